@@ -0,0 +1,120 @@
+#include "fake_backend.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/ssl/stream.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/error_code.hpp>
+#include <optional>
+#include <utility>
+
+#include "common/async_stream.hpp"
+#include "loadgen_wire.hpp"
+#include "protocol/packet_frame_buffer.hpp"
+
+namespace loadgen {
+
+FakeMysqlBackend::FakeMysqlBackend(boost::asio::io_context& ioc, BackendOptions options)
+    : ioc_{ioc},
+      options_{std::move(options)},
+      acceptor_{ioc,
+                boost::asio::ip::tcp::endpoint{boost::asio::ip::make_address("127.0.0.1"), 0}},
+      result_set_{make_result_set(options_.rows, options_.row_bytes)},
+      ok_after_auth_{make_ok(2)} {
+    port_ = acceptor_.local_endpoint().port();
+}
+
+void FakeMysqlBackend::start() {
+    boost::asio::co_spawn(acceptor_.get_executor(), accept_loop(), boost::asio::detached);
+}
+
+void FakeMysqlBackend::stop() {
+    boost::asio::post(acceptor_.get_executor(), [this] {
+        boost::system::error_code ec;
+        acceptor_.close(ec);
+    });
+}
+
+auto FakeMysqlBackend::accept_loop() -> boost::asio::awaitable<void> {
+    std::uint32_t next_id = 1;
+    while (acceptor_.is_open()) {
+        boost::system::error_code ec;
+        auto socket = co_await acceptor_.async_accept(
+            boost::asio::make_strand(ioc_),
+            boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        if (ec) {
+            if (ec == boost::asio::error::operation_aborted) {
+                break;
+            }
+            continue;
+        }
+        socket.set_option(boost::asio::ip::tcp::no_delay(true), ec);
+        auto executor = socket.get_executor();
+        boost::asio::co_spawn(executor, serve(std::move(socket), next_id++), boost::asio::detached);
+    }
+}
+
+auto FakeMysqlBackend::serve(boost::asio::ip::tcp::socket socket, std::uint32_t connection_id)
+    -> boost::asio::awaitable<void> {
+    std::optional<AsyncStream> stream;
+    if (options_.tls != nullptr) {
+        AsyncStream::ssl_socket tls{std::move(socket), *options_.tls};
+        boost::system::error_code ec;
+        co_await tls.async_handshake(boost::asio::ssl::stream_base::server,
+                                     boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        if (ec) {
+            co_return;
+        }
+        stream.emplace(std::move(tls));
+    } else {
+        stream.emplace(std::move(socket));
+    }
+
+    PacketFrameBuffer rx;
+    if (!co_await write_all(*stream, make_greeting(connection_id)) ||
+        !co_await fill_packet(*stream, rx)) {
+        co_return;
+    }
+    rx.consume(rx.peek(0)->raw().size());  // HandshakeResponse (검증하지 않음)
+    if (!co_await write_all(*stream, ok_after_auth_)) {
+        co_return;
+    }
+
+    while (co_await fill_packet(*stream, rx)) {
+        const auto pkt = *rx.peek(0);
+        const auto payload = pkt.payload();
+        const std::uint8_t command = payload.empty() ? 0 : payload[0];
+        const std::size_t size = pkt.raw().size();
+
+        bool ok = true;
+        switch (command) {
+            case kComQuit:
+                co_return;
+            case kComQuery:
+                queries_.fetch_add(1, std::memory_order_relaxed);
+                if (options_.on_query) {
+                    const std::string_view sql{reinterpret_cast<const char*>(payload.data()) + 1,
+                                               payload.size() - 1};
+                    ok = co_await write_all(*stream, options_.on_query(sql));
+                } else {
+                    ok = co_await write_all(*stream, result_set_);
+                }
+                break;
+            case kComPing:
+                ok = co_await write_all(*stream, make_ok(1));
+                break;
+            default:
+                ok = co_await write_all(*stream, make_err(1, "unsupported command"));
+                break;
+        }
+        rx.consume(size);  // payload 는 응답을 쓴 뒤에 버린다 (on_query 가 SQL 을 본다)
+        if (!ok) {
+            co_return;
+        }
+    }
+}
+
+}  // namespace loadgen
@@ -0,0 +1,79 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// fake_backend.hpp
+//
+// FakeMysqlBackend: 미리 만든 핸드셰이크 / result set 패킷을 회선 속도로 돌려주는 가짜 MySQL.
+//
+// [설계 의도]
+// sysbench + 실제 MySQL 측정은 프록시 비용과 MySQL 비용이 섞인다. 이 백엔드는 쿼리를
+// 해석하지 않고 COM_QUERY 마다 같은 result set 바이트를 한 번의 쓰기로 보낸다.
+// 백엔드 비용이 0 에 가까우므로 직결 대비 프록시 경유 차이가 곧 프록시 비용이다.
+//
+// [프로토콜]
+// greeting → HandshakeResponse 수신 → OK. 이후 COM_QUERY → result set,
+// COM_PING → OK, COM_QUIT → 연결 종료, 그 외 → ERR.
+// on_query 가 주어지면 COM_QUERY 응답은 SQL 별로 그 함수가 만든 바이트다 (테스트용 응답 각본).
+// tls 가 주어지면 accept 직후 TLS 핸드셰이크 (dbgate backend TLS 와 같은 방식).
+//
+// [스레드 안전성]
+// 연결마다 strand 에서 실행된다. start() / stop() 은 io_context 를 돌리는 스레드 밖에서
+// 호출해도 된다 (acceptor 조작은 post).
+// ---------------------------------------------------------------------------
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace loadgen {
+
+struct BackendOptions {
+    std::size_t rows{10};       // result set row 수
+    std::size_t row_bytes{64};  // row 의 payload 컬럼 바이트
+    boost::asio::ssl::context* tls{nullptr};  // nullptr = 평문
+    // SQL → 응답 wire 바이트 (비어 있으면 매 쿼리에 rows / row_bytes result set)
+    std::function<std::vector<std::uint8_t>(std::string_view sql)> on_query{};
+};
+
+class FakeMysqlBackend {
+public:
+    // 127.0.0.1 의 임의 포트에 바인딩한다 (port() 로 확인)
+    FakeMysqlBackend(boost::asio::io_context& ioc, BackendOptions options);
+
+    FakeMysqlBackend(const FakeMysqlBackend&) = delete;
+    FakeMysqlBackend& operator=(const FakeMysqlBackend&) = delete;
+    FakeMysqlBackend(FakeMysqlBackend&&) = delete;
+    FakeMysqlBackend& operator=(FakeMysqlBackend&&) = delete;
+    ~FakeMysqlBackend() = default;
+
+    [[nodiscard]] std::uint16_t port() const noexcept { return port_; }
+
+    void start();
+    void stop();
+
+    // 처리한 COM_QUERY 수 (프록시가 실제로 백엔드까지 전달했는지 확인용)
+    [[nodiscard]] std::uint64_t queries() const noexcept {
+        return queries_.load(std::memory_order_relaxed);
+    }
+
+private:
+    auto accept_loop() -> boost::asio::awaitable<void>;
+    auto serve(boost::asio::ip::tcp::socket socket, std::uint32_t connection_id)
+        -> boost::asio::awaitable<void>;
+
+    boost::asio::io_context& ioc_;
+    BackendOptions options_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    std::uint16_t port_{0};
+    std::vector<std::uint8_t> result_set_{};
+    std::vector<std::uint8_t> ok_after_auth_{};
+    std::atomic<std::uint64_t> queries_{0};
+};
+
+}  // namespace loadgen
@@ -0,0 +1,286 @@
+#include "load_driver.hpp"
+
+#include <openssl/ssl.h>
+#include <unistd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/ssl/stream.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/error_code.hpp>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "common/async_stream.hpp"
+#include "loadgen_wire.hpp"
+#include "protocol/packet_frame_buffer.hpp"
+
+namespace loadgen {
+
+namespace {
+
+constexpr auto kPollInterval = std::chrono::milliseconds{10};
+constexpr auto kConnectTimeout = std::chrono::seconds{60};
+constexpr auto kShutdownTimeout = std::chrono::seconds{30};
+
+struct SharedState {
+    std::atomic<std::size_t> settled{0};     // 핸드셰이크 성공 또는 실패가 결정된 연결 수
+    std::atomic<std::size_t> connected{0};
+    std::atomic<std::size_t> finished{0};
+    std::atomic<bool> measuring{false};
+    std::atomic<bool> stop{false};
+
+    std::mutex mutex;
+    LoadResult* result{nullptr};
+};
+
+auto open_stream(const LoadOptions& options, boost::asio::any_io_executor executor)
+    -> boost::asio::awaitable<std::optional<AsyncStream>> {
+    boost::asio::ip::tcp::socket socket{executor};
+    boost::system::error_code ec;
+    co_await socket.async_connect(options.target,
+                                  boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return std::nullopt;
+    }
+    socket.set_option(boost::asio::ip::tcp::no_delay(true), ec);
+
+    if (options.tls == nullptr) {
+        co_return AsyncStream{std::move(socket)};
+    }
+
+    AsyncStream::ssl_socket tls{std::move(socket), *options.tls};
+    if (!options.tls_server_name.empty()) {
+        // SNI + 인증서 호스트명 검증 (검증 모드/CA 는 options.tls context 설정을 따른다)
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+        SSL_set_tlsext_host_name(tls.native_handle(), options.tls_server_name.c_str());
+        if (SSL_set1_host(tls.native_handle(), options.tls_server_name.c_str()) != 1) {
+            co_return std::nullopt;
+        }
+    }
+    co_await tls.async_handshake(boost::asio::ssl::stream_base::client,
+                                 boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return std::nullopt;
+    }
+    co_return AsyncStream{std::move(tls)};
+}
+
+// greeting → HandshakeResponse → OK
+auto authenticate(AsyncStream& stream, PacketFrameBuffer& rx, const LoadOptions& options)
+    -> boost::asio::awaitable<bool> {
+    if (!co_await fill_packet(stream, rx)) {
+        co_return false;
+    }
+    rx.consume(rx.peek(0)->raw().size());
+    if (!co_await write_all(stream, make_handshake_response(options.user, options.db)) ||
+        !co_await fill_packet(stream, rx)) {
+        co_return false;
+    }
+    const auto reply = *rx.peek(0);
+    const bool ok = !reply.payload().empty() && reply.payload()[0] == 0x00;
+    rx.consume(reply.raw().size());
+    co_return ok;
+}
+
+// result set 끝(두 번째 EOF), OK, ERR 까지 소비한다. 반환: 응답 바이트 (끊김 = nullopt)
+auto read_response(AsyncStream& stream, PacketFrameBuffer& rx, bool& error_reply)
+    -> boost::asio::awaitable<std::optional<std::uint64_t>> {
+    std::uint64_t bytes = 0;
+    int eofs = 0;
+    bool first = true;
+    while (true) {
+        if (!rx.peek(0) && !co_await fill_packet(stream, rx)) {
+            co_return std::nullopt;
+        }
+        const auto pkt = *rx.peek(0);
+        const auto payload = pkt.payload();
+        const std::uint8_t byte0 = payload.empty() ? 0xFF : payload[0];
+        const bool is_eof = byte0 == 0xFE && payload.size() < 9;
+        bytes += pkt.raw().size();
+        rx.consume(pkt.raw().size());
+
+        if (byte0 == 0xFF) {
+            error_reply = true;
+            co_return bytes;
+        }
+        if (first && byte0 == 0x00) {
+            co_return bytes;
+        }
+        first = false;
+        if (is_eof && ++eofs == 2) {
+            co_return bytes;
+        }
+    }
+}
+
+auto run_connection(const LoadOptions& options,
+                    SharedState& shared,
+                    boost::asio::any_io_executor executor) -> boost::asio::awaitable<void> {
+    std::vector<std::uint64_t> latencies;
+    std::uint64_t queries = 0;
+    std::uint64_t errors = 0;
+    std::uint64_t bytes = 0;
+
+    auto stream = co_await open_stream(options, executor);
+    PacketFrameBuffer rx;
+    const bool ready = stream && co_await authenticate(*stream, rx, options);
+    if (ready) {
+        shared.connected.fetch_add(1, std::memory_order_relaxed);
+    }
+    shared.settled.fetch_add(1, std::memory_order_release);
+
+    if (ready) {
+        const auto query = make_query(options.query);
+        while (!shared.stop.load(std::memory_order_acquire)) {
+            const auto started = std::chrono::steady_clock::now();
+            bool error_reply = false;
+            std::optional<std::uint64_t> received;
+            if (co_await write_all(*stream, query)) {
+                received = co_await read_response(*stream, rx, error_reply);
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - started;
+
+            if (!shared.measuring.load(std::memory_order_acquire)) {
+                if (!received) {
+                    break;
+                }
+                continue;  // 워밍업 / 종료 직전 쿼리는 집계하지 않는다
+            }
+            if (!received || error_reply) {
+                ++errors;
+                if (!received) {
+                    break;
+                }
+                continue;
+            }
+            ++queries;
+            bytes += *received;
+            latencies.push_back(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+        const std::array<std::uint8_t, 1> quit{kComQuit};
+        std::vector<std::uint8_t> wire;
+        append_packet(wire, 0, quit);
+        co_await write_all(*stream, wire);
+        boost::system::error_code ec;
+        stream->lowest_layer().close(ec);
+    }
+
+    {
+        const std::lock_guard lock{shared.mutex};
+        shared.result->queries += queries;
+        shared.result->errors += errors;
+        shared.result->response_bytes += bytes;
+        shared.result->latencies_ns.insert(
+            shared.result->latencies_ns.end(), latencies.begin(), latencies.end());
+    }
+    shared.finished.fetch_add(1, std::memory_order_release);
+}
+
+// pred 가 참이 되거나 timeout 이 지날 때까지 대기. 반환: pred 결과
+template <typename Pred>
+bool wait_until(Pred pred, std::chrono::steady_clock::duration timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(kPollInterval);
+    }
+    return true;
+}
+
+}  // namespace
+
+std::uint64_t LoadResult::percentile_ns(double p) const noexcept {
+    if (latencies_ns.empty()) {
+        return 0;
+    }
+    const double rank = std::clamp(p, 0.0, 100.0) / 100.0 *
+                        static_cast<double>(latencies_ns.size() - 1);
+    return latencies_ns[static_cast<std::size_t>(std::llround(rank))];
+}
+
+std::int64_t resident_bytes() noexcept {
+    std::ifstream statm{"/proc/self/statm"};
+    long pages_total = 0;
+    long pages_resident = 0;
+    if (!(statm >> pages_total >> pages_resident)) {
+        return 0;
+    }
+    return static_cast<std::int64_t>(pages_resident) * sysconf(_SC_PAGESIZE);
+}
+
+LoadResult run_load(const LoadOptions& options) {
+    LoadResult result;
+    SharedState shared;
+    shared.result = &result;
+
+    const std::uint32_t threads = std::max<std::uint32_t>(options.threads, 1);
+    boost::asio::io_context ioc{static_cast<int>(threads)};
+    auto work = boost::asio::make_work_guard(ioc);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (std::uint32_t i = 0; i < threads; ++i) {
+        workers.emplace_back([&ioc] { ioc.run(); });
+    }
+
+#if defined(__GLIBC__)
+    // 이전 단계가 해제한 힙을 돌려놓아 RSS 차이가 이번 단계의 연결분만 반영되게 한다
+    malloc_trim(0);
+#endif
+    const std::int64_t rss_before = resident_bytes();
+    for (std::size_t i = 0; i < options.connections; ++i) {
+        auto strand = boost::asio::make_strand(ioc);
+        boost::asio::co_spawn(
+            strand, run_connection(options, shared, strand), boost::asio::detached);
+    }
+
+    const std::size_t total = options.connections;
+    wait_until([&] { return shared.settled.load(std::memory_order_acquire) == total; },
+               kConnectTimeout);
+    result.connected = shared.connected.load(std::memory_order_relaxed);
+    if (result.connected > 0) {
+        result.rss_per_connection =
+            (resident_bytes() - rss_before) / static_cast<std::int64_t>(result.connected);
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    shared.measuring.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(options.duration);
+    shared.measuring.store(false, std::memory_order_release);
+    result.seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    shared.stop.store(true, std::memory_order_release);
+
+    const bool drained = wait_until(
+        [&] { return shared.finished.load(std::memory_order_acquire) == total; }, kShutdownTimeout);
+    work.reset();
+    if (!drained) {
+        ioc.stop();
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::ranges::sort(result.latencies_ns);
+    return result;
+}
+
+}  // namespace loadgen
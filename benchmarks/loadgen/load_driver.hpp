@@ -0,0 +1,59 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// load_driver.hpp
+//
+// run_load: MySQL 클라이언트 연결 N 개를 동시에 열고 정해진 시간 동안 COM_QUERY 를 반복한다.
+//
+// [측정 절차]
+// 1. 모든 연결이 핸드셰이크를 마칠 때까지 기다린 뒤 RSS 를 잰다 (연결당 메모리).
+// 2. 측정 구간(duration) 동안 각 연결은 쿼리 → result set 끝(EOF/ERR)까지 수신을 반복하고,
+//    쿼리 1건의 왕복 시간을 기록한다. 측정 구간 밖의 쿼리는 집계하지 않는다.
+// 3. 구간이 끝나면 COM_QUIT 후 연결을 닫는다.
+//
+// 드라이버는 전용 io_context 를 threads 개 스레드로 돌린다 (프록시 워커와 분리).
+// ---------------------------------------------------------------------------
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace loadgen {
+
+struct LoadOptions {
+    boost::asio::ip::tcp::endpoint target{};
+    std::size_t connections{100};
+    std::chrono::milliseconds duration{std::chrono::seconds{10}};
+    std::uint32_t threads{1};
+    std::string user{"dbgate"};
+    std::string db{"bench"};
+    std::string query{"SELECT id, payload FROM bench_rows"};
+    boost::asio::ssl::context* tls{nullptr};  // nullptr = 평문
+    std::string tls_server_name{};            // 빈 문자열 = SNI 미설정
+};
+
+struct LoadResult {
+    std::size_t connected{0};         // 핸드셰이크까지 성공한 연결 수
+    std::uint64_t queries{0};         // 측정 구간에 완료한 쿼리 수
+    std::uint64_t errors{0};          // 측정 구간 중 끊김 / ERR 응답
+    std::uint64_t response_bytes{0};  // 측정 구간에 수신한 응답 바이트
+    double seconds{0.0};              // 실제 측정 구간 길이
+    std::int64_t rss_per_connection{0};  // 연결 수립 전후 RSS 차이 / connected (바이트)
+    std::vector<std::uint64_t> latencies_ns{};  // 정렬됨
+
+    // p: [0, 100]. 표본이 없으면 0
+    [[nodiscard]] std::uint64_t percentile_ns(double p) const noexcept;
+    [[nodiscard]] double qps() const noexcept {
+        return seconds > 0.0 ? static_cast<double>(queries) / seconds : 0.0;
+    }
+};
+
+[[nodiscard]] LoadResult run_load(const LoadOptions& options);
+
+// /proc/self/statm 의 resident 크기 (바이트, 읽기 실패 시 0)
+[[nodiscard]] std::int64_t resident_bytes() noexcept;
+
+}  // namespace loadgen
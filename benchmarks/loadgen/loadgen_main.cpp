@@ -0,0 +1,437 @@
+// ---------------------------------------------------------------------------
+// loadgen_main.cpp  —  dbgate_loadgen: 프로세스 내 프록시 오버헤드 측정
+//
+// 같은 프로세스에서 FakeMysqlBackend 와 ProxyServer 를 띄우고, 같은 부하를
+//   1) 백엔드 직결 (direct)
+//   2) 프록시 경유 (proxied)
+// 로 한 번씩 걸어 두 결과의 차이를 프록시 비용으로 보고한다.
+//
+// 사용법:
+//   dbgate_loadgen [--connections=N] [--duration-sec=S] [--rows=R] [--row-bytes=B]
+//                  [--driver-threads=T] [--proxy-threads=T] [--backend-threads=T]
+//                  [--frontend-tls] [--backend-tls] [--tls-cert=PEM] [--tls-key=PEM]
+//                  [--tls-server-name=NAME] [--policy=YAML] [--log-level=LEVEL]
+//                  [--tcp-nodelay=0|1] [--socket-buffer-bytes=N] [--busy-poll-us=N]
+//                  [--json=PATH]
+//
+// - TLS 는 dbgate 와 같은 방식(연결 직후 TLS)이다. --tls-cert/--tls-key 는 frontend 서버
+//   인증서와 가짜 백엔드 인증서로 함께 쓰이고, backend TLS 검증 CA 로도 쓰인다 (자체 서명).
+//   backend TLS 는 인증서 검증을 끄지 않으므로 인증서 CN/SAN 이 --tls-server-name 과 같아야 한다.
+// - 정책 파일은 임시 디렉터리로 복사해 쓴다 (PolicyVersionStore 스냅샷이 원본 옆에 쌓이지 않게).
+// - 모든 리스너는 127.0.0.1 임의 포트에만 바인딩한다.
+// - --tcp-nodelay / --socket-buffer-bytes / --busy-poll-us 는 프록시 양쪽 소켓 설정
+//   (TCP_NODELAY, SOCKET_{RECV,SEND}_BUFFER_BYTES, SOCKET_BUSY_POLL_US) 이다. 드라이버와 가짜
+//   백엔드는 항상 TCP_NODELAY 이므로 차이는 프록시 구간에서만 생긴다.
+// ---------------------------------------------------------------------------
+
+#include <spdlog/spdlog.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "fake_backend.hpp"
+#include "load_driver.hpp"
+#include "proxy/proxy_server.hpp"
+
+namespace {
+
+constexpr auto kProxyReadyTimeout = std::chrono::seconds{10};
+
+struct Options {
+    std::size_t connections{100};
+    std::uint32_t duration_sec{10};
+    std::size_t rows{10};
+    std::size_t row_bytes{64};
+    std::uint32_t driver_threads{2};
+    std::uint32_t proxy_threads{2};
+    std::uint32_t backend_threads{2};
+    bool frontend_tls{false};
+    bool backend_tls{false};
+    std::string tls_cert{};
+    std::string tls_key{};
+    std::string tls_server_name{"dbgate-bench"};
+    std::string policy{"benchmarks/policy-benchmark.yaml"};
+    std::string log_level{"warn"};
+    std::string json_path{};
+    bool tcp_nodelay{true};
+    std::uint32_t socket_buffer_bytes{0};
+    std::uint32_t busy_poll_us{0};
+};
+
+template <typename T>
+bool parse_number(std::string_view text, T& out) {
+    const auto* const end = text.data() + text.size();
+    const auto [ptr, ec] = std::from_chars(text.data(), end, out);
+    return ec == std::errc{} && ptr == end;
+}
+
+// --key=value / --flag 형식. 알 수 없는 옵션이나 잘못된 값이면 nullopt
+std::optional<Options> parse_args(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const std::string_view arg{argv[i]};
+        const auto eq = arg.find('=');
+        const auto key = arg.substr(0, eq);
+        const auto value = eq == std::string_view::npos ? std::string_view{} : arg.substr(eq + 1);
+
+        bool ok = true;
+        if (key == "--connections") {
+            ok = parse_number(value, opts.connections) && opts.connections > 0;
+        } else if (key == "--duration-sec") {
+            ok = parse_number(value, opts.duration_sec) && opts.duration_sec > 0;
+        } else if (key == "--rows") {
+            ok = parse_number(value, opts.rows);
+        } else if (key == "--row-bytes") {
+            ok = parse_number(value, opts.row_bytes);
+        } else if (key == "--driver-threads") {
+            ok = parse_number(value, opts.driver_threads) && opts.driver_threads > 0;
+        } else if (key == "--proxy-threads") {
+            ok = parse_number(value, opts.proxy_threads) && opts.proxy_threads > 0;
+        } else if (key == "--backend-threads") {
+            ok = parse_number(value, opts.backend_threads) && opts.backend_threads > 0;
+        } else if (key == "--frontend-tls") {
+            opts.frontend_tls = true;
+        } else if (key == "--backend-tls") {
+            opts.backend_tls = true;
+        } else if (key == "--tls-cert") {
+            opts.tls_cert = value;
+        } else if (key == "--tls-key") {
+            opts.tls_key = value;
+        } else if (key == "--tls-server-name") {
+            opts.tls_server_name = value;
+        } else if (key == "--policy") {
+            opts.policy = value;
+        } else if (key == "--log-level") {
+            opts.log_level = value;
+        } else if (key == "--json") {
+            opts.json_path = value;
+        } else if (key == "--tcp-nodelay") {
+            ok = value == "0" || value == "1";
+            opts.tcp_nodelay = value == "1";
+        } else if (key == "--socket-buffer-bytes") {
+            ok = parse_number(value, opts.socket_buffer_bytes);
+        } else if (key == "--busy-poll-us") {
+            ok = parse_number(value, opts.busy_poll_us);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::fprintf(
+                stderr, "invalid option: %.*s\n", static_cast<int>(arg.size()), arg.data());
+            return std::nullopt;
+        }
+    }
+    const bool tls = opts.frontend_tls || opts.backend_tls;
+    if (tls && (opts.tls_cert.empty() || opts.tls_key.empty())) {
+        std::fprintf(stderr, "--frontend-tls / --backend-tls require --tls-cert and --tls-key\n");
+        return std::nullopt;
+    }
+    return opts;
+}
+
+// 연결당 최대 4개 fd (클라이언트, 프록시 frontend/backend, 백엔드) 를 쓰므로 한도를 최대로 올린다
+void raise_fd_limit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+std::uint16_t free_loopback_port() {
+    boost::asio::io_context ioc;
+    boost::asio::ip::tcp::acceptor acceptor{
+        ioc, {boost::asio::ip::address_v4::loopback(), 0}};
+    return acceptor.local_endpoint().port();
+}
+
+// 프록시 accept 루프는 코루틴 안에서 리스너를 만든다: 접속이 될 때까지 재시도
+bool wait_for_listener(std::uint16_t port) {
+    const auto deadline = std::chrono::steady_clock::now() + kProxyReadyTimeout;
+    boost::asio::io_context ioc;
+    while (std::chrono::steady_clock::now() < deadline) {
+        boost::asio::ip::tcp::socket probe{ioc};
+        boost::system::error_code ec;
+        probe.connect({boost::asio::ip::address_v4::loopback(), port}, ec);
+        if (!ec) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    }
+    return false;
+}
+
+boost::asio::ssl::context make_server_tls(const Options& opts) {
+    boost::asio::ssl::context ctx{boost::asio::ssl::context::tls_server};
+    ctx.set_options(boost::asio::ssl::context::no_sslv2 | boost::asio::ssl::context::no_sslv3 |
+                    boost::asio::ssl::context::no_tlsv1 | boost::asio::ssl::context::no_tlsv1_1);
+    ctx.use_certificate_chain_file(opts.tls_cert);
+    ctx.use_private_key_file(opts.tls_key, boost::asio::ssl::context::pem);
+    return ctx;
+}
+
+boost::asio::ssl::context make_client_tls(const Options& opts) {
+    boost::asio::ssl::context ctx{boost::asio::ssl::context::tls_client};
+    ctx.set_options(boost::asio::ssl::context::no_tlsv1 | boost::asio::ssl::context::no_tlsv1_1);
+    // CA 는 --tls-cert (자체 서명) 로 고정한다. 호스트명은 드라이버가 연결마다 SSL_set1_host
+    ctx.load_verify_file(opts.tls_cert);
+    ctx.set_verify_mode(boost::asio::ssl::verify_peer);
+    return ctx;
+}
+
+struct PhaseReport {
+    std::string name;
+    loadgen::LoadResult result;
+};
+
+void print_phase(const PhaseReport& phase) {
+    const auto& r = phase.result;
+    std::printf("%-8s connected=%zu qps=%.0f p50=%.1fus p99=%.1fus errors=%llu rss/conn=%lldB\n",
+                phase.name.c_str(),
+                r.connected,
+                r.qps(),
+                static_cast<double>(r.percentile_ns(50.0)) / 1000.0,
+                static_cast<double>(r.percentile_ns(99.0)) / 1000.0,
+                static_cast<unsigned long long>(r.errors),
+                static_cast<long long>(r.rss_per_connection));
+}
+
+std::string phase_json(const PhaseReport& phase) {
+    const auto& r = phase.result;
+    return std::format(
+        R"("{}":{{"connected":{},"queries":{},"errors":{},"qps":{:.1f},)"
+        R"("p50_ns":{},"p99_ns":{},"response_bytes":{},"rss_per_connection":{}}})",
+        phase.name,
+        r.connected,
+        r.queries,
+        r.errors,
+        r.qps(),
+        r.percentile_ns(50.0),
+        r.percentile_ns(99.0),
+        r.response_bytes,
+        r.rss_per_connection);
+}
+
+// 프록시 경유 단계: ProxyServer 를 전용 io_context 에 띄우고 부하를 건 뒤 정지한다
+std::optional<loadgen::LoadResult> run_proxied(const Options& opts,
+                                               std::uint16_t backend_port,
+                                               const std::filesystem::path& work_dir,
+                                               loadgen::LoadOptions load) {
+    const auto policy_copy = work_dir / "policy.yaml";
+    std::error_code fs_ec;
+    std::filesystem::copy_file(
+        opts.policy, policy_copy, std::filesystem::copy_options::overwrite_existing, fs_ec);
+    if (fs_ec) {
+        std::fprintf(stderr, "cannot copy policy %s: %s\n", opts.policy.c_str(),
+                     fs_ec.message().c_str());
+        return std::nullopt;
+    }
+
+    ProxyConfig config;
+    config.listen_address = "127.0.0.1";
+    config.listen_port = free_loopback_port();
+    config.upstream_address = "127.0.0.1";
+    config.upstream_port = backend_port;
+    config.policy_path = policy_copy.string();
+    config.uds_socket_path = (work_dir / "dbgate.sock").string();
+    config.log_path = (work_dir / "dbgate.log").string();
+    config.log_level = opts.log_level;
+    config.health_check_port = free_loopback_port();
+    config.max_connections = static_cast<std::uint32_t>(opts.connections + 16);
+    config.worker_threads = opts.proxy_threads;
+    config.frontend_ssl_enabled = opts.frontend_tls;
+    config.frontend_ssl_cert_path = opts.tls_cert;
+    config.frontend_ssl_key_path = opts.tls_key;
+    config.backend_ssl_enabled = opts.backend_tls;
+    config.backend_ssl_ca_path = opts.tls_cert;
+    config.upstream_ssl_sni = opts.backend_tls ? opts.tls_server_name : std::string{};
+    config.tcp_nodelay = opts.tcp_nodelay;
+    config.socket_recv_buffer_bytes = opts.socket_buffer_bytes;
+    config.socket_send_buffer_bytes = opts.socket_buffer_bytes;
+    config.socket_busy_poll_us = opts.busy_poll_us;
+
+    boost::asio::io_context ioc{static_cast<int>(opts.proxy_threads)};
+    ProxyServer server{config};
+    server.run(ioc);
+
+    std::vector<std::thread> workers;
+    workers.reserve(opts.proxy_threads);
+    for (std::uint32_t i = 0; i < opts.proxy_threads; ++i) {
+        workers.emplace_back([&ioc] { ioc.run(); });
+    }
+
+    std::optional<loadgen::LoadResult> result;
+    if (wait_for_listener(config.listen_port)) {
+        load.target = {boost::asio::ip::address_v4::loopback(), config.listen_port};
+        result = loadgen::run_load(load);
+    } else {
+        std::fprintf(stderr, "proxy did not start listening on 127.0.0.1:%u\n",
+                     static_cast<unsigned>(config.listen_port));
+    }
+
+    server.stop();
+    ioc.stop();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return result;
+}
+
+int run(const Options& opts) {
+    raise_fd_limit();
+    spdlog::set_level(spdlog::level::from_str(opts.log_level));
+
+    const auto work_dir = std::filesystem::temp_directory_path() /
+                          std::format("dbgate-loadgen-{}", static_cast<long>(getpid()));
+    std::filesystem::create_directories(work_dir);
+
+    std::optional<boost::asio::ssl::context> backend_tls;
+    std::optional<boost::asio::ssl::context> client_tls;
+    if (opts.backend_tls) {
+        backend_tls.emplace(make_server_tls(opts));
+    }
+    if (opts.frontend_tls || opts.backend_tls) {
+        client_tls.emplace(make_client_tls(opts));
+    }
+
+    boost::asio::io_context backend_ioc{static_cast<int>(opts.backend_threads)};
+    loadgen::FakeMysqlBackend backend{
+        backend_ioc,
+        loadgen::BackendOptions{
+            .rows = opts.rows,
+            .row_bytes = opts.row_bytes,
+            .tls = backend_tls ? &*backend_tls : nullptr,
+        }};
+    backend.start();
+    std::vector<std::thread> backend_workers;
+    for (std::uint32_t i = 0; i < opts.backend_threads; ++i) {
+        backend_workers.emplace_back([&backend_ioc] { backend_ioc.run(); });
+    }
+
+    loadgen::LoadOptions load{
+        .connections = opts.connections,
+        .duration = std::chrono::seconds{opts.duration_sec},
+        .threads = opts.driver_threads,
+    };
+
+    // 1) 직결: 클라이언트 TLS 는 백엔드가 TLS 일 때만
+    PhaseReport direct{.name = "direct", .result = {}};
+    load.target = {boost::asio::ip::address_v4::loopback(), backend.port()};
+    load.tls = opts.backend_tls ? &*client_tls : nullptr;
+    load.tls_server_name = opts.backend_tls ? opts.tls_server_name : std::string{};
+    direct.result = loadgen::run_load(load);
+    const auto direct_backend_queries = backend.queries();
+
+    // 2) 프록시 경유: 클라이언트 TLS 는 frontend TLS 일 때만
+    load.tls = opts.frontend_tls ? &*client_tls : nullptr;
+    load.tls_server_name = opts.frontend_tls ? opts.tls_server_name : std::string{};
+    PhaseReport proxied{.name = "proxied", .result = {}};
+    auto proxied_result = run_proxied(opts, backend.port(), work_dir, load);
+    const auto proxied_backend_queries = backend.queries() - direct_backend_queries;
+
+    backend.stop();
+    backend_ioc.stop();
+    for (auto& worker : backend_workers) {
+        worker.join();
+    }
+    std::error_code fs_ec;
+    std::filesystem::remove_all(work_dir, fs_ec);
+
+    if (!proxied_result) {
+        return 1;
+    }
+    proxied.result = std::move(*proxied_result);
+
+    std::printf("connections=%zu duration=%us rows=%zu row_bytes=%zu frontend_tls=%d "
+                "backend_tls=%d tcp_nodelay=%d socket_buffer=%uB busy_poll=%uus\n",
+                opts.connections,
+                opts.duration_sec,
+                opts.rows,
+                opts.row_bytes,
+                opts.frontend_tls ? 1 : 0,
+                opts.backend_tls ? 1 : 0,
+                opts.tcp_nodelay ? 1 : 0,
+                opts.socket_buffer_bytes,
+                opts.busy_poll_us);
+    print_phase(direct);
+    print_phase(proxied);
+
+    const auto added_p50 = static_cast<double>(proxied.result.percentile_ns(50.0)) -
+                           static_cast<double>(direct.result.percentile_ns(50.0));
+    const auto added_p99 = static_cast<double>(proxied.result.percentile_ns(99.0)) -
+                           static_cast<double>(direct.result.percentile_ns(99.0));
+    const auto proxy_rss_per_connection =
+        proxied.result.rss_per_connection - direct.result.rss_per_connection;
+    std::printf("overhead added_p50=%.1fus added_p99=%.1fus proxy_rss/conn=%lldB "
+                "backend_queries=%llu\n",
+                added_p50 / 1000.0,
+                added_p99 / 1000.0,
+                static_cast<long long>(proxy_rss_per_connection),
+                static_cast<unsigned long long>(proxied_backend_queries));
+
+    if (!opts.json_path.empty()) {
+        std::ofstream out{opts.json_path};
+        out << std::format(
+            R"({{"connections":{},"duration_sec":{},"rows":{},"row_bytes":{},)"
+            R"("frontend_tls":{},"backend_tls":{},"tcp_nodelay":{},"socket_buffer_bytes":{},)"
+            R"("busy_poll_us":{},{},{},)"
+            R"("added_p50_ns":{:.0f},"added_p99_ns":{:.0f},"proxy_rss_per_connection":{}}})"
+            "\n",
+            opts.connections,
+            opts.duration_sec,
+            opts.rows,
+            opts.row_bytes,
+            opts.frontend_tls,
+            opts.backend_tls,
+            opts.tcp_nodelay,
+            opts.socket_buffer_bytes,
+            opts.busy_poll_us,
+            phase_json(direct),
+            phase_json(proxied),
+            added_p50,
+            added_p99,
+            proxy_rss_per_connection);
+        if (!out) {
+            std::fprintf(stderr, "cannot write %s\n", opts.json_path.c_str());
+            return 1;
+        }
+    }
+
+    // 양쪽 모두 오류 없이 같은 연결 수를 유지해야 비교가 유효하다
+    const bool valid = direct.result.connected == opts.connections &&
+                       proxied.result.connected == opts.connections &&
+                       direct.result.errors == 0 && proxied.result.errors == 0;
+    return valid ? 0 : 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const auto opts = parse_args(argc, argv);
+    if (!opts) {
+        return 64;  // EX_USAGE
+    }
+    try {
+        return run(*opts);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "dbgate_loadgen: %s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,209 @@
+#include "loadgen_wire.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/system/error_code.hpp>
+#include <algorithm>
+#include <string>
+
+namespace loadgen {
+
+namespace {
+
+constexpr std::size_t kReadChunk = 64U * 1024U;
+
+void put_u16(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    out.push_back(static_cast<std::uint8_t>(v & 0xFFU));
+    out.push_back(static_cast<std::uint8_t>((v >> 8U) & 0xFFU));
+}
+
+void put_u32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    put_u16(out, v & 0xFFFFU);
+    put_u16(out, v >> 16U);
+}
+
+void put_cstr(std::vector<std::uint8_t>& out, std::string_view s) {
+    out.insert(out.end(), s.begin(), s.end());
+    out.push_back(0);
+}
+
+// length-encoded integer (< 2^24)
+void put_lenenc(std::vector<std::uint8_t>& out, std::size_t n) {
+    if (n < 251) {
+        out.push_back(static_cast<std::uint8_t>(n));
+    } else if (n < 0x1'0000U) {
+        out.push_back(0xFC);
+        put_u16(out, static_cast<std::uint32_t>(n));
+    } else {
+        out.push_back(0xFD);
+        out.push_back(static_cast<std::uint8_t>(n & 0xFFU));
+        out.push_back(static_cast<std::uint8_t>((n >> 8U) & 0xFFU));
+        out.push_back(static_cast<std::uint8_t>((n >> 16U) & 0xFFU));
+    }
+}
+
+void put_lenenc_str(std::vector<std::uint8_t>& out, std::string_view s) {
+    put_lenenc(out, s.size());
+    out.insert(out.end(), s.begin(), s.end());
+}
+
+std::vector<std::uint8_t> column_definition(std::string_view name, std::uint8_t type) {
+    std::vector<std::uint8_t> p;
+    put_lenenc_str(p, "def");
+    put_lenenc_str(p, "bench");
+    put_lenenc_str(p, "bench_rows");
+    put_lenenc_str(p, "bench_rows");
+    put_lenenc_str(p, name);
+    put_lenenc_str(p, name);
+    p.push_back(0x0C);        // 고정 길이 필드 길이
+    put_u16(p, 0x21);         // utf8_general_ci
+    put_u32(p, 0x00FF'FFFFU); // column length
+    p.push_back(type);
+    put_u16(p, 0);            // flags
+    p.push_back(0);           // decimals
+    put_u16(p, 0);            // filler
+    return p;
+}
+
+void append_eof(std::vector<std::uint8_t>& out, std::uint8_t seq, std::uint16_t status) {
+    std::vector<std::uint8_t> eof{0xFE, 0x00, 0x00};  // warnings 0
+    put_u16(eof, status);
+    append_packet(out, seq, eof);
+}
+
+}  // namespace
+
+void append_packet(std::vector<std::uint8_t>& out,
+                   std::uint8_t seq,
+                   std::span<const std::uint8_t> payload) {
+    const auto len = static_cast<std::uint32_t>(payload.size());
+    out.push_back(static_cast<std::uint8_t>(len & 0xFFU));
+    out.push_back(static_cast<std::uint8_t>((len >> 8U) & 0xFFU));
+    out.push_back(static_cast<std::uint8_t>((len >> 16U) & 0xFFU));
+    out.push_back(seq);
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+std::vector<std::uint8_t> make_greeting(std::uint32_t connection_id) {
+    std::vector<std::uint8_t> p;
+    p.push_back(10);  // protocol version
+    put_cstr(p, "8.0.36-dbgate-loadgen");
+    put_u32(p, connection_id);
+    p.insert(p.end(), 8, 'a');  // auth-plugin-data part 1
+    p.push_back(0);
+    put_u16(p, kCapabilities & 0xFFFFU);
+    p.push_back(0x21);  // charset
+    put_u16(p, 0x0002); // SERVER_STATUS_AUTOCOMMIT
+    put_u16(p, kCapabilities >> 16U);
+    p.push_back(21);    // auth-plugin-data 길이
+    p.insert(p.end(), 10, 0);
+    p.insert(p.end(), 12, 'b');  // auth-plugin-data part 2
+    p.push_back(0);
+    put_cstr(p, "mysql_native_password");
+
+    std::vector<std::uint8_t> wire;
+    append_packet(wire, 0, p);
+    return wire;
+}
+
+std::vector<std::uint8_t> make_handshake_response(std::string_view user, std::string_view db) {
+    std::vector<std::uint8_t> p;
+    put_u32(p, kCapabilities);
+    put_u32(p, 16U * 1024U * 1024U);  // max packet
+    p.push_back(0x21);
+    p.insert(p.end(), 23, 0);
+    put_cstr(p, user);
+    p.push_back(20);           // auth response 길이 (SECURE_CONNECTION)
+    p.insert(p.end(), 20, 0);  // 가짜 백엔드는 검증하지 않는다
+    put_cstr(p, db);
+    put_cstr(p, "mysql_native_password");
+
+    std::vector<std::uint8_t> wire;
+    append_packet(wire, 1, p);
+    return wire;
+}
+
+std::vector<std::uint8_t> make_ok(std::uint8_t seq, std::uint16_t status) {
+    // header 0x00, affected_rows 0, last_insert_id 0, status, warnings 0
+    std::vector<std::uint8_t> ok{0x00, 0x00, 0x00};
+    put_u16(ok, status);
+    put_u16(ok, 0);
+    std::vector<std::uint8_t> wire;
+    append_packet(wire, seq, ok);
+    return wire;
+}
+
+std::vector<std::uint8_t> make_err(std::uint8_t seq, std::string_view message) {
+    std::vector<std::uint8_t> p{0xFF};
+    put_u16(p, 1047);  // ER_UNKNOWN_COM_ERROR
+    p.push_back('#');
+    const std::string_view state{"08S01"};
+    p.insert(p.end(), state.begin(), state.end());
+    p.insert(p.end(), message.begin(), message.end());
+
+    std::vector<std::uint8_t> wire;
+    append_packet(wire, seq, p);
+    return wire;
+}
+
+std::vector<std::uint8_t> make_query(std::string_view sql) {
+    std::vector<std::uint8_t> p{kComQuery};
+    p.insert(p.end(), sql.begin(), sql.end());
+    std::vector<std::uint8_t> wire;
+    append_packet(wire, 0, p);
+    return wire;
+}
+
+std::vector<std::uint8_t> make_result_set(std::size_t rows,
+                                          std::size_t row_bytes,
+                                          std::uint8_t first_seq,
+                                          std::uint16_t status) {
+    std::vector<std::uint8_t> wire;
+    std::uint8_t seq = first_seq;
+
+    const std::uint8_t column_count[] = {2};  // NOLINT(modernize-avoid-c-arrays)
+    append_packet(wire, seq++, column_count);
+    append_packet(wire, seq++, column_definition("id", 0x08));       // LONGLONG
+    append_packet(wire, seq++, column_definition("payload", 0xFD));  // VAR_STRING
+    append_eof(wire, seq++, status);
+
+    const std::string value(row_bytes, 'x');
+    std::vector<std::uint8_t> row;
+    for (std::size_t i = 0; i < rows; ++i) {
+        row.clear();
+        put_lenenc_str(row, std::to_string(i));
+        put_lenenc_str(row, value);
+        append_packet(wire, seq++, row);
+    }
+    append_eof(wire, seq, status);
+    return wire;
+}
+
+auto fill_packet(AsyncStream& stream, PacketFrameBuffer& rx, std::size_t offset)
+    -> boost::asio::awaitable<bool> {
+    while (!rx.peek(offset)) {
+        auto space = rx.prepare(std::max(kReadChunk, rx.missing(offset)));
+        boost::system::error_code ec;
+        const std::size_t n = co_await stream.async_read_some(
+            boost::asio::buffer(space.data(), space.size()),
+            boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        rx.commit(n);
+        if (ec) {
+            co_return false;
+        }
+    }
+    co_return true;
+}
+
+auto write_all(AsyncStream& stream, std::span<const std::uint8_t> bytes)
+    -> boost::asio::awaitable<bool> {
+    boost::system::error_code ec;
+    co_await boost::asio::async_write(stream,
+                                      boost::asio::buffer(bytes.data(), bytes.size()),
+                                      boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    co_return !ec;
+}
+
+}  // namespace loadgen
@@ -0,0 +1,81 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// loadgen_wire.hpp
+//
+// dbgate_loadgen 용 최소 MySQL 와이어 도구 (가짜 백엔드 + 클라이언트 드라이버 공용).
+//
+// [범위]
+// - 프록시를 통과시키는 데 필요한 패킷만 만든다: Initial Handshake v10,
+//   HandshakeResponse41, OK / EOF / ERR, text result set (CLIENT_DEPRECATE_EOF 없음 —
+//   프록시가 이 비트를 제거하므로 EOF 형식을 쓴다).
+// - 인증은 검증하지 않는다 (가짜 백엔드는 HandshakeResponse 를 받으면 OK).
+//   자격 증명이 오가지 않도록 auth 응답은 0 으로 채운다.
+// ---------------------------------------------------------------------------
+
+#include <boost/asio/awaitable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "common/async_stream.hpp"
+#include "protocol/packet_frame_buffer.hpp"
+
+namespace loadgen {
+
+// 가짜 백엔드 / 클라이언트가 주고받는 capability
+//   LONG_PASSWORD | LONG_FLAG | CONNECT_WITH_DB | PROTOCOL_41 | TRANSACTIONS |
+//   SECURE_CONNECTION | MULTI_RESULTS | PLUGIN_AUTH
+inline constexpr std::uint32_t kCapabilities = 0x0000'0001U | 0x0000'0004U | 0x0000'0008U |
+                                               0x0000'0200U | 0x0000'2000U | 0x0000'8000U |
+                                               0x0002'0000U | 0x0008'0000U;
+
+// OK / EOF status_flags
+inline constexpr std::uint16_t kServerStatusAutocommit = 0x0002;
+inline constexpr std::uint16_t kServerMoreResultsExists = 0x0008;
+
+inline constexpr std::uint8_t kComQuit = 0x01;
+inline constexpr std::uint8_t kComQuery = 0x03;
+inline constexpr std::uint8_t kComPing = 0x0E;
+
+// payload 를 4바이트 헤더(길이 3B + seq)와 함께 out 에 덧붙인다 (payload < 16MB)
+void append_packet(std::vector<std::uint8_t>& out,
+                   std::uint8_t seq,
+                   std::span<const std::uint8_t> payload);
+
+// wire 바이트 (헤더 포함)
+[[nodiscard]] std::vector<std::uint8_t> make_greeting(std::uint32_t connection_id);
+[[nodiscard]] std::vector<std::uint8_t> make_handshake_response(std::string_view user,
+                                                                std::string_view db);
+[[nodiscard]] std::vector<std::uint8_t> make_ok(std::uint8_t seq,
+                                                std::uint16_t status = kServerStatusAutocommit);
+[[nodiscard]] std::vector<std::uint8_t> make_err(std::uint8_t seq, std::string_view message);
+[[nodiscard]] std::vector<std::uint8_t> make_query(std::string_view sql);
+
+// ---------------------------------------------------------------------------
+// make_result_set
+//   컬럼 2개 (id, payload) 와 rows 개 row 의 text result set (seq first_seq 부터, 패킷 rows + 5개).
+//   payload 컬럼 값은 row_bytes 바이트. 한 번 만들어 두고 매 쿼리에 그대로 보낸다.
+//   status: 두 EOF 의 status_flags (다중 결과 응답이면 kServerMoreResultsExists 포함)
+// ---------------------------------------------------------------------------
+[[nodiscard]] std::vector<std::uint8_t> make_result_set(
+    std::size_t rows,
+    std::size_t row_bytes,
+    std::uint8_t first_seq = 1,
+    std::uint16_t status = kServerStatusAutocommit);
+
+// ---------------------------------------------------------------------------
+// fill_packet
+//   rx 의 offset 위치에 완전한 패킷이 들어올 때까지 stream 에서 읽는다.
+//   EOF / 오류면 false.
+// ---------------------------------------------------------------------------
+auto fill_packet(AsyncStream& stream, PacketFrameBuffer& rx, std::size_t offset = 0)
+    -> boost::asio::awaitable<bool>;
+
+// bytes 전체 쓰기. 실패 시 false.
+auto write_all(AsyncStream& stream, std::span<const std::uint8_t> bytes)
+    -> boost::asio::awaitable<bool>;
+
+}  // namespace loadgen
@@ -0,0 +1,59 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// bench_common.hpp
+//
+// dbgate_bench 공용 도구: 할당 계측, 코퍼스 로드, 합성 정책 생성.
+//
+// [할당 계측]
+// bench_main.cpp 가 전역 operator new 를 교체하여 스레드별 할당 횟수를 센다.
+// AllocationCounter 는 측정 루프 전후 차이를 반복 횟수로 나눠 "allocs/op" 카운터로
+// 보고한다 (Google Benchmark 의 PauseTiming 구간도 포함되므로 루프 안에서 준비 작업 금지).
+// ---------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "policy/rule.hpp"
+
+namespace dbgate_bench {
+
+// 현재 스레드가 지금까지 수행한 operator new 횟수
+[[nodiscard]] std::uint64_t thread_allocations() noexcept;
+
+class AllocationCounter {
+public:
+    AllocationCounter() noexcept : start_{thread_allocations()} {}
+
+    // state.counters[name] 에 반복당 평균 할당 수 / per 를 기록한다
+    //   (per: 반복 1회가 처리한 단위 수, 예: row 수 → "allocs/row")
+    void report(benchmark::State& state, const char* name = "allocs/op", double per = 1.0) const {
+        state.counters[name] =
+            benchmark::Counter(static_cast<double>(thread_allocations() - start_) / per,
+                               benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    std::uint64_t start_;
+};
+
+// tests/fuzz/corpus/sql_parser/*.sql (파일명 순) — 빌드 시 DBGATE_BENCH_CORPUS_DIR 로 지정
+[[nodiscard]] const std::vector<std::string>& sql_corpus();
+
+// ORM(Hibernate / SQLAlchemy 스타일) 이 생성하는 긴 SELECT/INSERT/UPDATE 문
+[[nodiscard]] const std::vector<std::string>& orm_queries();
+
+// ---------------------------------------------------------------------------
+// make_policy
+//   access_control 룰 rule_count 개 (user0..userN-1, 각 룰은 고유 테이블 2개 + 공용 테이블)
+//   와 기본 sql_rules / procedure_control 을 가진 정책. 평가 대상 세션은 마지막 룰의 사용자
+//   (bench_user()) 로, 선형 탐색이면 최악의 위치다.
+// ---------------------------------------------------------------------------
+[[nodiscard]] std::shared_ptr<PolicyConfig> make_policy(std::size_t rule_count);
+[[nodiscard]] std::string bench_user(std::size_t rule_count);
+
+}  // namespace dbgate_bench
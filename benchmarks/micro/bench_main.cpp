@@ -0,0 +1,195 @@
+// ---------------------------------------------------------------------------
+// bench_main.cpp
+//
+// dbgate_bench 진입점과 공용 도구 구현 (bench_common.hpp).
+//
+// 실행 예:
+//   ./build/bench/dbgate_bench --benchmark_filter=Policy
+//   ./build/bench/dbgate_bench --benchmark_format=json --benchmark_out=micro.json
+// ---------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <new>
+
+#include "bench_common.hpp"
+
+#ifndef DBGATE_BENCH_CORPUS_DIR
+#error "DBGATE_BENCH_CORPUS_DIR must point to tests/fuzz/corpus/sql_parser"
+#endif
+
+// ---------------------------------------------------------------------------
+// 전역 operator new 교체 — 스레드별 할당 횟수 계측
+//   크기/정렬 변형은 모두 counted_alloc / counted_aligned_alloc 으로 모인다.
+//   malloc 으로 할당하므로 모든 delete 변형도 free 로 함께 교체한다.
+// ---------------------------------------------------------------------------
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local std::uint64_t g_thread_allocations = 0;
+
+void* counted_alloc(std::size_t size) {
+    ++g_thread_allocations;
+    if (void* const p = std::malloc(size == 0 ? 1 : size)) {  // NOLINT(cppcoreguidelines-no-malloc)
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void* counted_aligned_alloc(std::size_t size, std::align_val_t align) {
+    ++g_thread_allocations;
+    const auto alignment = static_cast<std::size_t>(align);
+    const std::size_t rounded =
+        (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment;
+    if (void* const p = std::aligned_alloc(alignment, rounded)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-no-malloc,misc-new-delete-overloads)
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void* operator new(std::size_t size, std::align_val_t align) {
+    return counted_aligned_alloc(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return counted_aligned_alloc(size, align);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t /*size*/) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t /*size*/) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t /*align*/) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t /*align*/) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t /*size*/, std::align_val_t /*align*/) noexcept {
+    std::free(p);
+}
+void operator delete[](void* p, std::size_t /*size*/, std::align_val_t /*align*/) noexcept {
+    std::free(p);
+}
+// NOLINTEND(cppcoreguidelines-no-malloc,misc-new-delete-overloads)
+
+namespace dbgate_bench {
+
+std::uint64_t thread_allocations() noexcept { return g_thread_allocations; }
+
+const std::vector<std::string>& sql_corpus() {
+    static const std::vector<std::string> corpus = [] {
+        std::vector<std::filesystem::path> paths;
+        for (const auto& entry : std::filesystem::directory_iterator{DBGATE_BENCH_CORPUS_DIR}) {
+            if (entry.path().extension() == ".sql") {
+                paths.push_back(entry.path());
+            }
+        }
+        std::ranges::sort(paths);
+
+        std::vector<std::string> sqls;
+        sqls.reserve(paths.size());
+        for (const auto& path : paths) {
+            std::ifstream in{path, std::ios::binary};
+            sqls.emplace_back(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+        }
+        return sqls;
+    }();
+    return corpus;
+}
+
+const std::vector<std::string>& orm_queries() {
+    static const std::vector<std::string> queries = [] {
+        std::vector<std::string> out;
+
+        // Hibernate: 별칭 컬럼 나열 + 다중 JOIN + 페이징
+        std::string select =
+            "select order0_.id as id1_3_0_, customer1_.id as id1_1_1_, item2_.id as id1_2_2_";
+        for (int i = 0; i < 40; ++i) {
+            select += std::format(", order0_.col_{0} as col_{0}_3_0_", i);
+        }
+        select +=
+            " from orders order0_ inner join customers customer1_ on order0_.customer_id="
+            "customer1_.id left outer join order_items item2_ on order0_.id=item2_.order_id "
+            "left outer join products product3_ on item2_.product_id=product3_.id "
+            "where order0_.created_at>='2024-01-01 00:00:00' and customer1_.region in "
+            "('KR','JP','US','DE') and (order0_.status=? or order0_.status=?) "
+            "order by order0_.created_at desc limit 50 offset 100";
+        out.push_back(std::move(select));
+
+        // SQLAlchemy: 서브쿼리 + IN 목록
+        std::string in_list =
+            "SELECT users.id AS users_id, users.name AS users_name, users.email AS users_email "
+            "FROM users WHERE users.id IN (SELECT memberships.user_id FROM memberships "
+            "WHERE memberships.group_id IN (";
+        for (int i = 0; i < 200; ++i) {
+            in_list += std::format("{}{}", i == 0 ? "" : ", ", 1000 + i);
+        }
+        in_list += ")) AND users.deleted_at IS NULL ORDER BY users.id";
+        out.push_back(std::move(in_list));
+
+        // bulk INSERT (multi-row VALUES)
+        std::string insert =
+            "INSERT INTO audit_events (user_id, action, payload, created_at) VALUES ";
+        for (int i = 0; i < 100; ++i) {
+            insert += std::format("{}({}, 'login', '{{\"ip\":\"10.0.0.{}\"}}', NOW())",
+                                  i == 0 ? "" : ", ",
+                                  i,
+                                  i % 250);
+        }
+        out.push_back(std::move(insert));
+
+        // UPDATE with CASE
+        std::string update = "UPDATE inventory SET quantity = CASE sku";
+        for (int i = 0; i < 50; ++i) {
+            update += std::format(" WHEN 'SKU-{0:05}' THEN {1}", i, i * 3);
+        }
+        update += " ELSE quantity END WHERE warehouse_id = 7";
+        out.push_back(std::move(update));
+        return out;
+    }();
+    return queries;
+}
+
+std::string bench_user(std::size_t rule_count) {
+    return std::format("user{}", rule_count == 0 ? 0 : rule_count - 1);
+}
+
+std::shared_ptr<PolicyConfig> make_policy(std::size_t rule_count) {
+    auto cfg = std::make_shared<PolicyConfig>();
+    cfg->sql_rules.block_statements = {"DROP", "TRUNCATE", "ALTER"};
+    cfg->sql_rules.block_patterns = {"UNION\\s+SELECT", "SLEEP\\s*\\("};
+
+    for (std::size_t i = 0; i < rule_count; ++i) {
+        AccessRule rule{};
+        rule.user = std::format("user{}", i);
+        rule.source_ip_cidr = i % 2 == 0 ? "10.0.0.0/8" : "";
+        rule.allowed_tables = {std::format("t{}_a", i), std::format("t{}_b", i), "users", "orders"};
+        rule.allowed_operations = {"SELECT", "INSERT", "UPDATE", "DELETE"};
+        rule.blocked_operations = {"DROP"};
+        cfg->access_control.push_back(std::move(rule));
+    }
+
+    cfg->procedure_control.mode = "whitelist";
+    cfg->procedure_control.whitelist = {"sp_get_user"};
+    return cfg;
+}
+
+}  // namespace dbgate_bench
+
+int main(int argc, char** argv) {
+    // 차단 판정 로그(info)가 측정에 섞이지 않도록 로깅을 끈다
+    spdlog::set_level(spdlog::level::off);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
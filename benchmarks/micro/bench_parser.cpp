@@ -0,0 +1,101 @@
+// ---------------------------------------------------------------------------
+// bench_parser.cpp
+//
+// 파서 계층 핫 경로: SqlParser::parse / InjectionDetector::check / ProcedureDetector::detect.
+// 입력은 퍼징 코퍼스(짧은 대표 구문)와 ORM 생성 쿼리(긴 구문) 두 묶음이다.
+// 반복마다 같은 묶음 전체를 처리하고 items_per_second 는 쿼리 단위로 보고한다.
+// ---------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "parser/injection_detector.hpp"
+#include "parser/procedure_detector.hpp"
+#include "parser/sql_parser.hpp"
+
+namespace {
+
+// Arg(0): 퍼징 코퍼스, Arg(1): ORM 쿼리
+const std::vector<std::string>& inputs(const benchmark::State& state) {
+    return state.range(0) == 0 ? dbgate_bench::sql_corpus() : dbgate_bench::orm_queries();
+}
+
+std::int64_t total_bytes(const std::vector<std::string>& sqls) {
+    std::int64_t bytes = 0;
+    for (const auto& sql : sqls) {
+        bytes += static_cast<std::int64_t>(sql.size());
+    }
+    return bytes;
+}
+
+void set_rates(benchmark::State& state, const std::vector<std::string>& sqls) {
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(sqls.size()));
+    state.SetBytesProcessed(state.iterations() * total_bytes(sqls));
+}
+
+// 세션과 같은 조건: 커맨드마다 재사용하는 arena 위에서 파싱
+void BM_SqlParserParse(benchmark::State& state) {
+    const auto& sqls = inputs(state);
+    const SqlParser parser;
+    std::pmr::monotonic_buffer_resource arena{64U * 1024U};
+
+    const dbgate_bench::AllocationCounter allocs;
+    for (auto _ : state) {
+        for (const auto& sql : sqls) {
+            auto parsed = parser.parse(sql, &arena);
+            benchmark::DoNotOptimize(parsed);
+        }
+        arena.release();
+    }
+    allocs.report(state);
+    set_rates(state, sqls);
+}
+BENCHMARK(BM_SqlParserParse)->ArgName("orm")->Arg(0)->Arg(1);
+
+void BM_InjectionDetectorCheck(benchmark::State& state) {
+    const auto& sqls = inputs(state);
+    const InjectionDetector detector{builtin_injection_patterns()};
+
+    const dbgate_bench::AllocationCounter allocs;
+    for (auto _ : state) {
+        for (const auto& sql : sqls) {
+            auto result = detector.check(sql);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    allocs.report(state);
+    set_rates(state, sqls);
+}
+BENCHMARK(BM_InjectionDetectorCheck)->ArgName("orm")->Arg(0)->Arg(1);
+
+void BM_ProcedureDetectorDetect(benchmark::State& state) {
+    const auto& sqls = inputs(state);
+    const SqlParser parser;
+    const ProcedureDetector detector;
+
+    // 파싱 결과는 측정 밖에서 준비 (ParsedQuery 는 원문 버퍼를 빌린다)
+    std::vector<ParsedQuery> parsed;
+    for (const auto& sql : sqls) {
+        if (auto q = parser.parse(sql)) {
+            parsed.push_back(std::move(*q));
+        }
+    }
+
+    const dbgate_bench::AllocationCounter allocs;
+    for (auto _ : state) {
+        for (const auto& query : parsed) {
+            auto info = detector.detect(query);
+            benchmark::DoNotOptimize(info);
+        }
+    }
+    allocs.report(state);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(parsed.size()));
+}
+BENCHMARK(BM_ProcedureDetectorDetect)->ArgName("orm")->Arg(0)->Arg(1);
+
+}  // namespace
@@ -0,0 +1,70 @@
+// ---------------------------------------------------------------------------
+// bench_policy.cpp
+//
+// PolicyEngine::evaluate — access_control 룰 10 / 100 / 1000 개 정책.
+//   unbound: 쿼리마다 user/IP 룰 매칭 포함 (bind 이전 경로)
+//   bound  : 세션 PolicyBinding 사용 (핸드셰이크 후 세션 데이터패스와 같은 경로)
+// 허용 쿼리와 차단 쿼리(실행 권한 없는 테이블)를 번갈아 평가한다.
+// ---------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "common/types.hpp"
+#include "parser/sql_parser.hpp"
+#include "policy/policy_engine.hpp"
+
+namespace {
+
+constexpr std::array<std::string_view, 4> kQueries{
+    "SELECT u.name, o.total FROM users u JOIN orders o ON u.id = o.user_id WHERE u.id = 42",
+    "UPDATE orders SET status = 'shipped' WHERE id = 7",
+    "SELECT * FROM payroll WHERE employee_id = 3",  // 허용 목록 밖 테이블 → 차단
+    "DELETE FROM users WHERE id = 9",
+};
+
+SessionContext make_session(std::size_t rule_count) {
+    SessionContext session;
+    session.session_id = 1;
+    session.client_ip = "10.1.2.3";
+    session.client_port = 40000;
+    session.db_user = dbgate_bench::bench_user(rule_count);
+    session.db_name = "app";
+    session.handshake_done = true;
+    return session;
+}
+
+template <bool kBound>
+void BM_PolicyEngineEvaluate(benchmark::State& state) {
+    const auto rule_count = static_cast<std::size_t>(state.range(0));
+    const PolicyEngine engine{dbgate_bench::make_policy(rule_count)};
+    const SessionContext session = make_session(rule_count);
+    PolicyBinding binding;
+    engine.bind(session, binding);
+
+    const SqlParser parser;
+    std::vector<ParsedQuery> parsed;
+    for (const auto sql : kQueries) {
+        parsed.push_back(*parser.parse(sql));
+    }
+
+    const dbgate_bench::AllocationCounter allocs;
+    for (auto _ : state) {
+        for (const auto& query : parsed) {
+            auto result = engine.evaluate(query, session, kBound ? &binding : nullptr);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    allocs.report(state);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(parsed.size()));
+}
+BENCHMARK(BM_PolicyEngineEvaluate<false>)->Name("BM_PolicyEngineEvaluate/unbound")
+    ->ArgName("rules")->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_PolicyEngineEvaluate<true>)->Name("BM_PolicyEngineEvaluate/bound")
+    ->ArgName("rules")->Arg(10)->Arg(100)->Arg(1000);
+
+}  // namespace
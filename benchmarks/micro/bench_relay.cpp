@@ -0,0 +1,112 @@
+// ---------------------------------------------------------------------------
+// bench_relay.cpp
+//
+// 서버 응답 릴레이 루프의 코루틴 구조별 비용 (allocs/row).
+//   PacketFrameBuffer 에 이미 수신된 result set row N 개를 Session 과 같은 방식으로 걷는다.
+//   nested  : row 마다 중첩 awaitable 을 co_await (패킷당 코루틴 프레임)
+//   buffered: 버퍼에 있는 패킷은 동기 경로로 꺼내고, 비었을 때만 co_await
+//             (Session::take_buffered_server_packet / next_server_packet 구조)
+//   소켓 I/O 는 포함하지 않는다 — 코루틴 프레임 할당과 프레임 경계 판정만 측정한다.
+// ---------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "protocol/packet_frame_buffer.hpp"
+
+namespace {
+
+constexpr std::size_t kRowPayload = 48;  // 짧은 text row (컬럼 몇 개)
+
+std::vector<std::uint8_t> make_rows(std::size_t rows) {
+    std::vector<std::uint8_t> wire;
+    wire.reserve(rows * (4 + kRowPayload));
+    for (std::size_t i = 0; i < rows; ++i) {
+        wire.push_back(static_cast<std::uint8_t>(kRowPayload));
+        wire.push_back(0);
+        wire.push_back(0);
+        wire.push_back(static_cast<std::uint8_t>(i + 1));
+        for (std::size_t b = 0; b < kRowPayload; ++b) {
+            wire.push_back(static_cast<std::uint8_t>('a' + (b % 26)));
+        }
+    }
+    return wire;
+}
+
+std::optional<FrameHead> take(const PacketFrameBuffer& rx, std::size_t& pending) noexcept {
+    const auto view = rx.peek(pending);
+    if (!view) {
+        return std::nullopt;
+    }
+    pending += view->raw().size();
+    return FrameHead{.payload_length = view->payload_length(),
+                     .sequence_id = view->sequence_id(),
+                     .prefix = view->payload()};
+}
+
+// 수신 대기 경로 자리 (실제 세션은 여기서 flush + async_read_some)
+auto next_packet(const PacketFrameBuffer& rx, std::size_t& pending)
+    -> boost::asio::awaitable<std::optional<FrameHead>> {
+    co_return take(rx, pending);
+}
+
+template <bool kNested>
+auto walk(const PacketFrameBuffer& rx) -> boost::asio::awaitable<std::size_t> {
+    std::size_t pending = 0;
+    std::size_t rows = 0;
+    while (true) {
+        std::optional<FrameHead> pkt;
+        if constexpr (!kNested) {
+            pkt = take(rx, pending);
+        }
+        if (!pkt) {
+            pkt = co_await next_packet(rx, pending);
+        }
+        if (!pkt) {
+            break;
+        }
+        ++rows;
+    }
+    co_return rows;
+}
+
+template <bool kNested>
+void BM_RelayRowWalk(benchmark::State& state) {
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    const auto wire = make_rows(rows);
+    PacketFrameBuffer rx;
+    boost::asio::io_context ioc;
+    std::size_t walked = 0;
+
+    const dbgate_bench::AllocationCounter allocs;
+    for (auto _ : state) {
+        auto space = rx.prepare(wire.size());
+        std::memcpy(space.data(), wire.data(), wire.size());
+        rx.commit(wire.size());
+
+        boost::asio::co_spawn(ioc, walk<kNested>(rx), [&](std::exception_ptr, std::size_t n) {
+            walked = n;
+        });
+        ioc.run();
+        ioc.restart();
+        rx.consume(wire.size());
+    }
+    benchmark::DoNotOptimize(walked);
+    allocs.report(state, "allocs/row", static_cast<double>(rows));
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rows));
+}
+BENCHMARK(BM_RelayRowWalk<true>)->Name("BM_RelayRowWalk/nested")
+    ->ArgName("rows")->Arg(100)->Arg(10000);
+BENCHMARK(BM_RelayRowWalk<false>)->Name("BM_RelayRowWalk/buffered")
+    ->ArgName("rows")->Arg(100)->Arg(10000);
+
+}  // namespace
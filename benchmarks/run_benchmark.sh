@@ -1,17 +1,31 @@
 #!/usr/bin/env bash
 # =============================================================================
-# dbgate sysbench 벤치마크: 직접연결 vs 프록시
+# dbgate sysbench 벤치마크: 직접연결 vs 프록시 (+ 마이크로 벤치마크, 부하 생성기)
 #
 # 사용법:
 #   ./benchmarks/run_benchmark.sh [옵션]
+#   ./benchmarks/run_benchmark.sh --compare-only RESULT.json --baseline BASE.json
 #
 # 옵션:
-#   --threads N       sysbench 스레드 수 (기본: 4)
-#   --time N          실행 시간 초 (기본: 30)
-#   --table-size N    테이블 행 수 (기본: 10000)
-#   --tables N        테이블 수 (기본: 4)
-#   --skip-build      dbgate 빌드 건너뛰기
-#   --workloads LIST  콤마 구분 워크로드 (기본: oltp_read_only,oltp_read_write)
+#   --threads N         sysbench 스레드 수 (기본: 4)
+#   --time N            실행 시간 초 (기본: 30)
+#   --table-size N      테이블 행 수 (기본: 10000)
+#   --tables N          테이블 수 (기본: 4)
+#   --skip-build        dbgate 빌드 건너뛰기
+#   --workloads LIST    콤마 구분 워크로드 (기본: oltp_read_only,oltp_read_write)
+#   --skip-sysbench     sysbench 단계 건너뛰기 (MySQL 불필요)
+#   --micro             dbgate_bench 마이크로 벤치마크 실행
+#   --loadgen           dbgate_loadgen 프록시 오버헤드 측정 실행
+#   --flamegraph        프록시 경유 sysbench 구간 동안 perf 로 dbgate 프로파일 수집
+#   --baseline FILE     결과를 FILE 과 비교하여 회귀 판정 (회귀 시 종료 코드 3)
+#   --threshold PCT     회귀 판정 임계값 % (기본: 5)
+#   --save-baseline     이번 결과를 benchmarks/results/baseline.json 으로 저장
+#   --compare-only FILE 실행 없이 FILE 을 --baseline 과 비교만 한다
+#
+# 결과:
+#   benchmarks/results/latest.json            마지막 실행 결과
+#   benchmarks/results/history/<시각>-<커밋>.json  실행 기록 (환경 메타데이터 포함)
+#   benchmarks/results/flamegraph-<워크로드>.svg   --flamegraph (FlameGraph 도구가 있을 때)
 # =============================================================================
 set -euo pipefail
 
@@ -27,6 +41,14 @@ TABLE_SIZE=10000
 TABLES=4
 SKIP_BUILD=false
 WORKLOADS="oltp_read_only,oltp_read_write"
+SKIP_SYSBENCH=false
+RUN_MICRO=false
+RUN_LOADGEN=false
+FLAMEGRAPH=false
+BASELINE=""
+THRESHOLD=5
+SAVE_BASELINE=false
+COMPARE_ONLY=""
 
 MYSQL_HOST="${MYSQL_HOST:-127.0.0.1}"
 MYSQL_PORT="${MYSQL_PORT:-3306}"
@@ -38,10 +60,17 @@ PROXY_LISTEN_ADDR="${PROXY_LISTEN_ADDR:-127.0.0.1}"
 HEALTH_CHECK_PORT="${HEALTH_CHECK_PORT:-8084}"
 DBGATE_BIN="${DBGATE_BIN:-build/default/dbgate}"
 POLICY_PATH="${POLICY_PATH:-benchmarks/policy-benchmark.yaml}"
+BENCH_BIN_DIR="${BENCH_BIN_DIR:-build/bench}"
+FLAMEGRAPH_DIR="${FLAMEGRAPH_DIR:-}"   # stackcollapse-perf.pl / flamegraph.pl 위치 (없으면 PATH)
+PERF_FREQ="${PERF_FREQ:-99}"           # perf record 샘플링 주파수 (Hz)
+LOADGEN_CONNECTIONS="${LOADGEN_CONNECTIONS:-1000}"
+LOADGEN_ARGS="${LOADGEN_ARGS:-}"       # 추가 dbgate_loadgen 옵션 (예: --tcp-nodelay=0)
 RESULTS_DIR="benchmarks/results"
 
 DBGATE_PID=""
+PERF_PID=""
 DOCKER_STARTED=false
+SYSBENCH_PREPARED=false
 
 # ─── CLI 파싱 ─────────────────────────────────────────────────────────────────
 while [[ $# -gt 0 ]]; do
@@ -52,6 +81,14 @@ while [[ $# -gt 0 ]]; do
         --tables)     TABLES="$2";      shift 2 ;;
         --skip-build) SKIP_BUILD=true;  shift   ;;
         --workloads)  WORKLOADS="$2";   shift 2 ;;
+        --skip-sysbench) SKIP_SYSBENCH=true; shift ;;
+        --micro)      RUN_MICRO=true;   shift   ;;
+        --loadgen)    RUN_LOADGEN=true; shift   ;;
+        --flamegraph) FLAMEGRAPH=true;  shift   ;;
+        --baseline)   BASELINE="$2";    shift 2 ;;
+        --threshold)  THRESHOLD="$2";   shift 2 ;;
+        --save-baseline) SAVE_BASELINE=true; shift ;;
+        --compare-only)  COMPARE_ONLY="$2";  shift 2 ;;
         *)
             echo "알 수 없는 옵션: $1"
             exit 1
@@ -64,7 +101,14 @@ IFS=',' read -ra WORKLOAD_LIST <<< "$WORKLOADS"
 # ─── 전제조건 확인 ────────────────────────────────────────────────────────────
 check_prereqs() {
     local missing=()
-    for cmd in sysbench jq mysql; do
+    local required=(jq)
+    if [[ "$SKIP_SYSBENCH" == false ]]; then
+        required+=(sysbench mysql curl bc)
+    fi
+    if [[ "$FLAMEGRAPH" == true ]]; then
+        required+=(perf)
+    fi
+    for cmd in "${required[@]}"; do
         if ! command -v "$cmd" &>/dev/null; then
             missing+=("$cmd")
         fi
@@ -80,6 +124,12 @@ cleanup() {
     echo ""
     echo "=== 정리 ==="
 
+    # perf 수집 중단 (대상 프로세스보다 먼저)
+    if [[ -n "$PERF_PID" ]] && kill -0 "$PERF_PID" 2>/dev/null; then
+        kill -INT "$PERF_PID" 2>/dev/null || true
+        wait "$PERF_PID" 2>/dev/null || true
+    fi
+
     # dbgate 프로세스 종료
     if [[ -n "$DBGATE_PID" ]] && kill -0 "$DBGATE_PID" 2>/dev/null; then
         echo "  dbgate 종료 (PID=$DBGATE_PID)"
@@ -88,13 +138,15 @@ cleanup() {
     fi
 
     # sysbench cleanup
-    echo "  sysbench cleanup"
-    sysbench oltp_read_only \
-        --mysql-host="$MYSQL_HOST" --mysql-port="$MYSQL_PORT" \
-        --mysql-user="$MYSQL_USER" --mysql-password="$MYSQL_PASSWORD" \
-        --mysql-db="$MYSQL_DATABASE" \
-        --tables="$TABLES" --table-size="$TABLE_SIZE" \
-        cleanup 2>/dev/null || true
+    if [[ "$SYSBENCH_PREPARED" == true ]]; then
+        echo "  sysbench cleanup"
+        sysbench oltp_read_only \
+            --mysql-host="$MYSQL_HOST" --mysql-port="$MYSQL_PORT" \
+            --mysql-user="$MYSQL_USER" --mysql-password="$MYSQL_PASSWORD" \
+            --mysql-db="$MYSQL_DATABASE" \
+            --tables="$TABLES" --table-size="$TABLE_SIZE" \
+            cleanup 2>/dev/null || true
+    fi
 
     # Docker 정리 (우리가 시작한 경우만)
     if [[ "$DOCKER_STARTED" == true ]]; then
@@ -169,8 +221,193 @@ calc_overhead() {
     fi
 }
 
+# ─── 환경 메타데이터 (결과 비교 시 같은 조건인지 확인용) ──────────────────────
+collect_environment() {
+    local dirty=false
+    if [[ -n "$(git status --porcelain 2>/dev/null || true)" ]]; then
+        dirty=true
+    fi
+    jq -n \
+        --arg commit "$(git rev-parse HEAD 2>/dev/null || echo unknown)" \
+        --argjson dirty "$dirty" \
+        --arg kernel "$(uname -sr)" \
+        --arg cpu "$(grep -m1 'model name' /proc/cpuinfo 2>/dev/null | cut -d: -f2 | sed 's/^ *//' || true)" \
+        --argjson nproc "$(nproc)" \
+        --arg compiler "$("${CXX:-c++}" --version 2>/dev/null | head -1 || true)" \
+        '{
+            "git_commit": $commit,
+            "git_dirty": $dirty,
+            "kernel": $kernel,
+            "cpu_model": $cpu,
+            "cpu_count": $nproc,
+            "compiler": $compiler
+        }'
+}
+
+# ─── 마이크로 벤치마크 (stdout: 요약 JSON) ────────────────────────────────────
+run_micro() {
+    local bin="$BENCH_BIN_DIR/dbgate_bench"
+    local raw="$RESULTS_DIR/micro-raw.json"
+    if [[ ! -x "$bin" ]]; then
+        echo "ERROR: $bin 바이너리 없음" >&2
+        return 1
+    fi
+    "$bin" --benchmark_out="$raw" --benchmark_out_format=json >&2
+
+    # 벤치마크 이름 → ns 단위 시간 + allocs (Google Benchmark time_unit 정규화)
+    jq '
+        def to_ns: {"ns": 1, "us": 1000, "ms": 1000000, "s": 1000000000}[.time_unit // "ns"];
+        {
+            "library_build_type": .context.library_build_type,
+            "benchmarks": ([.benchmarks[]
+                | select((.run_type // "iteration") == "iteration")
+                | {
+                    key: .name,
+                    value: {
+                        "real_time_ns": (.real_time * to_ns),
+                        "cpu_time_ns": (.cpu_time * to_ns),
+                        "allocs": (.["allocs/op"] // .["allocs/row"])
+                    }
+                }] | from_entries)
+        }' "$raw"
+}
+
+# ─── 프록시 오버헤드 부하 생성기 (stdout: dbgate_loadgen JSON) ─────────────────
+run_loadgen() {
+    local bin="$BENCH_BIN_DIR/dbgate_loadgen"
+    local out="$RESULTS_DIR/loadgen-raw.json"
+    if [[ ! -x "$bin" ]]; then
+        echo "ERROR: $bin 바이너리 없음" >&2
+        return 1
+    fi
+    local rc=0
+    local -a extra=()
+    read -r -a extra <<< "$LOADGEN_ARGS"
+    "$bin" --connections="$LOADGEN_CONNECTIONS" --duration-sec="$TIME" \
+        --policy="$POLICY_PATH" --json="$out" ${extra[@]+"${extra[@]}"} >&2 || rc=$?
+    # 2: 연결 유지 실패 / 오류 응답 (결과는 기록하되 비교 무효로 표시)
+    if [[ $rc -ne 0 && $rc -ne 2 ]]; then
+        echo "ERROR: dbgate_loadgen 실패 (exit=$rc)" >&2
+        return 1
+    fi
+    jq --argjson valid "$([[ $rc -eq 0 ]] && echo true || echo false)" \
+        '. + {"valid": $valid}' "$out"
+}
+
+# ─── perf 프로파일 → flame graph ──────────────────────────────────────────────
+start_profile() {
+    local workload="$1"
+    perf record -F "$PERF_FREQ" -g -p "$DBGATE_PID" \
+        -o "$RESULTS_DIR/perf-${workload}.data" >/dev/null 2>&1 &
+    PERF_PID=$!
+}
+
+finish_profile() {
+    local workload="$1"
+    local data="$RESULTS_DIR/perf-${workload}.data"
+    local folded="$RESULTS_DIR/flamegraph-${workload}.folded"
+    local svg="$RESULTS_DIR/flamegraph-${workload}.svg"
+
+    if [[ -n "$PERF_PID" ]]; then
+        kill -INT "$PERF_PID" 2>/dev/null || true
+        wait "$PERF_PID" 2>/dev/null || true
+        PERF_PID=""
+    fi
+    if [[ ! -s "$data" ]]; then
+        echo "    WARN: perf 데이터 없음 (kernel.perf_event_paranoid 확인)"
+        return 0
+    fi
+
+    local collapse="stackcollapse-perf.pl"
+    local flame="flamegraph.pl"
+    if [[ -n "$FLAMEGRAPH_DIR" ]]; then
+        collapse="$FLAMEGRAPH_DIR/$collapse"
+        flame="$FLAMEGRAPH_DIR/$flame"
+    fi
+    if command -v "$collapse" &>/dev/null && command -v "$flame" &>/dev/null; then
+        perf script -i "$data" 2>/dev/null | "$collapse" > "$folded"
+        "$flame" --title "dbgate $workload" "$folded" > "$svg"
+        echo "    flame graph: $svg"
+    else
+        echo "    FlameGraph 도구 없음 — perf 데이터만 보관: $data (FLAMEGRAPH_DIR 설정)"
+    fi
+}
+
+# ─── baseline 비교 (회귀 시 3 반환) ───────────────────────────────────────────
+# 처리량(TPS/QPS)은 THRESHOLD% 초과 감소, 지연(p99)과 마이크로 벤치마크 시간은
+# THRESHOLD% 초과 증가를 회귀로 본다. 양쪽에 모두 있는 항목만 비교한다.
+compare_results() {
+    local current="$1"
+    local baseline="$2"
+    local rows
+    rows=$(jq -rn --slurpfile cur "$current" --slurpfile base "$baseline" \
+        --argjson t "$THRESHOLD" '
+        def metric($name; $old; $new; $worse):
+            select($old != null and $new != null and $old != 0)
+            | (($new - $old) / $old * 100) as $d
+            | [$name, $old, $new, $d,
+               (if $worse == "lower" then $d < -$t else $d > $t end)];
+        $cur[0] as $c | $base[0] as $b
+        | (
+            ($c.results // {} | to_entries[]) as $e
+            | ($b.results[$e.key] // null) as $o
+            | select($o != null)
+            | metric("sysbench/\($e.key) proxy.tps";
+                     $o.proxy.tps; $e.value.proxy.tps; "lower"),
+              metric("sysbench/\($e.key) proxy.p99_ms";
+                     $o.proxy.latency_p99_ms; $e.value.proxy.latency_p99_ms; "higher")
+          ),
+          (
+            ($c.micro.benchmarks // {} | to_entries[]) as $e
+            | ($b.micro.benchmarks[$e.key] // null) as $o
+            | select($o != null)
+            | metric("micro/\($e.key)"; $o.real_time_ns; $e.value.real_time_ns; "higher")
+          ),
+          (
+            select($c.loadgen.valid == true and $b.loadgen.valid == true)
+            | metric("loadgen proxied.qps";
+                     $b.loadgen.proxied.qps; $c.loadgen.proxied.qps; "lower"),
+              metric("loadgen proxied.p99_ns";
+                     $b.loadgen.proxied.p99_ns; $c.loadgen.proxied.p99_ns; "higher")
+          )
+        | @tsv')
+
+    echo ""
+    echo "=== baseline 비교: $current vs $baseline (임계값 ${THRESHOLD}%) ==="
+    printf "%-60s | %14s | %14s | %9s | %s\n" "항목" "baseline" "current" "변화" "판정"
+    local regressions=0
+    local name old new delta regressed mark
+    while IFS=$'\t' read -r name old new delta regressed; do
+        [[ -z "$name" ]] && continue
+        mark="ok"
+        if [[ "$regressed" == true ]]; then
+            mark="REGRESSION"
+            regressions=$((regressions + 1))
+        fi
+        printf "%-60s | %14.2f | %14.2f | %+8.1f%% | %s\n" "$name" "$old" "$new" "$delta" "$mark"
+    done <<< "$rows"
+
+    if [[ $regressions -gt 0 ]]; then
+        echo "  회귀 ${regressions}건 (임계값 ${THRESHOLD}% 초과)"
+        return 3
+    fi
+    echo "  회귀 없음"
+    return 0
+}
+
 # ─── 메인 ─────────────────────────────────────────────────────────────────────
 main() {
+    # 비교 전용 모드: 실행 없이 기존 결과 파일끼리 비교
+    if [[ -n "$COMPARE_ONLY" ]]; then
+        if [[ -z "$BASELINE" ]]; then
+            echo "ERROR: --compare-only 는 --baseline 이 필요합니다"
+            exit 1
+        fi
+        local rc=0
+        compare_results "$COMPARE_ONLY" "$BASELINE" || rc=$?
+        exit "$rc"
+    fi
+
     echo "=========================================="
     echo " dbgate sysbench 벤치마크"
     echo "=========================================="
@@ -181,7 +418,11 @@ main() {
     # 1. 전제조건 확인
     echo "=== 전제조건 확인 ==="
     check_prereqs
-    echo "  sysbench, jq, mysql 확인 완료"
+    echo "  필수 도구 확인 완료"
+    if [[ -n "$BASELINE" && ! -f "$BASELINE" ]]; then
+        echo "ERROR: baseline 파일 없음: $BASELINE"
+        exit 1
+    fi
 
     # 2. dbgate 빌드
     if [[ "$SKIP_BUILD" == false ]]; then
@@ -189,135 +430,164 @@ main() {
         echo "=== dbgate 빌드 ==="
         cmake --preset default 2>&1 | tail -1
         cmake --build build/default 2>&1 | tail -1
+        if [[ "$RUN_MICRO" == true || "$RUN_LOADGEN" == true ]]; then
+            cmake --preset bench 2>&1 | tail -1
+            cmake --build --preset bench --target dbgate_bench dbgate_loadgen 2>&1 | tail -1
+        fi
         echo "  빌드 완료"
     fi
 
-    if [[ ! -x "$DBGATE_BIN" ]]; then
+    if [[ "$SKIP_SYSBENCH" == false && ! -x "$DBGATE_BIN" ]]; then
         echo "ERROR: $DBGATE_BIN 바이너리 없음"
         exit 1
     fi
 
-    # 3. MySQL 준비
-    echo ""
-    echo "=== MySQL 준비 ==="
-    if mysql -h "$MYSQL_HOST" -P "$MYSQL_PORT" \
-             -u "$MYSQL_USER" -p"$MYSQL_PASSWORD" \
-             --connect-timeout=3 -e "SELECT 1" &>/dev/null; then
-        echo "  기존 MySQL 인스턴스 사용 ($MYSQL_HOST:$MYSQL_PORT)"
-    else
-        echo "  Docker로 MySQL 기동..."
-        docker compose -f benchmarks/docker-compose.benchmark.yml up -d
-        DOCKER_STARTED=true
-        wait_for_mysql
-    fi
-
-    # 데이터베이스 생성 (존재하지 않을 경우)
-    mysql -h "$MYSQL_HOST" -P "$MYSQL_PORT" \
-          -u root -prootpass \
-          --connect-timeout=5 \
-          -e "CREATE DATABASE IF NOT EXISTS $MYSQL_DATABASE" 2>/dev/null || true
-
-    # 4. sysbench prepare
-    echo ""
-    echo "=== sysbench prepare ==="
-    sysbench oltp_read_only \
-        --mysql-host="$MYSQL_HOST" --mysql-port="$MYSQL_PORT" \
-        --mysql-user="$MYSQL_USER" --mysql-password="$MYSQL_PASSWORD" \
-        --mysql-db="$MYSQL_DATABASE" \
-        --tables="$TABLES" --table-size="$TABLE_SIZE" \
-        prepare 2>&1 | tail -3
-    echo "  prepare 완료"
-
     # 결과 저장용
-    mkdir -p "$RESULTS_DIR"
+    mkdir -p "$RESULTS_DIR/history"
     local timestamp
     timestamp=$(date -u +"%Y-%m-%dT%H:%M:%SZ")
 
     # JSON 초기화
     local json_results="{}"
 
-    for workload in "${WORKLOAD_LIST[@]}"; do
+    if [[ "$SKIP_SYSBENCH" == true ]]; then
+        WORKLOAD_LIST=()
+    else
+        # 3. MySQL 준비
         echo ""
-        echo "=== 워크로드: $workload ==="
+        echo "=== MySQL 준비 ==="
+        if mysql -h "$MYSQL_HOST" -P "$MYSQL_PORT" \
+                 -u "$MYSQL_USER" -p"$MYSQL_PASSWORD" \
+                 --connect-timeout=3 -e "SELECT 1" &>/dev/null; then
+            echo "  기존 MySQL 인스턴스 사용 ($MYSQL_HOST:$MYSQL_PORT)"
+        else
+            echo "  Docker로 MySQL 기동..."
+            docker compose -f benchmarks/docker-compose.benchmark.yml up -d
+            DOCKER_STARTED=true
+            wait_for_mysql
+        fi
 
-        # 5. 직접 연결 벤치마크
-        read -r d_tps d_qps d_avg d_p95 d_p99 <<< \
-            "$(run_sysbench "$workload" "$MYSQL_HOST" "$MYSQL_PORT" "직접연결")"
-        echo "    TPS=$d_tps  QPS=$d_qps  avg=${d_avg}ms  P95=${d_p95}ms  P99=${d_p99}ms"
+        # 데이터베이스 생성 (존재하지 않을 경우)
+        mysql -h "$MYSQL_HOST" -P "$MYSQL_PORT" \
+              -u root -prootpass \
+              --connect-timeout=5 \
+              -e "CREATE DATABASE IF NOT EXISTS $MYSQL_DATABASE" 2>/dev/null || true
+
+        # 4. sysbench prepare
+        echo ""
+        echo "=== sysbench prepare ==="
+        sysbench oltp_read_only \
+            --mysql-host="$MYSQL_HOST" --mysql-port="$MYSQL_PORT" \
+            --mysql-user="$MYSQL_USER" --mysql-password="$MYSQL_PASSWORD" \
+            --mysql-db="$MYSQL_DATABASE" \
+            --tables="$TABLES" --table-size="$TABLE_SIZE" \
+            prepare 2>&1 | tail -3
+        SYSBENCH_PREPARED=true
+        echo "  prepare 완료"
+
+        for workload in "${WORKLOAD_LIST[@]}"; do
+            echo ""
+            echo "=== 워크로드: $workload ==="
+
+            # 5. 직접 연결 벤치마크
+            read -r d_tps d_qps d_avg d_p95 d_p99 <<< \
+                "$(run_sysbench "$workload" "$MYSQL_HOST" "$MYSQL_PORT" "직접연결")"
+            echo "    TPS=$d_tps  QPS=$d_qps  avg=${d_avg}ms  P95=${d_p95}ms  P99=${d_p99}ms"
+
+            # 6. 프록시 기동
+            if [[ -n "$DBGATE_PID" ]] && kill -0 "$DBGATE_PID" 2>/dev/null; then
+                kill "$DBGATE_PID" 2>/dev/null || true
+                wait "$DBGATE_PID" 2>/dev/null || true
+                DBGATE_PID=""
+            fi
+
+            MYSQL_HOST="$MYSQL_HOST" \
+            MYSQL_PORT="$MYSQL_PORT" \
+            PROXY_LISTEN_ADDR="$PROXY_LISTEN_ADDR" \
+            PROXY_LISTEN_PORT="$PROXY_PORT" \
+            POLICY_PATH="$POLICY_PATH" \
+            LOG_PATH="/tmp/dbgate-bench.log" \
+            LOG_LEVEL="warn" \
+            UDS_SOCKET_PATH="/tmp/dbgate-bench.sock" \
+            HEALTH_CHECK_PORT="$HEALTH_CHECK_PORT" \
+                "$DBGATE_BIN" &
+            DBGATE_PID=$!
+
+            # 헬스체크 대기
+            local ready=0
+            for i in $(seq 1 20); do
+                if curl -sf "http://127.0.0.1:${HEALTH_CHECK_PORT}/health" >/dev/null 2>&1; then
+                    ready=1; break
+                fi
+                sleep 0.5
+            done
+
+            if [[ $ready -eq 0 ]]; then
+                echo "  ERROR: dbgate 헬스체크 타임아웃"
+                exit 1
+            fi
 
-        # 6. 프록시 기동
-        if [[ -n "$DBGATE_PID" ]] && kill -0 "$DBGATE_PID" 2>/dev/null; then
+            # 7. 프록시 경유 벤치마크 (--flamegraph: 같은 구간 동안 perf 수집)
+            if [[ "$FLAMEGRAPH" == true ]]; then
+                start_profile "$workload"
+            fi
+            read -r p_tps p_qps p_avg p_p95 p_p99 <<< \
+                "$(run_sysbench "$workload" "127.0.0.1" "$PROXY_PORT" "프록시경유")"
+            echo "    TPS=$p_tps  QPS=$p_qps  avg=${p_avg}ms  P95=${p_p95}ms  P99=${p_p99}ms"
+            if [[ "$FLAMEGRAPH" == true ]]; then
+                finish_profile "$workload"
+            fi
+
+            # 프록시 종료
             kill "$DBGATE_PID" 2>/dev/null || true
             wait "$DBGATE_PID" 2>/dev/null || true
             DBGATE_PID=""
-        fi
 
-        MYSQL_HOST="$MYSQL_HOST" \
-        MYSQL_PORT="$MYSQL_PORT" \
-        PROXY_LISTEN_ADDR="$PROXY_LISTEN_ADDR" \
-        PROXY_LISTEN_PORT="$PROXY_PORT" \
-        POLICY_PATH="$POLICY_PATH" \
-        LOG_PATH="/tmp/dbgate-bench.log" \
-        LOG_LEVEL="warn" \
-        UDS_SOCKET_PATH="/tmp/dbgate-bench.sock" \
-        HEALTH_CHECK_PORT="$HEALTH_CHECK_PORT" \
-            "$DBGATE_BIN" &
-        DBGATE_PID=$!
-
-        # 헬스체크 대기
-        local ready=0
-        for i in $(seq 1 20); do
-            if curl -sf "http://127.0.0.1:${HEALTH_CHECK_PORT}/health" >/dev/null 2>&1; then
-                ready=1; break
-            fi
-            sleep 0.5
+            # 오버헤드 계산 (TPS는 낮을수록 나쁨 → 역방향)
+            local oh_tps oh_p95 oh_p99
+            oh_tps=$(calc_overhead "$d_tps" "$p_tps")
+            oh_p95=$(calc_overhead "$d_p95" "$p_p95")
+            oh_p99=$(calc_overhead "$d_p99" "$p_p99")
+
+            # JSON 결과 누적
+            json_results=$(echo "$json_results" | jq \
+                --arg wl "$workload" \
+                --argjson d_tps "$d_tps" --argjson d_qps "$d_qps" \
+                --argjson d_avg "$d_avg" --argjson d_p95 "$d_p95" --argjson d_p99 "$d_p99" \
+                --argjson p_tps "$p_tps" --argjson p_qps "$p_qps" \
+                --argjson p_avg "$p_avg" --argjson p_p95 "$p_p95" --argjson p_p99 "$p_p99" \
+                --argjson oh_tps "$oh_tps" --argjson oh_p95 "$oh_p95" --argjson oh_p99 "$oh_p99" \
+                '.[$wl] = {
+                    "direct": {
+                        "tps": $d_tps, "qps": $d_qps,
+                        "latency_avg_ms": $d_avg, "latency_p95_ms": $d_p95, "latency_p99_ms": $d_p99
+                    },
+                    "proxy": {
+                        "tps": $p_tps, "qps": $p_qps,
+                        "latency_avg_ms": $p_avg, "latency_p95_ms": $p_p95, "latency_p99_ms": $p_p99
+                    },
+                    "overhead": {
+                        "tps_percent": $oh_tps,
+                        "latency_p95_percent": $oh_p95,
+                        "latency_p99_percent": $oh_p99
+                    }
+                }')
         done
+    fi
 
-        if [[ $ready -eq 0 ]]; then
-            echo "  ERROR: dbgate 헬스체크 타임아웃"
-            exit 1
-        fi
-
-        # 7. 프록시 경유 벤치마크
-        read -r p_tps p_qps p_avg p_p95 p_p99 <<< \
-            "$(run_sysbench "$workload" "127.0.0.1" "$PROXY_PORT" "프록시경유")"
-        echo "    TPS=$p_tps  QPS=$p_qps  avg=${p_avg}ms  P95=${p_p95}ms  P99=${p_p99}ms"
-
-        # 프록시 종료
-        kill "$DBGATE_PID" 2>/dev/null || true
-        wait "$DBGATE_PID" 2>/dev/null || true
-        DBGATE_PID=""
-
-        # 오버헤드 계산 (TPS는 낮을수록 나쁨 → 역방향)
-        local oh_tps oh_p95 oh_p99
-        oh_tps=$(calc_overhead "$d_tps" "$p_tps")
-        oh_p95=$(calc_overhead "$d_p95" "$p_p95")
-        oh_p99=$(calc_overhead "$d_p99" "$p_p99")
-
-        # JSON 결과 누적
-        json_results=$(echo "$json_results" | jq \
-            --arg wl "$workload" \
-            --argjson d_tps "$d_tps" --argjson d_qps "$d_qps" \
-            --argjson d_avg "$d_avg" --argjson d_p95 "$d_p95" --argjson d_p99 "$d_p99" \
-            --argjson p_tps "$p_tps" --argjson p_qps "$p_qps" \
-            --argjson p_avg "$p_avg" --argjson p_p95 "$p_p95" --argjson p_p99 "$p_p99" \
-            --argjson oh_tps "$oh_tps" --argjson oh_p95 "$oh_p95" --argjson oh_p99 "$oh_p99" \
-            '.[$wl] = {
-                "direct": {
-                    "tps": $d_tps, "qps": $d_qps,
-                    "latency_avg_ms": $d_avg, "latency_p95_ms": $d_p95, "latency_p99_ms": $d_p99
-                },
-                "proxy": {
-                    "tps": $p_tps, "qps": $p_qps,
-                    "latency_avg_ms": $p_avg, "latency_p95_ms": $p_p95, "latency_p99_ms": $p_p99
-                },
-                "overhead": {
-                    "tps_percent": $oh_tps,
-                    "latency_p95_percent": $oh_p95,
-                    "latency_p99_percent": $oh_p99
-                }
-            }')
-    done
+    # 8. 마이크로 벤치마크 / 부하 생성기 (선택)
+    local micro_json="null"
+    local loadgen_json="null"
+    if [[ "$RUN_MICRO" == true ]]; then
+        echo ""
+        echo "=== 마이크로 벤치마크 (dbgate_bench) ==="
+        micro_json=$(run_micro)
+    fi
+    if [[ "$RUN_LOADGEN" == true ]]; then
+        echo ""
+        echo "=== 프록시 오버헤드 (dbgate_loadgen) ==="
+        loadgen_json=$(run_loadgen)
+    fi
 
     # 9. JSON 출력 생성
     local final_json
@@ -328,24 +598,34 @@ main() {
         --argjson table_size "$TABLE_SIZE" \
         --argjson tables "$TABLES" \
         --argjson results "$json_results" \
+        --argjson micro "$micro_json" \
+        --argjson loadgen "$loadgen_json" \
+        --argjson host "$(collect_environment)" \
         '{
             "timestamp": $ts,
-            "environment": {
+            "environment": ({
                 "threads": $threads,
                 "time_seconds": $time_sec,
                 "table_size": $table_size,
                 "tables": $tables
-            },
+            } + $host),
             "results": $results,
+            "micro": $micro,
+            "loadgen": $loadgen,
             "targets": {
                 "max_p95_overhead_percent": 10.0,
                 "min_tps": 1000
             }
         }')
 
+    local history_file
+    local commit
+    commit=$(git rev-parse --short HEAD 2>/dev/null || echo unknown)
+    history_file="$RESULTS_DIR/history/$(date -u +%Y%m%dT%H%M%SZ)-${commit}.json"
     echo "$final_json" > "$RESULTS_DIR/latest.json"
+    echo "$final_json" > "$history_file"
     echo ""
-    echo "=== JSON 결과 저장: $RESULTS_DIR/latest.json ==="
+    echo "=== JSON 결과 저장: $RESULTS_DIR/latest.json, $history_file ==="
 
     # 10. 콘솔 비교 테이블
     echo ""
@@ -420,6 +700,21 @@ main() {
         echo " 일부 성능 목표 미달 (FAIL)"
         echo "=========================================="
     fi
+
+    # 12. baseline 회귀 판정 (선택)
+    if [[ -n "$BASELINE" ]]; then
+        local rc=0
+        compare_results "$RESULTS_DIR/latest.json" "$BASELINE" || rc=$?
+        if [[ $rc -ne 0 ]]; then
+            exit "$rc"
+        fi
+    fi
+
+    # 회귀가 없을 때만 baseline 을 갱신한다
+    if [[ "$SAVE_BASELINE" == true ]]; then
+        cp "$RESULTS_DIR/latest.json" "$RESULTS_DIR/baseline.json"
+        echo "  baseline 갱신: $RESULTS_DIR/baseline.json"
+    fi
 }
 
 main "$@"
@@ -5,7 +5,7 @@
 //
 // 템플릿 메서드(async_read_some, async_write_some, async_handshake,
 // async_shutdown)는 헤더에 inline으로 구현되어 있다.
-// 여기서는 생성자, 소멸자, get_executor(), lowest_layer(), is_ssl()만 구현.
+// 여기서는 생성자, 소멸자, get_executor(), lowest_layer(), is_ssl(), TLS 조회만 구현.
 // ---------------------------------------------------------------------------
 
 // ─── 생성자 ─────────────────────────────────────────────────────────────────
@@ -14,6 +14,21 @@ AsyncStream::AsyncStream(tcp_socket socket) : stream_{std::move(socket)} {}
 
 AsyncStream::AsyncStream(ssl_socket ssl_stream) : stream_{std::move(ssl_stream)} {}
 
+AsyncStream::AsyncStream(KtlsStream ktls_stream) : stream_{std::move(ktls_stream)} {}
+
+// ─── make_tls ───────────────────────────────────────────────────────────────
+//   KtlsStream::create 는 성공 시에만 socket 을 가져가므로 실패하면 같은 소켓으로 폴백한다.
+
+auto AsyncStream::make_tls(tcp_socket socket, boost::asio::ssl::context& ctx, bool prefer_ktls)
+    -> AsyncStream {
+    if (prefer_ktls) {
+        if (auto ktls = KtlsStream::create(socket, ctx)) {
+            return AsyncStream{std::move(*ktls)};
+        }
+    }
+    return AsyncStream{ssl_socket{std::move(socket), ctx}};
+}
+
 // ─── 이동 생성자 / 이동 대입 ────────────────────────────────────────────────
 //
 // GCC는 Boost.Asio 소켓이 포함된 std::variant의 move 연산에서
@@ -52,7 +67,7 @@ auto AsyncStream::get_executor() -> executor_type {
 
 // ─── lowest_layer ───────────────────────────────────────────────────────────
 //   variant의 어느 타입이든 tcp::socket 참조를 반환한다.
-//   ssl::stream<tcp::socket>의 경우 next_layer()를 통해 접근.
+//   ssl::stream<tcp::socket> / KtlsStream 의 경우 next_layer()를 통해 접근.
 //   (ssl::stream::lowest_layer()는 basic_socket<>을 반환하지만
 //    tcp::socket = basic_stream_socket<>이므로 타입 불일치 — next_layer() 사용)
 
@@ -60,7 +75,7 @@ auto AsyncStream::lowest_layer() -> tcp_socket& {
     return std::visit(
         [](auto& s) -> tcp_socket& {
             using S = std::decay_t<decltype(s)>;
-            if constexpr (std::is_same_v<S, ssl_socket>) {
+            if constexpr (!std::is_same_v<S, tcp_socket>) {
                 return s.next_layer();
             } else {
                 return s;
@@ -72,5 +87,34 @@ auto AsyncStream::lowest_layer() -> tcp_socket& {
 // ─── is_ssl ─────────────────────────────────────────────────────────────────
 
 bool AsyncStream::is_ssl() const noexcept {
-    return std::holds_alternative<ssl_socket>(stream_);
+    return !std::holds_alternative<tcp_socket>(stream_);
+}
+
+// ─── native_ssl / kernel_send / kernel_recv ─────────────────────────────────
+
+SSL* AsyncStream::native_ssl() noexcept {
+    return std::visit(
+        [](auto& s) -> SSL* {
+            using S = std::decay_t<decltype(s)>;
+            if constexpr (std::is_same_v<S, tcp_socket>) {
+                return nullptr;
+            } else {
+                return s.native_handle();
+            }
+        },
+        stream_);
+}
+
+bool AsyncStream::kernel_send() const noexcept {
+    if (const auto* ktls = std::get_if<KtlsStream>(&stream_)) {
+        return ktls->ktls_send();
+    }
+    return std::holds_alternative<tcp_socket>(stream_);
+}
+
+bool AsyncStream::kernel_recv() const noexcept {
+    if (const auto* ktls = std::get_if<KtlsStream>(&stream_)) {
+        return ktls->ktls_recv() && !ktls->has_buffered_input();
+    }
+    return std::holds_alternative<tcp_socket>(stream_);
 }
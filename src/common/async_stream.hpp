@@ -7,6 +7,7 @@
 //   클라이언트↔프록시 구간 및 프록시↔MySQL 구간 양쪽 모두 TLS를 지원하기
 //   위해, tcp::socket과 ssl::stream<tcp::socket>을 std::variant로 보유하고
 //   통일된 async_read_some / async_write_some 인터페이스를 제공한다.
+//   kTLS 모드(SSL_KTLS_ENABLED)에서는 세 번째 대안인 KtlsStream(소켓 직결 OpenSSL)을 쓴다.
 //
 // 사용 패턴:
 //   // 평문 모드
@@ -15,6 +16,9 @@
 //   // TLS 모드
 //   AsyncStream stream{ssl::stream<tcp::socket>{std::move(tcp_socket), ssl_ctx}};
 //
+//   // TLS 모드 (kTLS 우선, SSL 객체 생성 실패 시 ssl::stream 폴백)
+//   auto stream = AsyncStream::make_tls(std::move(tcp_socket), ssl_ctx, /*prefer_ktls=*/true);
+//
 //   // 공통 읽기/쓰기 (co_await 사용)
 //   co_await async_read(stream, buffer, use_awaitable);
 //
@@ -33,8 +37,11 @@
 #include <boost/asio/ssl/stream_base.hpp>
 #include <boost/system/error_code.hpp>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
+#include "common/ktls_stream.hpp"
+
 // ---------------------------------------------------------------------------
 // AsyncStream
 // ---------------------------------------------------------------------------
@@ -54,6 +61,19 @@ public:
     // -----------------------------------------------------------------------
     explicit AsyncStream(ssl_socket ssl_stream);
 
+    // -----------------------------------------------------------------------
+    // 생성자 — KtlsStream (TLS 모드, kernel TLS offload 시도)
+    // -----------------------------------------------------------------------
+    explicit AsyncStream(KtlsStream ktls_stream);
+
+    // -----------------------------------------------------------------------
+    // make_tls
+    //   TLS 스트림 생성. prefer_ktls 이면 KtlsStream 을 만들고, 실패하면
+    //   ssl::stream(사용자 공간 TLS)으로 폴백한다. 핸드셰이크는 호출자가 수행.
+    // -----------------------------------------------------------------------
+    static auto make_tls(tcp_socket socket, boost::asio::ssl::context& ctx, bool prefer_ktls)
+        -> AsyncStream;
+
     // 이동 생성자 / 이동 대입
     AsyncStream(AsyncStream&&) noexcept;             // NOLINT(readability-named-parameter)
     AsyncStream& operator=(AsyncStream&&) noexcept;  // NOLINT(readability-named-parameter)
@@ -93,14 +113,14 @@ public:
     // -----------------------------------------------------------------------
     // async_handshake  (템플릿 — 헤더에 구현)
     //   평문 모드: no-op (boost::asio::post로 비동기 완료)
-    //   TLS  모드: ssl::stream::async_handshake 위임
+    //   TLS  모드: ssl::stream / KtlsStream::async_handshake 위임
     // -----------------------------------------------------------------------
     template <typename Token>
     auto async_handshake(boost::asio::ssl::stream_base::handshake_type type, Token&& token) {
         return std::visit(
             [&](auto& s) {
                 using S = std::decay_t<decltype(s)>;
-                if constexpr (std::is_same_v<S, ssl_socket>) {
+                if constexpr (!std::is_same_v<S, tcp_socket>) {
                     return s.async_handshake(type, std::forward<Token>(token));
                 } else {
                     // 평문 모드: 즉시 성공 반환 (비동기)
@@ -119,14 +139,14 @@ public:
     // -----------------------------------------------------------------------
     // async_shutdown  (템플릿 — 헤더에 구현)
     //   평문 모드: no-op (boost::asio::post로 비동기 완료)
-    //   TLS  모드: ssl::stream::async_shutdown 위임
+    //   TLS  모드: ssl::stream / KtlsStream::async_shutdown 위임
     // -----------------------------------------------------------------------
     template <typename Token>
     auto async_shutdown(Token&& token) {
         return std::visit(
             [&](auto& s) {
                 using S = std::decay_t<decltype(s)>;
-                if constexpr (std::is_same_v<S, ssl_socket>) {
+                if constexpr (!std::is_same_v<S, tcp_socket>) {
                     return s.async_shutdown(std::forward<Token>(token));
                 } else {
                     // 평문 모드: 즉시 성공 반환 (비동기)
@@ -142,6 +162,17 @@ public:
             stream_);
     }
 
+    // -----------------------------------------------------------------------
+    // visit  (템플릿 — 헤더에 구현)
+    //   실제 스트림 타입으로 f(stream&) 를 호출한다. 연산이 많은 구간(응답 릴레이 등)을
+    //   구체 타입으로 인스턴스화하여 연산마다의 variant 분기를 한 번으로 줄일 때 쓴다.
+    //   f 는 모든 대안에 대해 같은 타입을 반환해야 한다.
+    // -----------------------------------------------------------------------
+    template <typename F>
+    decltype(auto) visit(F&& f) {
+        return std::visit(std::forward<F>(f), stream_);
+    }
+
     // -----------------------------------------------------------------------
     // lowest_layer
     //   TCP 소켓 직접 참조 (connect / close / cancel / remote_endpoint 용)
@@ -154,6 +185,21 @@ public:
     // -----------------------------------------------------------------------
     [[nodiscard]] bool is_ssl() const noexcept;
 
+    // -----------------------------------------------------------------------
+    // native_ssl
+    //   OpenSSL SSL 객체 (SNI / 호스트명 검증 설정용). 평문 모드는 nullptr.
+    // -----------------------------------------------------------------------
+    [[nodiscard]] SSL* native_ssl() noexcept;
+
+    // -----------------------------------------------------------------------
+    // kernel_send / kernel_recv
+    //   소켓에 평문을 직접 쓰거나(읽어도) 되는지: 평문 모드, 또는 해당 방향 kTLS 활성.
+    //   true 이면 splice(2) 같은 소켓 직접 경로를 쓸 수 있다.
+    //   kernel_recv 는 OpenSSL 안에 아직 꺼내지 않은 수신 데이터가 있으면 false.
+    // -----------------------------------------------------------------------
+    [[nodiscard]] bool kernel_send() const noexcept;
+    [[nodiscard]] bool kernel_recv() const noexcept;
+
 private:
-    std::variant<tcp_socket, ssl_socket> stream_;
+    std::variant<tcp_socket, ssl_socket, KtlsStream> stream_;
 };
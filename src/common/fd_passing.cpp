@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------------
+// fd_passing.cpp
+// ---------------------------------------------------------------------------
+
+#include "common/fd_passing.hpp"
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+namespace {
+
+// fd 가 events 준비될 때까지 대기 (EINTR 재시도). false = 시간 초과 / 오류
+bool wait_ready(int fd, short events, std::chrono::milliseconds timeout) noexcept {
+    pollfd pfd{.fd = fd, .events = events, .revents = 0};
+    const auto wait_ms = static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(
+        timeout.count(), 0, 0x7FFFFFFF));
+    for (;;) {
+        const int rc = ::poll(&pfd, 1, wait_ms);
+        if (rc < 0 && errno == EINTR) {
+            continue;
+        }
+        return rc > 0;
+    }
+}
+
+}  // namespace
+
+std::array<char, 4> encode_frame_length(std::uint32_t length) noexcept {
+    return {static_cast<char>(length & 0xFFU),
+            static_cast<char>((length >> 8) & 0xFFU),
+            static_cast<char>((length >> 16) & 0xFFU),
+            static_cast<char>((length >> 24) & 0xFFU)};
+}
+
+std::uint32_t decode_frame_length(const std::array<char, 4>& header) noexcept {
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(header[0])) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(header[1])) << 8) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(header[2])) << 16) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(header[3])) << 24);
+}
+
+std::string errno_message(std::string_view what, int err) {
+    return std::string{what} + ": " + std::system_category().message(err);
+}
+
+auto send_all_with_timeout(int socket_fd,
+                           const char* data,
+                           std::size_t size,
+                           std::chrono::milliseconds timeout) -> std::expected<void, std::string> {
+    while (size > 0) {
+        const auto n = ::send(socket_fd, data, size, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if ((errno == EAGAIN || errno == EWOULDBLOCK) &&
+                wait_ready(socket_fd, POLLOUT, timeout)) {
+                continue;
+            }
+            return std::unexpected(errno_message("send", errno));
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return {};
+}
+
+auto try_send_with_fds(int socket_fd, std::span<const char> data, std::span<const int> fds)
+    -> std::expected<std::size_t, std::string> {
+    if (fds.empty() || fds.size() > kMaxHandoffFds) {
+        return std::unexpected(std::string{"invalid fd count"});
+    }
+    if (data.empty()) {
+        return std::unexpected(std::string{"empty frame"});
+    }
+
+    std::array<char, CMSG_SPACE(sizeof(int) * kMaxHandoffFds)> control{};
+    // sendmsg 는 iov 를 읽기만 한다 (iovec 가 const 를 표현하지 못할 뿐)
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    iovec iov{.iov_base = const_cast<char*>(data.data()), .iov_len = data.size()};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.data();
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+    std::memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+
+    for (;;) {
+        const auto n = ::sendmsg(socket_fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n >= 0) {
+            return static_cast<std::size_t>(n);
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
+        }
+        return std::unexpected(errno_message("sendmsg(SCM_RIGHTS)", errno));
+    }
+}
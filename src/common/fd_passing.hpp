@@ -0,0 +1,54 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// fd_passing.hpp
+//
+// UDS 프레임([4byte LE 길이][body]) 송신과 SCM_RIGHTS fd 전달 primitive.
+//
+// [설계 의도]
+// 리스너 인계(proxy/listener_handoff.hpp)의 요청 측은 proxy, 응답 측은 stats(UdsServer)에 있다.
+// 두 모듈이 같은 프레임 형식을 쓰되 stats 가 proxy 에 의존하지 않도록 (모듈 방향
+// common → ... → proxy ← stats) 소켓 수준 송신 코드를 common 에 둔다.
+// ---------------------------------------------------------------------------
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+
+// 프레임 하나에 실어 보내는 fd 최대 수 (프록시 리스너 + Health Check 리스너)
+inline constexpr std::size_t kMaxHandoffFds = 2;
+
+// 프레임 길이 헤더 (4byte LE)
+[[nodiscard]] std::array<char, 4> encode_frame_length(std::uint32_t length) noexcept;
+[[nodiscard]] std::uint32_t decode_frame_length(const std::array<char, 4>& header) noexcept;
+
+// "<what>: <strerror(err)>"
+[[nodiscard]] std::string errno_message(std::string_view what, int err);
+
+// ---------------------------------------------------------------------------
+// send_all_with_timeout
+//   size 바이트를 모두 쓴다. non-blocking 소켓이면 쓰기 가능해질 때까지 timeout 만큼 poll 한다.
+// ---------------------------------------------------------------------------
+[[nodiscard]] auto send_all_with_timeout(int socket_fd,
+                                         const char* data,
+                                         std::size_t size,
+                                         std::chrono::milliseconds timeout)
+    -> std::expected<void, std::string>;
+
+// ---------------------------------------------------------------------------
+// try_send_with_fds
+//   연결된 UDS(socket_fd)에 data 를 sendmsg 한 번으로 쓰면서 fds 를 SCM_RIGHTS 로 붙인다.
+//   기다리지 않는다 (MSG_DONTWAIT): 소켓 버퍼가 차 있으면 0 을 반환하고 fd 도 보내지 않는다.
+//   1 바이트 이상 나갔으면 fd 도 함께 전달된 것이므로, 나머지 data 는 일반 쓰기로 이어 보낸다.
+//   보낸 fd 는 상대 프로세스에 복제되며, 이쪽의 fd 는 그대로 열려 있다.
+//   호출자(UdsServer)는 0 이면 소켓 쓰기 가능을 비동기로 기다린 뒤 다시 호출한다.
+// ---------------------------------------------------------------------------
+[[nodiscard]] auto try_send_with_fds(int socket_fd,
+                                     std::span<const char> data,
+                                     std::span<const int> fds)
+    -> std::expected<std::size_t, std::string>;
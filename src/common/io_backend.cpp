@@ -0,0 +1,23 @@
+// ---------------------------------------------------------------------------
+// io_backend.cpp
+// ---------------------------------------------------------------------------
+
+#include "common/io_backend.hpp"
+
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+#include <liburing.h>
+
+#include <cstring>
+#endif
+
+auto probe_io_backend() -> std::expected<void, std::string> {
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    io_uring ring{};
+    const int rc = ::io_uring_queue_init(8, &ring, 0);
+    if (rc < 0) {
+        return std::unexpected(std::string{"io_uring_setup: "} + std::strerror(-rc));
+    }
+    ::io_uring_queue_exit(&ring);
+#endif
+    return {};
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// io_backend.hpp
+//
+// 빌드에 들어간 Boost.Asio I/O 백엔드 이름과 기동 시 사용 가능 여부 확인.
+//
+// [설계 의도]
+// Asio 는 백엔드를 컴파일 시에 고른다. DBGATE_ENABLE_IO_URING=ON 빌드는
+// BOOST_ASIO_HAS_IO_URING + BOOST_ASIO_DISABLE_EPOLL 로 소켓 읽기/쓰기/accept 를 포함한 모든
+// 비동기 연산을 io_uring 으로 보낸다 (ADR-008). 세션 / 릴레이 코드는 바뀌지 않는다.
+// 같은 바이너리에서 epoll 로 되돌릴 수 없으므로, 커널이나 seccomp 정책이 io_uring 을 막으면
+// 첫 소켓 연산에서 터지기 전에 기동 단계에서 명확한 오류로 멈춘다 (fail-close).
+// ---------------------------------------------------------------------------
+
+#include <boost/asio/detail/config.hpp>
+#include <expected>
+#include <string>
+#include <string_view>
+
+// "io_uring", "epoll", "kqueue", "select" 중 하나
+[[nodiscard]] constexpr std::string_view io_backend_name() noexcept {
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    return "io_uring";
+#elif defined(BOOST_ASIO_HAS_EPOLL)
+    return "epoll";
+#elif defined(BOOST_ASIO_HAS_KQUEUE)
+    return "kqueue";
+#else
+    return "select";
+#endif
+}
+
+// io_uring 빌드: 링을 한 번 만들어 보고 실패 사유를 돌려준다. 다른 백엔드는 항상 성공.
+[[nodiscard]] auto probe_io_backend() -> std::expected<void, std::string>;
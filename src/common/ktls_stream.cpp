@@ -0,0 +1,131 @@
+#include "common/ktls_stream.hpp"
+
+#include <openssl/bio.h>
+#include <openssl/err.h>
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/ssl/error.hpp>
+#include <cerrno>
+
+// ---------------------------------------------------------------------------
+// KtlsStream — 비템플릿 메서드 구현
+//
+// 각 do_* 는 OpenSSL 호출 1회만 수행한다. 대기/재시도는 헤더의 async_run 이 맡는다.
+// 호출 전 ERR_clear_error() 로 스레드 오류 큐를 비워 이전 연산의 오류가 섞이지 않게 한다.
+// ---------------------------------------------------------------------------
+
+auto KtlsStream::create(tcp_socket& socket, boost::asio::ssl::context& ctx)
+    -> std::expected<KtlsStream, std::string> {
+    std::unique_ptr<SSL, SslDeleter> ssl{SSL_new(ctx.native_handle())};
+    if (!ssl) {
+        return std::unexpected(std::string{"SSL_new failed"});
+    }
+
+    boost::system::error_code ec;
+    socket.native_non_blocking(true, ec);
+    if (ec) {
+        return std::unexpected("failed to set non-blocking socket: " + ec.message());
+    }
+    if (SSL_set_fd(ssl.get(), socket.native_handle()) != 1) {
+        return std::unexpected(std::string{"SSL_set_fd failed"});
+    }
+
+    // 부분 쓰기 허용: SSL_write 가 레코드 일부만 보내고 WANT_WRITE 를 돌려줄 수 있다.
+    // 재시도 시 버퍼 주소가 달라도 된다 (async_write 의 consuming_buffers).
+    SSL_set_mode(ssl.get(), SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+#if defined(SSL_OP_ENABLE_KTLS)
+    SSL_set_options(ssl.get(), SSL_OP_ENABLE_KTLS);
+#endif
+    return KtlsStream{std::move(socket), ssl.release()};
+}
+
+KtlsStream::KtlsStream(tcp_socket socket, SSL* ssl) noexcept
+    : socket_{std::move(socket)}, ssl_{ssl} {}
+
+bool KtlsStream::ktls_send() const noexcept {
+    return BIO_get_ktls_send(SSL_get_wbio(ssl_.get())) != 0;
+}
+
+bool KtlsStream::ktls_recv() const noexcept {
+    return BIO_get_ktls_recv(SSL_get_rbio(ssl_.get())) != 0;
+}
+
+bool KtlsStream::has_buffered_input() const noexcept {
+    return SSL_pending(ssl_.get()) > 0 || SSL_has_pending(ssl_.get()) != 0;
+}
+
+auto KtlsStream::do_handshake() noexcept -> StepResult {
+    ERR_clear_error();
+    const int rc = SSL_do_handshake(ssl_.get());
+    if (rc == 1) {
+        return StepResult{};
+    }
+    return classify(rc);
+}
+
+auto KtlsStream::do_read(boost::asio::mutable_buffer buffer) noexcept -> StepResult {
+    if (buffer.size() == 0) {
+        return StepResult{};
+    }
+    ERR_clear_error();
+    std::size_t n = 0;
+    const int rc = SSL_read_ex(ssl_.get(), buffer.data(), buffer.size(), &n);
+    if (rc == 1) {
+        return StepResult{.bytes = n};
+    }
+    return classify(rc);
+}
+
+auto KtlsStream::do_write(boost::asio::const_buffer buffer) noexcept -> StepResult {
+    if (buffer.size() == 0) {
+        return StepResult{};
+    }
+    ERR_clear_error();
+    std::size_t n = 0;
+    const int rc = SSL_write_ex(ssl_.get(), buffer.data(), buffer.size(), &n);
+    if (rc == 1) {
+        return StepResult{.bytes = n};
+    }
+    return classify(rc);
+}
+
+auto KtlsStream::do_shutdown() noexcept -> StepResult {
+    ERR_clear_error();
+    // 0: close_notify 전송 완료, 상대 close_notify 는 기다리지 않는다
+    const int rc = SSL_shutdown(ssl_.get());
+    if (rc >= 0) {
+        return StepResult{};
+    }
+    return classify(rc);
+}
+
+auto KtlsStream::classify(int rc) const noexcept -> StepResult {
+    switch (SSL_get_error(ssl_.get(), rc)) {
+        case SSL_ERROR_WANT_READ:
+            return StepResult{.step = Step::kWantRead};
+        case SSL_ERROR_WANT_WRITE:
+            return StepResult{.step = Step::kWantWrite};
+        case SSL_ERROR_ZERO_RETURN:
+            return StepResult{.ec = boost::asio::error::eof};
+        case SSL_ERROR_SYSCALL:
+            if (ERR_peek_error() == 0) {
+                // errno == 0: close_notify 없이 TCP EOF (ssl::stream 과 같은 오류로 보고)
+                if (errno != 0) {
+                    return StepResult{.ec = {errno, boost::system::system_category()}};
+                }
+                return StepResult{.ec = boost::asio::ssl::error::stream_truncated};
+            }
+            break;
+        default:
+            break;
+    }
+
+    const unsigned long err = ERR_get_error();
+#if defined(SSL_R_UNEXPECTED_EOF_WHILE_READING)
+    if (ERR_GET_REASON(err) == SSL_R_UNEXPECTED_EOF_WHILE_READING) {
+        return StepResult{.ec = boost::asio::ssl::error::stream_truncated};
+    }
+#endif
+    return StepResult{.ec = boost::system::error_code{static_cast<int>(err),
+                                                      boost::asio::error::get_ssl_category()}};
+}
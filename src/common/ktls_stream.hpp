@@ -0,0 +1,195 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// ktls_stream.hpp  —  KtlsStream: 소켓 직결 OpenSSL 스트림 (kernel TLS offload)
+//
+// 설계 목적:
+//   boost::asio::ssl::stream 은 OpenSSL 을 메모리 BIO 로 구동하므로 레코드 암복호화가
+//   항상 사용자 공간에서 일어나고, OpenSSL 의 kTLS(SSL_OP_ENABLE_KTLS)도 켜지지 않는다.
+//   KtlsStream 은 SSL 객체를 소켓 fd 에 직접 붙이고(SSL_set_fd) kTLS 를 요청한다.
+//   핸드셰이크 후 OpenSSL 이 세션 키를 커널에 넘기면(방향별) 이후 그 방향의 레코드
+//   암복호화는 커널이 수행하고, SSL_read / SSL_write 는 소켓 평문 I/O 로 바뀐다.
+//
+// 폴백:
+//   OpenSSL 빌드가 kTLS 를 지원하지 않거나, 커널 tls 모듈이 없거나, cipher 가 지원되지
+//   않으면 해당 방향은 그대로 사용자 공간 TLS 로 동작한다 (동작은 동일, 성능만 차이).
+//   ktls_send() / ktls_recv() 로 방향별 활성 여부를 확인한다.
+//
+// 비동기 모델:
+//   소켓은 non-blocking. SSL_* 호출이 WANT_READ / WANT_WRITE 를 돌려주면
+//   tcp::socket::async_wait 로 준비를 기다린 뒤 같은 호출을 다시 시도한다.
+//   첫 시도에서 바로 끝난 연산도 post 로 완료하여 initiating 함수 안에서 핸들러를
+//   호출하지 않는다 (asio 완료 규칙).
+//
+// 주의:
+//   - 이동 전용. 비동기 연산 진행 중 이동 금지 (ssl::stream 과 동일).
+//   - 읽기 1개 + 쓰기 1개까지 동시에 진행 가능 (같은 strand 에서 번갈아 실행).
+//   - next_layer() 소켓을 닫아도 SSL 객체는 fd 를 닫지 않는다 (BIO_NOCLOSE).
+// ---------------------------------------------------------------------------
+
+#include <openssl/ssl.h>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/asio/ssl/stream_base.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+class KtlsStream {
+public:
+    using executor_type = boost::asio::any_io_executor;
+    using tcp_socket = boost::asio::ip::tcp::socket;
+
+    // -----------------------------------------------------------------------
+    // create
+    //   ctx 로 SSL 객체를 만들어 socket 에 붙이고 kTLS 를 요청한다.
+    //   성공 시에만 socket 을 가져간다. SSL 객체/BIO 생성 실패 시 오류 문자열이며
+    //   socket 은 그대로 남는다 (호출자는 같은 소켓으로 ssl::stream 폴백).
+    // -----------------------------------------------------------------------
+    static auto create(tcp_socket& socket, boost::asio::ssl::context& ctx)
+        -> std::expected<KtlsStream, std::string>;
+
+    KtlsStream(KtlsStream&&) noexcept = default;
+    KtlsStream& operator=(KtlsStream&&) noexcept = default;
+    KtlsStream(const KtlsStream&) = delete;
+    KtlsStream& operator=(const KtlsStream&) = delete;
+    ~KtlsStream() = default;
+
+    auto get_executor() -> executor_type { return socket_.get_executor(); }
+    auto next_layer() -> tcp_socket& { return socket_; }
+
+    // SNI / 호스트명 검증 설정용 (핸드셰이크 전)
+    [[nodiscard]] SSL* native_handle() const noexcept { return ssl_.get(); }
+
+    // 방향별 kTLS 활성 여부 (핸드셰이크 후 의미 있음)
+    [[nodiscard]] bool ktls_send() const noexcept;
+    [[nodiscard]] bool ktls_recv() const noexcept;
+
+    // OpenSSL 이 아직 돌려주지 않은 수신 데이터(복호화된 평문 또는 처리 전 레코드)가 있는지.
+    // 있으면 소켓을 직접 읽는 경로(splice)는 쓸 수 없다.
+    [[nodiscard]] bool has_buffered_input() const noexcept;
+
+    // -----------------------------------------------------------------------
+    // 비동기 연산 (ssl::stream 과 같은 시그니처)
+    // -----------------------------------------------------------------------
+    template <typename Token>
+    auto async_handshake(boost::asio::ssl::stream_base::handshake_type type, Token&& token) {
+        if (type == boost::asio::ssl::stream_base::client) {
+            SSL_set_connect_state(ssl_.get());
+        } else {
+            SSL_set_accept_state(ssl_.get());
+        }
+        return async_run<false>([this] { return do_handshake(); }, std::forward<Token>(token));
+    }
+
+    template <typename MutableBufferSequence, typename ReadToken>
+    auto async_read_some(const MutableBufferSequence& buffers, ReadToken&& token) {
+        const auto buffer = first_nonempty<boost::asio::mutable_buffer>(buffers);
+        return async_run<true>([this, buffer] { return do_read(buffer); },
+                               std::forward<ReadToken>(token));
+    }
+
+    template <typename ConstBufferSequence, typename WriteToken>
+    auto async_write_some(const ConstBufferSequence& buffers, WriteToken&& token) {
+        const auto buffer = first_nonempty<boost::asio::const_buffer>(buffers);
+        return async_run<true>([this, buffer] { return do_write(buffer); },
+                               std::forward<WriteToken>(token));
+    }
+
+    template <typename Token>
+    auto async_shutdown(Token&& token) {
+        return async_run<false>([this] { return do_shutdown(); }, std::forward<Token>(token));
+    }
+
+private:
+    struct SslDeleter {
+        void operator()(SSL* ssl) const noexcept { SSL_free(ssl); }
+    };
+
+    // SSL_* 1회 시도 결과
+    enum class Step : std::uint8_t { kDone, kWantRead, kWantWrite };
+    struct StepResult {
+        Step step{Step::kDone};
+        std::size_t bytes{0};
+        boost::system::error_code ec{};
+    };
+
+    KtlsStream(tcp_socket socket, SSL* ssl) noexcept;
+
+    auto do_handshake() noexcept -> StepResult;
+    auto do_read(boost::asio::mutable_buffer buffer) noexcept -> StepResult;
+    auto do_write(boost::asio::const_buffer buffer) noexcept -> StepResult;
+    auto do_shutdown() noexcept -> StepResult;
+
+    // SSL_get_error 결과를 StepResult 로 변환
+    auto classify(int rc) const noexcept -> StepResult;
+
+    template <typename Buffer, typename BufferSequence>
+    static auto first_nonempty(const BufferSequence& buffers) -> Buffer {
+        const auto end = boost::asio::buffer_sequence_end(buffers);
+        for (auto it = boost::asio::buffer_sequence_begin(buffers); it != end; ++it) {
+            const Buffer buffer(*it);
+            if (buffer.size() != 0) {
+                return buffer;
+            }
+        }
+        return Buffer{};
+    }
+
+    // -----------------------------------------------------------------------
+    // async_run
+    //   attempt() 를 WANT_READ / WANT_WRITE 가 아닐 때까지 반복한다.
+    //   kWithSize: 완료 시그니처 void(error_code, size_t) (읽기/쓰기) 또는 void(error_code).
+    // -----------------------------------------------------------------------
+    template <bool kWithSize, typename Attempt, typename Token>
+    auto async_run(Attempt attempt, Token&& token) {
+        using Signature = std::conditional_t<kWithSize,
+                                             void(boost::system::error_code, std::size_t),
+                                             void(boost::system::error_code)>;
+        enum class Phase : std::uint8_t { kStart, kWaiting, kPosted };
+        return boost::asio::async_compose<Token, Signature>(
+            [this, attempt, phase = Phase::kStart, result = StepResult{}](
+                auto& self, boost::system::error_code wait_ec = {}) mutable {
+                if (phase != Phase::kPosted) {
+                    if (phase == Phase::kWaiting && wait_ec) {
+                        result = StepResult{.ec = wait_ec};
+                    } else {
+                        result = attempt();
+                        if (result.step != Step::kDone) {
+                            phase = Phase::kWaiting;
+                            socket_.async_wait(result.step == Step::kWantRead
+                                                   ? tcp_socket::wait_read
+                                                   : tcp_socket::wait_write,
+                                               std::move(self));
+                            return;
+                        }
+                    }
+                    if (phase == Phase::kStart) {
+                        phase = Phase::kPosted;
+                        boost::asio::post(socket_.get_executor(), std::move(self));
+                        return;
+                    }
+                }
+                if constexpr (kWithSize) {
+                    self.complete(result.ec, result.bytes);
+                } else {
+                    self.complete(result.ec);
+                }
+            },
+            token,
+            socket_);
+    }
+
+    tcp_socket socket_;
+    std::unique_ptr<SSL, SslDeleter> ssl_;
+};
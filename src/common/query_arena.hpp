@@ -0,0 +1,162 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// query_arena.hpp
+//
+// 쿼리 1건 처리(fingerprint → parse → detect → evaluate) 동안의 scratch 메모리.
+// 헤더 전용.
+//
+// [설계 의도]
+// 커맨드마다 만들어졌다 버려지는 작은 객체들(테이블명 뷰 벡터, fingerprint 문자열,
+// 정규화 테이블명 등)을 전역 allocator 대신 세션 소유 블록에서 bump 할당한다.
+// 블록은 reset() 후에도 보관하므로 정상 상태(steady state)에서는 전역 할당이 없다.
+//
+// [수명 규칙]
+// - reset() 은 이 arena 에서 할당한 모든 메모리를 한꺼번에 무효화한다.
+//   arena 를 쓰는 객체(ParsedQuery, std::pmr::string 등)는 reset() 전에 파괴되어야 한다.
+//   세션은 커맨드 블록 맨 앞에 Scope 를 두어 블록 안의 객체가 먼저 파괴되게 한다.
+// - deallocate 는 no-op 이다 (monotonic). 한 커맨드 안에서 재할당이 반복되어도
+//   reset() 전까지 메모리가 회수되지 않는다.
+// - kMaxRetainedBytes 를 넘는 블록은 reset() 에서 반환한다 (대용량 쿼리 1건 때문에
+//   세션이 큰 블록을 계속 쥐고 있지 않도록).
+// - 세션 strand 안에서만 쓰므로 스레드 안전하지 않다.
+// ---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+class QueryArena final : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t kInitialBlockBytes = 4096;
+    static constexpr std::size_t kMaxRetainedBytes = 64 * 1024;
+
+    // 첫 할당 전에는 블록을 만들지 않는다 (쿼리를 보내지 않는 세션은 비용 없음)
+    QueryArena() = default;
+
+    ~QueryArena() override {
+        for (const auto& block : blocks_) {
+            upstream()->deallocate(block.data, block.size, kBlockAlign);
+        }
+    }
+
+    QueryArena(const QueryArena&) = delete;
+    QueryArena& operator=(const QueryArena&) = delete;
+    QueryArena(QueryArena&&) = delete;
+    QueryArena& operator=(QueryArena&&) = delete;
+
+    // reset: 모든 할당을 무효화하고 보관 블록의 처음부터 다시 할당한다
+    void reset() noexcept {
+        std::size_t retained = 0;
+        std::size_t keep = 0;
+        for (; keep < blocks_.size(); ++keep) {
+            if (keep > 0 && retained + blocks_[keep].size > kMaxRetainedBytes) {
+                break;
+            }
+            retained += blocks_[keep].size;
+        }
+        for (std::size_t i = keep; i < blocks_.size(); ++i) {
+            upstream()->deallocate(blocks_[i].data, blocks_[i].size, kBlockAlign);
+        }
+        blocks_.resize(keep);
+        current_ = 0;
+        offset_ = 0;
+    }
+
+    // retained_bytes: 보관 중인 블록 크기 합
+    [[nodiscard]] std::size_t retained_bytes() const noexcept {
+        std::size_t total = 0;
+        for (const auto& block : blocks_) {
+            total += block.size;
+        }
+        return total;
+    }
+
+    // block_allocations: 전역 allocator 에서 블록을 받아온 누적 횟수 (관측/테스트용)
+    [[nodiscard]] std::uint64_t block_allocations() const noexcept { return block_allocations_; }
+
+    // -----------------------------------------------------------------------
+    // Scope
+    //   파괴 시 arena 를 reset 한다. arena 를 쓰는 객체보다 먼저 선언해야 한다.
+    // -----------------------------------------------------------------------
+    class Scope {
+    public:
+        explicit Scope(QueryArena& arena) noexcept : arena_{arena} {}
+        ~Scope() { arena_.reset(); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(Scope&&) = delete;
+
+    private:
+        QueryArena& arena_;
+    };
+
+private:
+    static constexpr std::size_t kBlockAlign = alignof(std::max_align_t);
+
+    struct Block {
+        void* data{nullptr};
+        std::size_t size{0};
+    };
+
+    [[nodiscard]] static std::pmr::memory_resource* upstream() noexcept {
+        return std::pmr::new_delete_resource();
+    }
+
+    // try_bump: blocks_[index] 의 offset 부터 bytes 를 잘라낸다 (공간이 없으면 nullptr)
+    [[nodiscard]] void* try_bump(std::size_t index,
+                                 std::size_t offset,
+                                 std::size_t bytes,
+                                 std::size_t alignment) noexcept {
+        const auto& block = blocks_[index];
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data);
+        const auto mask = static_cast<std::uintptr_t>(alignment) - 1;
+        const auto aligned = (base + offset + mask) & ~mask;
+        const auto begin = static_cast<std::size_t>(aligned - base);
+        if (begin > block.size || block.size - begin < bytes) {
+            return nullptr;
+        }
+        current_ = index;
+        offset_ = begin + bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (!blocks_.empty()) {
+            if (void* p = try_bump(current_, offset_, bytes, alignment)) {
+                return p;
+            }
+            for (std::size_t i = current_ + 1; i < blocks_.size(); ++i) {
+                if (void* p = try_bump(i, 0, bytes, alignment)) {
+                    return p;
+                }
+            }
+        }
+
+        const std::size_t last = blocks_.empty() ? 0 : blocks_.back().size;
+        // 과정렬 요청도 새 블록 안에 들어가도록 alignment 만큼 여유를 둔다
+        const std::size_t size = std::max({kInitialBlockBytes, last * 2, bytes + alignment});
+        blocks_.reserve(blocks_.size() + 1);
+        void* data = upstream()->allocate(size, kBlockAlign);
+        blocks_.push_back(Block{.data = data, .size = size});
+        ++block_allocations_;
+        return try_bump(blocks_.size() - 1, 0, bytes, alignment);
+    }
+
+    void do_deallocate(void* /*p*/, std::size_t /*bytes*/, std::size_t /*alignment*/) override {
+        // monotonic: reset() 에서 한꺼번에 회수한다
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::vector<Block> blocks_{};
+    std::size_t current_{0};
+    std::size_t offset_{0};
+    std::uint64_t block_allocations_{0};
+};
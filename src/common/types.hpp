@@ -19,6 +19,24 @@ struct SessionContext {
     bool          handshake_done{false};   // MySQL 핸드셰이크 완료 여부
 };
 
+// ---------------------------------------------------------------------------
+// SessionState
+//   Session 의 생명주기 상태를 나타낸다. (SessionRegistry 가 세션 목록에 노출)
+//
+//   kHandshaking     : MySQL 핸드셰이크 진행 중
+//   kReady           : 핸드셰이크 완료, 커맨드 수신 대기 중
+//   kProcessingQuery : COM_QUERY 처리 중 (정책 판정 / 릴레이 진행 중)
+//   kClosing         : Graceful Shutdown 진행 중 (새 쿼리 거부)
+//   kClosed          : 세션 완전 종료
+// ---------------------------------------------------------------------------
+enum class SessionState : std::uint8_t {
+    kHandshaking = 0,
+    kReady = 1,
+    kProcessingQuery = 2,
+    kClosing = 3,
+    kClosed = 4,
+};
+
 // ---------------------------------------------------------------------------
 // ParseErrorCode
 //   SQL 파싱 단계에서 발생 가능한 오류 분류.
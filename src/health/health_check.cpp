@@ -7,13 +7,19 @@
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/redirect_error.hpp>
 #include <boost/asio/use_awaitable.hpp>
 #include <boost/asio/write.hpp>
+#include <cctype>
 #include <format>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "stats/metrics_exporter.hpp"
 #include "stats/stats_collector.hpp"
 
 // ---------------------------------------------------------------------------
@@ -22,6 +28,11 @@
 // GET /health 에 대해:
 //   - kHealthy   -> HTTP 200 + {"status":"ok"}
 //   - kUnhealthy -> HTTP 503 + {"status":"unhealthy","reason":"..."}
+//   - kDraining  -> HTTP 503 + {"status":"draining","reason":"..."}
+// GET /metrics 에 대해:
+//   - 토큰 미설정   -> HTTP 404 (비활성)
+//   - Bearer 불일치 -> HTTP 401
+//   - 일치          -> HTTP 200 + OpenMetrics 텍스트
 // 기타 경로  -> HTTP 404 + {"status":"not found"}
 // 응답 후 소켓 즉시 close.
 //
@@ -30,8 +41,46 @@
 //   (max_connections 는 ProxyServer 가 주입, HealthCheck 는 StatsCollector 만 참조)
 // ---------------------------------------------------------------------------
 
+// ---------------------------------------------------------------------------
+// HealthCheckMetrics
+//   /metrics 공유 상태. 렌더 버퍼는 free list 로 재사용한다
+//   (scrape 마다 수십 KB 를 새로 할당하지 않음, 동시 scrape 시에만 추가 버퍼 생성).
+// ---------------------------------------------------------------------------
+struct HealthCheckMetrics {
+    static constexpr std::size_t kBufferReserve = 32 * 1024;
+    static constexpr std::size_t kMaxPooledBuffers = 4;
+
+    std::string bearer_token;
+    std::mutex mutex;
+    std::vector<std::string> free_buffers;
+
+    std::string acquire() {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            if (!free_buffers.empty()) {
+                auto buf = std::move(free_buffers.back());
+                free_buffers.pop_back();
+                return buf;
+            }
+        }
+        std::string buf;
+        buf.reserve(kBufferReserve);
+        return buf;
+    }
+
+    void release(std::string buf) {
+        const std::lock_guard<std::mutex> lock{mutex};
+        if (free_buffers.size() < kMaxPooledBuffers) {
+            free_buffers.push_back(std::move(buf));
+        }
+    }
+};
+
 namespace {
 
+// /metrics 요청 헤더 최대 크기 (Prometheus scrape 헤더 + Authorization)
+constexpr std::size_t kMaxRequestSize = 4096;
+
 // -----------------------------------------------------------------------
 // HTTP 응답 빌더 헬퍼
 // -----------------------------------------------------------------------
@@ -51,24 +100,165 @@ std::string make_http_response(int status_code,
         body);
 }
 
+// -----------------------------------------------------------------------
+// is_request_for
+//   요청 줄이 "GET <path> " 또는 "GET <path>?" 로 시작하는지 확인한다.
+// -----------------------------------------------------------------------
+bool is_request_for(std::string_view req, std::string_view path) {
+    constexpr std::string_view kGet = "GET ";
+    if (!req.starts_with(kGet) || !req.substr(kGet.size()).starts_with(path)) {
+        return false;
+    }
+    const auto next = kGet.size() + path.size();
+    return next < req.size() && (req[next] == ' ' || req[next] == '?');
+}
+
+// -----------------------------------------------------------------------
+// find_header
+//   헤더 이름(대소문자 무시)에 해당하는 값을 반환한다 (앞뒤 공백 제거).
+//   없으면 빈 문자열.
+// -----------------------------------------------------------------------
+std::string_view find_header(std::string_view req, std::string_view name) {
+    std::size_t pos = req.find("\r\n");
+    while (pos != std::string_view::npos) {
+        const auto start = pos + 2;
+        const auto end = req.find("\r\n", start);
+        if (end == std::string_view::npos || end == start) {
+            break;  // 헤더 끝 또는 잘린 줄
+        }
+        const auto line = req.substr(start, end - start);
+        const auto colon = line.find(':');
+        if (colon == name.size()) {
+            bool same = true;
+            for (std::size_t i = 0; i < colon && same; ++i) {
+                same = std::tolower(static_cast<unsigned char>(line[i])) ==
+                       std::tolower(static_cast<unsigned char>(name[i]));
+            }
+            if (same) {
+                auto value = line.substr(colon + 1);
+                while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+                    value.remove_prefix(1);
+                }
+                while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+                    value.remove_suffix(1);
+                }
+                return value;
+            }
+        }
+        pos = end;
+    }
+    return {};
+}
+
+// -----------------------------------------------------------------------
+// bearer_matches
+//   "Bearer <token>" 검증. 토큰 비교는 길이 외 정보가 새지 않도록 상수 시간.
+// -----------------------------------------------------------------------
+bool bearer_matches(std::string_view authorization, std::string_view expected) {
+    constexpr std::string_view kScheme = "bearer ";
+    if (expected.empty() || authorization.size() <= kScheme.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < kScheme.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(authorization[i])) != kScheme[i]) {
+            return false;
+        }
+    }
+    const auto token = authorization.substr(kScheme.size());
+    if (token.size() != expected.size()) {
+        return false;
+    }
+    unsigned char diff = 0;
+    for (std::size_t i = 0; i < token.size(); ++i) {
+        diff |= static_cast<unsigned char>(token[i] ^ expected[i]);
+    }
+    return diff == 0;
+}
+
+// -----------------------------------------------------------------------
+// serve_metrics
+//   인증 확인 후 OpenMetrics 응답을 보낸다.
+//   본문은 재사용 버퍼에 렌더링하고 헤더와 함께 scatter-gather 로 전송한다.
+// -----------------------------------------------------------------------
+auto serve_metrics(boost::asio::ip::tcp::socket& socket,
+                   std::string_view req,
+                   const std::shared_ptr<StatsCollector>& stats,
+                   const std::shared_ptr<HealthCheckMetrics>& metrics)
+    -> boost::asio::awaitable<void> {
+    boost::system::error_code ec;
+
+    if (!metrics || metrics->bearer_token.empty() || !stats) {
+        const auto response = make_http_response(404, "Not Found", R"({"status":"not found"})");
+        co_await boost::asio::async_write(
+            socket,
+            boost::asio::buffer(response),
+            boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        co_return;
+    }
+
+    if (!bearer_matches(find_header(req, "authorization"), metrics->bearer_token)) {
+        spdlog::warn("[health_check] /metrics unauthorized request");
+        const std::string_view body{R"({"status":"unauthorized"})"};
+        const auto response = std::format(
+            "HTTP/1.0 401 Unauthorized\r\n"
+            "Content-Type: application/json\r\n"
+            "WWW-Authenticate: Bearer\r\n"
+            "Content-Length: {}\r\n"
+            "Connection: close\r\n"
+            "\r\n"
+            "{}",
+            body.size(),
+            body);
+        co_await boost::asio::async_write(
+            socket,
+            boost::asio::buffer(response),
+            boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        co_return;
+    }
+
+    auto body = metrics->acquire();
+    render_openmetrics(stats->snapshot(), stats->rule_blocks(), body);
+
+    const auto header = std::format(
+        "HTTP/1.0 200 OK\r\n"
+        "Content-Type: {}\r\n"
+        "Content-Length: {}\r\n"
+        "Connection: close\r\n"
+        "\r\n",
+        kOpenMetricsContentType,
+        body.size());
+    const std::array<boost::asio::const_buffer, 2> buffers{boost::asio::buffer(header),
+                                                           boost::asio::buffer(body)};
+    co_await boost::asio::async_write(
+        socket, buffers, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        spdlog::debug("[health_check] metrics write error: {}", ec.message());
+    }
+    metrics->release(std::move(body));
+}
+
 // -----------------------------------------------------------------------
 // handle_connection
 //   단일 HTTP 연결을 처리하는 코루틴.
 //   요청 첫 줄만 읽어 경로를 판별하고 응답 후 소켓 close.
+//   /metrics 는 Authorization 헤더가 필요하므로 헤더 끝(빈 줄)까지 읽는다.
+//   status/unhealthy_reason 은 accept 시점의 값 스냅샷이다
+//   (멀티스레드 io_context 에서 HealthCheck 멤버를 참조로 공유하지 않는다).
 // -----------------------------------------------------------------------
 auto handle_connection(boost::asio::ip::tcp::socket socket,
-                       const HealthStatus& status,
-                       const std::string& unhealthy_reason,
-                       const std::shared_ptr<StatsCollector>& stats)
+                       HealthStatus status,
+                       std::string unhealthy_reason,
+                       std::shared_ptr<StatsCollector> stats,
+                       std::shared_ptr<HealthCheckMetrics> metrics)
     -> boost::asio::awaitable<void> {
-    // 요청 읽기 버퍼 (첫 줄만 필요: "GET /health HTTP/1.0\r\n" 수준)
-    std::array<char, 512> buf{};
+    // 요청 읽기 버퍼 (/health 는 첫 줄만, /metrics 는 헤더 전체)
+    std::array<char, kMaxRequestSize> buf{};
     boost::system::error_code ec;
 
     // Boost.Asio coroutine 내부 경로에서 clang-analyzer가 오탐을 내는 케이스가 있어
     // 해당 라인에 한해 경고를 제한한다.
     // NOLINTNEXTLINE(clang-analyzer-core.NullDereference)
-    const std::size_t n = co_await socket.async_read_some(
+    std::size_t n = co_await socket.async_read_some(
         boost::asio::buffer(buf), boost::asio::redirect_error(boost::asio::use_awaitable, ec));
 
     if (ec) {
@@ -76,6 +266,24 @@ auto handle_connection(boost::asio::ip::tcp::socket socket,
         co_return;
     }
 
+    if (is_request_for(std::string_view{buf.data(), n}, "/metrics")) {
+        while (std::string_view{buf.data(), n}.find("\r\n\r\n") == std::string_view::npos &&
+               n < buf.size()) {
+            n += co_await socket.async_read_some(
+                boost::asio::buffer(buf.data() + n, buf.size() - n),
+                boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+            if (ec) {
+                spdlog::debug("[health_check] read error: {}", ec.message());
+                co_return;
+            }
+        }
+        // 헤더가 버퍼를 넘으면 Authorization 을 놓칠 수 있다 → find_header 실패 → 401
+        co_await serve_metrics(socket, std::string_view{buf.data(), n}, stats, metrics);
+        (void)socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+        (void)socket.close(ec);
+        co_return;
+    }
+
     const std::string_view req{buf.data(), n};
     const bool is_get_health = (req.find("GET /health") != std::string_view::npos);
 
@@ -93,8 +301,11 @@ auto handle_connection(boost::asio::ip::tcp::socket socket,
             response = make_http_response(200, "OK", body);
         } else {
             // reason 이 비어있으면 기본 메시지 사용
+            const bool draining = status == HealthStatus::kDraining;
             const std::string safe_reason =
-                unhealthy_reason.empty() ? "service unavailable" : unhealthy_reason;
+                !unhealthy_reason.empty() ? unhealthy_reason
+                : draining                ? "draining"
+                                          : "service unavailable";
 
             // JSON 내부 따옴표 이스케이프 (간단 구현 — 제어문자 없음 가정)
             std::string escaped;
@@ -109,8 +320,9 @@ auto handle_connection(boost::asio::ip::tcp::socket socket,
                 }
             }
 
-            const std::string body =
-                std::format(R"({{"status":"unhealthy","reason":"{}"}})", escaped);
+            const std::string body = std::format(R"({{"status":"{}","reason":"{}"}})",
+                                                 draining ? "draining" : "unhealthy",
+                                                 escaped);
             response = make_http_response(503, "Service Unavailable", body);
         }
     } else {
@@ -149,24 +361,43 @@ auto handle_connection(boost::asio::ip::tcp::socket socket,
 
 HealthCheck::HealthCheck(std::uint16_t port,
                          std::shared_ptr<StatsCollector> stats,
-                         boost::asio::io_context& io_context)
-    : port_{port}, stats_{std::move(stats)}, io_context_{io_context}, unhealthy_reason_{} {}
+                         boost::asio::io_context& io_context,
+                         std::string metrics_token)
+    : port_{port},
+      stats_{std::move(stats)},
+      io_context_{io_context},
+      strand_{boost::asio::make_strand(io_context)},
+      acceptor_{strand_},
+      metrics_{std::make_shared<HealthCheckMetrics>()} {
+    metrics_->bearer_token = std::move(metrics_token);
+    if (!metrics_->bearer_token.empty()) {
+        // 첫 scrape 용 버퍼를 미리 확보해 둔다
+        metrics_->release(metrics_->acquire());
+    }
+}
 
 auto HealthCheck::run() -> boost::asio::awaitable<void> {
-    const auto endpoint = boost::asio::ip::tcp::endpoint{boost::asio::ip::tcp::v4(), port_};
-
-    boost::asio::ip::tcp::acceptor acceptor{io_context_, endpoint};
-    acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
-
-    spdlog::info("[health_check] listening on port {}", port_);
+    if (adopted_fd_ >= 0) {
+        // 인계받은 리스너: 이전 프로세스가 bind/listen 한 소켓을 그대로 쓴다
+        acceptor_.assign(boost::asio::ip::tcp::v4(), std::exchange(adopted_fd_, -1));
+        spdlog::info("[health_check] listening on port {} (inherited listener)", port_);
+    } else {
+        const auto endpoint = boost::asio::ip::tcp::endpoint{boost::asio::ip::tcp::v4(), port_};
+        acceptor_.open(endpoint.protocol());
+        acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+        acceptor_.bind(endpoint);
+        acceptor_.listen();
+        spdlog::info("[health_check] listening on port {}", port_);
+    }
+    listener_fd_.store(acceptor_.native_handle(), std::memory_order_release);
 
     while (true) {
         boost::system::error_code ec;
-        auto socket = co_await acceptor.async_accept(
+        auto socket = co_await acceptor_.async_accept(
             boost::asio::redirect_error(boost::asio::use_awaitable, ec));
 
         if (ec) {
-            if (ec == boost::asio::error::operation_aborted) {
+            if (ec == boost::asio::error::operation_aborted || !acceptor_.is_open()) {
                 // acceptor가 닫힘 — 정상 종료
                 spdlog::info("[health_check] acceptor closed, stopping");
                 break;
@@ -176,23 +407,51 @@ auto HealthCheck::run() -> boost::asio::awaitable<void> {
         }
 
         // 각 연결을 독립 코루틴으로 처리 (응답 후 즉시 close)
+        std::string reason;
+        {
+            const std::lock_guard<std::mutex> lock{reason_mutex_};
+            reason = unhealthy_reason_;
+        }
         boost::asio::co_spawn(
             io_context_,
-            handle_connection(std::move(socket), status_, unhealthy_reason_, stats_),
+            handle_connection(std::move(socket), status(), std::move(reason), stats_, metrics_),
             boost::asio::detached);
     }
 }
 
+void HealthCheck::stop_accepting() {
+    listener_fd_.store(-1, std::memory_order_release);
+    boost::asio::post(strand_, [this]() {
+        boost::system::error_code ec;
+        acceptor_.close(ec);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+    });
+}
+
+// 상태 전이는 reason_mutex_ 안에서 한다 (kDraining 확인과 덮어쓰기가 경합하지 않도록)
 void HealthCheck::set_unhealthy(std::string_view reason) {
+    const std::lock_guard<std::mutex> lock{reason_mutex_};
+    if (status_.load(std::memory_order_acquire) == HealthStatus::kDraining) {
+        return;
+    }
     unhealthy_reason_ = std::string{reason};
-    status_ = HealthStatus::kUnhealthy;
+    status_.store(HealthStatus::kUnhealthy, std::memory_order_release);
 }
 
 void HealthCheck::set_healthy() {
+    const std::lock_guard<std::mutex> lock{reason_mutex_};
+    if (status_.load(std::memory_order_acquire) == HealthStatus::kDraining) {
+        return;
+    }
     unhealthy_reason_.clear();
-    status_ = HealthStatus::kHealthy;
+    status_.store(HealthStatus::kHealthy, std::memory_order_release);
+}
+
+void HealthCheck::set_draining(std::string_view reason) {
+    const std::lock_guard<std::mutex> lock{reason_mutex_};
+    unhealthy_reason_ = std::string{reason};
+    status_.store(HealthStatus::kDraining, std::memory_order_release);
 }
 
 auto HealthCheck::status() const noexcept -> HealthStatus {
-    return status_;
+    return status_.load(std::memory_order_acquire);
 }
@@ -2,9 +2,13 @@
 
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/strand.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 
@@ -12,6 +16,7 @@
 // Forward declarations
 // ---------------------------------------------------------------------------
 class StatsCollector;
+struct HealthCheckMetrics;  // /metrics 인증 토큰 + 재사용 버퍼 (health_check.cpp)
 
 // ---------------------------------------------------------------------------
 // HealthStatus
@@ -19,10 +24,13 @@ class StatsCollector;
 //
 //   kHealthy   : 정상 동작 중 (HTTP 200 반환)
 //   kUnhealthy : 비정상 상태 (HTTP 503 반환)
+//   kDraining  : drain 중 — 기존 세션만 마무리하고 새 연결을 받지 않는다 (HTTP 503 반환).
+//                되돌릴 수 없다 (set_healthy / set_unhealthy 가 덮어쓰지 않음).
 // ---------------------------------------------------------------------------
 enum class HealthStatus : std::uint8_t {
     kHealthy   = 0,
     kUnhealthy = 1,
+    kDraining  = 2,
 };
 
 // ---------------------------------------------------------------------------
@@ -32,9 +40,15 @@ enum class HealthStatus : std::uint8_t {
 //   GET /health 요청에 대해 현재 HealthStatus 에 따라 응답한다.
 //   - kHealthy   -> 200 OK  + JSON body {"status":"ok"}
 //   - kUnhealthy -> 503 Service Unavailable + JSON body {"status":"unhealthy","reason":"..."}
+//   - kDraining  -> 503 Service Unavailable + JSON body {"status":"draining","reason":"..."}
 //
 //   과부하 / 업스트림 연결 실패 등의 상황에서 set_unhealthy() 를 호출하면
 //   로드밸런서가 해당 인스턴스를 라우팅 대상에서 제외할 수 있다.
+//
+//   GET /metrics 는 StatsSnapshot / 단계별 지연 / 규칙별 차단 카운터를 OpenMetrics
+//   텍스트로 반환한다 (Prometheus scrape 용).
+//   - metrics_token 이 비어 있으면 비활성 (404) — 인증 없는 노출 금지 (fail-close)
+//   - "Authorization: Bearer <metrics_token>" 이 일치하지 않으면 401
 // ---------------------------------------------------------------------------
 class HealthCheck {
 public:
@@ -43,10 +57,12 @@ public:
     //   port       : Health Check HTTP 서버 리슨 포트 (config 에서 주입)
     //   stats      : 통계 수집기 (shared 소유권, 상태 응답에 포함 가능)
     //   io_context : Boost.Asio io_context (코루틴 실행에 사용)
+    //   metrics_token : /metrics Bearer 토큰 (빈 문자열 = /metrics 비활성)
     // -----------------------------------------------------------------------
     HealthCheck(std::uint16_t                   port,
                 std::shared_ptr<StatsCollector> stats,
-                boost::asio::io_context&        io_context);
+                boost::asio::io_context&        io_context,
+                std::string                     metrics_token = {});
 
     ~HealthCheck() = default;
 
@@ -63,16 +79,46 @@ public:
     // -----------------------------------------------------------------------
     auto run() -> boost::asio::awaitable<void>;
 
+    // executor
+    //   acceptor 를 소유하는 strand. 멀티스레드 io_context 에서는 run() 을 이 위에서 spawn 해야
+    //   stop_accepting() 의 acceptor 정리와 accept 루프가 직렬화된다.
+    [[nodiscard]] auto executor() const -> boost::asio::any_io_executor { return strand_; }
+
+    // -----------------------------------------------------------------------
+    // adopt_listener
+    //   run() 이 bind 하지 않고 이미 listen 중인 fd 로 accept 한다 (리스너 인계,
+    //   proxy/listener_handoff.hpp 참조). run() 전에 호출한다. fd 소유권을 가져간다.
+    // -----------------------------------------------------------------------
+    void adopt_listener(int fd) noexcept { adopted_fd_ = fd; }
+
+    // listener_fd
+    //   listen 중인 소켓 fd (run() 이 bind/adopt 하기 전이나 stop_accepting() 후에는 -1).
+    //   인계 시 상대 프로세스로 복제해 보낸다.
+    [[nodiscard]] int listener_fd() const noexcept {
+        return listener_fd_.load(std::memory_order_acquire);
+    }
+
+    // stop_accepting
+    //   acceptor 를 닫아 run() 을 끝낸다 (진행 중인 응답은 그대로 마친다). 임의 스레드에서 호출 가능.
+    void stop_accepting();
+
+    // -----------------------------------------------------------------------
+    // set_draining
+    //   상태를 kDraining 으로 전환한다 (이후 set_healthy / set_unhealthy 는 무시된다).
+    //   로드밸런서가 503 을 보고 새 트래픽을 다른 인스턴스로 옮긴다.
+    // -----------------------------------------------------------------------
+    void set_draining(std::string_view reason);
+
     // -----------------------------------------------------------------------
     // set_unhealthy
-    //   상태를 kUnhealthy 로 전환한다.
+    //   상태를 kUnhealthy 로 전환한다 (kDraining 이면 무시).
     //   reason : HTTP 응답 body 에 포함할 사유 문자열
     // -----------------------------------------------------------------------
     void set_unhealthy(std::string_view reason);
 
     // -----------------------------------------------------------------------
     // set_healthy
-    //   상태를 kHealthy 로 복구한다.
+    //   상태를 kHealthy 로 복구한다 (kDraining 이면 무시).
     // -----------------------------------------------------------------------
     void set_healthy();
 
@@ -87,6 +133,15 @@ private:
     std::uint16_t                   port_;
     std::shared_ptr<StatsCollector> stats_;
     boost::asio::io_context&        io_context_;
-    HealthStatus                    status_{HealthStatus::kHealthy};
+    // strand_/acceptor_: accept 루프와 stop_accepting() 을 직렬화한다
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+    boost::asio::ip::tcp::acceptor  acceptor_;
+    int                             adopted_fd_{-1};
+    std::atomic<int>                listener_fd_{-1};
+    // status_/unhealthy_reason_ 는 accept 루프(워커 스레드)와 HTTP 핸들러가 동시에 접근한다.
+    std::atomic<HealthStatus>       status_{HealthStatus::kHealthy};
+    mutable std::mutex              reason_mutex_;
     std::string                     unhealthy_reason_{};
+    // 연결 코루틴이 HealthCheck 보다 오래 살 수 있어 shared 소유권으로 넘긴다.
+    std::shared_ptr<HealthCheckMetrics> metrics_;
 };
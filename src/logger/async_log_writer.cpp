@@ -0,0 +1,257 @@
+// ---------------------------------------------------------------------------
+// async_log_writer.cpp
+//
+// bounded MPSC 큐 + 전용 writer 스레드 구현.
+// ---------------------------------------------------------------------------
+
+#include "logger/async_log_writer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+// 생산자가 kBlock 대기 중 양보(yield)만 하는 횟수. 이후에는 짧게 잠든다.
+constexpr int kBlockSpinLimit = 64;
+constexpr std::chrono::microseconds kBlockSleep{50};
+
+}  // namespace
+
+AsyncLogWriter::AsyncLogWriter(std::shared_ptr<spdlog::logger> sink_logger,
+                               AsyncLogOptions options,
+                               std::shared_ptr<spdlog::logger> audit_logger)
+    : sink_logger_{std::move(sink_logger)},
+      options_{std::move(options)},
+      audit_logger_{std::move(audit_logger)},
+      cells_{std::make_unique<Cell[]>(  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+          std::bit_ceil(std::max<std::size_t>(options_.queue_capacity, 2)))},
+      mask_{std::bit_ceil(std::max<std::size_t>(options_.queue_capacity, 2)) - 1} {
+    options_.flush_batch = std::max<std::size_t>(options_.flush_batch, 1);
+    if (options_.flush_interval.count() <= 0) {
+        options_.flush_interval = std::chrono::milliseconds{1};
+    }
+    for (std::size_t i = 0; i <= mask_; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    stopping_.store(true, std::memory_order_release);
+    {
+        const std::lock_guard<std::mutex> lock{wake_mutex_};
+        wake_cv_.notify_one();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// submit
+// ---------------------------------------------------------------------------
+bool AsyncLogWriter::submit(int level, std::string line, bool preserve, LogChannel channel) {
+    Entry entry{.level = level,
+                .channel = channel,
+                .logged_at = std::chrono::system_clock::now(),
+                .line = std::move(line)};
+
+    if (preserve || options_.overflow_policy == LogOverflowPolicy::kBlock) {
+        push_blocking(entry);
+        wake_writer();
+        return true;
+    }
+
+    if (options_.overflow_policy == LogOverflowPolicy::kSample && !admit_under_pressure()) {
+        record_drop();
+        return false;
+    }
+
+    if (!try_push(entry)) {
+        record_drop();
+        return false;
+    }
+    wake_writer();
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// flush
+//   요청 번호를 올리고 writer 가 그 번호까지 처리했다고 알릴 때까지 대기한다.
+//   writer 는 요청 번호를 읽은 뒤 큐를 끝까지 비우므로, 호출 이전 제출분은 모두 기록된다.
+// ---------------------------------------------------------------------------
+void AsyncLogWriter::flush() {
+    const auto target = flush_requested_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    std::unique_lock<std::mutex> lock{wake_mutex_};
+    wake_cv_.notify_one();
+    flushed_cv_.wait(lock, [&] { return flush_completed_ >= target; });
+}
+
+std::size_t AsyncLogWriter::queued() const noexcept {
+    const auto head = dequeue_pos_.load(std::memory_order_relaxed);
+    const auto tail = enqueue_pos_.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+}
+
+// ---------------------------------------------------------------------------
+// try_push — Vyukov bounded queue 생산자 측
+//   셀 sequence == pos 이면 비어 있는 슬롯. CAS 로 위치를 선점한 뒤 엔트리를 옮기고
+//   sequence = pos + 1 로 게시한다. 실패 시 entry 는 그대로 남는다.
+// ---------------------------------------------------------------------------
+bool AsyncLogWriter::try_push(Entry& entry) noexcept {
+    auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        const auto seq = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // 가득 참
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    cell->entry = std::move(entry);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// try_pop — 단일 소비자(writer 스레드) 전용
+// ---------------------------------------------------------------------------
+bool AsyncLogWriter::try_pop(Entry& out) noexcept {
+    const auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[pos & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+        return false;  // 비어 있거나 생산자가 아직 게시 중
+    }
+    out = std::move(cell.entry);
+    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+// kSample: 3/4 미만이면 모두 받고, 그 이상이면 N 개 중 1 개만 받는다
+bool AsyncLogWriter::admit_under_pressure() noexcept {
+    if (queued() < capacity() - capacity() / 4 || options_.sample_keep_every <= 1) {
+        return true;
+    }
+    return sample_counter_.fetch_add(1, std::memory_order_relaxed) %
+               options_.sample_keep_every ==
+           0;
+}
+
+void AsyncLogWriter::push_blocking(Entry& entry) {
+    for (int spins = 0; !try_push(entry); ++spins) {
+        wake_writer();
+        if (spins < kBlockSpinLimit) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(kBlockSleep);
+        }
+    }
+}
+
+// writer 가 잠들어 있을 때만 mutex 를 잡는다.
+// fence 는 "push 후 sleeping_ 확인" 과 writer 의 "sleeping_ 설정 후 큐 확인" 이
+// 서로를 놓치지 않게 한다. 놓치더라도 writer 는 flush_interval 안에 깨어난다.
+void AsyncLogWriter::wake_writer() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        const std::lock_guard<std::mutex> lock{wake_mutex_};
+        wake_cv_.notify_one();
+    }
+}
+
+void AsyncLogWriter::record_drop() noexcept {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    if (options_.stats) {
+        options_.stats->on_log_dropped();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// run — writer 스레드
+//   flush_batch 개씩 꺼내 싱크에 쓰고, 미flush 라인이 flush_batch 에 도달하거나
+//   flush_interval 이 지나면 flush 한다. 큐가 비면 다음 flush 시각까지 잠든다.
+// ---------------------------------------------------------------------------
+void AsyncLogWriter::run() {
+    using Clock = std::chrono::steady_clock;
+
+    std::size_t unflushed = 0;
+    auto last_flush = Clock::now();
+    Entry entry;
+
+    for (;;) {
+        const auto requested = flush_requested_.load(std::memory_order_acquire);
+        const bool stop = stopping_.load(std::memory_order_acquire);
+
+        std::size_t batch = 0;
+        while (batch < options_.flush_batch && try_pop(entry)) {
+            const auto& target = entry.channel == LogChannel::kAudit && audit_logger_
+                                     ? audit_logger_
+                                     : sink_logger_;
+            try {
+                target->log(entry.logged_at,
+                                  spdlog::source_loc{},
+                                  static_cast<spdlog::level::level_enum>(entry.level),
+                                  entry.line);
+            } catch (...) {  // NOLINT(bugprone-empty-catch)
+                // 싱크 오류가 writer 스레드를 종료시키지 않도록 한다
+            }
+            ++batch;
+        }
+        unflushed += batch;
+        if (options_.stats) {
+            options_.stats->on_log_queue_depth(queued());
+        }
+
+        const bool drained = batch < options_.flush_batch;
+        const bool sync_wanted = requested > flush_completed_;
+        const auto now = Clock::now();
+        if (unflushed > 0 &&
+            (unflushed >= options_.flush_batch || now - last_flush >= options_.flush_interval ||
+             (drained && (sync_wanted || stop)))) {
+            try {
+                sink_logger_->flush();
+                if (audit_logger_) {
+                    audit_logger_->flush();
+                }
+            } catch (...) {  // NOLINT(bugprone-empty-catch)
+            }
+            unflushed = 0;
+            last_flush = now;
+        }
+
+        if (drained && sync_wanted) {
+            const std::lock_guard<std::mutex> lock{wake_mutex_};
+            flush_completed_ = requested;
+            flushed_cv_.notify_all();
+        }
+        if (!drained) {
+            continue;
+        }
+        if (stop) {
+            break;
+        }
+
+        const auto timeout = unflushed > 0 ? options_.flush_interval - (now - last_flush)
+                                           : Clock::duration{options_.flush_interval};
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock{wake_mutex_};
+            wake_cv_.wait_for(lock, timeout, [&] {
+                return stopping_.load(std::memory_order_acquire) || queued() > 0 ||
+                       flush_requested_.load(std::memory_order_acquire) > flush_completed_;
+            });
+        }
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+}
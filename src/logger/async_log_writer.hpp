@@ -0,0 +1,175 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// async_log_writer.hpp
+//
+// StructuredLogger 의 비동기 기록 파이프라인.
+//
+// [설계 의도]
+// 동기 모드에서는 log_query 마다 세션 io 스레드가 파일 write + flush 를 수행한다.
+// 비동기 모드에서는 세션 스레드는 직렬화된 JSON 라인을 bounded lock-free MPSC 큐에
+// 넣기만 하고, 전용 writer 스레드가 묶어서(batch) 싱크에 쓰고 크기/시간 임계치에
+// 따라 flush 한다.
+//
+// [큐]
+// Vyukov bounded MPMC 링 (셀별 sequence 번호) 을 단일 소비자로 사용한다.
+// 생산자는 CAS 1회 + 셀 이동, 소비자는 락 없이 꺼낸다.
+// writer 가 잠들어 있을 때만 생산자가 mutex 를 잡고 깨우므로, 평상시 생산자 경로에는
+// 락이 없다. 깨우기가 유실되어도 writer 는 flush_interval 마다 스스로 깨어난다.
+//
+// [오버플로 정책]
+// - kBlock : 큐에 자리가 날 때까지 생산자가 대기한다 (유실 없음, 세션 지연 가능)
+// - kDrop  : 큐가 가득 차면 버리고 log_dropped 를 증가시킨다
+// - kSample: 큐가 3/4 이상 차면 N 개 중 1 개만 넣고, 가득 차면 버린다
+// preserve=true 로 제출한 엔트리(차단 이벤트)는 정책과 무관하게 kBlock 으로 보존한다.
+//
+// [채널]
+// 바이너리 감사 로그(log_format: binary) 사용 시 감사 레코드는 kAudit 채널로 제출되어
+// 별도 싱크 로거에 기록된다. 큐·오버플로 정책·통계는 두 채널이 공유한다.
+// ---------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "stats/stats_collector.hpp"
+
+namespace spdlog {
+class logger;  // NOLINT(readability-identifier-naming)
+}
+
+// ---------------------------------------------------------------------------
+// LogOverflowPolicy
+//   비동기 큐가 가득 찼을 때의 동작.
+// ---------------------------------------------------------------------------
+enum class LogOverflowPolicy : std::uint8_t {
+    kBlock = 0,
+    kDrop = 1,
+    kSample = 2,
+};
+
+// ---------------------------------------------------------------------------
+// LogChannel
+//   엔트리를 기록할 싱크 로거. kAudit 은 audit_logger 가 주어진 경우에만 유효하다.
+// ---------------------------------------------------------------------------
+enum class LogChannel : std::uint8_t {
+    kMain = 0,
+    kAudit = 1,
+};
+
+// ---------------------------------------------------------------------------
+// AsyncLogOptions
+//   enabled           : false 이면 기존 동기 기록 (매 로그 flush)
+//   queue_capacity    : 큐 슬롯 수 (2 의 거듭제곱으로 올림)
+//   flush_batch       : flush 하지 않은 라인이 이 수에 도달하면 flush
+//   flush_interval    : 마지막 flush 이후 이 시간이 지나면 flush (writer 최대 대기 시간)
+//   overflow_policy   : 큐 포화 시 동작
+//   sample_keep_every : kSample 에서 포화 구간 동안 N 개 중 1 개를 보존
+//   stats             : log_dropped / log_queued 를 게시할 수집기 (nullptr 허용)
+// ---------------------------------------------------------------------------
+struct AsyncLogOptions {
+    bool enabled{false};
+    std::size_t queue_capacity{8192};
+    std::size_t flush_batch{256};
+    std::chrono::milliseconds flush_interval{200};
+    LogOverflowPolicy overflow_policy{LogOverflowPolicy::kDrop};
+    std::uint32_t sample_keep_every{10};
+    std::shared_ptr<StatsCollector> stats{};
+};
+
+// ---------------------------------------------------------------------------
+// AsyncLogWriter
+//   생성 시 writer 스레드를 시작하고, 소멸 시 큐를 모두 비우고 flush 한 뒤 종료한다.
+//   audit_logger: kAudit 채널 싱크 로거 (nullptr 이면 kAudit 엔트리도 sink_logger 로 간다)
+// ---------------------------------------------------------------------------
+class AsyncLogWriter {
+public:
+    AsyncLogWriter(std::shared_ptr<spdlog::logger> sink_logger,
+                   AsyncLogOptions options,
+                   std::shared_ptr<spdlog::logger> audit_logger = nullptr);
+    ~AsyncLogWriter();
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+    AsyncLogWriter(AsyncLogWriter&&) = delete;
+    AsyncLogWriter& operator=(AsyncLogWriter&&) = delete;
+
+    // -----------------------------------------------------------------------
+    // submit
+    //   level    : spdlog::level::level_enum 값
+    //   line     : 기록할 메시지 (이동)
+    //   preserve : true 이면 오버플로 정책과 무관하게 자리가 날 때까지 대기
+    //   channel  : 기록할 싱크 로거
+    //   반환: 큐에 넣었으면 true, 정책에 의해 버렸으면 false
+    // -----------------------------------------------------------------------
+    bool submit(int level,
+                std::string line,
+                bool preserve = false,
+                LogChannel channel = LogChannel::kMain);
+
+    // -----------------------------------------------------------------------
+    // flush
+    //   호출 이전에 제출된 모든 엔트리가 싱크에 기록·flush 될 때까지 대기한다.
+    // -----------------------------------------------------------------------
+    void flush();
+
+    [[nodiscard]] std::uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+    // 현재 큐에 대기 중인 엔트리 수 (근사치)
+    [[nodiscard]] std::size_t queued() const noexcept;
+    [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+private:
+    // logged_at: 제출 시각 (싱크 패턴 타임스탬프가 기록 시각이 아닌 발생 시각을 가리키도록)
+    struct Entry {
+        int level{0};
+        LogChannel channel{LogChannel::kMain};
+        std::chrono::system_clock::time_point logged_at{};
+        std::string line{};
+    };
+
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        Entry entry{};
+    };
+
+    std::shared_ptr<spdlog::logger> sink_logger_;
+    AsyncLogOptions options_;
+    std::shared_ptr<spdlog::logger> audit_logger_;
+
+    std::unique_ptr<Cell[]> cells_;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::size_t mask_;
+
+    // 생산자/소비자 위치는 false sharing 을 피하도록 캐시 라인을 분리한다
+    alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<std::size_t> dequeue_pos_{0};
+
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> sample_counter_{0};
+
+    // writer 수면/깨우기 + flush 요청 동기화 (생산자 평상시 경로에서는 잡지 않는다)
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable flushed_cv_;
+    std::atomic<bool> sleeping_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<std::uint64_t> flush_requested_{0};
+    std::uint64_t flush_completed_{0};  // wake_mutex_ 로 보호
+
+    std::thread thread_;
+
+    [[nodiscard]] bool try_push(Entry& entry) noexcept;
+    [[nodiscard]] bool try_pop(Entry& out) noexcept;
+    [[nodiscard]] bool admit_under_pressure() noexcept;
+    void push_blocking(Entry& entry);
+    void wake_writer();
+    void record_drop() noexcept;
+    void run();
+};
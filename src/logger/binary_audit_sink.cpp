@@ -0,0 +1,389 @@
+// ---------------------------------------------------------------------------
+// binary_audit_sink.cpp
+//
+// 바이너리 감사 로그 인코더 / 세그먼트 변환 / 파일 싱크 구현.
+// ---------------------------------------------------------------------------
+
+#include "logger/binary_audit_sink.hpp"
+
+#include <spdlog/common.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace audit_format {
+
+namespace {
+
+constexpr std::uint8_t kBlockFlagWouldBlock = 0x01;
+
+void append_bytes(fmt::memory_buffer& out, std::string_view bytes) {
+    out.append(bytes.data(), bytes.data() + bytes.size());
+}
+
+void append_u8(fmt::memory_buffer& out, std::uint8_t value) {
+    out.push_back(static_cast<char>(value));
+}
+
+// staging 문자열: ref 0 (inline) + len + bytes
+void put_inline_string(fmt::memory_buffer& out, std::string_view value) {
+    put_varint(out, 0);
+    put_varint(out, value.size());
+    append_bytes(out, value);
+}
+
+void put_timestamp(fmt::memory_buffer& out, std::chrono::system_clock::time_point tp) {
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch());
+    put_varint(out, zigzag(us.count()));
+}
+
+// 길이 접두 레코드 하나를 out 에 추가한다
+void put_record(fmt::memory_buffer& out, const fmt::memory_buffer& body) {
+    put_varint(out, body.size());
+    out.append(body.data(), body.data() + body.size());
+}
+
+[[nodiscard]] std::optional<std::uint8_t> get_u8(std::span<const std::uint8_t>& in) noexcept {
+    if (in.empty()) {
+        return std::nullopt;
+    }
+    const auto value = in.front();
+    in = in.subspan(1);
+    return value;
+}
+
+// varint 하나를 읽어 그대로 body 에 다시 쓴다
+[[nodiscard]] bool copy_varint(std::span<const std::uint8_t>& in, fmt::memory_buffer& body) {
+    const auto value = get_varint(in);
+    if (!value) {
+        return false;
+    }
+    put_varint(body, *value);
+    return true;
+}
+
+[[nodiscard]] bool copy_u8(std::span<const std::uint8_t>& in, fmt::memory_buffer& body) {
+    const auto value = get_u8(in);
+    if (!value) {
+        return false;
+    }
+    append_u8(body, *value);
+    return true;
+}
+
+// varint 길이 + bytes (SQL) 를 그대로 복사한다
+[[nodiscard]] bool copy_blob(std::span<const std::uint8_t>& in, fmt::memory_buffer& body) {
+    const auto len = get_varint(in);
+    if (!len || *len > in.size()) {
+        return false;
+    }
+    put_varint(body, *len);
+    const auto bytes = in.first(static_cast<std::size_t>(*len));
+    body.append(bytes.data(), bytes.data() + bytes.size());
+    in = in.subspan(bytes.size());
+    return true;
+}
+
+}  // namespace
+
+void put_varint(fmt::memory_buffer& out, std::uint64_t value) {
+    while (value >= 0x80U) {
+        out.push_back(static_cast<char>((value & 0x7FU) | 0x80U));
+        value >>= 7U;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+std::optional<std::uint64_t> get_varint(std::span<const std::uint8_t>& in) noexcept {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < in.size() && i < 10; ++i) {
+        const std::uint64_t byte = in[i];
+        value |= (byte & 0x7FU) << (7U * i);
+        if ((byte & 0x80U) == 0) {
+            in = in.subspan(i + 1);
+            return value;
+        }
+    }
+    return std::nullopt;  // 잘린 입력 또는 10 바이트 초과
+}
+
+void encode_query(fmt::memory_buffer& out, const QueryLog& entry) {
+    append_u8(out, static_cast<std::uint8_t>(RecordType::kQuery));
+    put_timestamp(out, entry.timestamp);
+    put_varint(out, entry.session_id);
+    put_inline_string(out, entry.db_user);
+    put_inline_string(out, entry.client_ip);
+    append_u8(out, entry.command_raw);
+    append_u8(out, entry.action_raw);
+    put_varint(out, static_cast<std::uint64_t>(std::max<std::int64_t>(entry.duration.count(), 0)));
+    put_varint(out, entry.tables.size());
+    for (const auto& table : entry.tables) {
+        put_inline_string(out, table);
+    }
+    put_varint(out, entry.raw_sql.size());
+    append_bytes(out, entry.raw_sql);
+}
+
+void encode_block(fmt::memory_buffer& out, const BlockLog& entry) {
+    append_u8(out, static_cast<std::uint8_t>(RecordType::kBlock));
+    put_timestamp(out, entry.timestamp);
+    put_varint(out, entry.session_id);
+    put_inline_string(out, entry.db_user);
+    put_inline_string(out, entry.client_ip);
+    put_inline_string(out, entry.matched_rule);
+    put_inline_string(out, entry.reason);
+    append_u8(out, entry.would_block ? kBlockFlagWouldBlock : 0);
+    put_varint(out, entry.raw_sql.size());
+    append_bytes(out, entry.raw_sql);
+}
+
+// ---------------------------------------------------------------------------
+// AuditSegmentEncoder
+// ---------------------------------------------------------------------------
+void AuditSegmentEncoder::begin_segment(fmt::memory_buffer& out) {
+    ids_.clear();
+    last_ts_us_ = 0;
+
+    fmt::memory_buffer body;
+    append_u8(body, static_cast<std::uint8_t>(RecordType::kSegment));
+    body.append(kMagic.data(), kMagic.data() + kMagic.size());
+    append_u8(body, kVersion);
+    put_record(out, body);
+}
+
+bool AuditSegmentEncoder::append(std::span<const std::uint8_t> staging, fmt::memory_buffer& out) {
+    // 변환 실패 시 사전이 기록과 어긋나지 않도록 새 문자열은 성공 후에만 등록한다
+    pending_.clear();
+    fmt::memory_buffer defs;
+    fmt::memory_buffer body;
+    std::span<const std::uint8_t> in = staging;
+
+    const auto type = get_u8(in);
+    if (!type ||
+        (*type != static_cast<std::uint8_t>(RecordType::kQuery) &&
+         *type != static_cast<std::uint8_t>(RecordType::kBlock))) {
+        return false;
+    }
+    append_u8(body, *type);
+
+    const auto ts = get_varint(in);
+    if (!ts) {
+        return false;
+    }
+    const std::int64_t ts_us = unzigzag(*ts);
+    put_varint(body, zigzag(ts_us - last_ts_us_));
+
+    if (!copy_varint(in, body)              // session_id
+        || !rewrite_string(in, defs, body)  // db_user
+        || !rewrite_string(in, defs, body)) {  // client_ip
+        return false;
+    }
+
+    if (*type == static_cast<std::uint8_t>(RecordType::kQuery)) {
+        if (!copy_u8(in, body)            // command_raw
+            || !copy_u8(in, body)         // action_raw
+            || !copy_varint(in, body)) {  // duration_us
+            return false;
+        }
+        const auto n_tables = get_varint(in);
+        if (!n_tables || *n_tables > in.size()) {
+            return false;
+        }
+        put_varint(body, *n_tables);
+        for (std::uint64_t i = 0; i < *n_tables; ++i) {
+            if (!rewrite_string(in, defs, body)) {
+                return false;
+            }
+        }
+    } else {
+        if (!rewrite_string(in, defs, body)     // matched_rule
+            || !rewrite_string(in, defs, body)  // reason
+            || !copy_u8(in, body)) {            // flags
+            return false;
+        }
+    }
+
+    if (!copy_blob(in, body) || !in.empty()) {
+        return false;
+    }
+
+    for (const auto& value : pending_) {
+        const auto id = ids_.size() + 1;
+        ids_.emplace(std::string{value}, id);
+    }
+    pending_.clear();
+    last_ts_us_ = ts_us;
+    out.append(defs.data(), defs.data() + defs.size());
+    put_record(out, body);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// rewrite_string
+//   짧은 문자열은 사전 id 로 바꾼다. 처음 보는 문자열이면 STRING 정의 레코드를 defs 에
+//   추가한다. 긴 문자열이나 사전 상한 이후의 문자열은 inline 으로 남긴다.
+// ---------------------------------------------------------------------------
+bool AuditSegmentEncoder::rewrite_string(std::span<const std::uint8_t>& in,
+                                         fmt::memory_buffer& defs,
+                                         fmt::memory_buffer& body) {
+    const auto ref = get_varint(in);
+    const auto len = ref && *ref == 0 ? get_varint(in) : std::nullopt;
+    if (!len || *len > in.size()) {
+        return false;
+    }
+    const auto bytes = in.first(static_cast<std::size_t>(*len));
+    in = in.subspan(bytes.size());
+    const std::string_view value{reinterpret_cast<const char*>(bytes.data()),  // NOLINT
+                                 bytes.size()};
+
+    if (value.size() > kMaxInternLength ||
+        ids_.size() + pending_.size() >= kMaxInternedStrings) {
+        put_inline_string(body, value);
+        return true;
+    }
+    if (const auto it = ids_.find(value); it != ids_.end()) {
+        put_varint(body, it->second);
+        return true;
+    }
+
+    // 같은 레코드 안에서 이미 정의한 문자열 (예: 같은 테이블 반복)
+    std::uint64_t id = 0;
+    for (std::size_t i = 0; i < pending_.size(); ++i) {
+        if (pending_[i] == value) {
+            id = ids_.size() + 1 + i;
+            break;
+        }
+    }
+    if (id == 0) {
+        id = ids_.size() + 1 + pending_.size();
+        pending_.push_back(value);
+
+        fmt::memory_buffer def;
+        append_u8(def, static_cast<std::uint8_t>(RecordType::kString));
+        put_varint(def, id);
+        put_varint(def, value.size());
+        append_bytes(def, value);
+        put_record(defs, def);
+    }
+    put_varint(body, id);
+    return true;
+}
+
+}  // namespace audit_format
+
+// ---------------------------------------------------------------------------
+// BinaryAuditSink
+// ---------------------------------------------------------------------------
+BinaryAuditSink::BinaryAuditSink(std::filesystem::path path,
+                                 std::size_t max_file_size,
+                                 std::size_t max_files)
+    : path_{std::move(path)}, max_file_size_{max_file_size}, max_files_{max_files} {
+    open_new_file();
+    if (file_ == nullptr) {
+        throw spdlog::spdlog_ex("Failed opening audit log file " + path_.string(), errno);
+    }
+}
+
+BinaryAuditSink::~BinaryAuditSink() {
+    if (file_ != nullptr) {
+        std::fclose(file_);  // NOLINT(cppcoreguidelines-owning-memory)
+    }
+}
+
+std::filesystem::path BinaryAuditSink::audit_path_for(const std::filesystem::path& log_path) {
+    auto audit = log_path;
+    audit.replace_extension(".audit");
+    return audit;
+}
+
+void BinaryAuditSink::sink_it_(const spdlog::details::log_msg& msg) {
+    if (file_ == nullptr) {
+        open_new_file();
+        if (file_ == nullptr) {
+            throw spdlog::spdlog_ex("Failed reopening audit log file " + path_.string(), errno);
+        }
+    }
+
+    buffer_.clear();
+    if (encoder_.dictionary_full()) {
+        encoder_.begin_segment(buffer_);
+    }
+    const std::span<const std::uint8_t> staging{
+        reinterpret_cast<const std::uint8_t*>(msg.payload.data()),  // NOLINT
+        msg.payload.size()};
+    if (!encoder_.append(staging, buffer_)) {
+        return;  // 손상된 staging 레코드는 파일을 오염시키지 않도록 기록하지 않는다
+    }
+    write_buffer();
+
+    if (file_size_ >= max_file_size_) {
+        rotate();
+    }
+}
+
+void BinaryAuditSink::flush_() {
+    if (file_ != nullptr) {
+        std::fflush(file_);
+    }
+}
+
+// 파일을 append 모드로 열고 새 세그먼트를 시작한다 (재기동 후 이어 쓰기 포함)
+void BinaryAuditSink::open_new_file() {
+    std::error_code ec;
+    if (path_.has_parent_path()) {
+        std::filesystem::create_directories(path_.parent_path(), ec);
+    }
+    file_ = std::fopen(path_.c_str(), "ab");  // NOLINT(cppcoreguidelines-owning-memory)
+    if (file_ == nullptr) {
+        return;
+    }
+    const auto existing = std::filesystem::file_size(path_, ec);
+    file_size_ = ec ? 0 : static_cast<std::size_t>(existing);
+
+    buffer_.clear();
+    encoder_.begin_segment(buffer_);
+    write_buffer();
+}
+
+// ---------------------------------------------------------------------------
+// rotate
+//   spdlog rotating_file_sink 와 같은 방식: base → .1 → .2 ... (가장 오래된 것은 덮어씀)
+// ---------------------------------------------------------------------------
+void BinaryAuditSink::rotate() {
+    std::fclose(file_);  // NOLINT(cppcoreguidelines-owning-memory)
+    file_ = nullptr;
+
+    std::error_code ec;
+    for (std::size_t i = max_files_; i > 0; --i) {
+        const auto src = rotated_path(i - 1);
+        if (std::filesystem::exists(src, ec)) {
+            std::filesystem::rename(src, rotated_path(i), ec);
+        }
+    }
+    open_new_file();
+}
+
+std::filesystem::path BinaryAuditSink::rotated_path(std::size_t index) const {
+    if (index == 0) {
+        return path_;
+    }
+    auto rotated = path_;
+    rotated.replace_filename(path_.stem().string() + "." + std::to_string(index) +
+                             path_.extension().string());
+    return rotated;
+}
+
+void BinaryAuditSink::write_buffer() {
+    if (buffer_.size() == 0) {
+        return;
+    }
+    const auto written = std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    file_size_ += written;
+    if (written != buffer_.size()) {
+        throw spdlog::spdlog_ex("Failed writing to audit log file " + path_.string(), errno);
+    }
+}
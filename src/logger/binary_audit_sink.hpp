@@ -0,0 +1,158 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// binary_audit_sink.hpp
+//
+// QueryLog / BlockLog 용 compact 바이너리 감사 로그 (global.log_format: binary).
+//
+// [설계 의도]
+// 쿼리 단위 JSON 라인은 하루 수십 GB 에 이르고 포렌식 시 전체 파싱이 느리다.
+// 바이너리 포맷은 길이 접두 레코드 + varint 타임스탬프 + 세그먼트 단위 문자열 사전
+// (사용자/IP/규칙/사유/테이블명) 으로 크기를 줄이고, 리더가 필요 없는 레코드의 SQL 을
+// 디코딩하지 않고 건너뛸 수 있게 한다. 포맷 명세: docs/audit-log-format.md
+//
+// [2단계 인코딩]
+// 1. 호출 스레드: encode_query / encode_block 이 사전 없이 자기완결적인 "staging" 레코드
+//    (모든 문자열 inline, 절대 타임스탬프) 를 만든다. 공유 상태가 없으므로 락이 없다.
+// 2. 싱크(동기 모드: spdlog 싱크 mutex, 비동기 모드: writer 스레드): AuditSegmentEncoder 가
+//    사전 참조와 타임스탬프 delta 로 다시 쓴다. 사전 상태는 싱크만 소유한다.
+//
+// [세그먼트]
+// 파일 시작·로테이션·사전 상한 도달 시 SEGMENT 레코드를 쓰고 사전을 초기화한다.
+// 리더는 SEGMENT 마다 사전을 비우므로 어느 세그먼트 경계에서든 읽기를 시작할 수 있다.
+// ---------------------------------------------------------------------------
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/sinks/base_sink.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "logger/log_types.hpp"
+
+namespace audit_format {
+
+inline constexpr std::array<char, 4> kMagic{'D', 'B', 'G', 'A'};
+inline constexpr std::uint8_t kVersion = 1;
+
+// 이 길이를 넘는 문자열은 사전에 넣지 않고 inline 으로 기록한다 (가변 사유 문자열 등)
+inline constexpr std::size_t kMaxInternLength = 256;
+// 세그먼트당 사전 엔트리 상한. 도달하면 새 세그먼트를 시작한다.
+inline constexpr std::size_t kMaxInternedStrings = 65536;
+
+enum class RecordType : std::uint8_t {
+    kSegment = 0,  // "DBGA" + version — 사전 초기화
+    kString = 1,   // 사전 정의: id, len, bytes
+    kQuery = 2,
+    kBlock = 3,
+};
+
+// LEB128 (unsigned) / zigzag (signed delta)
+void put_varint(fmt::memory_buffer& out, std::uint64_t value);
+[[nodiscard]] std::optional<std::uint64_t> get_varint(std::span<const std::uint8_t>& in) noexcept;
+
+[[nodiscard]] constexpr std::uint64_t zigzag(std::int64_t v) noexcept {
+    return (static_cast<std::uint64_t>(v) << 1U) ^ static_cast<std::uint64_t>(v >> 63);
+}
+[[nodiscard]] constexpr std::int64_t unzigzag(std::uint64_t v) noexcept {
+    return static_cast<std::int64_t>(v >> 1U) ^ -static_cast<std::int64_t>(v & 1U);
+}
+
+// -----------------------------------------------------------------------
+// encode_query / encode_block
+//   staging 레코드 본문(타입 바이트 포함, 길이 접두 없음)을 out 에 추가한다.
+//   문자열은 모두 inline(ref 0), 타임스탬프는 Unix epoch 마이크로초 절대값.
+// -----------------------------------------------------------------------
+void encode_query(fmt::memory_buffer& out, const QueryLog& entry);
+void encode_block(fmt::memory_buffer& out, const BlockLog& entry);
+
+// ---------------------------------------------------------------------------
+// AuditSegmentEncoder
+//   staging 레코드를 세그먼트 사전 참조 형식의 최종 레코드로 변환한다.
+//   스레드 안전하지 않음 — 싱크가 직렬화한다.
+// ---------------------------------------------------------------------------
+class AuditSegmentEncoder {
+public:
+    // SEGMENT 레코드를 out 에 추가하고 사전/타임스탬프 기준을 초기화한다
+    void begin_segment(fmt::memory_buffer& out);
+
+    // -----------------------------------------------------------------------
+    // append
+    //   staging 을 변환하여 (필요한 STRING 정의 레코드와 함께) out 에 추가한다.
+    //   staging 이 손상되었으면 out 을 변경하지 않고 false 를 반환한다.
+    // -----------------------------------------------------------------------
+    [[nodiscard]] bool append(std::span<const std::uint8_t> staging, fmt::memory_buffer& out);
+
+    [[nodiscard]] bool dictionary_full() const noexcept {
+        return ids_.size() >= kMaxInternedStrings;
+    }
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    std::unordered_map<std::string, std::uint64_t, StringHash, std::equal_to<>> ids_{};
+    std::int64_t last_ts_us_{0};
+    // append 진행 중 새로 정의한 문자열 (성공 시 ids_ 에 등록). staging 을 가리킨다.
+    std::vector<std::string_view> pending_{};
+
+    // staging 의 inline 문자열 하나를 읽어 ref 로 다시 쓴다 (새 문자열이면 defs 에 정의 추가)
+    [[nodiscard]] bool rewrite_string(std::span<const std::uint8_t>& in,
+                                      fmt::memory_buffer& defs,
+                                      fmt::memory_buffer& body);
+};
+
+}  // namespace audit_format
+
+// ---------------------------------------------------------------------------
+// BinaryAuditSink
+//   staging 레코드를 받아 세그먼트 형식으로 파일에 기록하는 spdlog 싱크.
+//   max_file_size 를 넘으면 <stem>.1<ext> ... 로 밀어내고 새 파일(새 세그먼트)을 연다.
+//   formatter/pattern 은 사용하지 않는다 (payload 가 곧 레코드).
+// ---------------------------------------------------------------------------
+class BinaryAuditSink final : public spdlog::sinks::base_sink<std::mutex> {
+public:
+    BinaryAuditSink(std::filesystem::path path, std::size_t max_file_size, std::size_t max_files);
+    ~BinaryAuditSink() override;
+
+    BinaryAuditSink(const BinaryAuditSink&) = delete;
+    BinaryAuditSink& operator=(const BinaryAuditSink&) = delete;
+    BinaryAuditSink(BinaryAuditSink&&) = delete;
+    BinaryAuditSink& operator=(BinaryAuditSink&&) = delete;
+
+    // log_path 옆의 감사 로그 경로 (/var/log/dbgate.log → /var/log/dbgate.audit)
+    [[nodiscard]] static std::filesystem::path audit_path_for(
+        const std::filesystem::path& log_path);
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
+
+private:
+    std::filesystem::path path_;
+    std::size_t max_file_size_;
+    std::size_t max_files_;
+    std::FILE* file_{nullptr};
+    std::size_t file_size_{0};
+    audit_format::AuditSegmentEncoder encoder_{};
+    fmt::memory_buffer buffer_{};
+
+    void open_new_file();
+    void rotate();
+    [[nodiscard]] std::filesystem::path rotated_path(std::size_t index) const;
+    void write_buffer();
+};
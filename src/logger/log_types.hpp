@@ -10,6 +10,12 @@
 // - command_raw (uint8_t): 호출자가 static_cast<uint8_t>(SqlCommand) 로 변환
 // - action_raw  (uint8_t): 호출자가 static_cast<uint8_t>(PolicyAction) 로 변환
 //
+// [비소유 필드]
+// - 문자열/목록 필드는 std::string_view / std::span 으로 호출자 데이터를 가리키기만 한다.
+//   세션 핫패스에서 SQL 원문·테이블 목록을 로그용으로 복사하지 않기 위함이다.
+// - 참조 대상은 log_* 호출이 끝날 때까지만 유효하면 된다. 비동기 모드에서도
+//   JSON 직렬화는 호출 스레드에서 끝나고 큐에는 직렬화된 라인만 들어간다.
+//
 // [민감정보 취급 주의]
 // - raw_sql 은 원문 SQL 전체를 포함한다. 운영 환경에서 로그 레벨/마스킹
 //   정책을 별도로 적용할 것.
@@ -17,8 +23,9 @@
 
 #include <chrono>
 #include <cstdint>
+#include <span>
 #include <string>
-#include <vector>
+#include <string_view>
 
 #include "common/types.hpp"  // std::uint64_t 등 기본 타입 (SessionContext 불포함)
 
@@ -33,6 +40,17 @@ enum class LogLevel : std::uint8_t {
     kError = 3,
 };
 
+// ---------------------------------------------------------------------------
+// LogFormat
+//   QueryLog / BlockLog 기록 형식. config(global.log_format) 에서 주입.
+//   kBinary: 감사 레코드를 <log_path stem>.audit 바이너리 파일에 기록한다
+//            (연결/진단 로그는 형식과 무관하게 JSON 라인 로그에 남는다)
+// ---------------------------------------------------------------------------
+enum class LogFormat : std::uint8_t {
+    kJson = 0,
+    kBinary = 1,
+};
+
 // ---------------------------------------------------------------------------
 // ConnectionLog
 //   클라이언트 연결/해제 이벤트 로그.
@@ -40,10 +58,10 @@ enum class LogLevel : std::uint8_t {
 // ---------------------------------------------------------------------------
 struct ConnectionLog {
     std::uint64_t session_id{0};
-    std::string event{};  // "connect" | "disconnect"
-    std::string client_ip{};
+    std::string_view event{};  // "connect" | "disconnect"
+    std::string_view client_ip{};
     std::uint16_t client_port{0};
-    std::string db_user{};
+    std::string_view db_user{};
     std::chrono::system_clock::time_point timestamp{};
 };
 
@@ -59,14 +77,14 @@ struct ConnectionLog {
 // ---------------------------------------------------------------------------
 struct QueryLog {
     std::uint64_t session_id{0};
-    std::string db_user{};
-    std::string client_ip{};
-    std::string raw_sql{};              // 원문 SQL (마스킹 주의)
-    std::uint8_t command_raw{0};        // SqlCommand as uint8_t
-    std::vector<std::string> tables{};  // 접근 테이블명 목록
-    std::uint8_t action_raw{0};         // PolicyAction as uint8_t
+    std::string_view db_user{};
+    std::string_view client_ip{};
+    std::string_view raw_sql{};                  // 원문 SQL (마스킹 주의)
+    std::uint8_t command_raw{0};                 // SqlCommand as uint8_t
+    std::span<const std::string_view> tables{};  // 접근 테이블명 목록
+    std::uint8_t action_raw{0};                  // PolicyAction as uint8_t
     std::chrono::system_clock::time_point timestamp{};
-    std::chrono::microseconds duration{0};  // 정책 평가 소요 시간
+    std::chrono::microseconds duration{0};       // 정책 평가 소요 시간
 };
 
 // ---------------------------------------------------------------------------
@@ -77,11 +95,11 @@ struct QueryLog {
 // ---------------------------------------------------------------------------
 struct BlockLog {
     std::uint64_t session_id{0};
-    std::string db_user{};
-    std::string client_ip{};
-    std::string raw_sql{};       // 원문 SQL (마스킹 주의)
-    std::string matched_rule{};  // 매칭 규칙 ID
-    std::string reason{};        // 차단 사유
+    std::string_view db_user{};
+    std::string_view client_ip{};
+    std::string_view raw_sql{};       // 원문 SQL (마스킹 주의)
+    std::string_view matched_rule{};  // 매칭 규칙 ID
+    std::string_view reason{};        // 차단 사유
     std::chrono::system_clock::time_point timestamp{};
     bool would_block{false};  // monitor 모드: 실제 차단 없이 로그만
 };
@@ -7,23 +7,41 @@
 #include "logger/structured_logger.hpp"
 
 #include <spdlog/common.h>
+#include <spdlog/fmt/fmt.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/spdlog.h>
 
 #include <array>
 #include <chrono>
-#include <cstdio>
+#include <cstdint>
+#include <cstring>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
+#include <iterator>
+
+#include "logger/binary_audit_sink.hpp"
 
 namespace {
 
 // ---------------------------------------------------------------------------
-// Helper: ISO8601 timestamp 포맷
+// Helper: 스레드별 재사용 직렬화 버퍼
+//   레코드마다 clear() 만 하므로 용량이 한 번 늘어난 뒤에는 힙 할당이 없다.
+//   emit() 이 버퍼 내용을 다 쓴 뒤에 같은 스레드의 다음 레코드가 버퍼를 재사용한다.
+// ---------------------------------------------------------------------------
+fmt::memory_buffer& line_buffer() {
+    thread_local fmt::memory_buffer buffer;
+    buffer.clear();
+    return buffer;
+}
+
+void append(fmt::memory_buffer& out, std::string_view text) {
+    out.append(text.data(), text.data() + text.size());
+}
+
+// ---------------------------------------------------------------------------
+// Helper: ISO8601 timestamp 포맷 (예: 2026-01-01T00:00:00.000Z)
 // ---------------------------------------------------------------------------
-std::string format_iso8601(const std::chrono::system_clock::time_point& tp) {
+void append_iso8601(fmt::memory_buffer& out, const std::chrono::system_clock::time_point& tp) {
     const auto duration = tp.time_since_epoch();
     const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
     const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration) - seconds;
@@ -32,66 +50,122 @@ std::string format_iso8601(const std::chrono::system_clock::time_point& tp) {
     std::tm tm_val{};
 #if defined(_WIN32)
     if (gmtime_s(&tm_val, &time_t_val) != 0) {
-        return "1970-01-01T00:00:00.000Z";
+        append(out, "1970-01-01T00:00:00.000Z");
+        return;
     }
 #else
     if (gmtime_r(&time_t_val, &tm_val) == nullptr) {
-        return "1970-01-01T00:00:00.000Z";
+        append(out, "1970-01-01T00:00:00.000Z");
+        return;
     }
 #endif
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm_val, "%Y-%m-%dT%H:%M:%S") << '.' << std::setfill('0') << std::setw(3)
-        << millis.count() << 'Z';
-    return oss.str();
+    fmt::format_to(std::back_inserter(out),
+                   "{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:03}Z",
+                   tm_val.tm_year + 1900,
+                   tm_val.tm_mon + 1,
+                   tm_val.tm_mday,
+                   tm_val.tm_hour,
+                   tm_val.tm_min,
+                   tm_val.tm_sec,
+                   millis.count());
+}
+
+// 이스케이프가 필요 없는 바이트인지 (제어 문자, '"', '\\' 제외)
+constexpr bool is_plain_json_byte(unsigned char ch) noexcept {
+    return ch >= 0x20 && ch != '"' && ch != '\\';
 }
 
 // ---------------------------------------------------------------------------
-// Helper: JSON 문자열 이스케이프 (기본적인 구현)
+// Helper: 8바이트 단위(SWAR)로 이스케이프 대상 바이트를 건너뛴다
+//   word 내에 0x20 미만 / '"' / '\\' 바이트가 하나라도 있는지 비트 연산으로 판정한다.
+//   (has_less(x, n) = (x - 0x01..*n) & ~x & 0x80.. — n <= 128 에서 존재 여부는 정확)
+//   UTF-8 멀티바이트(>= 0x80)는 ~x 의 최상위 비트가 0 이므로 오탐하지 않는다.
+//   반환: pos 이후 첫 이스케이프 대상 위치 (없으면 size)
 // ---------------------------------------------------------------------------
-std::string escape_json_string(const std::string& str) {
-    std::string result;
-    result.reserve(str.size() + 16);
+std::size_t skip_plain_bytes(const char* data, std::size_t pos, std::size_t size) noexcept {
+    constexpr std::uint64_t kOnes = 0x0101010101010101ULL;
+    constexpr std::uint64_t kHigh = 0x8080808080808080ULL;
+    const auto has_zero_byte = [](std::uint64_t v) { return (v - kOnes) & ~v & kHigh; };
+
+    while (pos + sizeof(std::uint64_t) <= size) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data + pos, sizeof(word));
+        const std::uint64_t special = ((word - kOnes * 0x20U) & ~word & kHigh) |
+                                      has_zero_byte(word ^ (kOnes * '"')) |
+                                      has_zero_byte(word ^ (kOnes * '\\'));
+        if (special != 0) {
+            break;
+        }
+        pos += sizeof(word);
+    }
+    while (pos < size && is_plain_json_byte(static_cast<unsigned char>(data[pos]))) {
+        ++pos;
+    }
+    return pos;
+}
 
-    for (const char ch : str) {
+// ---------------------------------------------------------------------------
+// Helper: JSON 문자열 이스케이프 (out 에 직접 추가)
+//   이스케이프가 필요 없는 연속 구간을 찾아 한 번에 복사하고, 특수 문자만 치환한다.
+//   SQL 원문은 대부분 일반 문자이므로 append 호출 수는 특수 문자 수에 비례한다.
+// ---------------------------------------------------------------------------
+void append_escaped(fmt::memory_buffer& out, std::string_view str) {
+    static constexpr std::array<char, 16> kHex{
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+
+    const char* const data = str.data();
+    const std::size_t size = str.size();
+    std::size_t run_start = 0;
+
+    for (;;) {
+        const std::size_t i = skip_plain_bytes(data, run_start, size);
+        out.append(data + run_start, data + i);
+        if (i == size) {
+            break;
+        }
+        run_start = i + 1;
+
+        const auto ch = static_cast<unsigned char>(data[i]);
         switch (ch) {
             case '"':
-                result += "\\\"";
+                append(out, "\\\"");
                 break;
             case '\\':
-                result += "\\\\";
+                append(out, "\\\\");
                 break;
             case '\b':
-                result += "\\b";
+                append(out, "\\b");
                 break;
             case '\f':
-                result += "\\f";
+                append(out, "\\f");
                 break;
             case '\n':
-                result += "\\n";
+                append(out, "\\n");
                 break;
             case '\r':
-                result += "\\r";
+                append(out, "\\r");
                 break;
             case '\t':
-                result += "\\t";
+                append(out, "\\t");
                 break;
-            default:
-                if (static_cast<unsigned char>(ch) < 0x20) {
-                    std::array<char, 8> buf{};
-                    (void)std::snprintf(buf.data(),  // NOLINT(cppcoreguidelines-pro-type-vararg)
-                                        buf.size(),
-                                        "\\u%04x",
-                                        static_cast<unsigned int>(static_cast<unsigned char>(ch)));
-                    result += buf.data();
-                } else {
-                    result += ch;
-                }
+            default: {
+                const std::array<char, 6> escaped{
+                    '\\', 'u', '0', '0', kHex[(ch >> 4U) & 0x0FU], kHex[ch & 0x0FU]};
+                out.append(escaped.data(), escaped.data() + escaped.size());
                 break;
+            }
         }
     }
+}
 
-    return result;
+// "key":"<escaped value>" 형태의 문자열 필드 (앞 구분자는 호출자가 붙인다)
+void append_string_field(fmt::memory_buffer& out, std::string_view key, std::string_view value) {
+    out.push_back('"');
+    append(out, key);
+    append(out, R"(":")");
+    append_escaped(out, value);
+    out.push_back('"');
 }
 
 }  // namespace
@@ -120,7 +194,9 @@ int StructuredLogger::to_spdlog_level(  // NOLINT(readability-convert-member-fun
 // ---------------------------------------------------------------------------
 StructuredLogger::StructuredLogger(
     LogLevel min_level,
-    const std::filesystem::path& log_path)  // NOLINT(modernize-pass-by-value)
+    const std::filesystem::path& log_path,  // NOLINT(modernize-pass-by-value)
+    AsyncLogOptions async,
+    LogFormat format)
     : min_level_(min_level), log_path_(log_path) {
     try {
         // 로그 디렉터리 생성
@@ -147,8 +223,25 @@ StructuredLogger::StructuredLogger(
         // 기본 패턴: 타임스탬프만 (구조화 로그는 각 메서드에서 JSON으로 생성)
         logger_->set_pattern("[%Y-%m-%d %H:%M:%S.%e] %v");
 
-        // 매 로그마다 파일을 플러시하도록 설정
-        logger_->flush_on(spdlog::level::trace);
+        if (format == LogFormat::kBinary) {
+            // 감사 레코드 전용 로거: 바이너리 싱크만 둔다 (stdout 에 바이너리를 쓰지 않음)
+            auto audit_sink = std::make_shared<BinaryAuditSink>(
+                BinaryAuditSink::audit_path_for(log_path_), max_file_size, max_files);
+            audit_logger_ = std::make_shared<spdlog::logger>("dbgate_audit", audit_sink);
+            audit_logger_->set_level(logger_->level());
+        }
+
+        if (async.enabled) {
+            // 비동기 모드: writer 스레드가 크기/시간 임계치에 따라 묶어서 flush 한다
+            async_writer_ =
+                std::make_unique<AsyncLogWriter>(logger_, std::move(async), audit_logger_);
+        } else {
+            // 매 로그마다 파일을 플러시하도록 설정
+            logger_->flush_on(spdlog::level::trace);
+            if (audit_logger_) {
+                audit_logger_->flush_on(spdlog::level::trace);
+            }
+        }
 
         spdlog::register_logger(logger_);
 
@@ -160,6 +253,8 @@ StructuredLogger::StructuredLogger(
 
 StructuredLogger::~StructuredLogger() {
     try {
+        // 큐에 남은 엔트리를 모두 기록한 뒤 writer 스레드를 종료한다
+        async_writer_.reset();
         if (logger_) {
             spdlog::drop("dbgate");
         }
@@ -176,15 +271,18 @@ void StructuredLogger::log_connection(const ConnectionLog& entry) {
         return;
     }
 
-    // JSON 구성
-    std::ostringstream json;
-    json << R"({"event":")" << escape_json_string(entry.event) << R"(","session_id":)"
-         << entry.session_id << R"(,"client_ip":")" << escape_json_string(entry.client_ip)
-         << R"(","client_port":)" << entry.client_port << R"(,"db_user":")"
-         << escape_json_string(entry.db_user) << R"(","timestamp":")"
-         << format_iso8601(entry.timestamp) << R"("})";
-
-    logger_->info(json.str());
+    auto& json = line_buffer();
+    json.push_back('{');
+    append_string_field(json, "event", entry.event);
+    fmt::format_to(std::back_inserter(json), R"(,"session_id":{},)", entry.session_id);
+    append_string_field(json, "client_ip", entry.client_ip);
+    fmt::format_to(std::back_inserter(json), R"(,"client_port":{},)", entry.client_port);
+    append_string_field(json, "db_user", entry.db_user);
+    append(json, R"(,"timestamp":")");
+    append_iso8601(json, entry.timestamp);
+    append(json, R"("})");
+
+    emit(LogLevel::kInfo, std::string_view{json.data(), json.size()});
 }
 
 // ---------------------------------------------------------------------------
@@ -195,26 +293,44 @@ void StructuredLogger::log_query(const QueryLog& entry) {
         return;
     }
 
-    // JSON 구성
-    std::ostringstream json;
-    json << R"({"event":"query","session_id":)" << entry.session_id << R"(,"db_user":")"
-         << escape_json_string(entry.db_user) << R"(","client_ip":")"
-         << escape_json_string(entry.client_ip) << R"(","raw_sql":")"
-         << escape_json_string(entry.raw_sql) << R"(","command_raw":)"
-         << static_cast<int>(entry.command_raw) << R"(,"tables":[)";
+    if (audit_logger_) {
+        auto& record = line_buffer();
+        audit_format::encode_query(record, entry);
+        emit(LogLevel::kInfo,
+             std::string_view{record.data(), record.size()},
+             /*preserve=*/false,
+             LogChannel::kAudit);
+        return;
+    }
 
-    for (size_t i = 0; i < entry.tables.size(); ++i) {
+    auto& json = line_buffer();
+    fmt::format_to(
+        std::back_inserter(json), R"({{"event":"query","session_id":{},)", entry.session_id);
+    append_string_field(json, "db_user", entry.db_user);
+    json.push_back(',');
+    append_string_field(json, "client_ip", entry.client_ip);
+    json.push_back(',');
+    append_string_field(json, "raw_sql", entry.raw_sql);
+    fmt::format_to(std::back_inserter(json),
+                   R"(,"command_raw":{},"tables":[)",
+                   static_cast<int>(entry.command_raw));
+
+    for (std::size_t i = 0; i < entry.tables.size(); ++i) {
         if (i > 0) {
-            json << ',';
+            json.push_back(',');
         }
-        json << R"(")" << escape_json_string(entry.tables[i]) << R"(")";
+        json.push_back('"');
+        append_escaped(json, entry.tables[i]);
+        json.push_back('"');
     }
 
-    json << R"(],"action_raw":)" << static_cast<int>(entry.action_raw) << R"(,"timestamp":")"
-         << format_iso8601(entry.timestamp) << R"(","duration_us":)" << entry.duration.count()
-         << R"(})";
+    fmt::format_to(std::back_inserter(json),
+                   R"(],"action_raw":{},"timestamp":")",
+                   static_cast<int>(entry.action_raw));
+    append_iso8601(json, entry.timestamp);
+    fmt::format_to(std::back_inserter(json), R"(","duration_us":{}}})", entry.duration.count());
 
-    logger_->info(json.str());
+    emit(LogLevel::kInfo, std::string_view{json.data(), json.size()});
 }
 
 // ---------------------------------------------------------------------------
@@ -225,21 +341,81 @@ void StructuredLogger::log_block(const BlockLog& entry) {
         return;
     }
 
-    // JSON 구성
+    if (audit_logger_) {
+        auto& record = line_buffer();
+        audit_format::encode_block(record, entry);
+        emit(LogLevel::kWarn,
+             std::string_view{record.data(), record.size()},
+             /*preserve=*/true,
+             LogChannel::kAudit);
+        return;
+    }
+
     // would_block==true: dry-run 모드에서 차단됐을 것임을 나타냄 (실제 차단 아님)
-    const char* event_name = entry.would_block ? "query_would_block" : "query_blocked";
-    const char* would_block_val = entry.would_block ? "true" : "false";
-
-    std::ostringstream json;
-    json << R"({"event":")" << event_name << R"(","session_id":)" << entry.session_id
-         << R"(,"db_user":")" << escape_json_string(entry.db_user) << R"(","client_ip":")"
-         << escape_json_string(entry.client_ip) << R"(","raw_sql":")"
-         << escape_json_string(entry.raw_sql) << R"(","matched_rule":")"
-         << escape_json_string(entry.matched_rule) << R"(","reason":")"
-         << escape_json_string(entry.reason) << R"(","would_block":)" << would_block_val
-         << R"(,"timestamp":")" << format_iso8601(entry.timestamp) << R"("})";
-
-    logger_->warn(json.str());
+    const std::string_view event_name =
+        entry.would_block ? "query_would_block" : "query_blocked";
+    const std::string_view would_block_val = entry.would_block ? "true" : "false";
+
+    auto& json = line_buffer();
+    json.push_back('{');
+    append_string_field(json, "event", event_name);
+    fmt::format_to(std::back_inserter(json), R"(,"session_id":{},)", entry.session_id);
+    append_string_field(json, "db_user", entry.db_user);
+    json.push_back(',');
+    append_string_field(json, "client_ip", entry.client_ip);
+    json.push_back(',');
+    append_string_field(json, "raw_sql", entry.raw_sql);
+    json.push_back(',');
+    append_string_field(json, "matched_rule", entry.matched_rule);
+    json.push_back(',');
+    append_string_field(json, "reason", entry.reason);
+    append(json, R"(,"would_block":)");
+    append(json, would_block_val);
+    append(json, R"(,"timestamp":")");
+    append_iso8601(json, entry.timestamp);
+    append(json, R"("})");
+
+    // 차단 이벤트는 감사 필수 기록이므로 비동기 큐 포화 시에도 버리지 않는다
+    emit(LogLevel::kWarn, std::string_view{json.data(), json.size()}, /*preserve=*/true);
+}
+
+// ---------------------------------------------------------------------------
+// emit: 동기 기록 또는 비동기 큐 제출
+//   동기 모드에서는 버퍼를 그대로 싱크에 넘긴다 (복사 없음).
+//   비동기 모드에서만 큐 엔트리 소유를 위해 한 번 복사한다.
+// ---------------------------------------------------------------------------
+void StructuredLogger::emit(LogLevel level,
+                            std::string_view line,
+                            bool preserve,
+                            LogChannel channel) {
+    const auto spd_level = static_cast<spdlog::level::level_enum>(to_spdlog_level(level));
+    const auto& target = channel == LogChannel::kAudit && audit_logger_ ? audit_logger_ : logger_;
+    if (!async_writer_) {
+        target->log(spd_level, line);
+        return;
+    }
+    // 필터될 로그는 큐 슬롯을 쓰지 않도록 제출 전에 레벨을 확인한다
+    if (target->should_log(spd_level)) {
+        (void)async_writer_->submit(
+            static_cast<int>(spd_level), std::string{line}, preserve, channel);
+    }
+}
+
+void StructuredLogger::flush() {
+    if (async_writer_) {
+        async_writer_->flush();
+        return;
+    }
+    if (logger_) {
+        logger_->flush();
+    }
+    if (audit_logger_) {
+        audit_logger_->flush();
+    }
+}
+
+std::uint64_t StructuredLogger::dropped_count() const noexcept {
+    return async_writer_ ? async_writer_->dropped() : 0;
 }
 
 // ---------------------------------------------------------------------------
@@ -247,24 +423,24 @@ void StructuredLogger::log_block(const BlockLog& entry) {
 // ---------------------------------------------------------------------------
 void StructuredLogger::debug(std::string_view msg) {
     if (logger_) {
-        logger_->debug(msg);
+        emit(LogLevel::kDebug, msg);
     }
 }
 
 void StructuredLogger::info(std::string_view msg) {
     if (logger_) {
-        logger_->info(msg);
+        emit(LogLevel::kInfo, msg);
     }
 }
 
 void StructuredLogger::warn(std::string_view msg) {
     if (logger_) {
-        logger_->warn(msg);
+        emit(LogLevel::kWarn, msg);
     }
 }
 
 void StructuredLogger::error(std::string_view msg) {
     if (logger_) {
-        logger_->error(msg);
+        emit(LogLevel::kError, msg);
     }
 }
@@ -11,16 +11,28 @@
 //   const-ref 파라미터를 사용한다.
 // - 민감정보(raw_sql 등)의 실제 마스킹 정책은 Phase 3 구현에서 적용한다.
 //
+// [비동기 모드]
+// AsyncLogOptions::enabled 이면 직렬화까지만 호출 스레드에서 수행하고, 싱크 기록과
+// flush 는 AsyncLogWriter 의 전용 스레드가 담당한다 (async_log_writer.hpp 참조).
+//
+// [바이너리 감사 로그]
+// LogFormat::kBinary 이면 QueryLog / BlockLog 를 JSON 대신 compact 바이너리 레코드로
+// <log_path stem>.audit 에 기록한다 (binary_audit_sink.hpp 참조). 비동기 모드에서는
+// 같은 큐의 kAudit 채널로 제출된다.
+//
 // [JSON 스키마 일관성]
 // 파서/정책/프록시 로그 간 필드명 불일치를 최소화하기 위해
 // 모든 구조체 필드를 snake_case JSON 키로 직렬화한다.
 // ---------------------------------------------------------------------------
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <string>
 #include <string_view>
 
 #include "log_types.hpp"
+#include "logger/async_log_writer.hpp"
 
 namespace spdlog {
 class logger;  // NOLINT(readability-identifier-naming)
@@ -36,7 +48,12 @@ public:
     // 생성자
     //   min_level : 이 레벨 미만의 로그는 기록하지 않는다.
     //   log_path  : 로그 파일 경로 (디렉터리가 아닌 파일 경로)
-    explicit StructuredLogger(LogLevel min_level, const std::filesystem::path& log_path);
+    //   async     : 비동기 기록 설정 (기본값: 비활성 — 매 로그 동기 flush)
+    //   format    : QueryLog / BlockLog 기록 형식 (기본값: JSON)
+    explicit StructuredLogger(LogLevel min_level,
+                              const std::filesystem::path& log_path,
+                              AsyncLogOptions async = {},
+                              LogFormat format = LogFormat::kJson);
 
     ~StructuredLogger();
 
@@ -53,12 +70,12 @@ public:
     void log_connection(const ConnectionLog& entry);
 
     // log_query
-    //   SQL 쿼리 실행 결과를 JSON 으로 기록한다.
+    //   SQL 쿼리 실행 결과를 JSON (또는 바이너리 감사 레코드) 으로 기록한다.
     //   [고빈도 호출 경로] 불필요한 문자열 복사를 최소화할 것.
     void log_query(const QueryLog& entry);
 
     // log_block
-    //   차단 이벤트를 JSON 으로 기록한다.
+    //   차단 이벤트를 JSON (또는 바이너리 감사 레코드) 으로 기록한다.
     void log_block(const BlockLog& entry);
 
     // 내부 진단용 spdlog 래퍼
@@ -69,10 +86,28 @@ public:
     void warn(std::string_view msg);
     void error(std::string_view msg);
 
+    // flush
+    //   지금까지 기록 요청된 로그를 싱크에 반영한다. 비동기 모드에서는 writer 스레드가
+    //   큐를 비우고 flush 할 때까지 대기한다 (종료 직전·테스트용).
+    void flush();
+
+    // 비동기 큐 포화로 버려진 엔트리 수 (동기 모드에서는 항상 0)
+    [[nodiscard]] std::uint64_t dropped_count() const noexcept;
+
 private:
     LogLevel min_level_;
     std::filesystem::path log_path_;
     std::shared_ptr<spdlog::logger> logger_;
+    std::shared_ptr<spdlog::logger> audit_logger_;  // nullptr = JSON 형식
+    std::unique_ptr<AsyncLogWriter> async_writer_;  // nullptr = 동기 모드
+
+    // 레벨 확인 후 동기 기록 또는 비동기 제출
+    //   preserve : 비동기 모드에서 오버플로 정책과 무관하게 보존 (차단 이벤트)
+    //   channel  : kAudit 이면 audit_logger_ 에 기록 (바이너리 staging 레코드)
+    void emit(LogLevel level,
+              std::string_view line,
+              bool preserve = false,
+              LogChannel channel = LogChannel::kMain);
 
     // Helper: spdlog LogLevel 으로 변환
     // NOLINTNEXTLINE(modernize-use-nodiscard,readability-convert-member-functions-to-static)
@@ -1,10 +1,15 @@
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <exception>
 #include <limits>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "common/io_backend.hpp"
+#include "parser/sql_scan.hpp"
 #include "proxy/proxy_server.hpp"
 
 // ---------------------------------------------------------------------------
@@ -67,6 +72,35 @@ bool env_bool(const char* name, bool default_val) {
     return s == "true" || s == "1" || s == "yes";
 }
 
+// ---------------------------------------------------------------------------
+// resolve_worker_threads
+//   WORKER_THREADS 설정값을 실제 스레드 수로 변환한다.
+//   0 이면 hardware_concurrency() (감지 실패 시 1) 를 사용한다.
+// ---------------------------------------------------------------------------
+std::uint32_t resolve_worker_threads(std::uint32_t configured) {
+    if (configured > 0) {
+        return configured;
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+// ---------------------------------------------------------------------------
+// run_io_worker
+//   io_context::run() 을 실행한다. 핸들러 예외는 로그 후 io_context 를 중단하여
+//   나머지 워커도 함께 종료되도록 한다 (부분 동작 상태로 남지 않게 한다).
+// ---------------------------------------------------------------------------
+void run_io_worker(boost::asio::io_context& ioc) noexcept {
+    try {
+        ioc.run();
+    } catch (const std::exception& e) {
+        spdlog::error("io worker terminated: {}", e.what());
+        ioc.stop();
+    } catch (...) {
+        spdlog::error("io worker terminated: unknown exception");
+        ioc.stop();
+    }
+}
+
 }  // namespace
 
 // ---------------------------------------------------------------------------
@@ -78,6 +112,18 @@ int main(int /*argc*/, char* /*argv*/[]) {
         ProxyConfig config;
         config.upstream_address = env_str("MYSQL_HOST", "127.0.0.1");
         config.upstream_port = env_u16("MYSQL_PORT", 3306);
+        config.upstream_dns_refresh_sec = env_u32("UPSTREAM_DNS_REFRESH_SEC", 30);
+
+        // ── 다중 업스트림 ─────────────────────────────────────────────────────
+        //   MYSQL_UPSTREAMS="db1:3306@2,db2:3306" (미설정 시 MYSQL_HOST:MYSQL_PORT 하나)
+        //   UPSTREAM_BALANCE=least_conn/round_robin
+        //   UPSTREAM_HEALTH_USER: 비밀번호 없는 probe 전용 계정 (미설정 시 greeting 까지만 확인)
+        config.upstream_list = env_str("MYSQL_UPSTREAMS", "");
+        config.upstream_balance = env_str("UPSTREAM_BALANCE", "least_conn");
+        config.upstream_health_interval_ms = env_u32("UPSTREAM_HEALTH_INTERVAL_MS", 2000);
+        config.upstream_health_timeout_ms = env_u32("UPSTREAM_HEALTH_TIMEOUT_MS", 1000);
+        config.upstream_eject_failures = env_u32("UPSTREAM_EJECT_FAILURES", 3);
+        config.upstream_health_user = env_str("UPSTREAM_HEALTH_USER", "");
         config.listen_address = env_str("PROXY_LISTEN_ADDR", "0.0.0.0");
         config.listen_port = env_u16("PROXY_LISTEN_PORT", 13306);
         config.policy_path = env_str("POLICY_PATH", "config/policy.yaml");
@@ -85,8 +131,55 @@ int main(int /*argc*/, char* /*argv*/[]) {
         config.log_path = env_str("LOG_PATH", "/tmp/dbgate.log");
         config.log_level = env_str("LOG_LEVEL", "info");
         config.health_check_port = env_u16("HEALTH_CHECK_PORT", 8080);
+        // /metrics Bearer 토큰 (미설정 시 /metrics 비활성)
+        config.metrics_token = env_str("METRICS_TOKEN", "");
         config.max_connections = env_u32("MAX_CONNECTIONS", 1000);
-        config.connection_timeout_sec = env_u32("CONNECTION_TIMEOUT_SEC", 30);
+        // 유휴 세션 종료 — MySQL wait_timeout 기본값과 같게 둔다 (풀링 클라이언트 보호)
+        config.connection_timeout_sec = env_u32("CONNECTION_TIMEOUT_SEC", 28800);
+        config.worker_threads = resolve_worker_threads(env_u32("WORKER_THREADS", 1));
+
+        // ── 연결 허용 판정 (재접속 폭주 방어) ────────────────────────────────
+        //   ACCEPT_RATE_PER_SEC / ACCEPT_BURST: accept 토큰 버킷 (0 = 제한 없음)
+        //   MAX_PENDING_HANDSHAKES / MAX_CONNECTIONS_PER_IP: 0 = 제한 없음
+        //   HANDSHAKE_TIMEOUT_MS: TLS + 백엔드 인증 제한 시간 (0 = 없음)
+        config.accept_rate_per_sec = env_u32("ACCEPT_RATE_PER_SEC", 0);
+        config.accept_burst = env_u32("ACCEPT_BURST", 0);
+        config.max_pending_handshakes = env_u32("MAX_PENDING_HANDSHAKES", 0);
+        config.max_connections_per_ip = env_u32("MAX_CONNECTIONS_PER_IP", 0);
+        config.handshake_timeout_ms = env_u32("HANDSHAKE_TIMEOUT_MS", 10000);
+
+        // ── 죽은 연결 감지 (클라이언트 / 업스트림 소켓) ──────────────────────
+        //   TCP_KEEPALIVE_IDLE_SEC=0 이면 keepalive 끔, TCP_USER_TIMEOUT_MS=0 이면 커널 기본값
+        config.tcp_keepalive_idle_sec = env_u32("TCP_KEEPALIVE_IDLE_SEC", 300);
+        config.tcp_keepalive_interval_sec = env_u32("TCP_KEEPALIVE_INTERVAL_SEC", 30);
+        config.tcp_keepalive_probes = env_u32("TCP_KEEPALIVE_PROBES", 4);
+        config.tcp_user_timeout_ms = env_u32("TCP_USER_TIMEOUT_MS", 0);
+
+        // ── 소켓 튜닝 (TCP_NODELAY 외에는 모두 opt-in) ──────────────────────
+        //   SOCKET_*_BUFFER_BYTES=0 이면 커널 자동 조정, TCP_DEFER_ACCEPT_SEC 는 frontend TLS 전용
+        config.tcp_nodelay = env_bool("TCP_NODELAY", true);
+        config.socket_recv_buffer_bytes = env_u32("SOCKET_RECV_BUFFER_BYTES", 0);
+        config.socket_send_buffer_bytes = env_u32("SOCKET_SEND_BUFFER_BYTES", 0);
+        config.socket_busy_poll_us = env_u32("SOCKET_BUSY_POLL_US", 0);
+        config.tcp_defer_accept_sec = env_u32("TCP_DEFER_ACCEPT_SEC", 0);
+        config.tcp_fastopen_queue = env_u32("TCP_FASTOPEN_QUEUE", 0);
+
+        // ── drain / 무중단 바이너리 교체 ──────────────────────────────────────
+        //   LISTENER_HANDOFF_FROM=<기존 dbgate 의 UDS_SOCKET_PATH>: 리스너를 넘겨받아 기동
+        //   DRAIN_IDLE_SEC: drain 중 이만큼 유휴인 세션 종료, DRAIN_TIMEOUT_SEC=0 이면 무제한
+        config.listener_handoff_from = env_str("LISTENER_HANDOFF_FROM", "");
+        config.drain_idle_sec = env_u32("DRAIN_IDLE_SEC", 5);
+        config.drain_timeout_sec = env_u32("DRAIN_TIMEOUT_SEC", 300);
+
+        // ── 비동기 감사 로그 ───────────────────────────────────────────────────
+        //   LOG_ASYNC_ENABLED=true/false
+        //   LOG_OVERFLOW_POLICY=block/drop/sample
+        config.log_async_enabled = env_bool("LOG_ASYNC_ENABLED", false);
+        config.log_queue_capacity = env_u32("LOG_QUEUE_CAPACITY", 8192);
+        config.log_flush_batch = env_u32("LOG_FLUSH_BATCH", 256);
+        config.log_flush_interval_ms = env_u32("LOG_FLUSH_INTERVAL_MS", 200);
+        config.log_overflow_policy = env_str("LOG_OVERFLOW_POLICY", "drop");
+        config.log_sample_keep_every = env_u32("LOG_SAMPLE_KEEP_EVERY", 10);
 
         // ── Frontend SSL 설정 ──────────────────────────────────────────────────
         //   FRONTEND_SSL_ENABLED=true/false
@@ -106,6 +199,40 @@ int main(int /*argc*/, char* /*argv*/[]) {
         config.backend_ssl_verify = env_bool("BACKEND_SSL_VERIFY", true);
         config.upstream_ssl_sni = env_str("UPSTREAM_SSL_SNI", "");
 
+        // ── kernel TLS offload (opt-in) ───────────────────────────────────────
+        //   SSL_KTLS_ENABLED=true/false: 핸드셰이크 후 레코드 암복호화를 커널에 위임 시도
+        config.ssl_ktls_enabled = env_bool("SSL_KTLS_ENABLED", false);
+        //   SSL_SESSION_CACHE_SIZE=N: TLS 세션 재개 캐시 크기 (0 = 재개 비활성)
+        //   SSL_SESSION_TIMEOUT_SEC=N: frontend 세션/티켓 수명 (초)
+        config.ssl_session_cache_size = env_u32("SSL_SESSION_CACHE_SIZE", 1024);
+        config.ssl_session_timeout_sec = env_u32("SSL_SESSION_TIMEOUT_SEC", 300);
+
+        // ── 백엔드 연결 풀 (opt-in) ───────────────────────────────────────────
+        //   BACKEND_POOL_ENABLED=true/false
+        //   BACKEND_POOL_MAX_IDLE / BACKEND_POOL_MAX_IDLE_PER_KEY / BACKEND_POOL_IDLE_TIMEOUT_SEC
+        config.backend_pool_enabled = env_bool("BACKEND_POOL_ENABLED", false);
+        config.backend_pool_max_idle = env_u32("BACKEND_POOL_MAX_IDLE", 64);
+        config.backend_pool_max_idle_per_key = env_u32("BACKEND_POOL_MAX_IDLE_PER_KEY", 8);
+        config.backend_pool_idle_timeout_sec = env_u32("BACKEND_POOL_IDLE_TIMEOUT_SEC", 60);
+
+        // ── 커맨드 파이프라이닝 (opt-in) ──────────────────────────────────────
+        //   PIPELINE_DEPTH=N: 세션당 응답 대기 중 커맨드 상한 (0 = 직렬, 최대 64)
+        config.pipeline_depth = env_u32("PIPELINE_DEPTH", 0);
+
+        // ── 릴레이 버퍼 메모리 예산 ───────────────────────────────────────────
+        //   RELAY_SESSION_BUFFER_KB=N: 세션이 커맨드 사이에 유지하는 버퍼 상한 (KiB)
+        //   RELAY_GLOBAL_BUFFER_MB=N : 전체 세션 버퍼 상한 (MiB, 0 = 제한 없음)
+        config.relay_session_buffer_kb = env_u32("RELAY_SESSION_BUFFER_KB", 1024);
+        config.relay_global_buffer_mb = env_u32("RELAY_GLOBAL_BUFFER_MB", 0);
+
+        // ── fingerprint 별 Top-K 집계 ─────────────────────────────────────────
+        //   TOP_QUERIES_CAPACITY=N: 추적할 구문 형태 수 (UDS "top_queries", 0 = 비활성)
+        config.top_queries_capacity = env_u32("TOP_QUERIES_CAPACITY", 256);
+
+        // ── 정책 바이너리 스냅샷 (opt-in) ─────────────────────────────────────
+        //   POLICY_BINARY_SNAPSHOTS=true: .policy_versions/ 에 .bin 사본도 기록
+        config.policy_binary_snapshots = env_bool("POLICY_BINARY_SNAPSHOTS", false);
+
         // ── UDS 제어 소켓 보안 설정 (DON-53) ─────────────────────────────────
         config.uds_client_timeout_sec = env_u32("UDS_CLIENT_TIMEOUT_SEC", 30);
         config.uds_max_connections = env_u32("UDS_MAX_CONNECTIONS", 8);
@@ -132,18 +259,45 @@ int main(int /*argc*/, char* /*argv*/[]) {
         // ── 로깅 초기화 ─────────────────────────────────────────────────────
         spdlog::info("Starting dbgate proxy server");
         spdlog::info("Listen: {}:{}", config.listen_address, config.listen_port);
-        spdlog::info("Upstream: {}:{}", config.upstream_address, config.upstream_port);
+        if (config.upstream_list.empty()) {
+            spdlog::info("Upstream: {}:{}", config.upstream_address, config.upstream_port);
+        } else {
+            spdlog::info("Upstreams: {} ({})", config.upstream_list, config.upstream_balance);
+        }
         spdlog::info("Policy: {}", config.policy_path);
         spdlog::info("UDS socket: {}", config.uds_socket_path);
         spdlog::info("Log level: {}", config.log_level);
+        spdlog::info("SQL scan kernel: {}", sql_scan::kernel_name(sql_scan::active_kernel()));
+        spdlog::info("I/O backend: {}", io_backend_name());
+        // io_uring 빌드는 epoll 로 되돌릴 수 없다: 커널 / seccomp 가 막으면 기동하지 않는다
+        if (auto backend = probe_io_backend(); !backend) {
+            spdlog::error("I/O backend {} unavailable ({}); rebuild without "
+                          "DBGATE_ENABLE_IO_URING or allow io_uring_setup",
+                          io_backend_name(),
+                          backend.error());
+            return EXIT_FAILURE;
+        }
         spdlog::info("Frontend SSL: {}", config.frontend_ssl_enabled ? "enabled" : "disabled");
         spdlog::info("Backend SSL: {}", config.backend_ssl_enabled ? "enabled" : "disabled");
+        spdlog::info("Worker threads: {}", config.worker_threads);
 
         // ── ProxyServer 생성 및 실행 ────────────────────────────────────────
-        boost::asio::io_context ioc;
+        //   하나의 io_context 를 worker_threads 개 스레드가 공유한다.
+        //   (메인 스레드 포함 — 추가 스레드는 worker_threads - 1 개)
+        //   세션은 각자의 strand 에서 실행되므로 세션 내부 처리는 직렬화된다.
+        boost::asio::io_context ioc{static_cast<int>(config.worker_threads)};
         ProxyServer server{config};
         server.run(ioc);
-        ioc.run();
+
+        std::vector<std::thread> workers;
+        workers.reserve(config.worker_threads - 1U);
+        for (std::uint32_t i = 1; i < config.worker_threads; ++i) {
+            workers.emplace_back([&ioc]() { run_io_worker(ioc); });
+        }
+        run_io_worker(ioc);
+        for (auto& worker : workers) {
+            worker.join();
+        }
 
         // ── 종료 처리 ───────────────────────────────────────────────────────
         spdlog::info("Proxy server stopped");
@@ -30,6 +30,12 @@
 // - 인코딩 우회: URL 인코딩, hex 리터럴은 탐지 불가 (false negative).
 // - 빈 패턴 목록: 모든 SQL이 detected=false로 통과 (config 검증 필요).
 //
+// [다중 패턴 스캔]
+// 패턴마다 정규식을 순서대로 돌리면 정상 쿼리도 P 번 스캔된다. 생성자에서 각 패턴의
+// 필수 리터럴을 LiteralPrefilter 에 등록해 두고, check() 는 사전 필터 스캔 1회로
+// 후보 패턴만 골라 정규식으로 확정한다. 후보는 원래 패턴 순서대로 확인하므로
+// 첫 매칭 패턴(matched_pattern)은 사전 필터가 없을 때와 같다.
+//
 // [CompiledPattern 구현 주의사항]
 // InjectionDetector 헤더에서 ~InjectionDetector() = default 가 선언되어 있으므로
 // vector<CompiledPattern>의 소멸자가 헤더 인스턴스화 지점에서 CompiledPattern의
@@ -43,6 +49,8 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <regex>
 #include <string>
@@ -63,6 +71,9 @@ struct InjectionDetector::CompiledPattern {
     std::string source_pattern;            // 원본 패턴 문자열 (감사 로그용)
     std::shared_ptr<std::regex> compiled;  // 컴파일된 정규식
     std::string reason;                    // 사람이 읽을 수 있는 탐지 이유
+    // 사전 필터 리터럴 id 목록. 모두 등장해야 정규식 확인 대상이 된다.
+    // 비어 있으면 필수 리터럴을 추출하지 못한 패턴 → 항상 정규식 실행.
+    std::vector<std::uint32_t> anchors{};
 
     // CompiledPattern의 소멸자는 여기서 완전하게 정의됨.
     // shared_ptr<regex>의 소멸자는 이 시점에서 완전한 regex 정의를 가진다.
@@ -81,6 +92,26 @@ struct InjectionDetector::CompiledPattern {
     CompiledPattern& operator=(const CompiledPattern&) = default;
 };
 
+// ---------------------------------------------------------------------------
+// builtin_injection_patterns
+// ---------------------------------------------------------------------------
+const std::vector<std::string>& builtin_injection_patterns() {
+    // NOLINTNEXTLINE(cert-err58-cpp)
+    static const std::vector<std::string> kDefaultInjectionPatterns = {
+        R"(UNION\s+SELECT)",
+        R"(('\s*OR\s+['"\d]))",
+        R"(SLEEP\s*\()",
+        R"(BENCHMARK\s*\()",
+        R"(LOAD_FILE\s*\()",
+        R"(INTO\s+OUTFILE)",
+        R"(INTO\s+DUMPFILE)",
+        R"(;\s*(DROP|DELETE|UPDATE|INSERT|ALTER|CREATE))",
+        R"(--\s*$)",
+        R"(/\*.*\*/)",
+    };
+    return kDefaultInjectionPatterns;
+}
+
 // ---------------------------------------------------------------------------
 // InjectionDetector 소멸자
 // cpp에서 정의하는 이유: CompiledPattern의 완전한 정의 이후에 소멸자가 인스턴스화되어야
@@ -100,6 +131,9 @@ InjectionDetector::InjectionDetector(std::vector<std::string> patterns) {
             auto re = std::make_shared<std::regex>(
                 p, std::regex_constants::icase | std::regex_constants::ECMAScript);
             CompiledPattern cp(p, std::move(re), "Matched injection pattern: " + p);
+            for (const auto& literal : extract_required_literals(p)) {
+                cp.anchors.push_back(prefilter_.add(literal));
+            }
             compiled_patterns_.push_back(std::move(cp));
 
         } catch (const std::regex_error& e) {
@@ -111,6 +145,8 @@ InjectionDetector::InjectionDetector(std::vector<std::string> patterns) {
         }
     }
 
+    prefilter_.build();
+
     // [Fail-close 보장] 유효한 패턴이 하나도 없으면 fail_close_active_ 를 true 로 설정.
     // 이 상태에서 check() 는 항상 detected=true 를 반환하여 모든 SQL 을 차단한다.
     //
@@ -138,13 +174,22 @@ InjectionResult InjectionDetector::check(std::string_view sql) const {
             .detected = true, .matched_pattern = "", .reason = "no valid patterns loaded"};
     }
 
-    const std::string sql_str(sql);
+    // 1단계: 사전 필터 스캔 1회로 등장한 필수 리터럴 집합을 구한다.
+    std::vector<bool> found;
+    prefilter_.scan(sql, found);
 
+    // 2단계: 필수 리터럴이 모두 등장한 후보 패턴만 정규식으로 확정한다.
+    //   SQL 복사 없이 string_view 의 반복자 범위로 regex_search 를 수행한다.
     for (const auto& cp : compiled_patterns_) {
         if (!cp.compiled) {
             continue;
         }
-        if (std::regex_search(sql_str, *cp.compiled)) {
+        const bool candidate =
+            std::ranges::all_of(cp.anchors, [&found](std::uint32_t id) { return found[id]; });
+        if (!candidate) {
+            continue;
+        }
+        if (std::regex_search(sql.begin(), sql.end(), *cp.compiled)) {
             // 첫 번째 매칭 시 즉시 반환
             return InjectionResult{
                 .detected = true, .matched_pattern = cp.source_pattern, .reason = cp.reason};
@@ -34,10 +34,13 @@
 //   다른 규칙이 추가 필터링을 담당한다.
 // ---------------------------------------------------------------------------
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "parser/literal_prefilter.hpp"
+
 // ---------------------------------------------------------------------------
 // InjectionResult
 //   SQL Injection 탐지 결과.
@@ -50,16 +53,30 @@ struct InjectionResult {
     std::string reason{};               // 사람이 읽을 수 있는 탐지 이유
 };
 
+// ---------------------------------------------------------------------------
+// builtin_injection_patterns
+//   내장 기본 인젝션 패턴 10가지 (injection_detector.cpp 상단 주석 참조).
+//   PolicyEngine 이 정책 스냅샷마다 block_patterns 와 합쳐 공유 detector 를 만든다.
+// ---------------------------------------------------------------------------
+[[nodiscard]] const std::vector<std::string>& builtin_injection_patterns();
+
 // ---------------------------------------------------------------------------
 // InjectionDetector
 //   생성 시 패턴 목록을 받아 정규식으로 컴파일하고, check() 에서 매칭.
 //
 //   [성능 고려사항]
 //   - 생성자에서 std::regex 컴파일 비용이 발생하므로 인스턴스를 재사용할 것.
-//   - 패턴 수와 SQL 길이에 비례하여 O(P * N) 복잡도. 과도한 패턴 수는
-//     레이턴시를 증가시킨다.
+//   - 2단계 매칭: 각 패턴의 필수 리터럴(UNION, SLEEP(, OUTFILE 등)을 하나의
+//     Aho–Corasick 오토마톤(LiteralPrefilter)으로 묶어 SQL 을 한 번만 스캔하고,
+//     필수 리터럴이 모두 등장한 후보 패턴에만 std::regex_search 를 실행한다.
+//     정상 쿼리는 패턴 수와 무관하게 O(N) 스캔 1회로 끝난다.
+//   - 필수 리터럴을 추출할 수 없는 패턴(최상위 | 교대 등)은 매번 정규식을 실행한다.
 //   - 입력 길이 제한은 호출자(proxy 레이어)가 사전에 적용해야 한다.
 //
+//   [공유]
+//   - check() 는 const 이며 내부 상태를 바꾸지 않으므로 하나의 인스턴스를 여러 세션/
+//     워커 스레드가 동시에 사용해도 안전하다. PolicyEngine::injection_detector() 참조.
+//
 //   [Fail-close 보장]
 //   - 유효한 패턴이 0개(빈 목록 또는 모두 잘못된 정규식)이면 fail_close_active_
 //     플래그가 설정된다. 이후 check() 호출 시 항상 detected=true 를 반환하여
@@ -111,6 +128,9 @@ private:
     struct CompiledPattern;
     std::vector<CompiledPattern> compiled_patterns_;
 
+    // 모든 패턴의 필수 리터럴을 담은 사전 필터 (생성자에서 build 완료, 이후 읽기 전용)
+    LiteralPrefilter prefilter_{};
+
     // fail-close 플래그: 유효한 패턴이 하나도 없을 때 true.
     // check() 에서 즉시 detected=true 를 반환하여 모든 SQL 을 차단한다.
     bool fail_close_active_{false};
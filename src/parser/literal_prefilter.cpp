@@ -0,0 +1,362 @@
+// ---------------------------------------------------------------------------
+// literal_prefilter.cpp
+//
+// 필수 리터럴 추출 + Aho–Corasick 오토마톤 구현.
+//
+// [추출 규칙 요약]
+//   리터럴 문자       : 현재 run 에 이어 붙임
+//   \( \. \* 등       : 이스케이프된 구두점은 리터럴로 취급
+//   \s \d \w \b \1 등 : 문자 클래스/경계/역참조 — run 종료
+//   . [..] ^ $        : run 종료
+//   * ? {n,m}         : 직전 리터럴 문자는 선택적이 되므로 run 에서 제거 후 종료
+//   +                 : 직전 문자는 최소 1회 등장하므로 유지하고 run 종료
+//   (...)             : 교대/lookaround/선택적 수량자가 없으면 내부를 재귀 추출
+//   최상위 |          : 어느 분기가 매칭될지 모르므로 추출 결과 전체 폐기
+// ---------------------------------------------------------------------------
+
+#include "parser/literal_prefilter.hpp"
+
+#include <algorithm>
+#include <deque>
+
+namespace {
+
+char fold_ascii(char c) {
+    if (c >= 'a' && c <= 'z') {
+        return static_cast<char>(c - 'a' + 'A');
+    }
+    return c;
+}
+
+// pattern[open] == '[' 일 때 닫는 ']' 위치 (없으면 npos)
+std::size_t find_class_end(std::string_view pattern, std::size_t open) {
+    std::size_t i = open + 1;
+    if (i < pattern.size() && pattern[i] == '^') {
+        ++i;
+    }
+    if (i < pattern.size() && pattern[i] == ']') {
+        ++i;  // 첫 ']' 는 리터럴
+    }
+    for (; i < pattern.size(); ++i) {
+        if (pattern[i] == '\\') {
+            ++i;
+        } else if (pattern[i] == ']') {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+// pattern[open] == '(' 일 때 짝이 맞는 ')' 위치 (없으면 npos)
+std::size_t find_group_end(std::string_view pattern, std::size_t open) {
+    int depth = 0;
+    for (std::size_t i = open; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+        if (c == '\\') {
+            ++i;
+        } else if (c == '[') {
+            const auto end = find_class_end(pattern, i);
+            if (end == std::string_view::npos) {
+                return std::string_view::npos;
+            }
+            i = end;
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            if (--depth == 0) {
+                return i;
+            }
+        }
+    }
+    return std::string_view::npos;
+}
+
+// 최상위(괄호/클래스 밖) 교대 연산자 존재 여부
+bool has_top_level_alternation(std::string_view pattern) {
+    int depth = 0;
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+        if (c == '\\') {
+            ++i;
+        } else if (c == '[') {
+            const auto end = find_class_end(pattern, i);
+            if (end == std::string_view::npos) {
+                return true;  // 해석 불가 — 보수적으로 교대 있음 처리
+            }
+            i = end;
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        } else if (c == '|' && depth == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 이스케이프 뒤 문자가 리터럴 구두점인지 (\s \d \b \1 \x41 등은 false)
+bool is_escaped_literal(char c) {
+    const auto u = static_cast<unsigned char>(c);
+    const bool alnum = (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9');
+    return !alnum;
+}
+
+// pattern[i] == '\\' 인 비리터럴 이스케이프의 전체 길이.
+// \xHH / \uHHHH / \cX / \12 처럼 뒤따르는 문자를 소비하는 형태를 처리하여
+// 그 문자들이 리터럴 run 으로 잘못 들어가지 않게 한다.
+std::size_t escape_length(std::string_view pattern, std::size_t i) {
+    const char kind = pattern[i + 1];
+    std::size_t len = 2;
+    if (kind == 'x') {
+        len = 4;
+    } else if (kind == 'u') {
+        len = 6;
+    } else if (kind == 'c') {
+        len = 3;
+    } else if (kind >= '0' && kind <= '9') {
+        while (i + len < pattern.size() && pattern[i + len] >= '0' && pattern[i + len] <= '9') {
+            ++len;
+        }
+    }
+    return std::min(len, pattern.size() - i);
+}
+
+// 수량자 시작 여부. optional: 직전 atom 이 0회 등장할 수 있으면 true
+bool quantifier_at(std::string_view pattern, std::size_t i, bool& optional, std::size_t& len) {
+    if (i >= pattern.size()) {
+        return false;
+    }
+    const char c = pattern[i];
+    if (c == '*' || c == '?' || c == '+') {
+        optional = (c != '+');
+        len = 1;
+    } else if (c == '{') {
+        const auto close = pattern.find('}', i);
+        optional = true;  // {n,m} 은 보수적으로 선택적으로 본다
+        len = (close == std::string_view::npos) ? pattern.size() - i : close - i + 1;
+    } else {
+        return false;
+    }
+    // 비탐욕 접미사 (*? +? {n}?)
+    if (i + len < pattern.size() && pattern[i + len] == '?') {
+        ++len;
+    }
+    return true;
+}
+
+class LiteralExtractor {
+public:
+    explicit LiteralExtractor(std::vector<std::string>& out) : out_{out} {}
+
+    // 순차열(sequence) 하나를 처리한다. 교대가 있으면 false.
+    bool extract(std::string_view pattern) {
+        if (has_top_level_alternation(pattern)) {
+            return false;
+        }
+        std::size_t i = 0;
+        while (i < pattern.size()) {
+            const char c = pattern[i];
+            if (c == '\\') {
+                if (i + 1 >= pattern.size()) {
+                    return false;
+                }
+                if (is_escaped_literal(pattern[i + 1])) {
+                    i = literal(pattern, i + 1, i + 2);
+                } else {
+                    flush();
+                    i = skip_quantifier(pattern, i + escape_length(pattern, i));
+                }
+            } else if (c == '(') {
+                flush();
+                const auto end = find_group_end(pattern, i);
+                if (end == std::string_view::npos) {
+                    return false;
+                }
+                bool optional = false;
+                std::size_t qlen = 0;
+                const bool quantified = quantifier_at(pattern, end + 1, optional, qlen);
+                std::string_view inner = pattern.substr(i + 1, end - i - 1);
+                const bool lookaround = inner.starts_with("?=") || inner.starts_with("?!") ||
+                                        inner.starts_with("?<");
+                if (inner.starts_with("?:")) {
+                    inner.remove_prefix(2);
+                }
+                if (!lookaround && !(quantified && optional)) {
+                    // 내부 교대 등으로 추출 불가여도 바깥 추출은 계속한다
+                    std::vector<std::string> nested;
+                    LiteralExtractor sub{nested};
+                    if (sub.extract(inner)) {
+                        out_.insert(out_.end(), nested.begin(), nested.end());
+                    }
+                }
+                i = end + 1 + (quantified ? qlen : 0);
+            } else if (c == '[') {
+                flush();
+                const auto end = find_class_end(pattern, i);
+                if (end == std::string_view::npos) {
+                    return false;
+                }
+                i = skip_quantifier(pattern, end + 1);
+            } else if (c == '.' || c == '^' || c == '$') {
+                flush();
+                i = skip_quantifier(pattern, i + 1);
+            } else if (c == '*' || c == '+' || c == '?' || c == '{' || c == ')') {
+                // 해석 불가 위치의 메타 문자 — 보수적으로 run 만 종료
+                flush();
+                ++i;
+            } else {
+                i = literal(pattern, i, i + 1);
+            }
+        }
+        flush();
+        return true;
+    }
+
+private:
+    std::vector<std::string>& out_;
+    std::string run_{};
+
+    void flush() {
+        if (!run_.empty()) {
+            out_.push_back(std::move(run_));
+            run_.clear();
+        }
+    }
+
+    // 리터럴 문자 pattern[ch] 를 처리하고, 뒤따르는 수량자를 반영한 다음 위치 반환
+    std::size_t literal(std::string_view pattern, std::size_t ch, std::size_t next) {
+        bool optional = false;
+        std::size_t qlen = 0;
+        if (quantifier_at(pattern, next, optional, qlen)) {
+            if (!optional) {
+                run_.push_back(fold_ascii(pattern[ch]));
+            }
+            flush();
+            return next + qlen;
+        }
+        run_.push_back(fold_ascii(pattern[ch]));
+        return next;
+    }
+
+    static std::size_t skip_quantifier(std::string_view pattern, std::size_t i) {
+        bool optional = false;
+        std::size_t qlen = 0;
+        return quantifier_at(pattern, i, optional, qlen) ? i + qlen : i;
+    }
+};
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// extract_required_literals
+// ---------------------------------------------------------------------------
+std::vector<std::string> extract_required_literals(std::string_view pattern) {
+    std::vector<std::string> literals;
+    LiteralExtractor extractor{literals};
+    if (!extractor.extract(pattern)) {
+        return {};
+    }
+    // 중복 제거 (순서는 의미 없음)
+    std::ranges::sort(literals);
+    const auto dup = std::ranges::unique(literals);
+    literals.erase(dup.begin(), dup.end());
+    return literals;
+}
+
+// ---------------------------------------------------------------------------
+// LiteralPrefilter
+// ---------------------------------------------------------------------------
+std::uint32_t LiteralPrefilter::new_state() {
+    std::array<std::uint32_t, 256> row{};
+    row.fill(kNoEdge);
+    delta_.push_back(row);
+    outputs_.emplace_back();
+    return static_cast<std::uint32_t>(delta_.size() - 1);
+}
+
+std::uint32_t LiteralPrefilter::add(std::string_view literal) {
+    std::string folded(literal);
+    std::ranges::transform(folded, folded.begin(), fold_ascii);
+
+    const auto it = std::ranges::find(literals_, folded);
+    if (it != literals_.end()) {
+        return static_cast<std::uint32_t>(it - literals_.begin());
+    }
+
+    if (delta_.empty()) {
+        new_state();  // root
+    }
+    built_ = false;
+
+    std::uint32_t state = 0;
+    for (const char c : folded) {
+        const auto idx = static_cast<unsigned char>(c);
+        if (delta_[state][idx] == kNoEdge) {
+            const auto next = new_state();
+            delta_[state][idx] = next;
+        }
+        state = delta_[state][idx];
+    }
+
+    const auto id = static_cast<std::uint32_t>(literals_.size());
+    literals_.push_back(std::move(folded));
+    outputs_[state].push_back(id);
+    return id;
+}
+
+void LiteralPrefilter::build() {
+    if (delta_.empty()) {
+        new_state();
+    }
+
+    // BFS 로 실패 링크를 계산하며 누락 전이를 채워 완전 DFA 로 만든다.
+    std::vector<std::uint32_t> fail(delta_.size(), 0);
+    std::deque<std::uint32_t> queue;
+
+    for (std::size_t c = 0; c < 256; ++c) {
+        auto& edge = delta_[0][c];
+        if (edge == kNoEdge) {
+            edge = 0;
+        } else {
+            fail[edge] = 0;
+            queue.push_back(edge);
+        }
+    }
+
+    while (!queue.empty()) {
+        const auto state = queue.front();
+        queue.pop_front();
+
+        // 실패 링크 상태의 출력도 이 상태에서 끝나는 것으로 합친다 (접미사 매칭)
+        const auto& inherited = outputs_[fail[state]];
+        outputs_[state].insert(outputs_[state].end(), inherited.begin(), inherited.end());
+
+        for (std::size_t c = 0; c < 256; ++c) {
+            auto& edge = delta_[state][c];
+            if (edge == kNoEdge) {
+                edge = delta_[fail[state]][c];
+            } else {
+                fail[edge] = delta_[fail[state]][c];
+                queue.push_back(edge);
+            }
+        }
+    }
+
+    built_ = true;
+}
+
+void LiteralPrefilter::scan(std::string_view text, std::vector<bool>& found) const {
+    found.assign(literals_.size(), false);
+    if (!built_ || literals_.empty()) {
+        return;
+    }
+
+    std::uint32_t state = 0;
+    for (const char c : text) {
+        state = delta_[state][static_cast<unsigned char>(fold_ascii(c))];
+        for (const auto id : outputs_[state]) {
+            found[id] = true;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// literal_prefilter.hpp
+//
+// 정규식 다중 패턴 매칭용 리터럴 사전 필터 (Aho–Corasick).
+//
+// [동작 개요]
+// 1. extract_required_literals(): 각 정규식에서 "매칭이 성립하려면 반드시 등장해야
+//    하는" 리터럴 조각(anchor)을 보수적으로 추출한다. 예: UNION\s+SELECT → UNION, SELECT
+// 2. LiteralPrefilter: 모든 패턴의 anchor 를 하나의 Aho–Corasick 오토마톤으로 묶어
+//    입력을 한 번만 스캔하고, 등장한 anchor 집합을 돌려준다.
+// 3. 호출자는 anchor 가 모두 등장한 패턴(후보)에 대해서만 정규식을 실행하여 확정한다.
+//
+// [정확성 원칙 — 미탐 금지]
+// - 추출은 필요조건만 사용한다. 확실하지 않은 구문(교대 |, 선택적 그룹, lookaround,
+//   역참조 등)을 만나면 해당 부분은 anchor 로 쓰지 않는다.
+// - anchor 를 하나도 뽑지 못한 패턴은 항상 후보로 취급한다 (매 쿼리 정규식 실행).
+// - 따라서 사전 필터 유무와 관계없이 탐지 결과는 동일하며, 달라지는 것은 비용뿐이다.
+//
+// [대소문자]
+// - ASCII 대소문자를 접어서(대문자) 비교한다. InjectionDetector 는 icase 로 정규식을
+//   컴파일하므로 결과가 일치한다. 비ASCII 바이트는 그대로 비교한다.
+// ---------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// extract_required_literals
+//   ECMAScript 정규식 pattern 에서 매칭에 반드시 포함되는 리터럴 조각 목록을 반환한다.
+//   반환 문자열은 ASCII 대문자로 접혀 있다. 추출 불가 시 빈 벡터.
+// ---------------------------------------------------------------------------
+[[nodiscard]] std::vector<std::string> extract_required_literals(std::string_view pattern);
+
+// ---------------------------------------------------------------------------
+// LiteralPrefilter
+//   add() 로 리터럴을 모두 등록한 뒤 build() 를 한 번 호출하고, 이후 scan() 을
+//   여러 스레드에서 동시에 호출할 수 있다 (build 이후 읽기 전용).
+//
+//   [복잡도]
+//   - scan: O(N + 매칭 수). 등록된 패턴 수와 무관하게 입력을 한 번만 읽는다.
+//   - 메모리: 노드당 256 전이 (uint32) — 노드 수는 등록 리터럴 총 길이 이하.
+// ---------------------------------------------------------------------------
+class LiteralPrefilter {
+public:
+    LiteralPrefilter() = default;
+
+    // add
+    //   리터럴을 등록하고 id 를 반환한다. 대소문자만 다른 중복 리터럴은 같은 id.
+    //   빈 리터럴은 등록하지 않는다 (호출자가 걸러야 함).
+    std::uint32_t add(std::string_view literal);
+
+    // build
+    //   실패 링크를 계산하여 전이 테이블을 완성한다. add() 이후 한 번 호출.
+    void build();
+
+    // scan
+    //   text 를 한 번 스캔하여 등장한 리터럴 id 에 대해 found[id] = true 로 설정한다.
+    //   found 는 size() 크기로 리셋된다.
+    void scan(std::string_view text, std::vector<bool>& found) const;
+
+    // 등록된 (중복 제거된) 리터럴 수
+    [[nodiscard]] std::size_t size() const noexcept { return literals_.size(); }
+
+private:
+    static constexpr std::uint32_t kNoEdge = UINT32_MAX;
+
+    std::vector<std::string> literals_{};                  // id → 접힌 리터럴
+    std::vector<std::array<std::uint32_t, 256>> delta_{};  // 상태별 전이 (build 후 완전 DFA)
+    std::vector<std::vector<std::uint32_t>> outputs_{};    // 상태별 종료 리터럴 id
+    bool built_{false};
+
+    std::uint32_t new_state();
+};
@@ -36,57 +36,87 @@
 #include <algorithm>
 #include <cctype>
 #include <ranges>
-#include <regex>
 #include <string>
+#include <string_view>
 
 // ---------------------------------------------------------------------------
 // 익명 네임스페이스: 내부 헬퍼
 // ---------------------------------------------------------------------------
 namespace {
 
-// 문자열을 대문자로 변환 (ASCII only)
-std::string to_upper_str(const std::string& s) {
-    std::string result(s);
-    std::ranges::transform(
-        result, result.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
-    return result;
+// ECMAScript \b 와 같은 단어 문자 ([A-Za-z0-9_])
+bool is_word_char(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+// ECMAScript \s (ASCII 범위)
+bool is_space_char(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
 }
 
 // raw_sql에서 CALL 뒤의 프로시저 이름을 추출한다.
-// 정규식: CALL\s+([\w.]+)\s*\(
-// 반환: 프로시저 이름 문자열, 실패 시 빈 문자열
+// 정규식 CALL\s+([\w.]+)\s*\( (icase) 의 leftmost 매칭과 같은 결과를 손으로 훑어 얻는다
+// (커맨드마다 std::regex 를 만들던 비용 제거 — 할당 없음).
+// 반환: 프로시저 이름 문자열(원문 케이스 보존), 실패 시 빈 문자열
 //
 // [한계]
 // - CALL 과 프로시저명 사이에 주석이 있으면 탐지 실패.
 // - schema.proc_name 형태 지원 (점 포함).
-std::string extract_procedure_name(const std::string& raw_sql) {
-    try {
-        // case-insensitive: 원문 SQL에서 직접 추출하여 케이스 보존
-        const std::regex call_re(R"(CALL\s+([\w.]+)\s*\()",
-                                 std::regex_constants::icase | std::regex_constants::ECMAScript);
+std::string_view extract_procedure_name(std::string_view raw_sql) {
+    constexpr std::string_view kCall{"CALL"};
+    const auto is_name_char = [](char c) { return is_word_char(c) || c == '.'; };
 
-        std::smatch m;
-        if (std::regex_search(raw_sql, m, call_re) && m.size() >= 2) {
-            return m[1].str();
+    for (std::size_t i = 0; i + kCall.size() <= raw_sql.size(); ++i) {
+        const bool keyword = std::ranges::equal(
+            raw_sql.substr(i, kCall.size()), kCall, [](unsigned char a, unsigned char b) {
+                return std::toupper(a) == b;
+            });
+        if (!keyword) {
+            continue;
+        }
+        std::size_t pos = i + kCall.size();
+        const std::size_t ws_begin = pos;
+        while (pos < raw_sql.size() && is_space_char(raw_sql[pos])) {
+            ++pos;
+        }
+        if (pos == ws_begin) {
+            continue;  // \s+
+        }
+        const std::size_t name_begin = pos;
+        while (pos < raw_sql.size() && is_name_char(raw_sql[pos])) {
+            ++pos;
+        }
+        const std::size_t name_end = pos;
+        while (pos < raw_sql.size() && is_space_char(raw_sql[pos])) {
+            ++pos;
+        }
+        if (name_end > name_begin && pos < raw_sql.size() && raw_sql[pos] == '(') {
+            return raw_sql.substr(name_begin, name_end - name_begin);
         }
-    } catch (const std::regex_error&) {  // NOLINT(bugprone-empty-catch)
-        // 정규식 오류는 무시하고 빈 이름 반환 — caller에게 빈 문자열로 안전하게 전달
     }
-
     return {};
 }
 
-// raw_sql을 대문자로 변환하여 특정 단어 포함 여부 확인
-// word_boundary 적용: 단어 경계 매칭
-bool contains_word(const std::string& raw_sql, const std::string& word) {
-    const std::string upper = to_upper_str(raw_sql);
-    try {
-        const std::regex re("\\b" + word + "\\b", std::regex_constants::ECMAScript);
-        return std::regex_search(upper, re);
-    } catch (const std::regex_error&) {
-        // 폴백: 단순 문자열 탐색
-        return upper.find(word) != std::string::npos;
+// raw_sql 에 대문자 키워드 word 가 단어 경계로 포함되어 있는지 (대소문자 무관, ASCII)
+// 대문자 사본/정규식 없이 원문을 한 번 훑는다 (데이터패스 할당 없음).
+bool contains_word(std::string_view raw_sql, std::string_view word) {
+    if (word.empty() || raw_sql.size() < word.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i + word.size() <= raw_sql.size(); ++i) {
+        if ((i > 0 && is_word_char(raw_sql[i - 1])) ||
+            (i + word.size() < raw_sql.size() && is_word_char(raw_sql[i + word.size()]))) {
+            continue;
+        }
+        const bool equal = std::ranges::equal(
+            raw_sql.substr(i, word.size()), word, [](unsigned char a, unsigned char b) {
+                return std::toupper(a) == b;
+            });
+        if (equal) {
+            return true;
+        }
     }
+    return false;
 }
 
 }  // namespace
@@ -98,11 +128,12 @@ bool contains_word(const std::string& raw_sql, const std::string& word) {
 std::optional<ProcedureInfo> ProcedureDetector::detect(const ParsedQuery& query) const {
     switch (query.command) {
         // CALL proc_name(...) 탐지
+        // 프로시저명은 ParsedQuery 와 같은 리소스(세션 QueryArena)에 복사한다
         case SqlCommand::kCall: {
-            const std::string proc_name = extract_procedure_name(query.raw_sql);
             return ProcedureInfo{
                 .type = ProcedureType::kCall,
-                .procedure_name = proc_name,
+                .procedure_name = std::pmr::string{extract_procedure_name(query.raw_sql),
+                                                   query.resource()},
                 .is_dynamic_sql = false  // CALL 자체는 동적 SQL이 아님
             };
         }
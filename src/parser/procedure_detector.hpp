@@ -23,6 +23,7 @@
 // - block_dynamic_sql=false 설정 시: 동적 SQL 우회를 허용한다 (false negative).
 // ---------------------------------------------------------------------------
 
+#include <memory_resource>
 #include <optional>
 #include <string>
 
@@ -50,7 +51,8 @@ struct ProcedureInfo {
 
     // CALL proc_name(...) 에서 추출한 프로시저 이름.
     // kCall 이외의 type 에서는 비어 있을 수 있다.
-    std::string procedure_name{};
+    // ParsedQuery::resource() 에서 할당한다 (세션에서는 커맨드 단위 QueryArena).
+    std::pmr::string procedure_name{};
 
     // PREPARE/EXECUTE 구문 여부.
     // true 이면 동적 SQL 우회 가능성이 있음을 의미한다.
@@ -88,4 +90,21 @@ public:
     // 위험한 SQL 이어도 탐지하지 못한다.
     [[nodiscard]] std::optional<ProcedureInfo>
     detect(const ParsedQuery& query) const;
+
+    // is_candidate
+    //   command 가 detect 결과를 낼 수 있는 커맨드인지. false 이면 detect 는 항상
+    //   nullopt 이므로 호출자는 탐지를 건너뛴다 (SELECT/INSERT 등 대부분의 커맨드).
+    [[nodiscard]] static constexpr bool is_candidate(SqlCommand command) noexcept {
+        switch (command) {
+            case SqlCommand::kCall:
+            case SqlCommand::kCreate:
+            case SqlCommand::kAlter:
+            case SqlCommand::kDrop:
+            case SqlCommand::kPrepare:
+            case SqlCommand::kExecute:
+                return true;
+            default:
+                return false;
+        }
+    }
 };
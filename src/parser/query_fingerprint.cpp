@@ -0,0 +1,93 @@
+// ---------------------------------------------------------------------------
+// query_fingerprint.cpp
+//
+// SqlLexer 토큰을 한 번 순회하며 fingerprint 를 만든다.
+// SqlParser 와 같은 렉서를 쓰므로 문자열/주석 경계 판정이 파서와 항상 일치한다.
+// 이미 토큰화한 SqlTokenList 를 받으면 SqlTokenCursor 로 같은 토큰을 재생한다.
+// ---------------------------------------------------------------------------
+
+#include "parser/query_fingerprint.hpp"
+
+#include <algorithm>
+
+namespace {
+
+bool is_number_word(std::string_view text) {
+    return !text.empty() && std::ranges::all_of(text, [](char c) { return c >= '0' && c <= '9'; });
+}
+
+// append_fingerprint: tokens(SqlLexer / SqlTokenCursor) 의 fingerprint 를 out 에 만든다.
+// 묶을 수 없는 쿼리면 false.
+template <typename TokenSource, typename String>
+bool append_fingerprint(TokenSource& tokens, String& out) {
+    out.reserve(tokens.source().size());
+
+    for (auto tok = tokens.next(); tok.kind != SqlTokenKind::kEnd; tok = tokens.next()) {
+        if (tok.separated_before && !out.empty()) {
+            out.push_back(' ');
+        }
+
+        switch (tok.kind) {
+            case SqlTokenKind::kString:
+                out.append("'?'");
+                break;
+            case SqlTokenKind::kWord:
+                if (is_number_word(tok.text)) {
+                    out.push_back('?');
+                } else {
+                    out.append(tok.text);
+                }
+                break;
+            case SqlTokenKind::kQuotedIdentifier:
+                out.append(tok.text);
+                break;
+            case SqlTokenKind::kSymbol: {
+                const char c = tok.text.front();
+                if (c == ';') {
+                    return false;
+                }
+                if (c == '?' || c == '\\') {
+                    out.push_back('\\');
+                }
+                out.push_back(c);
+                break;
+            }
+            case SqlTokenKind::kEnd:
+                break;
+        }
+    }
+
+    return !out.empty();
+}
+
+}  // namespace
+
+std::optional<std::string> fingerprint_query(std::string_view sql) {
+    std::string out;
+    SqlLexer lexer{sql};
+    if (!append_fingerprint(lexer, out)) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+std::optional<std::pmr::string> fingerprint_query(std::string_view sql,
+                                                  std::pmr::memory_resource* mr) {
+    std::pmr::string out{mr};
+    SqlLexer lexer{sql};
+    if (!append_fingerprint(lexer, out)) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+std::optional<std::pmr::string> fingerprint_query(std::string_view sql,
+                                                  const SqlTokenList& tokens,
+                                                  std::pmr::memory_resource* mr) {
+    std::pmr::string out{mr};
+    SqlTokenCursor cursor{tokens, sql};
+    if (!append_fingerprint(cursor, out)) {
+        return std::nullopt;
+    }
+    return out;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// query_fingerprint.hpp
+//
+// 리터럴만 다른 쿼리를 같은 문자열로 묶는 구문 형태(fingerprint) 정규화.
+//
+// [정규화 규칙] — SqlLexer 토큰 기준
+//   문자열 리터럴 '...' / "..."  → '?'
+//   숫자로만 이루어진 단어          → ?
+//   공백/주석                       → 단일 공백 (분리 여부만 보존)
+//   그 외 토큰(키워드, 식별자, 백틱 식별자, 기호) → 원문 그대로
+//   원문 기호 '?' 와 '\' 는 '\' 를 앞에 붙여 치환 결과와 구분한다.
+//
+// [보안 — 정규화가 판정을 바꾸지 않아야 한다]
+// fingerprint 는 판정 캐시 키로 쓰이므로, 같은 fingerprint 의 두 쿼리는 SqlParser 가
+// 같은 command / tables / 멀티 스테이트먼트 판정을 내려야 한다.
+// - 토큰 간 분리 여부를 보존한다 (첫 키워드 뒤 분리 여부가 command 판정에 쓰임).
+// - 세미콜론이 있으면 std::nullopt. 파서는 세미콜론 뒤 주석 유무로 멀티 스테이트먼트를
+//   판정하는데, 주석은 정규화에서 사라지므로 안전하게 묶을 수 없다.
+// - 리터럴 내용에 의존하는 판정(block_patterns 정규식 등)은 캐시하지 말고
+//   원문에 대해 매번 수행해야 한다 (PolicyEngine::evaluate_cached 참조).
+// ---------------------------------------------------------------------------
+
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "parser/sql_lexer.hpp"  // SqlTokenList
+
+// ---------------------------------------------------------------------------
+// fingerprint_query
+//   sql 의 fingerprint 를 반환한다.
+//   std::nullopt: 토큰이 없거나 세미콜론을 포함하여 묶을 수 없는 쿼리.
+// ---------------------------------------------------------------------------
+[[nodiscard]] std::optional<std::string> fingerprint_query(std::string_view sql);
+
+// fingerprint_query (memory_resource 오버로드)
+//   같은 결과를 mr 에서 할당한 문자열로 반환한다 (세션 데이터패스: 커맨드 단위 QueryArena).
+[[nodiscard]] std::optional<std::pmr::string> fingerprint_query(std::string_view sql,
+                                                                std::pmr::memory_resource* mr);
+
+// fingerprint_query (토큰 공유 오버로드)
+//   tokens: tokenize_sql(sql) 결과. 원문을 다시 렉싱하지 않는다 (SqlParser 와 공유).
+[[nodiscard]] std::optional<std::pmr::string> fingerprint_query(std::string_view sql,
+                                                                const SqlTokenList& tokens,
+                                                                std::pmr::memory_resource* mr);
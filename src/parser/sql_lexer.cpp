@@ -0,0 +1,130 @@
+// ---------------------------------------------------------------------------
+// sql_lexer.cpp
+//
+// SqlLexer 구현. 원문을 앞에서 뒤로 한 번만 스캔하며 할당하지 않는다.
+// 문자열/주석 경계 판정 규칙은 멀티 스테이트먼트 감지(DON-25)와 동일하게
+// 유지해야 한다. 규칙이 어긋나면 세미콜론 은닉 우회가 생긴다.
+//
+// 주석/문자열 내부는 sql_scan::find_first_of2 로 다음 구분 문자('*', 개행, 인용 문자,
+// 백슬래시)까지 한 번에 건너뛴다. 구분 문자 위치에서의 판정은 바이트 단위 루프와 같다.
+// ---------------------------------------------------------------------------
+
+#include "parser/sql_lexer.hpp"
+
+#include "parser/sql_scan.hpp"
+
+bool SqlLexer::skip_separators() noexcept {
+    const std::size_t len = sql_.size();
+    const std::size_t start = pos_;
+
+    while (pos_ < len) {
+        const char c = sql_[pos_];
+        const char next = (pos_ + 1 < len) ? sql_[pos_ + 1] : '\0';
+
+        if (is_sql_space(c)) {
+            ++pos_;
+            continue;
+        }
+
+        // 블록 주석 /* ... */ (중첩 미지원 — MySQL 도 중첩을 허용하지 않음)
+        if (c == '/' && next == '*') {
+            std::size_t star = pos_ + 2;
+            while (true) {
+                star = sql_scan::find_first_of2(sql_, star, '*', '*');
+                if (star + 1 >= len || sql_[star + 1] == '/') {
+                    break;
+                }
+                ++star;
+            }
+            // 닫히지 않은 블록 주석은 입력 끝까지 주석으로 본다
+            pos_ = (star + 1 < len) ? star + 2 : len;
+            continue;
+        }
+
+        // 라인 주석 -- / # (줄 끝까지, 개행 문자는 공백으로 다음 루프에서 소비)
+        if ((c == '-' && next == '-') || c == '#') {
+            pos_ = sql_scan::find_first_of2(sql_, pos_, '\n', '\n');
+            continue;
+        }
+
+        break;
+    }
+
+    return pos_ != start;
+}
+
+void SqlLexer::skip_quoted(char quote, bool allow_backslash) noexcept {
+    const std::size_t len = sql_.size();
+    ++pos_;  // 여는 인용 문자
+    const char escape = allow_backslash ? '\\' : quote;
+
+    while (pos_ < len) {
+        // 다음 인용 문자/백슬래시까지 건너뜀 (그 사이 바이트는 판정에 영향 없음)
+        pos_ = sql_scan::find_first_of2(sql_, pos_, quote, escape);
+        if (pos_ >= len) {
+            break;
+        }
+        const char c = sql_[pos_];
+        if (allow_backslash && c == '\\') {
+            // 이스케이프 문자: 다음 문자 건너뜀 (\' 등)
+            pos_ += 2;
+            continue;
+        }
+        if (c == quote) {
+            if (pos_ + 1 < len && sql_[pos_ + 1] == quote) {
+                // '' / "" / `` 이스케이프: 두 번째 인용 문자 건너뜀
+                pos_ += 2;
+                continue;
+            }
+            ++pos_;  // 닫는 인용 문자
+            return;
+        }
+    }
+
+    // 닫히지 않은 인용: 입력 끝까지 (백슬래시가 마지막 바이트인 경우 보정)
+    pos_ = len;
+}
+
+SqlToken SqlLexer::next() noexcept {
+    const bool separated = skip_separators() || pos_ == 0;
+
+    const std::size_t len = sql_.size();
+    if (pos_ >= len) {
+        pos_ = len;
+        return SqlToken{
+            .kind = SqlTokenKind::kEnd, .text = {}, .offset = len, .separated_before = separated};
+    }
+
+    const std::size_t start = pos_;
+    const char c = sql_[pos_];
+    SqlTokenKind kind = SqlTokenKind::kSymbol;
+
+    if (is_sql_word_char(c)) {
+        kind = SqlTokenKind::kWord;
+        while (pos_ < len && is_sql_word_char(sql_[pos_])) {
+            ++pos_;
+        }
+    } else if (c == '\'' || c == '"') {
+        kind = SqlTokenKind::kString;
+        skip_quoted(c, /*allow_backslash=*/true);
+    } else if (c == '`') {
+        kind = SqlTokenKind::kQuotedIdentifier;
+        skip_quoted(c, /*allow_backslash=*/false);
+    } else {
+        ++pos_;
+    }
+
+    return SqlToken{.kind = kind,
+                    .text = sql_.substr(start, pos_ - start),
+                    .offset = start,
+                    .separated_before = separated};
+}
+
+SqlTokenList tokenize_sql(std::string_view sql, std::pmr::memory_resource* mr) {
+    SqlTokenList tokens{mr};
+    SqlLexer lexer{sql};
+    for (auto tok = lexer.next(); tok.kind != SqlTokenKind::kEnd; tok = lexer.next()) {
+        tokens.push_back(tok);
+    }
+    return tokens;
+}
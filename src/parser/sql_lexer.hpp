@@ -0,0 +1,190 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// sql_lexer.hpp
+//
+// SQL 원문을 한 번의 선형 스캔으로 토큰화하는 경량 렉서.
+//
+// [설계 원칙]
+// - zero-allocation: 토큰은 원문을 가리키는 std::string_view 이며,
+//   렉서는 힙 할당을 하지 않는다. 원문은 토큰 사용이 끝날 때까지 살아 있어야 한다.
+// - 주석(/* */, --, #)은 토큰으로 방출하지 않고 건너뛴다.
+//   단, 직전 토큰과 현재 토큰이 주석/공백으로 분리되었는지는 기록한다.
+// - 문자열 리터럴('...', "...")과 백틱 식별자(`...`)는 하나의 토큰으로 묶는다.
+//   문자열/백틱 내부의 세미콜론·주석 기호·키워드는 구문으로 해석되지 않는다.
+//
+// [MySQL 렉서와의 차이 — 보수적 선택]
+// - "--" 는 뒤따르는 공백 여부와 무관하게 라인 주석으로 본다 (MySQL 은 "-- " 요구).
+// - /*! ... */ 조건부 실행 주석도 일반 블록 주석처럼 건너뛴다 (알려진 미탐).
+// - 문자열 내부 백슬래시 이스케이프는 항상 적용한다 (NO_BACKSLASH_ESCAPES 미반영).
+// - 닫히지 않은 문자열/주석/백틱은 입력 끝까지를 하나의 영역으로 본다.
+//
+// [토큰 공유 — tokenize_sql / SqlTokenCursor]
+// 세션 데이터패스는 원문을 tokenize_sql 로 한 번만 토큰화하고, 같은 SqlTokenList 를
+// fingerprint_query 와 SqlParser::parse 가 SqlTokenCursor 로 재생한다 (렉싱 1회).
+// 커서는 SqlLexer 와 같은 next() 를 제공하므로 두 소비자는 렉서/커서 어느 쪽이든 쓴다.
+// ---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// SqlTokenKind
+//   kWord             : 키워드/비인용 식별자/숫자 (영숫자, '_', '$', 비ASCII 바이트)
+//   kQuotedIdentifier : `ident` (text 는 백틱 포함 원문)
+//   kString           : 'str' 또는 "str" (text 는 따옴표 포함 원문)
+//   kSymbol           : 그 외 단일 문자 ( ) , . ; = 등
+//   kEnd              : 입력 끝
+// ---------------------------------------------------------------------------
+enum class SqlTokenKind : std::uint8_t {
+    kWord = 0,
+    kQuotedIdentifier = 1,
+    kString = 2,
+    kSymbol = 3,
+    kEnd = 4,
+};
+
+// ---------------------------------------------------------------------------
+// SqlToken
+//   text             : 원문 SQL 내부를 가리키는 view (복사 없음)
+//   offset           : 원문 기준 시작 오프셋
+//   separated_before : 직전 토큰과의 사이에 공백 또는 주석이 있었으면 true
+//                      (첫 토큰은 항상 true)
+// ---------------------------------------------------------------------------
+struct SqlToken {
+    SqlTokenKind kind{SqlTokenKind::kEnd};
+    std::string_view text{};
+    std::size_t offset{0};
+    bool separated_before{true};
+
+    // end_offset: 토큰 바로 뒤 원문 오프셋 (SqlLexer::position() 과 같다)
+    [[nodiscard]] std::size_t end_offset() const noexcept { return offset + text.size(); }
+};
+
+// ---------------------------------------------------------------------------
+// SqlLexer
+//   next() 를 반복 호출하여 토큰을 순서대로 얻는다. kEnd 이후 호출은 계속 kEnd.
+//
+//   사용 예:
+//     SqlLexer lexer{sql};
+//     for (auto tok = lexer.next(); tok.kind != SqlTokenKind::kEnd; tok = lexer.next()) {
+//         ...
+//     }
+//
+//   상태를 가지므로 인스턴스를 스레드 간 공유하지 않는다 (호출마다 지역 생성).
+// ---------------------------------------------------------------------------
+class SqlLexer {
+public:
+    explicit SqlLexer(std::string_view sql) noexcept : sql_{sql} {}
+
+    // next
+    //   다음 토큰을 반환한다. 주석과 공백은 건너뛴다.
+    [[nodiscard]] SqlToken next() noexcept;
+
+    // position
+    //   다음 스캔을 시작할 원문 오프셋 (마지막 토큰 바로 뒤).
+    [[nodiscard]] std::size_t position() const noexcept { return pos_; }
+
+    // remaining
+    //   아직 스캔하지 않은 원문 부분.
+    [[nodiscard]] std::string_view remaining() const noexcept { return sql_.substr(pos_); }
+
+    // source
+    //   렉서가 스캔 중인 원문 전체.
+    [[nodiscard]] std::string_view source() const noexcept { return sql_; }
+
+private:
+    std::string_view sql_;
+    std::size_t pos_{0};
+
+    // skip_separators: 공백과 주석을 건너뛰고, 하나라도 건너뛰었으면 true
+    bool skip_separators() noexcept;
+
+    // skip_quoted: pos_ 가 여는 인용 문자 위치일 때 닫는 인용 문자 뒤로 이동
+    //   allow_backslash: 백슬래시 이스케이프 적용 여부 (백틱은 false)
+    void skip_quoted(char quote, bool allow_backslash) noexcept;
+};
+
+// ---------------------------------------------------------------------------
+// SqlTokenList / tokenize_sql
+//   원문 전체를 SqlLexer 로 한 번 토큰화한 결과 (kEnd 제외, 원문 순서).
+//   토큰은 원문을 가리키므로 원문이 더 오래 살아야 한다. mr 에서 할당한다
+//   (세션에서는 커맨드 단위 QueryArena).
+// ---------------------------------------------------------------------------
+using SqlTokenList = std::pmr::vector<SqlToken>;
+
+[[nodiscard]] SqlTokenList tokenize_sql(std::string_view sql, std::pmr::memory_resource* mr);
+
+// ---------------------------------------------------------------------------
+// SqlTokenCursor
+//   tokenize_sql 결과를 SqlLexer 와 같은 순서/값으로 재생한다.
+//   source       : 토큰화한 원문 (tokens 와 같은 원문이어야 한다)
+//   끝에 도달하면 SqlLexer 와 같이 offset == source.size() 인 kEnd 를 계속 반환한다.
+// ---------------------------------------------------------------------------
+class SqlTokenCursor {
+public:
+    SqlTokenCursor(std::span<const SqlToken> tokens, std::string_view source) noexcept
+        : tokens_{tokens}, source_{source} {}
+
+    [[nodiscard]] SqlToken next() noexcept {
+        if (index_ < tokens_.size()) {
+            return tokens_[index_++];
+        }
+        // 마지막 토큰 뒤에 공백/주석이 남아 있으면 SqlLexer 도 separated=true 인 kEnd 를 낸다
+        const std::size_t tail = tokens_.empty() ? 0 : tokens_.back().end_offset();
+        return SqlToken{.kind = SqlTokenKind::kEnd,
+                        .text = {},
+                        .offset = source_.size(),
+                        .separated_before = tokens_.empty() || tail != source_.size()};
+    }
+
+    [[nodiscard]] std::string_view source() const noexcept { return source_; }
+
+private:
+    std::span<const SqlToken> tokens_;
+    std::string_view source_;
+    std::size_t index_{0};
+};
+
+// ---------------------------------------------------------------------------
+// 헬퍼
+// ---------------------------------------------------------------------------
+
+// is_sql_word_char
+//   비인용 식별자/키워드를 구성하는 문자인지 판정한다.
+//   비ASCII 바이트(UTF-8 멀티바이트)는 MySQL 과 같이 식별자 문자로 취급한다.
+[[nodiscard]] constexpr bool is_sql_word_char(char c) noexcept {
+    const auto u = static_cast<unsigned char>(c);
+    return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') ||
+           u == '_' || u == '$' || u >= 0x80;
+}
+
+// is_sql_space
+//   공백 문자 (스페이스, 탭, 개행, CR, VT, FF) 판정.
+[[nodiscard]] constexpr bool is_sql_space(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// keyword_equals
+//   ASCII 대소문자 무관 비교. keyword 는 대문자 리터럴로 전달한다.
+//   to_upper 복사 없이 토큰과 키워드를 비교하기 위해 사용한다.
+[[nodiscard]] constexpr bool keyword_equals(std::string_view text,
+                                            std::string_view keyword) noexcept {
+    if (text.size() != keyword.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (c >= 'a' && c <= 'z') {
+            c = static_cast<char>(c - 'a' + 'A');
+        }
+        if (c != keyword[i]) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -2,18 +2,29 @@
 // sql_parser.cpp
 //
 // SQL 구문 분류 및 테이블명 추출 구현.
-// "첫 번째 키워드 기반 분류 + 정규식 패턴 매칭" 수준의 경량 파서.
+// "첫 번째 키워드 기반 분류 + 단일 패스 토큰 스캔" 수준의 경량 파서.
+//
+// [단일 패스 설계]
+// SqlLexer 가 원문을 한 번만 스캔하며 string_view 토큰을 내놓고, parse() 는
+// 그 토큰 스트림 위에서 다음을 동시에 수행한다.
+//   - 첫 번째 키워드로 SqlCommand 분류
+//   - 문자열/주석/백틱 밖의 세미콜론 감지 (멀티 스테이트먼트 fail-close)
+//   - FROM/INTO/UPDATE/JOIN/TABLE 뒤 테이블명 추출
+//   - WHERE 키워드 감지
+// 주석 제거/대문자 변환 사본과 정규식을 만들지 않으므로 수십 KB 의 ORM 쿼리도
+// 입력 길이에 선형인 비용으로 처리한다.
+// 결과의 raw_sql 과 테이블명은 원문을 가리키는 뷰이므로 원문 크기와 무관하게 원문 복사가 없다.
+// 할당은 tables 벡터와, 원문에 연속으로 없는 테이블명(`db`.`t` 등) 의 정규화 사본에만 발생한다.
 //
 // [파서 설계 한계 — 구현 후에도 유지]
-// 1. 주석 분할 우회: DROP/**/TABLE 는 블록 주석 제거 후 공백이 삽입되어
-//    "DROP  TABLE" 형태가 된다. DROP 키워드는 탐지되나, 인젝션 감지기에서
-//    UN/**/ION 같은 분할은 탐지하지 못한다.
-//    MySQL 버전 힌트 주석 /*!50000 DROP TABLE */ 은 내용이 제거되어 미탐 가능.
+// 1. 주석 분할 우회: DROP/**/TABLE 은 주석이 토큰 구분자로 처리되어
+//    DROP 키워드가 탐지되나, 인젝션 감지기에서 UN/**/ION 같은 분할은 탐지하지 못한다.
+//    MySQL 버전 힌트 주석 /*!50000 DROP TABLE */ 은 내용이 건너뛰어져 미탐 가능.
 // 2. 인코딩 우회: URL 인코딩, hex 리터럴(0x44524f50='DROP'),
 //    멀티바이트 문자 경계 조작은 탐지하지 못한다.
-// 3. 복잡한 서브쿼리: SELECT * FROM (SELECT ...) AS t 에서 내부 테이블명은
-//    추출하지 않는다.
-// 4. Multi-statement: 세미콜론으로 구분된 복수 구문은 첫 번째만 처리.
+// 3. 복잡한 서브쿼리: outer/inner FROM 을 구분하지 않는다. 서브쿼리 내부 테이블도
+//    추출되며 '(' 로 시작하는 항목은 테이블명으로 잡지 않는다.
+// 4. Multi-statement: 세미콜론으로 구분된 복수 구문은 ParseError 로 차단한다.
 // 5. PREPARE/EXECUTE 내부 문자열: 리터럴 내부 SQL은 파싱하지 않음.
 //    procedure_detector 와 조합하여 탐지해야 한다.
 //
@@ -28,117 +39,24 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
-#include <cctype>
-#include <ranges>
-#include <regex>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <string_view>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "parser/sql_lexer.hpp"
+
 // ---------------------------------------------------------------------------
 // 익명 네임스페이스: 내부 헬퍼 함수들
 // ---------------------------------------------------------------------------
 namespace {
 
-// SQL에서 주석을 제거하고 결과 문자열을 반환한다.
-//
-// 처리 순서:
-//   1. /* ... */ 블록 주석 제거 (중첩 미지원)
-//   2. -- 인라인 주석 제거 (줄 끝까지)
-//   3. # 인라인 주석 제거 (줄 끝까지)
-//
-// [우회 주의]
-// - /*!50000 DROP TABLE */ 형태의 MySQL 조건부 실행 주석은
-//   블록 주석으로 처리되어 내용이 제거된다 (false negative).
-// - 블록 주석 제거 자리에 공백을 삽입하여 DROP/**/TABLE 이
-//   DROPTABLE 로 붙지 않도록 처리한다.
-std::string remove_comments(std::string_view sql) {
-    std::string result;
-    result.reserve(sql.size());
-
-    std::size_t i = 0;
-    const std::size_t len = sql.size();
-
-    while (i < len) {
-        // 블록 주석 /* ... */
-        if (i + 1 < len && sql[i] == '/' && sql[i + 1] == '*') {
-            i += 2;
-            while (i + 1 < len) {
-                if (sql[i] == '*' && sql[i + 1] == '/') {
-                    i += 2;
-                    break;
-                }
-                ++i;
-            }
-            // 블록 주석 자리에 공백 하나 삽입 (DROP/**/ TABLE 처리용)
-            result.push_back(' ');
-            continue;
-        }
-
-        // 인라인 주석 -- (줄 끝까지)
-        if (i + 1 < len && sql[i] == '-' && sql[i + 1] == '-') {
-            while (i < len && sql[i] != '\n') {
-                ++i;
-            }
-            continue;
-        }
-
-        // 해시 주석 # (줄 끝까지)
-        if (sql[i] == '#') {
-            while (i < len && sql[i] != '\n') {
-                ++i;
-            }
-            continue;
-        }
-
-        result.push_back(sql[i]);
-        ++i;
-    }
-
-    return result;
-}
-
-// 문자열을 대문자로 변환한다 (ASCII only).
-std::string to_upper(std::string_view s) {
-    std::string result(s);
-    std::ranges::transform(
-        result, result.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
-    return result;
-}
-
-// 문자열의 앞뒤 공백(스페이스, 탭, 개행 포함)을 제거한다.
-std::string_view trim(std::string_view s) {
-    const auto not_space = [](unsigned char c) {
-        return std::isspace(c) == 0;
-    };
-    const auto* const begin = std::ranges::find_if(s, not_space);
-    if (begin == s.end()) {
-        return {};
-    }
-    const auto* const end =
-        std::find_if(s.rbegin(), s.rend(), not_space).base();  // NOLINT(modernize-use-ranges)
-    return s.substr(static_cast<std::size_t>(begin - s.begin()),
-                    static_cast<std::size_t>(end - begin));
-}
-
-// 정규화된 SQL(대문자, 주석 제거)에서 첫 번째 키워드를 추출한다.
-// 반환값: 첫 번째 공백-구분 토큰, 없으면 빈 문자열
-std::string extract_first_keyword(std::string_view normalized_sql) {
-    const auto trimmed = trim(normalized_sql);
-    if (trimmed.empty()) {
-        return {};
-    }
-    const auto space_pos = trimmed.find_first_of(" \t\r\n");
-    if (space_pos == std::string_view::npos) {
-        return std::string(trimmed);
-    }
-    return std::string(trimmed.substr(0, space_pos));
-}
-
 // 첫 번째 키워드 → SqlCommand 매핑
-SqlCommand keyword_to_command(const std::string& keyword) {
-    static const std::unordered_map<std::string, SqlCommand> keyword_map = {
+// 토큰이 짧고 후보가 11개뿐이므로 선형 비교가 해시 맵보다 싸다.
+SqlCommand keyword_to_command(std::string_view keyword) {
+    static constexpr std::array<std::pair<std::string_view, SqlCommand>, 11> kKeywordMap{{
         {"SELECT", SqlCommand::kSelect},
         {"INSERT", SqlCommand::kInsert},
         {"UPDATE", SqlCommand::kUpdate},
@@ -150,380 +68,419 @@ SqlCommand keyword_to_command(const std::string& keyword) {
         {"CALL", SqlCommand::kCall},
         {"PREPARE", SqlCommand::kPrepare},
         {"EXECUTE", SqlCommand::kExecute},
-    };
+    }};
 
-    const auto it = keyword_map.find(keyword);
-    if (it != keyword_map.end()) {
-        return it->second;
+    for (const auto& [text, cmd] : kKeywordMap) {
+        if (keyword_equals(keyword, text)) {
+            return cmd;
+        }
     }
     return SqlCommand::kUnknown;
 }
 
-// 테이블명으로 허용되는 문자인지 확인한다.
-// 허용: 알파벳, 숫자, 밑줄, 점(schema.table), 백틱
-bool is_table_name_char(char c) {
-    return (std::isalnum(static_cast<unsigned char>(c)) != 0) || c == '_' || c == '.' || c == '`';
+// 첫 번째 키워드 뒤가 구분자(공백/주석/입력 끝)인지 확인한다.
+// "SELECT(1)" / "SELECT'a'" 처럼 구분자 없이 이어지면 첫 토큰 전체를
+// 키워드로 보지 않는다 (기존 "첫 번째 공백-구분 토큰" 규칙과 동일, kUnknown → 차단).
+bool starts_with_separator(std::string_view rest) {
+    if (rest.empty() || is_sql_space(rest.front()) || rest.front() == '#') {
+        return true;
+    }
+    return rest.starts_with("/*") || rest.starts_with("--");
 }
 
-// normalized_sql에서 keyword 뒤에 오는 테이블명(들)을 추출하여 out_tables에 추가.
-// 쉼표 구분 복수 테이블 지원 (FROM t1, t2).
-//
-// [우회 주의]
-// - "FROM (SELECT ...)" 처럼 서브쿼리가 오면 '(' 를 테이블명으로 잘못 인식하지 않도록
-//   괄호로 시작하는 토큰은 건너뜀.
-// - "FROM t1 AS a, t2" 처럼 별칭이 오면 별칭도 함께 잡힐 수 있음.
-//   현재는 첫 토큰만 추출하여 별칭 오탐을 최소화.
-// - ORM 생성 쿼리에서 false positive 발생 가능 (알려진 한계).
-void extract_tables_for_keyword(const std::string& normalized_sql,
-                                std::string_view original_sql,
-                                const std::string& keyword,
-                                std::vector<std::string>& out_tables) {
-    // keyword 다음에 오는 테이블명(들)을 추출하는 정규식
-    // 쉼표 구분 복수 테이블: FROM t1, t2, t3
-    // 각 테이블명은 백틱 선택적 포함
-    const std::string pattern = keyword + R"(\s+(`?[\w.]+`?(?:\s*,\s*`?[\w.]+`?)*))";
-
-    try {
-        const std::regex re(pattern,
-                            std::regex_constants::icase | std::regex_constants::ECMAScript);
-
-        auto it = std::sregex_iterator(normalized_sql.begin(), normalized_sql.end(), re);
-        const auto end_it = std::sregex_iterator();
-
-        for (; it != end_it; ++it) {
-            const std::smatch& m = *it;
-            if (m.size() < 2) {
-                continue;
-            }
-
-            std::string table_list = m[1].str();
-
-            // 쉼표로 분리하여 각 테이블명 처리
-            std::size_t pos = 0;
-            while (pos <= table_list.size()) {
-                // 앞 공백 건너뜀
-                while (pos < table_list.size() &&
-                       std::isspace(static_cast<unsigned char>(table_list[pos])) != 0) {
-                    ++pos;
-                }
-                if (pos >= table_list.size()) {
-                    break;
-                }
-
-                // 쉼표 찾기
-                const auto comma = table_list.find(',', pos);
-                std::string token;
-                if (comma == std::string::npos) {
-                    token = table_list.substr(pos);
-                    pos = table_list.size() + 1;
-                } else {
-                    token = table_list.substr(pos, comma - pos);
-                    pos = comma + 1;
-                }
-
-                // 토큰 앞뒤 공백 제거
-                const auto trimmed_sv = trim(token);
-                if (trimmed_sv.empty()) {
-                    continue;
-                }
-                std::string trimmed_token(trimmed_sv);
+// command 별 테이블명 추출 트리거 키워드인지 확인한다.
+//   SELECT/DELETE : FROM, JOIN
+//   INSERT        : INTO
+//   UPDATE        : UPDATE, JOIN
+//   DDL           : TABLE ("DROP TABLE users" / "TRUNCATE TABLE users" 등)
+bool is_table_keyword(SqlCommand cmd, std::string_view word) {
+    switch (cmd) {
+        case SqlCommand::kSelect:
+        case SqlCommand::kDelete:
+            return keyword_equals(word, "FROM") || keyword_equals(word, "JOIN");
+        case SqlCommand::kInsert:
+            return keyword_equals(word, "INTO");
+        case SqlCommand::kUpdate:
+            return keyword_equals(word, "UPDATE") || keyword_equals(word, "JOIN");
+        case SqlCommand::kDrop:
+        case SqlCommand::kTruncate:
+        case SqlCommand::kAlter:
+        case SqlCommand::kCreate:
+            return keyword_equals(word, "TABLE");
+        case SqlCommand::kCall:
+        case SqlCommand::kPrepare:
+        case SqlCommand::kExecute:
+        case SqlCommand::kUnknown:
+        default:
+            // 테이블명 추출 불필요 또는 불가
+            return false;
+    }
+}
 
-                // 백틱 제거
-                if (!trimmed_token.empty() && trimmed_token.front() == '`') {
-                    trimmed_token.erase(0, 1);
-                }
-                if (!trimmed_token.empty() && trimmed_token.back() == '`') {
-                    trimmed_token.pop_back();
-                }
+// 테이블명 바로 뒤에 와도 별칭으로 보지 않는 예약어.
+// 별칭 처리는 "FROM t1 a, t2 b" 의 쉼표 목록을 끝까지 따라가기 위한 것이므로,
+// 여기 없는 단어가 별칭으로 오인되더라도 뒤에 쉼표가 없으면 추출 결과는 같다.
+bool is_clause_keyword(std::string_view word) {
+    static constexpr std::array<std::string_view, 30> kClauseKeywords{
+        "WHERE", "ON",    "USING",  "JOIN",   "INNER",  "LEFT",   "RIGHT", "CROSS",
+        "FULL",  "OUTER", "NATURAL", "STRAIGHT_JOIN", "SET", "VALUES", "VALUE", "SELECT",
+        "GROUP", "ORDER", "HAVING", "LIMIT",  "UNION",  "FOR",    "LOCK",  "WINDOW",
+        "INTO",  "FROM",  "PARTITION", "USE", "IGNORE", "FORCE",
+    };
+    return std::ranges::any_of(kClauseKeywords,
+                               [word](std::string_view kw) { return keyword_equals(word, kw); });
+}
 
-                // 서브쿼리 시작 '(' 건너뜀
-                if (trimmed_token.empty() || trimmed_token.front() == '(') {
-                    continue;
-                }
+// 식별자 토큰(비인용 단어 또는 백틱 식별자)의 원문 뷰. 백틱은 제외한다.
+// escaped: `` 이스케이프 포함 여부 (원문 뷰 그대로는 테이블명이 아님)
+struct IdentifierPart {
+    std::string_view text{};
+    bool escaped{false};
+};
 
-                // 원문 SQL에서 케이스 보존된 이름 추출
-                const std::string upper_token = to_upper(trimmed_token);
-                const std::string orig_str(original_sql);
-                const std::string orig_upper = to_upper(orig_str);
-
-                std::string final_name = trimmed_token;
-
-                // 원문에서 케이스 보존 추출 시도 (단어 경계 확인)
-                std::size_t search_from = 0;
-                while (search_from < orig_upper.size()) {
-                    const auto found = orig_upper.find(upper_token, search_from);
-                    if (found == std::string::npos) {
-                        break;
-                    }
-
-                    // 단어 경계 확인: 앞뒤가 식별자 문자가 아니어야 함
-                    const bool valid_start =
-                        (found == 0) || (!is_table_name_char(orig_str[found - 1]));
-                    const bool valid_end =
-                        (found + upper_token.size() >= orig_str.size()) ||
-                        (!is_table_name_char(orig_str[found + upper_token.size()]));
-
-                    if (valid_start && valid_end) {
-                        final_name = orig_str.substr(found, upper_token.size());
-                        break;
-                    }
-                    search_from = found + 1;
-                }
+IdentifierPart identifier_part(const SqlToken& tok) {
+    if (tok.kind != SqlTokenKind::kQuotedIdentifier) {
+        return IdentifierPart{.text = tok.text};
+    }
+    std::string_view body = tok.text.substr(1);  // 여는 백틱
+    if (!body.empty() && body.back() == '`') {
+        body.remove_suffix(1);  // 닫는 백틱 (닫히지 않은 경우 그대로 둠)
+    }
+    return IdentifierPart{.text = body, .escaped = body.find("``") != std::string_view::npos};
+}
 
-                // 중복 추가 방지 (대소문자 무관)
-                const auto upper_final = to_upper(final_name);
-                bool already_added = false;
-                for (const auto& t : out_tables) {
-                    if (to_upper(t) == upper_final) {
-                        already_added = true;
-                        break;
-                    }
-                }
-                if (!already_added) {
-                    out_tables.push_back(std::move(final_name));
-                }
-            }
+// 식별자 조각을 정규화하여 out 에 덧붙인다. `` 이스케이프는 ` 하나로 복원한다.
+void append_unescaped(const IdentifierPart& part, std::pmr::string& out) {
+    if (!part.escaped) {
+        out.append(part.text);
+        return;
+    }
+    for (std::size_t i = 0; i < part.text.size(); ++i) {
+        out.push_back(part.text[i]);
+        if (part.text[i] == '`' && i + 1 < part.text.size() && part.text[i + 1] == '`') {
+            ++i;
         }
-    } catch (const std::regex_error& e) {
-        spdlog::warn("sql_parser: regex error for keyword '{}': {}", keyword, e.what());
     }
 }
 
-// 정규화된 SQL에서 "WHERE" 단어 포함 여부 확인
-// 단어 경계 적용: ELSEWHERE 같은 단어에서 오탐 방지
-bool has_where_keyword(const std::string& normalized_sql) {
-    try {
-        const std::regex where_re("\\bWHERE\\b", std::regex_constants::ECMAScript);
-        return std::regex_search(normalized_sql, where_re);
-    } catch (const std::regex_error&) {
+// 중복 추가 방지 (대소문자 무관)
+bool iequals_ascii(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
         return false;
     }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        auto ca = a[i];
+        auto cb = b[i];
+        if (ca >= 'a' && ca <= 'z') {
+            ca = static_cast<char>(ca - 'a' + 'A');
+        }
+        if (cb >= 'a' && cb <= 'z') {
+            cb = static_cast<char>(cb - 'a' + 'A');
+        }
+        if (ca != cb) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void add_table(std::string_view name, std::pmr::vector<std::string_view>& out_tables) {
+    if (name.empty()) {
+        return;
+    }
+    const bool already_added = std::ranges::any_of(
+        out_tables, [name](std::string_view t) { return iequals_ascii(t, name); });
+    if (!already_added) {
+        out_tables.push_back(name);
+    }
+}
+
+// ParseError::context 는 로깅용 단편이므로 대용량 SQL 전체를 복사하지 않는다
+constexpr std::size_t kErrorContextBytes = 256;
+
+std::string error_context(std::string_view sql) {
+    return std::string(sql.substr(0, kErrorContextBytes));
+}
+
+bool is_identifier(const SqlToken& tok) {
+    return tok.kind == SqlTokenKind::kWord || tok.kind == SqlTokenKind::kQuotedIdentifier;
+}
+
+bool is_symbol(const SqlToken& tok, char c) {
+    return tok.kind == SqlTokenKind::kSymbol && tok.text.front() == c;
 }
 
 // ---------------------------------------------------------------------------
-// has_semicolon_outside_string_or_comment
-//   원문 SQL에서 문자열 리터럴(' 또는 " 감쌈)과 주석(/* */, --, #) 밖에
-//   세미콜론이 존재하면 true 를 반환한다.
-//
-//   이 함수는 주석 제거 전 원문을 직접 스캔하여 멀티 스테이트먼트를 감지한다.
-//   주석 제거 후에는 주석 내 세미콜론도 사라지므로 false negative 위험이 있어
-//   원문 스캔 방식을 채택한다.
+// TableListScanner
+//   테이블 키워드 뒤의 "name [[AS] alias] [, name [[AS] alias]]..." 목록을
+//   토큰 단위로 따라가는 상태 머신. 토큰을 하나씩 feed() 하며,
+//   목록에 속하지 않는 토큰이면 false 를 반환하여 호출자가 일반 토큰으로
+//   다시 처리하게 한다 (예: "FROM t1 JOIN t2" 의 JOIN, "FROM t WHERE" 의 WHERE).
 //
-// [Trailing 세미콜론 처리 — DON-39]
-//   MySQL 클라이언트는 "SELECT 1;" 처럼 단일 구문 끝에 세미콜론을 붙인다.
-//   세미콜론 뒤에 non-whitespace 문자가 없으면 trailing 세미콜론으로 판단하여
-//   허용한다(false 반환). 이렇게 해야 정상 쿼리가 차단되는 false positive를 방지.
-//
-//   허용 예시: "SELECT 1;"  / "INSERT INTO t VALUES(1);"  / "SELECT 1;  \n"
-//   차단 예시: "SELECT 1; DROP TABLE users"  / "SELECT 1; ;"
-//
-// [한계 / 알려진 우회 가능성]
-// - 중첩 주석 미지원 (MySQL은 중첩 블록 주석을 허용하지 않으므로 실제 영향 미미).
-// - 백슬래시 이스케이프 처리 불완전: '\'' 같은 이스케이프 시퀀스는
-//   상태 머신 방식으로 처리하여 오탐을 방지한다.
-// - 큰따옴표 문자열(ANSI mode)도 처리하나, MySQL 기본 모드에서는
-//   큰따옴표가 식별자 구분자로 사용될 수 있어 일부 false negative 가능.
-//
-// [오탐/미탐 트레이드오프]
-// - 보수적(차단 우선): 파싱 불확실 시 세미콜론이 있다고 판정한다.
-// - trailing 세미콜론 허용으로 false positive 감소, 그러나
-//   "SELECT 1; --comment" 처럼 세미콜론 뒤 주석만 있는 경우에도 허용된다
-//   (주석 내용은 무해하므로 실질적 보안 영향 없음).
+//   [처리 규칙]
+//   - name 은 식별자 조각을 '.' 으로 이은 형태 (mydb.orders, `mydb`.`orders`).
+//   - "(" 로 시작하면 서브쿼리로 보고 목록을 종료한다 (내부 FROM 은 별도로 추출됨).
+//   - DDL 의 "TABLE IF [NOT] EXISTS name" 은 IF/NOT/EXISTS 를 건너뛴다.
+//   - 조각이 원문에서 연속(users, mydb.orders, `orders`) 이면 원문 뷰를 그대로 쓰고,
+//     그렇지 않으면 (`mydb`.`orders`, "a . b", `` 이스케이프) 정규화 사본을
+//     ParsedQuery::owned_strings 에 만든다.
 // ---------------------------------------------------------------------------
-bool has_semicolon_outside_string_or_comment(std::string_view sql) {
-    // 상태 머신으로 문자열/주석 영역을 추적
-    enum class State : std::uint8_t {
-        kNormal,        // 일반 SQL 구문
-        kSingleQuote,   // 'string' 내부
-        kDoubleQuote,   // "string" 내부
-        kBlockComment,  // /* ... */ 내부
-        kLineComment,   // -- ... \n 내부
-        kHashComment,   // # ... \n 내부
-    };
+class TableListScanner {
+public:
+    explicit TableListScanner(ParsedQuery& out) : out_{out}, owned_{out.resource()} {}
 
-    State state = State::kNormal;
-    const std::size_t len = sql.size();
-
-    for (std::size_t i = 0; i < len; ++i) {
-        const char c = sql[i];
-        const char next = (i + 1 < len) ? sql[i + 1] : '\0';
-
-        switch (state) {
-            case State::kNormal:
-                if (c == '\'') {
-                    state = State::kSingleQuote;
-                } else if (c == '"') {
-                    state = State::kDoubleQuote;
-                } else if (c == '/' && next == '*') {
-                    state = State::kBlockComment;
-                    ++i;  // '*' 건너뜀
-                } else if (c == '-' && next == '-') {
-                    state = State::kLineComment;
-                    ++i;  // 두 번째 '-' 건너뜀
-                } else if (c == '#') {
-                    state = State::kHashComment;
-                } else if (c == ';') {
-                    // 세미콜론 발견 — trailing 세미콜론 여부를 확인한다.
-                    // 세미콜론 뒤에 whitespace(공백/탭/개행)만 남아 있으면
-                    // 단일 구문의 trailing 세미콜론으로 판단하여 허용한다.
-                    // 뒤에 non-whitespace 문자가 하나라도 있으면 멀티 스테이트먼트.
-                    const std::string_view tail = sql.substr(i + 1);
-                    const bool only_whitespace = std::ranges::all_of(
-                        tail, [](unsigned char ch) { return std::isspace(ch) != 0; });
-                    // trailing 세미콜론이면 단일 구문으로 허용(false), 아니면 멀티
-                    // 스테이트먼트(true)
-                    return !only_whitespace;
+    void start() {
+        flush();
+        state_ = State::kExpectName;
+    }
+
+    [[nodiscard]] bool active() const { return state_ != State::kIdle; }
+
+    // feed: 토큰이 테이블 목록의 일부로 소비되었으면 true
+    bool feed(const SqlToken& tok) {
+        switch (state_) {
+            case State::kIdle:
+                return false;
+
+            case State::kExpectName:
+                if (tok.kind == SqlTokenKind::kWord &&
+                    (keyword_equals(tok.text, "IF") || keyword_equals(tok.text, "NOT") ||
+                     keyword_equals(tok.text, "EXISTS"))) {
+                    return true;
                 }
-                break;
-
-            case State::kSingleQuote:
-                if (c == '\\') {
-                    // 이스케이프 문자: 다음 문자 건너뜀 (\' 등)
-                    ++i;
-                } else if (c == '\'') {
-                    if (next == '\'') {
-                        // '' 이스케이프: 두 번째 따옴표 건너뜀
-                        ++i;
-                    } else {
-                        state = State::kNormal;
-                    }
+                if (is_identifier(tok)) {
+                    append(identifier_part(tok));
+                    state_ = State::kInName;
+                    return true;
                 }
-                break;
-
-            case State::kDoubleQuote:
-                if (c == '\\') {
-                    ++i;
-                } else if (c == '"') {
-                    if (next == '"') {
-                        ++i;
-                    } else {
-                        state = State::kNormal;
-                    }
+                state_ = State::kIdle;
+                return false;
+
+            case State::kInName:
+                if (is_symbol(tok, '.')) {
+                    append(IdentifierPart{.text = tok.text});
+                    state_ = State::kAfterDot;
+                    return true;
                 }
-                break;
-
-            case State::kBlockComment:
-                if (c == '*' && next == '/') {
-                    state = State::kNormal;
-                    ++i;  // '/' 건너뜀
+                flush();
+                return after_name(tok);
+
+            case State::kAfterDot:
+                if (is_identifier(tok)) {
+                    append(identifier_part(tok));
+                    state_ = State::kInName;
+                    return true;
+                }
+                flush();
+                state_ = State::kIdle;
+                return false;
+
+            case State::kAlias:
+                if (is_identifier(tok) || tok.kind == SqlTokenKind::kString) {
+                    state_ = State::kAfterAlias;
+                    return true;
                 }
-                break;
+                state_ = State::kIdle;
+                return false;
 
-            case State::kLineComment:
-            case State::kHashComment:
-                if (c == '\n') {
-                    state = State::kNormal;
+            case State::kAfterAlias:
+                if (is_symbol(tok, ',')) {
+                    state_ = State::kExpectName;
+                    return true;
                 }
-                break;
+                state_ = State::kIdle;
+                return false;
         }
+        return false;
     }
 
-    return false;
-}
+    // finish: 입력 끝에서 진행 중인 이름을 확정한다.
+    void finish() {
+        flush();
+        state_ = State::kIdle;
+    }
 
-}  // namespace
+private:
+    enum class State : std::uint8_t {
+        kIdle,        // 목록 밖
+        kExpectName,  // 키워드 또는 ',' 직후
+        kInName,      // 이름 조각 직후
+        kAfterDot,    // "schema." 직후
+        kAlias,       // AS 직후
+        kAfterAlias,  // 별칭 직후
+    };
 
-// ---------------------------------------------------------------------------
-// SqlParser::parse 구현
-// ---------------------------------------------------------------------------
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-std::expected<ParsedQuery, ParseError> SqlParser::parse(std::string_view sql) const {
-    // 1. 빈 입력 검사
-    const auto trimmed = trim(sql);
-    if (trimmed.empty()) {
-        return std::unexpected(ParseError{.code = ParseErrorCode::kInvalidSql,
-                                          .message = "Empty SQL input",
-                                          .context = std::string(sql)});
+    ParsedQuery& out_;
+    std::string_view view_{};  // 지금까지의 이름이 원문에서 연속일 때 그 범위
+    std::pmr::string owned_;   // 연속이 아니게 된 뒤의 정규화 사본 (ParsedQuery 리소스)
+    bool is_owned_{false};
+    State state_{State::kIdle};
+
+    void append(const IdentifierPart& part) {
+        if (!is_owned_) {
+            if (!part.escaped && view_.empty()) {
+                view_ = part.text;
+                return;
+            }
+            if (!part.escaped && part.text.data() == view_.data() + view_.size()) {
+                view_ = std::string_view{view_.data(), view_.size() + part.text.size()};
+                return;
+            }
+            owned_.assign(view_);
+            is_owned_ = true;
+        }
+        append_unescaped(part, owned_);
     }
 
-    // 2. 멀티 스테이트먼트 감지 (주석 제거 전 원문에서 수행)
-    //
-    // [보안 원칙] 문자열/주석 외부에 세미콜론이 있고, 세미콜론 뒤에
-    // non-whitespace 문자가 있으면 fail-close(ParseError 반환).
-    // 멀티 스테이트먼트 SQL은 piggyback 공격의 주요 벡터이므로 파싱 단계에서 차단.
-    //
-    // [DON-39] trailing 세미콜론 허용: "SELECT 1;" 처럼 세미콜론 뒤에
-    // 공백/개행만 있는 경우는 단일 구문으로 판단하여 통과시킨다.
-    // MySQL 클라이언트 대부분이 trailing 세미콜론을 붙이므로 이를 허용하지 않으면
-    // 운영 환경에서 정상 쿼리가 차단되는 false positive 가 발생한다.
-    if (has_semicolon_outside_string_or_comment(sql)) {
-        spdlog::warn(
-            "sql_parser: multi-statement detected (semicolon outside string/comment), "
-            "fail-close applied. sql_prefix='{}'",
-            std::string(sql).substr(0, 80));
-        return std::unexpected(ParseError{
-            .code = ParseErrorCode::kInvalidSql,
-            .message = "Multi-statement SQL detected: semicolon outside string or comment",
-            .context = std::string(sql)});
+    void flush() {
+        if (is_owned_) {
+            if (!owned_.empty()) {
+                add_table(out_.own(owned_), out_.tables);
+            }
+            owned_.clear();
+            is_owned_ = false;
+        } else {
+            add_table(view_, out_.tables);
+        }
+        view_ = {};
     }
 
-    // 3. 주석 제거
-    const std::string no_comments = remove_comments(sql);
-
-    // 4. 대문자 정규화
-    const std::string normalized = to_upper(no_comments);
+    bool after_name(const SqlToken& tok) {
+        if (is_symbol(tok, ',')) {
+            state_ = State::kExpectName;
+            return true;
+        }
+        if (tok.kind == SqlTokenKind::kWord && keyword_equals(tok.text, "AS")) {
+            state_ = State::kAlias;
+            return true;
+        }
+        if (is_identifier(tok) && !is_clause_keyword(tok.text)) {
+            state_ = State::kAfterAlias;
+            return true;
+        }
+        state_ = State::kIdle;
+        return false;
+    }
+};
 
-    // 정규화 후 공백만 남은 경우
-    const auto normalized_trimmed = trim(normalized);
-    if (normalized_trimmed.empty()) {
+// ---------------------------------------------------------------------------
+// parse_tokens
+//   SqlParser::parse 본체. tokens 는 SqlLexer 또는 SqlTokenCursor (같은 next() 계약).
+//   토큰 뒤 원문은 sql.substr(tok.end_offset()) 로 구하므로 두 소스의 결과가 같다.
+// ---------------------------------------------------------------------------
+template <typename TokenSource>
+std::expected<ParsedQuery, ParseError> parse_tokens(std::string_view sql,
+                                                    TokenSource& tokens,
+                                                    std::pmr::memory_resource* mr) {
+    // 1. 빈 입력 검사
+    if (std::ranges::all_of(sql, is_sql_space)) {
         return std::unexpected(ParseError{.code = ParseErrorCode::kInvalidSql,
-                                          .message = "SQL is empty after comment removal",
-                                          .context = std::string(sql)});
+                                          .message = "Empty SQL input",
+                                          .context = error_context(sql)});
     }
 
-    // 5. 첫 번째 키워드로 SqlCommand 분류
-    const std::string first_kw = extract_first_keyword(normalized_trimmed);
-    const SqlCommand cmd = keyword_to_command(first_kw);
-
-    // 6. 테이블명 추출
-    // command에 따라 탐색할 키워드가 다름
-    std::vector<std::string> tables;
-
-    const std::string normalized_str(normalized_trimmed);
-
-    switch (cmd) {
-        case SqlCommand::kSelect:
-        case SqlCommand::kDelete:
-            extract_tables_for_keyword(normalized_str, sql, "FROM", tables);
-            extract_tables_for_keyword(normalized_str, sql, "JOIN", tables);
+    // 2. 단일 패스 토큰 스캔
+    //    주석은 렉서가 건너뛰므로 주석 제거 사본을 만들지 않는다.
+    //    키워드 비교는 keyword_equals 로 대소문자 무관 수행한다 (대문자 사본 없음).
+    SqlCommand cmd = SqlCommand::kUnknown;
+    ParsedQuery result{mr};
+    TableListScanner table_list{result};
+    bool saw_token = false;
+    bool has_where = false;
+
+    for (auto tok = tokens.next(); tok.kind != SqlTokenKind::kEnd; tok = tokens.next()) {
+        // 2-1. 멀티 스테이트먼트 감지
+        //
+        // [보안 원칙] 문자열/주석 외부에 세미콜론이 있고, 세미콜론 뒤에
+        // non-whitespace 문자가 있으면 fail-close(ParseError 반환).
+        // 멀티 스테이트먼트 SQL은 piggyback 공격의 주요 벡터이므로 파싱 단계에서 차단.
+        //
+        // [DON-39] trailing 세미콜론 허용: "SELECT 1;" 처럼 세미콜론 뒤에
+        // 공백/개행만 있는 경우는 단일 구문으로 판단하여 통과시킨다.
+        // 세미콜론 뒤 주석도 non-whitespace 로 보아 차단한다 ("SELECT 1; --c").
+        if (is_symbol(tok, ';')) {
+            if (!std::ranges::all_of(sql.substr(tok.end_offset()), is_sql_space)) {
+                spdlog::warn(
+                    "sql_parser: multi-statement detected (semicolon outside string/comment), "
+                    "fail-close applied. sql_prefix='{}'",
+                    sql.substr(0, 80));
+                return std::unexpected(ParseError{
+                    .code = ParseErrorCode::kInvalidSql,
+                    .message = "Multi-statement SQL detected: semicolon outside string or comment",
+                    .context = error_context(sql)});
+            }
+            saw_token = true;
             break;
+        }
 
-        case SqlCommand::kInsert:
-            extract_tables_for_keyword(normalized_str, sql, "INTO", tables);
-            break;
+        // 2-2. 첫 번째 키워드로 SqlCommand 분류
+        if (!saw_token) {
+            saw_token = true;
+            if (tok.kind == SqlTokenKind::kWord &&
+                starts_with_separator(sql.substr(tok.end_offset()))) {
+                cmd = keyword_to_command(tok.text);
+            }
+            // UPDATE 는 첫 키워드 자체가 테이블 추출 트리거 ("UPDATE users SET ...")
+            if (cmd == SqlCommand::kUpdate) {
+                table_list.start();
+            }
+            continue;
+        }
 
-        case SqlCommand::kUpdate:
-            extract_tables_for_keyword(normalized_str, sql, "UPDATE", tables);
-            extract_tables_for_keyword(normalized_str, sql, "JOIN", tables);
-            break;
+        // 2-3. 테이블명 목록 진행 중이면 우선 소비
+        if (table_list.feed(tok)) {
+            continue;
+        }
 
-        case SqlCommand::kDrop:
-        case SqlCommand::kTruncate:
-        case SqlCommand::kAlter:
-        case SqlCommand::kCreate:
-            // "DROP TABLE users" / "TRUNCATE TABLE users" / "ALTER TABLE" / "CREATE TABLE"
-            extract_tables_for_keyword(normalized_str, sql, "TABLE", tables);
-            break;
+        if (tok.kind != SqlTokenKind::kWord) {
+            continue;
+        }
 
-        case SqlCommand::kCall:
-        case SqlCommand::kPrepare:
-        case SqlCommand::kExecute:
-        case SqlCommand::kUnknown:
-        default:
-            // 테이블명 추출 불필요 또는 불가
-            break;
+        // 2-4. has_where_clause 판정 (문자열/주석/백틱 내부의 WHERE 는 무시)
+        if (keyword_equals(tok.text, "WHERE")) {
+            has_where = true;
+            continue;
+        }
+
+        // 2-5. 테이블명 추출 트리거 키워드
+        if (is_table_keyword(cmd, tok.text)) {
+            table_list.start();
+        }
     }
+    table_list.finish();
 
-    // 7. has_where_clause 판정
-    const bool has_where = has_where_keyword(normalized_str);
+    // 주석/공백만 있는 경우
+    if (!saw_token) {
+        return std::unexpected(ParseError{.code = ParseErrorCode::kInvalidSql,
+                                          .message = "SQL is empty after comment removal",
+                                          .context = error_context(sql)});
+    }
 
-    // 8. ParsedQuery 구성
-    // raw_sql은 원문 그대로 보존
-    ParsedQuery result;
+    // 3. ParsedQuery 구성
+    // raw_sql 은 원문 그대로 (복사 없이 입력 버퍼를 빌린다)
     result.command = cmd;
-    result.tables = std::move(tables);
-    result.raw_sql = std::string(sql);
+    result.raw_sql = sql;
     result.has_where_clause = has_where;
 
     return result;
 }
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// SqlParser::parse 구현
+// ---------------------------------------------------------------------------
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+std::expected<ParsedQuery, ParseError> SqlParser::parse(std::string_view sql,
+                                                       std::pmr::memory_resource* mr) const {
+    SqlLexer lexer{sql};
+    return parse_tokens(sql, lexer, mr);
+}
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+std::expected<ParsedQuery, ParseError> SqlParser::parse(std::string_view sql,
+                                                       const SqlTokenList& tokens,
+                                                       std::pmr::memory_resource* mr) const {
+    SqlTokenCursor cursor{tokens, sql};
+    return parse_tokens(sql, cursor, mr);
+}
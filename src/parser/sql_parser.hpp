@@ -4,16 +4,17 @@
 // sql_parser.hpp
 //
 // SQL 구문 분류 및 테이블명 추출을 담당하는 "첫 번째 키워드 기반 분류 +
-// 정규식 패턴 매칭" 수준의 경량 파서.
+// 단일 패스 토큰 스캔" 수준의 경량 파서. 토큰화는 SqlLexer(sql_lexer.hpp) 가 담당한다.
 //
 // [설계 한계 / 알려진 우회 가능성]
 // 1. 주석 내 SQL 우회: DROP/**/TABLE, /*!DROP*/ 같은 인라인 주석 분할은
 //    전처리 없이 놓칠 수 있다.
 // 2. 인코딩 우회: URL 인코딩, 멀티바이트 문자 경계 조작은 탐지하지 못한다.
-// 3. 복잡한 서브쿼리: SELECT * FROM (SELECT ...) AS t 에서 내부 테이블명은
-//    추출하지 않는다.
-// 4. 대소문자/공백 변형: 전처리(대문자 변환)는 수행하나, 탭·줄바꿈 혼합 시
-//    일부 패턴을 놓칠 수 있다.
+// 3. 복잡한 서브쿼리: SELECT * FROM (SELECT ...) AS t 에서 outer/inner FROM 을
+//    구분하지 않는다 (내부 테이블명도 추출됨, 차단 우선 방향).
+// 4. 대소문자/공백 변형: 키워드는 대소문자 무관 비교하고 공백·탭·개행·주석을
+//    모두 토큰 구분자로 처리한다. 다만 첫 키워드 뒤에 구분자 없이 '(' 등이
+//    붙으면 ("SELECT(1)") kUnknown 으로 분류된다 (차단 우선).
 // 5. PREPARE/EXECUTE로 숨겨진 동적 SQL: 문자열 리터럴 내부까지 파싱하지
 //    않으므로 procedure_detector 와 조합하여 탐지해야 한다.
 //
@@ -24,11 +25,14 @@
 // ---------------------------------------------------------------------------
 
 #include <expected>
+#include <forward_list>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "common/types.hpp"  // ParseError, ParseErrorCode
+#include "parser/sql_lexer.hpp"  // SqlTokenList
 
 // ---------------------------------------------------------------------------
 // SqlCommand
@@ -55,6 +59,21 @@ enum class SqlCommand : std::uint8_t {
 //   파싱 성공 시 반환되는 SQL 분석 결과.
 //   raw_sql 은 원문 그대로 보존하며, 로깅/감사 목적으로만 사용한다.
 //
+// [빌린 뷰 — 수명 주의]
+//   raw_sql 과 tables 는 parse() 에 넘긴 원문 버퍼를 가리키는 string_view 이다
+//   (세션에서는 COM_QUERY 패킷이 들어 있는 client_buf_). 대용량 bulk INSERT 도 복사하지
+//   않는 대신, ParsedQuery 는 원문 버퍼보다 오래 살아서는 안 된다.
+//   원문에 연속으로 존재하지 않는 테이블명 (`db`.`t`, `` 이스케이프 등) 만 정규화해
+//   owned_strings 에 보관하고 tables 는 그 사본을 가리킨다.
+//   owned_strings 는 노드 기반이라 이동해도 원소 주소가 바뀌지 않지만, 복사하면 뷰가
+//   원본 객체를 가리키게 되므로 복사는 금지한다 (이동만 허용).
+//   수명을 넘겨 보관해야 하는 곳 (판정 캐시, 비동기 로그) 은 그 경계에서 사본을 만든다.
+//
+// [메모리 리소스]
+//   tables / owned_strings 는 parse() 에 넘긴 memory_resource 에서 할당한다
+//   (세션에서는 커맨드마다 reset 되는 QueryArena). 이동 생성은 리소스를 그대로 가져가지만,
+//   이동 대입은 리소스가 다르면 원소를 복사해 tables 의 뷰가 끊어지므로 금지한다.
+//
 // [보안 주의 — has_multi_statement]
 //   문자열 리터럴/주석 외부에 세미콜론이 발견되면 parse()가 ParseError
 //   (kInvalidSql)를 반환하므로, 이 플래그가 true 인 ParsedQuery 는
@@ -62,11 +81,31 @@ enum class SqlCommand : std::uint8_t {
 //   호출자는 parse() 실패 시 반드시 fail-close(차단)를 적용해야 한다.
 // ---------------------------------------------------------------------------
 struct ParsedQuery {
-    SqlCommand               command{SqlCommand::kUnknown};
-    std::vector<std::string> tables{};           // FROM/INTO/UPDATE/JOIN 뒤 테이블명
-    std::string              raw_sql{};          // 원문 SQL (로깅용, 변형 없음)
-    bool                     has_where_clause{}; // DELETE 무조건 삭제 탐지용
-    bool                     has_multi_statement{false}; // 멀티 스테이트먼트 감지 (차단 플래그)
+    SqlCommand                          command{SqlCommand::kUnknown};
+    std::pmr::vector<std::string_view>  tables{};            // FROM/INTO/UPDATE/JOIN 뒤 테이블명
+    std::string_view                    raw_sql{};           // 원문 SQL (로깅용, 변형 없음)
+    bool                                has_where_clause{};  // DELETE 무조건 삭제 탐지용
+    bool                                has_multi_statement{false}; // 멀티 스테이트먼트 감지
+    std::pmr::forward_list<std::pmr::string> owned_strings{}; // 원문 밖 문자열 (정규화 테이블명)
+
+    ParsedQuery() = default;
+    explicit ParsedQuery(std::pmr::memory_resource* mr) : tables{mr}, owned_strings{mr} {}
+    ~ParsedQuery() = default;
+
+    ParsedQuery(const ParsedQuery&)            = delete;
+    ParsedQuery& operator=(const ParsedQuery&) = delete;
+    ParsedQuery(ParsedQuery&&)                 = default;
+    ParsedQuery& operator=(ParsedQuery&&)      = delete;
+
+    // own: s 의 사본을 owned_strings 에 보관하고 그 뷰를 반환한다 (정규화 테이블명, 테스트 입력 등)
+    std::string_view own(std::string_view s) {
+        return owned_strings.emplace_front(s);
+    }
+
+    // resource: tables / owned_strings 가 할당하는 memory_resource
+    [[nodiscard]] std::pmr::memory_resource* resource() const noexcept {
+        return tables.get_allocator().resource();
+    }
 };
 
 // ---------------------------------------------------------------------------
@@ -91,12 +130,23 @@ public:
 
     // parse
     //   sql: 원문 SQL (null-terminated 불필요, view 로 전달)
+    //   mr : ParsedQuery 의 tables / owned_strings 할당 리소스 (mr 이 더 오래 살아야 함)
     //   반환: ParsedQuery 또는 ParseError
+    //         ParsedQuery 의 raw_sql / tables 는 sql 버퍼를 빌린다 (sql 이 더 오래 살아야 함).
     //
     // [오탐 주의]
     // ORM(예: Hibernate, SQLAlchemy)이 생성하는 복잡한 SELECT 에서
     // 테이블명 추출이 부정확할 수 있다. tables 벡터가 비어있더라도
     // 파싱 성공 자체는 유효하다.
     [[nodiscard]] std::expected<ParsedQuery, ParseError>
-    parse(std::string_view sql) const;
+    parse(std::string_view sql,
+          std::pmr::memory_resource* mr = std::pmr::get_default_resource()) const;
+
+    // parse (토큰 공유 오버로드)
+    //   tokens: tokenize_sql(sql) 결과. 원문을 다시 렉싱하지 않고 같은 결과를 만든다
+    //           (세션에서 fingerprint 와 토큰화 1회를 공유).
+    [[nodiscard]] std::expected<ParsedQuery, ParseError>
+    parse(std::string_view sql,
+          const SqlTokenList& tokens,
+          std::pmr::memory_resource* mr = std::pmr::get_default_resource()) const;
 };
@@ -0,0 +1,123 @@
+// ---------------------------------------------------------------------------
+// sql_scan.cpp
+//
+// find_first_of2 커널과 런타임 선택.
+// AVX2 본체는 target("avx2") 속성으로만 컴파일하므로 -mavx2 없이 빌드해도 되고,
+// CPU 가 AVX2 를 지원할 때만 호출된다 (선택은 첫 호출 시 1회, 이후 함수 포인터).
+// ---------------------------------------------------------------------------
+
+#include "parser/sql_scan.hpp"
+
+#include <bit>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DBGATE_SQL_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace sql_scan {
+namespace {
+
+using FindFn = std::size_t (*)(const char*, std::size_t, std::size_t, char, char) noexcept;
+
+std::size_t find_scalar(
+    const char* p, std::size_t size, std::size_t pos, char a, char b) noexcept {
+    for (; pos < size; ++pos) {
+        if (p[pos] == a || p[pos] == b) {
+            return pos;
+        }
+    }
+    return size;
+}
+
+#if defined(DBGATE_SQL_SCAN_X86)
+
+std::size_t find_sse2(const char* p, std::size_t size, std::size_t pos, char a, char b) noexcept {
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + pos));
+        const __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(x, va), _mm_cmpeq_epi8(x, vb));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hit));
+        if (mask != 0) {
+            return pos + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    return find_scalar(p, size, pos, a, b);
+}
+
+__attribute__((target("avx2"))) std::size_t find_avx2(
+    const char* p, std::size_t size, std::size_t pos, char a, char b) noexcept {
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    for (; pos + 32 <= size; pos += 32) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + pos));
+        const __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(x, va), _mm256_cmpeq_epi8(x, vb));
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hit));
+        if (mask != 0) {
+            return pos + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    return find_sse2(p, size, pos, a, b);
+}
+
+#endif
+
+struct Selected {
+    Kernel kernel;
+    FindFn find;
+};
+
+Selected select_kernel() noexcept {
+#if defined(DBGATE_SQL_SCAN_X86)
+    if (__builtin_cpu_supports("avx2")) {
+        return {Kernel::kAvx2, &find_avx2};
+    }
+    return {Kernel::kSse2, &find_sse2};
+#else
+    return {Kernel::kScalar, &find_scalar};
+#endif
+}
+
+const Selected& selected() noexcept {
+    static const Selected kSelected = select_kernel();
+    return kSelected;
+}
+
+}  // namespace
+
+Kernel active_kernel() noexcept {
+    return selected().kernel;
+}
+
+std::string_view kernel_name(Kernel kernel) noexcept {
+    switch (kernel) {
+        case Kernel::kAvx2:
+            return "avx2";
+        case Kernel::kSse2:
+            return "sse2";
+        case Kernel::kScalar:
+            break;
+    }
+    return "scalar";
+}
+
+std::size_t find_first_of2(std::string_view text, std::size_t pos, char a, char b) noexcept {
+    if (pos >= text.size()) {
+        return text.size();
+    }
+    return selected().find(text.data(), text.size(), pos, a, b);
+}
+
+std::size_t find_first_of2_scalar(std::string_view text,
+                                  std::size_t pos,
+                                  char a,
+                                  char b) noexcept {
+    if (pos >= text.size()) {
+        return text.size();
+    }
+    return find_scalar(text.data(), text.size(), pos, a, b);
+}
+
+}  // namespace sql_scan
@@ -0,0 +1,51 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// sql_scan.hpp
+//
+// SqlLexer 내부 영역(문자열 리터럴, 백틱 식별자, 블록/라인 주석)의 구분 문자 탐색 커널.
+//
+// [설계 의도]
+// 대용량 bulk INSERT 처럼 수 KB ~ 수 MB 리터럴을 가진 쿼리는 렉서 비용의 대부분이
+// "닫는 따옴표/백슬래시/'*'/개행이 나올 때까지 한 바이트씩 전진" 하는 루프다.
+// find_first_of2 는 두 구분 문자 중 하나의 첫 위치를 16/32 바이트 단위로 찾는다.
+//   - x86-64: SSE2 (기본 ISA) 또는 AVX2 (CPUID 로 런타임 선택, 빌드 플래그 불필요)
+//   - 그 외 : 스칼라
+// 어느 커널이든 결과는 find_first_of2_scalar 와 같아야 한다 (단위 테스트 + fuzz_sql_parser
+// 에서 차분 검증). 렉서의 문자열/주석 경계 규칙은 바뀌지 않는다.
+//
+// [범위]
+// 키워드/식별자 토큰은 짧아 스칼라가 더 싸므로 벡터화하지 않는다.
+// ---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <string_view>
+
+namespace sql_scan {
+
+// 런타임에 선택된 커널 (기동 로그/테스트용)
+enum class Kernel : unsigned char {
+    kScalar = 0,
+    kSse2 = 1,
+    kAvx2 = 2,
+};
+
+[[nodiscard]] Kernel active_kernel() noexcept;
+[[nodiscard]] std::string_view kernel_name(Kernel kernel) noexcept;
+
+// find_first_of2
+//   text[pos..) 에서 a 또는 b 와 같은 첫 바이트 위치. 없으면 text.size().
+//   한 문자만 찾으려면 a == b 로 호출한다. pos > text.size() 이면 text.size().
+[[nodiscard]] std::size_t find_first_of2(std::string_view text,
+                                         std::size_t pos,
+                                         char a,
+                                         char b) noexcept;
+
+// find_first_of2_scalar
+//   같은 계약의 바이트 단위 기준 구현 (차분 검증용).
+[[nodiscard]] std::size_t find_first_of2_scalar(std::string_view text,
+                                                std::size_t pos,
+                                                char a,
+                                                char b) noexcept;
+
+}  // namespace sql_scan
@@ -0,0 +1,337 @@
+// ---------------------------------------------------------------------------
+// access_index.cpp
+//
+// access_control 사전 컴파일 인덱스 구현.
+// ---------------------------------------------------------------------------
+
+#include "policy/access_index.hpp"
+
+#include <arpa/inet.h>   // inet_pton, AF_INET
+#include <netinet/in.h>  // in_addr
+
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <expected>
+
+namespace {
+
+// SqlCommand 값 순서의 커맨드 이름 (kUnknown 포함)
+constexpr std::array<std::string_view, 12> kCommandNames = {"SELECT",
+                                                            "INSERT",
+                                                            "UPDATE",
+                                                            "DELETE",
+                                                            "DROP",
+                                                            "TRUNCATE",
+                                                            "ALTER",
+                                                            "CREATE",
+                                                            "CALL",
+                                                            "PREPARE",
+                                                            "EXECUTE",
+                                                            "UNKNOWN"};
+static_assert(kCommandNames.size() == static_cast<std::size_t>(SqlCommand::kUnknown) + 1);
+
+bool iequals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    return std::equal(a.begin(), a.end(), b.begin(), [](unsigned char ac, unsigned char bc) {
+        return std::tolower(ac) == std::tolower(bc);
+    });
+}
+
+// operations_mask: 커맨드 이름 목록 → 비트마스크 (커맨드 이름이 아닌 항목은 무시)
+SqlCommandMask operations_mask(const std::vector<std::string>& ops) {
+    SqlCommandMask mask = 0;
+    for (const auto& op : ops) {
+        for (std::size_t i = 0; i < kCommandNames.size(); ++i) {
+            if (iequals(op, kCommandNames[i])) {
+                mask |= SqlCommandMask{1} << i;
+                break;
+            }
+        }
+    }
+    return mask;
+}
+
+struct Ipv4Cidr {
+    std::uint32_t network{0};
+    unsigned prefix_len{0};
+};
+
+// parse_cidr: "10.0.0.0/8" → 네트워크 주소 + prefix. 형식 오류 시 std::nullopt.
+// prefix 는 std::stoi 로 파싱하며 전체가 소비되고 0~32 범위여야 한다.
+std::optional<Ipv4Cidr> parse_cidr(const std::string& cidr) {
+    const auto slash_pos = cidr.find('/');
+    if (slash_pos == std::string::npos) {
+        return std::nullopt;
+    }
+    const std::string prefix_str = cidr.substr(slash_pos + 1);
+    int prefix_len = 0;
+    try {
+        std::size_t idx{0};
+        prefix_len = std::stoi(prefix_str, &idx);
+        if (idx != prefix_str.size() || prefix_len < 0 || prefix_len > 32) {
+            return std::nullopt;
+        }
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+    const auto network = parse_ipv4(cidr.substr(0, slash_pos));
+    if (!network.has_value()) {
+        return std::nullopt;
+    }
+    return Ipv4Cidr{.network = *network, .prefix_len = static_cast<unsigned>(prefix_len)};
+}
+
+struct MinuteRange {
+    int start{0};
+    int end{0};
+};
+
+// parse_minute_range: "HH:MM-HH:MM" → 자정 이후 분. 실패 시 사유 문자열.
+// 시/분은 std::stoi 로 파싱한다 (기존 per-query 파서와 같은 허용 범위).
+std::expected<MinuteRange, std::string> parse_minute_range(const std::string& range_str) {
+    // 최소 길이: "0:0-0:0" = 7
+    if (range_str.size() < 7) {
+        return std::unexpected("too short");
+    }
+    const auto dash_pos = range_str.find('-', 1);
+    if (dash_pos == std::string::npos) {
+        return std::unexpected("no '-'");
+    }
+
+    const auto parse_hhmm = [](const std::string& hhmm) -> std::optional<int> {
+        const auto colon_pos = hhmm.find(':');
+        if (colon_pos == std::string::npos) {
+            return std::nullopt;
+        }
+        try {
+            const int hour = std::stoi(hhmm.substr(0, colon_pos));
+            const int min = std::stoi(hhmm.substr(colon_pos + 1));
+            if (hour < 0 || hour > 23 || min < 0 || min > 59) {
+                return std::nullopt;
+            }
+            return (hour * 60) + min;
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    };
+
+    const auto start = parse_hhmm(range_str.substr(0, dash_pos));
+    if (!start.has_value()) {
+        return std::unexpected("invalid start time");
+    }
+    const auto end = parse_hhmm(range_str.substr(dash_pos + 1));
+    if (!end.has_value()) {
+        return std::unexpected("invalid end time");
+    }
+    return MinuteRange{.start = *start, .end = *end};
+}
+
+// zone_clock_for: timezone 이름별 ZoneClock 을 하나만 만든다. 조회 실패 시 nullptr.
+const ZoneClock* zone_clock_for(
+    CompiledAccessIndex& index,
+    std::unordered_map<std::string, const ZoneClock*>& by_name,
+    const std::string& tz_name,
+    std::size_t rule_index) {
+    if (const auto it = by_name.find(tz_name); it != by_name.end()) {
+        return it->second;
+    }
+    const ZoneClock* clock = nullptr;
+    try {
+        const auto* zone = std::chrono::locate_zone(tz_name);
+        index.zone_clocks.push_back(std::make_unique<ZoneClock>(zone));
+        clock = index.zone_clocks.back().get();
+    } catch (const std::exception& e) {
+        // 알 수 없는 timezone / tzdata 없음: 이 timezone 의 룰은 항상 차단 (fail-close)
+        index.time_issues.push_back(
+            TimeRestrictionIssue{.rule_index = rule_index,
+                                 .kind = TimeRestrictionIssue::Kind::kUnknownTimezone,
+                                 .value = tz_name,
+                                 .detail = e.what()});
+    }
+    by_name.emplace(tz_name, clock);
+    return clock;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// ZoneClock::minute_of_day
+// ---------------------------------------------------------------------------
+std::optional<int> ZoneClock::minute_of_day(
+    std::chrono::system_clock::time_point now) const noexcept {
+    using std::chrono::seconds;
+    const auto now_s = std::chrono::floor<seconds>(now);
+    const auto epoch_s = now_s.time_since_epoch().count();
+    const auto packed = cache_.load(std::memory_order_relaxed);
+    const auto until = static_cast<std::int64_t>(packed >> (kMinuteBits + kSpanBits));
+    const auto span = static_cast<std::int64_t>((packed >> kMinuteBits) & kSpanMask);
+    if (epoch_s < until && epoch_s >= until - span) {
+        return static_cast<int>(packed & kMinuteMask);
+    }
+
+    try {
+        const auto info = zone_->get_info(now_s);
+        // 로컬 자정 이후 초 (epoch 이전 로컬 시각도 0 이상이 되도록 보정)
+        seconds local_s = (now_s.time_since_epoch() + info.offset) % std::chrono::days{1};
+        if (local_s < seconds::zero()) {
+            local_s += std::chrono::days{1};
+        }
+        const int minute = static_cast<int>(local_s.count() / 60);
+
+        // 다음 로컬 분 경계 또는 오프셋 전환 시각 중 빠른 쪽까지 유효
+        const auto valid_until = std::min<std::chrono::sys_seconds>(
+            now_s + seconds{60 - (local_s.count() % 60)}, info.end);
+        const auto valid_epoch = valid_until.time_since_epoch().count();
+        if (valid_epoch > 0) {
+            const auto valid_span = static_cast<std::uint64_t>(valid_epoch - epoch_s);
+            cache_.store((static_cast<std::uint64_t>(valid_epoch) << (kMinuteBits + kSpanBits)) |
+                             (valid_span << kMinuteBits) | static_cast<std::uint64_t>(minute),
+                         std::memory_order_relaxed);
+        }
+        refreshes_.fetch_add(1, std::memory_order_relaxed);
+        return minute;
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+std::optional<std::uint32_t> parse_ipv4(const std::string& ip) noexcept {
+    struct in_addr addr{};
+    if (inet_pton(AF_INET, ip.c_str(), &addr) != 1) {
+        return std::nullopt;
+    }
+    return ntohl(addr.s_addr);
+}
+
+bool CompiledAccessRule::table_allowed(std::string_view table) const {
+    if (any_table) {
+        return true;
+    }
+    return tables.contains(table);
+}
+
+// ---------------------------------------------------------------------------
+// CidrTrie
+// ---------------------------------------------------------------------------
+void CidrTrie::insert(std::uint32_t network, unsigned prefix_len, std::uint32_t rule_index) {
+    std::uint32_t node = 0;
+    for (unsigned depth = 0; depth < prefix_len; ++depth) {
+        const auto bit = (network >> (31U - depth)) & 1U;
+        if (nodes_[node].child[bit] == kNoNode) {
+            nodes_[node].child[bit] = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        node = nodes_[node].child[bit];
+    }
+    nodes_[node].best = std::min(nodes_[node].best, rule_index);
+}
+
+std::uint32_t CidrTrie::lookup(std::uint32_t ip) const noexcept {
+    std::uint32_t node = 0;
+    std::uint32_t best = nodes_[0].best;
+    for (unsigned depth = 0; depth < 32; ++depth) {
+        node = nodes_[node].child[(ip >> (31U - depth)) & 1U];
+        if (node == kNoNode) {
+            break;
+        }
+        best = std::min(best, nodes_[node].best);
+    }
+    return best;
+}
+
+std::uint32_t UserRuleSet::lookup(std::optional<std::uint32_t> ip) const noexcept {
+    if (!ip.has_value()) {
+        return any_ip;
+    }
+    return std::min(any_ip, cidrs.lookup(*ip));
+}
+
+// ---------------------------------------------------------------------------
+// CompiledAccessIndex::find
+// ---------------------------------------------------------------------------
+std::optional<std::size_t> CompiledAccessIndex::find(std::string_view user,
+                                                     const std::string& client_ip) const {
+    const auto ip = parse_ipv4(client_ip);
+    std::uint32_t best = wildcard.lookup(ip);
+    if (const auto it = users.find(user); it != users.end()) {
+        best = std::min(best, it->second.lookup(ip));
+    }
+    if (best == CidrTrie::kNoRule) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(best);
+}
+
+// ---------------------------------------------------------------------------
+// compile_access_index
+// ---------------------------------------------------------------------------
+std::shared_ptr<const CompiledAccessIndex> compile_access_index(
+    const std::vector<AccessRule>& rules) {
+    auto index = std::make_shared<CompiledAccessIndex>();
+    index->rule_count = rules.size();
+    index->rules.reserve(rules.size());
+    std::unordered_map<std::string, const ZoneClock*> clocks_by_name;
+
+    for (std::size_t i = 0; i < rules.size(); ++i) {
+        const auto& rule = rules[i];
+        const auto rule_index = static_cast<std::uint32_t>(i);
+
+        CompiledAccessRule compiled{};
+        compiled.allow_rule_id = "access-rule:" + rule.user;
+        compiled.any_table =
+            std::ranges::find(rule.allowed_tables, "*") != rule.allowed_tables.end();
+        for (const auto& table : rule.allowed_tables) {
+            compiled.tables.insert(table);
+        }
+        compiled.restrict_operations =
+            !rule.allowed_operations.empty() &&
+            std::ranges::find(rule.allowed_operations, "*") == rule.allowed_operations.end();
+        compiled.allowed_operations = operations_mask(rule.allowed_operations);
+        compiled.blocked_operations = operations_mask(rule.blocked_operations);
+        if (rule.time_restriction.has_value()) {
+            const auto& tr = *rule.time_restriction;
+            CompiledTimeWindow window{};
+            if (const auto range = parse_minute_range(tr.allow_range); range.has_value()) {
+                window.valid = true;
+                window.start_minute = range->start;
+                window.end_minute = range->end;
+            } else {
+                index->time_issues.push_back(
+                    TimeRestrictionIssue{.rule_index = i,
+                                         .kind = TimeRestrictionIssue::Kind::kInvalidRange,
+                                         .value = tr.allow_range,
+                                         .detail = range.error()});
+            }
+            if (tr.timezone.empty()) {
+                index->time_issues.push_back(
+                    TimeRestrictionIssue{.rule_index = i,
+                                         .kind = TimeRestrictionIssue::Kind::kEmptyTimezone,
+                                         .value = tr.timezone,
+                                         .detail = "falling back to Etc/UTC"});
+            }
+            const std::string tz_name = tr.timezone.empty() ? "Etc/UTC" : tr.timezone;
+            window.clock = zone_clock_for(*index, clocks_by_name, tz_name, i);
+            compiled.time_window = window;
+        }
+        index->rules.push_back(std::move(compiled));
+
+        auto& set = rule.user == "*" ? index->wildcard : index->users[rule.user];
+        if (rule.source_ip_cidr.empty()) {
+            set.any_ip = std::min(set.any_ip, rule_index);
+            continue;
+        }
+        const auto cidr = parse_cidr(rule.source_ip_cidr);
+        if (!cidr.has_value()) {
+            // 잘못된 CIDR: 어떤 IP 와도 매칭되지 않음 (fail-close)
+            index->invalid_cidrs.push_back(
+                InvalidCidr{.rule_index = i, .cidr = rule.source_ip_cidr});
+            continue;
+        }
+        set.cidrs.insert(cidr->network, cidr->prefix_len, rule_index);
+    }
+
+    return index;
+}
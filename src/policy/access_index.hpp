@@ -0,0 +1,302 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// access_index.hpp
+//
+// access_control 의 사전 컴파일 인덱스.
+//
+// [설계 의도]
+// - evaluate() 의 Step 5 (user/IP 룰 탐색) 는 룰 수에 비례하는 선형 탐색이었고,
+//   룰마다 CIDR 문자열을 다시 파싱했다. 수천 개 룰의 멀티테넌트 정책에서는
+//   쿼리당 O(rules) 문자열 작업이 된다.
+// - PolicyEngine 생성/reload() 시점에 1회 컴파일하여 PolicyConfig(access_index) 에
+//   보관한다 (compiled_patterns 와 같은 수명 / 불변 공유 방식).
+//
+// [구조]
+// - user 해시맵: 정확 일치 user → UserRuleSet, user="*" 는 wildcard UserRuleSet 하나.
+// - UserRuleSet: source_ip_cidr 가 빈 룰(any_ip) 의 최소 인덱스 + CIDR 이진 radix trie.
+//   trie 노드는 그 prefix 를 가진 룰 중 최소 인덱스를 갖는다.
+//   조회는 IP 비트를 따라 최대 32 노드를 내려가며 최소 인덱스를 고른다.
+// - find() = min(user 버킷 결과, wildcard 버킷 결과) → 기존 "첫 번째 매칭 룰" 순서와 동일.
+// - CompiledAccessRule: 룰별 소문자 테이블 해시셋 + SqlCommand 비트마스크 (Step 6/8/9),
+//   분 단위로 파싱한 time_restriction 창 (Step 7).
+// - ZoneClock: timezone 별 "현재 로컬 분" 캐시. 같은 timezone 을 쓰는 룰은 하나를 공유한다.
+//   로컬 분이 바뀌거나 UTC 오프셋 전환(DST) 이 일어나는 시각까지 결과를 재사용하므로
+//   쿼리당 IANA 조회/변환 대신 atomic load 1회 + 정수 비교가 된다.
+//
+// [기존 동작과의 동일성]
+// - 잘못된 CIDR 룰은 어떤 IP 와도 매칭되지 않는다 (fail-close). invalid_cidrs 에 기록되어
+//   호출자가 컴파일 시점에 1회 경고한다 (기존: 쿼리마다 경고).
+// - IPv4 로 파싱되지 않는 client IP 는 any_ip 룰에만 매칭된다 ("0.0.0.0/0" 포함 CIDR 룰 불일치).
+// - 테이블/오퍼레이션 비교는 ASCII 대소문자 무관. SqlCommand 이름이 아닌 오퍼레이션 문자열은
+//   어떤 커맨드와도 일치하지 않으므로 마스크에서 제외된다.
+// - 잘못된 allow_range / 알 수 없는 timezone 은 time_issues 에 기록되어 컴파일 시점에 1회
+//   경고한다. 판정은 기존과 같이 차단 (fail-close). 빈 timezone 은 UTC 로 fallback.
+//
+// [스레드 안전성]
+// - 컴파일 결과는 불변(const) 이므로 여러 워커 스레드에서 동시 조회해도 안전하다.
+// - ZoneClock 캐시만 가변이며 단일 atomic 워드(유효 기한 + 분) 로 갱신한다 (락 없음).
+//   동시에 만료를 본 스레드가 둘 다 재계산해도 같은 값을 저장하므로 무해하다.
+// ---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "parser/sql_parser.hpp"
+#include "policy/rule.hpp"
+
+// ---------------------------------------------------------------------------
+// SqlCommandMask
+//   SqlCommand 값별 1비트 (kSelect = bit 0 ... kUnknown = bit 11).
+// ---------------------------------------------------------------------------
+using SqlCommandMask = std::uint32_t;
+
+[[nodiscard]] constexpr SqlCommandMask command_bit(SqlCommand cmd) noexcept {
+    return SqlCommandMask{1} << static_cast<unsigned>(cmd);
+}
+
+// ---------------------------------------------------------------------------
+// parse_ipv4
+//   점 표기 IPv4 → 호스트 바이트 순서 정수. 실패(IPv6, 잘못된 형식) 시 std::nullopt.
+// ---------------------------------------------------------------------------
+[[nodiscard]] std::optional<std::uint32_t> parse_ipv4(const std::string& ip) noexcept;
+
+// string_view 로 조회 가능한 문자열 해시 (heterogeneous lookup)
+struct StringViewHash {
+    using is_transparent = void;
+    [[nodiscard]] std::size_t operator()(std::string_view s) const noexcept {
+        return std::hash<std::string_view>{}(s);
+    }
+};
+
+// ASCII 대소문자 무관 해시/비교 (소문자 사본 없이 조회 — 데이터패스 할당 없음)
+struct AsciiCaseInsensitiveHash {
+    using is_transparent = void;
+    [[nodiscard]] std::size_t operator()(std::string_view s) const noexcept {
+        // FNV-1a 64bit (ASCII 소문자 기준)
+        std::uint64_t h = 14695981039346656037ULL;
+        for (const char c : s) {
+            h ^= static_cast<std::uint8_t>(ascii_lower(c));
+            h *= 1099511628211ULL;
+        }
+        return static_cast<std::size_t>(h);
+    }
+
+    [[nodiscard]] static constexpr char ascii_lower(char c) noexcept {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+};
+
+struct AsciiCaseInsensitiveEqual {
+    using is_transparent = void;
+    [[nodiscard]] bool operator()(std::string_view a, std::string_view b) const noexcept {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                   return AsciiCaseInsensitiveHash::ascii_lower(x) ==
+                          AsciiCaseInsensitiveHash::ascii_lower(y);
+               });
+    }
+};
+
+// ---------------------------------------------------------------------------
+// ZoneClock
+//   timezone 하나의 "현재 로컬 시각 (자정 이후 분, 0~1439)" 캐시.
+//   minute_of_day(now) 는 캐시 구간 안이면 atomic load 1회로 끝난다.
+//   만료 시각 = min(다음 로컬 분 경계, 현재 오프셋 구간의 끝(get_info().end)) 이므로
+//   DST 전환 직후의 쿼리는 항상 새 오프셋으로 계산된다.
+//   티커 스레드 없이 첫 만료 조회가 갱신한다 (쿼리가 없는 동안은 비용 없음).
+// ---------------------------------------------------------------------------
+class ZoneClock {
+public:
+    explicit ZoneClock(const std::chrono::time_zone* zone) noexcept : zone_(zone) {}
+    ~ZoneClock() = default;
+
+    ZoneClock(const ZoneClock&) = delete;
+    ZoneClock& operator=(const ZoneClock&) = delete;
+    ZoneClock(ZoneClock&&) = delete;
+    ZoneClock& operator=(ZoneClock&&) = delete;
+
+    // minute_of_day: now 의 로컬 분. tz 조회 예외 시 std::nullopt (호출자는 차단)
+    [[nodiscard]] std::optional<int> minute_of_day(
+        std::chrono::system_clock::time_point now) const noexcept;
+
+    // refreshes: 캐시를 재계산한 횟수 (테스트/진단용)
+    [[nodiscard]] std::uint64_t refreshes() const noexcept {
+        return refreshes_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr unsigned kMinuteBits = 11;  // 0~1439
+    static constexpr unsigned kSpanBits = 7;     // 1~60
+    static constexpr std::uint64_t kMinuteMask = (std::uint64_t{1} << kMinuteBits) - 1;
+    static constexpr std::uint64_t kSpanMask = (std::uint64_t{1} << kSpanBits) - 1;
+
+    const std::chrono::time_zone* zone_;
+    // [63..18] 유효 기한 (epoch 초, 이 시각부터 무효) | [17..11] 유효 구간 길이 (초)
+    // | [10..0] 로컬 분. [기한 - 길이, 기한) 밖의 now (시계 역행 포함) 는 재계산. 0 = 미계산
+    mutable std::atomic<std::uint64_t> cache_{0};
+    mutable std::atomic<std::uint64_t> refreshes_{0};
+};
+
+// ---------------------------------------------------------------------------
+// CompiledTimeWindow
+//   time_restriction 의 사전 계산 결과.
+//   valid       : allow_range 파싱 성공 여부 (false 면 설정 오류로 차단)
+//   start/end   : 자정 이후 분. start > end 이면 자정을 넘는 범위 (예: 22:00-06:00)
+//   clock       : timezone 의 ZoneClock (CompiledAccessIndex 소유). 알 수 없는 timezone 이면
+//                 nullptr → 항상 허용 시간 외로 판정 (fail-close)
+// ---------------------------------------------------------------------------
+struct CompiledTimeWindow {
+    bool valid{false};
+    int start_minute{0};
+    int end_minute{0};
+    const ZoneClock* clock{nullptr};
+
+    // contains: 로컬 분이 [start, end) 범위인지 (자정 초과 범위 포함)
+    [[nodiscard]] bool contains(int minute) const noexcept {
+        if (start_minute <= end_minute) {
+            return minute >= start_minute && minute < end_minute;
+        }
+        return minute >= start_minute || minute < end_minute;
+    }
+
+    // allows: now 가 허용 시간 안인지. clock 이 없거나 tz 조회 실패 시 false
+    [[nodiscard]] bool allows(std::chrono::system_clock::time_point now) const noexcept {
+        if (clock == nullptr) {
+            return false;
+        }
+        const auto minute = clock->minute_of_day(now);
+        return minute.has_value() && contains(*minute);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// CompiledAccessRule
+//   access_control[i] 의 Step 6/8/9 판정용 사전 계산 결과.
+//   any_table          : allowed_tables 에 "*" 포함
+//   tables             : allowed_tables (ASCII 대소문자 무관 조회)
+//   restrict_operations: allowed_operations 가 비어있지 않고 "*" 도 없음
+//   time_window        : time_restriction 이 있을 때만 값을 가진다
+//   allow_rule_id      : 허용 판정의 matched_rule ("access-rule:<user>", 쿼리마다 포맷하지 않음)
+// ---------------------------------------------------------------------------
+struct CompiledAccessRule {
+    std::string allow_rule_id{};
+    bool any_table{false};
+    std::unordered_set<std::string, AsciiCaseInsensitiveHash, AsciiCaseInsensitiveEqual> tables{};
+    bool restrict_operations{false};
+    SqlCommandMask allowed_operations{0};
+    SqlCommandMask blocked_operations{0};
+    std::optional<CompiledTimeWindow> time_window{};
+
+    // table_allowed: 대소문자 무관 allowed_tables 포함 여부 (any_table 이면 항상 true)
+    [[nodiscard]] bool table_allowed(std::string_view table) const;
+
+    [[nodiscard]] bool operation_blocked(SqlCommand cmd) const noexcept {
+        return (blocked_operations & command_bit(cmd)) != 0;
+    }
+
+    [[nodiscard]] bool operation_allowed(SqlCommand cmd) const noexcept {
+        return !restrict_operations || (allowed_operations & command_bit(cmd)) != 0;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// CidrTrie
+//   IPv4 CIDR 이진 radix trie. 노드마다 그 prefix 를 가진 룰의 최소 인덱스를 저장한다.
+//   lookup(ip) 은 ip 를 포함하는 모든 prefix 중 최소 룰 인덱스를 반환한다 (없으면 kNoRule).
+// ---------------------------------------------------------------------------
+class CidrTrie {
+public:
+    static constexpr std::uint32_t kNoRule = UINT32_MAX;
+
+    void insert(std::uint32_t network, unsigned prefix_len, std::uint32_t rule_index);
+    [[nodiscard]] std::uint32_t lookup(std::uint32_t ip) const noexcept;
+
+private:
+    static constexpr std::uint32_t kNoNode = 0;  // 루트(0) 는 자식이 될 수 없다
+
+    struct Node {
+        std::array<std::uint32_t, 2> child{kNoNode, kNoNode};
+        std::uint32_t best{kNoRule};
+    };
+
+    std::vector<Node> nodes_{Node{}};
+};
+
+// ---------------------------------------------------------------------------
+// UserRuleSet
+//   같은 user 키를 가진 룰 집합.
+//   any_ip: source_ip_cidr 가 빈 룰의 최소 인덱스 (IPv4 파싱 여부와 무관하게 매칭)
+// ---------------------------------------------------------------------------
+struct UserRuleSet {
+    std::uint32_t any_ip{CidrTrie::kNoRule};
+    CidrTrie cidrs{};
+
+    [[nodiscard]] std::uint32_t lookup(std::optional<std::uint32_t> ip) const noexcept;
+};
+
+// ---------------------------------------------------------------------------
+// InvalidCidr
+//   파싱에 실패한 source_ip_cidr (해당 룰은 어떤 IP 와도 매칭되지 않음).
+// ---------------------------------------------------------------------------
+struct InvalidCidr {
+    std::size_t rule_index{0};
+    std::string cidr{};
+};
+
+// ---------------------------------------------------------------------------
+// TimeRestrictionIssue
+//   컴파일 시점에 발견한 time_restriction 문제 (호출자가 1회 경고).
+//   kInvalidRange    : allow_range 형식 오류 → 설정 오류로 차단
+//   kUnknownTimezone : locate_zone 실패 → 허용 시간 외로 차단
+//   kEmptyTimezone   : 빈 timezone → UTC 로 fallback
+// ---------------------------------------------------------------------------
+struct TimeRestrictionIssue {
+    enum class Kind : std::uint8_t { kInvalidRange, kUnknownTimezone, kEmptyTimezone };
+
+    std::size_t rule_index{0};
+    Kind kind{Kind::kInvalidRange};
+    std::string value{};   // 문제가 된 allow_range 또는 timezone
+    std::string detail{};  // 파싱/조회 실패 사유
+};
+
+// ---------------------------------------------------------------------------
+// CompiledAccessIndex
+//   rule_count : 컴파일 당시 access_control 크기 (게시 후 룰 추가/삭제 감지용)
+//   rules      : access_control 과 같은 순서의 CompiledAccessRule
+//   zone_clocks: rules[].time_window.clock 이 가리키는 timezone 별 ZoneClock (소유)
+// ---------------------------------------------------------------------------
+struct CompiledAccessIndex {
+    std::size_t rule_count{0};
+    std::unordered_map<std::string, UserRuleSet, StringViewHash, std::equal_to<>> users{};
+    UserRuleSet wildcard{};
+    std::vector<CompiledAccessRule> rules{};
+    std::vector<InvalidCidr> invalid_cidrs{};
+    std::vector<std::unique_ptr<ZoneClock>> zone_clocks{};
+    std::vector<TimeRestrictionIssue> time_issues{};
+
+    // find: (user, client_ip) 에 매칭되는 첫 번째 access_control 인덱스. 없으면 std::nullopt.
+    [[nodiscard]] std::optional<std::size_t> find(std::string_view user,
+                                                  const std::string& client_ip) const;
+};
+
+// ---------------------------------------------------------------------------
+// compile_access_index
+//   access_control 을 컴파일한다. 잘못된 CIDR 은 invalid_cidrs, time_restriction 문제는
+//   time_issues 로 수집한다
+//   (메모리 부족 등은 호출자에게 전파).
+// ---------------------------------------------------------------------------
+[[nodiscard]] std::shared_ptr<const CompiledAccessIndex> compile_access_index(
+    const std::vector<AccessRule>& rules);
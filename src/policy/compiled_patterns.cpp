@@ -0,0 +1,88 @@
+// ---------------------------------------------------------------------------
+// compiled_patterns.cpp
+//
+// block_patterns 사전 컴파일 구현.
+// ---------------------------------------------------------------------------
+
+#include "policy/compiled_patterns.hpp"
+
+#include <string_view>
+#include <unordered_map>
+
+std::shared_ptr<const CompiledBlockPatterns> compile_block_patterns(
+    const std::vector<std::string>& patterns, const CompiledBlockPatterns* previous) {
+    auto compiled = std::make_shared<CompiledBlockPatterns>();
+    compiled->sources = patterns;
+    compiled->patterns.reserve(patterns.size());
+
+    // 이전 결과의 원본 → 컴파일 결과 (previous 는 이 함수 동안 살아 있다)
+    std::unordered_map<std::string_view, const CompiledBlockPattern*> reusable{};
+    std::unordered_map<std::string_view, const InvalidBlockPattern*> known_invalid{};
+    if (previous != nullptr) {
+        reusable.reserve(previous->patterns.size());
+        for (const auto& entry : previous->patterns) {
+            reusable.emplace(entry.source, &entry);
+        }
+        for (const auto& entry : previous->invalid) {
+            known_invalid.emplace(entry.source, &entry);
+        }
+    }
+
+    for (std::size_t i = 0; i < patterns.size(); ++i) {
+        const auto& p = patterns[i];
+        if (const auto it = reusable.find(p); it != reusable.end()) {
+            compiled->patterns.push_back(
+                CompiledBlockPattern{.source = p, .regex = it->second->regex, .index = i});
+            ++compiled->reused;
+            continue;
+        }
+        if (const auto it = known_invalid.find(p); it != known_invalid.end()) {
+            compiled->invalid.push_back(*it->second);
+            ++compiled->reused;
+            continue;
+        }
+        try {
+            compiled->patterns.push_back(CompiledBlockPattern{
+                .source = p,
+                .regex = std::regex(p,
+                                    std::regex_constants::icase |
+                                        std::regex_constants::ECMAScript |
+                                        std::regex_constants::optimize),
+                .index = i,
+            });
+        } catch (const std::regex_error& e) {
+            // 잘못된 패턴은 제외한다 (false negative 증가 — 호출자가 경고)
+            compiled->invalid.push_back(InvalidBlockPattern{.source = p, .error = e.what()});
+        }
+    }
+
+    for (auto& entry : compiled->patterns) {
+        for (const auto& literal : extract_required_literals(entry.source)) {
+            entry.anchors.push_back(compiled->prefilter.add(literal));
+        }
+    }
+    compiled->prefilter.build();
+
+    return compiled;
+}
+
+bool is_compiled_for(const std::shared_ptr<const CompiledBlockPatterns>& compiled,
+                     const std::vector<std::string>& patterns) noexcept {
+    return compiled != nullptr && compiled->sources == patterns;
+}
+
+BlockPatternsStamp stamp_compiled_for(const std::shared_ptr<const CompiledBlockPatterns>& compiled,
+                                      const std::vector<std::string>& patterns) noexcept {
+    return BlockPatternsStamp{
+        .compiled = compiled.get(), .data = patterns.data(), .size = patterns.size()};
+}
+
+bool is_compiled_for(const std::shared_ptr<const CompiledBlockPatterns>& compiled,
+                     const std::vector<std::string>& patterns,
+                     const BlockPatternsStamp& stamp) noexcept {
+    if (compiled != nullptr && stamp.compiled == compiled.get() &&
+        stamp.data == patterns.data() && stamp.size == patterns.size()) {
+        return true;
+    }
+    return is_compiled_for(compiled, patterns);
+}
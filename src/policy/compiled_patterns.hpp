@@ -0,0 +1,131 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// compiled_patterns.hpp
+//
+// sql_rules.block_patterns 의 사전 컴파일 결과.
+//
+// [설계 의도]
+// - std::regex 컴파일은 쿼리당 수행하기에 비용이 크다.
+//   PolicyLoader::load() 또는 PolicyEngine 생성/reload() 시점에 1회만 컴파일하고
+//   PolicyConfig(SqlRule::compiled_patterns) 에 함께 보관한다.
+// - evaluate()/explain() 은 config_.load() 로 얻은 PolicyConfig 에서
+//   컴파일된 matcher 를 그대로 사용한다 (Hot Reload 와 수명이 일치).
+//   일치 여부는 게시 시 기록한 BlockPatternsStamp 로 O(1) 확인한다 (원본 목록 비교 없음).
+// - 컴파일 결과는 불변(const) 이므로 여러 워커 스레드에서 동시 조회해도 안전하다.
+//
+// [잘못된 패턴]
+// - 컴파일 실패 패턴은 patterns 에서 제외되고 invalid 에 기록된다.
+//   호출자(로더/엔진)가 로드 시점에 1회 경고를 출력한다 (false negative 경보).
+//
+// [증분 컴파일]
+// - reload 시 현재 게시된 결과를 previous 로 넘기면 원본 문자열이 같은 패턴은
+//   컴파일된 regex 를 복사해 재사용하고 새로 추가/수정된 패턴만 컴파일한다.
+//   std::regex 복사는 컴파일된 오토마톤을 공유하므로 재컴파일 비용이 없다.
+//
+// [사전 필터 — 원문 스캔 1회]
+// - 패턴마다 regex_search 로 원문을 훑으면 정상 쿼리도 P 번 스캔된다.
+//   InjectionDetector 와 같이 각 패턴의 필수 리터럴을 LiteralPrefilter 하나에 등록하고,
+//   평가 시 사전 필터 스캔 1회로 필수 리터럴이 모두 등장한 패턴에만 정규식을 실행한다.
+//   필수 리터럴은 보수적으로만 추출되므로 판정 결과는 사전 필터 유무와 같다.
+// - 사전 필터는 컴파일마다 새로 만든다 (리터럴 추출과 오토마톤 구성은 패턴 길이에 선형).
+// ---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "parser/literal_prefilter.hpp"
+#include "policy/rule.hpp"
+
+// ---------------------------------------------------------------------------
+// CompiledBlockPattern
+//   source: 원본 패턴 문자열 (matched_rule/reason 표기용)
+//   regex : icase | ECMAScript 로 컴파일된 정규식
+//   index : block_patterns 내 원본 위치 (RuleProfile 인덱스)
+//   anchors: CompiledBlockPatterns::prefilter 의 리터럴 id. 모두 등장해야 정규식을 실행한다
+//            (비어 있으면 필수 리터럴을 추출하지 못한 패턴 → 항상 실행).
+// ---------------------------------------------------------------------------
+struct CompiledBlockPattern {
+    std::string source{};
+    std::regex regex{};
+    std::size_t index{0};
+    std::vector<std::uint32_t> anchors{};
+};
+
+// ---------------------------------------------------------------------------
+// InvalidBlockPattern
+//   컴파일에 실패한 패턴과 std::regex_error 메시지.
+// ---------------------------------------------------------------------------
+struct InvalidBlockPattern {
+    std::string source{};
+    std::string error{};
+};
+
+// ---------------------------------------------------------------------------
+// CompiledBlockPatterns
+//   patterns     : 컴파일 성공 패턴 (원본 순서 유지)
+//   invalid      : 컴파일 실패 패턴 목록
+//   sources      : 컴파일 당시 block_patterns 원본 사본
+//                  (PolicyConfig 가 이후 수정되어 결과가 낡았는지 감지하는 용도)
+//   reused       : previous 에서 재사용한 패턴 수 (나머지는 새로 컴파일, 진단용)
+//   prefilter    : patterns 의 필수 리터럴 오토마톤 (build 완료, 읽기 전용)
+// ---------------------------------------------------------------------------
+struct CompiledBlockPatterns {
+    std::vector<CompiledBlockPattern> patterns{};
+    std::vector<InvalidBlockPattern> invalid{};
+    std::vector<std::string> sources{};
+    std::size_t reused{0};
+    LiteralPrefilter prefilter{};
+
+    // candidate: found(prefilter.scan 결과) 기준으로 entry 의 정규식을 실행해야 하는지
+    [[nodiscard]] static bool candidate(const CompiledBlockPattern& entry,
+                                        const std::vector<bool>& found) noexcept {
+        for (const auto id : entry.anchors) {
+            if (!found[id]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// compile_block_patterns
+//   block_patterns 를 컴파일한다. 예외를 던지지 않는다
+//   (개별 regex_error 는 invalid 로 수집, 메모리 부족 등은 호출자에게 전파).
+//   previous: 이전 컴파일 결과 (nullptr 허용). 같은 원본 패턴은 결과를 재사용한다.
+// ---------------------------------------------------------------------------
+[[nodiscard]] std::shared_ptr<const CompiledBlockPatterns> compile_block_patterns(
+    const std::vector<std::string>& patterns, const CompiledBlockPatterns* previous = nullptr);
+
+// ---------------------------------------------------------------------------
+// is_compiled_for
+//   compiled 가 patterns 에 대해 유효한 컴파일 결과인지 확인한다.
+//   nullptr 이거나 원본 패턴 목록이 다르면 false (재컴파일 필요).
+// ---------------------------------------------------------------------------
+[[nodiscard]] bool is_compiled_for(const std::shared_ptr<const CompiledBlockPatterns>& compiled,
+                                   const std::vector<std::string>& patterns) noexcept;
+
+// ---------------------------------------------------------------------------
+// stamp_compiled_for
+//   is_compiled_for(compiled, patterns) 가 true 인 쌍의 BlockPatternsStamp 를 만든다.
+//   config 게시 직전(전체 비교 직후)에만 호출한다.
+// ---------------------------------------------------------------------------
+[[nodiscard]] BlockPatternsStamp stamp_compiled_for(
+    const std::shared_ptr<const CompiledBlockPatterns>& compiled,
+    const std::vector<std::string>& patterns) noexcept;
+
+// ---------------------------------------------------------------------------
+// is_compiled_for (stamp)
+//   stamp 가 현재 (compiled, patterns 저장소) 와 같으면 O(1) 로 true.
+//   다르면 게시 이후 외부에서 수정된 경우이므로 원본 목록 전체를 비교한다.
+//   같은 저장소를 제자리에서 같은 크기로 고치는 변경은 감지하지 않는다 —
+//   게시된 config 의 수정은 동시 evaluate() 와 경쟁하므로 reload() 로만 해야 한다.
+// ---------------------------------------------------------------------------
+[[nodiscard]] bool is_compiled_for(const std::shared_ptr<const CompiledBlockPatterns>& compiled,
+                                   const std::vector<std::string>& patterns,
+                                   const BlockPatternsStamp& stamp) noexcept;
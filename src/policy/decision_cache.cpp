@@ -0,0 +1,84 @@
+// ---------------------------------------------------------------------------
+// decision_cache.cpp
+//
+// 샤드별 mutex + LRU 로 구현한 판정 캐시.
+// ---------------------------------------------------------------------------
+
+#include "policy/decision_cache.hpp"
+
+#include <functional>
+
+std::size_t DecisionCacheKeyHash::operator()(const DecisionCacheKeyView& key) const noexcept {
+    // boost::hash_combine 과 같은 방식으로 필드 해시를 섞는다
+    std::size_t h = std::hash<std::string_view>{}(key.fingerprint);
+    const auto mix = [&h](std::size_t v) {
+        h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6U) + (h >> 2U);
+    };
+    mix(std::hash<std::string_view>{}(key.db_user));
+    mix(std::hash<std::string_view>{}(key.client_ip));
+    mix(std::hash<std::uint64_t>{}(key.generation));
+    return h;
+}
+
+DecisionCache::DecisionCache(std::size_t capacity)
+    : capacity_{capacity},
+      shard_capacity_{capacity == 0 ? 0 : (capacity + kShardCount - 1) / kShardCount} {}
+
+DecisionCache::Shard& DecisionCache::shard_for(const DecisionCacheKeyView& key) noexcept {
+    const std::size_t h = DecisionCacheKeyHash{}(key);
+    // 하위 비트는 unordered_map 버킷 선택에 쓰이므로 상위 비트로 샤드를 고른다
+    return shards_[(h >> 56U) % kShardCount];
+}
+
+std::shared_ptr<const CachedDecision> DecisionCache::find(const DecisionCacheKeyView& key) {
+    if (capacity_ == 0) {
+        return nullptr;
+    }
+
+    auto& shard = shard_for(key);
+    const std::lock_guard lock{shard.mutex};
+    const auto it = shard.map.find(key);
+    if (it == shard.map.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_pos);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return it->second.decision;
+}
+
+void DecisionCache::insert(DecisionCacheKey key, std::shared_ptr<const CachedDecision> decision) {
+    if (capacity_ == 0 || !decision || key.fingerprint.size() > kMaxFingerprintBytes) {
+        return;
+    }
+
+    auto& shard = shard_for(key.view());
+    const std::lock_guard lock{shard.mutex};
+
+    const auto existing = shard.map.find(key);
+    if (existing != shard.map.end()) {
+        existing->second.decision = std::move(decision);
+        shard.lru.splice(shard.lru.begin(), shard.lru, existing->second.lru_pos);
+        return;
+    }
+
+    if (shard.map.size() >= shard_capacity_) {
+        const DecisionCacheKey* victim = shard.lru.back();
+        shard.lru.pop_back();
+        shard.map.erase(shard.map.find(*victim));
+    }
+
+    const auto it = shard.map.emplace(std::move(key), Shard::Slot{std::move(decision), {}}).first;
+    shard.lru.push_front(&it->first);
+    it->second.lru_pos = shard.lru.begin();
+}
+
+std::size_t DecisionCache::size() const {
+    std::size_t total = 0;
+    for (const auto& shard : shards_) {
+        const std::lock_guard lock{shard.mutex};
+        total += shard.map.size();
+    }
+    return total;
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// decision_cache.hpp
+//
+// 쿼리 형태(fingerprint) 단위 정책 판정 캐시.
+//
+// [설계 의도]
+// OLTP 트래픽은 리터럴만 다른 수백 개의 구문 형태가 대부분이다. 같은 형태·같은
+// 사용자/IP·같은 정책 세대에서는 리터럴 비의존 판정(구문/접근 제어/테이블/프로시저/
+// 스키마)이 항상 같으므로 한 번 계산한 결과를 재사용한다.
+//
+// [저장하지 않는 것 — fail-close]
+// - block_patterns 정규식 결과: 리터럴 내용에 의존하므로 적중 시에도 원문에 매번 수행한다.
+// - time_restriction 을 거친 판정: 시각에 의존하므로 캐시하지 않는다.
+// - 정책 세대(generation)가 다르면 적중하지 않는다. reload() 마다 세대가 증가한다.
+//
+// [스레드 안전성]
+// 키 해시로 샤드를 나누고 샤드별 mutex 로 보호한다. 엔트리는 불변 shared_ptr 로
+// 공유하므로 find() 는 참조 카운트 증가 외 복사가 없다.
+// 샤드별 LRU 로 용량을 제한한다.
+// ---------------------------------------------------------------------------
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "parser/sql_parser.hpp"     // SqlCommand
+#include "policy/policy_engine.hpp"  // PolicyResult
+#include "policy/rule_profile.hpp"   // kNoAccessRule
+
+// [의존 방향] decision_cache.hpp → policy_engine.hpp (단방향).
+// policy_engine.hpp 는 DecisionCache 를 전방 선언만 한다.
+
+// ---------------------------------------------------------------------------
+// DecisionCacheKeyView
+//   조회용 키. 세션 문자열과 fingerprint 를 복사하지 않고 가리킨다 (find() 할당 없음).
+// ---------------------------------------------------------------------------
+struct DecisionCacheKeyView {
+    std::uint64_t generation{0};
+    std::string_view db_user{};
+    std::string_view client_ip{};
+    std::string_view fingerprint{};
+};
+
+// ---------------------------------------------------------------------------
+// DecisionCacheKey
+//   generation : PolicyEngine 정책 세대 (reload 마다 증가)
+//   db_user / client_ip : access_control 매칭 입력
+//   fingerprint: fingerprint_query() 결과
+// ---------------------------------------------------------------------------
+struct DecisionCacheKey {
+    std::uint64_t generation{0};
+    std::string db_user{};
+    std::string client_ip{};
+    std::string fingerprint{};
+
+    bool operator==(const DecisionCacheKey&) const = default;
+
+    [[nodiscard]] DecisionCacheKeyView view() const noexcept {
+        return DecisionCacheKeyView{.generation = generation,
+                                    .db_user = db_user,
+                                    .client_ip = client_ip,
+                                    .fingerprint = fingerprint};
+    }
+};
+
+// DecisionCacheKey / DecisionCacheKeyView 가 같은 해시를 내도록 string_view 기준으로 섞는다
+struct DecisionCacheKeyHash {
+    using is_transparent = void;
+
+    std::size_t operator()(const DecisionCacheKeyView& key) const noexcept;
+    std::size_t operator()(const DecisionCacheKey& key) const noexcept {
+        return (*this)(key.view());
+    }
+};
+
+struct DecisionCacheKeyEqual {
+    using is_transparent = void;
+
+    bool operator()(const DecisionCacheKey& a, const DecisionCacheKey& b) const noexcept {
+        return a == b;
+    }
+    bool operator()(const DecisionCacheKeyView& a, const DecisionCacheKey& b) const noexcept {
+        return a.generation == b.generation && a.db_user == b.db_user &&
+               a.client_ip == b.client_ip && a.fingerprint == b.fingerprint;
+    }
+    bool operator()(const DecisionCacheKey& a, const DecisionCacheKeyView& b) const noexcept {
+        return (*this)(b, a);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// CachedDecision
+//   result         : block_patterns 단계를 제외한 판정
+//   patterns_apply : true 이면 적중 시 block_patterns 를 원문에 수행해야 한다
+//   reached_allow  : 리터럴 비의존 단계를 모두 통과했는지 (monitor 패턴 적중 결합용)
+//   access_rule_index: 매칭된 access_control 위치 (적중 시 RuleProfile hits 집계용)
+//   command/tables : 파서 결과 (적중 시 파싱 없이 감사 로그에 사용)
+// ---------------------------------------------------------------------------
+struct CachedDecision {
+    PolicyResult result{};
+    bool patterns_apply{true};
+    bool reached_allow{false};
+    std::size_t access_rule_index{kNoAccessRule};
+    SqlCommand command{SqlCommand::kUnknown};
+    std::vector<std::string> tables{};
+};
+
+class DecisionCache {
+public:
+    // 이 길이를 넘는 fingerprint 는 저장하지 않는다 (대량 INSERT 등 메모리 보호)
+    static constexpr std::size_t kMaxFingerprintBytes = 4096;
+
+    // capacity == 0 이면 비활성 (find 는 항상 nullptr, insert 는 no-op)
+    explicit DecisionCache(std::size_t capacity);
+
+    DecisionCache(const DecisionCache&) = delete;
+    DecisionCache& operator=(const DecisionCache&) = delete;
+    DecisionCache(DecisionCache&&) = delete;
+    DecisionCache& operator=(DecisionCache&&) = delete;
+    ~DecisionCache() = default;
+
+    [[nodiscard]] std::shared_ptr<const CachedDecision> find(const DecisionCacheKeyView& key);
+    [[nodiscard]] std::shared_ptr<const CachedDecision> find(const DecisionCacheKey& key) {
+        return find(key.view());
+    }
+    void insert(DecisionCacheKey key, std::shared_ptr<const CachedDecision> decision);
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::uint64_t hits() const noexcept {
+        return hits_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t misses() const noexcept {
+        return misses_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::size_t kShardCount = 16;
+
+    struct Shard {
+        // 앞쪽이 최근 사용. unordered_map 노드 주소는 rehash 후에도 유지되므로 키 포인터를 보관
+        using Lru = std::list<const DecisionCacheKey*>;
+        struct Slot {
+            std::shared_ptr<const CachedDecision> decision;
+            Lru::iterator lru_pos;
+        };
+
+        mutable std::mutex mutex;
+        Lru lru;
+        std::unordered_map<DecisionCacheKey, Slot, DecisionCacheKeyHash, DecisionCacheKeyEqual>
+            map;
+    };
+
+    std::size_t capacity_;
+    std::size_t shard_capacity_;
+    std::array<Shard, kShardCount> shards_{};
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+
+    Shard& shard_for(const DecisionCacheKeyView& key) noexcept;
+};
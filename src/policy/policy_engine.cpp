@@ -19,13 +19,15 @@
 // [참고] C++23에서 std::atomic<std::shared_ptr<T>> 가 권장되나 헤더 변경 불가.
 //
 // [IPv4 CIDR 매칭]
-// ip_in_cidr() 는 IPv4 전용이다. IPv6 는 미지원 (알려진 한계).
-// CIDR 파싱 실패 시 false 반환 (fail-close: 알 수 없는 IP = 차단).
+// access_control 은 생성/reload 시 CompiledAccessIndex (user 해시맵 + CIDR radix trie) 로
+// 컴파일된다 (policy/access_index.hpp). IPv4 전용이며 IPv6 는 미지원 (알려진 한계).
+// CIDR 파싱 실패 룰은 어떤 IP 와도 매칭되지 않는다 (fail-close: 알 수 없는 IP = 차단).
 //
 // [시간대 처리]
-// C++20 std::chrono::locate_zone + zoned_time 을 사용하여 setenv/tzset 없이
-// 스레드 안전하게 시간대를 처리한다. IANA tz database 기반이므로 DST 도 정확하다.
-// locate_zone 실패(알 수 없는 timezone) 시 false 반환 (fail-close).
+// time_restriction 은 컴파일 시 분 단위 창 + timezone 별 ZoneClock 으로 변환된다
+// (policy/access_index.hpp). ZoneClock 은 C++20 std::chrono::time_zone::get_info 로
+// 오프셋을 구하므로 setenv/tzset 없이 스레드 안전하고, 오프셋 전환 시각에 캐시가 만료되어
+// DST 도 정확하다. 잘못된 allow_range / 알 수 없는 timezone 은 차단 (fail-close).
 //
 // [schema 접근 차단 우회 방지]
 // SQL 파서가 "schema.table" 형태로 테이블을 추출하는 경우에도
@@ -35,31 +37,34 @@
 // - access_control 의 user = "*" 와일드카드: 모든 사용자에 적용되므로
 //   규칙 순서 오류 시 의도치 않은 허용/차단 발생 가능.
 // - block_patterns 의 regex 잘못 작성 시 해당 패턴만 건너뜀 (false negative 증가).
+//   패턴은 로드/reload 시 1회 컴파일되어 SqlRule::compiled_patterns 에 보관된다.
 // - CIDR 매칭 실패 (잘못된 CIDR 문자열): 해당 규칙을 매칭 실패로 처리 (fail-close).
 //
 // [알려진 한계]
 // - IPv6 CIDR 매칭 미지원
-// - 시간대 변환의 DST 오차
 // - 복잡한 서브쿼리/CTE 에서 테이블명 추출 불완전 (파서 한계)
 // ---------------------------------------------------------------------------
 
 #include "policy/policy_engine.hpp"
 
-#include <arpa/inet.h>   // inet_pton, AF_INET
-#include <netinet/in.h>  // in_addr
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
 #include <cctype>
-#include <chrono>   // C++20 timezone
-#include <cstring>  // memset
-#include <ctime>    // localtime_r
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <ranges>
 #include <regex>
 #include <string>
 #include <string_view>
+#include <vector>
+
+#include "parser/injection_detector.hpp"
+#include "policy/access_index.hpp"
+#include "policy/compiled_patterns.hpp"
+#include "policy/decision_cache.hpp"
+#include "policy/rule_profile.hpp"
 
 // ---------------------------------------------------------------------------
 // 내부 헬퍼
@@ -106,192 +111,162 @@ bool iequals(std::string_view a, std::string_view b) {
     });
 }
 
-// ---------------------------------------------------------------------------
-// 내부 헬퍼: IPv4 CIDR 매칭
-//
-// IPv4 전용. cidr_string 형식: "10.0.0.0/8"
-// 실패(잘못된 CIDR/IP 형식) 시 false 반환 (fail-close).
-//
-// [보안 주의]
-// IP 스푸핑 방어는 네트워크 레이어 소관.
-// 이 함수는 텍스트 파싱만 수행하며 패킷 레벨 검증을 수행하지 않는다.
-//
-// [알려진 한계]
-// - IPv6 미지원. IPv6 주소가 전달되면 inet_pton(AF_INET, ...) 실패 → false 반환.
-// - "0.0.0.0/0" (모든 IP 허용) 은 올바르게 처리된다.
-// ---------------------------------------------------------------------------
-bool ip_in_cidr(const std::string& ip, const std::string& cidr) {
-    // CIDR에서 '/' 기준 분리
-    const auto slash_pos = cidr.find('/');
-    if (slash_pos == std::string::npos) {
-        spdlog::warn("policy_engine: invalid CIDR format (no '/') '{}'", cidr);
-        return false;
-    }
-
-    const std::string network_str = cidr.substr(0, slash_pos);
-    const std::string prefix_str = cidr.substr(slash_pos + 1);
-
-    // prefix_len 파싱
-    int prefix_len = 0;
-    try {
-        std::size_t idx{0};
-        prefix_len = std::stoi(prefix_str, &idx);
-        if (idx != prefix_str.size() || prefix_len < 0 || prefix_len > 32) {
-            spdlog::warn("policy_engine: invalid prefix length in CIDR '{}'", cidr);
-            return false;
+// 테이블명의 '.' 구분 부분 중 숫자로만 된 것이 있는지 ("123", "archive.2023").
+// fingerprint_query 는 숫자로만 된 단어를 '?' 로 바꾸므로 이런 테이블은 서로 구분되지 않는다.
+bool has_numeric_name_part(std::string_view table) {
+    while (!table.empty()) {
+        const auto dot_pos = table.find('.');
+        const auto part = table.substr(0, dot_pos);
+        if (!part.empty() &&
+            std::ranges::all_of(part, [](char c) { return c >= '0' && c <= '9'; })) {
+            return true;
         }
-    } catch (const std::exception&) {
-        spdlog::warn("policy_engine: cannot parse prefix length in CIDR '{}'", cidr);
-        return false;
-    }
-
-    // IP 주소를 32비트 정수로 변환
-    struct in_addr ip_addr{};
-    struct in_addr net_addr{};
-
-    if (inet_pton(AF_INET, ip.c_str(), &ip_addr) != 1) {
-        // IPv6 또는 잘못된 IP — fail-close
-        spdlog::debug("policy_engine: cannot parse client IP '{}' as IPv4", ip);
-        return false;
-    }
-    if (inet_pton(AF_INET, network_str.c_str(), &net_addr) != 1) {
-        spdlog::warn(
-            "policy_engine: cannot parse network address '{}' in CIDR '{}'", network_str, cidr);
-        return false;
+        if (dot_pos == std::string_view::npos) {
+            break;
+        }
+        table.remove_prefix(dot_pos + 1);
     }
-
-    // 네트워크 마스크 계산
-    // prefix_len == 0: 모든 IP 허용 (마스크 = 0)
-    const std::uint32_t mask =
-        (prefix_len == 0) ? 0U : htonl(~0U << (32 - static_cast<unsigned>(prefix_len)));
-
-    const std::uint32_t ip_int = ip_addr.s_addr;
-    const std::uint32_t net_int = net_addr.s_addr;
-
-    return (ip_int & mask) == (net_int & mask);
+    return false;
 }
 
 // ---------------------------------------------------------------------------
-// 내부 헬퍼: 시간 범위 파싱
-// 형식: "HH:MM-HH:MM" (예: "09:00-18:00")
+// ensure_compiled_patterns
+//   cfg.sql_rules.compiled_patterns 가 없거나 block_patterns 와 불일치하면 재컴파일한다.
+//   PolicyLoader 가 이미 컴파일한 config 는 그대로 재사용한다 (경고 중복 방지).
+//   config 가 게시(config_.store)되기 전에만 호출해야 한다.
+//
+//   live: 현재 게시된 config (reload 시, 없으면 nullptr). 새 config 와 비교해
+//         바뀌지 않은 부분의 컴파일 결과를 재사용한다.
+//     - block_patterns   : 원본 문자열이 같은 패턴은 regex 재사용, 나머지만 컴파일
+//     - injection_detector: block_patterns 전체가 같으면 live 의 detector 를 공유
+//     - access_index     : access_control 전체가 같으면 live 의 인덱스를 공유
+//   rule_profile 은 diff 와 무관하게 스냅샷마다 새로 만든다 (reload 마다 0 부터).
 // ---------------------------------------------------------------------------
-struct TimeRange {
-    int start_h{0};
-    int start_m{0};
-    int end_h{0};
-    int end_m{0};
-};
-
-std::optional<TimeRange> parse_time_range(const std::string& range_str) {
-    // "HH:MM-HH:MM" 형식 파싱
-    // 최소 길이: "0:0-0:0" = 7
-    if (range_str.size() < 7) {
-        spdlog::warn("policy_engine: invalid time range format '{}' (too short)", range_str);
-        return std::nullopt;
+void ensure_compiled_patterns(PolicyConfig& cfg, const PolicyConfig* live) {
+    if (live == &cfg) {
+        live = nullptr;  // 같은 객체를 다시 게시: 비교 기준 없음 (제자리 수정 가능성)
     }
-
-    const auto dash_pos = range_str.find('-', 1);
-    if (dash_pos == std::string::npos) {
-        spdlog::warn("policy_engine: invalid time range format '{}' (no '-')", range_str);
-        return std::nullopt;
-    }
-
-    const std::string start_str = range_str.substr(0, dash_pos);
-    const std::string end_str = range_str.substr(dash_pos + 1);
-
-    auto parse_hhmm = [](const std::string& hhmm, int& hour, int& min) -> bool {
-        const auto colon_pos = hhmm.find(':');
-        if (colon_pos == std::string::npos) {
-            return false;
+    const CompiledBlockPatterns* previous_patterns =
+        live != nullptr ? live->sql_rules.compiled_patterns.get() : nullptr;
+
+    const bool stale =
+        !is_compiled_for(cfg.sql_rules.compiled_patterns, cfg.sql_rules.block_patterns);
+    if (stale) {
+        cfg.sql_rules.compiled_patterns =
+            compile_block_patterns(cfg.sql_rules.block_patterns, previous_patterns);
+        for (const auto& invalid : cfg.sql_rules.compiled_patterns->invalid) {
+            // 잘못된 regex: 건너뜀 (false negative 증가)
+            spdlog::warn("policy_engine: invalid block_pattern '{}', skipping: {}",
+                         invalid.source,
+                         invalid.error);
         }
-        try {
-            std::size_t idx{0};
-            hour = std::stoi(hhmm.substr(0, colon_pos), &idx);
-            min = std::stoi(hhmm.substr(colon_pos + 1), &idx);
-            return (hour >= 0 && hour <= 23 && min >= 0 && min <= 59);
-        } catch (const std::exception&) {
-            return false;
+    }
+    cfg.sql_rules.compiled_stamp =
+        stamp_compiled_for(cfg.sql_rules.compiled_patterns, cfg.sql_rules.block_patterns);
+
+    // 공유 InjectionDetector: 기본 패턴 + 유효한 block_patterns (중복 제외).
+    // 잘못된 block_pattern 은 위에서 이미 경고했으므로 detector 에 넘기지 않는다.
+    const bool detector_reusable = live != nullptr && live->sql_rules.injection_detector &&
+                                   live->sql_rules.block_patterns == cfg.sql_rules.block_patterns;
+    bool detector_reused = false;
+    if ((stale || !cfg.sql_rules.injection_detector) && detector_reusable) {
+        cfg.sql_rules.injection_detector = live->sql_rules.injection_detector;
+        detector_reused = true;
+    } else if (stale || !cfg.sql_rules.injection_detector) {
+        std::vector<std::string> patterns = builtin_injection_patterns();
+        for (const auto& entry : cfg.sql_rules.compiled_patterns->patterns) {
+            if (std::ranges::find(patterns, entry.source) == patterns.end()) {
+                patterns.push_back(entry.source);
+            }
         }
-    };
+        cfg.sql_rules.injection_detector =
+            std::make_shared<const InjectionDetector>(std::move(patterns));
+    }
 
-    TimeRange tr{};
-    if (!parse_hhmm(start_str, tr.start_h, tr.start_m)) {
-        spdlog::warn("policy_engine: invalid start time in range '{}'", range_str);
-        return std::nullopt;
+    // access_control 인덱스: 잘못된 CIDR 은 컴파일 시점에 1회 경고 (해당 룰은 매칭 불가)
+    const bool index_reused = live != nullptr && live->access_index &&
+                              live->access_index->rule_count == live->access_control.size() &&
+                              live->access_control == cfg.access_control;
+    cfg.access_index =
+        index_reused ? live->access_index : compile_access_index(cfg.access_control);
+    for (const auto& invalid : cfg.access_index->invalid_cidrs) {
+        spdlog::warn("policy_engine: invalid source_ip_cidr '{}' in access rule #{} (user='{}'), "
+                     "rule never matches (fail-close)",
+                     invalid.cidr,
+                     invalid.rule_index,
+                     cfg.access_control[invalid.rule_index].user);
     }
-    if (!parse_hhmm(end_str, tr.end_h, tr.end_m)) {
-        spdlog::warn("policy_engine: invalid end time in range '{}'", range_str);
-        return std::nullopt;
+    // time_restriction: 잘못된 allow_range / timezone 도 컴파일 시점에 1회 경고
+    for (const auto& issue : cfg.access_index->time_issues) {
+        const auto& user = cfg.access_control[issue.rule_index].user;
+        switch (issue.kind) {
+            case TimeRestrictionIssue::Kind::kInvalidRange:
+                spdlog::warn("policy_engine: invalid time range format '{}' ({}) in access rule "
+                             "#{} (user='{}'), blocking (fail-close)",
+                             issue.value,
+                             issue.detail,
+                             issue.rule_index,
+                             user);
+                break;
+            case TimeRestrictionIssue::Kind::kUnknownTimezone:
+                spdlog::warn("policy_engine: timezone '{}' lookup failed ({}) in access rule #{} "
+                             "(user='{}'), denying access (fail-close)",
+                             issue.value,
+                             issue.detail,
+                             issue.rule_index,
+                             user);
+                break;
+            case TimeRestrictionIssue::Kind::kEmptyTimezone:
+                spdlog::warn("policy_engine: empty timezone in access rule #{} (user='{}'), "
+                             "falling back to UTC",
+                             issue.rule_index,
+                             user);
+                break;
+        }
     }
 
-    return tr;
+    // 규칙별 프로파일은 스냅샷마다 새로 센다 (인덱스가 이 스냅샷의 규칙 위치이므로)
+    cfg.rule_profile = std::make_shared<RuleProfile>(cfg.access_control.size(),
+                                                     cfg.sql_rules.block_patterns.size());
+
+    if (live != nullptr) {
+        const std::size_t reused_patterns = cfg.sql_rules.compiled_patterns->reused;
+        spdlog::info("policy_engine: reload diff — access_index {}, block_patterns {}/{} "
+                     "reused, injection_detector {}",
+                     index_reused ? "reused" : "recompiled",
+                     reused_patterns,
+                     cfg.sql_rules.block_patterns.size(),
+                     detector_reused ? "reused" : "rebuilt");
+    }
 }
 
 // ---------------------------------------------------------------------------
-// 내부 헬퍼: 현재 시각이 TimeRange 내인지 확인 (timezone 적용)
-//
-// [스레드 안전성 — C++20 chrono timezone 사용]
-// 이전 구현은 setenv("TZ", ...) + tzset() 으로 프로세스 전역 TZ 환경변수를
-// 변경하여 다른 스레드의 시간 계산(로그 타임스탬프 등)에 부작용을 일으켰다.
-// C++20 std::chrono::locate_zone + zoned_time 을 사용하면 TZ 환경변수를
-// 건드리지 않으므로 프로세스 전체에 부작용이 없고 스레드 안전하다.
-//
-// [오탐/미탐 트레이드오프]
-// - tz_name 이 비어있으면 UTC("Etc/UTC") 로 fallback. fail-close 적용.
-// - std::chrono::locate_zone 이 알 수 없는 timezone 문자열을 받으면
-//   std::runtime_error 를 던진다. catch 후 false(차단) 반환 (fail-close).
-//
-// [DST 한계]
-// std::chrono::zoned_time 은 IANA tz database 기반이므로 DST 전환을
-// 정확하게 처리한다. 이전 setenv/tzset 구현보다 정확도가 높다.
-//
-// [알려진 한계]
-// - IANA tz database 가 시스템에 없으면 locate_zone 이 실패할 수 있다.
-//   (GCC 14 libstdc++ 는 /usr/share/zoneinfo 를 사용한다.)
-// - "Asia/Seoul" 처럼 표준 IANA 이름만 지원한다. "KST+9" 형태는 불가.
+// compiled_patterns_for
+//   evaluate()/explain() 에서 사용할 컴파일 결과를 반환한다.
+//   게시 시 기록한 stamp 와 같으면 O(1) 로 그대로 쓴다.
+//   게시 이후 외부에서 block_patterns 가 수정된 경우에만 임시 컴파일한다
+//   (fail-close: 낡은 matcher 로 평가하지 않는다).
 // ---------------------------------------------------------------------------
-bool is_within_time_range(const TimeRange& range, const std::string& tz_name) {
-    int now_hour = 0;
-    int now_min = 0;
-
-    try {
-        // timezone 이름이 비어있으면 UTC 로 fallback (fail-close 보수적 선택)
-        const std::string effective_tz = tz_name.empty() ? "Etc/UTC" : tz_name;
-        if (tz_name.empty()) {
-            spdlog::warn("policy_engine: empty timezone, falling back to UTC (fail-close)");
-        }
-
-        // C++20 chrono: TZ 환경변수를 건드리지 않고 로컬 시각 획득
-        const auto* zone = std::chrono::locate_zone(effective_tz);
-        const auto now_sys = std::chrono::system_clock::now();
-        const std::chrono::zoned_time zt{zone, now_sys};
-        const auto local_time = zt.get_local_time();
-
-        // 일(day) 경계를 구한 뒤 시:분 추출
-        const auto dp = std::chrono::floor<std::chrono::days>(local_time);
-        const std::chrono::hh_mm_ss hms{local_time - dp};
-
-        now_hour = static_cast<int>(hms.hours().count());
-        now_min = static_cast<int>(hms.minutes().count());
-
-    } catch (const std::exception& e) {
-        // locate_zone 실패(알 수 없는 timezone 등) → fail-close: 차단
-        spdlog::warn("policy_engine: timezone '{}' lookup failed ({}), denying access (fail-close)",
-                     tz_name,
-                     e.what());
-        return false;
+std::shared_ptr<const CompiledBlockPatterns> compiled_patterns_for(const PolicyConfig& cfg) {
+    if (is_compiled_for(cfg.sql_rules.compiled_patterns,
+                        cfg.sql_rules.block_patterns,
+                        cfg.sql_rules.compiled_stamp)) {
+        return cfg.sql_rules.compiled_patterns;
     }
+    return compile_block_patterns(cfg.sql_rules.block_patterns);
+}
 
-    const int now_minutes = (now_hour * 60) + now_min;
-    const int start_minutes = (range.start_h * 60) + range.start_m;
-    const int end_minutes = (range.end_h * 60) + range.end_m;
-
-    // 자정을 넘지 않는 단순 범위 (예: 09:00-18:00)
-    if (start_minutes <= end_minutes) {
-        return (now_minutes >= start_minutes && now_minutes < end_minutes);
+// ---------------------------------------------------------------------------
+// access_index_for
+//   evaluate()/explain() 에서 사용할 access_control 인덱스를 반환한다.
+//   게시 이후 외부에서 룰이 추가/삭제된 경우에만 임시 컴파일한다
+//   (fail-close: 범위를 벗어난 인덱스로 평가하지 않는다).
+// ---------------------------------------------------------------------------
+std::shared_ptr<const CompiledAccessIndex> access_index_for(const PolicyConfig& cfg) {
+    if (cfg.access_index && cfg.access_index->rule_count == cfg.access_control.size()) {
+        return cfg.access_index;
     }
-    // 자정을 넘는 범위 (예: 22:00-06:00)
-    return (now_minutes >= start_minutes || now_minutes < end_minutes);
+    return compile_access_index(cfg.access_control);
 }
 
 }  // namespace
@@ -300,6 +275,12 @@ bool is_within_time_range(const TimeRange& range, const std::string& tz_name) {
 // PolicyEngine 생성자
 // ---------------------------------------------------------------------------
 PolicyEngine::PolicyEngine(std::shared_ptr<PolicyConfig> config) : config_(std::move(config)) {
+    // 판정 캐시 용량은 초기 config 기준으로 고정한다 (reload 는 세대 증가로 무효화만 한다).
+    // config 가 없으면 어떤 판정도 캐시할 수 없으므로 비활성.
+    const auto initial = config_.load(std::memory_order_relaxed);
+    decision_cache_ =
+        std::make_unique<DecisionCache>(initial ? initial->global.decision_cache_entries : 0U);
+
     // config_ 가 nullptr 이면 이후 모든 evaluate() 가 kBlock 을 반환한다.
     // fail-close 원칙에 의해 nullptr config 도 허용하되, 차단으로 처리.
     // config_ 는 std::atomic<std::shared_ptr<PolicyConfig>> 이므로 load() 로 읽는다.
@@ -309,6 +290,8 @@ PolicyEngine::PolicyEngine(std::shared_ptr<PolicyConfig> config) : config_(std::
             "policy_engine: constructed with nullptr config — all queries will be blocked "
             "(fail-close)");
     } else {
+        // 생성자 내부이므로 아직 다른 스레드에 게시되지 않았다.
+        ensure_compiled_patterns(*loaded, nullptr);
         spdlog::info(
             "policy_engine: initialized with {} access rules, {} block statements, {} block "
             "patterns",
@@ -318,23 +301,132 @@ PolicyEngine::PolicyEngine(std::shared_ptr<PolicyConfig> config) : config_(std::
     }
 }
 
+// DecisionCache 가 불완전 타입인 헤더에서 unique_ptr 소멸자를 생성하지 않도록 여기서 정의
+PolicyEngine::~PolicyEngine() = default;
+
 // ---------------------------------------------------------------------------
-// PolicyEngine::evaluate 구현
+// evaluate 단계 분리 (판정 캐시 지원)
 //
-// 평가 순서는 설계 명세(DON-26)를 준수한다.
-// 모든 예외는 catch 후 kBlock 반환 (fail-close).
+// evaluate() = apply_block_patterns(evaluate_structural(...), raw_sql)
+//
+// evaluate_structural: block_patterns(Step 4) 를 제외한 모든 단계.
+//   입력은 command / tables / 세션 user·IP / 시각뿐이므로, time_restriction 을
+//   거치지 않은 결과는 같은 fingerprint·user·IP·정책 세대에서 재사용할 수 있다.
+// apply_block_patterns: 리터럴 내용에 의존하는 Step 4 를 원문에 수행하고 결합한다.
+//   결합 규칙은 단일 함수로 평가하던 기존 순서와 동일한 결과를 낸다:
+//   - block_statements 가 매칭됐으면(patterns_apply=false) Step 4 는 생략된다.
+//   - enforce 패턴 매칭은 이후 단계보다 우선하여 즉시 kBlock.
+//   - monitor 패턴 매칭은 나머지 단계가 모두 통과(reached_allow)한 경우에만 kLog 로 반환.
 // ---------------------------------------------------------------------------
-PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionContext& session) const {
-    // apply_monitor: monitor 모드일 때 kBlock → kLog 다운그레이드.
-    // monitor 모드에서는 실제 차단 없이 로그만 기록한다.
-    auto apply_monitor = [](PolicyResult r, RuleMode m) -> PolicyResult {
-        if (m == RuleMode::kMonitor && r.action == PolicyAction::kBlock) {
-            r.action = PolicyAction::kLog;
-            r.monitor_mode = true;
-            r.reason = "[monitor] " + r.reason;
+namespace {
+
+struct StructuralDecision {
+    PolicyResult result{};
+    bool patterns_apply{false};  // Step 4 가 결과를 바꿀 수 있음
+    bool reached_allow{false};   // Step 12 (명시적 allow) 도달
+    bool time_dependent{false};  // Step 7 time_restriction 평가를 거침 (캐시 금지)
+    std::size_t access_rule_index{kNoAccessRule};  // 매칭된 access_control 위치
+};
+
+// ---------------------------------------------------------------------------
+// AccessRuleTimer
+//   Step 5 (access_control 탐색) 부터 판정 반환까지의 시간을 매칭 규칙에 귀속한다.
+//   매칭 규칙이 없으면 no_access_rule 로 기록한다. profile 이 없으면 시각도 읽지 않는다.
+// ---------------------------------------------------------------------------
+class AccessRuleTimer {
+public:
+    explicit AccessRuleTimer(RuleProfile* profile) noexcept
+        : profile_{profile},
+          start_{profile != nullptr ? std::chrono::steady_clock::now()
+                                    : std::chrono::steady_clock::time_point{}} {}
+
+    ~AccessRuleTimer() {
+        if (profile_ == nullptr) {
+            return;
         }
-        return r;
-    };
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        if (index_ == kNoAccessRule) {
+            profile_->record_no_access_rule(elapsed);
+        } else {
+            profile_->record_access_rule(index_, elapsed);
+        }
+    }
+
+    AccessRuleTimer(const AccessRuleTimer&) = delete;
+    AccessRuleTimer& operator=(const AccessRuleTimer&) = delete;
+    AccessRuleTimer(AccessRuleTimer&&) = delete;
+    AccessRuleTimer& operator=(AccessRuleTimer&&) = delete;
+
+    void matched(std::size_t index) noexcept { index_ = index; }
+
+private:
+    RuleProfile* profile_;
+    std::chrono::steady_clock::time_point start_;
+    std::size_t index_{kNoAccessRule};
+};
+
+// apply_monitor: monitor 모드일 때 kBlock → kLog 다운그레이드.
+// monitor 모드에서는 실제 차단 없이 로그만 기록한다.
+PolicyResult apply_monitor(PolicyResult r, RuleMode m) {
+    if (m == RuleMode::kMonitor && r.action == PolicyAction::kBlock) {
+        r.action = PolicyAction::kLog;
+        r.monitor_mode = true;
+        r.reason = "[monitor] " + r.reason;
+    }
+    return r;
+}
+
+// resolve_query_log: 허용된 쿼리의 로그 샘플링 비율을 결정한다.
+// 우선순위: AccessRule::log_sample_rate > command_sample_rates > sample_rate.
+// rate limit 파라미터는 전역 설정을 그대로 사용한다.
+QueryLogDirective resolve_query_log(const QueryLogSampling& sampling,
+                                    const AccessRule& rule,
+                                    std::string_view cmd_str) {
+    QueryLogDirective directive{.sample_rate = sampling.sample_rate,
+                                .session_rate_limit = sampling.session_rate_limit,
+                                .session_burst = sampling.session_burst};
+    if (rule.log_sample_rate.has_value()) {
+        directive.sample_rate = *rule.log_sample_rate;
+        return directive;
+    }
+    for (const auto& entry : sampling.command_sample_rates) {
+        if (iequals(cmd_str, entry.command)) {
+            directive.sample_rate = entry.rate;
+            break;
+        }
+    }
+    return directive;
+}
+
+// ---------------------------------------------------------------------------
+// find_access_rule
+//   (user, IP) 의 첫 번째 매칭 룰 인덱스. binding 이 현재 스냅샷·같은 user/IP 로
+//   바인딩되어 있으면 저장된 결과를 재사용하고, 아니면 매칭 후 binding 을 갱신한다.
+// ---------------------------------------------------------------------------
+std::optional<std::size_t> find_access_rule(
+    const std::shared_ptr<const CompiledAccessIndex>& index,
+    const SessionContext& session,
+    PolicyBinding* binding) {
+    if (binding == nullptr) {
+        return index->find(session.db_user, session.client_ip);
+    }
+    if (binding->index != index || binding->db_user != session.db_user ||
+        binding->client_ip != session.client_ip) {
+        binding->index = index;
+        binding->db_user = session.db_user;
+        binding->client_ip = session.client_ip;
+        binding->access_rule = index->find(session.db_user, session.client_ip);
+        ++binding->binds;
+    }
+    return binding->access_rule;
+}
+
+StructuralDecision evaluate_structural(const PolicyConfig& cfg,
+                                       const ParsedQuery& query,
+                                       const SessionContext& session,
+                                       PolicyBinding* binding = nullptr) {
+    const PolicyConfig* const config = &cfg;  // 단계별 코드는 config-> 접근 형태 유지
+    StructuralDecision decision;
 
     // [보안 수정] monitor 모드에서 block_statements/block_patterns 매칭 시
     // 즉시 반환하지 않고 access_control 평가를 계속 진행한다.
@@ -342,24 +434,15 @@ PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionConte
     // 반드시 먼저 확정되어야 하며, access_control 통과 후에만 kLog를 반환해야 한다.
     std::optional<PolicyResult> sql_rules_monitor_hit;
 
-    // Step 1: config_ nullptr 체크
-    const auto config = config_.load(std::memory_order_acquire);
-    if (!config) {
-        spdlog::error("policy_engine: config is null, blocking query (fail-close) session={}",
-                      session.session_id);
-        return PolicyResult{.action = PolicyAction::kBlock,
-                            .matched_rule = "no-config",
-                            .reason = "Policy config unavailable"};
-    }
-
     // Step 2: Unknown command → kBlock
     if (query.command == SqlCommand::kUnknown) {
         spdlog::warn("policy_engine: unknown SQL command blocked, session={}, sql_prefix='{}'",
                      session.session_id,
                      query.raw_sql.substr(0, std::min(query.raw_sql.size(), std::size_t{50})));
-        return PolicyResult{.action = PolicyAction::kBlock,
-                            .matched_rule = "unknown-command",
-                            .reason = "Unknown SQL command blocked"};
+        decision.result = PolicyResult{.action = PolicyAction::kBlock,
+                                       .matched_rule = "unknown-command",
+                                       .reason = "Unknown SQL command blocked"};
+        return decision;
     }
 
     const std::string_view cmd_str = command_to_string(query.command);
@@ -384,67 +467,32 @@ PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionConte
                 r.reason = "[monitor] " + r.reason;
                 sql_rules_monitor_hit = r;
             } else {
-                return r;
+                decision.result = std::move(r);
+                return decision;
             }
             break;
         }
     }
 
-    // Step 4: SQL 패턴 차단 (block_patterns)
-    // [오탐 주의] ORM 생성 쿼리에서 false positive 발생 가능.
-    // [미탐 주의] 주석 분할(UN/**/ION)은 탐지 불가 (알려진 한계).
-    if (!sql_rules_monitor_hit.has_value()) {
-        for (const auto& pattern : config->sql_rules.block_patterns) {
-            try {
-                const std::regex re(pattern,
-                                    std::regex_constants::icase | std::regex_constants::ECMAScript);
-                if (std::regex_search(query.raw_sql, re)) {
-                    spdlog::info("policy_engine: block_pattern matched '{}', session={}, user='{}'",
-                                 pattern,
-                                 session.session_id,
-                                 session.db_user);
-                    PolicyResult r{.action = PolicyAction::kBlock,
-                                   .matched_rule = "block-pattern",
-                                   .reason = fmt::format("SQL pattern blocked: {}", pattern)};
-                    if (config->sql_rules.mode == RuleMode::kMonitor) {
-                        // monitor 모드: 즉시 반환하지 않고 access_control 평가 계속
-                        r.action = PolicyAction::kLog;
-                        r.monitor_mode = true;
-                        r.reason = "[monitor] " + r.reason;
-                        sql_rules_monitor_hit = r;
-                    } else {
-                        return r;
-                    }
-                    break;
-                }
-            } catch (const std::regex_error& e) {
-                // 잘못된 regex: 건너뜀 (false negative 증가, 로더에서 이미 경고)
-                spdlog::warn(
-                    "policy_engine: invalid block_pattern '{}', skipping: {}", pattern, e.what());
-            }
-        }
-    }
+    // Step 4: SQL 패턴 차단 (block_patterns) — apply_block_patterns 에서 원문에 수행.
+    // block_statements 가 이미 매칭됐으면 생략 (기존 평가 순서와 동일).
+    decision.patterns_apply = !sql_rules_monitor_hit.has_value();
 
     // Step 5: 사용자/IP 접근 제어 (access_control 룰 찾기)
-    // 첫 번째 매칭 룰을 적용한다 (순서 우선).
+    // 첫 번째 매칭 룰을 적용한다 (순서 우선). access_index 는 user 해시맵 + CIDR trie 로
+    // 선형 탐색과 같은 "가장 앞의 매칭 룰" 을 찾는다 (user 일치 또는 "*", CIDR 빈값 = 전체).
+    // 세션 binding 이 있으면 스냅샷당 1회만 매칭한다.
     // [오탐 주의] user="*" 가 있는 룰이 앞에 있으면 특정 사용자 룰이 무시될 수 있다.
+    AccessRuleTimer rule_timer{config->rule_profile.get()};
+    const auto access_index = access_index_for(*config);
+    const auto matched_index = find_access_rule(access_index, session, binding);
     const AccessRule* matched_rule = nullptr;
-    for (const auto& rule : config->access_control) {
-        // 사용자 매칭: 정확 일치 또는 와일드카드
-        const bool user_match = (rule.user == session.db_user || rule.user == "*");
-        if (!user_match) {
-            continue;
-        }
-
-        // IP CIDR 매칭: source_ip_cidr 가 비어있으면 모든 IP 허용
-        if (!rule.source_ip_cidr.empty()) {
-            if (!ip_in_cidr(session.client_ip, rule.source_ip_cidr)) {
-                continue;
-            }
-        }
-
-        matched_rule = &rule;
-        break;
+    const CompiledAccessRule* compiled_rule = nullptr;
+    if (matched_index.has_value()) {
+        matched_rule = &config->access_control[*matched_index];
+        compiled_rule = &access_index->rules[*matched_index];
+        decision.access_rule_index = *matched_index;
+        rule_timer.matched(*matched_index);
     }
 
     if (matched_rule == nullptr) {
@@ -452,48 +500,58 @@ PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionConte
                      session.db_user,
                      session.client_ip,
                      session.session_id);
-        return PolicyResult{.action = PolicyAction::kBlock,
-                            .matched_rule = "no-access-rule",
-                            .reason = "No matching access rule for user/IP"};
+        decision.result = PolicyResult{.action = PolicyAction::kBlock,
+                                       .matched_rule = "no-access-rule",
+                                       .reason = "No matching access rule for user/IP"};
+        return decision;
     }
 
     // Step 6: 차단 오퍼레이션 체크 (blocked_operations)
     // blocked_operations 는 allowed_operations 보다 우선 적용된다.
-    for (const auto& blocked_op : matched_rule->blocked_operations) {
-        if (iequals(cmd_str, blocked_op)) {
-            spdlog::info("policy_engine: blocked_operation '{}' matched, session={}, user='{}'",
-                         blocked_op,
-                         session.session_id,
-                         session.db_user);
-            return apply_monitor(
-                PolicyResult{
-                    .action = PolicyAction::kBlock,
-                    .matched_rule = "blocked-operation",
-                    .reason = fmt::format(
-                        "Operation blocked for user '{}': {}", session.db_user, blocked_op)},
-                matched_rule->mode);
-        }
+    // 비트마스크로 판정하고, 차단 시에만 사유 표기용 원본 문자열을 찾는다.
+    if (compiled_rule->operation_blocked(query.command)) {
+        const auto blocked_op = std::ranges::find_if(
+            matched_rule->blocked_operations,
+            [&cmd_str](const std::string& op) { return iequals(cmd_str, op); });
+        const std::string_view blocked_name =
+            blocked_op != matched_rule->blocked_operations.end() ? std::string_view{*blocked_op}
+                                                                 : cmd_str;
+        spdlog::info("policy_engine: blocked_operation '{}' matched, session={}, user='{}'",
+                     blocked_name,
+                     session.session_id,
+                     session.db_user);
+        decision.result = apply_monitor(
+            PolicyResult{
+                .action = PolicyAction::kBlock,
+                .matched_rule = "blocked-operation",
+                .reason = fmt::format(
+                    "Operation blocked for user '{}': {}", session.db_user, blocked_name)},
+            matched_rule->mode);
+        return decision;
     }
 
     // Step 7: 시간대 제한 체크 (time_restriction)
+    // allow_range 는 분 단위로, timezone 은 ZoneClock 으로 사전 계산되어 있다.
     if (matched_rule->time_restriction.has_value()) {
+        decision.time_dependent = true;
         const auto& tr = matched_rule->time_restriction.value();
-        const auto range = parse_time_range(tr.allow_range);
-        if (!range.has_value()) {
+        const auto& window = compiled_rule->time_window;
+        if (!window.has_value() || !window->valid) {
             // allow_range 파싱 실패 → fail-close (차단)
             spdlog::error(
                 "policy_engine: invalid allow_range '{}' for user='{}', blocking (fail-close)",
                 tr.allow_range,
                 session.db_user);
-            return apply_monitor(
+            decision.result = apply_monitor(
                 PolicyResult{
                     .action = PolicyAction::kBlock,
                     .matched_rule = "time-restriction",
                     .reason = fmt::format("Invalid time restriction configuration for user '{}'",
                                           session.db_user)},
                 matched_rule->mode);
+            return decision;
         }
-        if (!is_within_time_range(range.value(), tr.timezone)) {
+        if (!window->allows(std::chrono::system_clock::now())) {
             spdlog::info(
                 "policy_engine: time_restriction denied, allow_range='{}', timezone='{}', "
                 "session={}, user='{}'",
@@ -501,63 +559,51 @@ PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionConte
                 tr.timezone,
                 session.session_id,
                 session.db_user);
-            return apply_monitor(PolicyResult{.action = PolicyAction::kBlock,
-                                              .matched_rule = "time-restriction",
-                                              .reason = "Access outside allowed hours"},
-                                 matched_rule->mode);
+            decision.result = apply_monitor(PolicyResult{.action = PolicyAction::kBlock,
+                                                         .matched_rule = "time-restriction",
+                                                         .reason = "Access outside allowed hours"},
+                                            matched_rule->mode);
+            return decision;
         }
     }
 
     // Step 8: 테이블 접근 제어 (allowed_tables)
     // "*" 가 포함되어 있으면 모든 테이블 허용.
     // query.tables 가 비어있으면 테이블 체크 건너뜀 (허용).
-    const bool all_tables_allowed = std::ranges::any_of(
-        matched_rule->allowed_tables, [](const std::string& t) { return t == "*"; });
-
-    if (!all_tables_allowed && !query.tables.empty()) {
+    // allowed_tables 는 소문자 해시셋으로 사전 계산되어 있다 (대소문자 무관 비교).
+    if (!compiled_rule->any_table && !query.tables.empty()) {
         for (const auto& table : query.tables) {
-            const bool table_allowed = std::ranges::any_of(
-                matched_rule->allowed_tables,
-                [&table](const std::string& allowed) { return iequals(table, allowed); });
-            if (!table_allowed) {
+            if (!compiled_rule->table_allowed(table)) {
                 spdlog::info(
                     "policy_engine: table '{}' not in allowed_tables for user='{}', session={}",
                     table,
                     session.db_user,
                     session.session_id);
-                return apply_monitor(
+                decision.result = apply_monitor(
                     PolicyResult{.action = PolicyAction::kBlock,
                                  .matched_rule = "table-denied",
                                  .reason = fmt::format("Table access denied: {}", table)},
                     matched_rule->mode);
+                return decision;
             }
         }
     }
 
     // Step 9: 허용 오퍼레이션 체크 (allowed_operations)
-    // allowed_operations 가 비어있지 않고 "*" 도 없으면 명시적 허용 목록과 비교.
-    if (!matched_rule->allowed_operations.empty()) {
-        const bool all_ops_allowed = std::ranges::any_of(
-            matched_rule->allowed_operations, [](const std::string& op) { return op == "*"; });
-
-        if (!all_ops_allowed) {
-            const bool op_allowed = std::ranges::any_of(
-                matched_rule->allowed_operations,
-                [&cmd_str](const std::string& op) { return iequals(cmd_str, op); });
-            if (!op_allowed) {
-                spdlog::info(
-                    "policy_engine: operation '{}' not in allowed_operations for user='{}', "
-                    "session={}",
-                    cmd_str,
-                    session.db_user,
-                    session.session_id);
-                return apply_monitor(
-                    PolicyResult{.action = PolicyAction::kBlock,
-                                 .matched_rule = "operation-denied",
-                                 .reason = fmt::format("Operation not allowed: {}", cmd_str)},
-                    matched_rule->mode);
-            }
-        }
+    // allowed_operations 가 비어있지 않고 "*" 도 없으면 명시적 허용 목록(비트마스크)과 비교.
+    if (!compiled_rule->operation_allowed(query.command)) {
+        spdlog::info(
+            "policy_engine: operation '{}' not in allowed_operations for user='{}', "
+            "session={}",
+            cmd_str,
+            session.db_user,
+            session.session_id);
+        decision.result = apply_monitor(
+            PolicyResult{.action = PolicyAction::kBlock,
+                         .matched_rule = "operation-denied",
+                         .reason = fmt::format("Operation not allowed: {}", cmd_str)},
+            matched_rule->mode);
+        return decision;
     }
 
     // Step 10: 프로시저 제어
@@ -575,17 +621,19 @@ PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionConte
                     cmd_str,
                     session.session_id,
                     session.db_user);
-                return apply_monitor(
+                decision.result = apply_monitor(
                     PolicyResult{
                         .action = PolicyAction::kBlock,
                         .matched_rule = "procedure-dynamic-sql",
                         .reason = fmt::format("Dynamic SQL ({}) blocked by policy", cmd_str)},
                     matched_rule->mode);
+                return decision;
             }
         } else if (query.command == SqlCommand::kCall) {
             // CALL: 화이트리스트/블랙리스트 모드
             // 프로시저명은 query.tables 의 첫 번째 요소로 파싱됨 (파서 구현 의존)
-            const std::string proc_name = query.tables.empty() ? "" : query.tables.front();
+            const std::string_view proc_name =
+                query.tables.empty() ? std::string_view{} : query.tables.front();
 
             if (pc.mode == "whitelist") {
                 // 화이트리스트 모드: whitelist 에 있어야 허용
@@ -598,12 +646,13 @@ PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionConte
                         proc_name,
                         session.session_id,
                         session.db_user);
-                    return apply_monitor(
+                    decision.result = apply_monitor(
                         PolicyResult{
                             .action = PolicyAction::kBlock,
                             .matched_rule = "procedure-whitelist",
                             .reason = fmt::format("Procedure '{}' not in whitelist", proc_name)},
                         matched_rule->mode);
+                    return decision;
                 }
             } else if (pc.mode == "blacklist") {
                 // 블랙리스트 모드: whitelist(블랙리스트로 재사용) 에 있으면 차단
@@ -616,12 +665,13 @@ PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionConte
                         proc_name,
                         session.session_id,
                         session.db_user);
-                    return apply_monitor(
+                    decision.result = apply_monitor(
                         PolicyResult{
                             .action = PolicyAction::kBlock,
                             .matched_rule = "procedure-blacklist",
                             .reason = fmt::format("Procedure '{}' is blacklisted", proc_name)},
                         matched_rule->mode);
+                    return decision;
                 }
             }
         }
@@ -638,11 +688,12 @@ PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionConte
                 cmd_str,
                 session.session_id,
                 session.db_user);
-            return apply_monitor(
+            decision.result = apply_monitor(
                 PolicyResult{.action = PolicyAction::kBlock,
                              .matched_rule = "procedure-create-alter",
                              .reason = fmt::format("{} blocked by procedure policy", cmd_str)},
                 matched_rule->mode);
+            return decision;
         }
     }
 
@@ -667,8 +718,8 @@ PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionConte
             // "information_schema.tables" → schema_part = "information_schema"
             // "information_schema"        → schema_part = "information_schema"
             const auto dot_pos = table.find('.');
-            const std::string schema_part =
-                (dot_pos != std::string::npos) ? table.substr(0, dot_pos) : table;
+            const std::string_view schema_part =
+                (dot_pos != std::string_view::npos) ? table.substr(0, dot_pos) : table;
 
             for (const auto& schema : schema_names) {
                 if (iequals(schema_part, schema)) {
@@ -679,10 +730,11 @@ PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionConte
                         schema_part,
                         session.session_id,
                         session.db_user);
-                    return apply_monitor(PolicyResult{.action = PolicyAction::kBlock,
+                    decision.result = apply_monitor(PolicyResult{.action = PolicyAction::kBlock,
                                                       .matched_rule = "schema-access",
                                                       .reason = "Schema access blocked"},
                                          matched_rule->mode);
+                    return decision;
                 }
             }
         }
@@ -694,12 +746,279 @@ PolicyResult PolicyEngine::evaluate(const ParsedQuery& query, const SessionConte
                   cmd_str,
                   session.session_id);
     // sql_rules monitor 매치가 있었다면: access_control 통과 후 kLog로 반환
+    decision.reached_allow = true;
     if (sql_rules_monitor_hit.has_value()) {
-        return sql_rules_monitor_hit.value();
+        decision.result = std::move(sql_rules_monitor_hit.value());
+        return decision;
+    }
+    decision.result =
+        PolicyResult{.action = PolicyAction::kAllow,
+                     .matched_rule = compiled_rule->allow_rule_id,
+                     .reason = "Access allowed",
+                     .query_log = resolve_query_log(config->global.query_log, *matched_rule,
+                                                    cmd_str)};
+    return decision;
+}
+
+// ---------------------------------------------------------------------------
+// find_block_pattern
+//   raw_sql 에 처음 매칭되는 block_pattern (없으면 nullptr).
+//   evaluate() 와 explain() 이 같은 판정을 내리도록 Step 4 매칭은 여기서만 수행한다.
+//   profile: 패턴별 평가 기록 대상 (explain 은 nullptr — 프로파일에 반영하지 않는다).
+// ---------------------------------------------------------------------------
+const CompiledBlockPattern* find_block_pattern(const CompiledBlockPatterns& compiled,
+                                               std::string_view raw_sql,
+                                               RuleProfile* profile) {
+    // [오탐 주의] ORM 생성 쿼리에서 false positive 발생 가능.
+    // [미탐 주의] 주석 분할(UN/**/ION)은 탐지 불가 (알려진 한계).
+    // 사전 필터 스캔 1회 → 필수 리터럴이 모두 등장한 패턴만 정규식으로 확정한다.
+    // 걸러진 패턴도 평가 1회(불일치, 비용 0)로 기록한다 (RuleProfile 평가 수 유지).
+    std::vector<bool> found;
+    compiled.prefilter.scan(raw_sql, found);
+    for (const auto& entry : compiled.patterns) {
+        if (!CompiledBlockPatterns::candidate(entry, found)) {
+            if (profile != nullptr) {
+                profile->record_pattern(entry.index, false, std::chrono::nanoseconds{0});
+            }
+            continue;
+        }
+        try {
+            const auto match_start = profile != nullptr ? std::chrono::steady_clock::now()
+                                                        : std::chrono::steady_clock::time_point{};
+            const bool matched = std::regex_search(raw_sql.begin(), raw_sql.end(), entry.regex);
+            if (profile != nullptr) {
+                profile->record_pattern(
+                    entry.index, matched, std::chrono::steady_clock::now() - match_start);
+            }
+            if (matched) {
+                return &entry;
+            }
+        } catch (const std::regex_error& e) {
+            // 매칭 중 regex 오류 (error_complexity/error_stack 등): 건너뜀
+            // (잘못된 패턴 자체는 컴파일 단계에서 이미 제외·경고됨)
+            spdlog::warn("policy_engine: block_pattern '{}' match failed, skipping: {}",
+                         entry.source,
+                         e.what());
+        }
+    }
+    return nullptr;
+}
+
+PolicyResult apply_block_patterns(const PolicyConfig& config,
+                                  const StructuralDecision& decision,
+                                  std::string_view raw_sql,
+                                  const SessionContext& session) {
+    if (!decision.patterns_apply) {
+        return decision.result;
+    }
+
+    const auto compiled = compiled_patterns_for(config);
+    const auto* entry = find_block_pattern(*compiled, raw_sql, config.rule_profile.get());
+    if (entry == nullptr) {
+        return decision.result;
+    }
+
+    spdlog::info("policy_engine: block_pattern matched '{}', session={}, user='{}'",
+                 entry->source,
+                 session.session_id,
+                 session.db_user);
+    PolicyResult r{.action = PolicyAction::kBlock,
+                   .matched_rule = "block-pattern",
+                   .reason = fmt::format("SQL pattern blocked: {}", entry->source)};
+    if (config.sql_rules.mode != RuleMode::kMonitor) {
+        return r;
+    }
+    // monitor 모드: access_control 등 나머지 단계가 모두 통과한 경우에만 kLog.
+    // (no-access-rule 등 fail-close 경로가 반드시 먼저 확정되어야 함)
+    if (!decision.reached_allow) {
+        return decision.result;
+    }
+    r.action = PolicyAction::kLog;
+    r.monitor_mode = true;
+    r.reason = "[monitor] " + r.reason;
+    return r;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// PolicyEngine::evaluate 구현
+//
+// 평가 순서는 설계 명세(DON-26)를 준수한다.
+// 모든 예외는 catch 후 kBlock 반환 (fail-close).
+// ---------------------------------------------------------------------------
+PolicyResult PolicyEngine::evaluate(const ParsedQuery& query,
+                                    const SessionContext& session,
+                                    PolicyBinding* binding) const {
+    // Step 1: config_ nullptr 체크
+    const auto config = config_.load(std::memory_order_acquire);
+    if (!config) {
+        spdlog::error("policy_engine: config is null, blocking query (fail-close) session={}",
+                      session.session_id);
+        return PolicyResult{.action = PolicyAction::kBlock,
+                            .matched_rule = "no-config",
+                            .reason = "Policy config unavailable"};
     }
-    return PolicyResult{.action = PolicyAction::kAllow,
-                        .matched_rule = fmt::format("access-rule:{}", matched_rule->user),
-                        .reason = "Access allowed"};
+
+    return apply_block_patterns(
+        *config, evaluate_structural(*config, query, session, binding), query.raw_sql, session);
+}
+
+// ---------------------------------------------------------------------------
+// PolicyEngine::evaluate (판정 캐시 저장 오버로드)
+//
+// [세대 검사] 세대를 config 보다 먼저 읽고, 평가 후 세대가 그대로일 때만 저장한다.
+// reload() 는 config 교체 후 세대를 올리므로, 세대 g 로 읽은 config 는 항상 세대 g
+// 이상의 정책이다 — 이전 정책의 판정이 새 세대 키로 저장되지 않는다.
+// ---------------------------------------------------------------------------
+PolicyResult PolicyEngine::evaluate(const ParsedQuery& query,
+                                    const SessionContext& session,
+                                    std::string_view fingerprint,
+                                    PolicyBinding* binding) const {
+    const auto generation = config_generation_.load(std::memory_order_acquire);
+    const auto config = config_.load(std::memory_order_acquire);
+    if (!config) {
+        return evaluate(query, session);
+    }
+
+    const auto decision = evaluate_structural(*config, query, session, binding);
+    const auto result = apply_block_patterns(*config, decision, query.raw_sql, session);
+
+    // 숫자로만 된 테이블명 (또는 schema / 테이블 부분) 은 fingerprint 에서 '?' 로 정규화되어
+    // 다른 테이블과 구분되지 않는다 (archive.2023 / archive.2024 → archive.?)
+    const bool numeric_table = std::ranges::any_of(query.tables, has_numeric_name_part);
+
+    if (decision_cache_->capacity() > 0 && !decision.time_dependent && !numeric_table &&
+        fingerprint.size() <= DecisionCache::kMaxFingerprintBytes &&
+        config_generation_.load(std::memory_order_acquire) == generation) {
+        decision_cache_->insert(
+            DecisionCacheKey{.generation = generation,
+                             .db_user = session.db_user,
+                             .client_ip = session.client_ip,
+                             .fingerprint = std::string(fingerprint)},
+            std::make_shared<const CachedDecision>(
+                CachedDecision{.result = decision.result,
+                               .patterns_apply = decision.patterns_apply,
+                               .reached_allow = decision.reached_allow,
+                               .access_rule_index = decision.access_rule_index,
+                               .command = query.command,
+                               .tables = std::vector<std::string>(query.tables.begin(),
+                                                                  query.tables.end())}));
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// PolicyEngine::evaluate_prepared
+// ---------------------------------------------------------------------------
+PreparedVerdict PolicyEngine::evaluate_prepared(const ParsedQuery& query,
+                                                const SessionContext& session,
+                                                PolicyBinding* binding) const {
+    const auto generation = config_generation_.load(std::memory_order_acquire);
+    const auto config = config_.load(std::memory_order_acquire);
+    if (!config) {
+        return PreparedVerdict{.result = evaluate(query, session), .generation = generation};
+    }
+
+    const auto decision = evaluate_structural(*config, query, session, binding);
+    return PreparedVerdict{
+        .result = apply_block_patterns(*config, decision, query.raw_sql, session),
+        .generation = generation,
+        .time_dependent = decision.time_dependent};
+}
+
+// ---------------------------------------------------------------------------
+// PolicyEngine::bind
+// ---------------------------------------------------------------------------
+void PolicyEngine::bind(const SessionContext& session, PolicyBinding& binding) const {
+    const auto config = config_.load(std::memory_order_acquire);
+    if (!config) {
+        binding = PolicyBinding{.binds = binding.binds};
+        return;
+    }
+    (void)find_access_rule(access_index_for(*config), session, &binding);
+}
+
+// ---------------------------------------------------------------------------
+// PolicyEngine::evaluate_cached 구현
+//
+// 적중 시 block_patterns 는 현재 config 의 컴파일된 패턴으로 원문에 수행한다.
+// config 가 nullptr 이면 캐시를 보지 않는다 (호출자가 evaluate() 로 kBlock 확정).
+// ---------------------------------------------------------------------------
+std::optional<CachedEvaluation> PolicyEngine::evaluate_cached(std::string_view fingerprint,
+                                                              std::string_view raw_sql,
+                                                              const SessionContext& session) const {
+    if (decision_cache_->capacity() == 0 ||
+        fingerprint.size() > DecisionCache::kMaxFingerprintBytes) {
+        return std::nullopt;
+    }
+    const auto generation = config_generation_.load(std::memory_order_acquire);
+    const auto config = config_.load(std::memory_order_acquire);
+    if (!config) {
+        return std::nullopt;
+    }
+
+    const auto cached = decision_cache_->find(DecisionCacheKeyView{.generation = generation,
+                                                                   .db_user = session.db_user,
+                                                                   .client_ip = session.client_ip,
+                                                                   .fingerprint = fingerprint});
+    if (!cached) {
+        return std::nullopt;
+    }
+
+    if (config->rule_profile) {
+        // 평가 없이 재사용된 판정: 매칭 규칙의 hits 만 센다 (kNoAccessRule 은 무시됨)
+        config->rule_profile->record_access_rule_cached(cached->access_rule_index);
+    }
+
+    const StructuralDecision decision{.result = cached->result,
+                                      .patterns_apply = cached->patterns_apply,
+                                      .reached_allow = cached->reached_allow,
+                                      .time_dependent = false,
+                                      .access_rule_index = cached->access_rule_index};
+    return CachedEvaluation{.result = apply_block_patterns(*config, decision, raw_sql, session),
+                            .command = cached->command,
+                            .tables = cached->tables};
+}
+
+// ---------------------------------------------------------------------------
+// PolicyEngine::decision_cache_stats
+// ---------------------------------------------------------------------------
+PolicyEngine::DecisionCacheStats PolicyEngine::decision_cache_stats() const {
+    return DecisionCacheStats{.hits = decision_cache_->hits(),
+                              .misses = decision_cache_->misses(),
+                              .entries = decision_cache_->size(),
+                              .capacity = decision_cache_->capacity()};
+}
+
+// ---------------------------------------------------------------------------
+// PolicyEngine::rule_stats
+//   같은 config 스냅샷에서 규칙 이름과 카운터를 함께 읽어 인덱스 불일치가 없게 한다.
+// ---------------------------------------------------------------------------
+PolicyRuleStats PolicyEngine::rule_stats() const {
+    PolicyRuleStats stats{.version = current_version()};
+    const auto config = config_.load(std::memory_order_acquire);
+    if (!config || !config->rule_profile) {
+        return stats;
+    }
+    const auto& profile = *config->rule_profile;
+
+    stats.access_rules.reserve(config->access_control.size());
+    for (std::size_t i = 0; i < config->access_control.size(); ++i) {
+        const auto& rule = config->access_control[i];
+        stats.access_rules.push_back(
+            RuleStats{.index = i,
+                      .rule = fmt::format("{}@{}", rule.user, rule.source_ip_cidr),
+                      .cost = profile.access_rule(i)});
+    }
+    stats.block_patterns.reserve(config->sql_rules.block_patterns.size());
+    for (std::size_t i = 0; i < config->sql_rules.block_patterns.size(); ++i) {
+        stats.block_patterns.push_back(RuleStats{.index = i,
+                                                 .rule = config->sql_rules.block_patterns[i],
+                                                 .cost = profile.block_pattern(i)});
+    }
+    stats.no_access_rule = profile.no_access_rule();
+    return stats;
 }
 
 // ---------------------------------------------------------------------------
@@ -802,63 +1121,39 @@ ExplainResult PolicyEngine::explain(const ParsedQuery& query, const SessionConte
     }
     path += " > block_statements_passed";
 
-    // Step 4: SQL 패턴 차단 (block_patterns)
-    // [오탐 주의] ORM 생성 쿼리에서 false positive 발생 가능.
-    // [미탐 주의] 주석 분할(UN/**/ION)은 탐지 불가 (알려진 한계).
+    // Step 4: SQL 패턴 차단 (block_patterns) — evaluate() 와 같은 find_block_pattern 사용
     if (!sql_rules_monitor_hit.has_value()) {
-        for (const auto& pattern : config->sql_rules.block_patterns) {
-            try {
-                const std::regex re(pattern,
-                                    std::regex_constants::icase | std::regex_constants::ECMAScript);
-                if (std::regex_search(query.raw_sql, re)) {
-                    path += fmt::format(" > block_pattern({})", pattern);
-                    spdlog::debug(
-                        "policy_engine: explain: block_pattern matched '{}', session={}, user='{}'",
-                        pattern,
-                        session.session_id,
-                        session.db_user);
-                    ExplainResult r{.action = PolicyAction::kBlock,
-                                    .matched_rule = "block-pattern",
-                                    .reason = fmt::format("SQL pattern blocked: {}", pattern),
-                                    .matched_access_rule = "",
-                                    .evaluation_path = path};
-                    if (config->sql_rules.mode == RuleMode::kMonitor) {
-                        // monitor 모드: 즉시 반환하지 않고 access_control 평가 계속
-                        r.action = PolicyAction::kLog;
-                        r.monitor_mode = true;
-                        r.reason = "[monitor] " + r.reason;
-                        sql_rules_monitor_hit = r;
-                    } else {
-                        return r;
-                    }
-                    break;
-                }
-            } catch (const std::regex_error& e) {
-                // 잘못된 regex: 건너뜀 (false negative 증가, 로더에서 이미 경고)
-                spdlog::warn("policy_engine: explain: invalid block_pattern '{}', skipping: {}",
-                             pattern,
-                             e.what());
+        const auto compiled = compiled_patterns_for(*config);
+        if (const auto* entry = find_block_pattern(*compiled, query.raw_sql, nullptr)) {
+            path += fmt::format(" > block_pattern({})", entry->source);
+            spdlog::debug(
+                "policy_engine: explain: block_pattern matched '{}', session={}, user='{}'",
+                entry->source,
+                session.session_id,
+                session.db_user);
+            ExplainResult r{.action = PolicyAction::kBlock,
+                            .matched_rule = "block-pattern",
+                            .reason = fmt::format("SQL pattern blocked: {}", entry->source),
+                            .matched_access_rule = "",
+                            .evaluation_path = path};
+            if (config->sql_rules.mode != RuleMode::kMonitor) {
+                return r;
             }
+            // monitor 모드: 즉시 반환하지 않고 access_control 평가 계속
+            r.action = PolicyAction::kLog;
+            r.monitor_mode = true;
+            r.reason = "[monitor] " + r.reason;
+            sql_rules_monitor_hit = r;
         }
     }
     path += " > block_patterns_passed";
 
-    // Step 5: 사용자/IP 접근 제어 (access_control 룰 찾기)
+    // Step 5: 사용자/IP 접근 제어 (access_control 룰 찾기) — evaluate() 와 같은 인덱스 사용
     // [오탐 주의] user="*" 가 있는 룰이 앞에 있으면 특정 사용자 룰이 무시될 수 있다.
-    const AccessRule* matched_rule = nullptr;
-    for (const auto& rule : config->access_control) {
-        const bool user_match = (rule.user == session.db_user || rule.user == "*");
-        if (!user_match) {
-            continue;
-        }
-        if (!rule.source_ip_cidr.empty()) {
-            if (!ip_in_cidr(session.client_ip, rule.source_ip_cidr)) {
-                continue;
-            }
-        }
-        matched_rule = &rule;
-        break;
-    }
+    const auto access_index = access_index_for(*config);
+    const auto matched_index = access_index->find(session.db_user, session.client_ip);
+    const AccessRule* matched_rule =
+        matched_index.has_value() ? &config->access_control[*matched_index] : nullptr;
 
     if (matched_rule == nullptr) {
         path += " > no_access_rule";
@@ -904,8 +1199,8 @@ ExplainResult PolicyEngine::explain(const ParsedQuery& query, const SessionConte
     // Step 7: 시간대 제한 체크 (time_restriction)
     if (matched_rule->time_restriction.has_value()) {
         const auto& tr = matched_rule->time_restriction.value();
-        const auto range = parse_time_range(tr.allow_range);
-        if (!range.has_value()) {
+        const auto& window = access_index->rules[*matched_index].time_window;
+        if (!window.has_value() || !window->valid) {
             // allow_range 파싱 실패 → fail-close (차단)
             path += " > time_restriction_config_error";
             spdlog::debug(
@@ -923,7 +1218,7 @@ ExplainResult PolicyEngine::explain(const ParsedQuery& query, const SessionConte
                     .evaluation_path = path},
                 matched_rule->mode);
         }
-        if (!is_within_time_range(range.value(), tr.timezone)) {
+        if (!window->allows(std::chrono::system_clock::now())) {
             path += fmt::format(
                 " > time_restriction_denied(allow_range={},tz={})", tr.allow_range, tr.timezone);
             spdlog::debug(
@@ -1025,7 +1320,8 @@ ExplainResult PolicyEngine::explain(const ParsedQuery& query, const SessionConte
                     matched_rule->mode);
             }
         } else if (query.command == SqlCommand::kCall) {
-            const std::string proc_name = query.tables.empty() ? "" : query.tables.front();
+            const std::string_view proc_name =
+                query.tables.empty() ? std::string_view{} : query.tables.front();
 
             if (pc.mode == "whitelist") {
                 const bool in_whitelist = std::ranges::any_of(
@@ -1103,8 +1399,8 @@ ExplainResult PolicyEngine::explain(const ParsedQuery& query, const SessionConte
             "information_schema", "mysql", "performance_schema", "sys"};
         for (const auto& table : query.tables) {
             const auto dot_pos = table.find('.');
-            const std::string schema_part =
-                (dot_pos != std::string::npos) ? table.substr(0, dot_pos) : table;
+            const std::string_view schema_part =
+                (dot_pos != std::string_view::npos) ? table.substr(0, dot_pos) : table;
 
             for (const auto& schema : schema_names) {
                 if (iequals(schema_part, schema)) {
@@ -1233,12 +1529,18 @@ void PolicyEngine::reload(std::shared_ptr<PolicyConfig> new_config) {
     } else {
         spdlog::info("policy_engine: reloading config with {} access rules",
                      new_config->access_control.size());
+        // 게시 전 1회 컴파일 (로더가 이미 컴파일했다면 재사용, 바뀌지 않은 부분은 현재
+        // 게시된 config 의 결과를 재사용). reload 는 관리 경로에서 직렬로 호출된다.
+        const auto live = config_.load(std::memory_order_acquire);
+        ensure_compiled_patterns(*new_config, live.get());
     }
     // config_ 는 std::atomic<std::shared_ptr<PolicyConfig>> (C++20) 이다.
     // store() 로 원자적으로 교체한다.
     // std::memory_order_release 를 사용하여 이 store 이전의 메모리 쓰기가
     // evaluate() 의 load(acquire) 이후에 보이도록 보장한다.
     config_.store(std::move(new_config), std::memory_order_release);
+    // 판정 캐시 무효화: 세대는 config 교체 이후에 올린다 (evaluate 세대 검사 참조).
+    config_generation_.fetch_add(1, std::memory_order_acq_rel);
     // 버전 없는 reload 는 version=0 으로 리셋 (하위 호환).
     current_version_.store(0, std::memory_order_release);
 }
@@ -1274,3 +1576,44 @@ void PolicyEngine::reload(std::shared_ptr<PolicyConfig> new_config, std::uint64_
 std::uint64_t PolicyEngine::current_version() const noexcept {
     return current_version_.load(std::memory_order_acquire);
 }
+
+// ---------------------------------------------------------------------------
+// PolicyEngine::generation
+// ---------------------------------------------------------------------------
+std::uint64_t PolicyEngine::generation() const noexcept {
+    return config_generation_.load(std::memory_order_acquire);
+}
+
+// ---------------------------------------------------------------------------
+// PolicyEngine::current_config
+// ---------------------------------------------------------------------------
+std::shared_ptr<const PolicyConfig> PolicyEngine::current_config() const noexcept {
+    return config_.load(std::memory_order_acquire);
+}
+
+// ---------------------------------------------------------------------------
+// PolicyEngine::injection_detector
+//
+// 현재 config 스냅샷에 묶인 detector 를 반환한다. reload() 로 config 가 교체되면
+// 새 detector 가 함께 교체되고, 이전 detector 는 사용 중인 세션이 놓을 때 해제된다.
+// ---------------------------------------------------------------------------
+std::shared_ptr<const InjectionDetector> PolicyEngine::injection_detector() const noexcept {
+    const auto config = config_.load(std::memory_order_acquire);
+    if (!config) {
+        return nullptr;
+    }
+    return config->sql_rules.injection_detector;
+}
+
+// ---------------------------------------------------------------------------
+// PolicyEngine::result_row_limit
+// ---------------------------------------------------------------------------
+PolicyEngine::ResultRowLimit PolicyEngine::result_row_limit() const noexcept {
+    const auto config = config_.load(std::memory_order_acquire);
+    if (!config) {
+        return ResultRowLimit{};
+    }
+    return ResultRowLimit{
+        .max_rows = config->data_protection.max_result_rows,
+        .truncate = config->data_protection.max_result_rows_action == "truncate"};
+}
@@ -31,11 +31,18 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "common/types.hpp"       // SessionContext, ParseError
-#include "parser/sql_parser.hpp"  // ParsedQuery
-#include "rule.hpp"               // PolicyConfig
+#include "parser/sql_parser.hpp"   // ParsedQuery
+#include "policy/rule_profile.hpp"  // PolicyRuleStats
+#include "rule.hpp"                 // PolicyConfig
+
+class DecisionCache;  // policy/decision_cache.hpp (단방향 의존 유지를 위해 전방 선언)
+struct CompiledAccessIndex;  // policy/access_index.hpp
 
 // ---------------------------------------------------------------------------
 // PolicyAction
@@ -48,6 +55,21 @@ enum class PolicyAction : std::uint8_t {
     kLog = 2,    // 허용 + 감사 로그 (경보)
 };
 
+// ---------------------------------------------------------------------------
+// QueryLogDirective
+//   허용된 쿼리의 QueryLog 기록 지시 (GlobalConfig::query_log + AccessRule 에서 해석).
+//   sample_rate:        기록 비율 [0.0, 1.0]
+//   session_rate_limit: 세션당 초당 QueryLog 상한 (0 = 제한 없음)
+//   session_burst:      token bucket 용량 (0 = session_rate_limit)
+//
+//   kAllow 결과에만 의미가 있다. kBlock / kLog(monitor) 는 항상 기록된다.
+// ---------------------------------------------------------------------------
+struct QueryLogDirective {
+    double sample_rate{1.0};
+    std::uint32_t session_rate_limit{0};
+    std::uint32_t session_burst{0};
+};
+
 // ---------------------------------------------------------------------------
 // PolicyResult
 //   정책 평가 결과.
@@ -61,6 +83,7 @@ struct PolicyResult {
     std::string matched_rule{};                 // 매칭된 규칙 식별자
     std::string reason{};                       // 판정 이유 (감사 로그용)
     bool monitor_mode{false};  // true: monitor 모드에 의해 kBlock→kLog 다운그레이드됨
+    QueryLogDirective query_log{};  // 허용 시 QueryLog 샘플링/rate limit 지시
 };
 
 // ---------------------------------------------------------------------------
@@ -88,6 +111,50 @@ struct ExplainResult {
     bool monitor_mode{false};  // true: monitor 모드에 의해 kBlock→kLog 다운그레이드됨
 };
 
+// ---------------------------------------------------------------------------
+// CachedEvaluation
+//   evaluate_cached() 적중 결과.
+//   result : block_patterns 까지 원문에 수행하여 결합한 최종 판정 (evaluate() 와 동일)
+//   command / tables : 캐시 당시 파서 결과 (같은 fingerprint 이면 동일) — 감사 로그용
+// ---------------------------------------------------------------------------
+struct CachedEvaluation {
+    PolicyResult result{};
+    SqlCommand command{SqlCommand::kUnknown};
+    std::vector<std::string> tables{};
+};
+
+// ---------------------------------------------------------------------------
+// PreparedVerdict
+//   evaluate_prepared() 결과. prepared statement 의 판정을 EXECUTE 마다 재사용하기 위한 것.
+//   result        : evaluate() 와 동일한 최종 판정 (block_patterns 는 PREPARE 원문에 수행)
+//   generation    : 평가 전에 읽은 정책 세대 (현재 세대와 다르면 재평가)
+//   time_dependent: time_restriction 평가를 거침 → 시각에 따라 달라지므로 매번 재평가
+// ---------------------------------------------------------------------------
+struct PreparedVerdict {
+    PolicyResult result{};
+    std::uint64_t generation{0};
+    bool time_dependent{false};
+};
+
+// ---------------------------------------------------------------------------
+// PolicyBinding
+//   세션별 access rule 바인딩. db_user / client_ip 는 핸드셰이크 후 고정이므로
+//   Step 5 (user/IP 매칭) 결과는 정책 스냅샷이 같은 동안 쿼리마다 같다.
+//   evaluate(..., &binding) 은 바인딩된 스냅샷(access_index)이 현재 스냅샷과 같으면
+//   매칭을 생략하고 저장된 룰을 사용한다. reload() 로 스냅샷이 바뀌면 다음 평가에서
+//   다시 매칭한다 (lazy). first-match 규칙상 (user, IP) 에 적용 가능한 룰은 하나뿐이다.
+//
+//   [fail-close] 바인딩 당시와 user/IP 가 다르면 재사용하지 않고 다시 매칭한다.
+//   [스레드 안전성] 한 세션(코루틴) 전용. 세션 간/스레드 간 공유 금지.
+// ---------------------------------------------------------------------------
+struct PolicyBinding {
+    std::shared_ptr<const CompiledAccessIndex> index{};  // 바인딩 당시 스냅샷 (nullptr = 미바인딩)
+    std::string db_user{};
+    std::string client_ip{};
+    std::optional<std::size_t> access_rule{};  // 매칭 룰 인덱스 (nullopt = no-access-rule)
+    std::uint64_t binds{0};                    // 매칭 수행 횟수 (관측/테스트용)
+};
+
 // ---------------------------------------------------------------------------
 // PolicyEngine
 //   정책 설정을 기반으로 쿼리 허용/차단을 판정한다.
@@ -102,7 +169,7 @@ public:
     // config 가 nullptr 이면 모든 evaluate() 가 kBlock 을 반환한다 (fail-close).
     explicit PolicyEngine(std::shared_ptr<PolicyConfig> config);
 
-    ~PolicyEngine() = default;
+    ~PolicyEngine();
 
     // 복사/이동 금지:
     // atomic<shared_ptr<...>> 멤버는 복사/이동 연산이 삭제되어 있으므로
@@ -128,8 +195,51 @@ public:
     //   [오탐 주의]
     //   access_control 의 user 필드가 "*" 와일드카드일 때 모든 사용자에게
     //   적용되므로, 규칙 순서와 우선순위를 config 에서 명확히 정의해야 한다.
+    //
+    //   binding: 세션의 PolicyBinding. 주어지면 Step 5 매칭을 스냅샷당 1회로 줄인다.
     [[nodiscard]] PolicyResult evaluate(const ParsedQuery& query,
-                                        const SessionContext& session) const;
+                                        const SessionContext& session,
+                                        PolicyBinding* binding = nullptr) const;
+
+    // evaluate (판정 캐시 저장 오버로드)
+    //   evaluate(query, session) 과 같은 결과를 반환하고, 리터럴 비의존 판정을
+    //   (fingerprint, db_user, client_ip, 정책 세대) 키로 판정 캐시에 저장한다.
+    //   time_restriction 을 거친 판정, 숫자로만 된 테이블명 (schema.2023 처럼 '.' 구분 부분
+    //   포함) 등 fingerprint 로 구분되지 않는 결과는 저장하지 않는다.
+    [[nodiscard]] PolicyResult evaluate(const ParsedQuery& query,
+                                        const SessionContext& session,
+                                        std::string_view fingerprint,
+                                        PolicyBinding* binding = nullptr) const;
+
+    // bind
+    //   세션의 user/IP 를 현재 정책 스냅샷의 access rule 에 바인딩한다 (핸드셰이크 직후 호출).
+    //   이후 evaluate(..., &binding) 은 스냅샷이 바뀌기 전까지 Step 5 매칭을 생략한다.
+    //   config 가 nullptr 이면 binding 을 비운다 (evaluate() 가 kBlock).
+    void bind(const SessionContext& session, PolicyBinding& binding) const;
+
+    // evaluate_cached
+    //   판정 캐시 조회. 적중하면 파싱·리터럴 비의존 단계를 생략하고 block_patterns 만
+    //   raw_sql 원문에 수행하여 최종 판정을 반환한다. 미적중/캐시 비활성이면 std::nullopt
+    //   (호출자는 파싱 후 evaluate(query, session, fingerprint) 로 진행).
+    //
+    //   [무효화] reload() 마다 정책 세대가 증가하므로 이전 정책의 판정은 적중하지 않는다.
+    [[nodiscard]] std::optional<CachedEvaluation> evaluate_cached(
+        std::string_view fingerprint,
+        std::string_view raw_sql,
+        const SessionContext& session) const;
+
+    // evaluate_prepared
+    //   COM_STMT_PREPARE 문의 판정. evaluate(query, session, binding) 과 같은 결과에
+    //   평가 당시 정책 세대와 time_restriction 경유 여부를 붙여 반환한다.
+    //   세대는 config 보다 먼저 읽으므로 평가 중 reload() 가 끼어들면 이전 세대로 기록되어
+    //   다음 EXECUTE 에서 재평가된다 (fail-close).
+    [[nodiscard]] PreparedVerdict evaluate_prepared(const ParsedQuery& query,
+                                                    const SessionContext& session,
+                                                    PolicyBinding* binding = nullptr) const;
+
+    // generation
+    //   reload() 마다 1 증가하는 정책 세대. 저장된 판정(PreparedVerdict 등)의 무효화 기준.
+    [[nodiscard]] std::uint64_t generation() const noexcept;
 
     // evaluate_error
     //   파서 오류 발생 시 호출. 반드시 PolicyAction::kBlock 을 반환한다.
@@ -187,6 +297,45 @@ public:
     //   PolicyVersionStore 로 저장 없이 reload() 만 호출된 경우에도 0 을 반환한다.
     [[nodiscard]] std::uint64_t current_version() const noexcept;
 
+    // current_config
+    //   현재 게시된 정책 스냅샷 (읽기 전용, 없으면 nullptr).
+    //   reload 경로가 PolicyLoader::load(path, previous) 에 넘겨 바뀌지 않은 패턴을 재사용한다.
+    [[nodiscard]] std::shared_ptr<const PolicyConfig> current_config() const noexcept;
+
+    // injection_detector
+    //   현재 정책 스냅샷의 공유 InjectionDetector 를 반환한다.
+    //   reload() 마다 기본 패턴 + 새 block_patterns 로 1회 컴파일되며 (block_patterns 가
+    //   바뀌지 않았으면 이전 detector 를 그대로 공유),
+    //   세션은 쿼리마다 이 포인터를 얻어 사용한다 (세션별 정규식 컴파일 없음).
+    //   config 가 nullptr 이면 nullptr 을 반환한다 (이 경우 evaluate() 가 이미 kBlock).
+    [[nodiscard]] std::shared_ptr<const InjectionDetector> injection_detector() const noexcept;
+
+    // result_row_limit
+    //   현재 정책의 data_protection.max_result_rows 와 초과 시 처리 방식.
+    //   세션의 응답 릴레이가 결과 셋 응답마다 읽어 row 수 한도를 적용한다.
+    //   config 가 nullptr 이면 제한 없음 (이 경우 evaluate() 가 이미 kBlock).
+    struct ResultRowLimit {
+        std::uint32_t max_rows{0};  // 0 = 제한 없음
+        bool truncate{false};       // true: 한도에서 EOF 로 정상 종료, false: ERR
+    };
+    [[nodiscard]] ResultRowLimit result_row_limit() const noexcept;
+
+    // decision_cache_stats
+    //   판정 캐시 적중/미적중 누계와 현재 엔트리 수 (관측용).
+    struct DecisionCacheStats {
+        std::uint64_t hits{0};
+        std::uint64_t misses{0};
+        std::size_t entries{0};
+        std::size_t capacity{0};
+    };
+    [[nodiscard]] DecisionCacheStats decision_cache_stats() const;
+
+    // rule_stats
+    //   현재 정책 스냅샷의 규칙별 적중 수 / 누적 평가 시간 (UDS policy_stats).
+    //   인덱스는 access_control / block_patterns 위치이며 reload() 마다 0 부터 다시 센다.
+    //   config 가 nullptr 이면 빈 결과.
+    [[nodiscard]] PolicyRuleStats rule_stats() const;
+
 private:
     // std::atomic<std::shared_ptr<PolicyConfig>> (C++20)
     // reload() 와 evaluate() 가 동시에 실행되는 경우에도 data race 없이
@@ -204,4 +353,13 @@ private:
     // reload(config, version) 호출 시 갱신, reload(config) 호출 시 0 으로 리셋.
     // atomic 으로 스레드 안전 읽기/쓰기를 보장한다.
     std::atomic<std::uint64_t> current_version_{0};
+
+    // config_generation_: reload() 마다 1 증가하는 정책 세대.
+    // current_version_ 은 버전 없는 reload 시 0 으로 돌아가므로 캐시 키로 쓸 수 없다.
+    // 세대는 config_ 교체 이후에 증가시키고, 캐시 저장 측은 평가 전후 세대가 같을 때만
+    // 저장하여 이전 config 의 판정이 새 세대 키로 들어가지 않게 한다.
+    std::atomic<std::uint64_t> config_generation_{0};
+
+    // decision_cache_: fingerprint 판정 캐시. 용량은 생성 시 global.decision_cache_entries.
+    std::unique_ptr<DecisionCache> decision_cache_;
 };
@@ -14,7 +14,7 @@
 // - connection_timeout YAML 키: "30s" 형태의 숫자+단위 문자열에서 숫자만 추출.
 //   단위가 "s"(초) 외의 값이면 파싱을 건너뛰고 기본값(30)을 적용한다.
 // - CIDR 표기법: 문자열 그대로 source_ip_cidr 멤버에 저장.
-//   유효성 검사는 PolicyEngine::ip_in_cidr 에서 수행된다.
+//   유효성 검사는 PolicyEngine 생성/reload 시 compile_access_index 에서 수행된다.
 // - time_restriction.allow YAML 키 → allow_range 멤버 매핑.
 //
 // [fail-close 연계 — block_patterns 최소 1개 검증]
@@ -35,10 +35,13 @@
 #include <yaml-cpp/yaml.h>
 
 #include <algorithm>
+#include <cctype>
 #include <charconv>
 #include <filesystem>
-#include <regex>
 #include <string>
+#include <string_view>
+
+#include "policy/compiled_patterns.hpp"
 
 // ---------------------------------------------------------------------------
 // 내부 헬퍼: connection_timeout 문자열("30s")에서 정수(30)를 추출.
@@ -67,24 +70,21 @@ namespace {
 }
 
 // ---------------------------------------------------------------------------
-// 내부 헬퍼: regex 패턴이 유효한지 사전 검증하고 경고 로그를 출력한다.
-// PolicyEngine에서도 건너뛰므로 중복 경고가 발생할 수 있으나,
-// 로드 시점 조기 감지가 더 중요하다 (false negative 조기 경보).
-// ---------------------------------------------------------------------------
-void validate_block_patterns(const std::vector<std::string>& patterns) {
-    for (const auto& p : patterns) {
-        try {
-            const std::regex re(p, std::regex_constants::icase | std::regex_constants::ECMAScript);
-            (void)re;  // 컴파일만 확인
-        } catch (const std::regex_error& e) {
-            // [오탐/미탐 경보] 잘못된 패턴은 PolicyEngine에서 건너뛰므로
-            // 해당 패턴의 탐지가 누락된다 (false negative 증가).
-            spdlog::warn(
-                "policy_loader: block_pattern '{}' is invalid regex and will be skipped by "
-                "PolicyEngine — false negative risk: {}",
-                p,
-                e.what());
-        }
+// 내부 헬퍼: block_patterns 를 사전 컴파일하고, 잘못된 패턴에 대해 경고 로그를 출력한다.
+// 컴파일 결과는 SqlRule::compiled_patterns 에 보관되어 PolicyEngine 이 그대로
+// 재사용하므로 경고는 로드 시점에 1회만 발생한다 (false negative 조기 경보).
+// previous 가 있으면 원본이 같은 패턴은 이전 컴파일 결과를 재사용한다 (reload 증분 컴파일).
+// ---------------------------------------------------------------------------
+void compile_and_validate_block_patterns(SqlRule& rules, const CompiledBlockPatterns* previous) {
+    rules.compiled_patterns = compile_block_patterns(rules.block_patterns, previous);
+    for (const auto& invalid : rules.compiled_patterns->invalid) {
+        // [오탐/미탐 경보] 잘못된 패턴은 PolicyEngine에서 건너뛰므로
+        // 해당 패턴의 탐지가 누락된다 (false negative 증가).
+        spdlog::warn(
+            "policy_loader: block_pattern '{}' is invalid regex and will be skipped by "
+            "PolicyEngine — false negative risk: {}",
+            invalid.source,
+            invalid.error);
     }
 }
 
@@ -148,6 +148,69 @@ void validate_block_patterns(const std::vector<std::string>& patterns) {
     }
 }
 
+// ---------------------------------------------------------------------------
+// 내부 헬퍼: YAML 노드에서 로그 샘플링 비율 [0.0, 1.0] 을 읽는다.
+// 없으면 std::nullopt. 숫자가 아니면 경고 후 1.0 (전부 기록 — 감사 누락 방지),
+// 범위를 벗어나면 경고 후 [0.0, 1.0] 으로 clamp 한다.
+// ---------------------------------------------------------------------------
+[[nodiscard]] std::optional<double> read_sample_rate(const YAML::Node& node,
+                                                     std::string_view key) {
+    if (!node || node.IsNull()) {
+        return std::nullopt;
+    }
+    double rate = 1.0;
+    try {
+        rate = node.as<double>();
+    } catch (const YAML::Exception&) {
+        spdlog::warn("policy_loader: {} is not a number, using 1.0 (log everything)", key);
+        return 1.0;
+    }
+    if (!(rate >= 0.0 && rate <= 1.0)) {
+        const double clamped = rate > 1.0 ? 1.0 : 0.0;
+        spdlog::warn("policy_loader: {} {} out of range [0, 1], using {}", key, rate, clamped);
+        return clamped;
+    }
+    return rate;
+}
+
+// ---------------------------------------------------------------------------
+// 내부 헬퍼: QueryLogSampling 파싱
+// query_log YAML:
+//   sample_rate: 1.0
+//   command_sample_rates: { SELECT: 0.01 }
+//   session_rate_limit: 100
+//   session_burst: 200
+// ---------------------------------------------------------------------------
+[[nodiscard]] QueryLogSampling parse_query_log(const YAML::Node& ql_node) {
+    QueryLogSampling ql{};
+    if (!ql_node || !ql_node.IsMap()) {
+        return ql;
+    }
+
+    ql.sample_rate = read_sample_rate(ql_node["sample_rate"], "query_log.sample_rate")
+                         .value_or(ql.sample_rate);
+
+    const auto& cmd_node = ql_node["command_sample_rates"];
+    if (cmd_node && cmd_node.IsMap()) {
+        for (const auto& item : cmd_node) {
+            if (!item.first.IsScalar()) {
+                continue;
+            }
+            auto command = item.first.as<std::string>();
+            std::transform(command.begin(), command.end(), command.begin(), [](unsigned char c) {
+                return static_cast<char>(std::toupper(c));
+            });
+            const auto rate = read_sample_rate(item.second, "query_log.command_sample_rates");
+            ql.command_sample_rates.push_back(
+                CommandSampleRate{.command = std::move(command), .rate = rate.value_or(1.0)});
+        }
+    }
+
+    ql.session_rate_limit = read_uint32(ql_node["session_rate_limit"], ql.session_rate_limit);
+    ql.session_burst = read_uint32(ql_node["session_burst"], ql.session_burst);
+    return ql;
+}
+
 // ---------------------------------------------------------------------------
 // 내부 헬퍼: YAML 노드에서 RuleMode 를 파싱한다.
 //
@@ -179,6 +242,8 @@ void validate_block_patterns(const std::vector<std::string>& patterns) {
     cfg.log_level = read_string(global_node["log_level"], cfg.log_level);
     cfg.log_format = read_string(global_node["log_format"], cfg.log_format);
     cfg.max_connections = read_uint32(global_node["max_connections"], cfg.max_connections);
+    cfg.decision_cache_entries =
+        read_uint32(global_node["decision_cache_entries"], cfg.decision_cache_entries);
 
     // connection_timeout: "30s" → 30 (숫자만 추출)
     if (global_node["connection_timeout"] && global_node["connection_timeout"].IsScalar()) {
@@ -186,6 +251,8 @@ void validate_block_patterns(const std::vector<std::string>& patterns) {
         cfg.connection_timeout_sec = parse_timeout_str(raw, cfg.connection_timeout_sec);
     }
 
+    cfg.query_log = parse_query_log(global_node["query_log"]);
+
     return cfg;
 }
 
@@ -244,6 +311,9 @@ void validate_block_patterns(const std::vector<std::string>& patterns) {
     // mode 파싱 (없거나 알 수 없는 값 → kEnforce, fail-close)
     rule.mode = parse_rule_mode(rule_node["mode"]);
 
+    // log_sample_rate: 이 룰로 허용된 쿼리의 로그 샘플링 비율 (없으면 global.query_log)
+    rule.log_sample_rate = read_sample_rate(rule_node["log_sample_rate"], "log_sample_rate");
+
     return rule;
 }
 
@@ -301,8 +371,19 @@ void validate_block_patterns(const std::vector<std::string>& patterns) {
     }
 
     dp.max_result_rows = read_uint32(dp_node["max_result_rows"], dp.max_result_rows);
+    dp.max_result_rows_action =
+        read_string(dp_node["max_result_rows_action"], dp.max_result_rows_action);
     dp.block_schema_access = read_bool(dp_node["block_schema_access"], dp.block_schema_access);
 
+    // max_result_rows_action 유효성 검사 (알 수 없는 값은 잘린 결과를 ERR 로 알리는 쪽으로)
+    if (dp.max_result_rows_action != "error" && dp.max_result_rows_action != "truncate") {
+        spdlog::warn(
+            "policy_loader: data_protection.max_result_rows_action '{}' is not 'error' or "
+            "'truncate', defaulting to 'error'",
+            dp.max_result_rows_action);
+        dp.max_result_rows_action = "error";
+    }
+
     return dp;
 }
 
@@ -312,7 +393,7 @@ void validate_block_patterns(const std::vector<std::string>& patterns) {
 // PolicyLoader::load 구현
 // ---------------------------------------------------------------------------
 std::expected<PolicyConfig, std::string> PolicyLoader::load(
-    const std::filesystem::path& config_path) {
+    const std::filesystem::path& config_path, const PolicyConfig* previous) {
     // 1. 경로 정규화 (path traversal 방지 목적)
     std::error_code ec;
     const auto canonical_path = std::filesystem::canonical(config_path, ec);
@@ -428,8 +509,9 @@ std::expected<PolicyConfig, std::string> PolicyLoader::load(
         return std::unexpected(err);
     }
 
-    // 5. block_patterns 유효성 사전 검증 (오류 경고만 — 파싱 실패 아님)
-    validate_block_patterns(cfg.sql_rules.block_patterns);
+    // 5. block_patterns 사전 컴파일 + 유효성 검증 (오류 경고만 — 파싱 실패 아님)
+    compile_and_validate_block_patterns(
+        cfg.sql_rules, previous != nullptr ? previous->sql_rules.compiled_patterns.get() : nullptr);
 
     // monitor モード 룰 집계 (운영자 감사 목적)
     // static_cast: std::count_if 반환형이 ptrdiff_t(부호 있음)이므로 명시적 변환
@@ -69,8 +69,13 @@ public:
     //   policy.yaml 의 regex 패턴이 잘못 작성되면 InjectionDetector 초기화
     //   시 패턴이 무시되어 false negative 가 발생한다. 로드 시 패턴 검증
     //   경고를 로그에 출력하도록 구현 레이어에서 처리할 것.
+    //
+    //   [증분 컴파일]
+    //   previous: 현재 게시된 정책 (reload 시, nullptr 허용). block_patterns 중 previous 와
+    //   원본이 같은 패턴은 컴파일된 regex 를 재사용하고 바뀐 패턴만 컴파일한다.
+    //   previous 는 load 동안에만 참조한다.
     [[nodiscard]] static std::expected<PolicyConfig, std::string>
-    load(const std::filesystem::path& config_path);
+    load(const std::filesystem::path& config_path, const PolicyConfig* previous = nullptr);
 
     // watch (Phase 4 — 선택사항)
     //   config_path 파일의 변경을 비동기로 감시하고, 변경 감지 + 파싱 성공
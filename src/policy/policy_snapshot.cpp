@@ -0,0 +1,373 @@
+// ---------------------------------------------------------------------------
+// policy_snapshot.cpp
+//
+// PolicyConfig 바이너리 스냅샷 인코딩/디코딩.
+//
+// Writer 는 본문을 쓰면서 문자열을 인터닝하고(config 가 encode 동안 살아 있으므로
+// string_view 키), 마지막에 헤더 + 문자열 테이블 + 본문을 이어 붙인다.
+// Reader 는 첫 오류를 기억하고 이후 읽기는 0/빈 값을 돌려준다. 호출자는 섹션 단위가 아니라
+// 끝에서 한 번 ok() 를 확인한다 (검증 분기를 필드마다 반복하지 않기 위함).
+// ---------------------------------------------------------------------------
+
+#include "policy/policy_snapshot.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <bit>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace policy_snapshot {
+namespace {
+
+constexpr std::uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+
+[[nodiscard]] std::uint64_t fnv1a(std::span<const std::uint8_t> data) noexcept {
+    std::uint64_t h = kFnvOffset;
+    for (const std::uint8_t b : data) {
+        h ^= b;
+        h *= kFnvPrime;
+    }
+    return h;
+}
+
+[[nodiscard]] std::span<const std::uint8_t> as_bytes(std::string_view s) noexcept {
+    return {reinterpret_cast<const std::uint8_t*>(s.data()), s.size()};
+}
+
+template <typename T>
+void put_le(std::string& out, T value) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<char>((static_cast<std::uint64_t>(value) >> (8U * i)) & 0xFFU));
+    }
+}
+
+template <typename T>
+[[nodiscard]] T get_le(const std::uint8_t* p) noexcept {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<std::uint64_t>(p[i]) << (8U * i);
+    }
+    return static_cast<T>(value);
+}
+
+// ---------------------------------------------------------------------------
+// Writer
+// ---------------------------------------------------------------------------
+class Writer {
+public:
+    void u8(std::uint8_t v) { put_le(body_, v); }
+    void u32(std::uint32_t v) { put_le(body_, v); }
+    void flag(bool v) { u8(v ? 1U : 0U); }
+    void f64(double v) { put_le(body_, std::bit_cast<std::uint64_t>(v)); }
+    void str(std::string_view s) { u32(intern(s)); }
+
+    void strings(const std::vector<std::string>& list) {
+        u32(static_cast<std::uint32_t>(list.size()));
+        for (const auto& s : list) {
+            str(s);
+        }
+    }
+
+    [[nodiscard]] std::string finish(std::uint32_t rules_count, std::string_view source_hash) {
+        std::string payload;
+        put_le(payload, static_cast<std::uint32_t>(table_.size()));
+        for (const auto s : table_) {
+            put_le(payload, static_cast<std::uint32_t>(s.size()));
+            payload.append(s);
+        }
+        payload.append(body_);
+
+        std::string out;
+        out.reserve(kHeaderSize + payload.size());
+        out.append(kMagic);
+        put_le(out, kVersion);
+        put_le(out, std::uint16_t{0});
+        put_le(out, rules_count);
+        put_le(out, static_cast<std::uint32_t>(kHeaderSize));
+        put_le(out, static_cast<std::uint64_t>(payload.size()));
+        put_le(out, fnv1a(as_bytes(payload)));
+        std::string hash{source_hash.substr(0, kHashLength)};
+        hash.resize(kHashLength, '\0');
+        out.append(hash);
+        out.append(payload);
+        return out;
+    }
+
+private:
+    std::uint32_t intern(std::string_view s) {
+        const auto [it, inserted] = ids_.try_emplace(s, static_cast<std::uint32_t>(table_.size()));
+        if (inserted) {
+            table_.push_back(s);
+        }
+        return it->second;
+    }
+
+    std::unordered_map<std::string_view, std::uint32_t> ids_{};
+    std::vector<std::string_view> table_{};
+    std::string body_{};
+};
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+class Reader {
+public:
+    explicit Reader(std::span<const std::uint8_t> in) noexcept : in_{in} {}
+
+    [[nodiscard]] bool ok() const noexcept { return error_.empty(); }
+    [[nodiscard]] const std::string& error() const noexcept { return error_; }
+    [[nodiscard]] bool at_end() const noexcept { return pos_ == in_.size(); }
+
+    void fail(std::string message) {
+        if (error_.empty()) {
+            error_ = std::move(message);
+        }
+    }
+
+    std::uint8_t u8() { return fixed<std::uint8_t>(); }
+    std::uint32_t u32() { return fixed<std::uint32_t>(); }
+    bool flag() { return u8() != 0; }
+    double f64() { return std::bit_cast<double>(fixed<std::uint64_t>()); }
+
+    // count: 원소마다 최소 min_size 바이트가 남아 있어야 한다 (손상된 개수로 과대 할당 방지)
+    std::uint32_t count(std::size_t min_size) {
+        const auto n = u32();
+        if (static_cast<std::uint64_t>(n) * min_size > in_.size() - pos_) {
+            fail("list count exceeds snapshot size");
+            return 0;
+        }
+        return n;
+    }
+
+    bool read_table() {
+        const auto n = count(sizeof(std::uint32_t));
+        table_.reserve(n);
+        for (std::uint32_t i = 0; i < n && ok(); ++i) {
+            const auto len = u32();
+            const auto* p = take(len);
+            if (p != nullptr) {
+                table_.emplace_back(reinterpret_cast<const char*>(p), len);
+            }
+        }
+        return ok();
+    }
+
+    std::string str() {
+        const auto id = u32();
+        if (id >= table_.size()) {
+            fail(fmt::format("string index {} out of range", id));
+            return {};
+        }
+        return std::string{table_[id]};
+    }
+
+    std::vector<std::string> strings() {
+        std::vector<std::string> out(count(sizeof(std::uint32_t)));
+        for (auto& s : out) {
+            s = str();
+        }
+        return out;
+    }
+
+    RuleMode mode() {
+        const auto v = u8();
+        if (v > static_cast<std::uint8_t>(RuleMode::kMonitor)) {
+            fail(fmt::format("invalid rule mode {}", v));
+            return RuleMode::kEnforce;
+        }
+        return static_cast<RuleMode>(v);
+    }
+
+private:
+    const std::uint8_t* take(std::size_t n) {
+        if (!ok() || n > in_.size() - pos_) {
+            fail("truncated snapshot payload");
+            return nullptr;
+        }
+        const auto* p = in_.data() + pos_;
+        pos_ += n;
+        return p;
+    }
+
+    template <typename T>
+    T fixed() {
+        const auto* p = take(sizeof(T));
+        return p == nullptr ? T{} : get_le<T>(p);
+    }
+
+    std::span<const std::uint8_t> in_;
+    std::size_t pos_{0};
+    std::vector<std::string_view> table_{};
+    std::string error_{};
+};
+
+}  // namespace
+
+std::string encode(const PolicyConfig& config, std::string_view source_hash) {
+    Writer w;
+
+    const auto& g = config.global;
+    w.str(g.log_level);
+    w.str(g.log_format);
+    w.u32(g.max_connections);
+    w.u32(g.connection_timeout_sec);
+    w.u32(g.decision_cache_entries);
+    w.f64(g.query_log.sample_rate);
+    w.u32(static_cast<std::uint32_t>(g.query_log.command_sample_rates.size()));
+    for (const auto& rate : g.query_log.command_sample_rates) {
+        w.str(rate.command);
+        w.f64(rate.rate);
+    }
+    w.u32(g.query_log.session_rate_limit);
+    w.u32(g.query_log.session_burst);
+
+    w.u32(static_cast<std::uint32_t>(config.access_control.size()));
+    for (const auto& rule : config.access_control) {
+        w.str(rule.user);
+        w.str(rule.source_ip_cidr);
+        w.strings(rule.allowed_tables);
+        w.strings(rule.allowed_operations);
+        w.strings(rule.blocked_operations);
+        w.flag(rule.time_restriction.has_value());
+        if (rule.time_restriction) {
+            w.str(rule.time_restriction->allow_range);
+            w.str(rule.time_restriction->timezone);
+        }
+        w.u8(static_cast<std::uint8_t>(rule.mode));
+        w.flag(rule.log_sample_rate.has_value());
+        if (rule.log_sample_rate) {
+            w.f64(*rule.log_sample_rate);
+        }
+    }
+
+    w.strings(config.sql_rules.block_statements);
+    w.strings(config.sql_rules.block_patterns);
+    w.u8(static_cast<std::uint8_t>(config.sql_rules.mode));
+
+    w.str(config.procedure_control.mode);
+    w.strings(config.procedure_control.whitelist);
+    w.flag(config.procedure_control.block_dynamic_sql);
+    w.flag(config.procedure_control.block_create_alter);
+
+    w.u32(config.data_protection.max_result_rows);
+    w.str(config.data_protection.max_result_rows_action);
+    w.flag(config.data_protection.block_schema_access);
+
+    return w.finish(static_cast<std::uint32_t>(config.access_control.size()), source_hash);
+}
+
+std::expected<SnapshotHeader, std::string> read_header(std::span<const std::uint8_t> data) {
+    if (data.size() < kHeaderSize) {
+        return std::unexpected("snapshot shorter than header");
+    }
+    if (!std::equal(kMagic.begin(), kMagic.end(), data.begin())) {
+        return std::unexpected("bad snapshot magic");
+    }
+    SnapshotHeader header{};
+    header.version = get_le<std::uint16_t>(data.data() + 4);
+    if (header.version != kVersion) {
+        return std::unexpected(fmt::format("unsupported snapshot version {}", header.version));
+    }
+    header.rules_count = get_le<std::uint32_t>(data.data() + 8);
+    if (get_le<std::uint32_t>(data.data() + 12) != kHeaderSize) {
+        return std::unexpected("unexpected snapshot header size");
+    }
+    header.payload_size = get_le<std::uint64_t>(data.data() + 16);
+    header.checksum = get_le<std::uint64_t>(data.data() + 24);
+    const auto* hash = reinterpret_cast<const char*>(data.data() + 32);
+    header.source_hash.assign(hash, std::find(hash, hash + kHashLength, '\0'));
+    return header;
+}
+
+std::expected<PolicyConfig, std::string> decode(std::span<const std::uint8_t> data,
+                                                std::string_view expected_hash) {
+    auto header = read_header(data);
+    if (!header) {
+        return std::unexpected(header.error());
+    }
+    const auto payload = data.subspan(kHeaderSize);
+    if (payload.size() != header->payload_size) {
+        return std::unexpected("snapshot payload size mismatch");
+    }
+    if (fnv1a(payload) != header->checksum) {
+        return std::unexpected("snapshot checksum mismatch");
+    }
+    if (!expected_hash.empty() && header->source_hash != expected_hash) {
+        return std::unexpected("snapshot was built from a different source file");
+    }
+
+    Reader r{payload};
+    if (!r.read_table()) {
+        return std::unexpected(r.error());
+    }
+
+    PolicyConfig cfg{};
+    auto& g = cfg.global;
+    g.log_level = r.str();
+    g.log_format = r.str();
+    g.max_connections = r.u32();
+    g.connection_timeout_sec = r.u32();
+    g.decision_cache_entries = r.u32();
+    g.query_log.sample_rate = r.f64();
+    g.query_log.command_sample_rates.resize(r.count(sizeof(std::uint32_t) + sizeof(double)));
+    for (auto& rate : g.query_log.command_sample_rates) {
+        rate.command = r.str();
+        rate.rate = r.f64();
+    }
+    g.query_log.session_rate_limit = r.u32();
+    g.query_log.session_burst = r.u32();
+
+    // 룰 하나는 최소 문자열 2개 + 목록 3개 + 플래그/모드 3바이트
+    cfg.access_control.resize(r.count((5 * sizeof(std::uint32_t)) + 3));
+    for (auto& rule : cfg.access_control) {
+        rule.user = r.str();
+        rule.source_ip_cidr = r.str();
+        rule.allowed_tables = r.strings();
+        rule.allowed_operations = r.strings();
+        rule.blocked_operations = r.strings();
+        if (r.flag()) {
+            TimeRestriction tr{};
+            tr.allow_range = r.str();
+            tr.timezone = r.str();
+            rule.time_restriction = std::move(tr);
+        }
+        rule.mode = r.mode();
+        if (r.flag()) {
+            rule.log_sample_rate = r.f64();
+        }
+    }
+
+    cfg.sql_rules.block_statements = r.strings();
+    cfg.sql_rules.block_patterns = r.strings();
+    cfg.sql_rules.mode = r.mode();
+
+    cfg.procedure_control.mode = r.str();
+    cfg.procedure_control.whitelist = r.strings();
+    cfg.procedure_control.block_dynamic_sql = r.flag();
+    cfg.procedure_control.block_create_alter = r.flag();
+
+    cfg.data_protection.max_result_rows = r.u32();
+    cfg.data_protection.max_result_rows_action = r.str();
+    cfg.data_protection.block_schema_access = r.flag();
+
+    if (r.ok() && !r.at_end()) {
+        r.fail("trailing bytes after snapshot body");
+    }
+    if (!r.ok()) {
+        return std::unexpected(r.error());
+    }
+    if (cfg.access_control.size() != header->rules_count) {
+        return std::unexpected("snapshot rules_count mismatch");
+    }
+    // PolicyLoader 와 같은 fail-close 조건 (빈 패턴 목록은 InjectionDetector 가 모두 차단)
+    if (cfg.sql_rules.block_patterns.empty()) {
+        return std::unexpected("snapshot has no block_patterns");
+    }
+    return cfg;
+}
+
+}  // namespace policy_snapshot
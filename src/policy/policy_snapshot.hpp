@@ -0,0 +1,83 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// policy_snapshot.hpp
+//
+// PolicyConfig 의 바이너리 스냅샷 (PolicyVersionStore 의 .bin 사본).
+//
+// [설계 의도]
+// YAML 스냅샷으로 롤백/기동하면 매번 yaml-cpp 파싱 + 노드 순회 비용을 치른다.
+// 바이너리 스냅샷은 로더가 만든 최종 PolicyConfig 를 고정 폭 little-endian 레코드와
+// 문자열 테이블(중복 문자열 1회 저장)로 기록하여, mmap 한 바이트 범위에서 복사 한 번으로
+// 복원한다. YAML 이 원본(source of truth)이며 바이너리는 언제든 버리고 다시 만들 수 있다.
+//
+// [포맷] (모든 정수 little-endian)
+//   header (kHeaderSize 바이트)
+//     [0..4)   magic "DBGP"
+//     [4..6)   format version (kVersion)
+//     [6..8)   reserved (0)
+//     [8..12)  rules_count (access_control 수 — 목록 조회용)
+//     [12..16) header size
+//     [16..24) payload size
+//     [24..32) payload FNV-1a 64 checksum
+//     [32..96) 원본 YAML SHA-256 hex (없으면 0 채움)
+//   payload
+//     u32 string_count, { u32 len, bytes }*   — 문자열 테이블
+//     본문: 문자열은 u32 테이블 인덱스, 목록은 u32 개수 + 원소, 실수는 IEEE-754 u64
+//
+// [검증 — 하나라도 실패하면 std::unexpected (호출자는 YAML 로 fallback)]
+// magic / version / 크기 / checksum / 원본 해시 일치 / 문자열 인덱스·enum 범위 /
+// block_patterns 최소 1개 (PolicyLoader 와 같은 fail-close 조건).
+//
+// [범위]
+// 컴파일 결과(regex, CIDR trie, 테이블 해시셋)는 기록하지 않는다. std::regex 는 직렬화할 수
+// 없고 접근 인덱스 컴파일은 룰 수에 선형이므로, PolicyEngine::reload 가 기존과 같이 만든다
+// (바뀌지 않은 패턴은 현재 정책의 컴파일 결과를 재사용).
+// ---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "policy/rule.hpp"
+
+namespace policy_snapshot {
+
+inline constexpr std::string_view kMagic{"DBGP"};
+inline constexpr std::uint16_t kVersion = 1;
+inline constexpr std::size_t kHashLength = 64;  // SHA-256 hex
+inline constexpr std::size_t kHeaderSize = 32 + kHashLength;
+
+// ---------------------------------------------------------------------------
+// SnapshotHeader
+//   rules_count / source_hash 는 디렉토리 스캔 시 메타데이터 복원에도 쓰인다.
+// ---------------------------------------------------------------------------
+struct SnapshotHeader {
+    std::uint16_t version{0};
+    std::uint32_t rules_count{0};
+    std::uint64_t payload_size{0};
+    std::uint64_t checksum{0};
+    std::string source_hash{};
+};
+
+// encode: config 의 바이너리 스냅샷 (source_hash: 원본 YAML SHA-256 hex, 빈 값 허용)
+[[nodiscard]] std::string encode(const PolicyConfig& config, std::string_view source_hash);
+
+// read_header: 헤더만 검증·파싱한다 (payload checksum 은 decode 에서 검사)
+[[nodiscard]] std::expected<SnapshotHeader, std::string> read_header(
+    std::span<const std::uint8_t> data);
+
+// ---------------------------------------------------------------------------
+// decode
+//   data 전체를 검증하고 PolicyConfig 로 복원한다.
+//   expected_hash 가 비어 있지 않으면 헤더의 원본 해시와 같아야 한다.
+//   컴파일 결과 필드(compiled_patterns, injection_detector, access_index, rule_profile)는
+//   비어 있다 (PolicyEngine 이 채운다).
+// ---------------------------------------------------------------------------
+[[nodiscard]] std::expected<PolicyConfig, std::string> decode(std::span<const std::uint8_t> data,
+                                                              std::string_view expected_hash);
+
+}  // namespace policy_snapshot
@@ -13,6 +13,11 @@
 // 예: v1_20260304T103000Z.yaml
 // 타임스탬프는 ISO 8601 UTC 형식 (YYYYMMDDTHHMMSSz).
 //
+// [바이너리 사본]
+// binary_snapshots_ 이면 같은 stem 의 .bin 을 함께 기록한다 (임시 파일 + rename 으로
+// 반쯤 쓰인 파일이 보이지 않게). 로드는 mmap + policy_snapshot::decode 이며, 어떤 실패든
+// YAML 사본 파싱으로 넘어간다. 생성자 스캔은 .bin 헤더에서 hash / rules_count 를 복원한다.
+//
 // [스냅샷 디렉토리 스캔 (생성자)]
 // 기존 스냅샷 파일을 정규식으로 파싱하여 versions_ 벡터를 복원한다.
 // 파일명 파싱 실패 항목은 무시하고 로그 경고를 출력한다.
@@ -25,6 +30,7 @@
 // - 스냅샷 디렉토리 외부에서 파일이 추가/삭제되면 versions_ 와 불일치 발생.
 //   재시작 시 생성자 스캔으로 복원됨.
 // - compute_hash: 파일 읽기 실패 시 빈 문자열 반환 (스냅샷 저장은 계속).
+//   이 경우 .bin 헤더의 원본 해시도 비어 있어 load_cached 대상이 되지 않는다.
 // - prune 중 파일 삭제 실패 시 로그 경고만 출력하고 계속 진행.
 // ---------------------------------------------------------------------------
 
@@ -49,7 +55,14 @@
 // OpenSSL EVP for SHA-256
 #include <openssl/evp.h>
 
+// mmap (바이너리 스냅샷)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "policy/policy_loader.hpp"
+#include "policy/policy_snapshot.hpp"
 
 // ---------------------------------------------------------------------------
 // 내부 헬퍼: 현재 UTC 시각을 ISO 8601 compact 형식으로 반환.
@@ -105,6 +118,84 @@ struct SnapshotFileParts {
     }
 }
 
+// ---------------------------------------------------------------------------
+// 내부 헬퍼: YAML 스냅샷 경로에 대응하는 바이너리 사본 경로 (같은 stem, .bin)
+// ---------------------------------------------------------------------------
+[[nodiscard]] std::filesystem::path binary_path_for(const std::filesystem::path& yaml_path) {
+    auto path = yaml_path;
+    path.replace_extension(".bin");
+    return path;
+}
+
+// ---------------------------------------------------------------------------
+// MappedFile
+//   읽기 전용 mmap RAII. 열기/매핑 실패 시 valid() == false.
+//   fd 는 매핑 직후 닫는다 (매핑은 fd 와 독립적으로 유지된다).
+// ---------------------------------------------------------------------------
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            const auto size = static_cast<std::size_t>(st.st_size);
+            void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                data_ = addr;
+                size_ = size;
+            }
+        }
+        ::close(fd);
+    }
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            ::munmap(data_, size_);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    [[nodiscard]] bool valid() const noexcept { return data_ != nullptr; }
+    [[nodiscard]] std::span<const std::uint8_t> bytes() const noexcept {
+        return {static_cast<const std::uint8_t*>(data_), size_};
+    }
+
+private:
+    void* data_{nullptr};
+    std::size_t size_{0};
+};
+
+// ---------------------------------------------------------------------------
+// 내부 헬퍼: data 를 path 에 원자적으로 기록한다 (path.tmp 에 쓴 뒤 rename).
+// ---------------------------------------------------------------------------
+[[nodiscard]] bool write_file_atomic(const std::filesystem::path& path, std::string_view data) {
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!out) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
 }  // namespace
 
 // ---------------------------------------------------------------------------
@@ -115,8 +206,11 @@ struct SnapshotFileParts {
 // 3. 기존 스냅샷 파일을 스캔하여 versions_ 복원
 // ---------------------------------------------------------------------------
 PolicyVersionStore::PolicyVersionStore(const std::filesystem::path& config_dir,
-                                       std::uint32_t max_versions)
-    : versions_dir_(config_dir / ".policy_versions"), max_versions_(max_versions) {
+                                       std::uint32_t max_versions,
+                                       bool binary_snapshots)
+    : versions_dir_(config_dir / ".policy_versions"),
+      max_versions_(max_versions),
+      binary_snapshots_(binary_snapshots) {
     // 디렉토리 생성 (이미 있으면 무시)
     std::error_code ec;
     std::filesystem::create_directories(versions_dir_, ec);
@@ -156,8 +250,14 @@ PolicyVersionStore::PolicyVersionStore(const std::filesystem::path& config_dir,
         meta.version = parts.version;
         meta.timestamp = parts.timestamp;
         meta.snapshot_path = path;
-        // rules_count 와 hash 는 스캔 시 0/"" 로 초기화
-        // (재시작 시 정확한 값 복원 불가 — 알려진 한계)
+        // rules_count 와 hash 는 .bin 헤더가 있으면 복원하고, 없으면 0/"" 로 둔다
+        const MappedFile bin(binary_path_for(path));
+        if (bin.valid()) {
+            if (auto header = policy_snapshot::read_header(bin.bytes())) {
+                meta.rules_count = header->rules_count;
+                meta.hash = std::move(header->source_hash);
+            }
+        }
         found.push_back(std::move(meta));
     }
 
@@ -190,10 +290,17 @@ PolicyVersionStore::PolicyVersionStore(const std::filesystem::path& config_dir,
 // save_snapshot
 //
 // 1. source_path 의 YAML 파일을 스냅샷 디렉토리에 복사
-// 2. SHA-256 해시 계산 (원본 파일 기준)
-// 3. PolicyVersionMeta 생성 및 versions_ 추가
-// 4. prune() 호출
-// 5. next_version_++ 후 메타 반환
+// 2. SHA-256 해시 계산 (복사본 기준)
+// 3. binary_snapshots_ 이면 복사본을 다시 파싱해 .bin 기록
+// 4. PolicyVersionMeta 생성 및 versions_ 추가
+// 5. prune() 호출
+// 6. next_version_++ 후 메타 반환
+//
+// [해시와 .bin 본문의 일치]
+// config 는 호출자가 먼저 파싱한 정책이라, 그 사이 원본이 수정되면 복사 시점의 파일과 다를
+// 수 있다. .bin 을 config 로 만들면 "새 파일의 해시 + 이전 정책 본문" 이 되어 다음 기동의
+// load_cached 가 YAML 을 읽지 않고 이전 정책을 복원한다. 그래서 해시와 .bin 본문을 모두
+// 같은 바이트(복사본)에서 만든다.
 // ---------------------------------------------------------------------------
 std::expected<PolicyVersionMeta, std::string> PolicyVersionStore::save_snapshot(
     const PolicyConfig& config, const std::filesystem::path& source_path) {
@@ -227,17 +334,33 @@ std::expected<PolicyVersionMeta, std::string> PolicyVersionStore::save_snapshot(
         return std::unexpected(err);
     }
 
-    // SHA-256 해시 계산 (원본 파일 기준)
-    const std::string hash = compute_hash(source_path);
+    // SHA-256 해시 계산 (복사본 기준 — 복사 뒤 원본이 바뀌어도 사본과 어긋나지 않는다)
+    const std::string hash = compute_hash(snapshot_path);
     if (hash.empty()) {
         spdlog::warn(
             "policy_version_store: failed to compute SHA-256 for '{}' — hash will be empty",
-            source_path.string());
+            snapshot_path.string());
     }
 
     // access_control 규칙 수 계산
     const auto rules_count = static_cast<std::uint32_t>(config.access_control.size());
 
+    // 바이너리 사본 (실패해도 YAML 사본으로 버전은 유효)
+    //   본문은 해시를 계산한 복사본을 파싱한 결과다 (config 가 아니다 — 위 [해시와 .bin 본문]).
+    if (binary_snapshots_) {
+        const auto bin_path = binary_path_for(snapshot_path);
+        auto snapshot_config = PolicyLoader::load(snapshot_path);
+        if (!snapshot_config) {
+            spdlog::warn("policy_version_store: skipping binary snapshot '{}': {}",
+                         bin_path.string(),
+                         snapshot_config.error());
+        } else if (!write_file_atomic(bin_path,
+                                      policy_snapshot::encode(*snapshot_config, hash))) {
+            spdlog::warn("policy_version_store: failed to write binary snapshot '{}'",
+                         bin_path.string());
+        }
+    }
+
     // 메타데이터 생성
     PolicyVersionMeta meta;
     meta.version = next_version_;
@@ -292,6 +415,18 @@ std::expected<PolicyConfig, std::string> PolicyVersionStore::load_snapshot(
         return std::unexpected(err);
     }
 
+    // 바이너리 사본이 있으면 우선 사용 (실패 시 YAML 로 fallback)
+    if (std::filesystem::exists(binary_path_for(it->snapshot_path), ec)) {
+        auto binary = load_binary(*it);
+        if (binary) {
+            spdlog::info("policy_version_store: loaded snapshot v{} from binary", version);
+            return std::move(*binary);
+        }
+        spdlog::warn("policy_version_store: binary snapshot v{} rejected ({}), parsing YAML",
+                     version,
+                     binary.error());
+    }
+
     // PolicyLoader 로 파싱
     auto result = PolicyLoader::load(it->snapshot_path);
     if (!result) {
@@ -306,6 +441,47 @@ std::expected<PolicyConfig, std::string> PolicyVersionStore::load_snapshot(
     return std::move(*result);
 }
 
+// ---------------------------------------------------------------------------
+// load_cached
+//
+// source_path 해시와 같은 해시를 가진 최신 버전부터 .bin 복원을 시도한다.
+// ---------------------------------------------------------------------------
+std::expected<CachedPolicy, std::string> PolicyVersionStore::load_cached(
+    const std::filesystem::path& source_path) const {
+    const std::string hash = compute_hash(source_path);
+    if (hash.empty()) {
+        return std::unexpected("policy_version_store: cannot hash source file");
+    }
+
+    const std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = versions_.rbegin(); it != versions_.rend(); ++it) {
+        if (it->hash != hash) {
+            continue;
+        }
+        auto binary = load_binary(*it);
+        if (!binary) {
+            return std::unexpected(fmt::format(
+                "policy_version_store: cached v{} unusable: {}", it->version, binary.error()));
+        }
+        spdlog::info("policy_version_store: source unchanged, using binary snapshot v{}",
+                     it->version);
+        return CachedPolicy{.meta = *it, .config = std::move(*binary)};
+    }
+    return std::unexpected("policy_version_store: no snapshot matches source file");
+}
+
+// ---------------------------------------------------------------------------
+// load_binary (static private)
+// ---------------------------------------------------------------------------
+std::expected<PolicyConfig, std::string> PolicyVersionStore::load_binary(
+    const PolicyVersionMeta& meta) {
+    const MappedFile bin(binary_path_for(meta.snapshot_path));
+    if (!bin.valid()) {
+        return std::unexpected("binary snapshot missing or unreadable");
+    }
+    return policy_snapshot::decode(bin.bytes(), meta.hash);
+}
+
 // ---------------------------------------------------------------------------
 // list_versions
 //
@@ -359,6 +535,8 @@ void PolicyVersionStore::prune() {
                          ec.message());
             // 파일 삭제 실패해도 벡터에서는 제거 (이후 접근 시 실패로 처리됨)
         }
+        // 바이너리 사본 (없으면 remove 는 false 를 반환할 뿐)
+        std::filesystem::remove(binary_path_for(oldest.snapshot_path), ec);
 
         versions_.erase(versions_.begin());
     }
@@ -10,6 +10,9 @@
 // - SHA-256 해시(OpenSSL EVP)로 스냅샷 무결성을 추적한다.
 // - max_versions_ 초과 시 오래된 스냅샷을 자동으로 삭제한다 (prune).
 // - 모든 공개 메서드는 std::mutex 로 보호되어 스레드 안전하다.
+// - binary_snapshots 가 켜져 있으면 같은 stem 의 .bin (policy_snapshot.hpp) 도 저장한다.
+//   load_snapshot / load_cached 는 .bin 을 mmap 하여 YAML 파싱 없이 복원하고,
+//   .bin 이 없거나 검증에 실패하면 YAML 사본으로 fallback 한다 (YAML 이 원본).
 //
 // [fail-close 연계]
 // - load_snapshot 실패(파일 없음, 파싱 오류) 시 std::unexpected 반환.
@@ -18,13 +21,14 @@
 //   버전 저장 실패 = 스냅샷 미보관이며, 현재 동작 중인 정책은 그대로 유지.
 //
 // [파일명 패턴]
-// v{version}_{iso_timestamp}.yaml
+// v{version}_{iso_timestamp}.yaml (+ 선택적 v{version}_{iso_timestamp}.bin)
 // 예: v1_20260304T103000Z.yaml
 //
 // [알려진 한계]
 // - 스냅샷 디렉토리(.policy_versions/)가 외부에서 수정되면
 //   versions_ 벡터와 실제 파일이 불일치할 수 있다.
 //   재시작 시 생성자에서 디렉토리를 스캔하여 복원하므로 영속성은 유지된다.
+//   (rules_count / hash 는 .bin 헤더가 있을 때만 복원된다)
 // - compute_hash 실패 시 hash 필드가 빈 문자열로 저장된다 (스냅샷은 계속 저장).
 // - SHA-256 해시는 무결성 확인용이며, 서명/인증은 범위 외.
 // ---------------------------------------------------------------------------
@@ -56,6 +60,15 @@ struct PolicyVersionMeta {
     std::filesystem::path snapshot_path{};
 };
 
+// ---------------------------------------------------------------------------
+// CachedPolicy
+//   load_cached 결과: 원본 파일과 해시가 같은 최신 버전과 바이너리에서 복원한 정책.
+// ---------------------------------------------------------------------------
+struct CachedPolicy {
+    PolicyVersionMeta meta{};
+    PolicyConfig config{};
+};
+
 // ---------------------------------------------------------------------------
 // PolicyVersionStore
 //   정책 스냅샷 저장/로드/목록/정리를 담당한다.
@@ -74,8 +87,10 @@ class PolicyVersionStore {
 public:
     // config_dir:    정책 설정 디렉토리 경로 (스냅샷 서브디렉토리 생성 위치).
     // max_versions:  유지할 최대 스냅샷 수. 초과 시 오래된 것부터 삭제.
+    // binary_snapshots: true 이면 save_snapshot 이 .bin 바이너리 사본도 기록한다.
     explicit PolicyVersionStore(const std::filesystem::path& config_dir,
-                                std::uint32_t max_versions = 10);
+                                std::uint32_t max_versions = 10,
+                                bool binary_snapshots = false);
     ~PolicyVersionStore() = default;
 
     // 복사/이동 금지 (mutex 멤버)
@@ -87,6 +102,11 @@ public:
     // save_snapshot
     //   source_path 의 YAML 파일을 스냅샷 디렉토리에 복사하여 버전을 저장한다.
     //
+    //   hash 는 YAML 사본의 SHA-256 이다. binary_snapshots 이면 그 사본을 다시 파싱한 .bin 도
+    //   기록한다 (임시 파일 + rename) — config 를 파싱한 뒤 원본이 수정되어도 .bin 본문과
+    //   hash 가 같은 바이트를 가리킨다. config 는 rules_count 에만 쓴다.
+    //   .bin 기록 실패는 경고만 남긴다 (YAML 사본만으로 버전은 유효).
+    //
     //   성공: PolicyVersionMeta 반환 (version, timestamp, hash 포함).
     //   실패: std::unexpected(error_message) 반환.
     //         실패해도 현재 동작 중인 정책/엔진에 영향 없음.
@@ -99,6 +119,8 @@ public:
 
     // load_snapshot
     //   version 에 해당하는 스냅샷을 파일에서 읽어 PolicyConfig 로 반환한다.
+    //   .bin 이 있으면 mmap 후 검증(checksum + 메타 해시 일치)하여 복원하고,
+    //   실패하면 경고 후 YAML 사본을 PolicyLoader 로 파싱한다.
     //
     //   성공: PolicyConfig 반환.
     //   실패: std::unexpected(error_message) 반환.
@@ -109,6 +131,13 @@ public:
     [[nodiscard]] std::expected<PolicyConfig, std::string> load_snapshot(
         std::uint64_t version) const;
 
+    // load_cached
+    //   기동 fast path. source_path 의 SHA-256 과 해시가 같은 최신 버전의 .bin 을 복원한다.
+    //   일치하는 버전이 없거나 .bin 이 없거나 검증에 실패하면 std::unexpected —
+    //   호출자는 PolicyLoader::load 로 원본을 파싱한다 (fail-close 는 그쪽에서 유지).
+    [[nodiscard]] std::expected<CachedPolicy, std::string> load_cached(
+        const std::filesystem::path& source_path) const;
+
     // list_versions
     //   저장된 모든 버전의 메타데이터를 반환한다 (최신 버전 먼저 정렬).
     [[nodiscard]] std::vector<PolicyVersionMeta> list_versions() const;
@@ -121,6 +150,7 @@ public:
 private:
     std::filesystem::path versions_dir_;       // 스냅샷 저장 디렉토리
     std::uint32_t max_versions_;               // 유지할 최대 스냅샷 수
+    bool binary_snapshots_;                    // .bin 사본 기록 여부
     mutable std::mutex mutex_;                 // 공개 메서드 직렬화용 뮤텍스
     std::uint64_t next_version_{1};            // 다음 버전 번호 (1부터 시작)
     std::vector<PolicyVersionMeta> versions_;  // 저장된 스냅샷 메타데이터 목록
@@ -139,4 +169,9 @@ private:
     //   OpenSSL EVP_DigestInit_ex / EVP_DigestUpdate / EVP_DigestFinal_ex 사용.
     //   OpenSSL libcrypto 는 Boost.Asio SSL 의존으로 이미 vcpkg 에 설치됨.
     [[nodiscard]] static std::string compute_hash(const std::filesystem::path& file_path);
+
+    // load_binary
+    //   meta 의 .bin 을 mmap 하여 복원한다. .bin 없음/검증 실패 시 std::unexpected.
+    [[nodiscard]] static std::expected<PolicyConfig, std::string> load_binary(
+        const PolicyVersionMeta& meta);
 };
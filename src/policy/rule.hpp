@@ -13,7 +13,9 @@
 //   판정 로직을 포함하지 않는다.
 // ---------------------------------------------------------------------------
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -41,11 +43,14 @@ enum class RuleMode : std::uint8_t {
 //
 //   [한계]
 //   - timezone 파싱은 구현 레이어에서 OS의 tzdata 에 의존한다.
-//   - 서머타임(DST) 전환 경계에서 1시간 오차 가능성 있음.
+//   - 엔진은 접근 인덱스 컴파일 시 분 단위 창으로 변환한다 (policy/access_index.hpp).
+//     게시 후 이 필드를 수정해도 반영되지 않는다 (reload 로 교체).
 // ---------------------------------------------------------------------------
 struct TimeRestriction {
     std::string allow_range{"09:00-18:00"};  // 접근 허용 시간 범위
     std::string timezone{"UTC"};             // IANA timezone ID
+
+    bool operator==(const TimeRestriction&) const = default;
 };
 
 // ---------------------------------------------------------------------------
@@ -71,6 +76,32 @@ struct AccessRule {
 
     // 룰 실행 모드 (기본 kEnforce — fail-close)
     RuleMode mode{RuleMode::kEnforce};
+
+    // 이 룰로 허용된 쿼리의 로그 샘플링 비율 [0.0, 1.0] (설정 없으면 global.query_log 적용)
+    std::optional<double> log_sample_rate{};
+
+    // reload diff 용 (모든 필드 비교 — 같으면 컴파일된 접근 인덱스를 재사용한다)
+    bool operator==(const AccessRule&) const = default;
+};
+
+// compiled_patterns.hpp / parser/injection_detector.hpp / rule_profile.hpp /
+// access_index.hpp 에 정의 (rule.hpp 독립성 유지를 위해 전방 선언만 사용)
+struct CompiledAccessIndex;
+struct CompiledBlockPatterns;
+class InjectionDetector;
+class RuleProfile;
+
+// ---------------------------------------------------------------------------
+// BlockPatternsStamp
+//   compiled_patterns 가 block_patterns 와 일치함을 전체 비교로 확인한 시점의 식별자
+//   (컴파일 결과 주소, block_patterns 저장소 data(), size()). PolicyEngine 이 게시 직전에
+//   기록하고, evaluate()/explain() 은 이 값만 대조한다 (쿼리당 O(1)).
+//   복사된 config 는 저장소 주소가 달라 전체 비교로 되돌아간다 (결과는 동일).
+// ---------------------------------------------------------------------------
+struct BlockPatternsStamp {
+    const CompiledBlockPatterns* compiled{nullptr};
+    const std::string* data{nullptr};
+    std::size_t size{0};
 };
 
 // ---------------------------------------------------------------------------
@@ -78,10 +109,19 @@ struct AccessRule {
 //   SQL 구문 레벨 차단 규칙.
 //   block_statements: SQL 커맨드 문자열 (예: ["DROP", "TRUNCATE"])
 //   block_patterns:   정규식 패턴 (InjectionDetector 와 공유)
+//   compiled_patterns: block_patterns 사전 컴파일 결과.
+//                      PolicyLoader::load() / PolicyEngine 생성·reload() 시 채워진다.
+//                      nullptr 이거나 block_patterns 와 불일치하면 엔진이 재컴파일한다.
+//   compiled_stamp: compiled_patterns 검증 시점의 BlockPatternsStamp (엔진 게시 시 기록)
+//   injection_detector: 기본 인젝션 패턴 + block_patterns 로 만든 공유 detector.
+//                       PolicyEngine 생성·reload() 시 채워지며, 세션들이 읽기 전용으로 공유한다.
 // ---------------------------------------------------------------------------
 struct SqlRule {
     std::vector<std::string> block_statements{};  // 차단할 SQL 구문 종류
     std::vector<std::string> block_patterns{};    // 정규식 기반 차단 패턴
+    std::shared_ptr<const CompiledBlockPatterns> compiled_patterns{};  // 사전 컴파일 결과
+    std::shared_ptr<const InjectionDetector> injection_detector{};     // 세션 공유 detector
+    BlockPatternsStamp compiled_stamp{};                               // O(1) 일치 확인용
 
     // 섹션 레벨 실행 모드 (기본 kEnforce — fail-close)
     RuleMode mode{RuleMode::kEnforce};
@@ -108,25 +148,61 @@ struct ProcedureControl {
 // ---------------------------------------------------------------------------
 // DataProtection
 //   결과 행 수 제한 및 스키마 접근 차단 설정.
-//   max_result_rows = 0 이면 제한 없음.
+//   max_result_rows = 0 이면 제한 없음. 응답 릴레이가 결과 셋마다 row 를 세어 적용한다.
+//   max_result_rows_action: 한도를 넘는 row 가 도착했을 때의 처리
+//     "error"    — 한도까지 전달한 뒤 ERR 로 결과 셋을 끝낸다 (기본, 잘린 결과를 성공으로
+//                  오인하지 않음)
+//     "truncate" — 한도까지 전달한 뒤 EOF 로 결과 셋을 정상 종료한다
 //   block_schema_access = true 이면 information_schema, mysql DB 접근 차단.
 // ---------------------------------------------------------------------------
 struct DataProtection {
-    std::uint32_t max_result_rows{0};  // 0 = 제한 없음
-    bool block_schema_access{true};    // 스키마 메타데이터 접근 차단
+    std::uint32_t max_result_rows{0};             // 0 = 제한 없음
+    std::string max_result_rows_action{"error"};  // "error" | "truncate"
+    bool block_schema_access{true};               // 스키마 메타데이터 접근 차단
+};
+
+// ---------------------------------------------------------------------------
+// QueryLogSampling
+//   허용된 쿼리(QueryLog)의 로그 샘플링 / 세션별 rate limit 설정.
+//   sample_rate:          기본 샘플링 비율 [0.0, 1.0] (1.0 = 전부 기록)
+//   command_sample_rates: SQL 커맨드별 비율 (예: SELECT → 0.01). sample_rate 보다 우선.
+//   session_rate_limit:   세션당 초당 기록 가능한 QueryLog 수 (0 = 제한 없음)
+//   session_burst:        token bucket 용량 (0 이면 session_rate_limit 과 같음)
+//
+//   우선순위: AccessRule::log_sample_rate > command_sample_rates > sample_rate
+//
+//   [보안 원칙]
+//   차단(BlockLog) 및 monitor 모드 would-block 이벤트는 샘플링/rate limit 대상이 아니며
+//   항상 기록된다.
+// ---------------------------------------------------------------------------
+struct CommandSampleRate {
+    std::string command{};  // 대문자 SQL 커맨드 (예: "SELECT")
+    double rate{1.0};
+};
+
+struct QueryLogSampling {
+    double sample_rate{1.0};
+    std::vector<CommandSampleRate> command_sample_rates{};
+    std::uint32_t session_rate_limit{0};  // 0 = 제한 없음
+    std::uint32_t session_burst{0};       // 0 = session_rate_limit
 };
 
 // ---------------------------------------------------------------------------
 // GlobalConfig
 //   전역 설정값.
 //   log_level: "trace"|"debug"|"info"|"warn"|"error"|"critical"
-//   log_format: "json" | "text"
+//   log_format: "json" | "binary" — binary 는 쿼리/차단 감사 레코드를 <log_path stem>.audit
+//               바이너리 파일에 기록한다. 변경은 재시작 시 적용된다.
 // ---------------------------------------------------------------------------
 struct GlobalConfig {
     std::string log_level{"info"};
     std::string log_format{"json"};
     std::uint32_t max_connections{1000};
     std::uint32_t connection_timeout_sec{30};
+    // fingerprint 판정 캐시 엔트리 수 (0 = 비활성). 변경은 재시작 시 적용된다.
+    std::uint32_t decision_cache_entries{4096};
+    // 허용 쿼리 로그 샘플링 / rate limit (기본: 전부 기록). 핫 리로드로 즉시 반영된다.
+    QueryLogSampling query_log{};
 };
 
 // ---------------------------------------------------------------------------
@@ -138,6 +214,15 @@ struct GlobalConfig {
 //   [Hot Reload 고려사항]
 //   - PolicyEngine::reload 를 통해 shared_ptr 교체 방식으로 원자적 갱신.
 //   - 갱신 중 평가가 진행 중인 경우 이전 config 로 완료됨 (eventual consistency).
+//
+//   access_index: access_control 사전 컴파일 인덱스 (user 해시맵 + CIDR trie +
+//                 테이블 해시셋 + 오퍼레이션 비트마스크). PolicyEngine 생성·reload() 시 채워진다.
+//                 게시 후 access_control 의 룰 수가 바뀌면 엔진이 임시로 재컴파일한다.
+//                 reload 시 access_control 이 현재 정책과 같으면 기존 인덱스를 공유한다.
+//   rule_profile: 규칙별 적중/평가 비용 카운터. PolicyEngine 생성·reload() 시
+//                 이 스냅샷의 규칙 수로 새로 만들어진다 (reload 마다 0 부터).
+//
+//   필드를 추가하면 policy_snapshot.cpp 의 encode/decode 와 kVersion 도 함께 갱신한다.
 // ---------------------------------------------------------------------------
 struct PolicyConfig {
     GlobalConfig global{};
@@ -145,4 +230,6 @@ struct PolicyConfig {
     SqlRule sql_rules{};
     ProcedureControl procedure_control{};
     DataProtection data_protection{};
+    std::shared_ptr<const CompiledAccessIndex> access_index{};
+    std::shared_ptr<RuleProfile> rule_profile{};
 };
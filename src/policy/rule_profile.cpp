@@ -0,0 +1,92 @@
+// ---------------------------------------------------------------------------
+// rule_profile.cpp
+//
+// RuleProfile 구현. 샤드는 하나의 연속 배열을 stride 단위로 나눠 쓴다.
+// stride 는 캐시 라인(8 카운터) 배수 + 1 라인이므로 배열 시작 정렬과 무관하게
+// 인접 샤드가 같은 캐시 라인을 공유하지 않는다.
+// ---------------------------------------------------------------------------
+
+#include "policy/rule_profile.hpp"
+
+namespace {
+
+constexpr std::size_t kCountersPerLine = 64 / sizeof(std::atomic<std::uint64_t>);
+
+std::size_t profile_shard() noexcept {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t shard =
+        next.fetch_add(1, std::memory_order_relaxed) % RuleProfile::kShardCount;
+    return shard;
+}
+
+std::uint64_t to_ns(std::chrono::nanoseconds elapsed) noexcept {
+    return elapsed.count() > 0 ? static_cast<std::uint64_t>(elapsed.count()) : 0;
+}
+
+}  // namespace
+
+RuleProfile::RuleProfile(std::size_t access_rules, std::size_t block_patterns)
+    : access_rules_{access_rules}, block_patterns_{block_patterns} {
+    const auto counters = (access_rules + 1 + block_patterns) * kCountersPerSlot;
+    stride_ = ((counters + kCountersPerLine - 1) / kCountersPerLine + 1) * kCountersPerLine;
+    counters_ = std::make_unique<std::atomic<std::uint64_t>[]>(stride_ * kShardCount);
+}
+
+void RuleProfile::record_access_rule(std::size_t index, std::chrono::nanoseconds elapsed) noexcept {
+    if (index < access_rules_) {
+        record(index, 1, true, to_ns(elapsed));
+    }
+}
+
+void RuleProfile::record_access_rule_cached(std::size_t index) noexcept {
+    if (index < access_rules_) {
+        record(index, 0, true, 0);
+    }
+}
+
+void RuleProfile::record_no_access_rule(std::chrono::nanoseconds elapsed) noexcept {
+    record(access_rules_, 1, true, to_ns(elapsed));
+}
+
+void RuleProfile::record_pattern(std::size_t index,
+                                 bool matched,
+                                 std::chrono::nanoseconds elapsed) noexcept {
+    if (index < block_patterns_) {
+        record(access_rules_ + 1 + index, 1, matched, to_ns(elapsed));
+    }
+}
+
+RuleCost RuleProfile::access_rule(std::size_t index) const noexcept {
+    return index < access_rules_ ? merged(index) : RuleCost{};
+}
+
+RuleCost RuleProfile::block_pattern(std::size_t index) const noexcept {
+    return index < block_patterns_ ? merged(access_rules_ + 1 + index) : RuleCost{};
+}
+
+RuleCost RuleProfile::no_access_rule() const noexcept { return merged(access_rules_); }
+
+void RuleProfile::record(std::size_t slot,
+                         std::uint64_t evaluations,
+                         bool hit,
+                         std::uint64_t ns) noexcept {
+    auto* base = &counters_[(profile_shard() * stride_) + (slot * kCountersPerSlot)];
+    if (evaluations > 0) {
+        base[0].fetch_add(evaluations, std::memory_order_relaxed);
+        base[2].fetch_add(ns, std::memory_order_relaxed);
+    }
+    if (hit) {
+        base[1].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+RuleCost RuleProfile::merged(std::size_t slot) const noexcept {
+    RuleCost cost{};
+    for (std::size_t shard = 0; shard < kShardCount; ++shard) {
+        const auto* base = &counters_[(shard * stride_) + (slot * kCountersPerSlot)];
+        cost.evaluations += base[0].load(std::memory_order_relaxed);
+        cost.hits += base[1].load(std::memory_order_relaxed);
+        cost.total_ns += base[2].load(std::memory_order_relaxed);
+    }
+    return cost;
+}
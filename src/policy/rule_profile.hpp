@@ -0,0 +1,109 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// rule_profile.hpp
+//
+// 정책 스냅샷(PolicyConfig) 단위 규칙별 적중 수 / 평가 비용 프로파일.
+//
+// [설계 의도]
+// - 어느 AccessRule 이 자주 매칭되는지(재정렬 후보), 어느 block_pattern 정규식이
+//   느린지(재작성 후보)를 운영 중에 확인하기 위한 카운터.
+// - PolicyConfig 에 함께 보관되어 reload() 시 새 스냅샷과 함께 0 부터 다시 센다
+//   (인덱스 = 해당 스냅샷의 access_control / block_patterns 위치).
+//
+// [측정 방식]
+// - access rule : access_control 탐색 시작 ~ 판정까지 (Step 5 ~ 12) 를 매칭된 규칙에 귀속.
+//                 매칭 규칙이 없으면 no_access_rule 에 귀속 (전체 탐색 비용).
+//                 판정 캐시 적중은 평가가 없으므로 hits 만 증가한다.
+// - block_pattern: 원문에 대한 regex_search 1회마다 evaluations / total_ns, 매칭 시 hits.
+//
+// [스레드 안전성]
+// - record_*(): 데이터패스에서 concurrent 호출 안전. 스레드별 샤드에 relaxed fetch_add.
+// - access_rule() / block_pattern() / no_access_rule(): 샤드 합산 (조회 경로).
+// ---------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+// access_control 에 매칭된 규칙이 없음을 나타내는 인덱스
+inline constexpr std::size_t kNoAccessRule = std::numeric_limits<std::size_t>::max();
+
+// ---------------------------------------------------------------------------
+// RuleCost
+//   evaluations: 실제 평가 횟수 (total_ns 의 분모)
+//   hits       : 매칭 횟수 (access rule 은 판정 캐시 적중 포함)
+//   total_ns   : 누적 평가 시간
+// ---------------------------------------------------------------------------
+struct RuleCost {
+    std::uint64_t evaluations{0};
+    std::uint64_t hits{0};
+    std::uint64_t total_ns{0};
+};
+
+// ---------------------------------------------------------------------------
+// RuleStats / PolicyRuleStats
+//   PolicyEngine::rule_stats() 반환값 (UDS policy_stats 응답).
+//   rule: access rule 은 "user@cidr", block_pattern 은 원본 패턴 문자열.
+// ---------------------------------------------------------------------------
+struct RuleStats {
+    std::size_t index{0};
+    std::string rule{};
+    RuleCost cost{};
+};
+
+struct PolicyRuleStats {
+    std::uint64_t version{0};
+    std::vector<RuleStats> access_rules{};
+    std::vector<RuleStats> block_patterns{};
+    RuleCost no_access_rule{};
+};
+
+class RuleProfile {
+public:
+    static constexpr std::size_t kShardCount = 8;
+
+    RuleProfile(std::size_t access_rules, std::size_t block_patterns);
+    ~RuleProfile() = default;
+
+    RuleProfile(const RuleProfile&) = delete;
+    RuleProfile& operator=(const RuleProfile&) = delete;
+    RuleProfile(RuleProfile&&) = delete;
+    RuleProfile& operator=(RuleProfile&&) = delete;
+
+    [[nodiscard]] std::size_t access_rule_count() const noexcept { return access_rules_; }
+    [[nodiscard]] std::size_t block_pattern_count() const noexcept { return block_patterns_; }
+
+    // record_access_rule: index 규칙이 매칭되어 elapsed 동안 평가됨
+    void record_access_rule(std::size_t index, std::chrono::nanoseconds elapsed) noexcept;
+
+    // record_access_rule_cached: 판정 캐시 적중 (평가 없이 매칭만 증가)
+    void record_access_rule_cached(std::size_t index) noexcept;
+
+    // record_no_access_rule: 매칭되는 access rule 없음 (default deny)
+    void record_no_access_rule(std::chrono::nanoseconds elapsed) noexcept;
+
+    // record_pattern: block_patterns[index] 정규식 1회 수행
+    void record_pattern(std::size_t index, bool matched, std::chrono::nanoseconds elapsed) noexcept;
+
+    [[nodiscard]] RuleCost access_rule(std::size_t index) const noexcept;
+    [[nodiscard]] RuleCost block_pattern(std::size_t index) const noexcept;
+    [[nodiscard]] RuleCost no_access_rule() const noexcept;
+
+private:
+    // 슬롯 = [access rules..., no_access_rule, block patterns...], 슬롯당 카운터 3개
+    static constexpr std::size_t kCountersPerSlot = 3;
+
+    void record(std::size_t slot, std::uint64_t evaluations, bool hit, std::uint64_t ns) noexcept;
+    [[nodiscard]] RuleCost merged(std::size_t slot) const noexcept;
+
+    std::size_t access_rules_;
+    std::size_t block_patterns_;
+    std::size_t stride_;  // 샤드 하나의 카운터 수 (캐시 라인 경계 + 여유 1 라인)
+    std::unique_ptr<std::atomic<std::uint64_t>[]> counters_;
+};
@@ -6,7 +6,7 @@
 // extract_command — 구현
 //
 // MysqlPacket의 payload 첫 바이트를 CommandType으로 매핑한다.
-// COM_QUERY(0x03)의 경우 나머지 바이트를 SQL 문자열로 설정한다.
+// COM_QUERY(0x03) / COM_STMT_PREPARE(0x16)의 경우 나머지 바이트를 SQL 문자열로 설정한다.
 // ---------------------------------------------------------------------------
 
 namespace {
@@ -43,19 +43,35 @@ auto map_command_byte(std::uint8_t byte) noexcept -> std::optional<CommandType>
             return CommandType::kComStmtPrepare;
         case 0x17:
             return CommandType::kComStmtExecute;
+        case 0x18:
+            return CommandType::kComStmtSendLongData;
         case 0x19:
             return CommandType::kComStmtClose;
         case 0x1A:
             return CommandType::kComStmtReset;
+        case 0x1C:
+            return CommandType::kComStmtFetch;
         default:
             return std::nullopt;
     }
 }
 
-}  // namespace
+// statement_id (payload[1..4], LE) 를 갖는 커맨드인지
+auto has_statement_id(CommandType type) noexcept -> bool {
+    switch (type) {
+        case CommandType::kComStmtExecute:
+        case CommandType::kComStmtSendLongData:
+        case CommandType::kComStmtClose:
+        case CommandType::kComStmtReset:
+        case CommandType::kComStmtFetch:
+            return true;
+        default:
+            return false;
+    }
+}
 
-auto extract_command(const MysqlPacket& packet) -> std::expected<CommandPacket, ParseError> {
-    const auto payload = packet.payload();
+auto extract_from_payload(std::span<const std::uint8_t> payload, std::uint8_t sequence_id)
+    -> std::expected<CommandPacket, ParseError> {
 
     // payload가 비어있으면 malformed
     if (payload.empty()) {
@@ -75,15 +91,62 @@ auto extract_command(const MysqlPacket& packet) -> std::expected<CommandPacket,
 
     CommandPacket cmd;
     cmd.command_type = *cmd_type;
-    cmd.sequence_id = packet.sequence_id();
+    cmd.sequence_id = sequence_id;
 
-    // COM_QUERY: payload[1:]을 SQL 문자열로 설정
-    if (*cmd_type == CommandType::kComQuery && payload.size() > 1) {
-        cmd.query.assign(
+    // COM_QUERY / COM_STMT_PREPARE: payload[1:] 을 SQL 로 (패킷 버퍼를 가리키는 뷰, 복사 없음)
+    const bool carries_sql =
+        *cmd_type == CommandType::kComQuery || *cmd_type == CommandType::kComStmtPrepare;
+    if (carries_sql && payload.size() > 1) {
+        cmd.query = std::string_view{
             reinterpret_cast<const char*>(  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
                 payload.data() + 1),
-            payload.size() - 1);
+            payload.size() - 1};
+    }
+
+    if (has_statement_id(*cmd_type)) {
+        if (payload.size() < 5) {
+            return std::unexpected(
+                ParseError{.code = ParseErrorCode::kMalformedPacket,
+                           .message = std::format("truncated statement id: command 0x{:02X}",
+                                                  cmd_byte),
+                           .context = {}});
+        }
+        cmd.statement_id = static_cast<std::uint32_t>(payload[1]) |
+                           (static_cast<std::uint32_t>(payload[2]) << 8U) |
+                           (static_cast<std::uint32_t>(payload[3]) << 16U) |
+                           (static_cast<std::uint32_t>(payload[4]) << 24U);
+        if (*cmd_type == CommandType::kComStmtExecute && payload.size() > 5) {
+            cmd.execute_flags = payload[5];
+        }
     }
 
     return cmd;
 }
+
+}  // namespace
+
+auto extract_command(const MysqlPacket& packet) -> std::expected<CommandPacket, ParseError> {
+    return extract_from_payload(packet.payload(), packet.sequence_id());
+}
+
+auto extract_command(const MysqlPacketView& packet) -> std::expected<CommandPacket, ParseError> {
+    return extract_from_payload(packet.payload(), packet.sequence_id());
+}
+
+auto response_shape(CommandType type) noexcept -> ResponseShape {
+    switch (type) {
+        case CommandType::kComInitDb:
+        case CommandType::kComCreateDb:
+        case CommandType::kComDropDb:
+        case CommandType::kComRefresh:
+        case CommandType::kComStatistics:
+        case CommandType::kComProcessKill:
+        case CommandType::kComPing:
+        case CommandType::kComStmtReset:
+            return ResponseShape::kSinglePacket;
+        case CommandType::kComFieldList:
+            return ResponseShape::kFieldList;
+        default:
+            return ResponseShape::kGeneric;
+    }
+}
@@ -5,7 +5,7 @@
 
 #include <cstdint>
 #include <expected>
-#include <string>
+#include <string_view>
 
 // ---------------------------------------------------------------------------
 // CommandType
@@ -13,23 +13,25 @@
 //   핸드셰이크 완료 이후의 커맨드 패킷 첫 바이트에 대응한다.
 // ---------------------------------------------------------------------------
 enum class CommandType : std::uint8_t {
-    kComQuit        = 0x01,  // COM_QUIT
-    kComInitDb      = 0x02,  // COM_INIT_DB  (USE database)
-    kComQuery       = 0x03,  // COM_QUERY    (SQL 문 실행)
-    kComFieldList   = 0x04,  // COM_FIELD_LIST
-    kComCreateDb    = 0x05,  // COM_CREATE_DB
-    kComDropDb      = 0x06,  // COM_DROP_DB
-    kComRefresh     = 0x07,  // COM_REFRESH
-    kComStatistics  = 0x09,  // COM_STATISTICS
-    kComProcessInfo = 0x0A,  // COM_PROCESS_INFO
-    kComConnect     = 0x0B,  // COM_CONNECT
-    kComProcessKill = 0x0C,  // COM_PROCESS_KILL
-    kComPing        = 0x0E,  // COM_PING
-    kComStmtPrepare = 0x16,  // COM_STMT_PREPARE
-    kComStmtExecute = 0x17,  // COM_STMT_EXECUTE
-    kComStmtClose   = 0x19,  // COM_STMT_CLOSE
-    kComStmtReset   = 0x1A,  // COM_STMT_RESET
-    kComUnknown     = 0xFF,  // 미분류 / 파싱 불가
+    kComQuit             = 0x01,  // COM_QUIT
+    kComInitDb           = 0x02,  // COM_INIT_DB  (USE database)
+    kComQuery            = 0x03,  // COM_QUERY    (SQL 문 실행)
+    kComFieldList        = 0x04,  // COM_FIELD_LIST
+    kComCreateDb         = 0x05,  // COM_CREATE_DB
+    kComDropDb           = 0x06,  // COM_DROP_DB
+    kComRefresh          = 0x07,  // COM_REFRESH
+    kComStatistics       = 0x09,  // COM_STATISTICS
+    kComProcessInfo      = 0x0A,  // COM_PROCESS_INFO
+    kComConnect          = 0x0B,  // COM_CONNECT
+    kComProcessKill      = 0x0C,  // COM_PROCESS_KILL
+    kComPing             = 0x0E,  // COM_PING
+    kComStmtPrepare      = 0x16,  // COM_STMT_PREPARE
+    kComStmtExecute      = 0x17,  // COM_STMT_EXECUTE
+    kComStmtSendLongData = 0x18,  // COM_STMT_SEND_LONG_DATA (서버 응답 없음)
+    kComStmtClose        = 0x19,  // COM_STMT_CLOSE (서버 응답 없음)
+    kComStmtReset        = 0x1A,  // COM_STMT_RESET
+    kComStmtFetch        = 0x1C,  // COM_STMT_FETCH (커서)
+    kComUnknown          = 0xFF,  // 미분류 / 파싱 불가
 };
 
 // ---------------------------------------------------------------------------
@@ -37,13 +39,21 @@ enum class CommandType : std::uint8_t {
 //   핸드셰이크 이후 클라이언트가 보내는 단일 커맨드를 나타낸다.
 //
 //   command_type : COM_* 종류
-//   query        : COM_QUERY 의 경우 SQL 문자열 (다른 커맨드는 빈 문자열)
+//   query        : COM_QUERY / COM_STMT_PREPARE 의 SQL 문자열 (다른 커맨드는 빈 문자열)
+//   statement_id : COM_STMT_EXECUTE / SEND_LONG_DATA / CLOSE / RESET / FETCH 의 대상 statement
+//   execute_flags: COM_STMT_EXECUTE 의 flags 바이트 (커서 종류, 0 = CURSOR_TYPE_NO_CURSOR)
 //   sequence_id  : MySQL 패킷 시퀀스 번호 (응답 생성 시 +1)
+//
+//   [빌린 뷰 — 수명 주의]
+//   query 는 추출 원본 패킷의 payload 를 가리킨다 (복사 없음). 세션에서는 client_buf_ 위의
+//   패킷이므로 해당 커맨드 처리가 끝날 때까지만 유효하다. 더 오래 보관하려면 사본을 만든다.
 // ---------------------------------------------------------------------------
 struct CommandPacket {
-    CommandType  command_type{CommandType::kComUnknown};
-    std::string  query{};        // COM_QUERY payload (UTF-8 SQL)
-    std::uint8_t sequence_id{0};
+    CommandType      command_type{CommandType::kComUnknown};
+    std::string_view query{};        // COM_QUERY / COM_STMT_PREPARE SQL (패킷 버퍼를 빌림)
+    std::uint32_t    statement_id{0};
+    std::uint8_t     execute_flags{0};
+    std::uint8_t     sequence_id{0};
 };
 
 // ---------------------------------------------------------------------------
@@ -51,11 +61,39 @@ struct CommandPacket {
 //   MysqlPacket 에서 CommandPacket 을 추출한다.
 //
 //   packet 의 페이로드 첫 바이트를 CommandType 으로 해석하며,
-//   COM_QUERY 이면 나머지 바이트를 query 문자열로 설정한다.
+//   COM_QUERY / COM_STMT_PREPARE 이면 나머지 바이트를 query 문자열로 설정한다.
+//   statement 대상 커맨드(COM_STMT_EXECUTE 등)는 statement_id (LE 4바이트) 를 읽는다.
 //
 //   실패 조건:
 //     - 페이로드가 비어 있음  -> ParseErrorCode::kMalformedPacket
+//     - statement_id 가 잘림  -> ParseErrorCode::kMalformedPacket
 //     - 지원하지 않는 커맨드 -> ParseErrorCode::kUnsupportedCommand
 // ---------------------------------------------------------------------------
 auto extract_command(const MysqlPacket& packet)
     -> std::expected<CommandPacket, ParseError>;
+
+// 임시 패킷에서 추출하면 query 가 즉시 끊어진 뷰가 되므로 금지한다.
+auto extract_command(MysqlPacket&& packet)
+    -> std::expected<CommandPacket, ParseError> = delete;
+
+// MysqlPacketView 오버로드 — 릴레이 버퍼 위의 패킷에서 직접 추출한다.
+// COM_QUERY SQL 도 복사하지 않고 버퍼를 가리킨다.
+auto extract_command(const MysqlPacketView& packet)
+    -> std::expected<CommandPacket, ParseError>;
+
+// ---------------------------------------------------------------------------
+// ResponseShape / response_shape
+//   커맨드별 서버 응답 모양. 릴레이는 이 값으로 응답 끝을 판정한다.
+//
+//   kSinglePacket : 응답이 패킷 1개 (OK / ERR / COM_STATISTICS 문자열 등)
+//                   — 첫 바이트를 column count 로 해석하지 않는다.
+//   kFieldList    : COM_FIELD_LIST — column definition 들 뒤 EOF (또는 ERR 1개)
+//   kGeneric      : OK / ERR / Result Set 판별 상태 머신 (COM_QUERY, COM_STMT_* 등)
+// ---------------------------------------------------------------------------
+enum class ResponseShape : std::uint8_t {
+    kSinglePacket,
+    kFieldList,
+    kGeneric,
+};
+
+[[nodiscard]] auto response_shape(CommandType type) noexcept -> ResponseShape;
@@ -1,5 +1,9 @@
 #include "protocol/handshake.hpp"
 
+#include <openssl/rand.h>
+
+#include <algorithm>
+#include <array>
 #include <boost/asio/read.hpp>
 #include <boost/asio/redirect_error.hpp>
 #include <boost/asio/use_awaitable.hpp>
@@ -184,9 +188,8 @@ auto strip_unsupported_client_capabilities(const MysqlPacket& pkt) -> std::vecto
         return bytes;
     }
 
-    constexpr std::uint32_t unsupported_mask = 0x00000800U     // CLIENT_SSL
-                                               | 0x01000000U   // CLIENT_DEPRECATE_EOF
-                                               | 0x08000000U;  // CLIENT_QUERY_ATTRIBUTES
+    // CLIENT_SSL | CLIENT_DEPRECATE_EOF | CLIENT_QUERY_ATTRIBUTES
+    constexpr std::uint32_t unsupported_mask = detail::kUnsupportedCapabilities;
 
     // serialized bytes에서 payload 시작 오프셋은 4
     std::uint32_t cap_flags = static_cast<std::uint32_t>(bytes[4]) |
@@ -660,6 +663,187 @@ auto extract_handshake_response_fields(std::span<const std::uint8_t> payload,
     return std::expected<void, ParseError>{};
 }
 
+// ---------------------------------------------------------------------------
+// 연결 풀 경로 — 패킷 빌더
+// ---------------------------------------------------------------------------
+
+namespace {
+
+constexpr std::uint32_t kClientConnectWithDb = 0x00000008U;
+constexpr std::uint32_t kClientCompress = 0x00000020U;
+constexpr std::uint32_t kClientProtocol41 = 0x00000200U;
+constexpr std::uint32_t kClientSecureConnection = 0x00008000U;
+constexpr std::uint32_t kClientPluginAuth = 0x00080000U;
+constexpr std::uint32_t kClientConnectAttrs = 0x00100000U;
+constexpr std::uint32_t kClientZstdCompression = 0x04000000U;
+
+constexpr std::size_t kScrambleLength = 20;
+
+auto read_u32_le(std::span<const std::uint8_t> data, std::size_t pos) noexcept -> std::uint32_t {
+    return static_cast<std::uint32_t>(data[pos]) |
+           (static_cast<std::uint32_t>(data[pos + 1]) << 8U) |
+           (static_cast<std::uint32_t>(data[pos + 2]) << 16U) |
+           (static_cast<std::uint32_t>(data[pos + 3]) << 24U);
+}
+
+void append_u32_le(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    for (unsigned shift = 0; shift < 32U; shift += 8U) {
+        out.push_back(static_cast<std::uint8_t>((value >> shift) & 0xFFU));
+    }
+}
+
+void append_nul_string(std::vector<std::uint8_t>& out, std::string_view text) {
+    out.insert(out.end(), text.begin(), text.end());
+    out.push_back(0x00);
+}
+
+// payload 앞에 4바이트 헤더를 채운다 (out[0..4) 는 자리만 잡아 둔 상태)
+void finish_packet(std::vector<std::uint8_t>& out, std::uint8_t sequence_id) {
+    const auto payload_len = static_cast<std::uint32_t>(out.size() - 4);
+    out[0] = static_cast<std::uint8_t>(payload_len & 0xFFU);
+    out[1] = static_cast<std::uint8_t>((payload_len >> 8U) & 0xFFU);
+    out[2] = static_cast<std::uint8_t>((payload_len >> 16U) & 0xFFU);
+    out[3] = sequence_id;
+}
+
+auto pool_error(std::string message, std::string context = {}) -> ParseError {
+    return ParseError{.code = ParseErrorCode::kMalformedPacket,
+                      .message = std::move(message),
+                      .context = std::move(context)};
+}
+
+}  // namespace
+
+auto make_pooled_greeting(std::span<const std::uint8_t> greeting_packet,
+                          std::span<const std::uint8_t> scramble)
+    -> std::expected<std::vector<std::uint8_t>, ParseError> {
+    if (scramble.size() != kScrambleLength) {
+        return std::unexpected(
+            pool_error("pooled greeting scramble must be 20 bytes",
+                       std::format("size={}", scramble.size())));
+    }
+    if (greeting_packet.size() < 5 || greeting_packet[4] != 0x0A) {
+        return std::unexpected(pool_error("greeting template is not a HandshakeV10 packet"));
+    }
+
+    const auto payload = greeting_packet.subspan(4);
+
+    // server_version NUL
+    std::size_t pos = 1;
+    while (pos < payload.size() && payload[pos] != 0x00) {
+        ++pos;
+    }
+    ++pos;
+
+    // connection_id(4) | part1(8) | filler(1) | cap1(2) | charset(1) | status(2) | cap2(2)
+    // | auth_plugin_data_len(1) | reserved(10) | part2(13)
+    const std::size_t part1_pos = pos + 4;
+    const std::size_t cap1_pos = part1_pos + 9;
+    const std::size_t cap2_pos = cap1_pos + 5;
+    const std::size_t auth_len_pos = cap2_pos + 2;
+    const std::size_t part2_pos = auth_len_pos + 11;
+    if (part2_pos + 13 > payload.size()) {
+        return std::unexpected(pool_error("greeting template truncated",
+                                          std::format("payload size={}", payload.size())));
+    }
+
+    const std::uint32_t server_caps =
+        static_cast<std::uint32_t>(payload[cap1_pos]) |
+        (static_cast<std::uint32_t>(payload[cap1_pos + 1]) << 8U) |
+        (static_cast<std::uint32_t>(payload[cap2_pos]) << 16U) |
+        (static_cast<std::uint32_t>(payload[cap2_pos + 1]) << 24U);
+    if ((server_caps & kClientPluginAuth) == 0U || (server_caps & kClientSecureConnection) == 0U) {
+        return std::unexpected(
+            pool_error("greeting template lacks CLIENT_PLUGIN_AUTH/CLIENT_SECURE_CONNECTION",
+                       std::format("server_caps=0x{:08X}", server_caps)));
+    }
+    if (payload[auth_len_pos] != kScrambleLength + 1) {
+        return std::unexpected(
+            pool_error("greeting template auth_plugin_data length unsupported",
+                       std::format("len={}", payload[auth_len_pos])));
+    }
+
+    std::vector<std::uint8_t> out(greeting_packet.begin(), greeting_packet.end());
+    std::copy_n(scramble.begin(), 8, out.begin() + static_cast<std::ptrdiff_t>(4 + part1_pos));
+    std::copy_n(scramble.begin() + 8,
+                kScrambleLength - 8,
+                out.begin() + static_cast<std::ptrdiff_t>(4 + part2_pos));
+    return out;
+}
+
+auto parse_client_handshake(std::span<const std::uint8_t> payload)
+    -> std::expected<ClientHandshake, ParseError> {
+    ClientHandshake client;
+    if (auto fields = extract_handshake_response_fields(payload, client.user, client.db); !fields) {
+        return std::unexpected(fields.error());
+    }
+
+    const std::uint32_t flags = read_u32_le(payload, 0);
+    if ((flags & kClientProtocol41) == 0U || (flags & kClientPluginAuth) == 0U) {
+        return std::unexpected(
+            pool_error("client does not support CLIENT_PROTOCOL_41/CLIENT_PLUGIN_AUTH",
+                       std::format("flags=0x{:08X}", flags)));
+    }
+    if ((flags & (kClientCompress | kClientZstdCompression)) != 0U) {
+        return std::unexpected(pool_error("compressed protocol is not supported",
+                                          std::format("flags=0x{:08X}", flags)));
+    }
+
+    client.capability_flags = flags & ~kUnsupportedCapabilities;
+    client.max_packet_size = read_u32_le(payload, 4);
+    client.charset = payload[8];
+    return client;
+}
+
+auto build_reauth_response(const ClientHandshake& client) -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> out(4, 0x00);
+    out.reserve(4 + 32 + client.user.size() + client.db.size() + kPoolReauthPlugin.size() + 8);
+
+    append_u32_le(out, client.capability_flags);
+    append_u32_le(out, client.max_packet_size);
+    out.push_back(client.charset);
+    out.insert(out.end(), 23, 0x00);
+
+    append_nul_string(out, client.user);
+    // 빈 auth_response: lenenc / 1B 길이 / NUL 종료 세 인코딩 모두 0x00 한 바이트
+    out.push_back(0x00);
+    if ((client.capability_flags & kClientConnectWithDb) != 0U) {
+        append_nul_string(out, client.db);
+    }
+    append_nul_string(out, kPoolReauthPlugin);
+    if ((client.capability_flags & kClientConnectAttrs) != 0U) {
+        out.push_back(0x00);  // attribute 블록 길이 0
+    }
+
+    finish_packet(out, 1);
+    return out;
+}
+
+auto build_change_user(const ClientHandshake& client, std::uint32_t negotiated_flags)
+    -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> out(4, 0x00);
+    out.reserve(4 + 8 + client.user.size() + client.db.size() + kPoolReauthPlugin.size());
+
+    out.push_back(0x11);  // COM_CHANGE_USER
+    append_nul_string(out, client.user);
+    // 빈 auth_response: CLIENT_SECURE_CONNECTION 이면 1B 길이 0, 아니면 빈 NUL 종료 문자열
+    out.push_back(0x00);
+    append_nul_string(out, client.db);
+    if ((negotiated_flags & kClientProtocol41) != 0U) {
+        out.push_back(client.charset);
+        out.push_back(0x00);
+    }
+    if ((negotiated_flags & kClientPluginAuth) != 0U) {
+        append_nul_string(out, kPoolReauthPlugin);
+    }
+    if ((negotiated_flags & kClientConnectAttrs) != 0U) {
+        out.push_back(0x00);
+    }
+
+    finish_packet(out, 0);
+    return out;
+}
+
 }  // namespace detail
 
 // ===========================================================================
@@ -672,7 +856,8 @@ auto extract_handshake_response_fields(std::span<const std::uint8_t> payload,
 // static
 auto HandshakeRelay::relay_handshake(AsyncStream& client_stream,
                                      AsyncStream& server_stream,
-                                     SessionContext& ctx)
+                                     SessionContext& ctx,
+                                     HandshakeCapture* capture)
     -> boost::asio::awaitable<std::expected<void, ParseError>> {
     detail::HandshakeState state = detail::HandshakeState::kWaitServerGreeting;
     int round_trips = 0;
@@ -714,6 +899,12 @@ auto HandshakeRelay::relay_handshake(AsyncStream& client_stream,
                 co_return std::unexpected(extract_result.error());
             }
             fields_extracted = true;
+
+            if (capture != nullptr) {
+                auto client = detail::parse_client_handshake(payload);
+                capture->client =
+                    client ? std::optional<ClientHandshake>{std::move(*client)} : std::nullopt;
+            }
         }
 
         // 순수 함수로 상태 전이 판단
@@ -732,6 +923,12 @@ auto HandshakeRelay::relay_handshake(AsyncStream& client_stream,
                     // 프록시는 TLS 미지원 — SSL 광고를 유지하면 클라이언트가
                     // SSLRequest(32B)를 보내 HandshakeResponse41 파싱 실패
                     const auto modified = strip_unsupported_capabilities(pkt);
+                    // 풀 경로에서 scramble 을 교체할 수 있는 greeting 만 원형으로 캡처한다
+                    static constexpr std::array<std::uint8_t, 20> kProbeScramble{};
+                    if (capture != nullptr &&
+                        detail::make_pooled_greeting(modified, kProbeScramble)) {
+                        capture->server_greeting = modified;
+                    }
                     boost::system::error_code write_ec;
                     co_await boost::asio::async_write(
                         client_stream,
@@ -824,3 +1021,265 @@ auto HandshakeRelay::relay_handshake(AsyncStream& client_stream,
     co_return std::unexpected(ParseError{
         .code = ParseErrorCode::kMalformedPacket, .message = "handshake failed", .context = {}});
 }
+
+// ===========================================================================
+// 연결 풀 경로 — accept_client / authenticate_fresh / change_user / reset_connection
+// ===========================================================================
+
+namespace {
+
+// ER_NOT_SUPPORTED_AUTH_MODE: 풀 경로를 쓸 수 없는 클라이언트에 반환
+constexpr std::uint16_t kErrNotSupportedAuthMode = 1251;
+
+auto write_bytes(AsyncStream& stream, std::span<const std::uint8_t> bytes)
+    -> boost::asio::awaitable<std::expected<void, ParseError>> {
+    boost::system::error_code ec;
+    co_await boost::asio::async_write(stream,
+                                      boost::asio::buffer(bytes.data(), bytes.size()),
+                                      boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return std::unexpected(ParseError{.code = ParseErrorCode::kInternalError,
+                                             .message = "failed to write packet",
+                                             .context = ec.message()});
+    }
+    co_return std::expected<void, ParseError>{};
+}
+
+// 시퀀스 번호를 바꿔 전달한다 (풀 경로는 서버와 클라이언트의 시퀀스가 어긋난다)
+auto forward_with_seq(AsyncStream& stream, const MysqlPacket& pkt, std::uint8_t sequence_id)
+    -> boost::asio::awaitable<std::expected<void, ParseError>> {
+    auto bytes = pkt.serialize();
+    bytes[3] = sequence_id;
+    co_return co_await write_bytes(stream, bytes);
+}
+
+// -----------------------------------------------------------------------
+// relay_reauth_exchange
+//   재인증 요청을 서버에 보낸 뒤의 인증 교환을 릴레이한다 (kWaitServerAuth 부터).
+//   상태 판단은 relay_handshake 와 같은 detail::process_handshake_packet 을 쓴다.
+//
+//   seq_shift   : 클라이언트 시퀀스 = 서버 시퀀스 + seq_shift
+//   relayed_any : [out] 클라이언트에 패킷을 하나라도 전달했는지
+// -----------------------------------------------------------------------
+auto relay_reauth_exchange(AsyncStream& client_stream,
+                           AsyncStream& server_stream,
+                           std::uint8_t seq_shift,
+                           bool& relayed_any)
+    -> boost::asio::awaitable<std::expected<void, ParseError>> {
+    detail::HandshakeState state = detail::HandshakeState::kWaitServerAuth;
+    int round_trips = 0;
+    relayed_any = false;
+
+    while (state != detail::HandshakeState::kDone && state != detail::HandshakeState::kFailed) {
+        const bool read_from_server = (state == detail::HandshakeState::kWaitServerAuth ||
+                                       state == detail::HandshakeState::kWaitServerAuthSwitch ||
+                                       state == detail::HandshakeState::kWaitServerMoreData);
+
+        auto pkt_result = co_await read_packet(read_from_server ? server_stream : client_stream);
+        if (!pkt_result) {
+            co_return std::unexpected(pkt_result.error());
+        }
+        const MysqlPacket& pkt = *pkt_result;
+        const auto payload = pkt.payload();
+
+        auto transition_result = detail::process_handshake_packet(state, payload, round_trips);
+        if (!transition_result) {
+            co_return std::unexpected(transition_result.error());
+        }
+        const detail::HandshakeTransition& transition = *transition_result;
+
+        const auto to_client = static_cast<std::uint8_t>(pkt.sequence_id() + seq_shift);
+        const auto to_server = static_cast<std::uint8_t>(pkt.sequence_id() - seq_shift);
+
+        switch (transition.action) {
+            case detail::HandshakeAction::kRelayToClient: {
+                relayed_any = true;
+                auto write_result = co_await forward_with_seq(client_stream, pkt, to_client);
+                if (!write_result) {
+                    co_return std::unexpected(write_result.error());
+                }
+                break;
+            }
+            case detail::HandshakeAction::kRelayToServer: {
+                auto write_result = co_await forward_with_seq(server_stream, pkt, to_server);
+                if (!write_result) {
+                    co_return std::unexpected(write_result.error());
+                }
+                break;
+            }
+            case detail::HandshakeAction::kComplete: {
+                relayed_any = true;
+                co_return co_await forward_with_seq(client_stream, pkt, to_client);
+            }
+            case detail::HandshakeAction::kTerminate: {
+                relayed_any = true;
+                co_await forward_with_seq(client_stream, pkt, to_client);
+                co_return std::unexpected(ParseError{
+                    .code = ParseErrorCode::kMalformedPacket,
+                    .message = "backend re-authentication failed",
+                    .context =
+                        std::format("state={}, payload[0]=0x{:02X}",
+                                    static_cast<int>(state),
+                                    payload.empty() ? 0U : static_cast<unsigned>(payload[0]))});
+            }
+            case detail::HandshakeAction::kTerminateNoRelay: {
+                co_return std::unexpected(ParseError{
+                    .code = ParseErrorCode::kMalformedPacket,
+                    .message = "unknown auth response packet type during re-authentication",
+                    .context =
+                        std::format("state={}, payload[0]=0x{:02X}",
+                                    static_cast<int>(state),
+                                    payload.empty() ? 0U : static_cast<unsigned>(payload[0]))});
+            }
+        }
+
+        if (transition.next_state == detail::HandshakeState::kWaitClientMoreData ||
+            transition.next_state == detail::HandshakeState::kWaitClientAuthSwitch) {
+            ++round_trips;
+        }
+        state = transition.next_state;
+    }
+
+    co_return std::unexpected(ParseError{.code = ParseErrorCode::kMalformedPacket,
+                                         .message = "backend re-authentication failed",
+                                         .context = {}});
+}
+
+void fill_context(SessionContext& ctx, const ClientHandshake& client) {
+    ctx.db_user = client.user;
+    ctx.db_name = client.db;
+    ctx.handshake_done = true;
+}
+
+}  // namespace
+
+// static
+auto HandshakeRelay::accept_client(AsyncStream& client_stream,
+                                   std::span<const std::uint8_t> greeting_template)
+    -> boost::asio::awaitable<std::expected<ClientHandshake, ParseError>> {
+    // 클라이언트가 첫 응답에 쓰는 scramble. 이 응답의 auth 데이터는 버려지고
+    // 실제 인증은 서버의 AuthSwitchRequest 로 다시 수행되지만, 예측 가능한 값을 쓰지 않는다.
+    std::array<std::uint8_t, 20> scramble{};
+    if (RAND_bytes(scramble.data(), static_cast<int>(scramble.size())) != 1) {
+        co_return std::unexpected(ParseError{.code = ParseErrorCode::kInternalError,
+                                             .message = "RAND_bytes failed for greeting scramble",
+                                             .context = {}});
+    }
+    // MySQL scramble 은 NUL 을 포함하지 않는 출력 가능 문자 범위를 쓴다
+    for (auto& b : scramble) {
+        b = static_cast<std::uint8_t>(33U + (b % 94U));
+    }
+
+    auto greeting = detail::make_pooled_greeting(greeting_template, scramble);
+    if (!greeting) {
+        co_return std::unexpected(greeting.error());
+    }
+    if (auto written = co_await write_bytes(client_stream, *greeting); !written) {
+        co_return std::unexpected(written.error());
+    }
+
+    auto pkt_result = co_await read_packet(client_stream);
+    if (!pkt_result) {
+        co_return std::unexpected(pkt_result.error());
+    }
+
+    auto client = detail::parse_client_handshake(pkt_result->payload());
+    if (!client) {
+        // fail-close: AuthSwitch 를 받을 수 없는 클라이언트는 풀 경로로 인증할 수 없다
+        const auto err_pkt = MysqlPacket::make_error(
+            kErrNotSupportedAuthMode,
+            "Client does not support authentication protocol requested by server",
+            static_cast<std::uint8_t>(pkt_result->sequence_id() + 1));
+        co_await write_packet(client_stream, err_pkt);
+        co_return std::unexpected(client.error());
+    }
+    co_return std::move(*client);
+}
+
+// static
+auto HandshakeRelay::authenticate_fresh(AsyncStream& client_stream,
+                                        AsyncStream& server_stream,
+                                        const ClientHandshake& client,
+                                        SessionContext& ctx)
+    -> boost::asio::awaitable<std::expected<void, ParseError>> {
+    auto greeting = co_await read_packet(server_stream);
+    if (!greeting) {
+        co_return std::unexpected(greeting.error());
+    }
+
+    const auto greeting_payload = greeting->payload();
+    if (greeting_payload.empty() || greeting_payload[0] != 0x0A) {
+        // 서버가 greeting 대신 ERR(0xFF, 예: too many connections)를 보냈으면 그대로 전달
+        if (!greeting_payload.empty() && greeting_payload[0] == 0xFF) {
+            co_await forward_with_seq(client_stream, *greeting, 2);
+        }
+        co_return std::unexpected(ParseError{
+            .code = ParseErrorCode::kMalformedPacket,
+            .message = "unexpected server greeting on pooled path",
+            .context = std::format(
+                "payload[0]=0x{:02X}",
+                greeting_payload.empty() ? 0U : static_cast<unsigned>(greeting_payload[0]))});
+    }
+
+    const auto response = detail::build_reauth_response(client);
+    if (auto written = co_await write_bytes(server_stream, response); !written) {
+        co_return std::unexpected(written.error());
+    }
+
+    // 서버 시퀀스 2 부터 = 클라이언트가 기대하는 시퀀스 (클라이언트 응답이 seq 1)
+    bool relayed_any = false;
+    auto relayed = co_await relay_reauth_exchange(client_stream, server_stream, 0, relayed_any);
+    if (!relayed) {
+        co_return std::unexpected(relayed.error());
+    }
+    fill_context(ctx, client);
+    co_return std::expected<void, ParseError>{};
+}
+
+// static
+auto HandshakeRelay::change_user(AsyncStream& client_stream,
+                                 AsyncStream& server_stream,
+                                 const ClientHandshake& client,
+                                 std::uint32_t negotiated_flags,
+                                 SessionContext& ctx)
+    -> boost::asio::awaitable<std::expected<PooledAuthStatus, ParseError>> {
+    const auto request = detail::build_change_user(client, negotiated_flags);
+    if (auto written = co_await write_bytes(server_stream, request); !written) {
+        co_return PooledAuthStatus::kBackendUnusable;
+    }
+
+    // COM_CHANGE_USER 가 seq 0 이므로 서버 응답은 seq 1 부터, 클라이언트는 seq 2 를 기대한다
+    bool relayed_any = false;
+    auto relayed = co_await relay_reauth_exchange(client_stream, server_stream, 1, relayed_any);
+    if (!relayed) {
+        if (!relayed_any) {
+            co_return PooledAuthStatus::kBackendUnusable;
+        }
+        co_return std::unexpected(relayed.error());
+    }
+    fill_context(ctx, client);
+    co_return PooledAuthStatus::kDone;
+}
+
+// static
+auto HandshakeRelay::reset_connection(AsyncStream& server_stream)
+    -> boost::asio::awaitable<std::expected<void, ParseError>> {
+    static constexpr std::array<std::uint8_t, 5> kComResetConnection{0x01, 0x00, 0x00, 0x00, 0x1F};
+    if (auto written = co_await write_bytes(server_stream, kComResetConnection); !written) {
+        co_return std::unexpected(written.error());
+    }
+
+    auto reply = co_await read_packet(server_stream);
+    if (!reply) {
+        co_return std::unexpected(reply.error());
+    }
+    const auto payload = reply->payload();
+    if (payload.empty() || payload[0] != 0x00) {
+        co_return std::unexpected(ParseError{
+            .code = ParseErrorCode::kMalformedPacket,
+            .message = "COM_RESET_CONNECTION was not acknowledged",
+            .context = std::format("payload[0]=0x{:02X}",
+                                   payload.empty() ? 0U : static_cast<unsigned>(payload[0]))});
+    }
+    co_return std::expected<void, ParseError>{};
+}
@@ -1,7 +1,12 @@
 #pragma once
 
 #include <boost/asio/awaitable.hpp>
+#include <cstdint>
 #include <expected>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
 
 #include "common/async_stream.hpp"
 #include "common/types.hpp"
@@ -27,6 +32,43 @@
 //     - std::unexpected(ParseError) 반환
 //     - 소켓은 호출자가 닫아야 한다.
 // ---------------------------------------------------------------------------
+// ---------------------------------------------------------------------------
+// ClientHandshake
+//   HandshakeResponse41 에서 백엔드 재인증(풀 경로)에 필요한 필드.
+//   capability_flags 는 strip 적용 후 값이다.
+// ---------------------------------------------------------------------------
+struct ClientHandshake {
+    std::uint32_t capability_flags{0};
+    std::uint32_t max_packet_size{0};
+    std::uint8_t charset{0};
+    std::string user{};
+    std::string db{};
+};
+
+// ---------------------------------------------------------------------------
+// HandshakeCapture
+//   relay_handshake() 가 투명 릴레이 중 관찰한 값 (연결 풀 용).
+//   server_greeting : strip 적용 후 클라이언트에 전달한 greeting (헤더 포함).
+//                     풀 경로에 쓸 수 없는 형식이면 비어 있다.
+//   client          : CLIENT_PLUGIN_AUTH 를 지원하지 않는 클라이언트면 nullopt
+// ---------------------------------------------------------------------------
+struct HandshakeCapture {
+    std::vector<std::uint8_t> server_greeting{};
+    std::optional<ClientHandshake> client{};
+};
+
+// ---------------------------------------------------------------------------
+// PooledAuthStatus
+//   change_user() 결과.
+//   kDone            : 재인증 성공 (ctx 가 채워짐). 인증 실패는 unexpected 로 반환된다.
+//   kBackendUnusable : 클라이언트에 아무것도 전달하기 전에 풀 연결이 끊겨 있었음
+//                      — 호출자는 새 연결로 재시도할 수 있다.
+// ---------------------------------------------------------------------------
+enum class PooledAuthStatus : std::uint8_t {
+    kDone,
+    kBackendUnusable,
+};
+
 class HandshakeRelay {
 public:
     HandshakeRelay() = default;
@@ -36,12 +78,57 @@ public:
     //   client_stream : 클라이언트 측 AsyncStream (accept 된 소켓 또는 TLS)
     //   server_stream : MySQL 서버 측 AsyncStream (connect 된 소켓 또는 TLS)
     //   ctx           : [out] db_user, db_name, handshake_done 이 채워진다.
+    //   capture       : [out, 선택] 연결 풀이 사용할 greeting / 클라이언트 필드
     //
     //   반환: 성공 시 std::expected<void, ParseError>{}
     //         실패 시 std::unexpected(ParseError)
     // -----------------------------------------------------------------------
     static auto relay_handshake(AsyncStream& client_stream,
                                 AsyncStream& server_stream,
-                                SessionContext& ctx)
+                                SessionContext& ctx,
+                                HandshakeCapture* capture = nullptr)
+        -> boost::asio::awaitable<std::expected<void, ParseError>>;
+
+    // -----------------------------------------------------------------------
+    // 연결 풀 경로 (BackendPool)
+    //
+    //   클라이언트에는 greeting_template 에 새 scramble 을 넣은 greeting 을 보내고
+    //   (accept_client), 서버 연결은 새로 인증하거나(authenticate_fresh) 풀에서 꺼낸
+    //   연결을 COM_CHANGE_USER 로 재인증한다(change_user).
+    //
+    //   두 경우 모두 서버가 모르는 auth plugin 이름으로 요청하여 서버가
+    //   AuthSwitchRequest 를 보내게 하고, 그 뒤의 인증 교환은 클라이언트 ↔ 서버 간에
+    //   그대로 릴레이한다 (시퀀스 번호만 보정). 프록시는 자격 증명을 다루지 않는다.
+    // -----------------------------------------------------------------------
+
+    // accept_client
+    //   greeting_template 기반 greeting 전송 후 HandshakeResponse41 을 읽는다.
+    //   CLIENT_PLUGIN_AUTH 미지원 클라이언트는 AuthSwitch 를 받을 수 없으므로 실패한다.
+    static auto accept_client(AsyncStream& client_stream,
+                              std::span<const std::uint8_t> greeting_template)
+        -> boost::asio::awaitable<std::expected<ClientHandshake, ParseError>>;
+
+    // authenticate_fresh
+    //   새로 연결한 서버의 greeting 을 읽고 재인증 응답을 보낸 뒤 인증 교환을 릴레이한다.
+    //   성공 시 ctx.db_user / db_name / handshake_done 이 채워진다.
+    static auto authenticate_fresh(AsyncStream& client_stream,
+                                   AsyncStream& server_stream,
+                                   const ClientHandshake& client,
+                                   SessionContext& ctx)
+        -> boost::asio::awaitable<std::expected<void, ParseError>>;
+
+    // change_user
+    //   풀 연결에 COM_CHANGE_USER 를 보내고 인증 교환을 릴레이한다.
+    //   negotiated_flags : 풀 연결이 서버와 협상한 capability
+    static auto change_user(AsyncStream& client_stream,
+                            AsyncStream& server_stream,
+                            const ClientHandshake& client,
+                            std::uint32_t negotiated_flags,
+                            SessionContext& ctx)
+        -> boost::asio::awaitable<std::expected<PooledAuthStatus, ParseError>>;
+
+    // reset_connection
+    //   COM_RESET_CONNECTION 을 보내고 OK 를 확인한다. 실패 시 연결은 재사용하면 안 된다.
+    static auto reset_connection(AsyncStream& server_stream)
         -> boost::asio::awaitable<std::expected<void, ParseError>>;
 };
@@ -11,11 +11,14 @@
 // ---------------------------------------------------------------------------
 
 #include "common/types.hpp"
+#include "protocol/handshake.hpp"
 
 #include <cstdint>
 #include <expected>
 #include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace detail {
 
@@ -117,4 +120,51 @@ auto extract_handshake_response_fields(
     std::string&                  out_user,
     std::string&                  out_db) noexcept -> std::expected<void, ParseError>;
 
+// ---------------------------------------------------------------------------
+// 연결 풀 경로 (HandshakeRelay::accept_client / authenticate_fresh / change_user)
+// ---------------------------------------------------------------------------
+
+// 프록시가 서버/클라이언트 양쪽에서 제거하는 capability
+//   CLIENT_SSL | CLIENT_DEPRECATE_EOF | CLIENT_QUERY_ATTRIBUTES
+inline constexpr std::uint32_t kUnsupportedCapabilities = 0x00000800U | 0x01000000U | 0x08000000U;
+
+// 재인증 요청에 쓰는 auth plugin 이름.
+// 서버에 없는 이름이어야 서버가 계정의 plugin 으로 AuthSwitchRequest 를 보낸다.
+inline constexpr std::string_view kPoolReauthPlugin = "dbgate_pool_reauth";
+
+// ---------------------------------------------------------------------------
+// make_pooled_greeting
+//   greeting_packet(헤더 포함 HandshakeV10)의 auth_plugin_data 를 scramble(20B)로 교체한다.
+//   CLIENT_PLUGIN_AUTH / CLIENT_SECURE_CONNECTION 이 없거나 auth_plugin_data 길이가
+//   21(20B + NUL)이 아니면 실패한다.
+// ---------------------------------------------------------------------------
+auto make_pooled_greeting(std::span<const std::uint8_t> greeting_packet,
+                          std::span<const std::uint8_t> scramble)
+    -> std::expected<std::vector<std::uint8_t>, ParseError>;
+
+// ---------------------------------------------------------------------------
+// parse_client_handshake
+//   HandshakeResponse41 payload 를 ClientHandshake 로 해석한다 (capability 는 strip 적용).
+//   풀 경로가 지원하지 않는 클라이언트는 실패한다:
+//     CLIENT_PROTOCOL_41 / CLIENT_PLUGIN_AUTH 미설정, CLIENT_COMPRESS / ZSTD 압축 요청.
+// ---------------------------------------------------------------------------
+auto parse_client_handshake(std::span<const std::uint8_t> payload)
+    -> std::expected<ClientHandshake, ParseError>;
+
+// ---------------------------------------------------------------------------
+// build_reauth_response
+//   새 서버 연결에 보낼 HandshakeResponse41 패킷 (헤더 포함, seq 1).
+//   auth_response 는 비우고 plugin 은 kPoolReauthPlugin 으로 보낸다.
+//   CLIENT_CONNECT_ATTRS 가 있으면 빈 attribute 블록을 붙인다.
+// ---------------------------------------------------------------------------
+auto build_reauth_response(const ClientHandshake& client) -> std::vector<std::uint8_t>;
+
+// ---------------------------------------------------------------------------
+// build_change_user
+//   풀 연결에 보낼 COM_CHANGE_USER 패킷 (헤더 포함, seq 0).
+//   negotiated_flags 에 따라 auth_response / charset / plugin / attrs 를 인코딩한다.
+// ---------------------------------------------------------------------------
+auto build_change_user(const ClientHandshake& client, std::uint32_t negotiated_flags)
+    -> std::vector<std::uint8_t>;
+
 }  // namespace detail
@@ -45,11 +45,9 @@ auto detect_packet_type(std::span<const std::uint8_t> payload) noexcept -> Packe
     }
 }
 
-}  // namespace
-
-// static
-auto MysqlPacket::parse(std::span<const std::uint8_t> data)
-    -> std::expected<MysqlPacket, ParseError> {
+// 헤더 검증 후 payload 길이를 돌려준다. MysqlPacket / MysqlPacketView 공용.
+auto validate_header(std::span<const std::uint8_t> data)
+    -> std::expected<std::uint32_t, ParseError> {
     // 헤더 최소 4바이트 검증
     if (data.size() < 4) {
         return std::unexpected(
@@ -71,17 +69,19 @@ auto MysqlPacket::parse(std::span<const std::uint8_t> data)
             .context = std::format("declared length={}, available={}", length, data.size() - 4)});
     }
 
-    MysqlPacket pkt;
-    pkt.sequence_id_ = data[3];
-
-    // payload 복사
-    const auto* payload_begin = data.data() + 4;
-    pkt.payload_.assign(payload_begin, payload_begin + length);
+    return length;
+}
 
-    // PacketType 판별
-    pkt.type_ = detect_packet_type(std::span<const std::uint8_t>{pkt.payload_});
+}  // namespace
 
-    return pkt;
+// static
+auto MysqlPacket::parse(std::span<const std::uint8_t> data)
+    -> std::expected<MysqlPacket, ParseError> {
+    const auto view = MysqlPacketView::parse(data);
+    if (!view) {
+        return std::unexpected(view.error());
+    }
+    return view->to_packet();
 }
 
 auto MysqlPacket::sequence_id() const noexcept -> std::uint8_t {
@@ -177,3 +177,65 @@ auto MysqlPacket::make_error(std::uint16_t error_code,
 
     return pkt;
 }
+
+// static
+auto MysqlPacket::make_eof(std::uint16_t warnings,
+                           std::uint16_t status_flags,
+                           std::uint8_t sequence_id) -> MysqlPacket {
+    MysqlPacket pkt;
+    pkt.sequence_id_ = sequence_id;
+    pkt.type_ = PacketType::kEof;
+    pkt.payload_ = {0xFE,
+                    static_cast<std::uint8_t>(warnings & 0xFFU),
+                    static_cast<std::uint8_t>((warnings >> 8U) & 0xFFU),
+                    static_cast<std::uint8_t>(status_flags & 0xFFU),
+                    static_cast<std::uint8_t>((status_flags >> 8U) & 0xFFU)};
+    return pkt;
+}
+
+// ---------------------------------------------------------------------------
+// MysqlPacketView — 구현
+// ---------------------------------------------------------------------------
+
+// static
+auto MysqlPacketView::parse(std::span<const std::uint8_t> data)
+    -> std::expected<MysqlPacketView, ParseError> {
+    const auto length = validate_header(data);
+    if (!length) {
+        return std::unexpected(length.error());
+    }
+
+    MysqlPacketView view;
+    view.raw_ = data.first(static_cast<std::size_t>(4) + *length);
+    view.type_ = detect_packet_type(view.payload());
+    return view;
+}
+
+auto MysqlPacketView::sequence_id() const noexcept -> std::uint8_t {
+    return raw_.size() >= 4 ? raw_[3] : std::uint8_t{0};
+}
+
+auto MysqlPacketView::payload_length() const noexcept -> std::uint32_t {
+    return static_cast<std::uint32_t>(payload().size());
+}
+
+auto MysqlPacketView::payload() const noexcept -> std::span<const std::uint8_t> {
+    return raw_.size() >= 4 ? raw_.subspan(4) : std::span<const std::uint8_t>{};
+}
+
+auto MysqlPacketView::type() const noexcept -> PacketType {
+    return type_;
+}
+
+auto MysqlPacketView::raw() const noexcept -> std::span<const std::uint8_t> {
+    return raw_;
+}
+
+auto MysqlPacketView::to_packet() const -> MysqlPacket {
+    MysqlPacket pkt;
+    pkt.sequence_id_ = sequence_id();
+    const auto body = payload();
+    pkt.payload_.assign(body.begin(), body.end());
+    pkt.type_ = type_;
+    return pkt;
+}
@@ -35,6 +35,7 @@ enum class PacketType : std::uint8_t {
 //   parse()  : 원시 바이트에서 MysqlPacket 으로 변환
 //   serialize(): MysqlPacket 을 원시 바이트로 변환
 //   make_error(): ERR Packet 을 생성하는 정적 팩토리
+//   make_eof()  : EOF Packet 을 생성하는 정적 팩토리
 // ---------------------------------------------------------------------------
 class MysqlPacket {
 public:
@@ -77,8 +78,64 @@ public:
                            std::string_view message,
                            std::uint8_t    sequence_id) -> MysqlPacket;
 
+    // -----------------------------------------------------------------------
+    // make_eof
+    //   MySQL EOF Packet (CLIENT_DEPRECATE_EOF 미사용 형식) 을 생성한다.
+    //   payload: [0xFE][2바이트 warnings LE][2바이트 status_flags LE]
+    //   결과 셋을 프록시가 직접 끝낼 때 (max_result_rows truncate) 사용한다.
+    // -----------------------------------------------------------------------
+    static auto make_eof(std::uint16_t warnings,
+                         std::uint16_t status_flags,
+                         std::uint8_t  sequence_id) -> MysqlPacket;
+
 private:
+    friend class MysqlPacketView;
+
     std::uint8_t              sequence_id_{0};
     std::vector<std::uint8_t> payload_{};
     PacketType                type_{PacketType::kUnknown};
 };
+
+// ---------------------------------------------------------------------------
+// MysqlPacketView
+//   호출자 버퍼 위의 MySQL 패킷 1개를 복사 없이 가리키는 비소유 뷰.
+//
+//   릴레이 경로(서버 응답 row, 투명 릴레이 커맨드)는 payload 를 해석만 하고
+//   원본 바이트를 그대로 전달하므로 MysqlPacket 으로 복사할 필요가 없다.
+//   raw() 는 헤더 4바이트를 포함한 와이어 바이트 그대로이며 serialize() 결과와 같다.
+//
+//   [수명]
+//   뷰는 parse() 에 넘긴 버퍼를 참조한다. 버퍼를 재사용(다음 패킷 읽기)하거나
+//   해제하면 뷰와 payload() span 은 무효가 된다. 보관이 필요하면 to_packet().
+// ---------------------------------------------------------------------------
+class MysqlPacketView {
+public:
+    MysqlPacketView() = default;
+
+    // -----------------------------------------------------------------------
+    // parse
+    //   MysqlPacket::parse 와 동일한 검증을 수행하되 payload 를 복사하지 않는다.
+    //   data 가 선언 길이보다 길면 뒤쪽 바이트는 무시한다 (raw() 에 포함되지 않음).
+    //
+    //   실패 시: std::unexpected(ParseError)
+    // -----------------------------------------------------------------------
+    static auto parse(std::span<const std::uint8_t> data)
+        -> std::expected<MysqlPacketView, ParseError>;
+
+    [[nodiscard]] auto sequence_id()     const noexcept -> std::uint8_t;
+    [[nodiscard]] auto payload_length()  const noexcept -> std::uint32_t;
+    [[nodiscard]] auto payload()         const noexcept
+        -> std::span<const std::uint8_t>;
+    [[nodiscard]] auto type()            const noexcept -> PacketType;
+
+    // 헤더 + payload 원본 바이트 (그대로 async_write 가능)
+    [[nodiscard]] auto raw()             const noexcept
+        -> std::span<const std::uint8_t>;
+
+    // 소유 패킷으로 복사 (뷰 수명을 넘겨 보관해야 할 때만 사용)
+    [[nodiscard]] auto to_packet() const -> MysqlPacket;
+
+private:
+    std::span<const std::uint8_t> raw_{};
+    PacketType                    type_{PacketType::kUnknown};
+};
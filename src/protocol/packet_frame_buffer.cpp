@@ -0,0 +1,115 @@
+#include "protocol/packet_frame_buffer.hpp"
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+// PacketFrameBuffer — 구현
+// ---------------------------------------------------------------------------
+
+namespace {
+
+constexpr std::size_t kHeaderSize = 4;
+
+auto declared_length(std::span<const std::uint8_t> header) noexcept -> std::size_t {
+    return static_cast<std::size_t>(header[0]) | (static_cast<std::size_t>(header[1]) << 8U) |
+           (static_cast<std::size_t>(header[2]) << 16U);
+}
+
+}  // namespace
+
+auto PacketFrameBuffer::prepare(std::size_t min_free) -> std::span<std::uint8_t> {
+    const std::size_t pending = end_ - begin_;
+
+    if (pending == 0 && buf_.size() > kRetainMax && min_free <= kDefaultCapacity) {
+        std::vector<std::uint8_t>(kDefaultCapacity).swap(buf_);
+        begin_ = 0;
+        end_ = 0;
+    }
+
+    if (buf_.size() - end_ < min_free) {
+        // 소비된 앞부분을 회수한다 (pending 은 보통 미완성 패킷 1개 분량으로 작다)
+        if (begin_ > 0) {
+            std::copy(buf_.begin() + static_cast<std::ptrdiff_t>(begin_),
+                      buf_.begin() + static_cast<std::ptrdiff_t>(end_),
+                      buf_.begin());
+            begin_ = 0;
+            end_ = pending;
+        }
+        if (buf_.size() - end_ < min_free) {
+            buf_.resize(std::max(end_ + min_free, kDefaultCapacity));
+        }
+    }
+
+    return std::span<std::uint8_t>{buf_}.subspan(end_);
+}
+
+void PacketFrameBuffer::commit(std::size_t n) noexcept {
+    end_ = std::min(end_ + n, buf_.size());
+}
+
+auto PacketFrameBuffer::peek(std::size_t offset) const noexcept
+    -> std::optional<MysqlPacketView> {
+    const auto data = readable();
+    if (offset > data.size() || data.size() - offset < kHeaderSize) {
+        return std::nullopt;
+    }
+    const auto rest = data.subspan(offset);
+    const std::size_t total = kHeaderSize + declared_length(rest);
+    if (rest.size() < total) {
+        return std::nullopt;
+    }
+    // 길이 검증을 마쳤으므로 실패하지 않는다 (에러 문자열 생성 비용 없음)
+    auto view = MysqlPacketView::parse(rest.first(total));
+    if (!view) {
+        return std::nullopt;
+    }
+    return *view;
+}
+
+auto PacketFrameBuffer::peek_head(std::size_t offset, std::size_t min_prefix) const noexcept
+    -> std::optional<FrameHead> {
+    const auto data = readable();
+    if (offset > data.size() || data.size() - offset < kHeaderSize) {
+        return std::nullopt;
+    }
+    const auto rest = data.subspan(offset);
+    const std::size_t length = declared_length(rest);
+    const std::size_t have = std::min(rest.size() - kHeaderSize, length);
+    if (have < std::min(min_prefix, length)) {
+        return std::nullopt;
+    }
+    return FrameHead{.payload_length = static_cast<std::uint32_t>(length),
+                     .sequence_id = rest[3],
+                     .prefix = rest.subspan(kHeaderSize, have)};
+}
+
+auto PacketFrameBuffer::missing(std::size_t offset) const noexcept -> std::size_t {
+    const auto data = readable();
+    const std::size_t have = offset < data.size() ? data.size() - offset : 0;
+    if (have < kHeaderSize) {
+        return kHeaderSize - have;
+    }
+    const std::size_t total = kHeaderSize + declared_length(data.subspan(offset));
+    return total > have ? total - have : 0;
+}
+
+auto PacketFrameBuffer::readable() const noexcept -> std::span<const std::uint8_t> {
+    return std::span<const std::uint8_t>{buf_}.subspan(begin_, end_ - begin_);
+}
+
+void PacketFrameBuffer::release(std::size_t keep) noexcept {
+    if (begin_ != end_ || buf_.size() <= keep) {
+        return;
+    }
+    std::vector<std::uint8_t>{}.swap(buf_);
+    begin_ = 0;
+    end_ = 0;
+}
+
+void PacketFrameBuffer::consume(std::size_t n) noexcept {
+    begin_ += std::min(n, end_ - begin_);
+    if (begin_ == end_) {
+        begin_ = 0;
+        end_ = 0;
+    }
+}
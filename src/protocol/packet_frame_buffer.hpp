@@ -0,0 +1,114 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// packet_frame_buffer.hpp
+//
+// 스트림 수신용 MySQL 패킷 프레이밍 버퍼.
+//
+// [용도]
+// 서버 응답(Result Set)을 패킷 1개씩 read/write 하면 row 수만큼 syscall 과
+// 코루틴 중단이 발생한다. PacketFrameBuffer 는 소켓이 가진 만큼 한 번에 읽어
+// 쌓아 두고, 호출자가 패킷 경계를 따라 걸으며(peek) 상태 머신을 갱신한 뒤
+// 완전한 패킷들을 연속된 바이트 구간(readable().first(n))으로 한 번에 전달하게 한다.
+//
+// [레이아웃]
+//   [0, begin_)      : 이미 소비된 영역 (prepare() 시 compaction 으로 회수)
+//   [begin_, end_)   : 수신했지만 아직 소비하지 않은 바이트 (readable)
+//   [end_, size)     : 다음 수신에 쓸 빈 공간 (prepare)
+//
+// [큰 패킷 — 헤더만 보고 통과]
+// 릴레이 상태 머신은 payload 앞 몇 바이트와 길이, sequence id 만 본다. peek_head() 는
+// 패킷 전체가 아직 없어도 헤더와 payload 앞부분이 있으면 FrameHead 를 돌려주므로,
+// 호출자는 큰 row(BLOB 등)를 버퍼에 다 모으지 않고 나머지를 그대로 흘려보낼 수 있다.
+//
+// [수명]
+// peek() / peek_head() 가 돌려준 뷰는 다음 prepare() / consume() 호출 전까지만 유효하다.
+// 소켓 I/O 는 하지 않는다 (asio 비의존 — 단위 테스트 가능).
+// ---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "protocol/mysql_packet.hpp"
+
+// ---------------------------------------------------------------------------
+// FrameHead
+//   패킷 헤더 + payload 앞부분. 릴레이 상태 머신 판정 입력.
+//   prefix 가 payload 전체이면 complete() (lenenc 구조 검사 등 전체가 필요한 판정 가능).
+// ---------------------------------------------------------------------------
+struct FrameHead {
+    std::uint32_t payload_length{0};
+    std::uint8_t sequence_id{0};
+    std::span<const std::uint8_t> prefix{};
+
+    [[nodiscard]] bool complete() const noexcept { return prefix.size() == payload_length; }
+};
+
+class PacketFrameBuffer {
+public:
+    static constexpr std::size_t kDefaultCapacity = 64U * 1024U;
+
+    // 큰 패킷 수신으로 자란 버퍼를 세션 수명 내내 점유하지 않도록,
+    // 비어 있는 상태에서 prepare() 시 이 크기를 넘는 버퍼는 기본 크기로 줄인다.
+    static constexpr std::size_t kRetainMax = 1024U * 1024U;
+
+    PacketFrameBuffer() = default;
+
+    // -----------------------------------------------------------------------
+    // prepare
+    //   다음 수신에 쓸 빈 공간을 최소 min_free 바이트 이상 확보하여 반환한다.
+    //   소비된 앞부분을 당겨오거나(compaction) 버퍼를 확장한다.
+    //   기존 peek() 뷰는 무효가 된다.
+    // -----------------------------------------------------------------------
+    [[nodiscard]] auto prepare(std::size_t min_free) -> std::span<std::uint8_t>;
+
+    // prepare() 로 받은 공간 중 실제 수신한 n 바이트를 readable 영역에 추가
+    void commit(std::size_t n) noexcept;
+
+    // -----------------------------------------------------------------------
+    // peek
+    //   readable 시작으로부터 offset 바이트 위치의 패킷이 완전히 수신되었으면 뷰 반환.
+    //   아직 부족하면 std::nullopt (missing() 으로 부족 바이트 수 확인).
+    // -----------------------------------------------------------------------
+    [[nodiscard]] auto peek(std::size_t offset) const noexcept -> std::optional<MysqlPacketView>;
+
+    // -----------------------------------------------------------------------
+    // peek_head
+    //   offset 위치 패킷의 헤더와 payload 앞 min(min_prefix, payload_length) 바이트가
+    //   수신되었으면 FrameHead 반환 (prefix 는 그 이상 수신된 만큼 포함, payload 범위 내).
+    // -----------------------------------------------------------------------
+    [[nodiscard]] auto peek_head(std::size_t offset, std::size_t min_prefix) const noexcept
+        -> std::optional<FrameHead>;
+
+    // offset 위치 패킷을 완성하는 데 더 필요한 바이트 수 (헤더 미완성이면 헤더까지)
+    [[nodiscard]] auto missing(std::size_t offset) const noexcept -> std::size_t;
+
+    // 수신했지만 소비하지 않은 바이트
+    [[nodiscard]] auto readable() const noexcept -> std::span<const std::uint8_t>;
+
+    // readable 앞쪽 n 바이트를 소비 (전달 완료)
+    void consume(std::size_t n) noexcept;
+
+    // prepare(min_free) 가 compaction 만으로는 부족하여 버퍼를 키워야 하는지
+    [[nodiscard]] auto would_grow(std::size_t min_free) const noexcept -> bool {
+        return buf_.size() - (end_ - begin_) < min_free;
+    }
+
+    // -----------------------------------------------------------------------
+    // release
+    //   비어 있고 capacity 가 keep 을 넘으면 버퍼를 해제한다 (다음 prepare() 가 다시 할당).
+    //   유휴 세션의 버퍼 메모리를 돌려줄 때 사용한다 (RelayBudget).
+    // -----------------------------------------------------------------------
+    void release(std::size_t keep) noexcept;
+
+    // 할당된 버퍼 크기 (RelayBudget 집계 / 테스트)
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t { return buf_.size(); }
+
+private:
+    std::vector<std::uint8_t> buf_{};
+    std::size_t begin_{0};
+    std::size_t end_{0};
+};
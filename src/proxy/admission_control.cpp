@@ -0,0 +1,168 @@
+// ---------------------------------------------------------------------------
+// admission_control.cpp
+// ---------------------------------------------------------------------------
+
+#include "proxy/admission_control.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+namespace {
+
+auto source_key(const boost::asio::ip::address& address) noexcept -> AdmissionTicket::SourceKey {
+    if (address.is_v4()) {
+        return boost::asio::ip::make_address_v6(boost::asio::ip::v4_mapped, address.to_v4())
+            .to_bytes();
+    }
+    return address.to_v6().to_bytes();
+}
+
+}  // namespace
+
+std::string_view admission_reject_name(AdmissionReject reason) noexcept {
+    switch (reason) {
+        case AdmissionReject::kRateLimited:
+            return "rate_limited";
+        case AdmissionReject::kTooManyPendingHandshakes:
+            return "pending_handshakes";
+        case AdmissionReject::kPerIpLimit:
+            break;
+    }
+    return "per_ip_limit";
+}
+
+// ---------------------------------------------------------------------------
+// AdmissionTicket
+// ---------------------------------------------------------------------------
+AdmissionTicket::AdmissionTicket(std::shared_ptr<AdmissionControl> owner,
+                                 const SourceKey& source,
+                                 bool holds_source) noexcept
+    : owner_{std::move(owner)}, source_{source}, holds_source_{holds_source}, pending_{true} {}
+
+AdmissionTicket::~AdmissionTicket() { reset(); }
+
+AdmissionTicket::AdmissionTicket(AdmissionTicket&& other) noexcept
+    : owner_{std::move(other.owner_)},
+      source_{other.source_},
+      holds_source_{std::exchange(other.holds_source_, false)},
+      pending_{std::exchange(other.pending_, false)} {}
+
+AdmissionTicket& AdmissionTicket::operator=(AdmissionTicket&& other) noexcept {
+    if (this != &other) {
+        reset();
+        owner_ = std::move(other.owner_);
+        source_ = other.source_;
+        holds_source_ = std::exchange(other.holds_source_, false);
+        pending_ = std::exchange(other.pending_, false);
+    }
+    return *this;
+}
+
+void AdmissionTicket::handshake_finished() noexcept {
+    if (owner_ && pending_) {
+        pending_ = false;
+        owner_->release_pending();
+    }
+}
+
+std::chrono::milliseconds AdmissionTicket::handshake_timeout() const noexcept {
+    return owner_ ? owner_->options().handshake_timeout : std::chrono::milliseconds{0};
+}
+
+void AdmissionTicket::reset() noexcept {
+    if (!owner_) {
+        return;
+    }
+    handshake_finished();
+    if (holds_source_) {
+        holds_source_ = false;
+        owner_->release_source(source_);
+    }
+    owner_.reset();
+}
+
+// ---------------------------------------------------------------------------
+// AdmissionControl
+// ---------------------------------------------------------------------------
+AdmissionControl::AdmissionControl(AdmissionOptions options,
+                                   std::chrono::steady_clock::time_point now) noexcept
+    : options_{options},
+      burst_{static_cast<double>(options.accept_burst != 0 ? options.accept_burst
+                                                           : options.accept_rate)},
+      tokens_{burst_},
+      refilled_at_{now} {}
+
+auto AdmissionControl::try_admit(const boost::asio::ip::address& source,
+                                 std::chrono::steady_clock::time_point now)
+    -> std::expected<AdmissionTicket, AdmissionReject> {
+    const auto key = source_key(source);
+    const bool per_ip = options_.max_connections_per_ip != 0;
+
+    const std::lock_guard lock{mu_};
+    if (options_.accept_rate != 0) {
+        // 버킷 보충: 마지막 보충 이후 경과 시간만큼 (버킷 크기 상한)
+        if (now > refilled_at_) {
+            const std::chrono::duration<double> elapsed = now - refilled_at_;
+            tokens_ = std::min(burst_, tokens_ + (elapsed.count() * options_.accept_rate));
+            refilled_at_ = now;
+        }
+        if (tokens_ < 1.0) {
+            return std::unexpected(AdmissionReject::kRateLimited);
+        }
+    }
+    if (options_.max_pending_handshakes != 0 && pending_ >= options_.max_pending_handshakes) {
+        return std::unexpected(AdmissionReject::kTooManyPendingHandshakes);
+    }
+    if (per_ip) {
+        const auto it = per_source_.find(key);
+        if (it != per_source_.end() && it->second >= options_.max_connections_per_ip) {
+            return std::unexpected(AdmissionReject::kPerIpLimit);
+        }
+        ++per_source_[key];
+    }
+
+    if (options_.accept_rate != 0) {
+        tokens_ -= 1.0;
+    }
+    ++pending_;
+    return AdmissionTicket{shared_from_this(), key, per_ip};
+}
+
+std::uint32_t AdmissionControl::pending_handshakes() const noexcept {
+    const std::lock_guard lock{mu_};
+    return pending_;
+}
+
+std::size_t AdmissionControl::tracked_sources() const noexcept {
+    const std::lock_guard lock{mu_};
+    return per_source_.size();
+}
+
+std::size_t AdmissionControl::SourceKeyHash::operator()(
+    const AdmissionTicket::SourceKey& key) const noexcept {
+    std::uint64_t hi = 0;
+    std::uint64_t lo = 0;
+    std::memcpy(&hi, key.data(), sizeof(hi));
+    std::memcpy(&lo, key.data() + sizeof(hi), sizeof(lo));
+    return std::hash<std::uint64_t>{}(hi ^ (lo * 0x9E3779B97F4A7C15ULL));
+}
+
+void AdmissionControl::release_pending() noexcept {
+    const std::lock_guard lock{mu_};
+    if (pending_ > 0) {
+        --pending_;
+    }
+}
+
+void AdmissionControl::release_source(const AdmissionTicket::SourceKey& source) noexcept {
+    const std::lock_guard lock{mu_};
+    const auto it = per_source_.find(source);
+    if (it == per_source_.end()) {
+        return;
+    }
+    if (--it->second == 0) {
+        per_source_.erase(it);  // 연결이 끝난 IP 는 남기지 않는다 (표 크기 = 활성 출발지 수)
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// admission_control.hpp
+//
+// accept 직후 연결 허용 판정 (재접속 폭주 방어).
+//
+// [설계 의도]
+// 재접속 폭주 때 max_connections 검사만으로는 거부되는 연결까지 Session 생성, frontend TLS
+// 핸드셰이크 시도, 업스트림 connect 비용을 모두 치른다. accept 루프가 upstream 선택 전에
+// 다음 세 가지를 먼저 검사해 프록시와 MySQL 양쪽을 보호한다.
+//   - accept_rate / accept_burst : 토큰 버킷. 초당 허용 연결 수를 제한한다
+//   - max_pending_handshakes     : accept ~ kReady(백엔드 인증 완료) 사이 세션 수 상한
+//   - max_connections_per_ip     : 출발지 IP 별 동시 연결 상한
+// 핸드셰이크가 handshake_timeout 안에 끝나지 않은 세션은 Session 이 직접 닫는다
+// (느린/멈춘 클라이언트가 pending 슬롯을 오래 점유하지 않도록).
+// 모든 값은 0 이면 해당 검사를 하지 않는다.
+//
+// [수명]
+// 허용된 연결은 AdmissionTicket 을 받는다. 티켓은 세션 수명 동안 IP 슬롯을, 핸드셰이크가
+// 끝날 때까지(handshake_finished 또는 소멸) pending 슬롯을 점유한다.
+// 티켓이 AdmissionControl 을 shared_ptr 로 잡으므로 반드시 make_shared 로 생성한다.
+//
+// [스레드 안전성]
+// try_admit 은 accept 루프에서, 티켓 해제는 각 세션 strand 에서 호출된다.
+// 상태는 mutex 하나로 보호한다 (연결 수립/종료마다 1회, 데이터패스에는 없음).
+// ---------------------------------------------------------------------------
+
+#include <array>
+#include <boost/asio/ip/address.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+struct AdmissionOptions {
+    std::uint32_t accept_rate{0};             // 초당 허용 연결 수 (0 = 제한 없음)
+    std::uint32_t accept_burst{0};            // 버킷 크기 (0 = accept_rate)
+    std::uint32_t max_pending_handshakes{0};  // 0 = 제한 없음
+    std::uint32_t max_connections_per_ip{0};  // 0 = 제한 없음
+    std::chrono::milliseconds handshake_timeout{0};  // 0 = 제한 없음
+};
+
+enum class AdmissionReject : std::uint8_t {
+    kRateLimited = 0,
+    kTooManyPendingHandshakes = 1,
+    kPerIpLimit = 2,
+};
+
+// "rate_limited" / "pending_handshakes" / "per_ip_limit"
+[[nodiscard]] std::string_view admission_reject_name(AdmissionReject reason) noexcept;
+
+class AdmissionControl;
+
+// ---------------------------------------------------------------------------
+// AdmissionTicket
+//   허용된 연결 1개의 점유분. 기본 생성된 티켓은 아무 것도 점유하지 않는다
+//   (테스트 / Session 직접 생성용).
+// ---------------------------------------------------------------------------
+class AdmissionTicket {
+public:
+    using SourceKey = std::array<unsigned char, 16>;  // IPv6 (IPv4 는 v4-mapped)
+
+    AdmissionTicket() noexcept = default;
+    ~AdmissionTicket();
+
+    AdmissionTicket(const AdmissionTicket&) = delete;
+    AdmissionTicket& operator=(const AdmissionTicket&) = delete;
+    AdmissionTicket(AdmissionTicket&& other) noexcept;
+    AdmissionTicket& operator=(AdmissionTicket&& other) noexcept;
+
+    // 핸드셰이크 완료 — pending 슬롯 반환 (중복 호출 무시)
+    void handshake_finished() noexcept;
+
+    // Session 이 적용할 핸드셰이크 제한 시간 (0 = 없음)
+    [[nodiscard]] std::chrono::milliseconds handshake_timeout() const noexcept;
+
+    [[nodiscard]] explicit operator bool() const noexcept { return owner_ != nullptr; }
+
+private:
+    friend class AdmissionControl;
+    AdmissionTicket(std::shared_ptr<AdmissionControl> owner,
+                    const SourceKey& source,
+                    bool holds_source) noexcept;
+
+    void reset() noexcept;
+
+    std::shared_ptr<AdmissionControl> owner_{};
+    SourceKey source_{};
+    bool holds_source_{false};  // max_connections_per_ip 가 0 이면 IP 별로 세지 않는다
+    bool pending_{false};
+};
+
+class AdmissionControl : public std::enable_shared_from_this<AdmissionControl> {
+public:
+    explicit AdmissionControl(AdmissionOptions options,
+                              std::chrono::steady_clock::time_point now =
+                                  std::chrono::steady_clock::now()) noexcept;
+    ~AdmissionControl() = default;
+
+    AdmissionControl(const AdmissionControl&) = delete;
+    AdmissionControl& operator=(const AdmissionControl&) = delete;
+    AdmissionControl(AdmissionControl&&) = delete;
+    AdmissionControl& operator=(AdmissionControl&&) = delete;
+
+    // -----------------------------------------------------------------------
+    // try_admit
+    //   rate → pending → per-IP 순서로 검사하고, 모두 통과해야 토큰/슬롯을 차지한다
+    //   (거부된 연결은 아무 것도 소비하지 않는다).
+    // -----------------------------------------------------------------------
+    [[nodiscard]] auto try_admit(const boost::asio::ip::address& source,
+                                 std::chrono::steady_clock::time_point now =
+                                     std::chrono::steady_clock::now())
+        -> std::expected<AdmissionTicket, AdmissionReject>;
+
+    [[nodiscard]] const AdmissionOptions& options() const noexcept { return options_; }
+
+    [[nodiscard]] std::uint32_t pending_handshakes() const noexcept;
+
+    // 현재 연결을 가진 출발지 IP 수
+    [[nodiscard]] std::size_t tracked_sources() const noexcept;
+
+private:
+    friend class AdmissionTicket;
+
+    struct SourceKeyHash {
+        std::size_t operator()(const AdmissionTicket::SourceKey& key) const noexcept;
+    };
+
+    void release_pending() noexcept;
+    void release_source(const AdmissionTicket::SourceKey& source) noexcept;
+
+    const AdmissionOptions options_;
+    const double burst_;
+
+    mutable std::mutex mu_;
+    double tokens_;
+    std::chrono::steady_clock::time_point refilled_at_;
+    std::uint32_t pending_{0};
+    std::unordered_map<AdmissionTicket::SourceKey, std::uint32_t, SourceKeyHash> per_source_{};
+};
@@ -0,0 +1,172 @@
+#include "proxy/backend_pool.hpp"
+
+#include <poll.h>
+
+#include <functional>
+
+// ---------------------------------------------------------------------------
+// BackendPool — 구현
+//
+// 제거되는 연결은 락 밖에서 소멸시킨다 (소켓 close 가 락 구간을 늘리지 않도록).
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// 유휴 연결은 서버가 먼저 보낼 데이터가 없어야 한다.
+// 읽을 수 있거나(EOF, wait_timeout 직전 ERR 등) 에러 상태면 끊긴 연결로 본다.
+bool peer_closed(AsyncStream& stream) noexcept {
+    auto& sock = stream.lowest_layer();
+    if (!sock.is_open()) {
+        return true;
+    }
+    pollfd pfd{.fd = sock.native_handle(), .events = POLLIN, .revents = 0};
+    const int ready = ::poll(&pfd, 1, 0);
+    return ready != 0;
+}
+
+}  // namespace
+
+std::size_t BackendPoolKeyHash::operator()(const BackendPoolKey& key) const noexcept {
+    std::size_t h = std::hash<std::string>{}(key.db_user);
+    const auto mix = [&h](std::size_t v) {
+        h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6U) + (h >> 2U);
+    };
+    mix(std::hash<std::string>{}(key.db_name));
+    mix(std::hash<std::uint32_t>{}(key.capability_flags));
+    mix(std::hash<bool>{}(key.backend_tls));
+    mix(std::hash<std::string>{}(key.endpoint.address().to_string()));
+    mix(std::hash<std::uint16_t>{}(key.endpoint.port()));
+    return h;
+}
+
+BackendPool::BackendPool(std::size_t max_idle,
+                         std::size_t max_idle_per_key,
+                         std::chrono::seconds idle_timeout,
+                         std::shared_ptr<StatsCollector> stats)
+    : max_idle_{max_idle},
+      max_idle_per_key_{max_idle_per_key},
+      idle_timeout_{idle_timeout},
+      stats_{std::move(stats)} {}
+
+auto BackendPool::acquire(const BackendPoolKey& key, std::chrono::steady_clock::time_point now)
+    -> std::optional<PooledBackend> {
+    std::vector<PooledBackend> dropped;
+    std::optional<PooledBackend> found;
+    {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        const auto it = idle_.find(key);
+        if (it != idle_.end()) {
+            auto& list = it->second;
+            while (!list.empty()) {
+                PooledBackend candidate = std::move(list.back());
+                list.pop_back();
+                --idle_total_;
+                if (expired(candidate, now) || peer_closed(candidate.stream)) {
+                    dropped.push_back(std::move(candidate));
+                    continue;
+                }
+                found.emplace(std::move(candidate));
+                break;
+            }
+            if (list.empty()) {
+                idle_.erase(it);
+            }
+            publish_idle_locked();
+        }
+    }
+
+    if (stats_) {
+        if (!dropped.empty()) {
+            stats_->on_pool_eviction(dropped.size());
+        }
+        if (found) {
+            stats_->on_pool_hit();
+        } else {
+            stats_->on_pool_miss();
+        }
+    }
+    return found;
+}
+
+bool BackendPool::release(const BackendPoolKey& key, PooledBackend backend) {
+    {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        auto& list = idle_[key];
+        if (idle_total_ < max_idle_ && list.size() < max_idle_per_key_) {
+            list.push_back(std::move(backend));
+            ++idle_total_;
+            publish_idle_locked();
+            return true;
+        }
+        if (list.empty()) {
+            idle_.erase(key);
+        }
+    }
+
+    // 상한 초과: 보관하지 않는다 (backend 는 이 함수 반환 시 소멸하며 연결이 닫힌다)
+    if (stats_) {
+        stats_->on_pool_eviction();
+    }
+    return false;
+}
+
+std::size_t BackendPool::evict_expired(std::chrono::steady_clock::time_point now) {
+    std::vector<PooledBackend> dropped;
+    {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        for (auto it = idle_.begin(); it != idle_.end();) {
+            auto& list = it->second;
+            std::erase_if(list, [&](PooledBackend& backend) {
+                if (!expired(backend, now)) {
+                    return false;
+                }
+                dropped.push_back(std::move(backend));
+                return true;
+            });
+            it = list.empty() ? idle_.erase(it) : std::next(it);
+        }
+        idle_total_ -= dropped.size();
+        publish_idle_locked();
+    }
+
+    if (stats_ && !dropped.empty()) {
+        stats_->on_pool_eviction(dropped.size());
+    }
+    return dropped.size();
+}
+
+void BackendPool::clear() {
+    decltype(idle_) dropped;
+    {
+        const std::lock_guard<std::mutex> lock{mutex_};
+        dropped.swap(idle_);
+        idle_total_ = 0;
+        publish_idle_locked();
+    }
+}
+
+auto BackendPool::greeting_template() const -> std::vector<std::uint8_t> {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    return greeting_template_;
+}
+
+void BackendPool::set_greeting_template(std::vector<std::uint8_t> greeting) {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    greeting_template_ = std::move(greeting);
+}
+
+auto BackendPool::idle_count() const -> std::size_t {
+    const std::lock_guard<std::mutex> lock{mutex_};
+    return idle_total_;
+}
+
+void BackendPool::publish_idle_locked() noexcept {
+    if (stats_) {
+        stats_->on_pool_idle_changed(idle_total_);
+    }
+}
+
+bool BackendPool::expired(const PooledBackend& backend,
+                          std::chrono::steady_clock::time_point now) const noexcept {
+    return now - backend.idle_since >= idle_timeout_;
+}
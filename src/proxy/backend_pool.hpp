@@ -0,0 +1,152 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// backend_pool.hpp
+//
+// 인증을 마친 업스트림 MySQL 연결을 세션 간 재사용하는 opt-in 연결 풀.
+//
+// [설계 의도]
+// 짧은 연결이 많은 워크로드에서는 세션마다 TCP connect + (backend TLS) + MySQL
+// 핸드셰이크 비용이 쿼리보다 크다. 세션 종료 시 COM_RESET_CONNECTION 으로 세션
+// 상태(트랜잭션, 임시 테이블, 사용자 변수, prepared statement)를 초기화한 연결을
+// 보관하고, 다음 세션은 COM_CHANGE_USER 로 재인증하여 사용한다.
+//
+// [보안 — 재인증은 항상 MySQL 서버가 수행한다]
+// 프록시는 자격 증명을 알지 못한다. COM_CHANGE_USER 는 미지원 auth plugin 으로 보내
+// 서버가 AuthSwitchRequest(새 scramble)를 내리게 하고, 인증 교환은 클라이언트와
+// 서버 사이에서 그대로 릴레이된다. 재인증이 실패하면 연결은 풀로 돌아가지 않는다.
+//
+// [키]
+// (db_user, db_name, capability_flags, backend_tls, endpoint) 가 같은 연결만 재사용한다.
+// capability_flags 는 서버와 협상된 값이므로 프로토콜 동작(결과셋 형식 등)이 같다.
+//
+// [스레드 안전성]
+// 모든 연산은 mutex 로 보호한다. 보관 중인 연결은 어느 세션에도 속하지 않으므로
+// 반출 후에는 반출한 세션의 strand 위에서만 사용된다.
+// ---------------------------------------------------------------------------
+
+#include <boost/asio/ip/tcp.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/async_stream.hpp"
+#include "stats/stats_collector.hpp"
+
+// ---------------------------------------------------------------------------
+// BackendPoolKey
+//   db_user / db_name   : 핸드셰이크에서 추출한 사용자 / 초기 DB
+//   capability_flags    : 서버와 협상된 클라이언트 capability (strip 적용 후)
+//   backend_tls         : backend 구간 TLS 여부
+//   endpoint            : 업스트림 엔드포인트 (DNS 갱신 후 다른 주소면 적중하지 않음)
+// ---------------------------------------------------------------------------
+struct BackendPoolKey {
+    std::string db_user{};
+    std::string db_name{};
+    std::uint32_t capability_flags{0};
+    bool backend_tls{false};
+    boost::asio::ip::tcp::endpoint endpoint{};
+
+    bool operator==(const BackendPoolKey&) const = default;
+};
+
+struct BackendPoolKeyHash {
+    std::size_t operator()(const BackendPoolKey& key) const noexcept;
+};
+
+// ---------------------------------------------------------------------------
+// PooledBackend
+//   stream           : 인증 완료 + COM_RESET_CONNECTION 을 마친 서버 연결
+//   capability_flags : 이 연결에서 서버와 협상된 capability (COM_CHANGE_USER 인코딩용)
+//   idle_since       : 풀에 반납된 시각 (유휴 타임아웃 판정)
+// ---------------------------------------------------------------------------
+struct PooledBackend {
+    AsyncStream stream;
+    std::uint32_t capability_flags{0};
+    std::chrono::steady_clock::time_point idle_since{};
+};
+
+class BackendPool {
+public:
+    // -----------------------------------------------------------------------
+    // 생성자
+    //   max_idle         : 풀 전체 유휴 연결 상한
+    //   max_idle_per_key : 키 하나당 유휴 연결 상한
+    //   idle_timeout     : 이 시간보다 오래 유휴인 연결은 반출하지 않고 제거한다
+    //   stats            : pool_* 통계를 갱신할 수집기 (nullptr 허용)
+    // -----------------------------------------------------------------------
+    BackendPool(std::size_t max_idle,
+                std::size_t max_idle_per_key,
+                std::chrono::seconds idle_timeout,
+                std::shared_ptr<StatsCollector> stats);
+
+    ~BackendPool() = default;
+
+    BackendPool(const BackendPool&) = delete;
+    BackendPool& operator=(const BackendPool&) = delete;
+    BackendPool(BackendPool&&) = delete;
+    BackendPool& operator=(BackendPool&&) = delete;
+
+    // -----------------------------------------------------------------------
+    // acquire
+    //   key 에 해당하는 가장 최근 반납 연결을 반출한다 (LIFO — 살아 있을 확률이 높음).
+    //   유휴 타임아웃을 넘겼거나 원격이 이미 닫은 연결은 건너뛰고 제거한다.
+    //   반출하면 on_pool_hit, 없으면 on_pool_miss 를 기록한다.
+    // -----------------------------------------------------------------------
+    [[nodiscard]] auto acquire(const BackendPoolKey& key,
+                               std::chrono::steady_clock::time_point now)
+        -> std::optional<PooledBackend>;
+
+    // -----------------------------------------------------------------------
+    // release
+    //   연결을 풀에 반납한다. 상한을 넘으면 보관하지 않고 false 를 반환하며,
+    //   이때 연결은 backend 와 함께 소멸(종료)된다.
+    // -----------------------------------------------------------------------
+    bool release(const BackendPoolKey& key, PooledBackend backend);
+
+    // -----------------------------------------------------------------------
+    // evict_expired
+    //   idle_timeout 을 넘긴 유휴 연결을 모두 제거하고 제거 수를 반환한다.
+    //   ProxyServer 가 주기적으로 호출한다.
+    // -----------------------------------------------------------------------
+    std::size_t evict_expired(std::chrono::steady_clock::time_point now);
+
+    // 모든 유휴 연결을 닫는다 (종료 시)
+    void clear();
+
+    // -----------------------------------------------------------------------
+    // greeting_template / set_greeting_template
+    //   풀 경로에서 클라이언트에 보낼 서버 greeting 원형 (strip 적용 후 헤더 포함 바이트).
+    //   첫 투명 핸드셰이크에서 캡처한다. 비어 있으면 세션은 투명 경로를 사용한다.
+    // -----------------------------------------------------------------------
+    [[nodiscard]] auto greeting_template() const -> std::vector<std::uint8_t>;
+    void set_greeting_template(std::vector<std::uint8_t> greeting);
+
+    [[nodiscard]] auto idle_count() const -> std::size_t;
+    [[nodiscard]] auto idle_timeout() const noexcept -> std::chrono::seconds {
+        return idle_timeout_;
+    }
+
+private:
+    std::size_t max_idle_;
+    std::size_t max_idle_per_key_;
+    std::chrono::seconds idle_timeout_;
+    std::shared_ptr<StatsCollector> stats_;
+
+    mutable std::mutex mutex_;
+    // 키별 유휴 연결 (뒤쪽이 최근 반납)
+    std::unordered_map<BackendPoolKey, std::vector<PooledBackend>, BackendPoolKeyHash> idle_{};
+    std::size_t idle_total_{0};
+    std::vector<std::uint8_t> greeting_template_{};
+
+    // mutex_ 보유 상태에서 호출
+    void publish_idle_locked() noexcept;
+    [[nodiscard]] bool expired(const PooledBackend& backend,
+                               std::chrono::steady_clock::time_point now) const noexcept;
+};
@@ -0,0 +1,215 @@
+// ---------------------------------------------------------------------------
+// listener_handoff.cpp
+// ---------------------------------------------------------------------------
+
+#include "proxy/listener_handoff.hpp"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// 응답 본문 상한 (인계 응답은 짧은 JSON 이다)
+constexpr std::uint32_t kMaxResponseSize = 64U * 1024U;
+
+// 정확히 size 바이트를 읽는다 (SO_RCVTIMEO 가 걸린 blocking 소켓)
+auto recv_all(int fd, char* data, std::size_t size) -> std::expected<void, std::string> {
+    while (size > 0) {
+        const auto n = ::recv(fd, data, size, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            return std::unexpected(errno_message("recv", errno));
+        }
+        if (n == 0) {
+            return std::unexpected(std::string{"connection closed by peer"});
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return {};
+}
+
+void close_all(const std::vector<int>& fds) noexcept {
+    for (const int fd : fds) {
+        ::close(fd);
+    }
+}
+
+// 소유한 fd 를 닫는 RAII (연결 소켓 정리용)
+class FdGuard {
+public:
+    explicit FdGuard(int fd) noexcept : fd_{fd} {}
+    ~FdGuard() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+    FdGuard(const FdGuard&) = delete;
+    FdGuard& operator=(const FdGuard&) = delete;
+    FdGuard(FdGuard&&) = delete;
+    FdGuard& operator=(FdGuard&&) = delete;
+
+    [[nodiscard]] int get() const noexcept { return fd_; }
+
+private:
+    int fd_;
+};
+
+}  // namespace
+
+auto request_listener_handoff(const std::filesystem::path& uds_path,
+                              std::uint16_t listen_port,
+                              std::chrono::milliseconds timeout)
+    -> std::expected<std::vector<int>, std::string> {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    const auto path = uds_path.string();
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        return std::unexpected(std::string{"invalid UDS path"});
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    const FdGuard sock{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    if (sock.get() < 0) {
+        return std::unexpected(errno_message("socket", errno));
+    }
+    const auto tv_sec = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    const timeval tv{
+        .tv_sec = static_cast<time_t>(tv_sec.count()),
+        .tv_usec = static_cast<suseconds_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(timeout - tv_sec).count()),
+    };
+    ::setsockopt(sock.get(), SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    ::setsockopt(sock.get(), SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (::connect(sock.get(), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        return std::unexpected(errno_message("connect " + path, errno));
+    }
+
+    const auto request =
+        R"({"command":"listener_handoff","version":1,"payload":{"listen_port":)" +
+        std::to_string(listen_port) + "}}";
+    const auto req_header = encode_frame_length(static_cast<std::uint32_t>(request.size()));
+    if (auto sent =
+            send_all_with_timeout(sock.get(), req_header.data(), req_header.size(), timeout);
+        !sent) {
+        return std::unexpected(sent.error());
+    }
+    if (auto sent = send_all_with_timeout(sock.get(), request.data(), request.size(), timeout);
+        !sent) {
+        return std::unexpected(sent.error());
+    }
+
+    // 응답 헤더 첫 바이트와 함께 fd 를 받는다
+    std::array<char, 4> header{};
+    std::array<char, CMSG_SPACE(sizeof(int) * kMaxHandoffFds)> control{};
+    iovec iov{.iov_base = header.data(), .iov_len = 1};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.data();
+    msg.msg_controllen = control.size();
+
+    ssize_t n = 0;
+    do {
+        n = ::recvmsg(sock.get(), &msg, MSG_CMSG_CLOEXEC);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+        return std::unexpected(errno_message("recvmsg", errno));
+    }
+    if (n == 0) {
+        return std::unexpected(std::string{"connection closed by peer"});
+    }
+
+    std::vector<int> fds;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+            continue;
+        }
+        const auto count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (std::size_t i = 0; i < count; ++i) {
+            int fd = -1;
+            std::memcpy(&fd, CMSG_DATA(cmsg) + (i * sizeof(int)), sizeof(int));
+            fds.push_back(fd);
+        }
+    }
+    if ((msg.msg_flags & MSG_CTRUNC) != 0) {
+        close_all(fds);
+        return std::unexpected(std::string{"ancillary data truncated"});
+    }
+
+    auto fail = [&fds](std::string message) -> std::expected<std::vector<int>, std::string> {
+        close_all(fds);
+        return std::unexpected(std::move(message));
+    };
+
+    if (auto rest = recv_all(sock.get(), header.data() + 1, header.size() - 1); !rest) {
+        return fail(rest.error());
+    }
+    const auto body_len = decode_frame_length(header);
+    if (body_len == 0 || body_len > kMaxResponseSize) {
+        return fail("invalid response length " + std::to_string(body_len));
+    }
+    std::string body(body_len, '\0');
+    if (auto read = recv_all(sock.get(), body.data(), body.size()); !read) {
+        return fail(read.error());
+    }
+
+    if (!body.starts_with(R"({"ok":true)")) {
+        return fail("handoff refused: " + body);
+    }
+    if (fds.empty()) {
+        return fail("handoff response carried no file descriptor");
+    }
+    return fds;
+}
+
+auto inspect_listener_fd(int fd) -> std::expected<boost::asio::ip::tcp::endpoint, std::string> {
+    int value = 0;
+    socklen_t len = sizeof(value);
+    if (::getsockopt(fd, SOL_SOCKET, SO_TYPE, &value, &len) != 0) {
+        return std::unexpected(errno_message("getsockopt(SO_TYPE)", errno));
+    }
+    if (value != SOCK_STREAM) {
+        return std::unexpected(std::string{"not a stream socket"});
+    }
+    len = sizeof(value);
+    if (::getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &value, &len) != 0) {
+        return std::unexpected(errno_message("getsockopt(SO_ACCEPTCONN)", errno));
+    }
+    if (value == 0) {
+        return std::unexpected(std::string{"socket is not listening"});
+    }
+
+    sockaddr_storage storage{};
+    socklen_t addr_len = sizeof(storage);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&storage), &addr_len) != 0) {
+        return std::unexpected(errno_message("getsockname", errno));
+    }
+    if (storage.ss_family == AF_INET) {
+        sockaddr_in in4{};
+        std::memcpy(&in4, &storage, sizeof(in4));
+        const boost::asio::ip::address_v4 addr{ntohl(in4.sin_addr.s_addr)};
+        return boost::asio::ip::tcp::endpoint{addr, ntohs(in4.sin_port)};
+    }
+    if (storage.ss_family == AF_INET6) {
+        sockaddr_in6 in6{};
+        std::memcpy(&in6, &storage, sizeof(in6));
+        boost::asio::ip::address_v6::bytes_type bytes{};
+        std::memcpy(bytes.data(), &in6.sin6_addr, bytes.size());
+        return boost::asio::ip::tcp::endpoint{boost::asio::ip::address_v6{bytes, in6.sin6_scope_id},
+                                              ntohs(in6.sin6_port)};
+    }
+    return std::unexpected(std::string{"not a TCP socket"});
+}
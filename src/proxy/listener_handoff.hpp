@@ -0,0 +1,51 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// listener_handoff.hpp
+//
+// 무중단 바이너리 교체용 리스너 fd 인계 (UDS + SCM_RIGHTS).
+//
+// [흐름]
+//   1. 새 프로세스를 LISTENER_HANDOFF_FROM=<기존 프로세스의 UDS 경로> 로 기동한다.
+//   2. 새 프로세스는 기동 중 request_listener_handoff() 로 {"command":"listener_handoff",
+//      "payload":{"listen_port":N}} 을 보낸다. 기존 프로세스는 포트가 자신과 같을 때만 넘긴다.
+//   3. 기존 프로세스(UdsServer)는 응답 프레임과 함께 리스너 fd 들(프록시 포트, Health Check
+//      포트)을 SCM_RIGHTS 로 보내고 drain 에 들어간다 (accept 중단, 세션은 커맨드 경계 / 유휴
+//      임계치에서 종료, ProxyServer::drain 참조).
+//   4. 새 프로세스는 받은 fd 를 검증한 뒤 bind 없이 acceptor 에 붙인다.
+// 리슨 소켓은 커널에 하나뿐이므로 인계 사이에 들어온 연결은 backlog 에 남아 있다가 새
+// 프로세스가 accept 한다 (연결 거부 구간 없음).
+// 프레임 / SCM_RIGHTS 송신 primitive 는 응답 측(stats)과 공유하도록 common/fd_passing.hpp 에 있다.
+//
+// [보안]
+// 인계 요청은 다른 UDS 커맨드와 같이 소켓 파일 0600 + SO_PEERCRED UID 검증을 거친다.
+// 받은 fd 가 listening TCP 소켓이 아니거나 포트가 설정과 다르면 기동하지 않는다 (fail-close).
+// ---------------------------------------------------------------------------
+
+#include <boost/asio/ip/tcp.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "common/fd_passing.hpp"
+
+// ---------------------------------------------------------------------------
+// request_listener_handoff
+//   uds_path 의 dbgate 에 listen_port 리스너 인계를 요청하고 받은 fd 목록을 보낸 순서대로
+//   반환한다 (소유권은 호출자, close-on-exec). 응답이 ok:false 이거나 fd 가 없으면 오류.
+// ---------------------------------------------------------------------------
+[[nodiscard]] auto request_listener_handoff(const std::filesystem::path& uds_path,
+                                            std::uint16_t listen_port,
+                                            std::chrono::milliseconds timeout)
+    -> std::expected<std::vector<int>, std::string>;
+
+// ---------------------------------------------------------------------------
+// inspect_listener_fd
+//   fd 가 listen 중인 TCP 소켓인지 확인하고 bind 된 로컬 주소를 반환한다.
+// ---------------------------------------------------------------------------
+[[nodiscard]] auto inspect_listener_fd(int fd)
+    -> std::expected<boost::asio::ip::tcp::endpoint, std::string>;
@@ -0,0 +1,84 @@
+// ---------------------------------------------------------------------------
+// prepared_statement_table.cpp
+//
+// statement_id → PreparedStatement 저장소와 PREPARE 판정/재평가.
+// ---------------------------------------------------------------------------
+
+#include "proxy/prepared_statement_table.hpp"
+
+#include <utility>
+
+#include "parser/query_fingerprint.hpp"
+
+namespace {
+
+// statement.sql 을 파싱·평가하여 command / tables / verdict 를 채운다
+void evaluate_into(PreparedStatement& statement,
+                   const SqlParser& parser,
+                   const PolicyEngine& engine,
+                   const SessionContext& session,
+                   PolicyBinding* binding,
+                   std::pmr::memory_resource* mr) {
+    const auto parsed = parser.parse(statement.sql, mr);
+    if (!parsed) {
+        // 파싱 실패는 정책과 무관하게 항상 차단 (fail-close)
+        statement.command = SqlCommand::kUnknown;
+        statement.tables.clear();
+        // 세대를 먼저 읽는다 — 평가 도중 reload 되면 다음 EXECUTE 에서 다시 평가된다
+        const std::uint64_t generation = engine.generation();
+        statement.verdict =
+            PreparedVerdict{.result = engine.evaluate_error(parsed.error(), session),
+                            .generation = generation};
+        return;
+    }
+
+    statement.command = parsed->command;
+    statement.tables.assign(parsed->tables.begin(), parsed->tables.end());
+    statement.verdict = engine.evaluate_prepared(*parsed, session, binding);
+}
+
+}  // namespace
+
+PreparedStatement prepare_statement(std::string_view sql,
+                                    const SqlParser& parser,
+                                    const PolicyEngine& engine,
+                                    const SessionContext& session,
+                                    PolicyBinding* binding,
+                                    std::pmr::memory_resource* mr) {
+    PreparedStatement statement{.sql = std::string(sql)};
+    if (const auto fingerprint = fingerprint_query(sql, mr)) {
+        statement.fingerprint.assign(*fingerprint);
+    }
+    evaluate_into(statement, parser, engine, session, binding, mr);
+    return statement;
+}
+
+bool revalidate_statement(PreparedStatement& statement,
+                          const SqlParser& parser,
+                          const PolicyEngine& engine,
+                          const SessionContext& session,
+                          PolicyBinding* binding,
+                          std::pmr::memory_resource* mr) {
+    if (statement.verdict.generation == engine.generation() && !statement.verdict.time_dependent) {
+        return false;
+    }
+    evaluate_into(statement, parser, engine, session, binding, mr);
+    return true;
+}
+
+void PreparedStatementTable::insert(std::uint32_t statement_id, PreparedStatement statement) {
+    statements_.insert_or_assign(statement_id, std::move(statement));
+}
+
+PreparedStatement* PreparedStatementTable::find(std::uint32_t statement_id) noexcept {
+    const auto it = statements_.find(statement_id);
+    return it == statements_.end() ? nullptr : &it->second;
+}
+
+void PreparedStatementTable::erase(std::uint32_t statement_id) noexcept {
+    statements_.erase(statement_id);
+}
+
+void PreparedStatementTable::clear() noexcept {
+    statements_.clear();
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// prepared_statement_table.hpp
+//
+// 세션별 prepared statement 판정 저장소.
+//
+// [설계 의도]
+// COM_STMT_PREPARE 의 SQL 을 한 번 파싱·정책 평가하여 서버가 돌려준 statement_id 별로
+// 판정을 보관한다. COM_STMT_EXECUTE 는 statement_id 조회(O(1)) 후 저장된 판정으로
+// 곧바로 전달/차단한다 — 바이너리 프로토콜 파라미터는 파싱하지 않는다.
+//
+// [무효화 — fail-close]
+// - 정책 세대(PolicyEngine::generation) 가 평가 당시와 다르면 EXECUTE 전에 보관한
+//   SQL 을 다시 파싱·평가한다 (reload 로 차단된 문은 다음 EXECUTE 부터 차단).
+// - time_restriction 을 거친 판정은 시각에 따라 달라지므로 EXECUTE 마다 재평가한다.
+// - 등록되지 않은 statement_id 의 EXECUTE 는 서버에 전달하지 않는다 (세션이 ERR 응답).
+//
+// [파라미터 값]
+// 바인딩 파라미터는 SQL 구문이 아니라 값으로 전달되므로 구문/테이블 판정에 영향이 없다.
+// block_patterns 는 PREPARE 원문(placeholder 포함)에만 수행된다.
+//
+// [스레드 안전성]
+// 세션 코루틴 하나에서만 사용한다 (동기화 없음).
+// ---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/types.hpp"
+#include "parser/sql_parser.hpp"
+#include "policy/policy_engine.hpp"
+
+// ---------------------------------------------------------------------------
+// PreparedStatement
+//   sql     : PREPARE 원문 사본 (재평가 / 감사 로그용)
+//   fingerprint : sql 의 fingerprint_query() 결과 (없으면 빈 문자열, top_queries 집계 키)
+//   command / tables : PREPARE 시점 파서 결과 (감사 로그용)
+//   verdict : 저장된 판정과 평가 당시 정책 세대
+// ---------------------------------------------------------------------------
+struct PreparedStatement {
+    std::string sql{};
+    std::string fingerprint{};
+    SqlCommand command{SqlCommand::kUnknown};
+    std::vector<std::string> tables{};
+    PreparedVerdict verdict{};
+};
+
+// ---------------------------------------------------------------------------
+// prepare_statement
+//   sql 을 파싱·평가한 PreparedStatement 를 만든다 (테이블 등록은 서버 응답 후 insert).
+//   파싱 실패는 evaluate_error() 로 kBlock 판정이 된다.
+//   mr: 파싱 scratch 리소스 (세션: QueryArena). 반환값은 mr 을 참조하지 않는다.
+// ---------------------------------------------------------------------------
+[[nodiscard]] PreparedStatement prepare_statement(
+    std::string_view sql,
+    const SqlParser& parser,
+    const PolicyEngine& engine,
+    const SessionContext& session,
+    PolicyBinding* binding,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+// ---------------------------------------------------------------------------
+// revalidate_statement
+//   저장된 판정이 현재 정책에서도 유효한지 확인하고, 아니면 sql 을 다시 평가한다.
+//   반환: 재평가했으면 true (정책 세대 변경 또는 time_dependent).
+// ---------------------------------------------------------------------------
+bool revalidate_statement(PreparedStatement& statement,
+                          const SqlParser& parser,
+                          const PolicyEngine& engine,
+                          const SessionContext& session,
+                          PolicyBinding* binding,
+                          std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+class PreparedStatementTable {
+public:
+    // 세션당 보관 상한. 넘으면 새 PREPARE 는 서버에 전달하지 않고 ERR 로 거절한다.
+    static constexpr std::size_t kMaxStatements = 1024;
+
+    [[nodiscard]] bool full() const noexcept { return statements_.size() >= kMaxStatements; }
+    [[nodiscard]] std::size_t size() const noexcept { return statements_.size(); }
+
+    // insert: statement_id 로 등록한다 (같은 id 가 있으면 교체)
+    void insert(std::uint32_t statement_id, PreparedStatement statement);
+
+    // find: 등록되지 않았으면 nullptr
+    [[nodiscard]] PreparedStatement* find(std::uint32_t statement_id) noexcept;
+
+    void erase(std::uint32_t statement_id) noexcept;
+    void clear() noexcept;
+
+private:
+    std::unordered_map<std::uint32_t, PreparedStatement> statements_{};
+};
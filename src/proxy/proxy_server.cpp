@@ -1,29 +1,44 @@
 #include "proxy/proxy_server.hpp"
 
 #include <spdlog/spdlog.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/redirect_error.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/asio/ssl/context.hpp>
 #include <boost/asio/ssl/stream.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/this_coro.hpp>
 #include <boost/asio/use_awaitable.hpp>
 #include <format>
+#include <utility>
+
+#include "logger/binary_audit_sink.hpp"
+#include "proxy/listener_handoff.hpp"
 
 // ---------------------------------------------------------------------------
 // ProxyServer — 구현
 //
 // run() 흐름:
 //   1. io_ctx_ 저장
-//   2. SSL context 초기화 (설정에 따라)
-//   3. PolicyLoader::load(config_.policy_path)
+//   2. SSL context 초기화 (설정에 따라) + upstream_set_ 생성 (목록/선택 방식 검증)
+//   2b. (opt-in) listener_handoff_from 의 기존 프로세스에서 리스너 인계
+//   3. version_store_ 생성 + (opt-in) 바이너리 스냅샷 복원, 아니면 PolicyLoader::load
 //   4. logger_, stats_, policy_engine_ 생성
-//   5. uds_server_ + co_spawn(run)
-//   6. health_check_ + co_spawn(run)
+//   5. uds_server_ + co_spawn(run) — drain / listener_handoff 커맨드 연결
+//   6. health_check_ (인계받은 리스너 adopt) + co_spawn(run)
 //   7. SIGTERM/SIGINT 핸들러 + SIGHUP 핸들러
-//   8. accept 루프: 세션 생성 + co_spawn(session->run())
-//      콜백에서 sessions_.erase()
+//   7b. upstream_set_ 초기 해석 + start (DNS 갱신 / 헬스 probe)
+//   7c. (opt-in) backend_pool_ 생성 + co_spawn(pool_sweep_loop)
+//   7d. co_spawn(stats_tick_loop) — 윈도우 QPS 표본 + 사용자별 집계
+//   7g. timer_wheel_ 생성 + co_spawn(timer_wheel_loop) — 세션 유휴 / 핸드셰이크 제한 시간
+//   8. accept 루프 (accept_strand_): 세션 생성 + co_spawn(session->run())
+//      콜백에서 sessions_.erase() — stop / drain 중 마지막 세션이면 io_context 중단
 // ---------------------------------------------------------------------------
 
 ProxyServer::ProxyServer(ProxyConfig config) : config_{std::move(config)} {}
@@ -46,6 +61,25 @@ LogLevel parse_log_level(const std::string& level_str) {
     return LogLevel::kInfo;
 }
 
+// 알 수 없는 값은 기본값(drop)으로 취급한다 — 세션 지연보다 로그 유실 카운트가 안전
+LogOverflowPolicy parse_log_overflow_policy(const std::string& policy_str) {
+    if (policy_str == "block") {
+        return LogOverflowPolicy::kBlock;
+    }
+    if (policy_str == "sample") {
+        return LogOverflowPolicy::kSample;
+    }
+    return LogOverflowPolicy::kDrop;
+}
+
+// 알 수 없는 값은 JSON 으로 취급한다 (감사 레코드는 어느 쪽이든 기록된다)
+LogFormat parse_log_format(const std::string& format_str) {
+    if (format_str == "binary") {
+        return LogFormat::kBinary;
+    }
+    return LogFormat::kJson;
+}
+
 }  // namespace
 
 // ---------------------------------------------------------------------------
@@ -99,7 +133,13 @@ LogLevel parse_log_level(const std::string& level_str) {
             return false;
         }
 
-        spdlog::info("[proxy] frontend SSL context initialized");
+        // 세션 재개: 공유 서버 세션 캐시 + 세션 티켓 (재접속 시 전체 핸드셰이크 생략)
+        enable_server_resumption(ctx,
+                                 config_.ssl_session_cache_size,
+                                 std::chrono::seconds{config_.ssl_session_timeout_sec});
+
+        spdlog::info("[proxy] frontend SSL context initialized (session cache={})",
+                     config_.ssl_session_cache_size);
     }
 
     // ── Backend SSL ─────────────────────────────────────────────────────────
@@ -151,21 +191,123 @@ LogLevel parse_log_level(const std::string& level_str) {
             spdlog::debug("[proxy] backend SSL: SNI hostname={}", config_.upstream_ssl_sni);
         }
 
+        // 세션 재개: 업스트림에서 받은 세션을 다음 연결 핸드셰이크에 제시
+        if (config_.ssl_session_cache_size > 0) {
+            backend_tls_sessions_ =
+                std::make_unique<TlsSessionCache>(config_.ssl_session_cache_size);
+            backend_tls_sessions_->attach(ctx);
+        }
+
         spdlog::info("[proxy] backend SSL context initialized");
     }
 
     return true;
 }
 
+// ---------------------------------------------------------------------------
+// init_upstreams
+//   upstream_list 가 비어 있으면 upstream_address:upstream_port 하나로 구성한다.
+//   목록 파싱 실패 / 알 수 없는 선택 방식은 false (fail-close: 서버 기동 실패).
+// ---------------------------------------------------------------------------
+[[nodiscard]] bool ProxyServer::init_upstreams(boost::asio::io_context& io_ctx) {
+    std::vector<UpstreamSpec> specs;
+    if (config_.upstream_list.empty()) {
+        specs.push_back(UpstreamSpec{
+            .host = config_.upstream_address, .port = config_.upstream_port, .weight = 1});
+    } else {
+        auto parsed = parse_upstream_list(config_.upstream_list, config_.upstream_port);
+        if (!parsed) {
+            spdlog::error("[proxy] invalid upstream list — aborting startup: {}", parsed.error());
+            return false;
+        }
+        specs = std::move(*parsed);
+    }
+
+    const auto balance = parse_upstream_balance(config_.upstream_balance);
+    if (!balance) {
+        spdlog::error("[proxy] unknown upstream balance '{}' — aborting startup",
+                      config_.upstream_balance);
+        return false;
+    }
+
+    upstream_set_ = std::make_unique<UpstreamSet>(
+        std::move(specs),
+        UpstreamSetOptions{
+            .balance = *balance,
+            .dns_refresh = std::chrono::seconds{config_.upstream_dns_refresh_sec},
+            .health_interval = std::chrono::milliseconds{config_.upstream_health_interval_ms},
+            .health_timeout = std::chrono::milliseconds{config_.upstream_health_timeout_ms},
+            .eject_failures = std::max(1U, config_.upstream_eject_failures),
+            .health_user = config_.upstream_health_user},
+        io_ctx);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// inherit_listeners
+//   listener_handoff_from 의 기존 dbgate 에서 리스너 fd 를 받아 설정과 맞는지 검증한다.
+//   [0] 프록시 리스너: listen_address:listen_port 와 정확히 같아야 한다 (아니면 fail-close).
+//   [1] Health Check 리스너: 포트가 같을 때만 쓰고, 다르면 닫은 뒤 직접 bind 한다.
+// ---------------------------------------------------------------------------
+[[nodiscard]] bool ProxyServer::inherit_listeners() {
+    constexpr auto kHandoffTimeout = std::chrono::seconds{5};
+    auto fds = request_listener_handoff(
+        config_.listener_handoff_from, config_.listen_port, kHandoffTimeout);
+    if (!fds) {
+        spdlog::error("[proxy] listener handoff from {} failed: {}",
+                      config_.listener_handoff_from,
+                      fds.error());
+        return false;
+    }
+
+    const boost::asio::ip::tcp::endpoint expected{
+        boost::asio::ip::make_address(config_.listen_address), config_.listen_port};
+    auto proxy_ep = inspect_listener_fd(fds->front());
+    if (!proxy_ep || *proxy_ep != expected) {
+        spdlog::error("[proxy] inherited listener rejected: {}",
+                      proxy_ep ? std::format("bound to {}:{}, expected {}:{}",
+                                             proxy_ep->address().to_string(),
+                                             proxy_ep->port(),
+                                             config_.listen_address,
+                                             config_.listen_port)
+                               : proxy_ep.error());
+        for (const int fd : *fds) {
+            ::close(fd);
+        }
+        return false;
+    }
+    inherited_fds_.push_back(fds->front());
+
+    if (fds->size() > 1) {
+        const int health_fd = (*fds)[1];
+        auto health_ep = inspect_listener_fd(health_fd);
+        if (health_ep && health_ep->port() == config_.health_check_port) {
+            inherited_fds_.push_back(health_fd);
+        } else {
+            spdlog::warn("[proxy] inherited health check listener ignored (port {} expected)",
+                         config_.health_check_port);
+            ::close(health_fd);
+        }
+    }
+
+    spdlog::info("[proxy] inherited {} listener(s) from {}",
+                 inherited_fds_.size(),
+                 config_.listener_handoff_from);
+    return true;
+}
+
 // ---------------------------------------------------------------------------
 // policy_reload
-//   SIGHUP 핸들러에서 호출된다.
+//   SIGHUP 핸들러가 UdsServer 관리 strand(control_executor)에 post 하여 호출된다.
+//   UDS policy_reload/policy_rollback 과 같은 strand 에서 직렬 실행된다.
 //   DON-50: PolicyLoader::load → save_snapshot → policy_engine_->reload(버전 포함)
+//   현재 정책을 diff 기준으로 넘겨 바뀌지 않은 패턴/인덱스는 재컴파일하지 않는다.
 // ---------------------------------------------------------------------------
 void ProxyServer::policy_reload() {
     spdlog::info("[proxy] SIGHUP received — reloading policy: {}", config_.policy_path);
 
-    auto result = PolicyLoader::load(config_.policy_path);
+    const auto live = policy_engine_->current_config();
+    auto result = PolicyLoader::load(config_.policy_path, live.get());
     if (!result) {
         spdlog::warn("[proxy] policy reload failed (keeping current policy): {}", result.error());
         return;
@@ -208,39 +350,100 @@ void ProxyServer::run(boost::asio::io_context& io_ctx) {
         return;
     }
 
+    // 업스트림 목록 검증 (fail-close: 잘못된 목록/선택 방식이면 기동 중단)
+    if (!init_upstreams(io_ctx)) {
+        return;
+    }
+
+    // -----------------------------------------------------------------------
+    // 2b. 리스너 인계 (무중단 교체, fail-close: 인계 실패 시 기동 중단)
+    //   기존 프로세스는 fd 를 보낸 직후 drain 에 들어가므로 이후 단계는 실패하지 않는 것만 둔다.
+    // -----------------------------------------------------------------------
+    if (!config_.listener_handoff_from.empty() && !inherit_listeners()) {
+        return;
+    }
+
     // -----------------------------------------------------------------------
-    // 3. PolicyLoader::load
+    // 3. PolicyVersionStore 생성 + PolicyLoader::load
+    //    바이너리 스냅샷이 켜져 있고 원본이 마지막 스냅샷과 같으면 .bin 에서 복원한다
+    //    (cached_version != 0 → 새 스냅샷을 저장하지 않고 그 버전을 그대로 사용).
     // -----------------------------------------------------------------------
+    const std::filesystem::path policy_path{config_.policy_path};
+    {
+        const auto config_dir = policy_path.parent_path().empty() ? std::filesystem::current_path()
+                                                                  : policy_path.parent_path();
+        version_store_ = std::make_shared<PolicyVersionStore>(
+            config_dir, 10U, config_.policy_binary_snapshots);
+    }
+
     std::shared_ptr<PolicyConfig> policy_config;
+    std::uint64_t cached_version = 0;
+
+    if (config_.policy_binary_snapshots) {
+        auto cached = version_store_->load_cached(policy_path);
+        if (cached) {
+            cached_version = cached->meta.version;
+            policy_config = std::make_shared<PolicyConfig>(std::move(cached->config));
+            spdlog::info("[proxy] policy restored from binary snapshot v{}", cached_version);
+        } else {
+            spdlog::info("[proxy] no usable binary policy snapshot ({})", cached.error());
+        }
+    }
 
-    auto load_result = PolicyLoader::load(config_.policy_path);
-    if (!load_result) {
-        spdlog::warn("[proxy] initial policy load failed (fail-close — all queries blocked): {}",
-                     load_result.error());
-        policy_config = nullptr;
-    } else {
-        policy_config = std::make_shared<PolicyConfig>(std::move(*load_result));
-        spdlog::info("[proxy] policy loaded from: {}", config_.policy_path);
+    if (!policy_config) {
+        auto load_result = PolicyLoader::load(config_.policy_path);
+        if (!load_result) {
+            spdlog::warn(
+                "[proxy] initial policy load failed (fail-close — all queries blocked): {}",
+                load_result.error());
+        } else {
+            policy_config = std::make_shared<PolicyConfig>(std::move(*load_result));
+            spdlog::info("[proxy] policy loaded from: {}", config_.policy_path);
+        }
     }
 
     // -----------------------------------------------------------------------
     // 4. logger, stats, policy_engine 생성
     // -----------------------------------------------------------------------
     const auto log_level = parse_log_level(config_.log_level);
-    logger_ = std::make_shared<StructuredLogger>(log_level, config_.log_path);
     stats_ = std::make_shared<StatsCollector>();
+    session_registry_ = std::make_shared<SessionRegistry>();
+    user_accounting_ = std::make_shared<UserAccounting>();
+    if (config_.top_queries_capacity > 0) {
+        query_topk_ = std::make_shared<QueryTopK>(config_.top_queries_capacity);
+    }
+    AsyncLogOptions async_log{
+        .enabled = config_.log_async_enabled,
+        .queue_capacity = config_.log_queue_capacity,
+        .flush_batch = config_.log_flush_batch,
+        .flush_interval = std::chrono::milliseconds{config_.log_flush_interval_ms},
+        .overflow_policy = parse_log_overflow_policy(config_.log_overflow_policy),
+        .sample_keep_every = config_.log_sample_keep_every,
+        .stats = stats_,
+    };
+    // 정책 로드 실패 시 global 설정이 없으므로 기본 형식(JSON)을 사용한다
+    const auto log_format =
+        policy_config ? parse_log_format(policy_config->global.log_format) : LogFormat::kJson;
+    logger_ = std::make_shared<StructuredLogger>(
+        log_level, config_.log_path, std::move(async_log), log_format);
+    if (log_format == LogFormat::kBinary) {
+        spdlog::info("[proxy] binary audit log: {}",
+                     BinaryAuditSink::audit_path_for(config_.log_path).string());
+    }
+    if (config_.log_async_enabled) {
+        spdlog::info("[proxy] async audit logging enabled (queue={}, overflow={})",
+                     config_.log_queue_capacity,
+                     config_.log_overflow_policy);
+    }
     policy_engine_ = std::make_shared<PolicyEngine>(policy_config);
 
     // -----------------------------------------------------------------------
-    // 4b. PolicyVersionStore 생성 + 초기 스냅샷 저장 (DON-50)
+    // 4b. 초기 스냅샷 저장 (DON-50)
     // -----------------------------------------------------------------------
     {
-        const std::filesystem::path policy_path{config_.policy_path};
-        const auto config_dir = policy_path.parent_path().empty() ? std::filesystem::current_path()
-                                                                  : policy_path.parent_path();
-        version_store_ = std::make_shared<PolicyVersionStore>(config_dir);
-
-        if (policy_config) {
+        if (cached_version != 0) {
+            policy_engine_->reload(policy_config, cached_version);
+        } else if (policy_config) {
             // 초기 로드 성공 시 스냅샷 저장 (버전 관리 시작)
             auto save_result = version_store_->save_snapshot(*policy_config, policy_path);
             if (!save_result) {
@@ -272,9 +475,17 @@ void ProxyServer::run(boost::asio::io_context& io_ctx) {
     if (config_.uds_allowed_uid >= 0) {
         uds_server_->set_allowed_uid(static_cast<uid_t>(config_.uds_allowed_uid));
     }
+    uds_server_->set_session_registry(session_registry_);
+    uds_server_->set_user_accounting(user_accounting_);
+    uds_server_->set_query_topk(query_topk_);
+    uds_server_->set_drain_control(DrainControl{
+        .listener_fds = [this](std::uint16_t port) { return handoff_listener_fds(port); },
+        .begin_drain = [this](std::string_view reason,
+                              bool handed_off) { drain(reason, handed_off); },
+    });
 
     boost::asio::co_spawn(
-        io_ctx,
+        uds_server_->executor(),
         uds_server_->run(),
         [](std::exception_ptr eptr) {  // NOLINT(performance-unnecessary-value-param)
             if (eptr) {
@@ -289,10 +500,14 @@ void ProxyServer::run(boost::asio::io_context& io_ctx) {
     // -----------------------------------------------------------------------
     // 6. HealthCheck 생성 + co_spawn
     // -----------------------------------------------------------------------
-    health_check_ = std::make_unique<HealthCheck>(config_.health_check_port, stats_, io_ctx);
+    health_check_ = std::make_unique<HealthCheck>(
+        config_.health_check_port, stats_, io_ctx, config_.metrics_token);
+    if (inherited_fds_.size() > 1) {
+        health_check_->adopt_listener(inherited_fds_[1]);
+    }
 
     boost::asio::co_spawn(
-        io_ctx,
+        health_check_->executor(),
         health_check_->run(),
         [](std::exception_ptr eptr) {  // NOLINT(performance-unnecessary-value-param)
             if (eptr) {
@@ -322,21 +537,143 @@ void ProxyServer::run(boost::asio::io_context& io_ctx) {
         signals_hup->async_wait(
             [this, setup_hup](const boost::system::error_code& ec, int /*signum*/) {
                 if (!ec) {
-                    policy_reload();
+                    // YAML 파싱/스냅샷 I/O 는 관리 워커에서 실행한다 (세션 io_context 비블로킹).
+                    // 게시는 PolicyEngine 의 atomic 교체이므로 워커에서 바로 수행한다.
+                    boost::asio::post(uds_server_->control_executor(),
+                                      [this] { policy_reload(); });
                     (*setup_hup)();
                 }
             });
     };
     (*setup_hup)();
 
+    // -----------------------------------------------------------------------
+    // 7b. 업스트림 백엔드 (초기 해석 1회 + 백그라운드 갱신 / 헬스 probe)
+    //   세션은 마지막 성공 결과를 공유하므로 연결 수립이 리졸버를 기다리지 않는다.
+    // -----------------------------------------------------------------------
+    const auto resolved = upstream_set_->resolve_initial();
+    spdlog::info("[proxy] upstreams: {} configured, {} resolved, balance={}",
+                 upstream_set_->size(),
+                 resolved,
+                 config_.upstream_balance);
+    upstream_set_->start();
+
+    if (config_.ssl_ktls_enabled &&
+        (config_.frontend_ssl_enabled || config_.backend_ssl_enabled)) {
+        spdlog::info("[proxy] kernel TLS offload requested (falls back to user-space TLS)");
+    }
+
+    if (config_.pipeline_depth > 0) {
+        spdlog::info("[proxy] command pipelining enabled (depth={})",
+                     std::min<std::size_t>(config_.pipeline_depth, ResponsePipeline::kMaxDepth));
+    }
+
+    // -----------------------------------------------------------------------
+    // 7c. 백엔드 연결 풀 (opt-in)
+    // -----------------------------------------------------------------------
+    if (config_.backend_pool_enabled) {
+        backend_pool_ = std::make_shared<BackendPool>(
+            config_.backend_pool_max_idle,
+            config_.backend_pool_max_idle_per_key,
+            std::chrono::seconds{config_.backend_pool_idle_timeout_sec},
+            stats_);
+        spdlog::info("[proxy] backend connection pool enabled (max_idle={}, per_key={}, "
+                     "idle_timeout={}s)",
+                     config_.backend_pool_max_idle,
+                     config_.backend_pool_max_idle_per_key,
+                     config_.backend_pool_idle_timeout_sec);
+
+        boost::asio::co_spawn(
+            io_ctx,
+            pool_sweep_loop(),
+            [](std::exception_ptr eptr) {  // NOLINT(performance-unnecessary-value-param)
+                if (eptr) {
+                    try {
+                        std::rethrow_exception(eptr);
+                    } catch (const std::exception& e) {
+                        spdlog::error("[proxy] backend pool sweep error: {}", e.what());
+                    }
+                }
+            });
+    }
+
+    // -----------------------------------------------------------------------
+    // 7d. 통계 윈도우 표본 (1초 주기)
+    // -----------------------------------------------------------------------
+    boost::asio::co_spawn(
+        io_ctx,
+        stats_tick_loop(),
+        [](std::exception_ptr eptr) {  // NOLINT(performance-unnecessary-value-param)
+            if (eptr) {
+                try {
+                    std::rethrow_exception(eptr);
+                } catch (const std::exception& e) {
+                    spdlog::error("[proxy] stats tick error: {}", e.what());
+                }
+            }
+        });
+
+    // -----------------------------------------------------------------------
+    // 7e. 릴레이 버퍼 메모리 예산 (사용량은 항상 집계, 전체 상한은 opt-in)
+    // -----------------------------------------------------------------------
+    relay_budget_ = std::make_shared<RelayBudget>(
+        static_cast<std::size_t>(config_.relay_session_buffer_kb) * 1024U,
+        static_cast<std::size_t>(config_.relay_global_buffer_mb) * 1024U * 1024U,
+        stats_);
+    if (config_.relay_global_buffer_mb > 0) {
+        spdlog::info("[proxy] relay buffer budget: {} KiB per session, {} MiB total",
+                     config_.relay_session_buffer_kb,
+                     config_.relay_global_buffer_mb);
+    }
+
+    // -----------------------------------------------------------------------
+    // 7f. 연결 허용 판정 (재접속 폭주 방어, 모든 검사 opt-in — 핸드셰이크 제한 시간 제외)
+    // -----------------------------------------------------------------------
+    admission_ = std::make_shared<AdmissionControl>(AdmissionOptions{
+        .accept_rate = config_.accept_rate_per_sec,
+        .accept_burst = config_.accept_burst,
+        .max_pending_handshakes = config_.max_pending_handshakes,
+        .max_connections_per_ip = config_.max_connections_per_ip,
+        .handshake_timeout = std::chrono::milliseconds{config_.handshake_timeout_ms},
+    });
+    if (config_.accept_rate_per_sec > 0 || config_.max_pending_handshakes > 0 ||
+        config_.max_connections_per_ip > 0) {
+        spdlog::info(
+            "[proxy] admission control: accept_rate={}/s burst={} max_pending_handshakes={} "
+            "max_connections_per_ip={}",
+            config_.accept_rate_per_sec,
+            config_.accept_burst,
+            config_.max_pending_handshakes,
+            config_.max_connections_per_ip);
+    }
+
+    // -----------------------------------------------------------------------
+    // 7g. 세션 타이머 휠 (유휴 / 핸드셰이크 제한 시간, 프로세스 공용)
+    // -----------------------------------------------------------------------
+    timer_wheel_ = std::make_shared<TimerWheel>();
+    boost::asio::co_spawn(
+        io_ctx,
+        timer_wheel_loop(),
+        [](std::exception_ptr eptr) {  // NOLINT(performance-unnecessary-value-param)
+            if (eptr) {
+                try {
+                    std::rethrow_exception(eptr);
+                } catch (const std::exception& e) {
+                    spdlog::error("[proxy] timer wheel error: {}", e.what());
+                }
+            }
+        });
+
     // -----------------------------------------------------------------------
     // 8. Accept 루프 (co_spawn)
     // -----------------------------------------------------------------------
     const auto listen_addr = boost::asio::ip::make_address(config_.listen_address);
     const auto listen_ep = boost::asio::ip::tcp::endpoint{listen_addr, config_.listen_port};
 
+    // acceptor 는 accept_strand_ 에서만 만진다 (drain() 의 close 와 accept 루프 직렬화)
+    accept_strand_ = boost::asio::make_strand(io_ctx);
     boost::asio::co_spawn(
-        io_ctx,
+        accept_strand_,
         accept_loop(listen_ep),
         [](std::exception_ptr eptr) {  // NOLINT(performance-unnecessary-value-param)
             if (eptr) {
@@ -353,15 +690,99 @@ void ProxyServer::run(boost::asio::io_context& io_ctx) {
 // ProxyServer::accept_loop
 //   TCP Accept 루프 코루틴.
 //   Frontend SSL이 활성화된 경우 accept 후 TLS 핸드셰이크를 수행한다.
+//   거부 판정(max_connections / AdmissionControl)은 세션 생성·upstream 선택 전에 끝낸다.
 // ---------------------------------------------------------------------------
 boost::asio::awaitable<void> ProxyServer::accept_loop(boost::asio::ip::tcp::endpoint listen_ep) {
-    boost::asio::ip::tcp::acceptor acceptor{*io_ctx_, listen_ep};
-    acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+    // 리스너 옵션(버퍼 크기, defer accept, fast open)은 bind/listen 전에 적용한다
+    //   인계받은 리스너는 이미 listen 중이다: 옵션만 다시 적용하고 bind 하지 않는다
+    acceptor_ = std::make_unique<boost::asio::ip::tcp::acceptor>(accept_strand_);
+    auto& acceptor = *acceptor_;
+    const bool inherited = !inherited_fds_.empty();
+    if (inherited) {
+        acceptor.assign(listen_ep.protocol(), std::exchange(inherited_fds_.front(), -1));
+        inherited_fds_.clear();
+    } else {
+        acceptor.open(listen_ep.protocol());
+        acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+    }
+
+    SocketTuning tuning{
+        .no_delay = config_.tcp_nodelay,
+        .recv_buffer_bytes = 0,  // 리스너에서 물려받는다
+        .send_buffer_bytes = 0,
+        .busy_poll_us = config_.socket_busy_poll_us,
+    };
+    if (tuning.busy_poll_us > 0) {
+        // SO_BUSY_POLL 은 권한(CAP_NET_ADMIN)에 따라 실패한다: 연결마다 경고하지 않도록 미리 확인
+        boost::asio::ip::tcp::socket probe{*io_ctx_};
+        boost::system::error_code probe_ec;
+        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+        probe.open(listen_ep.protocol(), probe_ec);
+        const SocketTuning busy_only{.no_delay = false, .busy_poll_us = tuning.busy_poll_us};
+        if (probe_ec || !apply_socket_tuning(probe, busy_only)) {
+            spdlog::warn("[proxy] SO_BUSY_POLL={}us not permitted, busy polling disabled",
+                         tuning.busy_poll_us);
+            tuning.busy_poll_us = 0;
+        }
+    }
 
-    spdlog::info("[proxy] listening on {}:{} (SSL={})",
+    ListenerTuning listener_tuning{
+        .recv_buffer_bytes = config_.socket_recv_buffer_bytes,
+        .send_buffer_bytes = config_.socket_send_buffer_bytes,
+        .defer_accept_sec = config_.tcp_defer_accept_sec,
+        .fastopen_queue = config_.tcp_fastopen_queue,
+    };
+    if (listener_tuning.defer_accept_sec > 0 && !config_.frontend_ssl_enabled) {
+        // 평문 MySQL 은 서버 greeting 이 먼저다: defer 하면 모든 연결이 그 시간만큼 늦어진다
+        spdlog::warn("[proxy] TCP_DEFER_ACCEPT ignored: client sends nothing before the "
+                     "server greeting without frontend TLS");
+        listener_tuning.defer_accept_sec = 0;
+    }
+    if (auto tuned = apply_listener_tuning(acceptor, listener_tuning); !tuned) {
+        spdlog::warn("[proxy] listener socket option {} failed", tuned.error());
+    }
+    if (!inherited) {
+        acceptor.bind(listen_ep);
+        acceptor.listen();
+    }
+    listen_fd_.store(acceptor.native_handle(), std::memory_order_release);
+    if (config_.socket_recv_buffer_bytes > 0 || config_.socket_send_buffer_bytes > 0 ||
+        tuning.busy_poll_us > 0 || listener_tuning.defer_accept_sec > 0 ||
+        listener_tuning.fastopen_queue > 0 || !tuning.no_delay) {
+        spdlog::info("[proxy] socket tuning: nodelay={} rcvbuf={} sndbuf={} busy_poll={}us "
+                     "defer_accept={}s fastopen={}",
+                     tuning.no_delay,
+                     config_.socket_recv_buffer_bytes,
+                     config_.socket_send_buffer_bytes,
+                     tuning.busy_poll_us,
+                     listener_tuning.defer_accept_sec,
+                     listener_tuning.fastopen_queue);
+    }
+
+    spdlog::info("[proxy] listening on {}:{} (SSL={}{})",
                  config_.listen_address,
                  config_.listen_port,
-                 config_.frontend_ssl_enabled ? "frontend" : "none");
+                 config_.frontend_ssl_enabled ? "frontend" : "none",
+                 inherited ? ", inherited listener" : "");
+
+    const TcpKeepalive keepalive{
+        .idle_sec = config_.tcp_keepalive_idle_sec,
+        .interval_sec = config_.tcp_keepalive_interval_sec,
+        .probes = config_.tcp_keepalive_probes,
+        .user_timeout_ms = config_.tcp_user_timeout_ms,
+    };
+    const SessionTimeouts timeouts{
+        .wheel = timer_wheel_,
+        .idle_timeout = std::chrono::seconds{config_.connection_timeout_sec},
+        .keepalive = keepalive,
+    };
+    // 업스트림 소켓은 리스너가 없으므로 버퍼 크기를 connect 전에 직접 설정한다
+    const SocketTuning upstream_tuning{
+        .no_delay = tuning.no_delay,
+        .recv_buffer_bytes = config_.socket_recv_buffer_bytes,
+        .send_buffer_bytes = config_.socket_send_buffer_bytes,
+        .busy_poll_us = tuning.busy_poll_us,
+    };
 
     while (!stopping_) {
         boost::system::error_code ec;
@@ -369,7 +790,7 @@ boost::asio::awaitable<void> ProxyServer::accept_loop(boost::asio::ip::tcp::endp
             boost::asio::redirect_error(boost::asio::use_awaitable, ec));
 
         if (ec) {
-            if (ec == boost::asio::error::operation_aborted) {
+            if (ec == boost::asio::error::operation_aborted || !acceptor.is_open()) {
                 spdlog::info("[proxy] acceptor closed");
                 break;
             }
@@ -386,56 +807,77 @@ boost::asio::awaitable<void> ProxyServer::accept_loop(boost::asio::ip::tcp::endp
         }
 
         // max_connections 초과 시 unhealthy 전환 + 연결 거부
+        //   활성 수는 SessionRegistry 기준 (등록 즉시 반영, 통계 스냅샷 계산 없음)
         if (config_.max_connections > 0) {
-            const auto snap = stats_->snapshot();
-            if (snap.active_sessions >= config_.max_connections) {
+            const auto active = session_registry_->size();
+            if (active >= config_.max_connections) {
                 spdlog::warn("[proxy] max_connections ({}) reached, rejecting new connection",
                              config_.max_connections);
                 health_check_->set_unhealthy(
                     std::format("max_connections ({}) reached", config_.max_connections));
+                stats_->on_connection_rejected();
                 boost::system::error_code close_ec;
                 client_sock.close(close_ec);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
                 continue;
             }
 
-            if (health_check_->status() == HealthStatus::kUnhealthy &&
-                snap.active_sessions < config_.max_connections) {
+            if (health_check_->status() == HealthStatus::kUnhealthy) {
                 health_check_->set_healthy();
             }
         }
 
+        // accept 속도 / pending 핸드셰이크 / 출발지 IP 별 상한
+        //   폭주 중에는 거부가 대량이므로 debug 로만 남기고 connections_rejected 로 집계한다.
+        boost::system::error_code peer_ec;
+        const auto peer = client_sock.remote_endpoint(peer_ec);
+        if (peer_ec) {
+            boost::system::error_code close_ec;
+            client_sock.close(close_ec);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+            continue;
+        }
+        auto admission = admission_->try_admit(peer.address());
+        if (!admission) {
+            spdlog::debug("[proxy] rejecting connection from {} ({})",
+                          peer.address().to_string(),
+                          admission_reject_name(admission.error()));
+            stats_->on_connection_rejected();
+            boost::system::error_code close_ec;
+            client_sock.close(close_ec);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+            continue;
+        }
+
+        // 옵션 실패는 연결을 거부하지 않는다 (keepalive / 튜닝은 보조 수단)
+        if (auto ka = apply_tcp_keepalive(client_sock, keepalive); !ka) {
+            spdlog::warn("[proxy] client socket option {} failed", ka.error());
+        }
+        if (auto tuned = apply_socket_tuning(client_sock, tuning); !tuned) {
+            spdlog::warn("[proxy] client socket option {} failed", tuned.error());
+        }
+
         // 세션 ID 할당
         const std::uint64_t sid = next_session_id_.fetch_add(1, std::memory_order_relaxed);
 
-        // upstream 호스트명 해석
-        boost::asio::ip::tcp::resolver resolver{*io_ctx_};
-        boost::system::error_code resolve_ec;
-        auto resolve_results = co_await resolver.async_resolve(
-            config_.upstream_address,
-            std::to_string(config_.upstream_port),
-            boost::asio::redirect_error(boost::asio::use_awaitable, resolve_ec));
-
-        if (resolve_ec || resolve_results.empty()) {
-            spdlog::error("[proxy] failed to resolve upstream {}: {}",
-                          config_.upstream_address,
-                          resolve_ec.message());
+        // upstream 선택: 해석 완료 + 제외되지 않은 백엔드 중 하나 (해석/probe 대기 없음)
+        auto upstream = upstream_set_->select();
+        if (!upstream) {
+            spdlog::error(
+                "[proxy] no resolved healthy upstream, rejecting connection (fail-close)");
             boost::system::error_code close_ec;
             client_sock.close(close_ec);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
             continue;
         }
 
-        const auto server_ep = *resolve_results.begin();
-
         // ──────────────────────────────────────────────────────────────────
         // Frontend SSL 처리
         //   SSL이 활성화된 경우: ssl::stream으로 래핑 (핸드셰이크는 Session::run에서 수행)
+        //                       kTLS 모드면 KtlsStream (생성 실패 시 ssl::stream 폴백)
         //   SSL이 비활성화된 경우: tcp::socket → AsyncStream
         // ──────────────────────────────────────────────────────────────────
         AsyncStream client_stream{AsyncStream::tcp_socket{client_sock.get_executor()}};
 
         if (frontend_ssl_ctx_.has_value()) {
-            AsyncStream::ssl_socket ssl_client_sock{std::move(client_sock), *frontend_ssl_ctx_};
-            client_stream = AsyncStream{std::move(ssl_client_sock)};
+            client_stream = AsyncStream::make_tls(
+                std::move(client_sock), *frontend_ssl_ctx_, config_.ssl_ktls_enabled);
         } else {
             client_stream = AsyncStream{std::move(client_sock)};
         }
@@ -444,21 +886,45 @@ boost::asio::awaitable<void> ProxyServer::accept_loop(boost::asio::ip::tcp::endp
         boost::asio::ssl::context* backend_ssl_ctx_ptr =
             backend_ssl_ctx_.has_value() ? &(*backend_ssl_ctx_) : nullptr;
 
-        const auto backend_tls_server_name =
-            config_.upstream_ssl_sni.empty() ? config_.upstream_address : config_.upstream_ssl_sni;
+        const std::string backend_tls_server_name = config_.upstream_ssl_sni.empty()
+                                                        ? std::string{upstream->host}
+                                                        : config_.upstream_ssl_sni;
 
         // 세션 생성
         auto session = std::make_shared<Session>(sid,
                                                  std::move(client_stream),
-                                                 server_ep,
+                                                 upstream->endpoint,
                                                  backend_ssl_ctx_ptr,
                                                  config_.backend_ssl_verify,
                                                  backend_tls_server_name,
                                                  policy_engine_,
                                                  logger_,
-                                                 stats_);
-
-        sessions_.emplace(sid, session);
+                                                 stats_,
+                                                 backend_pool_,
+                                                 config_.pipeline_depth,
+                                                 config_.ssl_ktls_enabled,
+                                                 backend_tls_sessions_.get(),
+                                                 relay_budget_,
+                                                 std::move(upstream->lease),
+                                                 session_registry_->add(sid),
+                                                 std::move(*admission),
+                                                 timeouts,
+                                                 upstream_tuning,
+                                                 query_topk_);
+
+        {
+            // stop() 의 세션 순회와 경합하지 않도록 stopping_ 재확인을 락 안에서 수행한다.
+            const std::lock_guard<std::mutex> lock{sessions_mutex_};
+            if (stopping_.load(std::memory_order_acquire)) {
+                session_registry_->remove(sid);
+                continue;
+            }
+            sessions_.emplace(sid, session);
+        }
+        if (draining_.load(std::memory_order_acquire)) {
+            // drain 시작과 acceptor close 사이에 accept 된 연결도 같은 규칙으로 마무리한다
+            session->drain(std::chrono::seconds{config_.drain_idle_sec});
+        }
 
         spdlog::debug("[proxy] new session {}", sid);
 
@@ -475,29 +941,108 @@ boost::asio::awaitable<void> ProxyServer::accept_loop(boost::asio::ip::tcp::endp
                     }
                 }
 
-                sessions_.erase(sid);
-                spdlog::debug("[proxy] session {} removed (active: {})", sid, sessions_.size());
+                // 완료 콜백은 세션 strand 에서 실행되므로 워커 스레드 간 경합이 가능하다.
+                std::size_t remaining = 0;
+                {
+                    const std::lock_guard<std::mutex> lock{sessions_mutex_};
+                    sessions_.erase(sid);
+                    remaining = sessions_.size();
+                }
+                if (const auto finished = session_registry_->remove(sid)) {
+                    user_accounting_->retire(*finished);
+                }
+                spdlog::debug("[proxy] session {} removed (active: {})", sid, remaining);
 
-                if (stopping_ && sessions_.empty()) {
+                if (remaining == 0 && stopping_.load(std::memory_order_acquire)) {
                     spdlog::info("[proxy] all sessions closed, stopping io_context");
                     io_ctx_->stop();
+                } else if (remaining == 0 && draining_.load(std::memory_order_acquire)) {
+                    spdlog::info("[proxy] drain complete, all sessions closed");
+                    stop();
                 }
             });
     }
 }
 
+// ---------------------------------------------------------------------------
+// ProxyServer::pool_sweep_loop
+//   유휴 타임아웃의 절반 주기(최소 1초)로 만료된 풀 연결을 닫는다.
+//   acquire() 도 만료 연결을 건너뛰지만, 요청이 없는 키의 연결이 서버 자원을
+//   계속 점유하지 않도록 주기적으로 정리한다.
+// ---------------------------------------------------------------------------
+boost::asio::awaitable<void> ProxyServer::pool_sweep_loop() {
+    const auto interval =
+        std::max(std::chrono::seconds{1}, backend_pool_->idle_timeout() / 2);
+    boost::asio::steady_timer timer{co_await boost::asio::this_coro::executor};
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        timer.expires_after(interval);
+        boost::system::error_code ec;
+        co_await timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        if (stopping_.load(std::memory_order_acquire)) {
+            break;
+        }
+        const auto evicted = backend_pool_->evict_expired(std::chrono::steady_clock::now());
+        if (evicted > 0) {
+            spdlog::debug("[proxy] backend pool: closed {} idle connection(s)", evicted);
+        }
+    }
+    backend_pool_->clear();
+}
+
+// ---------------------------------------------------------------------------
+// ProxyServer::stats_tick_loop
+//   1초마다 쿼리 합계 표본을 기록한다. snapshot() 의 1s/10s/60s 윈도우 기준점.
+//   같은 주기로 db_user 별 집계 테이블을 갱신한다 (활성 세션 수에 비례하는 합산).
+// ---------------------------------------------------------------------------
+boost::asio::awaitable<void> ProxyServer::stats_tick_loop() {
+    boost::asio::steady_timer timer{co_await boost::asio::this_coro::executor};
+    auto next = std::chrono::steady_clock::now();
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        // 주기가 밀리지 않도록 절대 시각 기준으로 대기 (지연 시 한꺼번에 따라잡지 않음)
+        next = std::max(next + std::chrono::seconds{1}, std::chrono::steady_clock::now());
+        timer.expires_at(next);
+        boost::system::error_code ec;
+        co_await timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        if (stopping_.load(std::memory_order_acquire)) {
+            break;
+        }
+        stats_->tick();
+        user_accounting_->refresh(*session_registry_);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ProxyServer::timer_wheel_loop
+//   휠 tick 주기(100ms)마다 advance() 를 호출한다. 만료 콜백은 세션 strand 로 post 만
+//   하므로 이 코루틴은 막히지 않는다. stats_tick_loop 와 같이 절대 시각 기준으로 대기한다.
+// ---------------------------------------------------------------------------
+boost::asio::awaitable<void> ProxyServer::timer_wheel_loop() {
+    boost::asio::steady_timer timer{co_await boost::asio::this_coro::executor};
+    auto next = std::chrono::steady_clock::now();
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        next = std::max(next + timer_wheel_->tick(), std::chrono::steady_clock::now());
+        timer.expires_at(next);
+        boost::system::error_code ec;
+        co_await timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        if (stopping_.load(std::memory_order_acquire)) {
+            break;
+        }
+        timer_wheel_->advance(std::chrono::steady_clock::now());
+    }
+}
+
 // ---------------------------------------------------------------------------
 // ProxyServer::stop
 // ---------------------------------------------------------------------------
 void ProxyServer::stop() {
-    if (stopping_) {
+    // 시그널 핸들러는 임의의 워커 스레드에서 호출될 수 있으므로 exchange 로 1회 보장
+    if (stopping_.exchange(true, std::memory_order_acq_rel)) {
         return;
     }
 
-    stopping_ = true;
-
-    spdlog::info("[proxy] stopping — active sessions: {}", sessions_.size());
-
     if (health_check_) {
         health_check_->set_unhealthy("proxy shutting down");
     }
@@ -506,13 +1051,121 @@ void ProxyServer::stop() {
         uds_server_->stop();
     }
 
-    for (auto& [sid, session] : sessions_) {
-        spdlog::debug("[proxy] closing session {}", sid);
-        session->close();
+    if (upstream_set_) {
+        upstream_set_->stop();
+    }
+
+    if (backend_pool_) {
+        backend_pool_->clear();
     }
 
-    if (sessions_.empty() && io_ctx_ != nullptr) {
+    bool no_sessions = false;
+    {
+        const std::lock_guard<std::mutex> lock{sessions_mutex_};
+        spdlog::info("[proxy] stopping — active sessions: {}", sessions_.size());
+
+        // close() 는 strand 로 post 만 하므로 락 구간에서 호출해도 재진입하지 않는다.
+        for (auto& [sid, session] : sessions_) {
+            spdlog::debug("[proxy] closing session {}", sid);
+            session->close();
+        }
+        no_sessions = sessions_.empty();
+    }
+
+    if (no_sessions && io_ctx_ != nullptr) {
         spdlog::info("[proxy] no active sessions, stopping io_context immediately");
         io_ctx_->stop();
     }
 }
+
+// ---------------------------------------------------------------------------
+// ProxyServer::drain
+//   stop() 과 달리 세션을 바로 닫지 않는다: 커맨드 경계에서 하나씩 끝나기를 기다린다.
+// ---------------------------------------------------------------------------
+void ProxyServer::drain(std::string_view reason, bool handed_off) {
+    if (stopping_.load(std::memory_order_acquire) ||
+        draining_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    // 인계 뒤에는 같은 리스너를 새 프로세스가 들고 있다 — 이쪽 fd 만 닫으면 된다
+    listen_fd_.store(-1, std::memory_order_release);
+    if (accept_strand_) {
+        boost::asio::post(accept_strand_, [this] {
+            if (acceptor_) {
+                boost::system::error_code ec;
+                // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+                acceptor_->close(ec);
+            }
+        });
+    }
+
+    if (health_check_) {
+        health_check_->set_draining(reason);
+        if (handed_off) {
+            health_check_->stop_accepting();
+        }
+    }
+
+    const std::chrono::milliseconds idle_threshold{std::chrono::seconds{config_.drain_idle_sec}};
+    bool no_sessions = false;
+    {
+        const std::lock_guard<std::mutex> lock{sessions_mutex_};
+        spdlog::info("[proxy] draining ({}) — active sessions: {}, idle threshold {}s",
+                     reason,
+                     sessions_.size(),
+                     config_.drain_idle_sec);
+        for (auto& [sid, session] : sessions_) {
+            session->drain(idle_threshold);
+        }
+        no_sessions = sessions_.empty();
+    }
+
+    if (no_sessions) {
+        spdlog::info("[proxy] drain complete, no active sessions");
+        stop();
+        return;
+    }
+
+    if (config_.drain_timeout_sec > 0 && io_ctx_ != nullptr) {
+        auto timer = std::make_shared<boost::asio::steady_timer>(
+            *io_ctx_, std::chrono::seconds{config_.drain_timeout_sec});
+        timer->async_wait([this, timer](const boost::system::error_code& ec) {
+            if (ec || stopping_.load(std::memory_order_acquire)) {
+                return;
+            }
+            spdlog::warn("[proxy] drain timeout ({}s) — closing remaining sessions",
+                         config_.drain_timeout_sec);
+            stop();
+        });
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ProxyServer::active_sessions
+// ---------------------------------------------------------------------------
+std::size_t ProxyServer::active_sessions() const {
+    const std::lock_guard<std::mutex> lock{sessions_mutex_};
+    return sessions_.size();
+}
+
+// ---------------------------------------------------------------------------
+// ProxyServer::handoff_listener_fds
+//   UdsServer 연결 스레드에서 호출된다. fd 값만 읽으며 소유권은 넘기지 않는다
+//   (SCM_RIGHTS 가 상대 프로세스에 복제한다).
+// ---------------------------------------------------------------------------
+std::vector<int> ProxyServer::handoff_listener_fds(std::uint16_t listen_port) const {
+    if (draining_.load(std::memory_order_acquire) ||
+        stopping_.load(std::memory_order_acquire) || listen_port != config_.listen_port) {
+        return {};
+    }
+    const int proxy_fd = listen_fd_.load(std::memory_order_acquire);
+    if (proxy_fd < 0) {
+        return {};
+    }
+    std::vector<int> fds{proxy_fd};
+    if (health_check_ && health_check_->listener_fd() >= 0) {
+        fds.push_back(health_check_->listener_fd());
+    }
+    return fds;
+}
@@ -1,24 +1,39 @@
 #pragma once
 
 #include <atomic>
+#include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/context.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "health/health_check.hpp"
 #include "logger/structured_logger.hpp"
 #include "policy/policy_engine.hpp"
 #include "policy/policy_loader.hpp"
 #include "policy/policy_version_store.hpp"
+#include "proxy/admission_control.hpp"
+#include "proxy/backend_pool.hpp"
+#include "proxy/relay_budget.hpp"
 #include "proxy/session.hpp"
+#include "proxy/socket_options.hpp"
+#include "proxy/timer_wheel.hpp"
+#include "proxy/tls_session_cache.hpp"
+#include "proxy/upstream_set.hpp"
+#include "stats/query_topk.hpp"
+#include "stats/session_registry.hpp"
 #include "stats/stats_collector.hpp"
 #include "stats/uds_server.hpp"
+#include "stats/user_accounting.hpp"
 
 // ---------------------------------------------------------------------------
 // ProxyConfig
@@ -29,13 +44,49 @@
 //   listen_port           : 프록시 리슨 포트
 //   upstream_address      : 업스트림 MySQL 서버 IP/호스트명
 //   upstream_port         : 업스트림 MySQL 서버 포트
+//   upstream_dns_refresh_sec: 업스트림 호스트명 재해석 주기 (초, 0 = 기동 시 1회)
+//   upstream_list         : 다중 업스트림 "host[:port][@weight],..." (빈 문자열 = upstream_address
+//                           /upstream_port 하나, UpstreamSet 참조)
+//   upstream_balance      : 백엔드 선택 방식 ("least_conn", "round_robin")
+//   upstream_health_interval_ms: 백엔드 probe 주기 (밀리초, 0 = probe/제외 없음)
+//   upstream_health_timeout_ms : probe 1회 제한 시간 (밀리초)
+//   upstream_eject_failures: 연속 실패(probe + 세션 connect) 몇 번에 제외할지
+//   upstream_health_user  : probe 로그인 계정 (비밀번호 없음, 빈 문자열 = greeting 까지만 확인)
 //   max_connections       : 동시 허용 최대 세션 수
-//   connection_timeout_sec: 세션 유휴 타임아웃 (초)
+//   accept_rate_per_sec / accept_burst: accept 토큰 버킷 (초당 연결 수 / 버킷 크기, 0 = 제한 없음
+//                           / accept_rate_per_sec 와 같음)
+//   max_pending_handshakes: 핸드셰이크(accept ~ 백엔드 인증 완료) 진행 중 세션 상한 (0 = 없음)
+//   max_connections_per_ip: 출발지 IP 별 동시 연결 상한 (0 = 없음)
+//   handshake_timeout_ms  : 핸드셰이크 제한 시간 (밀리초, 0 = 없음, AdmissionControl 참조)
+//   connection_timeout_sec: 세션 유휴 타임아웃 — 다음 커맨드를 기다린 시간 (초, 0 = 없음)
+//   tcp_keepalive_idle_sec / tcp_keepalive_interval_sec / tcp_keepalive_probes:
+//                           클라이언트·업스트림 소켓 TCP keepalive (idle 0 = 끔, 나머지 0 = 커널
+//                           기본값)
+//   tcp_user_timeout_ms   : TCP_USER_TIMEOUT (밀리초, 0 = 커널 기본값)
+//   tcp_nodelay           : 클라이언트·업스트림 소켓 TCP_NODELAY (Nagle 끔)
+//   socket_recv_buffer_bytes / socket_send_buffer_bytes: 양쪽 소켓 SO_RCVBUF / SO_SNDBUF
+//                           (0 = 커널 자동 조정)
+//   socket_busy_poll_us   : 양쪽 소켓 SO_BUSY_POLL (µs, 0 = 끔, 권한 없으면 기동 시 끈다)
+//   tcp_defer_accept_sec  : 리스너 TCP_DEFER_ACCEPT (초, 0 = 끔, frontend TLS 일 때만 적용)
+//   tcp_fastopen_queue    : 리스너 TCP_FASTOPEN 큐 길이 (0 = 끔)
+//   listener_handoff_from : 기동 시 리스너를 넘겨받을 기존 dbgate 의 UDS 경로 (빈 문자열 = 직접
+//                           bind, listener_handoff.hpp 참조). 인계 실패 시 기동하지 않는다.
+//   drain_idle_sec        : drain 중 커맨드 대기가 이만큼 이어진 세션을 닫는다 (초, 0 = 다음 커맨드
+//                           경계에서 바로)
+//   drain_timeout_sec     : drain 시작 후 남은 세션을 강제 종료하기까지의 시간 (초, 0 = 무제한)
+//   worker_threads        : io_context::run() 을 호출할 워커 스레드 수
+//                           (1 = 단일 스레드, 0 = hardware_concurrency)
 //   policy_path           : 정책 파일 경로 (YAML)
 //   uds_socket_path       : Go 운영도구와 통신하는 Unix Domain Socket 경로
 //   log_path              : 로그 출력 파일 경로
 //   log_level             : 로그 레벨 문자열 ("trace","debug","info","warn","error")
+//   log_async_enabled     : 감사 로그 비동기 기록 (전용 writer 스레드) 사용 여부
+//   log_queue_capacity    : 비동기 로그 큐 슬롯 수
+//   log_flush_batch / log_flush_interval_ms: writer flush 임계치 (라인 수 / 밀리초)
+//   log_overflow_policy   : 큐 포화 시 동작 ("block", "drop", "sample")
+//   log_sample_keep_every : "sample" 정책에서 포화 구간 동안 N 개 중 1 개 보존
 //   health_check_port     : Health Check HTTP 서버 포트
+//   metrics_token         : Health Check 포트 GET /metrics Bearer 토큰 (빈 문자열 = 비활성)
 //   frontend_ssl_enabled  : Frontend TLS 활성화 여부
 //   frontend_ssl_cert_path: Frontend TLS 인증서 경로 (PEM)
 //   frontend_ssl_key_path : Frontend TLS 개인키 경로 (PEM)
@@ -43,6 +94,18 @@
 //   backend_ssl_ca_path   : Backend CA 인증서 경로 (서버 검증용)
 //   backend_ssl_verify    : Backend 서버 인증서 검증 여부
 //   upstream_ssl_sni      : Backend SNI 호스트명 (빈 문자열 = 미사용)
+//   ssl_ktls_enabled      : TLS 구간 kernel TLS offload 시도 (opt-in, 불가 시 사용자 공간 TLS)
+//   ssl_session_cache_size: TLS 세션 재개 캐시 크기 (frontend 세션 수 / backend 업스트림 키 수,
+//                           0 = 재개 비활성)
+//   ssl_session_timeout_sec: frontend 세션/티켓 수명 (초)
+//   backend_pool_enabled  : 백엔드 연결 풀 사용 여부 (opt-in)
+//   backend_pool_max_idle : 풀 전체 유휴 연결 상한
+//   backend_pool_max_idle_per_key: (user, db, capability, TLS, endpoint) 키당 유휴 연결 상한
+//   backend_pool_idle_timeout_sec: 유휴 연결 보관 시간 (초)
+//   relay_session_buffer_kb: 세션이 커맨드 사이에 유지하는 릴레이 버퍼 상한 (KiB)
+//   relay_global_buffer_mb : 전체 세션 릴레이 버퍼 상한 (MiB, 0 = 제한 없음, RelayBudget 참조)
+//   policy_binary_snapshots: 정책 스냅샷에 바이너리 사본(.bin)도 기록하고, 원본이 바뀌지 않은
+//                            재기동/롤백은 YAML 파싱 없이 복원 (PolicyVersionStore 참조)
 // ---------------------------------------------------------------------------
 struct ProxyConfig {
     std::string listen_address{};
@@ -51,14 +114,76 @@ struct ProxyConfig {
     std::string uds_socket_path{};
     std::string log_path{};
     std::string log_level{};
+    std::string log_overflow_policy{"drop"};
     std::string frontend_ssl_cert_path{};  // PEM 인증서
     std::string frontend_ssl_key_path{};   // PEM 개인키
     std::string backend_ssl_ca_path{};  // MySQL 서버 CA 인증서 (검증용)
     std::string upstream_ssl_sni{};     // SNI 호스트명 (빈 문자열 = 미사용)
+    std::string metrics_token{};        // /metrics Bearer 토큰 (로그 출력 금지)
+    std::string upstream_list{};        // 비어 있으면 upstream_address:upstream_port 하나
+    std::string upstream_balance{"least_conn"};
+    std::string upstream_health_user{};
+    std::string listener_handoff_from{};  // 빈 문자열 = 리스너 직접 bind
 
     std::uint32_t max_connections{0};
     std::uint32_t connection_timeout_sec{0};
 
+    // --- 연결 허용 판정 (AdmissionControl, 0 = 해당 검사 없음) ---
+    std::uint32_t accept_rate_per_sec{0};
+    std::uint32_t accept_burst{0};
+    std::uint32_t max_pending_handshakes{0};
+    std::uint32_t max_connections_per_ip{0};
+    std::uint32_t handshake_timeout_ms{10000};
+
+    // --- 죽은 연결 감지 (TcpKeepalive) ---
+    std::uint32_t tcp_keepalive_idle_sec{0};
+    std::uint32_t tcp_keepalive_interval_sec{0};
+    std::uint32_t tcp_keepalive_probes{0};
+    std::uint32_t tcp_user_timeout_ms{0};
+
+    // --- 소켓 튜닝 (SocketTuning / ListenerTuning) ---
+    bool tcp_nodelay{true};
+    std::uint32_t socket_recv_buffer_bytes{0};
+    std::uint32_t socket_send_buffer_bytes{0};
+    std::uint32_t socket_busy_poll_us{0};
+    std::uint32_t tcp_defer_accept_sec{0};
+    std::uint32_t tcp_fastopen_queue{0};
+
+    // --- drain / 무중단 교체 (ProxyServer::drain) ---
+    std::uint32_t drain_idle_sec{5};
+    std::uint32_t drain_timeout_sec{300};
+
+    std::uint32_t worker_threads{1};
+    std::uint32_t upstream_dns_refresh_sec{30};
+    std::uint32_t upstream_health_interval_ms{2000};
+    std::uint32_t upstream_health_timeout_ms{1000};
+    std::uint32_t upstream_eject_failures{3};
+
+    // --- 비동기 감사 로그 ---
+    std::uint32_t log_queue_capacity{8192};
+    std::uint32_t log_flush_batch{256};
+    std::uint32_t log_flush_interval_ms{200};
+    std::uint32_t log_sample_keep_every{10};
+
+    // --- 백엔드 연결 풀 ---
+    std::uint32_t backend_pool_max_idle{64};
+    std::uint32_t backend_pool_max_idle_per_key{8};
+    std::uint32_t backend_pool_idle_timeout_sec{60};
+
+    // --- TLS 세션 재개 (0 = 비활성) ---
+    std::uint32_t ssl_session_cache_size{1024};
+    std::uint32_t ssl_session_timeout_sec{300};
+
+    // --- 커맨드 파이프라이닝 (0 = 직렬, 최대 ResponsePipeline::kMaxDepth) ---
+    std::uint32_t pipeline_depth{0};
+
+    // --- 릴레이 버퍼 메모리 예산 (RelayBudget) ---
+    std::uint32_t relay_session_buffer_kb{1024};  // 세션이 커맨드 사이에 유지하는 버퍼 상한
+    std::uint32_t relay_global_buffer_mb{0};      // 전체 세션 합계 상한 (0 = 제한 없음)
+
+    // --- fingerprint 별 Top-K 집계 (QueryTopK, 0 = 비활성) ---
+    std::uint32_t top_queries_capacity{256};
+
     // --- UDS 제어 소켓 보안 설정 (DON-53) ---
     std::uint32_t uds_client_timeout_sec{30};  // 클라이언트 읽기 타임아웃 (초)
     std::uint32_t uds_max_connections{8};      // 최대 동시 제어 연결 수
@@ -74,6 +199,10 @@ struct ProxyConfig {
     // 프록시 -> MySQL (backend) TLS
     bool backend_ssl_enabled{false};
     bool backend_ssl_verify{true};  // 서버 인증서 검증 여부
+    bool ssl_ktls_enabled{false};   // frontend/backend TLS 를 KtlsStream 으로 (kTLS 시도)
+    bool backend_pool_enabled{false};
+    bool log_async_enabled{false};
+    bool policy_binary_snapshots{false};
 };
 
 // ---------------------------------------------------------------------------
@@ -84,9 +213,20 @@ struct ProxyConfig {
 //     ProxyServer server(config);
 //     server.run(io_ctx);   // io_ctx.run() 은 호출자가 실행
 //
+//   멀티스레드 실행:
+//     하나의 io_context 를 여러 스레드가 run() 해도 안전하다.
+//     - Session 은 자신의 strand 위에서만 실행되므로 세션 내부는 직렬화된다.
+//     - sessions_ 레지스트리는 sessions_mutex_ 로 보호한다.
+//     - 세션 완료 콜백은 각 세션 strand 에서 호출되므로 서로 다른 스레드일 수 있다.
+//
 //   Graceful Shutdown:
 //     stop() 호출 시 새 연결을 거부하고 기존 세션이 완료되면 io_context 를 중단한다.
 //
+//   Drain / 무중단 바이너리 교체:
+//     drain() 은 accept 를 멈추고 Health Check 를 draining(503)으로 바꾼 뒤, 세션을 커맨드
+//     경계에서 하나씩 정상 종료한다 (Session::drain). UDS "listener_handoff" 는 리스너 fd 를 새
+//     프로세스에 넘긴 뒤 drain 을 시작하므로 클라이언트는 연결 거부 없이 새 프로세스로 옮겨간다.
+//
 //   SSL 지원:
 //     - Frontend SSL: accept 후 ssl::stream으로 TLS 핸드셰이크 → AsyncStream 생성
 //     - Backend SSL: ssl::context 포인터를 Session에 전달, Session에서 connect 후 TLS 업그레이드
@@ -124,22 +264,73 @@ public:
     // -----------------------------------------------------------------------
     void stop();
 
+    // -----------------------------------------------------------------------
+    // drain
+    //   새 연결 accept 를 멈추고 기존 세션이 스스로 끝나기를 기다린다.
+    //   - 프록시 리스너 닫기 — 인계된 경우(handed_off) 새 프로세스가 계속 accept 한다
+    //   - Health Check 를 kDraining 으로 (로드밸런서가 트래픽을 옮긴다). handed_off 면
+    //     Health Check 리스너도 새 프로세스로 넘어갔으므로 이쪽 accept 를 멈춘다
+    //   - 세션마다 Session::drain(drain_idle_sec): 처리 중인 쿼리는 끝까지, 유휴 세션은 닫힘
+    //   - 마지막 세션이 끝나거나 drain_timeout_sec 이 지나면 stop()
+    //   중복 호출 / stop() 이후 호출은 무시한다. 임의 스레드에서 호출 가능.
+    // -----------------------------------------------------------------------
+    void drain(std::string_view reason, bool handed_off = false);
+
+    // -----------------------------------------------------------------------
+    // active_sessions
+    //   sessions_ 에 등록된 세션 수. 세션은 완료 콜백에서 erase 되므로 stop() 후 마지막 세션이
+    //   끝나면 0 이다. 임의 스레드에서 호출 가능 (sessions_mutex_).
+    // -----------------------------------------------------------------------
+    [[nodiscard]] std::size_t active_sessions() const;
+
 private:
     ProxyConfig config_;
-    bool stopping_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> draining_{false};
 
     std::shared_ptr<PolicyEngine> policy_engine_{};
     std::shared_ptr<StructuredLogger> logger_{};
     std::shared_ptr<StatsCollector> stats_{};
+    // session_registry_: 활성 세션 목록 (UDS "sessions", 세션 통계 블록 소유 공유)
+    std::shared_ptr<SessionRegistry> session_registry_{};
+    // user_accounting_: db_user 별 누적 (종료 세션 retire + stats tick 마다 refresh)
+    std::shared_ptr<UserAccounting> user_accounting_{};
+    // query_topk_: fingerprint 별 Top-K (top_queries_capacity == 0 이면 nullptr)
+    std::shared_ptr<QueryTopK> query_topk_{};
     std::shared_ptr<PolicyVersionStore> version_store_{};  // DON-50: 정책 버전 스토어
     std::unique_ptr<UdsServer> uds_server_{};
     std::unique_ptr<HealthCheck> health_check_{};
+    // upstream_set_: 업스트림 백엔드 목록 (주소 해석 공유 + 선택 + 헬스 체크)
+    std::unique_ptr<UpstreamSet> upstream_set_{};
+    // backend_pool_: 인증된 서버 연결 재사용 (backend_pool_enabled 일 때만 생성)
+    std::shared_ptr<BackendPool> backend_pool_{};
+    // relay_budget_: 세션 릴레이 버퍼 메모리 예산 / 사용량 집계 (run() 에서 생성)
+    std::shared_ptr<RelayBudget> relay_budget_{};
+    // admission_: accept 속도 / pending 핸드셰이크 / IP 별 상한 판정 (run() 에서 생성)
+    std::shared_ptr<AdmissionControl> admission_{};
+    // timer_wheel_: 세션 유휴 / 핸드셰이크 제한 시간 (run() 에서 생성, timer_wheel_loop 가 구동)
+    std::shared_ptr<TimerWheel> timer_wheel_{};
 
     std::atomic<std::uint64_t> next_session_id_{1};
+    // sessions_: 워커 스레드 간 공유되므로 반드시 sessions_mutex_ 를 잡고 접근한다.
+    //   락 구간에서는 map 조작과 Session::close()(strand post)만 수행한다.
+    mutable std::mutex sessions_mutex_;
     std::unordered_map<std::uint64_t, std::shared_ptr<Session>> sessions_{};
 
     boost::asio::io_context* io_ctx_{nullptr};
 
+    // 프록시 리스너 (accept_strand_ 에서만 접근, drain() 이 post 로 닫는다)
+    //   listen_fd_    : 인계용 fd 사본 (listen 전 / drain 후 -1)
+    //   inherited_fds_: 기동 시 넘겨받은 리스너 [프록시, Health Check] (accept_loop 이 가져간다)
+    boost::asio::any_io_executor accept_strand_{};
+    std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor_{};
+    std::atomic<int> listen_fd_{-1};
+    std::vector<int> inherited_fds_{};
+
+    // backend_tls_sessions_: backend TLS 세션 재개 캐시 (backend_ssl_ctx_ 보다 먼저 선언 →
+    //   나중에 파괴. ctx 의 new-session 콜백이 이 캐시를 가리킨다)
+    std::unique_ptr<TlsSessionCache> backend_tls_sessions_{};
+
     // SSL/TLS context
     //   optional: SSL이 비활성화된 경우 생성하지 않음
     std::optional<boost::asio::ssl::context> frontend_ssl_ctx_{};
@@ -152,6 +343,28 @@ private:
     //   SSL 설정 오류 시 false 반환 (fail-close: 서버 기동 실패)
     [[nodiscard]] bool init_ssl();
 
+    // init_upstreams: upstream_list / upstream_balance 를 검증하고 upstream_set_ 을 만든다
+    //   설정 오류 시 false 반환 (fail-close: 서버 기동 실패)
+    [[nodiscard]] bool init_upstreams(boost::asio::io_context& io_ctx);
+
+    // inherit_listeners: listener_handoff_from 의 dbgate 에서 리스너를 넘겨받아 검증한다
+    //   (프록시 포트 필수, Health Check 포트는 있으면 사용). 실패 시 false (fail-close: 기동 중단)
+    [[nodiscard]] bool inherit_listeners();
+
+    // handoff_listener_fds: UDS "listener_handoff" 로 넘길 fd [프록시, Health Check]
+    //   (요청 포트가 다르거나 drain 중 / listen 전이면 빈 목록)
+    [[nodiscard]] std::vector<int> handoff_listener_fds(std::uint16_t listen_port) const;
+
+    // pool_sweep_loop: 유휴 타임아웃을 넘긴 풀 연결을 주기적으로 닫는다
+    boost::asio::awaitable<void> pool_sweep_loop();
+
+    // stats_tick_loop: 1초마다 StatsCollector::tick() 으로 윈도우 QPS 표본을 기록하고
+    //   UserAccounting::refresh() 로 사용자별 집계를 갱신한다
+    boost::asio::awaitable<void> stats_tick_loop();
+
+    // timer_wheel_loop: tick 주기마다 TimerWheel::advance() 로 만료된 세션 타이머를 실행한다
+    boost::asio::awaitable<void> timer_wheel_loop();
+
     // accept_loop: TCP Accept 루프 코루틴
     boost::asio::awaitable<void> accept_loop(boost::asio::ip::tcp::endpoint listen_ep);
 };
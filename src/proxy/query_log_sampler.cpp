@@ -0,0 +1,68 @@
+// ---------------------------------------------------------------------------
+// query_log_sampler.cpp
+//
+// QueryLogSampler 구현. 난수는 splitmix64 (세션 로컬 상태, 락 없음).
+// ---------------------------------------------------------------------------
+
+#include "proxy/query_log_sampler.hpp"
+
+#include <algorithm>
+
+QueryLogSampler::QueryLogSampler(std::uint64_t seed) noexcept : rng_state_(seed) {}
+
+bool QueryLogSampler::admit(PolicyAction action,
+                            const QueryLogDirective& directive,
+                            std::chrono::steady_clock::time_point now) noexcept {
+    if (action != PolicyAction::kAllow) {
+        return true;
+    }
+    if (!sample(directive.sample_rate)) {
+        return false;
+    }
+    if (directive.session_rate_limit == 0) {
+        return true;
+    }
+    return take_token(directive, now);
+}
+
+bool QueryLogSampler::sample(double rate) noexcept {
+    if (rate >= 1.0) {
+        return true;
+    }
+    if (!(rate > 0.0)) {
+        return false;
+    }
+    // splitmix64 → [0, 1) 균등 분포 (상위 53비트 사용)
+    rng_state_ += 0x9E3779B97F4A7C15ULL;
+    std::uint64_t z = rng_state_;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    const double u = static_cast<double>(z >> 11) * 0x1.0p-53;
+    return u < rate;
+}
+
+bool QueryLogSampler::take_token(const QueryLogDirective& directive,
+                                 std::chrono::steady_clock::time_point now) noexcept {
+    const double rate = static_cast<double>(directive.session_rate_limit);
+    const double capacity =
+        directive.session_burst > 0 ? static_cast<double>(directive.session_burst) : rate;
+
+    if (!bucket_started_) {
+        // 첫 쿼리에서 가득 찬 bucket 으로 시작한다
+        bucket_started_ = true;
+        tokens_ = capacity;
+    } else if (now > last_refill_) {
+        const std::chrono::duration<double> elapsed = now - last_refill_;
+        tokens_ += elapsed.count() * rate;
+    }
+    last_refill_ = std::max(last_refill_, now);
+    // 정책 리로드로 용량이 줄어든 경우도 여기서 반영된다
+    tokens_ = std::min(tokens_, capacity);
+
+    if (tokens_ < 1.0) {
+        return false;
+    }
+    tokens_ -= 1.0;
+    return true;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// query_log_sampler.hpp
+//
+// 세션별 QueryLog 샘플링 / rate limit 판정.
+//
+// [설계 의도]
+// 허용된 쿼리마다 남기는 QueryLog 는 정책 평가 다음으로 큰 쿼리당 비용이다.
+// PolicyResult::query_log (정책의 global.query_log + AccessRule::log_sample_rate) 에
+// 따라 일부만 기록하고, 세션별 token bucket 으로 한 클라이언트가 감사 싱크를
+// 포화시키지 못하게 한다.
+//
+// [보안 원칙]
+// - kAllow 가 아닌 판정(kBlock, monitor kLog)은 샘플링/rate limit 없이 항상 기록한다.
+// - 차단 로그(BlockLog)는 이 클래스를 거치지 않는다.
+//
+// [스레드 안전성]
+// 세션 코루틴 하나에서만 사용한다 (동기화 없음).
+// ---------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdint>
+
+#include "policy/policy_engine.hpp"  // PolicyAction, QueryLogDirective
+
+class QueryLogSampler {
+public:
+    // seed: 세션 id 등 — 세션마다 다른 샘플링 난수열을 쓰기 위함
+    explicit QueryLogSampler(std::uint64_t seed) noexcept;
+
+    // ---------------------------------------------------------------------------
+    // admit
+    //   이번 쿼리의 QueryLog 를 기록할지 결정한다.
+    //   1. action != kAllow → 항상 true
+    //   2. sample_rate 확률로 통과 (1.0 = 항상, 0.0 = never)
+    //   3. session_rate_limit > 0 이면 token bucket 에서 토큰 1개 소비
+    //      (샘플링에서 제외된 쿼리는 토큰을 소비하지 않는다)
+    // ---------------------------------------------------------------------------
+    [[nodiscard]] bool admit(PolicyAction action,
+                             const QueryLogDirective& directive,
+                             std::chrono::steady_clock::time_point now) noexcept;
+
+private:
+    [[nodiscard]] bool sample(double rate) noexcept;
+    [[nodiscard]] bool take_token(const QueryLogDirective& directive,
+                                  std::chrono::steady_clock::time_point now) noexcept;
+
+    std::uint64_t rng_state_;
+    double tokens_{0.0};
+    bool bucket_started_{false};
+    std::chrono::steady_clock::time_point last_refill_{};
+};
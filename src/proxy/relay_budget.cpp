@@ -0,0 +1,24 @@
+// ---------------------------------------------------------------------------
+// relay_budget.cpp
+// ---------------------------------------------------------------------------
+
+#include "proxy/relay_budget.hpp"
+
+#include <utility>
+
+RelayBudget::RelayBudget(std::size_t session_limit,
+                         std::size_t global_limit,
+                         std::shared_ptr<StatsCollector> stats) noexcept
+    : session_limit_{session_limit}, global_limit_{global_limit}, stats_{std::move(stats)} {}
+
+void RelayBudget::adjust(std::size_t before, std::size_t after) noexcept {
+    std::size_t total = 0;
+    if (after > before) {
+        total = in_use_.fetch_add(after - before, std::memory_order_relaxed) + (after - before);
+    } else {
+        total = in_use_.fetch_sub(before - after, std::memory_order_relaxed) - (before - after);
+    }
+    if (stats_) {
+        stats_->on_relay_buffer_bytes(total);
+    }
+}
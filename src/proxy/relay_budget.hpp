@@ -0,0 +1,99 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// relay_budget.hpp
+//
+// 세션 릴레이 버퍼(server_rx_ / client_buf_) 메모리 예산과 프로세스 전체 사용량 집계.
+//
+// [설계 의도]
+// 릴레이 버퍼는 세션마다 재사용되므로, 큰 쿼리/응답을 한 번 처리한 세션은 그 크기를
+// 유지한 채 유휴 상태로 남을 수 있다. 1만 세션 규모에서는 이 유지분이 호스트 메모리를
+// 결정하므로 두 가지 상한을 둔다.
+//   - session_limit: 세션이 커맨드 사이에 유지하는 버퍼 합계 상한. 넘으면 응답/커맨드가
+//                    끝난 시점에 버퍼를 해제한다 (처리 중 일시적 초과는 허용 — 쿼리는
+//                    판정을 위해 패킷 전체를 받아야 한다).
+//   - global_limit : 전체 세션 버퍼 합계 상한 (0 = 제한 없음). 넘는 동안에는
+//                    1) 세션이 커맨드 사이마다 버퍼를 모두 해제하고
+//                    2) 버퍼를 키워야 하는 서버 읽기를 잠시 멈춘다 (Session::wait_for_relay_budget)
+//
+// [backpressure]
+// 서버 응답 릴레이는 클라이언트 쓰기가 끝난 뒤에만 다음 서버 읽기를 하므로, 세션별 미전송
+// 바이트는 읽기 1회분을 넘지 않는다. 느린 클라이언트는 커널 소켓 버퍼를 통해 서버 읽기를
+// 늦추며, 이 예산은 그 위에서 버퍼 "유지" 메모리를 제한한다.
+//
+// [스레드 안전성]
+// RelayBudget 의 합계는 atomic 이다. Account 는 세션 strand 에서만 갱신한다.
+// ---------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "stats/stats_collector.hpp"
+
+class RelayBudget {
+public:
+    // session_limit: 세션당 유지 버퍼 상한 (바이트), global_limit: 전체 상한 (0 = 제한 없음)
+    // stats: 사용량 게이지 (nullptr 허용)
+    RelayBudget(std::size_t session_limit,
+                std::size_t global_limit,
+                std::shared_ptr<StatsCollector> stats = nullptr) noexcept;
+    ~RelayBudget() = default;
+
+    RelayBudget(const RelayBudget&) = delete;
+    RelayBudget& operator=(const RelayBudget&) = delete;
+    RelayBudget(RelayBudget&&) = delete;
+    RelayBudget& operator=(RelayBudget&&) = delete;
+
+    [[nodiscard]] std::size_t session_limit() const noexcept { return session_limit_; }
+    [[nodiscard]] std::size_t global_limit() const noexcept { return global_limit_; }
+
+    // 전체 세션 릴레이 버퍼 합계 (바이트)
+    [[nodiscard]] std::size_t in_use() const noexcept {
+        return in_use_.load(std::memory_order_relaxed);
+    }
+
+    // 전체 상한을 넘었는지 (global_limit == 0 이면 항상 false)
+    [[nodiscard]] bool over_limit() const noexcept {
+        return global_limit_ != 0 && in_use() > global_limit_;
+    }
+
+    // -----------------------------------------------------------------------
+    // Account
+    //   세션 하나의 버퍼 사용량. update() 로 현재 합계를 알리면 차이만 전체에 반영하고,
+    //   소멸 시 남은 사용량을 돌려준다. budget 이 nullptr 이면 아무것도 하지 않는다.
+    // -----------------------------------------------------------------------
+    class Account {
+    public:
+        Account() = default;
+        explicit Account(RelayBudget* budget) noexcept : budget_{budget} {}
+        ~Account() { update(0); }
+
+        Account(const Account&) = delete;
+        Account& operator=(const Account&) = delete;
+        Account(Account&&) = delete;
+        Account& operator=(Account&&) = delete;
+
+        void update(std::size_t bytes) noexcept {
+            if (budget_ == nullptr || bytes == bytes_) {
+                return;
+            }
+            budget_->adjust(bytes_, bytes);
+            bytes_ = bytes;
+        }
+
+        [[nodiscard]] std::size_t bytes() const noexcept { return bytes_; }
+
+    private:
+        RelayBudget* budget_{nullptr};
+        std::size_t bytes_{0};
+    };
+
+private:
+    void adjust(std::size_t before, std::size_t after) noexcept;
+
+    std::size_t session_limit_;
+    std::size_t global_limit_;
+    std::shared_ptr<StatsCollector> stats_;
+    std::atomic<std::size_t> in_use_{0};
+};
@@ -0,0 +1,80 @@
+// ---------------------------------------------------------------------------
+// response_pipeline.cpp
+//
+// 세션별 in-flight 응답 큐. 생산자/소비자 모두 세션 strand 에서 실행되므로
+// 상태 확인과 대기 사이에 끼어드는 실행이 없다 (깨움 유실 없음).
+// ---------------------------------------------------------------------------
+
+#include "proxy/response_pipeline.hpp"
+
+#include <algorithm>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/error_code.hpp>
+#include <utility>
+
+ResponsePipeline::ResponsePipeline(const boost::asio::any_io_executor& executor,
+                                   std::size_t depth)
+    : depth_{std::min(depth, kMaxDepth)}, producer_signal_{executor}, consumer_signal_{executor} {}
+
+auto ResponsePipeline::wait_on(boost::asio::steady_timer& timer) -> boost::asio::awaitable<void> {
+    boost::system::error_code ec;
+    timer.expires_at(boost::asio::steady_timer::time_point::max());
+    co_await timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+}
+
+auto ResponsePipeline::acquire_slot() -> boost::asio::awaitable<bool> {
+    while (!failed_ && pending_.size() >= depth_) {
+        co_await wait_on(producer_signal_);
+    }
+    co_return !failed_;
+}
+
+void ResponsePipeline::push(PendingResponse response) {
+    pending_.push_back(std::move(response));
+    consumer_signal_.cancel();
+}
+
+auto ResponsePipeline::drain() -> boost::asio::awaitable<bool> {
+    while (!failed_ && !pending_.empty()) {
+        co_await wait_on(producer_signal_);
+    }
+    co_return !failed_;
+}
+
+void ResponsePipeline::stop() {
+    stopped_ = true;
+    consumer_signal_.cancel();
+}
+
+auto ResponsePipeline::wait_consumer_done() -> boost::asio::awaitable<void> {
+    while (!consumer_done_) {
+        co_await wait_on(producer_signal_);
+    }
+}
+
+auto ResponsePipeline::next() -> boost::asio::awaitable<PendingResponse*> {
+    while (!failed_ && pending_.empty() && !stopped_) {
+        co_await wait_on(consumer_signal_);
+    }
+    if (failed_ || pending_.empty()) {
+        co_return nullptr;
+    }
+    co_return &pending_.front();
+}
+
+void ResponsePipeline::complete() {
+    pending_.pop_front();
+    producer_signal_.cancel();
+}
+
+void ResponsePipeline::fail() {
+    failed_ = true;
+    pending_.clear();
+    producer_signal_.cancel();
+}
+
+void ResponsePipeline::finish() {
+    consumer_done_ = true;
+    producer_signal_.cancel();
+}
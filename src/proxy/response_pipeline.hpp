@@ -0,0 +1,119 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// response_pipeline.hpp
+//
+// 세션별 in-flight 응답 큐 (opt-in 파이프라이닝, PIPELINE_DEPTH).
+//
+// [설계 의도]
+// 직렬 모드는 커맨드 1개의 응답 릴레이가 끝나야 다음 클라이언트 패킷을 읽는다.
+// 파이프라이닝 모드에서는 세션 run() 코루틴(생산자)이 다음 커맨드를 읽고·평가하고
+// 서버에 전달하는 동안, 릴레이 코루틴(소비자)이 앞선 커맨드의 응답을 클라이언트에
+// 보낸다. 두 코루틴은 같은 strand 에서 번갈아 실행되며 이 큐로만 통신한다.
+//
+// [순서 보장]
+// 서버는 받은 순서대로 응답한다. 프록시가 직접 만드는 응답(정책 차단 ERR 등)도
+// 같은 큐에 넣어 클라이언트가 보낸 순서 그대로 응답을 받게 한다.
+// 클라이언트 소켓 쓰기는 소비자만, 서버 소켓 쓰기는 생산자만 수행한다.
+//
+// [상한 — backpressure]
+// 서버에 전달했지만 응답이 끝나지 않은 커맨드는 depth 개까지다. 가득 차면 생산자는
+// acquire_slot() 에서 대기하므로 클라이언트 소켓 읽기도 멈춘다.
+//
+// [실패 — fail-close]
+// 소비자가 릴레이에 실패하면 fail() 로 표시하고, 대기 중인 생산자는 false 를 받아
+// 세션을 종료한다. 이후 push 된 응답은 전송되지 않는다.
+//
+// [스레드 안전성]
+// 세션 strand 위에서만 사용한다 (동기화 없음).
+// ---------------------------------------------------------------------------
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "protocol/command.hpp"
+
+// ---------------------------------------------------------------------------
+// PendingResponse
+//   command_type / sequence_id : 서버 응답 릴레이 인자 (relay_server_response)
+//   local_reply                : 비어 있지 않으면 서버 응답 대신 이 바이트를 보낸다
+//                                (정책 차단 ERR 등 서버에 전달하지 않은 커맨드)
+//   forwarded_at               : 서버 전달 시각 (kUpstreamResponse 지연 측정)
+//   query_hash                 : QueryTopK fingerprint 해시 (0 = 집계 안 함, 지연 귀속용)
+// ---------------------------------------------------------------------------
+struct PendingResponse {
+    CommandType command_type{CommandType::kComUnknown};
+    std::uint8_t sequence_id{0};
+    std::vector<std::uint8_t> local_reply{};
+    std::chrono::steady_clock::time_point forwarded_at{};
+    std::uint64_t query_hash{0};
+};
+
+class ResponsePipeline {
+public:
+    // 세션당 in-flight 상한의 최댓값 (설정값은 이 값으로 잘린다)
+    static constexpr std::size_t kMaxDepth = 64;
+
+    // depth == 0 이면 비활성 (직렬 모드)
+    ResponsePipeline(const boost::asio::any_io_executor& executor, std::size_t depth);
+
+    [[nodiscard]] bool enabled() const noexcept { return depth_ > 0; }
+    [[nodiscard]] std::size_t depth() const noexcept { return depth_; }
+    [[nodiscard]] std::size_t size() const noexcept { return pending_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return pending_.empty(); }
+    [[nodiscard]] bool failed() const noexcept { return failed_; }
+
+    // -----------------------------------------------------------------------
+    // 생산자 (세션 run() 코루틴)
+    // -----------------------------------------------------------------------
+
+    // acquire_slot: in-flight 가 depth 미만이 될 때까지 대기. 실패했으면 false.
+    auto acquire_slot() -> boost::asio::awaitable<bool>;
+
+    // push: 응답 1개를 큐 뒤에 넣고 소비자를 깨운다 (acquire_slot 이후 호출)
+    void push(PendingResponse response);
+
+    // drain: 큐가 빌 때까지 대기 (직렬 처리가 필요한 커맨드 앞). 실패했으면 false.
+    auto drain() -> boost::asio::awaitable<bool>;
+
+    // stop: 더 이상 push 하지 않는다. 소비자는 남은 응답을 보낸 뒤 종료한다.
+    void stop();
+
+    // wait_consumer_done: 소비자 코루틴이 finish() 할 때까지 대기
+    auto wait_consumer_done() -> boost::asio::awaitable<void>;
+
+    // -----------------------------------------------------------------------
+    // 소비자 (릴레이 코루틴)
+    // -----------------------------------------------------------------------
+
+    // next: 다음 응답을 기다린다. stop() 후 비었거나 실패했으면 nullptr.
+    //   반환된 항목은 complete() 전까지 큐 맨 앞에 남아 in-flight 로 계산된다.
+    auto next() -> boost::asio::awaitable<PendingResponse*>;
+
+    // complete: 맨 앞 응답 전송 완료 → 꺼내고 생산자를 깨운다
+    void complete();
+
+    // fail: 릴레이 실패. 남은 응답을 버리고 생산자를 깨운다.
+    void fail();
+
+    // finish: 소비자 종료 통지
+    void finish();
+
+private:
+    // timer 를 조건 변수처럼 쓴다: 무기한 대기 후 상대편의 cancel() 로 깨어난다.
+    static auto wait_on(boost::asio::steady_timer& timer) -> boost::asio::awaitable<void>;
+
+    std::size_t depth_;
+    std::deque<PendingResponse> pending_{};
+    boost::asio::steady_timer producer_signal_;
+    boost::asio::steady_timer consumer_signal_;
+    bool stopped_{false};
+    bool failed_{false};
+    bool consumer_done_{false};
+};
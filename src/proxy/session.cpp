@@ -5,21 +5,27 @@
 #include <openssl/x509_vfy.h>
 #include <spdlog/spdlog.h>
 
-#include <array>
+#include <algorithm>
 #include <boost/asio/co_spawn.hpp>
-#include <boost/asio/connect.hpp>
 #include <boost/asio/detached.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/redirect_error.hpp>
 #include <boost/asio/ssl/stream.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/use_awaitable.hpp>
 #include <boost/asio/write.hpp>
 #include <chrono>
 #include <format>
 #include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "parser/injection_detector.hpp"
+#include "parser/query_fingerprint.hpp"
+#include "parser/sql_lexer.hpp"
+
 // ---------------------------------------------------------------------------
 // Session — 구현
 //
@@ -28,30 +34,17 @@
 //   2. stats_.on_connection_open()
 //   3. TCP connect → (backend SSL이면 TLS 핸드셰이크 후 server_stream_ 재생성)
 //   4. HandshakeRelay::relay_handshake()
+//      연결 풀 사용 시: accept_client → 풀 연결 change_user 또는 새 연결 authenticate_fresh
 //   5. state_ = kReady → logger_.log_connection("connect")
 //   6. 커맨드 루프:
-//        헤더 4B + payload 읽기 → MysqlPacket::parse()
+//        세션 버퍼에 헤더 4B + payload 읽기 → MysqlPacketView (복사 없음)
 //        COM_QUIT → break
 //        COM_QUERY → parse → policy → block/allow 분기
 //        기타     → 서버 투명 릴레이
-//   7. state_ = kClosed → stats/logger 정리 → 소켓 close
+//   7. (연결 풀 사용 시) COM_RESET_CONNECTION 후 서버 연결 반납
+//      state_ = kClosed → stats/logger 정리 → 소켓 close
 // ---------------------------------------------------------------------------
 
-// 기본 SQL Injection 패턴 (InjectionDetector 초기화)
-// NOLINTNEXTLINE(cert-err58-cpp)
-static const std::vector<std::string> kDefaultInjectionPatterns = {
-    R"(UNION\s+SELECT)",
-    R"(('\s*OR\s+['"\d]))",
-    R"(SLEEP\s*\()",
-    R"(BENCHMARK\s*\()",
-    R"(LOAD_FILE\s*\()",
-    R"(INTO\s+OUTFILE)",
-    R"(INTO\s+DUMPFILE)",
-    R"(;\s*(DROP|DELETE|UPDATE|INSERT|ALTER|CREATE))",
-    R"(--\s*$)",
-    R"(/\*.*\*/)",
-};
-
 // ---------------------------------------------------------------------------
 // Session 생성자
 // ---------------------------------------------------------------------------
@@ -63,7 +56,18 @@ Session::Session(std::uint64_t session_id,
                  const std::string& backend_tls_server_name,  // NOLINT(modernize-pass-by-value)
                  std::shared_ptr<PolicyEngine> policy,
                  std::shared_ptr<StructuredLogger> logger,
-                 std::shared_ptr<StatsCollector> stats)
+                 std::shared_ptr<StatsCollector> stats,
+                 std::shared_ptr<BackendPool> backend_pool,
+                 std::uint32_t pipeline_depth,
+                 bool backend_ssl_ktls,
+                 TlsSessionCache* backend_tls_sessions,
+                 std::shared_ptr<RelayBudget> relay_budget,
+                 UpstreamLease upstream_lease,
+                 std::shared_ptr<SessionStats> session_stats,
+                 AdmissionTicket admission,
+                 SessionTimeouts timeouts,
+                 SocketTuning upstream_tuning,
+                 std::shared_ptr<QueryTopK> query_topk)
     : session_id_{session_id},
       client_stream_{std::move(client_stream)}
       // server_stream_: 임시 tcp::socket으로 초기화 (run()에서 교체)
@@ -72,31 +76,84 @@ Session::Session(std::uint64_t session_id,
       server_endpoint_{std::move(server_endpoint)},
       backend_ssl_ctx_{backend_ssl_ctx},
       backend_ssl_verify_{backend_ssl_verify},
+      backend_ssl_ktls_{backend_ssl_ktls},
+      backend_tls_sessions_{backend_tls_sessions},
       backend_tls_server_name_{backend_tls_server_name},
       policy_{std::move(policy)},
       logger_{std::move(logger)},
       stats_{std::move(stats)},
+      query_topk_{std::move(query_topk)},
+      backend_pool_{std::move(backend_pool)},
       ctx_{},
       // NOLINTNEXTLINE(cppcoreguidelines-use-default-member-init,modernize-use-default-member-init)
       state_{SessionState::kHandshaking},
       strand_{boost::asio::make_strand(client_stream_.get_executor())},
       sql_parser_{},
-      injection_detector_{kDefaultInjectionPatterns},
       proc_detector_{},
+      log_sampler_{session_id},
+      response_pipeline_{strand_, pipeline_depth},
+      relay_budget_{std::move(relay_budget)},
+      relay_account_{relay_budget_.get()},
+      upstream_lease_{std::move(upstream_lease)},
+      session_stats_{session_stats != nullptr
+                         ? std::move(session_stats)
+                         : std::make_shared<SessionStats>(session_id,
+                                                          std::chrono::system_clock::now())},
+      admission_{std::move(admission)},
+      timeouts_{std::move(timeouts)},
+      upstream_tuning_{upstream_tuning},
       closing_{false} {}
 
 // ---------------------------------------------------------------------------
 // 내부 헬퍼: 패킷 1개 읽기 (4바이트 헤더 + payload)
+//
+//   세션이 소유한 방향별 버퍼(buf)에 직접 읽고, 그 위의 MysqlPacketView 를 반환한다.
+//   버퍼는 패킷마다 새로 할당하지 않고 재사용하며, 릴레이 시에는 읽은 바이트를
+//   그대로 전달하므로 row 패킷 1개당 할당/복사가 발생하지 않는다.
+//
+//   반환된 뷰는 같은 버퍼로 다음 read_one_packet 을 호출하기 전까지만 유효하다.
 // ---------------------------------------------------------------------------
 namespace {
 
-auto read_one_packet(AsyncStream& stream)
-    -> boost::asio::awaitable<std::expected<MysqlPacket, ParseError>> {
-    std::array<std::uint8_t, 4> header{};
+// 큰 패킷(최대 16MB)을 한 번 받은 뒤 세션 수명 내내 메모리를 점유하지 않도록,
+// 이 크기를 넘게 자란 버퍼는 작은 패킷을 읽을 때 새 버퍼로 교체한다.
+constexpr std::size_t kRelayBufferInitial = 16U * 1024U;
+constexpr std::size_t kRelayBufferRetainMax = 1024U * 1024U;
+
+// 서버 응답 스트리밍 시 1회 async_read_some 에 내어주는 최소 빈 공간
+constexpr std::size_t kServerReadChunk = PacketFrameBuffer::kDefaultCapacity;
+
+// 이만큼 넘게 모자란 응답 패킷은 버퍼에 모으지 않고 흘려보낸다 (stream_server_packet)
+constexpr std::size_t kStreamThreshold = kServerReadChunk;
+
+// 전체 릴레이 버퍼 상한 초과 시 서버 읽기 대기 (확인 주기 / 최대 대기)
+//   다른 세션이 버퍼를 돌려줄 시간을 주되, 상한이 계속 넘는 동안 세션이 멈추지 않도록
+//   최대 대기 후에는 읽기를 진행한다 (이미 할당된 버퍼로 읽는 경우는 대기하지 않음).
+constexpr auto kRelayBudgetPoll = std::chrono::milliseconds{5};
+constexpr auto kRelayBudgetMaxWait = std::chrono::milliseconds{500};
+
+// 릴레이 상태 머신이 보는 payload 앞부분 크기 (COM_STMT_PREPARE_OK 12바이트 포함)
+constexpr std::size_t kFrameHeadBytes = 16;
+
+// data_protection.max_result_rows 초과 시 클라이언트에 보내는 ERR (ER_TOO_BIG_SELECT)
+constexpr std::uint16_t kResultRowLimitErrorCode = 1104;
+constexpr std::string_view kResultRowLimitMessage =
+    "Result set exceeds the maximum number of rows allowed by policy";
+
+// EOF / OK status_flags 의 SERVER_MORE_RESULTS_EXISTS (CALL, 멀티 스테이트먼트)
+//   릴레이는 이 플래그를 따라 다음 결과를 이어 받고, 잘라낸 결과 셋 뒤에는 더 보내지 않는다.
+constexpr std::uint16_t kServerMoreResultsExists = 0x0008;
+
+auto read_one_packet(AsyncStream& stream, std::vector<std::uint8_t>& buf)
+    -> boost::asio::awaitable<std::expected<MysqlPacketView, ParseError>> {
+    if (buf.size() < 4) {
+        buf.resize(kRelayBufferInitial);
+    }
+
     boost::system::error_code ec;
 
     co_await boost::asio::async_read(stream,
-                                     boost::asio::buffer(header),
+                                     boost::asio::buffer(buf.data(), 4),
                                      boost::asio::redirect_error(boost::asio::use_awaitable, ec));
 
     if (ec) {
@@ -105,15 +162,18 @@ auto read_one_packet(AsyncStream& stream)
                                              .context = ec.message()});
     }
 
-    const std::uint32_t payload_len = static_cast<std::uint32_t>(header[0]) |
-                                      (static_cast<std::uint32_t>(header[1]) << 8U) |
-                                      (static_cast<std::uint32_t>(header[2]) << 16U);
-
-    std::vector<std::uint8_t> buf(4 + payload_len);
-    buf[0] = header[0];
-    buf[1] = header[1];
-    buf[2] = header[2];
-    buf[3] = header[3];
+    const std::uint32_t payload_len = static_cast<std::uint32_t>(buf[0]) |
+                                      (static_cast<std::uint32_t>(buf[1]) << 8U) |
+                                      (static_cast<std::uint32_t>(buf[2]) << 16U);
+    const std::size_t total = static_cast<std::size_t>(4) + payload_len;
+
+    if (total > buf.size()) {
+        buf.resize(total);  // 헤더 4바이트는 resize 후에도 보존된다
+    } else if (buf.size() > kRelayBufferRetainMax && total <= kRelayBufferInitial) {
+        std::vector<std::uint8_t> shrunk(kRelayBufferInitial);
+        std::copy_n(buf.begin(), 4, shrunk.begin());
+        buf.swap(shrunk);
+    }
 
     if (payload_len > 0) {
         co_await boost::asio::async_read(
@@ -127,16 +187,18 @@ auto read_one_packet(AsyncStream& stream)
         }
     }
 
-    co_return MysqlPacket::parse(std::span<const std::uint8_t>{buf});
+    co_return MysqlPacketView::parse(std::span<const std::uint8_t>{buf.data(), total});
 }
 
-auto write_packet_raw(AsyncStream& stream, const MysqlPacket& pkt)
+// 원본 와이어 바이트(헤더 포함)를 그대로 전송한다. serialize() 복사 없음.
+//   Stream: AsyncStream 또는 응답 릴레이에서 특화된 구체 스트림 타입
+template <typename Stream>
+auto write_packet_raw(Stream& stream, std::span<const std::uint8_t> bytes)
     -> boost::asio::awaitable<std::expected<void, ParseError>> {
-    const auto bytes = pkt.serialize();
     boost::system::error_code ec;
 
     co_await boost::asio::async_write(stream,
-                                      boost::asio::buffer(bytes),
+                                      boost::asio::buffer(bytes.data(), bytes.size()),
                                       boost::asio::redirect_error(boost::asio::use_awaitable, ec));
 
     if (ec) {
@@ -219,9 +281,10 @@ auto consume_lenenc_text_cell(std::span<const std::uint8_t> payload, std::size_t
     return true;
 }
 
-auto is_text_row_packet(std::span<const std::uint8_t> payload, std::uint8_t column_count) -> bool {
+auto is_text_row_packet(std::span<const std::uint8_t> payload, std::uint64_t column_count)
+    -> bool {
     std::size_t offset = 0;
-    for (std::uint8_t i = 0; i < column_count; ++i) {
+    for (std::uint64_t i = 0; i < column_count; ++i) {
         if (!consume_lenenc_text_cell(payload, offset)) {
             return false;
         }
@@ -252,289 +315,1013 @@ auto is_metadata_terminator_packet(std::span<const std::uint8_t> payload) -> boo
            is_resultset_final_ok_packet(payload);
 }
 
-auto relay_stmt_prepare_section(AsyncStream& server_stream,
-                                AsyncStream& client_stream,
-                                std::uint16_t count,
-                                std::uint64_t session_id)
-    -> boost::asio::awaitable<std::expected<void, ParseError>> {
-    for (std::uint16_t i = 0; i < count; ++i) {
-        auto def_pkt_result = co_await read_one_packet(server_stream);
-        if (!def_pkt_result) {
-            co_return std::unexpected(def_pkt_result.error());
-        }
-
-        auto wr = co_await write_packet_raw(client_stream, *def_pkt_result);
-        if (!wr) {
-            co_return std::unexpected(wr.error());
-        }
+// 결과 셋 row 구간을 끝내는 패킷인지 (EOF / ERR, 또는 COM_QUERY 의 final OK)
+//   흘려보낸 큰 row 는 payload 전체가 없으므로 final OK 가 아니다.
+auto is_rows_terminator(const FrameHead& pkt,
+                        CommandType request_type,
+                        std::uint64_t column_count) -> bool {
+    if (pkt.prefix.empty()) {
+        return false;
     }
+    const std::uint8_t byte0 = pkt.prefix[0];
+    const bool eof_or_err = (byte0 == 0xFE && pkt.payload_length < 9) || byte0 == 0xFF;
+    const bool final_ok = request_type == CommandType::kComQuery && byte0 == 0x00 &&
+                          pkt.complete() && !is_text_row_packet(pkt.prefix, column_count) &&
+                          is_resultset_final_ok_packet(pkt.prefix);
+    return eof_or_err || final_ok;
+}
 
-    auto term_pkt_result = co_await read_one_packet(server_stream);
-    if (!term_pkt_result) {
-        co_return std::unexpected(term_pkt_result.error());
+// 끝 패킷(EOF / OK)의 status_flags (payload 가 짧으면 0)
+//   EOF: [0xFE][warnings 2][status 2]
+//   OK : [0x00][affected_rows lenenc][last_insert_id lenenc][status 2]...
+auto terminator_status_flags(std::span<const std::uint8_t> payload) -> std::uint16_t {
+    if (payload.empty()) {
+        return 0;
     }
-
-    auto wr = co_await write_packet_raw(client_stream, *term_pkt_result);
-    if (!wr) {
-        co_return std::unexpected(wr.error());
+    std::size_t offset = 3;
+    if (payload[0] == 0x00) {
+        offset = 1;
+        std::uint64_t ignored = 0;
+        if (!parse_lenenc_integer(payload, offset, ignored) ||
+            !parse_lenenc_integer(payload, offset, ignored)) {
+            return 0;
+        }
+    } else if (payload[0] != 0xFE) {
+        return 0;
     }
-
-    const auto payload = term_pkt_result->payload();
-    if (!is_metadata_terminator_packet(payload)) {
-        spdlog::warn("[session {}] unexpected COM_STMT_PREPARE terminator: 0x{:02x} (len={})",
-                     session_id,
-                     payload.empty() ? 0U : static_cast<unsigned>(payload[0]),
-                     payload.size());
+    if (offset + 2 > payload.size()) {
+        return 0;
     }
+    return static_cast<std::uint16_t>(payload[offset] |
+                                      (static_cast<unsigned>(payload[offset + 1]) << 8U));
+}
 
-    co_return std::expected<void, ParseError>{};
+auto has_more_results(std::span<const std::uint8_t> payload) -> bool {
+    return (terminator_status_flags(payload) & kServerMoreResultsExists) != 0;
 }
 
 }  // namespace
 
 // ---------------------------------------------------------------------------
-// relay_server_response
-//   MySQL 서버 응답(OK / ERR / Result Set)이 완료될 때까지 읽어 클라이언트에 릴레이.
+// next_server_packet / flush_server_pending
+//   서버 응답 스트리밍 릴레이의 수신/전달 단위.
+//
+//   next_server_packet() 은 server_rx_ 에 이미 쌓인 패킷을 우선 반환하고,
+//   완전한 패킷이 없을 때만 소켓에서 읽는다. 반환한 패킷은 "전달 대기"(pending)로
+//   표시될 뿐 즉시 쓰지 않는다. 읽기 위해 대기해야 하는 시점에 pending 구간 전체를
+//   한 번의 async_write 로 클라이언트에 보내므로, 소켓에 이미 도착한 row 들은
+//   syscall 1회 (TLS 는 레코드 수 최소화) 로 묶여 전달된다.
+//
+//   아직 kStreamThreshold 넘게 모자란 큰 패킷은 헤더와 앞 kFrameHeadBytes 만 보고
+//   stream_server_packet() 으로 본문을 바로 흘려보낸다 (버퍼 성장/복사 없음).
+//
+//   반환된 FrameHead 는 다음 next_server_packet() 호출 전까지만 유효하다.
 // ---------------------------------------------------------------------------
-auto Session::relay_server_response(CommandType request_type,
-                                    [[maybe_unused]] std::uint8_t request_seq_id)
-    -> boost::asio::awaitable<std::expected<void, ParseError>> {
-    enum class ResponseState {  // NOLINT(performance-enum-size)
-        kFirst,                 // 첫 패킷 분석 중
-        kColumnDefs,            // column definition 읽는 중
-        kRows,                  // row 데이터 읽는 중
-        kDone,                  // 응답 완료
-    };
-
-    // 첫 패킷으로 응답 유형 판별
-    auto first_pkt_result = co_await read_one_packet(server_stream_);
-    if (!first_pkt_result) {
-        co_return std::unexpected(first_pkt_result.error());
+auto Session::take_buffered_server_packet() noexcept -> std::optional<FrameHead> {
+    const auto view = server_rx_.peek(server_pending_);
+    if (!view) {
+        return std::nullopt;
     }
+    server_pending_ += view->raw().size();
+    return FrameHead{.payload_length = view->payload_length(),
+                     .sequence_id = view->sequence_id(),
+                     .prefix = view->payload()};
+}
+
+template <typename Streams>
+auto Session::next_server_packet(Streams streams)
+    -> boost::asio::awaitable<std::expected<FrameHead, ParseError>> {
+    while (true) {
+        if (const auto buffered = take_buffered_server_packet()) {
+            co_return *buffered;
+        }
+
+        if (server_rx_.missing(server_pending_) > kStreamThreshold) {
+            if (const auto head = server_rx_.peek_head(server_pending_, kFrameHeadBytes)) {
+                co_return co_await stream_server_packet(streams, *head);
+            }
+        }
+
+        // 더 읽어야 한다 — 대기 전에 지금까지 걸어온 완전한 패킷들을 먼저 전달
+        auto flushed = co_await flush_server_pending(streams);
+        if (!flushed) {
+            co_return std::unexpected(flushed.error());
+        }
+
+        // 전체 릴레이 버퍼 상한을 넘은 동안에는 버퍼를 키워야 하는 읽기를 잠시 멈춘다
+        if (relay_budget_ != nullptr && relay_budget_->over_limit() &&
+            server_rx_.would_grow(kServerReadChunk)) {
+            co_await wait_for_relay_budget();
+        }
+
+        // 큰 패킷도 앞부분만 있으면 흘려보내므로 버퍼를 패킷 크기만큼 키우지 않는다
+        const bool header_incomplete = server_rx_.readable().size() < 4;
+        auto space = server_rx_.prepare(kServerReadChunk);
+        sync_relay_memory();
+
+        boost::system::error_code ec;
+        const std::size_t n = co_await streams.server.async_read_some(
+            boost::asio::buffer(space.data(), space.size()),
+            boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        server_rx_.commit(n);
+        session_stats_->add_bytes_out(n);
 
-    const MysqlPacket& first_pkt = *first_pkt_result;
-    const auto first_payload = first_pkt.payload();
+        if (ec) {
+            co_return std::unexpected(ParseError{
+                .code = ParseErrorCode::kMalformedPacket,
+                .message = header_incomplete ? "failed to read packet header"
+                                             : "failed to read packet payload",
+                .context = ec.message()});
+        }
+    }
+}
 
-    // 첫 패킷을 클라이언트에 전달
-    auto wr = co_await write_packet_raw(client_stream_, first_pkt);
+// ---------------------------------------------------------------------------
+// stream_server_packet
+//   server_rx_ 의 server_pending_ 위치에 있는 미완성 큰 패킷을 통째로 전달한다.
+//   1. 앞부분을 streamed_head_ 에 복사 (이후 버퍼를 비우므로)
+//   2. 앞선 pending 패킷들 + 이 패킷의 수신분을 전달하고 버퍼를 비운다
+//   3. 나머지 본문: 서버 수신·클라이언트 송신이 모두 소켓 직접 경로(평문 또는 kTLS)면
+//      splice(2), 아니면 청크 단위 read/write
+//   버퍼에는 이 패킷 이후의 바이트가 절대 들어오지 않도록 남은 길이까지만 읽는다.
+// ---------------------------------------------------------------------------
+template <typename Streams>
+auto Session::stream_server_packet(Streams streams, FrameHead head)
+    -> boost::asio::awaitable<std::expected<FrameHead, ParseError>> {
+    const std::size_t prefix_len = std::min(head.prefix.size(), streamed_head_.size());
+    std::copy_n(head.prefix.begin(), prefix_len, streamed_head_.begin());
+    const FrameHead streamed{.payload_length = head.payload_length,
+                             .sequence_id = head.sequence_id,
+                             .prefix = std::span<const std::uint8_t>{streamed_head_}.first(
+                                 prefix_len)};
+
+    // pending 구간과 이 패킷의 수신분은 연속이므로 한 번에 보낸다
+    const std::size_t buffered = server_rx_.readable().size();
+    std::size_t remaining = server_pending_ + 4 + head.payload_length - buffered;
+    auto wr = co_await write_packet_raw(streams.client, server_rx_.readable());
+    server_rx_.consume(buffered);
+    server_pending_ = 0;
     if (!wr) {
         co_return std::unexpected(wr.error());
     }
 
-    if (first_payload.empty()) {
-        co_return std::expected<void, ParseError>{};
+    if (server_stream_.kernel_recv() && client_stream_.kernel_send() && splice_pipe_.open()) {
+        auto spliced = co_await splice_bytes(
+            server_stream_.lowest_layer(), client_stream_.lowest_layer(), splice_pipe_, remaining);
+        if (!spliced) {
+            co_return std::unexpected(spliced.error());
+        }
+        session_stats_->add_bytes_out(remaining);
+        co_return streamed;
     }
 
-    const std::uint8_t first_byte = first_payload[0];
+    while (remaining > 0) {
+        auto space = server_rx_.prepare(std::min(remaining, kServerReadChunk));
+        sync_relay_memory();
+        boost::system::error_code ec;
+        const std::size_t n = co_await streams.server.async_read_some(
+            boost::asio::buffer(space.data(), std::min(space.size(), remaining)),
+            boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        server_rx_.commit(n);
+        session_stats_->add_bytes_out(n);
+        if (ec) {
+            co_return std::unexpected(ParseError{.code = ParseErrorCode::kMalformedPacket,
+                                                 .message = "failed to read packet payload",
+                                                 .context = ec.message()});
+        }
 
-    // ERR 패킷 (0xFF) → 즉시 완료
-    if (first_byte == 0xFF) {
-        co_return std::expected<void, ParseError>{};
+        auto chunk = co_await write_packet_raw(streams.client, server_rx_.readable());
+        server_rx_.consume(n);
+        if (!chunk) {
+            co_return std::unexpected(chunk.error());
+        }
+        remaining -= n;
     }
+    co_return streamed;
+}
 
-    // OK 패킷 (0x00)
-    if (first_byte == 0x00) {
-        if (request_type == CommandType::kComStmtPrepare) {
-            if (first_payload.size() < 12) {
-                spdlog::warn("[session {}] short COM_STMT_PREPARE OK payload: {} bytes",
-                             session_id_,
-                             first_payload.size());
-                co_return std::expected<void, ParseError>{};
-            }
+template <typename Streams>
+auto Session::flush_server_pending(Streams streams)
+    -> boost::asio::awaitable<std::expected<void, ParseError>> {
+    if (server_pending_ == 0) {
+        co_return std::expected<void, ParseError>{};
+    }
 
-            const std::uint16_t num_columns = static_cast<std::uint16_t>(first_payload[5]) |
-                                              (static_cast<std::uint16_t>(first_payload[6]) << 8U);
-            const std::uint16_t num_params = static_cast<std::uint16_t>(first_payload[7]) |
-                                             (static_cast<std::uint16_t>(first_payload[8]) << 8U);
+    // write_packet_raw 를 거치지 않고 직접 쓴다 (flush 마다 중첩 코루틴 프레임 1개 절약)
+    const auto bytes = server_rx_.readable().first(server_pending_);
+    boost::system::error_code ec;
+    co_await boost::asio::async_write(streams.client,
+                                      boost::asio::buffer(bytes.data(), bytes.size()),
+                                      boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    server_rx_.consume(server_pending_);
+    server_pending_ = 0;
+    if (ec) {
+        co_return std::unexpected(ParseError{.code = ParseErrorCode::kInternalError,
+                                             .message = "failed to write packet",
+                                             .context = ec.message()});
+    }
+    co_return std::expected<void, ParseError>{};
+}
 
-            if (num_params > 0) {
-                auto params_result = co_await relay_stmt_prepare_section(
-                    server_stream_, client_stream_, num_params, session_id_);
-                if (!params_result) {
-                    co_return std::unexpected(params_result.error());
-                }
+// ---------------------------------------------------------------------------
+// peek_server_packet
+//   server_pending_ 위치의 다음 패킷을 전달 대기열에 넣지 않고 들여다본다.
+//   작은 패킷은 완전히 수신될 때까지 기다리고, kStreamThreshold 넘게 모자란 큰 패킷은
+//   앞 kFrameHeadBytes 만 있으면 반환한다 (큰 패킷은 EOF/ERR/OK 가 아니므로 판정에 충분).
+//   수신을 기다려야 하면 앞선 pending 패킷들을 먼저 전달한다.
+// ---------------------------------------------------------------------------
+template <typename Streams>
+auto Session::peek_server_packet(Streams streams)
+    -> boost::asio::awaitable<std::expected<FrameHead, ParseError>> {
+    while (true) {
+        if (const auto view = server_rx_.peek(server_pending_)) {
+            co_return FrameHead{.payload_length = view->payload_length(),
+                                .sequence_id = view->sequence_id(),
+                                .prefix = view->payload()};
+        }
+        if (server_rx_.missing(server_pending_) > kStreamThreshold) {
+            if (const auto head = server_rx_.peek_head(server_pending_, kFrameHeadBytes)) {
+                co_return *head;
             }
+        }
 
-            if (num_columns > 0) {
-                auto columns_result = co_await relay_stmt_prepare_section(
-                    server_stream_, client_stream_, num_columns, session_id_);
-                if (!columns_result) {
-                    co_return std::unexpected(columns_result.error());
-                }
-            }
+        auto flushed = co_await flush_server_pending(streams);
+        if (!flushed) {
+            co_return std::unexpected(flushed.error());
+        }
+        auto received = co_await read_server_chunk(streams, kServerReadChunk);
+        if (!received) {
+            co_return std::unexpected(received.error());
         }
-        co_return std::expected<void, ParseError>{};
     }
+}
 
-    // EOF 패킷 (0xFE, payload.size() < 9) → 즉시 완료 (비정상)
-    if (first_byte == 0xFE && first_payload.size() < 9) {
-        co_return std::expected<void, ParseError>{};
+// ---------------------------------------------------------------------------
+// read_server_chunk
+//   서버에서 최대 max_bytes 를 server_rx_ 로 1회 수신한다 (수신 바이트 수 반환).
+// ---------------------------------------------------------------------------
+template <typename Streams>
+auto Session::read_server_chunk(Streams streams, std::size_t max_bytes)
+    -> boost::asio::awaitable<std::expected<std::size_t, ParseError>> {
+    const bool header_incomplete = server_rx_.readable().size() < 4;
+    auto space = server_rx_.prepare(max_bytes);
+    sync_relay_memory();
+
+    boost::system::error_code ec;
+    const std::size_t n = co_await streams.server.async_read_some(
+        boost::asio::buffer(space.data(), std::min(space.size(), max_bytes)),
+        boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    server_rx_.commit(n);
+    session_stats_->add_bytes_out(n);
+
+    if (ec) {
+        co_return std::unexpected(
+            ParseError{.code = ParseErrorCode::kMalformedPacket,
+                       .message = header_incomplete ? "failed to read packet header"
+                                                    : "failed to read packet payload",
+                       .context = ec.message()});
     }
+    co_return n;
+}
 
-    // LOCAL_INFILE 요청 (0xFB)
-    if (first_byte == 0xFB) {
-        spdlog::warn("[session {}] unsupported LOCAL_INFILE response (0xFB) from server",
-                     session_id_);
-        co_return std::unexpected(ParseError{.code = ParseErrorCode::kUnsupportedCommand,
-                                             .message = "LOCAL_INFILE response is not supported",
-                                             .context = "server response first byte = 0xFB"});
+// ---------------------------------------------------------------------------
+// end_result_set_at_limit
+//   결과 셋이 max_result_rows 를 넘었을 때 (seq 는 첫 초과 row 의 sequence_id).
+//   1. 한도까지 판정된 row 들을 전달한다
+//   2. 클라이언트에 ERR (기본) 또는 EOF (truncate) 로 결과 셋을 끝낸다
+//      EOF status 는 column-def 뒤 EOF 의 값에서 SERVER_MORE_RESULTS_EXISTS 를 뺀 것
+//   3. 서버의 나머지 응답은 끝까지 읽어 버린다 (클라이언트 쓰기 없음, discard_remaining_results)
+//   응답 경계를 끝까지 따라가지 못하면 오류를 반환하며, 세션과 함께 서버 연결을 닫는다
+//   (풀에 반납하지 않음).
+// ---------------------------------------------------------------------------
+template <typename Streams>
+auto Session::end_result_set_at_limit(Streams streams,
+                                      PolicyEngine::ResultRowLimit limit,
+                                      std::uint8_t seq,
+                                      std::uint16_t metadata_status,
+                                      CommandType request_type,
+                                      std::uint8_t column_count)
+    -> boost::asio::awaitable<std::expected<void, ParseError>> {
+    auto flushed = co_await flush_server_pending(streams);
+    if (!flushed) {
+        co_return std::unexpected(flushed.error());
     }
 
-    // Result Set: 첫 바이트가 column count (0x01~0xFC)
-    if (first_byte < 0x01 || first_byte > 0xFC) {
-        spdlog::warn(
-            "[session {}] unexpected first byte in response: 0x{:02x}", session_id_, first_byte);
-        co_return std::expected<void, ParseError>{};
+    const auto reply =
+        limit.truncate
+            ? MysqlPacket::make_eof(
+                  0, static_cast<std::uint16_t>(metadata_status & ~kServerMoreResultsExists), seq)
+            : MysqlPacket::make_error(kResultRowLimitErrorCode, kResultRowLimitMessage, seq);
+    const auto reply_bytes = reply.serialize();
+    auto written = co_await write_packet_raw(streams.client, reply_bytes);
+    if (!written) {
+        co_return std::unexpected(written.error());
     }
+    stats_->on_result_rows_limited();
 
-    const std::uint8_t column_count = first_byte;
-    std::uint8_t column_defs_read = 0;
-    ResponseState state = ResponseState::kColumnDefs;
-    std::uint8_t prev_seq_id = first_pkt.sequence_id();
+    auto discarded = co_await discard_remaining_results(streams, request_type, column_count);
+    if (!discarded) {
+        co_return std::unexpected(discarded.error());
+    }
+    spdlog::warn(
+        "[session {}] result set exceeded max_result_rows={} ({}), {} more rows discarded",
+        session_id_,
+        limit.max_rows,
+        limit.truncate ? "truncated" : "error",
+        *discarded);
+    co_return std::expected<void, ParseError>{};
+}
 
-    while (state != ResponseState::kDone) {
-        auto pkt_result = co_await read_one_packet(server_stream_);
-        if (!pkt_result) {
-            co_return std::unexpected(pkt_result.error());
-        }
+// ---------------------------------------------------------------------------
+// discard_remaining_results
+//   server_rx_ 앞쪽부터 응답의 끝까지 읽어 버린다 (server_pending_ == 0 전제).
+//   잘라낸 결과 셋의 terminator 에 SERVER_MORE_RESULTS_EXISTS 가 있으면 (CALL 등) 뒤따르는
+//   결과 셋 / OK 도 이 플래그가 없는 끝 패킷 (또는 ERR) 이 올 때까지 모두 버린다.
+//   큰 row 는 버퍼에 모으지 않고 남은 길이만큼 청크 단위로 읽어 버리며,
+//   끝 패킷 뒤에 이미 수신된 바이트 (파이프라이닝의 다음 응답) 는 그대로 남긴다.
+//   다음 결과의 첫 패킷을 해석할 수 없으면 (LOCAL_INFILE 등) 응답 경계를 잃었으므로
+//   오류를 반환한다 (서버 연결은 닫히고 풀에 반납되지 않는다).
+//   반환: 버린 row 수 (모든 결과 셋 합계, terminator / column-def 제외)
+// ---------------------------------------------------------------------------
+template <typename Streams>
+auto Session::discard_remaining_results(Streams streams,
+                                        CommandType request_type,
+                                        std::uint8_t column_count)
+    -> boost::asio::awaitable<std::expected<std::uint64_t, ParseError>> {
+    enum class DiscardState {  // NOLINT(performance-enum-size)
+        kRows,                 // row 구간 (terminator 까지)
+        kNextResult,           // SERVER_MORE_RESULTS_EXISTS 뒤 다음 결과의 첫 패킷
+        kColumnDefs,           // 다음 결과 셋의 column definition (EOF 까지)
+    };
 
-        const MysqlPacket& pkt = *pkt_result;
-        const auto payload = pkt.payload();
+    const auto lost_boundary = [this](std::uint8_t byte0) {
+        spdlog::warn("[session {}] unexpected packet 0x{:02x} while discarding results over "
+                     "max_result_rows, closing server connection",
+                     session_id_,
+                     byte0);
+        return std::unexpected(
+            ParseError{.code = ParseErrorCode::kMalformedPacket,
+                       .message = "lost response boundary while discarding result rows",
+                       .context = std::format("first byte = 0x{:02x}", byte0)});
+    };
 
-        auto w = co_await write_packet_raw(client_stream_, pkt);
-        if (!w) {
-            co_return std::unexpected(w.error());
+    DiscardState state = DiscardState::kRows;
+    std::uint64_t columns = column_count;
+    std::uint64_t discarded = 0;
+    std::size_t skip = 0;  // 버리는 중인 큰 패킷의 남은 바이트
+    while (true) {
+        if (skip == 0) {
+            if (const auto view = server_rx_.peek(0)) {
+                const FrameHead head{.payload_length = view->payload_length(),
+                                     .sequence_id = view->sequence_id(),
+                                     .prefix = view->payload()};
+                const std::uint8_t byte0 = head.prefix.empty() ? 0 : head.prefix[0];
+                const bool eof = byte0 == 0xFE && head.payload_length < 9;
+                bool end = false;
+                switch (state) {
+                    case DiscardState::kRows:
+                        if (is_rows_terminator(head, request_type, columns)) {
+                            end = byte0 == 0xFF || !has_more_results(head.prefix);
+                            state = DiscardState::kNextResult;
+                        } else {
+                            ++discarded;
+                        }
+                        break;
+                    case DiscardState::kNextResult:
+                        if (byte0 == 0xFF || eof) {
+                            end = true;
+                        } else if (!head.prefix.empty() && byte0 == 0x00) {
+                            end = !has_more_results(head.prefix);
+                        } else if (byte0 >= 0x01 && byte0 <= 0xFC) {
+                            // column count 는 lenenc 다 (0xFC = 251 개 이상, 뒤 2바이트)
+                            std::size_t offset = 0;
+                            if (!parse_lenenc_integer(head.prefix, offset, columns) ||
+                                columns == 0) {
+                                co_return lost_boundary(byte0);
+                            }
+                            state = DiscardState::kColumnDefs;
+                        } else {
+                            co_return lost_boundary(byte0);
+                        }
+                        break;
+                    case DiscardState::kColumnDefs:
+                        if (byte0 == 0xFF) {
+                            end = true;
+                        } else if (eof) {
+                            state = DiscardState::kRows;
+                        }
+                        break;
+                }
+                server_rx_.consume(view->raw().size());
+                if (end) {
+                    co_return discarded;
+                }
+                continue;
+            }
+            if (server_rx_.readable().size() >= 4 && server_rx_.missing(0) > kStreamThreshold) {
+                // 큰 패킷은 row 또는 column definition 이다 (끝 패킷 / column count 는 작다)
+                if (state == DiscardState::kNextResult) {
+                    co_return lost_boundary(server_rx_.readable()[4]);
+                }
+                if (state == DiscardState::kRows) {
+                    ++discarded;
+                }
+                skip = server_rx_.missing(0);
+                server_rx_.consume(server_rx_.readable().size());
+            }
         }
 
-        if (payload.empty()) {
-            break;
+        auto received =
+            co_await read_server_chunk(streams, skip != 0 ? std::min(skip, kServerReadChunk)
+                                                          : kServerReadChunk);
+        if (!received) {
+            co_return std::unexpected(received.error());
+        }
+        if (skip != 0) {
+            server_rx_.consume(*received);
+            skip -= *received;
         }
+    }
+}
 
-        const std::uint8_t byte0 = payload[0];
+// ---------------------------------------------------------------------------
+// 릴레이 버퍼 메모리 예산 (RelayBudget)
+// ---------------------------------------------------------------------------
+void Session::sync_relay_memory() noexcept {
+    relay_account_.update(server_rx_.capacity() + client_buf_.capacity());
+}
 
-        if (byte0 == 0xFF) {
-            state = ResponseState::kDone;
-            continue;
+void Session::set_state(SessionState state) noexcept {
+    state_ = state;
+    session_stats_->set_state(state);
+}
+
+void Session::record_query(bool blocked) noexcept {
+    stats_->on_query(blocked);
+    session_stats_->on_query(blocked, std::chrono::system_clock::now());
+}
+
+std::uint64_t Session::record_top_query(std::string_view fingerprint, bool blocked) {
+    if (!query_topk_) {
+        return 0;
+    }
+    if (fingerprint.empty()) {
+        query_topk_->record_untracked();
+        return 0;
+    }
+    const std::uint64_t hash = QueryTopK::hash_fingerprint(fingerprint);
+    query_topk_->record(hash, fingerprint, blocked);
+    return hash;
+}
+
+bool Session::relay_over_budget() const noexcept {
+    return relay_budget_ != nullptr &&
+           (relay_account_.bytes() > relay_budget_->session_limit() || relay_budget_->over_limit());
+}
+
+void Session::trim_client_buffer() noexcept {
+    if (!relay_over_budget()) {
+        return;
+    }
+    const std::size_t keep = relay_budget_->over_limit() ? 0 : kRelayBufferInitial;
+    if (client_buf_.capacity() > keep) {
+        std::vector<std::uint8_t>{}.swap(client_buf_);  // read_one_packet 이 다시 할당
+        sync_relay_memory();
+    }
+}
+
+void Session::trim_server_buffer() noexcept {
+    if (!relay_over_budget()) {
+        return;
+    }
+    server_rx_.release(relay_budget_->over_limit() ? 0 : PacketFrameBuffer::kDefaultCapacity);
+    sync_relay_memory();
+}
+
+auto Session::wait_for_relay_budget() -> boost::asio::awaitable<void> {
+    stats_->on_relay_budget_wait();
+    boost::asio::steady_timer timer{strand_};
+    for (auto waited = std::chrono::milliseconds{0};
+         relay_budget_->over_limit() && waited < kRelayBudgetMaxWait;
+         waited += kRelayBudgetPoll) {
+        timer.expires_after(kRelayBudgetPoll);
+        boost::system::error_code ec;
+        co_await timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        if (ec) {
+            co_return;
         }
+    }
+}
 
-        if (pkt.sequence_id() < prev_seq_id && prev_seq_id != 0xFF) {
-            spdlog::warn("[session {}] seq_id reversed ({} -> {}), stopping relay",
-                         session_id_,
-                         prev_seq_id,
-                         pkt.sequence_id());
-            state = ResponseState::kDone;
+template <typename Streams>
+auto Session::relay_stmt_prepare_section(Streams streams, std::uint16_t count)
+    -> boost::asio::awaitable<std::expected<void, ParseError>> {
+    for (std::uint16_t i = 0; i < count; ++i) {
+        if (take_buffered_server_packet()) {
             continue;
         }
-        prev_seq_id = pkt.sequence_id();
-
-        switch (state) {
-            case ResponseState::kColumnDefs: {
-                if (byte0 == 0xFE && payload.size() < 9) {
-                    state = ResponseState::kRows;
-                } else if (byte0 == 0xFF) {
-                    state = ResponseState::kDone;
-                } else {
-                    ++column_defs_read;
-                    if (column_defs_read > column_count + 1) {
-                        spdlog::warn("[session {}] too many column definitions: {} > {}",
-                                     session_id_,
-                                     column_defs_read,
-                                     column_count);
-                        state = ResponseState::kDone;
-                    }
-                }
-                break;
-            }
+        auto def_pkt_result = co_await next_server_packet(streams);
+        if (!def_pkt_result) {
+            co_return std::unexpected(def_pkt_result.error());
+        }
+    }
 
-            case ResponseState::kRows: {
-                // EOF/ERR packet, or binary-protocol final OK packet — end of result set
-                const bool eof_or_err = (byte0 == 0xFE && payload.size() < 9) || byte0 == 0xFF;
-                const bool final_ok = request_type == CommandType::kComQuery && byte0 == 0x00 &&
-                                      !is_text_row_packet(payload, column_count) &&
-                                      is_resultset_final_ok_packet(payload);
-                if (eof_or_err || final_ok) {
-                    state = ResponseState::kDone;
-                }
-                break;
-            }
+    auto term_pkt_result = co_await next_server_packet(streams);
+    if (!term_pkt_result) {
+        co_return std::unexpected(term_pkt_result.error());
+    }
 
-            case ResponseState::kDone:
-            case ResponseState::kFirst:
-                break;
-        }
+    const FrameHead& term = *term_pkt_result;
+    if (!term.complete() || !is_metadata_terminator_packet(term.prefix)) {
+        spdlog::warn("[session {}] unexpected COM_STMT_PREPARE terminator: 0x{:02x} (len={})",
+                     session_id_,
+                     term.prefix.empty() ? 0U : static_cast<unsigned>(term.prefix[0]),
+                     term.payload_length);
     }
 
     co_return std::expected<void, ParseError>{};
 }
 
 // ---------------------------------------------------------------------------
-// Session::run
+// send_client_error
+//   프록시가 직접 만든 ERR 패킷을 클라이언트에 보낸다 (서버에는 전달하지 않은 커맨드).
 // ---------------------------------------------------------------------------
-auto Session::run() -> boost::asio::awaitable<void> {
-    // -----------------------------------------------------------------------
-    // 1. SessionContext 초기화
-    // -----------------------------------------------------------------------
-    ctx_.session_id = session_id_;
-    ctx_.connected_at = std::chrono::system_clock::now();
+auto Session::send_client_error(std::uint16_t code, std::string_view message, std::uint8_t seq)
+    -> boost::asio::awaitable<bool> {
+    const auto err_bytes = MysqlPacket::make_error(code, message, seq).serialize();
+    boost::system::error_code wr_ec;
+    co_await boost::asio::async_write(
+        client_stream_,
+        boost::asio::buffer(err_bytes),
+        boost::asio::redirect_error(boost::asio::use_awaitable, wr_ec));
+    if (wr_ec) {
+        spdlog::warn("[session {}] failed to send ERR {} to client: {}",
+                     session_id_,
+                     code,
+                     wr_ec.message());
+        co_return false;
+    }
+    co_return true;
+}
 
-    // 클라이언트 IP/포트 추출
-    boost::system::error_code peer_ec;
-    const auto remote_ep = client_stream_.lowest_layer().remote_endpoint(peer_ec);
-    if (!peer_ec) {
-        ctx_.client_ip = remote_ep.address().to_string();
-        ctx_.client_port = remote_ep.port();
+// ---------------------------------------------------------------------------
+// respond_error / forward_and_relay / drain_responses
+//   직렬 모드: 즉시 전송 / 릴레이한다.
+//   파이프라이닝 모드: in-flight 자리를 얻은 뒤 응답을 response_pipeline_ 에 넣는다.
+//   클라이언트 소켓에는 relay_pipelined_responses 만 쓰므로 응답 순서가 유지된다.
+// ---------------------------------------------------------------------------
+auto Session::respond_error(std::uint16_t code, std::string_view message, std::uint8_t seq)
+    -> boost::asio::awaitable<bool> {
+    if (!response_pipeline_.enabled()) {
+        co_return co_await send_client_error(code, message, seq);
     }
+    if (!co_await response_pipeline_.acquire_slot()) {
+        co_return false;
+    }
+    response_pipeline_.push(
+        PendingResponse{.local_reply = MysqlPacket::make_error(code, message, seq).serialize()});
+    co_return true;
+}
 
-    // -----------------------------------------------------------------------
-    // 2. stats: 연결 열기
-    // -----------------------------------------------------------------------
-    stats_->on_connection_open();
+auto Session::forward_and_relay(std::span<const std::uint8_t> raw,
+                                const CommandPacket& cmd,
+                                std::uint64_t query_hash) -> boost::asio::awaitable<bool> {
+    if (response_pipeline_.enabled() && !co_await response_pipeline_.acquire_slot()) {
+        co_return false;
+    }
 
-    struct StatsGuard {  // NOLINT(cppcoreguidelines-special-member-functions)
-        StatsCollector* stats;
-        ~StatsGuard() { stats->on_connection_close(); }
-    } const stats_guard{stats_.get()};
+    const auto upstream_start = std::chrono::steady_clock::now();
+    auto fwd = co_await write_packet_raw(server_stream_, raw);
+    if (!fwd) {
+        spdlog::error("[session {}] failed to forward command 0x{:02x} to server: {}",
+                      session_id_,
+                      static_cast<std::uint8_t>(cmd.command_type),
+                      fwd.error().message);
+        co_return false;
+    }
 
-    // -----------------------------------------------------------------------
-    // 3. Frontend TLS 핸드셰이크 (클라이언트 구간 TLS 활성화 시)
-    // -----------------------------------------------------------------------
-    if (client_stream_.is_ssl()) {
-        boost::system::error_code tls_ec;
-        co_await client_stream_.async_handshake(
-            boost::asio::ssl::stream_base::server,
-            boost::asio::redirect_error(boost::asio::use_awaitable, tls_ec));
+    if (response_pipeline_.enabled()) {
+        response_pipeline_.push(PendingResponse{.command_type = cmd.command_type,
+                                                .sequence_id = cmd.sequence_id,
+                                                .forwarded_at = upstream_start,
+                                                .query_hash = query_hash});
+        co_return true;
+    }
 
-        if (tls_ec) {
-            spdlog::warn(
-                "[session {}] frontend TLS handshake failed: {}", session_id_, tls_ec.message());
-            state_ = SessionState::kClosed;
-            boost::system::error_code close_ec;
-            // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-            client_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both,
-                                                   close_ec);
+    auto relay_result = co_await relay_server_response(cmd.command_type, cmd.sequence_id);
+    if (!relay_result) {
+        spdlog::warn("[session {}] relay_server_response failed: {}",
+                     session_id_,
+                     relay_result.error().message);
+        co_return false;
+    }
+    const auto upstream_elapsed = std::chrono::steady_clock::now() - upstream_start;
+    stats_->on_latency(LatencyStage::kUpstreamResponse, upstream_elapsed);
+    session_stats_->add_upstream_time(upstream_elapsed);
+    if (query_hash != 0) {
+        query_topk_->record_latency(query_hash, upstream_elapsed);
+    }
+    co_return true;
+}
+
+auto Session::drain_responses() -> boost::asio::awaitable<bool> {
+    if (!response_pipeline_.enabled()) {
+        co_return true;
+    }
+    co_return co_await response_pipeline_.drain();
+}
+
+// ---------------------------------------------------------------------------
+// relay_pipelined_responses
+//   파이프라이닝 모드의 소비자. 큐 맨 앞 응답을 클라이언트에 보내고 다음으로 넘어간다.
+//   실패하면 큐를 실패로 표시하고 클라이언트 읽기를 취소하여 run() 루프를 깨운다.
+// ---------------------------------------------------------------------------
+auto Session::relay_pipelined_responses() -> boost::asio::awaitable<void> {
+    while (PendingResponse* const pending = co_await response_pipeline_.next()) {
+        bool ok = true;
+        if (!pending->local_reply.empty()) {
+            boost::system::error_code wr_ec;
+            co_await boost::asio::async_write(
+                client_stream_,
+                boost::asio::buffer(pending->local_reply),
+                boost::asio::redirect_error(boost::asio::use_awaitable, wr_ec));
+            if (wr_ec) {
+                spdlog::warn("[session {}] failed to send queued reply to client: {}",
+                             session_id_,
+                             wr_ec.message());
+                ok = false;
+            }
+        } else {
+            auto relay_result =
+                co_await relay_server_response(pending->command_type, pending->sequence_id);
+            if (relay_result) {
+                const auto upstream_elapsed =
+                    std::chrono::steady_clock::now() - pending->forwarded_at;
+                stats_->on_latency(LatencyStage::kUpstreamResponse, upstream_elapsed);
+                session_stats_->add_upstream_time(upstream_elapsed);
+                if (pending->query_hash != 0) {
+                    query_topk_->record_latency(pending->query_hash, upstream_elapsed);
+                }
+            } else {
+                spdlog::warn("[session {}] pipelined relay failed: {}",
+                             session_id_,
+                             relay_result.error().message);
+                ok = false;
+            }
+        }
+
+        if (!ok) {
+            response_pipeline_.fail();
+            boost::system::error_code cancel_ec;
             // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-            client_stream_.lowest_layer().close(close_ec);
-            co_return;
+            client_stream_.lowest_layer().cancel(cancel_ec);
+            break;
+        }
+        response_pipeline_.complete();
+    }
+    response_pipeline_.finish();
+}
+
+// ---------------------------------------------------------------------------
+// relay_server_response
+//   MySQL 서버 응답(OK / ERR / Result Set)이 완료될 때까지 읽어 클라이언트에 릴레이.
+//   양쪽 스트림의 실제 타입을 여기서 한 번 확인하고 특화된 relay_response 로 넘긴다
+//   (server x client = 3 x 3 인스턴스). 람다는 코루틴을 만들어 반환만 하므로 참조 캡처가
+//   안전하고, RelayStreams 는 세션 멤버 스트림을 참조한다.
+// ---------------------------------------------------------------------------
+auto Session::relay_server_response(CommandType request_type,
+                                    std::uint8_t request_seq_id,
+                                    std::optional<std::uint32_t>* prepared_statement_id)
+    -> boost::asio::awaitable<std::expected<void, ParseError>> {
+    co_return co_await server_stream_.visit([&](auto& server) {
+        return client_stream_.visit([&](auto& client) {
+            using Streams = RelayStreams<std::remove_reference_t<decltype(server)>,
+                                         std::remove_reference_t<decltype(client)>>;
+            return relay_response(Streams{.server = server, .client = client},
+                                  request_type,
+                                  request_seq_id,
+                                  prepared_statement_id);
+        });
+    });
+}
+
+// ---------------------------------------------------------------------------
+// relay_response
+//   패킷 경계 판정은 relay_response_packets, 실제 전송은 묶음 단위로 수행하며
+//   성공/실패와 무관하게 이미 판정된 패킷은 모두 전달한 뒤 반환한다.
+// ---------------------------------------------------------------------------
+template <typename Streams>
+auto Session::relay_response(Streams streams,
+                             CommandType request_type,
+                             std::uint8_t request_seq_id,
+                             std::optional<std::uint32_t>* prepared_statement_id)
+    -> boost::asio::awaitable<std::expected<void, ParseError>> {
+    auto result = co_await relay_response_packets(
+        streams, request_type, request_seq_id, prepared_statement_id);
+    auto flushed = co_await flush_server_pending(streams);
+    trim_server_buffer();
+    if (!result) {
+        co_return result;
+    }
+    co_return flushed;
+}
+
+// ---------------------------------------------------------------------------
+// relay_response_packets
+//   응답 하나를 끝까지 릴레이한다. 결과 셋 / OK 의 끝 패킷에 SERVER_MORE_RESULTS_EXISTS 가
+//   있으면 (CALL, 멀티 스테이트먼트) 다음 결과를 같은 응답으로 이어서 릴레이한다.
+// ---------------------------------------------------------------------------
+template <typename Streams>
+auto Session::relay_response_packets(Streams streams,
+                                    CommandType request_type,
+                                    [[maybe_unused]] std::uint8_t request_seq_id,
+                                    std::optional<std::uint32_t>* prepared_statement_id)
+    -> boost::asio::awaitable<std::expected<void, ParseError>> {
+    while (true) {
+        auto more = co_await relay_result_packets(streams, request_type, prepared_statement_id);
+        if (!more) {
+            co_return std::unexpected(more.error());
+        }
+        if (!*more) {
+            co_return std::expected<void, ParseError>{};
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// relay_result_packets
+//   결과 하나 (OK / ERR / 결과 셋) 의 패킷 경계를 따라 걸으며
+//   column-def / row / EOF 상태 머신을 갱신한다.
+//   반환: 끝 패킷에 SERVER_MORE_RESULTS_EXISTS 가 있어 다음 결과가 이어지는지
+// ---------------------------------------------------------------------------
+template <typename Streams>
+auto Session::relay_result_packets(Streams streams,
+                                   CommandType request_type,
+                                   std::optional<std::uint32_t>* prepared_statement_id)
+    -> boost::asio::awaitable<std::expected<bool, ParseError>> {
+    enum class ResponseState {  // NOLINT(performance-enum-size)
+        kFirst,                 // 첫 패킷 분석 중
+        kColumnDefs,            // column definition 읽는 중
+        kRows,                  // row 데이터 읽는 중
+        kDone,                  // 응답 완료
+    };
+
+    // 첫 패킷으로 응답 유형 판별
+    // (next_server_packet 이 반환한 패킷은 전달 대기열에 포함된다)
+    auto first_pkt_result = co_await next_server_packet(streams);
+    if (!first_pkt_result) {
+        co_return std::unexpected(first_pkt_result.error());
+    }
+
+    const FrameHead first_pkt = *first_pkt_result;
+    const auto first_payload = first_pkt.prefix;
+
+    if (first_payload.empty()) {
+        co_return false;
+    }
+
+    const std::uint8_t first_byte = first_payload[0];
+
+    // 커맨드별 응답 모양: 단일 패킷 응답(COM_STATISTICS 문자열 등)은 첫 바이트를
+    // column count 로 해석하지 않고 바로 끝낸다.
+    switch (response_shape(request_type)) {
+        case ResponseShape::kSinglePacket:
+            co_return false;
+        case ResponseShape::kFieldList: {
+            // column definition 들 뒤 EOF, 또는 ERR 1개
+            FrameHead pkt = first_pkt;
+            while (!pkt.prefix.empty() && pkt.prefix[0] != 0xFF &&
+                   !(pkt.prefix[0] == 0xFE && pkt.payload_length < 9)) {
+                if (const auto buffered = take_buffered_server_packet()) {
+                    pkt = *buffered;
+                    continue;
+                }
+                auto next = co_await next_server_packet(streams);
+                if (!next) {
+                    co_return std::unexpected(next.error());
+                }
+                pkt = *next;
+            }
+            co_return false;
+        }
+        case ResponseShape::kGeneric:
+            break;
+    }
+
+    // ERR 패킷 (0xFF) → 즉시 완료
+    if (first_byte == 0xFF) {
+        co_return false;
+    }
+
+    // OK 패킷 (0x00)
+    if (first_byte == 0x00) {
+        if (request_type == CommandType::kComStmtPrepare) {
+            if (first_payload.size() < 12) {
+                spdlog::warn("[session {}] short COM_STMT_PREPARE OK payload: {} bytes",
+                             session_id_,
+                             first_payload.size());
+                co_return false;
+            }
+
+            // COM_STMT_PREPARE_OK: [0x00][statement_id 4B][num_columns 2B][num_params 2B]...
+            if (prepared_statement_id != nullptr) {
+                *prepared_statement_id = static_cast<std::uint32_t>(first_payload[1]) |
+                                         (static_cast<std::uint32_t>(first_payload[2]) << 8U) |
+                                         (static_cast<std::uint32_t>(first_payload[3]) << 16U) |
+                                         (static_cast<std::uint32_t>(first_payload[4]) << 24U);
+            }
+
+            const std::uint16_t num_columns = static_cast<std::uint16_t>(first_payload[5]) |
+                                              (static_cast<std::uint16_t>(first_payload[6]) << 8U);
+            const std::uint16_t num_params = static_cast<std::uint16_t>(first_payload[7]) |
+                                             (static_cast<std::uint16_t>(first_payload[8]) << 8U);
+
+            if (num_params > 0) {
+                auto params_result = co_await relay_stmt_prepare_section(streams, num_params);
+                if (!params_result) {
+                    co_return std::unexpected(params_result.error());
+                }
+            }
+
+            if (num_columns > 0) {
+                auto columns_result = co_await relay_stmt_prepare_section(streams, num_columns);
+                if (!columns_result) {
+                    co_return std::unexpected(columns_result.error());
+                }
+            }
+            co_return false;
+        }
+        co_return has_more_results(first_payload);
+    }
+
+    // EOF 패킷 (0xFE, payload < 9바이트) → 즉시 완료 (비정상)
+    if (first_byte == 0xFE && first_pkt.payload_length < 9) {
+        co_return false;
+    }
+
+    // LOCAL_INFILE 요청 (0xFB)
+    if (first_byte == 0xFB) {
+        spdlog::warn("[session {}] unsupported LOCAL_INFILE response (0xFB) from server",
+                     session_id_);
+        co_return std::unexpected(ParseError{.code = ParseErrorCode::kUnsupportedCommand,
+                                             .message = "LOCAL_INFILE response is not supported",
+                                             .context = "server response first byte = 0xFB"});
+    }
+
+    // Result Set: 첫 바이트가 column count (0x01~0xFC)
+    if (first_byte < 0x01 || first_byte > 0xFC) {
+        spdlog::warn(
+            "[session {}] unexpected first byte in response: 0x{:02x}", session_id_, first_byte);
+        co_return false;
+    }
+
+    const std::uint8_t column_count = first_byte;
+    std::uint8_t column_defs_read = 0;
+    ResponseState state = ResponseState::kColumnDefs;
+    std::uint8_t prev_seq_id = first_pkt.sequence_id;
+
+    // data_protection.max_result_rows (결과 셋마다 적용, 0 = 제한 없음)
+    const auto row_limit = policy_->result_row_limit();
+    std::uint32_t rows_relayed = 0;
+    std::uint16_t metadata_status = 0;  // column-def 뒤 EOF 의 status_flags
+    bool more_results = false;          // row 구간 terminator 의 SERVER_MORE_RESULTS_EXISTS
+
+    while (state != ResponseState::kDone) {
+        // 한도만큼 전달했으면 다음 패킷을 전달 대기열에 넣기 전에 row 인지 확인한다
+        if (state == ResponseState::kRows && row_limit.max_rows != 0 &&
+            rows_relayed == row_limit.max_rows) {
+            auto next = co_await peek_server_packet(streams);
+            if (!next) {
+                co_return std::unexpected(next.error());
+            }
+            if (!next->prefix.empty() && !is_rows_terminator(*next, request_type, column_count)) {
+                auto ended = co_await end_result_set_at_limit(streams,
+                                                              row_limit,
+                                                              next->sequence_id,
+                                                              metadata_status,
+                                                              request_type,
+                                                              column_count);
+                if (!ended) {
+                    co_return std::unexpected(ended.error());
+                }
+                co_return false;  // 남은 결과는 모두 버렸다
+            }
+        }
+
+        // 이미 수신된 row 는 동기 경로로 꺼낸다 (row 마다 코루틴 프레임을 할당하지 않음)
+        std::optional<FrameHead> buffered = take_buffered_server_packet();
+        if (!buffered) {
+            auto pkt_result = co_await next_server_packet(streams);
+            if (!pkt_result) {
+                co_return std::unexpected(pkt_result.error());
+            }
+            buffered = *pkt_result;
+        }
+
+        const FrameHead pkt = *buffered;
+        const auto payload = pkt.prefix;
+
+        if (payload.empty()) {
+            break;
+        }
+
+        const std::uint8_t byte0 = payload[0];
+
+        if (byte0 == 0xFF) {
+            state = ResponseState::kDone;
+            continue;
+        }
+
+        if (pkt.sequence_id < prev_seq_id && prev_seq_id != 0xFF) {
+            spdlog::warn("[session {}] seq_id reversed ({} -> {}), stopping relay",
+                         session_id_,
+                         prev_seq_id,
+                         pkt.sequence_id);
+            state = ResponseState::kDone;
+            continue;
+        }
+        prev_seq_id = pkt.sequence_id;
+
+        switch (state) {
+            case ResponseState::kColumnDefs: {
+                if (byte0 == 0xFE && pkt.payload_length < 9) {
+                    metadata_status = terminator_status_flags(payload);
+                    state = ResponseState::kRows;
+                } else if (byte0 == 0xFF) {
+                    state = ResponseState::kDone;
+                } else {
+                    ++column_defs_read;
+                    if (column_defs_read > column_count + 1) {
+                        spdlog::warn("[session {}] too many column definitions: {} > {}",
+                                     session_id_,
+                                     column_defs_read,
+                                     column_count);
+                        state = ResponseState::kDone;
+                    }
+                }
+                break;
+            }
+
+            case ResponseState::kRows: {
+                // EOF/ERR packet, or binary-protocol final OK packet — end of result set
+                if (is_rows_terminator(pkt, request_type, column_count)) {
+                    more_results = byte0 != 0xFF && has_more_results(payload);
+                    state = ResponseState::kDone;
+                } else {
+                    ++rows_relayed;
+                }
+                break;
+            }
+
+            case ResponseState::kDone:
+            case ResponseState::kFirst:
+                break;
         }
     }
 
+    co_return more_results;
+}
+
+// ---------------------------------------------------------------------------
+// Session::connect_backend
+//   업스트림 TCP connect 후 backend SSL 이면 TLS 핸드셰이크를 수행하여 server_stream_ 을
+//   교체한다. 실패 시 클라이언트에 ERR(err_seq)을 보내고 클라이언트 소켓을 닫는다.
+//
+//   err_seq: 투명 경로는 greeting 전이므로 0, 풀 경로는 HandshakeResponse(seq 1) 이후이므로 2
+// ---------------------------------------------------------------------------
+auto Session::connect_backend(std::uint8_t err_seq) -> boost::asio::awaitable<bool> {
     // -----------------------------------------------------------------------
-    // 4. MySQL 서버 TCP connect
+    // MySQL 서버 TCP connect
     // -----------------------------------------------------------------------
     // 로컬 tcp::socket으로 서버에 먼저 연결
+    //   버퍼 크기는 SYN 의 window scale 에 반영되도록 connect 전에 설정한다
     boost::asio::ip::tcp::socket raw_server_sock{client_stream_.get_executor()};
     boost::system::error_code connect_ec;
-    co_await boost::asio::async_connect(
-        raw_server_sock,
-        std::vector{server_endpoint_},
-        boost::asio::redirect_error(boost::asio::use_awaitable, connect_ec));
+    // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+    raw_server_sock.open(server_endpoint_.protocol(), connect_ec);
+    if (!connect_ec) {
+        if (auto tuned = apply_socket_tuning(raw_server_sock, upstream_tuning_); !tuned) {
+            spdlog::warn(
+                "[session {}] upstream socket option {} failed", session_id_, tuned.error());
+        }
+        co_await raw_server_sock.async_connect(
+            server_endpoint_, boost::asio::redirect_error(boost::asio::use_awaitable, connect_ec));
+    }
 
+    upstream_lease_.report_connect(!connect_ec);
+    if (!connect_ec) {
+        if (auto ka = apply_tcp_keepalive(raw_server_sock, timeouts_.keepalive); !ka) {
+            spdlog::warn("[session {}] upstream socket option {} failed", session_id_, ka.error());
+        }
+    }
     if (connect_ec) {
         spdlog::error(
             "[session {}] upstream connect failed: {}", session_id_, connect_ec.message());
 
         const auto err_pkt = MysqlPacket::make_error(
-            2003, std::format("Can't connect to MySQL server ({})", connect_ec.message()), 0);
+            2003,
+            std::format("Can't connect to MySQL server ({})", connect_ec.message()),
+            err_seq);
         boost::system::error_code wr_ec;
         const auto err_bytes = err_pkt.serialize();
         co_await boost::asio::async_write(
@@ -542,103 +1329,422 @@ auto Session::run() -> boost::asio::awaitable<void> {
             boost::asio::buffer(err_bytes),
             boost::asio::redirect_error(boost::asio::use_awaitable, wr_ec));
 
-        state_ = SessionState::kClosed;
-        boost::system::error_code close_ec;
-        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-        client_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both,
-                                               close_ec);
-        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-        client_stream_.lowest_layer().close(close_ec);
+        set_state(SessionState::kClosed);
+        boost::system::error_code close_ec;
+        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+        client_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both,
+                                               close_ec);
+        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+        client_stream_.lowest_layer().close(close_ec);
+        co_return false;
+    }
+
+    // -----------------------------------------------------------------------
+    // Backend SSL 핸드셰이크 (backend_ssl_ctx_가 유효한 경우)
+    //    TCP connect 성공 후 TLS 스트림(ssl::stream 또는 KtlsStream)으로 업그레이드하고
+    //    server_stream_ 교체
+    // -----------------------------------------------------------------------
+    if (backend_ssl_ctx_ != nullptr) {
+        spdlog::debug("[session {}] backend SSL: upgrading TCP to TLS", session_id_);
+
+        // TLS 스트림으로 래핑 (kTLS 모드면 KtlsStream, 생성 실패 시 ssl::stream 폴백)
+        AsyncStream tls_server_stream =
+            AsyncStream::make_tls(std::move(raw_server_sock), *backend_ssl_ctx_, backend_ssl_ktls_);
+        SSL* const native_ssl = tls_server_stream.native_ssl();
+
+        const auto verify_name = backend_tls_server_name_.empty()
+                                     ? server_endpoint_.address().to_string()
+                                     : backend_tls_server_name_;
+        boost::system::error_code ip_ec;
+        const bool verify_name_is_ip =
+            !boost::asio::ip::make_address(verify_name, ip_ec).is_unspecified() && !ip_ec;
+
+        // SNI는 호스트명 기반 TLS에서만 설정한다.
+        if (!verify_name.empty() && !verify_name_is_ip) {
+            if (SSL_set_tlsext_host_name(native_ssl, verify_name.c_str()) != 1) {
+                const auto err = ERR_get_error();
+                spdlog::error("[session {}] backend TLS SNI setup failed for {}: {}",
+                              session_id_,
+                              verify_name,
+                              err != 0 ? ERR_error_string(err, nullptr) : "unknown");
+                set_state(SessionState::kClosed);
+                boost::system::error_code close_ec;
+                // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+                client_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both,
+                                                       close_ec);
+                // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+                client_stream_.lowest_layer().close(close_ec);
+                co_return false;
+            }
+        }
+
+        // verify_peer가 활성화되면 인증서 체인 + 호스트명/IP 일치 검증을 모두 수행한다.
+        if (backend_ssl_verify_) {
+            int verify_ok = 0;
+            if (verify_name_is_ip) {
+                X509_VERIFY_PARAM* verify_param = SSL_get0_param(native_ssl);
+                verify_ok = X509_VERIFY_PARAM_set1_ip_asc(verify_param, verify_name.c_str());
+            } else {
+                verify_ok = SSL_set1_host(native_ssl, verify_name.c_str());
+            }
+            if (verify_ok != 1) {
+                const auto err = ERR_get_error();
+                spdlog::error(
+                    "[session {}] backend TLS hostname verification setup failed for {}: {}",
+                    session_id_,
+                    verify_name,
+                    err != 0 ? ERR_error_string(err, nullptr) : "unknown");
+                set_state(SessionState::kClosed);
+                boost::system::error_code close_ec;
+                // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+                client_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both,
+                                                       close_ec);
+                // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+                client_stream_.lowest_layer().close(close_ec);
+                co_return false;
+            }
+        }
+
+        // 세션 재개: 같은 업스트림(검증 이름 + 엔드포인트)에서 받은 세션이 있으면 제시한다.
+        const auto resume_key = std::format("{}@{}:{}",
+                                            verify_name,
+                                            server_endpoint_.address().to_string(),
+                                            server_endpoint_.port());
+        const bool resume_offered = backend_tls_sessions_ != nullptr &&
+                                    backend_tls_sessions_->prepare(native_ssl, resume_key);
+
+        // TLS 핸드셰이크 (client 역할 — 프록시가 MySQL 서버에 연결하는 클라이언트)
+        boost::system::error_code tls_ec;
+        co_await tls_server_stream.async_handshake(
+            boost::asio::ssl::stream_base::client,
+            boost::asio::redirect_error(boost::asio::use_awaitable, tls_ec));
+
+        if (tls_ec) {
+            spdlog::error(
+                "[session {}] backend TLS handshake failed: {}", session_id_, tls_ec.message());
+            if (resume_offered) {
+                backend_tls_sessions_->forget(resume_key);
+            }
+
+            const auto err_pkt =
+                MysqlPacket::make_error(2026,  // CR_SSL_CONNECTION_ERROR
+                                        std::format("SSL connection error: {}", tls_ec.message()),
+                                        err_seq);
+            boost::system::error_code wr_ec;
+            const auto err_bytes = err_pkt.serialize();
+            co_await boost::asio::async_write(
+                client_stream_,
+                boost::asio::buffer(err_bytes),
+                boost::asio::redirect_error(boost::asio::use_awaitable, wr_ec));
+
+            set_state(SessionState::kClosed);
+            boost::system::error_code close_ec;
+            // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+            client_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both,
+                                                   close_ec);
+            // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+            client_stream_.lowest_layer().close(close_ec);
+            co_return false;
+        }
+
+        const bool resumed = SSL_session_reused(native_ssl) == 1;
+        stats_->on_backend_tls_handshake(resumed);
+        spdlog::debug("[session {}] backend TLS handshake succeeded (resumed={} ktls tx={} rx={})",
+                      session_id_,
+                      resumed,
+                      tls_server_stream.kernel_send(),
+                      tls_server_stream.kernel_recv());
+
+        // server_stream_을 TLS stream으로 교체 (move-assign)
+        server_stream_ = std::move(tls_server_stream);
+
+    } else {
+        // 평문 모드: raw tcp::socket으로 AsyncStream 생성
+        server_stream_ = AsyncStream{std::move(raw_server_sock)};
+    }
+
+    co_return true;
+}
+
+// ---------------------------------------------------------------------------
+// Session::establish_backend
+//   서버 연결과 MySQL 핸드셰이크를 완료한다. 실패 시 양쪽 소켓을 닫고 false.
+//
+//   투명 경로 (풀 미사용, 또는 greeting 원형 캡처 전):
+//     connect → relay_handshake. 풀 사용 시 greeting 원형과 풀 키를 캡처한다.
+//   풀 경로:
+//     accept_client (원형 greeting + 새 scramble) → 풀 적중 시 change_user,
+//     미적중이거나 풀 연결이 이미 끊겨 있었으면 connect → authenticate_fresh.
+// ---------------------------------------------------------------------------
+auto Session::establish_backend() -> boost::asio::awaitable<bool> {
+    const auto greeting_template =
+        backend_pool_ ? backend_pool_->greeting_template() : std::vector<std::uint8_t>{};
+
+    if (greeting_template.empty()) {
+        if (!co_await connect_backend(0)) {
+            co_return false;
+        }
+
+        HandshakeCapture capture;
+        auto hs_result = co_await HandshakeRelay::relay_handshake(
+            client_stream_, server_stream_, ctx_, backend_pool_ ? &capture : nullptr);
+        if (!hs_result) {
+            spdlog::error(
+                "[session {}] handshake failed: {}", session_id_, hs_result.error().message);
+            close_streams();
+            co_return false;
+        }
+
+        if (backend_pool_ && capture.client) {
+            if (!capture.server_greeting.empty()) {
+                backend_pool_->set_greeting_template(std::move(capture.server_greeting));
+            }
+            pool_flags_ = capture.client->capability_flags;
+            pool_key_ = make_pool_key(*capture.client);
+        }
+        co_return true;
+    }
+
+    auto client = co_await HandshakeRelay::accept_client(client_stream_, greeting_template);
+    if (!client) {
+        spdlog::warn("[session {}] pooled handshake rejected client: {} ({})",
+                     session_id_,
+                     client.error().message,
+                     client.error().context);
+        close_streams();
+        co_return false;
+    }
+
+    auto key = make_pool_key(*client);
+    if (auto pooled = backend_pool_->acquire(key, std::chrono::steady_clock::now())) {
+        server_stream_ = std::move(pooled->stream);
+        pool_flags_ = pooled->capability_flags;
+
+        auto status = co_await HandshakeRelay::change_user(
+            client_stream_, server_stream_, *client, pool_flags_, ctx_);
+        if (!status) {
+            spdlog::error("[session {}] pooled re-authentication failed: {}",
+                          session_id_,
+                          status.error().message);
+            close_streams();
+            co_return false;
+        }
+        if (*status == PooledAuthStatus::kDone) {
+            spdlog::debug("[session {}] reusing pooled backend connection", session_id_);
+            pool_key_ = std::move(key);
+            co_return true;
+        }
+
+        // 클라이언트에 아무것도 전달하기 전에 풀 연결이 끊긴 것을 확인 — 새 연결로 진행
+        spdlog::debug("[session {}] pooled backend connection was stale, reconnecting",
+                      session_id_);
+        stats_->on_pool_eviction();
+        boost::system::error_code close_ec;
+        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+        server_stream_.lowest_layer().close(close_ec);
+    }
+
+    if (!co_await connect_backend(2)) {
+        co_return false;
+    }
+
+    auto hs_result =
+        co_await HandshakeRelay::authenticate_fresh(client_stream_, server_stream_, *client, ctx_);
+    if (!hs_result) {
+        spdlog::error(
+            "[session {}] handshake failed: {}", session_id_, hs_result.error().message);
+        close_streams();
+        co_return false;
+    }
+
+    pool_flags_ = client->capability_flags;
+    pool_key_ = std::move(key);
+    co_return true;
+}
+
+// ---------------------------------------------------------------------------
+// Session::release_backend
+//   COM_RESET_CONNECTION 으로 세션 상태를 초기화하고 서버 연결을 풀에 반납한다.
+//   reset 이 실패하면 반납하지 않는다 (호출자가 server_stream_ 을 닫는다).
+// ---------------------------------------------------------------------------
+auto Session::release_backend() -> boost::asio::awaitable<void> {
+    auto reset = co_await HandshakeRelay::reset_connection(server_stream_);
+    if (!reset) {
+        spdlog::debug("[session {}] backend reset failed, not pooling: {}",
+                      session_id_,
+                      reset.error().message);
+        stats_->on_pool_eviction();
+        co_return;
+    }
+
+    PooledBackend backend{.stream = std::move(server_stream_),
+                          .capability_flags = pool_flags_,
+                          .idle_since = std::chrono::steady_clock::now()};
+    server_stream_ = AsyncStream{boost::asio::ip::tcp::socket{client_stream_.get_executor()}};
+
+    if (backend_pool_->release(*pool_key_, std::move(backend))) {
+        spdlog::debug("[session {}] backend connection returned to pool", session_id_);
+    }
+}
+
+auto Session::make_pool_key(const ClientHandshake& client) const -> BackendPoolKey {
+    return BackendPoolKey{.db_user = client.user,
+                          .db_name = client.db,
+                          .capability_flags = client.capability_flags,
+                          .backend_tls = backend_ssl_ctx_ != nullptr,
+                          .endpoint = server_endpoint_};
+}
+
+void Session::close_streams() {
+    set_state(SessionState::kClosed);
+    boost::system::error_code close_ec;
+    // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+    client_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both, close_ec);
+    // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+    client_stream_.lowest_layer().close(close_ec);
+    // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+    server_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both, close_ec);
+    // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+    server_stream_.lowest_layer().close(close_ec);
+}
+
+void Session::on_handshake_timeout() {
+    if (state_ != SessionState::kHandshaking) {
+        return;
+    }
+    spdlog::warn("[session {}] handshake not finished within {}ms, closing",
+                 session_id_,
+                 admission_.handshake_timeout().count());
+    stats_->on_handshake_timeout();
+    close_streams();
+}
+
+void Session::on_idle_check() {
+    idle_timer_ = 0;
+    if (timers_stopped_ || state_ == SessionState::kClosed) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (!awaiting_command_ || !response_pipeline_.empty()) {
+        idle_since_ = now;  // 처리 중 — 지금부터 다시 센다
+    } else if (now - idle_since_ >= timeouts_.idle_timeout) {
+        spdlog::info("[session {}] idle for {}s, closing",
+                     session_id_,
+                     std::chrono::duration_cast<std::chrono::seconds>(timeouts_.idle_timeout)
+                         .count());
+        stats_->on_idle_timeout();
+        close_streams();
+        return;
+    }
+    idle_timer_ = schedule_on_strand(idle_since_ + timeouts_.idle_timeout, &Session::on_idle_check);
+}
+
+auto Session::schedule_on_strand(std::chrono::steady_clock::time_point deadline,
+                                 void (Session::*handler)()) -> TimerWheel::TimerId {
+    // 휠 콜백은 advance() 를 호출한 스레드에서 실행된다 → 세션 상태는 strand 에서만 만진다
+    return timeouts_.wheel->schedule(
+        deadline, [weak = weak_from_this(), strand = strand_, handler]() {
+            boost::asio::post(strand, [weak, handler]() {
+                if (const auto self = weak.lock()) {
+                    ((*self).*handler)();
+                }
+            });
+        });
+}
+
+void Session::on_drain_check() {
+    drain_timer_ = 0;
+    if (timers_stopped_ || state_ == SessionState::kClosed) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const bool idle = awaiting_command_ && response_pipeline_.empty();
+    if (idle && now - idle_since_ >= drain_idle_) {
+        spdlog::debug("[session {}] closing idle session for drain", session_id_);
+        close_streams();
+        return;
+    }
+    if (timeouts_.wheel == nullptr) {
+        return;  // 휠이 없으면 커맨드 루프가 다음 커맨드 경계에서 끝낸다
+    }
+    // 처리 중 / 핸드셰이크 중이면 지금부터 다시 센다 (on_idle_check 와 같은 방식)
+    const auto next = idle ? idle_since_ + drain_idle_
+                           : now + std::max(drain_idle_, timeouts_.wheel->tick());
+    drain_timer_ = schedule_on_strand(next, &Session::on_drain_check);
+}
+
+void Session::cancel_timers() noexcept {
+    timers_stopped_ = true;
+    if (timeouts_.wheel == nullptr) {
+        return;
+    }
+    timeouts_.wheel->cancel(std::exchange(handshake_timer_, 0));
+    timeouts_.wheel->cancel(std::exchange(idle_timer_, 0));
+    timeouts_.wheel->cancel(std::exchange(drain_timer_, 0));
+}
+
+// ---------------------------------------------------------------------------
+// Session::run
+// ---------------------------------------------------------------------------
+auto Session::run() -> boost::asio::awaitable<void> {
+    // -----------------------------------------------------------------------
+    // 1. SessionContext 초기화
+    // -----------------------------------------------------------------------
+    ctx_.session_id = session_id_;
+    ctx_.connected_at = std::chrono::system_clock::now();
+
+    // run() 이 시작되기 전에 close() 되었다면 cancel 할 비동기 작업이 없었으므로 여기서 끝낸다
+    // (ProxyServer::stop() 이 sessions_ 등록 직후, co_spawn 전에 세션을 닫는 경우).
+    if (closing_.load(std::memory_order_acquire)) {
+        close_streams();
         co_return;
     }
 
+    // 클라이언트 IP/포트 추출
+    boost::system::error_code peer_ec;
+    const auto remote_ep = client_stream_.lowest_layer().remote_endpoint(peer_ec);
+    if (!peer_ec) {
+        ctx_.client_ip = remote_ep.address().to_string();
+        ctx_.client_port = remote_ep.port();
+    }
+    session_stats_->publish_context(ctx_);
+
     // -----------------------------------------------------------------------
-    // 5. Backend SSL 핸드셰이크 (backend_ssl_ctx_가 유효한 경우)
-    //    TCP connect 성공 후 ssl::stream으로 업그레이드하고 server_stream_ 교체
+    // 2. stats: 연결 열기
     // -----------------------------------------------------------------------
-    if (backend_ssl_ctx_ != nullptr) {
-        spdlog::debug("[session {}] backend SSL: upgrading TCP to TLS", session_id_);
-
-        // ssl::stream으로 래핑
-        boost::asio::ssl::stream<boost::asio::ip::tcp::socket> ssl_server_sock{
-            std::move(raw_server_sock), *backend_ssl_ctx_};
-
-        const auto verify_name = backend_tls_server_name_.empty()
-                                     ? server_endpoint_.address().to_string()
-                                     : backend_tls_server_name_;
-        boost::system::error_code ip_ec;
-        const bool verify_name_is_ip =
-            !boost::asio::ip::make_address(verify_name, ip_ec).is_unspecified() && !ip_ec;
+    stats_->on_connection_open();
 
-        // SNI는 호스트명 기반 TLS에서만 설정한다.
-        if (!verify_name.empty() && !verify_name_is_ip) {
-            if (SSL_set_tlsext_host_name(ssl_server_sock.native_handle(), verify_name.c_str()) !=
-                1) {
-                const auto err = ERR_get_error();
-                spdlog::error("[session {}] backend TLS SNI setup failed for {}: {}",
-                              session_id_,
-                              verify_name,
-                              err != 0 ? ERR_error_string(err, nullptr) : "unknown");
-                state_ = SessionState::kClosed;
-                boost::system::error_code close_ec;
-                // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-                client_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both,
-                                                       close_ec);
-                // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-                client_stream_.lowest_layer().close(close_ec);
-                co_return;
-            }
-        }
+    struct StatsGuard {  // NOLINT(cppcoreguidelines-special-member-functions)
+        StatsCollector* stats;
+        ~StatsGuard() { stats->on_connection_close(); }
+    } const stats_guard{stats_.get()};
 
-        // verify_peer가 활성화되면 인증서 체인 + 호스트명/IP 일치 검증을 모두 수행한다.
-        if (backend_ssl_verify_) {
-            int verify_ok = 0;
-            if (verify_name_is_ip) {
-                X509_VERIFY_PARAM* verify_param = SSL_get0_param(ssl_server_sock.native_handle());
-                verify_ok = X509_VERIFY_PARAM_set1_ip_asc(verify_param, verify_name.c_str());
-            } else {
-                verify_ok = SSL_set1_host(ssl_server_sock.native_handle(), verify_name.c_str());
-            }
-            if (verify_ok != 1) {
-                const auto err = ERR_get_error();
-                spdlog::error(
-                    "[session {}] backend TLS hostname verification setup failed for {}: {}",
-                    session_id_,
-                    verify_name,
-                    err != 0 ? ERR_error_string(err, nullptr) : "unknown");
-                state_ = SessionState::kClosed;
-                boost::system::error_code close_ec;
-                // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-                client_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both,
-                                                       close_ec);
-                // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-                client_stream_.lowest_layer().close(close_ec);
-                co_return;
-            }
-        }
+    // 핸드셰이크 제한 시간: TLS + 백엔드 인증이 끝나기 전에 만료되면 소켓을 닫아
+    // 진행 중인 읽기/쓰기를 실패시킨다 (휠 콜백은 이 strand 로 post 된다).
+    struct TimerGuard {  // NOLINT(cppcoreguidelines-special-member-functions)
+        Session* session;
+        ~TimerGuard() { session->cancel_timers(); }
+    } const timer_guard{this};
+
+    if (const auto timeout = admission_.handshake_timeout();
+        timeouts_.wheel != nullptr && timeout.count() > 0) {
+        handshake_timer_ = schedule_on_strand(std::chrono::steady_clock::now() + timeout,
+                                              &Session::on_handshake_timeout);
+    }
 
-        // TLS 핸드셰이크 (client 역할 — 프록시가 MySQL 서버에 연결하는 클라이언트)
+    // -----------------------------------------------------------------------
+    // 3. Frontend TLS 핸드셰이크 (클라이언트 구간 TLS 활성화 시)
+    // -----------------------------------------------------------------------
+    if (client_stream_.is_ssl()) {
         boost::system::error_code tls_ec;
-        co_await ssl_server_sock.async_handshake(
-            boost::asio::ssl::stream_base::client,
+        co_await client_stream_.async_handshake(
+            boost::asio::ssl::stream_base::server,
             boost::asio::redirect_error(boost::asio::use_awaitable, tls_ec));
 
         if (tls_ec) {
-            spdlog::error(
-                "[session {}] backend TLS handshake failed: {}", session_id_, tls_ec.message());
-
-            const auto err_pkt =
-                MysqlPacket::make_error(2026,  // CR_SSL_CONNECTION_ERROR
-                                        std::format("SSL connection error: {}", tls_ec.message()),
-                                        0);
-            boost::system::error_code wr_ec;
-            const auto err_bytes = err_pkt.serialize();
-            co_await boost::asio::async_write(
-                client_stream_,
-                boost::asio::buffer(err_bytes),
-                boost::asio::redirect_error(boost::asio::use_awaitable, wr_ec));
-
-            state_ = SessionState::kClosed;
+            spdlog::warn(
+                "[session {}] frontend TLS handshake failed: {}", session_id_, tls_ec.message());
+            set_state(SessionState::kClosed);
             boost::system::error_code close_ec;
             // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
             client_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both,
@@ -647,43 +1753,43 @@ auto Session::run() -> boost::asio::awaitable<void> {
             client_stream_.lowest_layer().close(close_ec);
             co_return;
         }
-
-        spdlog::debug("[session {}] backend TLS handshake succeeded", session_id_);
-
-        // server_stream_을 TLS stream으로 교체 (move-assign)
-        server_stream_ = AsyncStream{std::move(ssl_server_sock)};
-
-    } else {
-        // 평문 모드: raw tcp::socket으로 AsyncStream 생성
-        server_stream_ = AsyncStream{std::move(raw_server_sock)};
+        const bool resumed = SSL_session_reused(client_stream_.native_ssl()) == 1;
+        stats_->on_frontend_tls_handshake(resumed);
+        spdlog::debug("[session {}] frontend TLS handshake succeeded (resumed={} ktls tx={} rx={})",
+                      session_id_,
+                      resumed,
+                      client_stream_.kernel_send(),
+                      client_stream_.kernel_recv());
     }
 
     // -----------------------------------------------------------------------
-    // 6. HandshakeRelay::relay_handshake()
+    // 4~6. 업스트림 연결 + MySQL 핸드셰이크
+    //   연결 풀 사용 시 풀 연결을 재인증하거나 새 연결을 재인증 경로로 인증한다.
     // -----------------------------------------------------------------------
-    auto hs_result = co_await HandshakeRelay::relay_handshake(client_stream_, server_stream_, ctx_);
-
-    if (!hs_result) {
-        spdlog::error("[session {}] handshake failed: {}", session_id_, hs_result.error().message);
-        state_ = SessionState::kClosed;
-        boost::system::error_code close_ec;
-        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-        client_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both,
-                                               close_ec);
-        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-        client_stream_.lowest_layer().close(close_ec);
-        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-        server_stream_.lowest_layer().shutdown(boost::asio::ip::tcp::socket::shutdown_both,
-                                               close_ec);
-        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
-        server_stream_.lowest_layer().close(close_ec);
+    if (!co_await establish_backend()) {
         co_return;
     }
-
+    if (state_ == SessionState::kClosed) {
+        co_return;  // 제한 시간 만료로 닫힌 뒤 완료된 핸드셰이크
+    }
     // -----------------------------------------------------------------------
     // 7. 핸드셰이크 완료 → kReady
     // -----------------------------------------------------------------------
-    state_ = SessionState::kReady;
+    if (timeouts_.wheel != nullptr) {
+        timeouts_.wheel->cancel(std::exchange(handshake_timer_, 0));
+    }
+    admission_.handshake_finished();
+    set_state(SessionState::kReady);
+
+    if (timeouts_.wheel != nullptr && timeouts_.idle_timeout.count() > 0) {
+        idle_since_ = std::chrono::steady_clock::now();
+        idle_timer_ = schedule_on_strand(idle_since_ + timeouts_.idle_timeout,
+                                         &Session::on_idle_check);
+    }
+
+    // user/IP 가 확정됐으므로 access rule 을 미리 바인딩한다 (reload 후에는 다음 쿼리에서 재바인딩)
+    policy_->bind(ctx_, policy_binding_);
+    session_stats_->publish_context(ctx_);
 
     logger_->log_connection(ConnectionLog{
         .session_id = session_id_,
@@ -697,22 +1803,51 @@ auto Session::run() -> boost::asio::awaitable<void> {
     spdlog::info(
         "[session {}] handshake done, user={}, db={}", session_id_, ctx_.db_user, ctx_.db_name);
 
+    // 파이프라이닝 모드: 응답 릴레이를 별도 코루틴(같은 strand)으로 분리한다.
+    // 아래 커맨드 루프는 앞선 응답이 릴레이되는 동안 다음 커맨드를 읽고·평가·전달한다.
+    if (response_pipeline_.enabled()) {
+        boost::asio::co_spawn(
+            strand_,
+            [self = shared_from_this()]() { return self->relay_pipelined_responses(); },
+            boost::asio::detached);
+    }
+
     // -----------------------------------------------------------------------
     // 8. 커맨드 루프
+    //   backend_reusable: 커맨드 경계에서 클라이언트가 정상 종료(COM_QUIT / EOF)했는지.
+    //   이 경우에만 서버 연결을 reset 후 풀에 반납한다.
     // -----------------------------------------------------------------------
+    bool backend_reusable = false;
     while (true) {
         if (closing_.load(std::memory_order_acquire)) {
             break;
         }
+        if (draining_ && (drain_idle_.count() == 0 || timeouts_.wheel == nullptr)) {
+            // drain: 앞선 응답을 모두 보낸 뒤 커맨드 경계에서 끝낸다
+            [[maybe_unused]] const bool drained = co_await drain_responses();
+            spdlog::debug("[session {}] closed at command boundary for drain", session_id_);
+            break;
+        }
 
-        auto pkt_result = co_await read_one_packet(client_stream_);
+        trim_client_buffer();
+        if (idle_timer_ != 0 || draining_) {
+            idle_since_ = std::chrono::steady_clock::now();
+        }
+        awaiting_command_ = true;
+        auto pkt_result = co_await read_one_packet(client_stream_, client_buf_);
+        awaiting_command_ = false;
+        sync_relay_memory();
 
         if (!pkt_result) {
             const auto& err = pkt_result.error();
+            if (draining_ && state_ == SessionState::kClosed) {
+                break;  // on_drain_check 가 유휴 세션을 닫았다
+            }
             if (err.context.find("eof") != std::string::npos ||
                 err.context.find("End of file") != std::string::npos ||
                 err.message.find("header") != std::string::npos) {
                 spdlog::debug("[session {}] client disconnected", session_id_);
+                backend_reusable = pool_key_.has_value();
             } else {
                 spdlog::warn("[session {}] read error: {} (context: {})",
                              session_id_,
@@ -722,7 +1857,10 @@ auto Session::run() -> boost::asio::awaitable<void> {
             break;
         }
 
-        const MysqlPacket& pkt = *pkt_result;
+        // client_buf_ 위의 뷰: 아래 서버 응답 릴레이는 server_rx_ 를 쓰므로
+        // 이 커맨드 처리가 끝날 때까지 유효하다.
+        const MysqlPacketView pkt = *pkt_result;
+        session_stats_->add_bytes_in(pkt.raw().size());
 
         auto cmd_result = extract_command(pkt);
         if (!cmd_result) {
@@ -739,12 +1877,16 @@ auto Session::run() -> boost::asio::awaitable<void> {
         // ---------------------------------------------------------------
         if (cmd.command_type == CommandType::kComQuit) {
             spdlog::debug("[session {}] COM_QUIT received", session_id_);
-            boost::system::error_code fwd_ec;
-            const auto quit_bytes = pkt.serialize();
-            co_await boost::asio::async_write(
-                server_stream_,
-                boost::asio::buffer(quit_bytes),
-                boost::asio::redirect_error(boost::asio::use_awaitable, fwd_ec));
+            // 앞선 응답을 모두 보낸 뒤 종료한다 (실패 시 연결 반납 안 함)
+            if (!co_await drain_responses()) {
+                break;
+            }
+            // 풀에 반납할 연결에는 COM_QUIT 을 전달하지 않는다
+            backend_reusable = pool_key_.has_value();
+            if (!backend_reusable) {
+                [[maybe_unused]] const auto fwd =
+                    co_await write_packet_raw(server_stream_, pkt.raw());
+            }
             break;
         }
 
@@ -752,45 +1894,89 @@ auto Session::run() -> boost::asio::awaitable<void> {
         // COM_QUERY
         // ---------------------------------------------------------------
         if (cmd.command_type == CommandType::kComQuery) {
-            state_ = SessionState::kProcessingQuery;
+            set_state(SessionState::kProcessingQuery);
 
+            // 이 블록의 scratch (fingerprint, 파서 결과, 테이블 뷰) 는 query_arena_ 에서
+            // 할당한다. arena_scope 가 가장 먼저 선언되어 가장 나중에 파괴되며 arena 를 reset.
+            const QueryArena::Scope arena_scope{query_arena_};
             const auto query_start = std::chrono::steady_clock::now();
 
-            auto parse_result = sql_parser_.parse(cmd.query);
+            // 원문은 한 번만 토큰화하고 fingerprint 와 파서(캐시 미스 시)가 토큰을 공유한다.
+            // 같은 형태(fingerprint)·사용자·IP 의 판정이 캐시되어 있으면 파싱과 리터럴 비의존
+            // 단계를 생략한다. block_patterns 는 적중 시에도 원문에 수행된다.
+            const auto sql_tokens = tokenize_sql(cmd.query, &query_arena_);
+            const auto fingerprint = fingerprint_query(cmd.query, sql_tokens, &query_arena_);
+            const auto lookup_start = std::chrono::steady_clock::now();
+            auto cached = fingerprint ? policy_->evaluate_cached(*fingerprint, cmd.query, ctx_)
+                                      : std::nullopt;
 
             PolicyResult policy_result;
-
-            if (!parse_result) {
-                spdlog::warn("[session {}] SQL parse error: {} sql={}",
-                             session_id_,
-                             parse_result.error().message,
-                             cmd.query.size() > 200 ? cmd.query.substr(0, 200) + "..." : cmd.query);
-                policy_result = policy_->evaluate_error(parse_result.error(), ctx_);
+            std::uint8_t command_raw = 0;
+            // 감사 로그용 테이블명 뷰: client_buf_ 위 원문(파싱 결과) 또는 캐시 항목 사본을
+            // 가리킨다. 둘 다 이 커맨드 처리가 끝날 때까지 유지된다 (parsed_query / cached).
+            std::pmr::vector<std::string_view> tables{&query_arena_};
+            std::optional<ParsedQuery> parsed_query;
+
+            if (cached) {
+                stats_->on_latency(LatencyStage::kPolicyEvaluate,
+                                   std::chrono::steady_clock::now() - lookup_start);
+                policy_result = std::move(cached->result);
+                command_raw = static_cast<std::uint8_t>(cached->command);
+                tables.assign(cached->tables.begin(), cached->tables.end());
             } else {
-                const ParsedQuery& parsed = *parse_result;
+                const auto parse_start = std::chrono::steady_clock::now();
+                auto parse_result = sql_parser_.parse(cmd.query, sql_tokens, &query_arena_);
+                const auto parse_end = std::chrono::steady_clock::now();
+                stats_->on_latency(LatencyStage::kParse, parse_end - parse_start);
+
+                if (!parse_result) {
+                    spdlog::warn("[session {}] SQL parse error: {} sql={}{}",
+                                 session_id_,
+                                 parse_result.error().message,
+                                 cmd.query.substr(0, 200),
+                                 cmd.query.size() > 200 ? "..." : "");
+                    policy_result = policy_->evaluate_error(parse_result.error(), ctx_);
+                } else {
+                    const ParsedQuery& parsed = *parse_result;
 
-                [[maybe_unused]] const auto inj_result = injection_detector_.check(cmd.query);
-                [[maybe_unused]] const auto proc_result = proc_detector_.detect(parsed);
+                    // InjectionDetector 는 정책 스냅샷 단위로 1회 컴파일되어 세션 간 공유된다.
+                    // (세션마다 정규식을 컴파일하지 않음 — 재연결 폭주 시 지연 방지)
+                    if (const auto detector = policy_->injection_detector()) {
+                        [[maybe_unused]] const auto inj_result = detector->check(cmd.query);
+                    }
+                    const auto inj_end = std::chrono::steady_clock::now();
+                    stats_->on_latency(LatencyStage::kInjectionCheck, inj_end - parse_end);
+                    // 프로시저/동적 SQL 과 무관한 커맨드는 탐지 자체를 건너뛴다
+                    if (ProcedureDetector::is_candidate(parsed.command)) {
+                        [[maybe_unused]] const auto proc_result = proc_detector_.detect(parsed);
+                    }
 
-                policy_result = policy_->evaluate(parsed, ctx_);
+                    const auto eval_start = std::chrono::steady_clock::now();
+                    policy_result =
+                        fingerprint
+                            ? policy_->evaluate(parsed, ctx_, *fingerprint, &policy_binding_)
+                            : policy_->evaluate(parsed, ctx_, &policy_binding_);
+                    stats_->on_latency(LatencyStage::kPolicyEvaluate,
+                                       std::chrono::steady_clock::now() - eval_start);
+                    command_raw = static_cast<std::uint8_t>(parsed.command);
+                    // 판정이 끝났으므로 파서 결과를 이 커맨드 끝까지 보관하고 뷰만 가져온다
+                    parsed_query.emplace(std::move(*parse_result));
+                    tables = std::move(parsed_query->tables);
+                }
             }
 
             const auto query_end = std::chrono::steady_clock::now();
             const auto duration =
                 std::chrono::duration_cast<std::chrono::microseconds>(query_end - query_start);
+            stats_->on_latency(LatencyStage::kProxyOverhead, query_end - query_start);
+            const std::string_view fingerprint_view =
+                fingerprint ? std::string_view{*fingerprint} : std::string_view{};
 
             if (policy_result.action == PolicyAction::kBlock) {
-                const auto err_pkt =
-                    MysqlPacket::make_error(1045,
-                                            "Access denied by policy",
-                                            static_cast<std::uint8_t>(cmd.sequence_id + 1));
-
-                boost::system::error_code wr_ec;
-                const auto err_bytes = err_pkt.serialize();
-                co_await boost::asio::async_write(
-                    client_stream_,
-                    boost::asio::buffer(err_bytes),
-                    boost::asio::redirect_error(boost::asio::use_awaitable, wr_ec));
+                const bool replied =
+                    co_await respond_error(1045,
+                                           "Access denied by policy",
+                                           static_cast<std::uint8_t>(cmd.sequence_id + 1));
 
                 logger_->log_block(BlockLog{
                     .session_id = session_id_,
@@ -802,8 +1988,13 @@ auto Session::run() -> boost::asio::awaitable<void> {
                     .timestamp = std::chrono::system_clock::now(),
                 });
 
-                stats_->on_query(true);
-                state_ = SessionState::kReady;
+                record_query(true);
+                (void)record_top_query(fingerprint_view, true);
+                stats_->on_rule_block(policy_result.matched_rule);
+                if (!replied) {
+                    break;
+                }
+                set_state(SessionState::kReady);
                 continue;
             }
 
@@ -824,86 +2015,291 @@ auto Session::run() -> boost::asio::awaitable<void> {
             }
 
             {
-                auto fwd = co_await write_packet_raw(server_stream_, pkt);
-                if (!fwd) {
-                    spdlog::error("[session {}] failed to forward query to server: {}",
-                                  session_id_,
-                                  fwd.error().message);
+                // 파이프라이닝 모드에서는 응답 릴레이를 기다리지 않는다 (로그는 전달 시점 기준)
+                // Top-K 카운터를 전달 전에 잡아 두어야 첫 쿼리의 지연도 귀속된다
+                const std::uint64_t query_hash = record_top_query(fingerprint_view, false);
+                if (!co_await forward_and_relay(pkt.raw(), cmd, query_hash)) {
                     break;
                 }
 
-                auto relay_result =
-                    co_await relay_server_response(cmd.command_type, cmd.sequence_id);
-                if (!relay_result) {
-                    spdlog::warn("[session {}] relay_server_response failed: {}",
-                                 session_id_,
-                                 relay_result.error().message);
-                    break;
+                // 허용 쿼리 로그는 정책의 샘플링/세션 rate limit 을 따른다.
+                // (차단·monitor would-block 로그는 위에서 항상 기록된다)
+                if (log_sampler_.admit(policy_result.action,
+                                       policy_result.query_log,
+                                       std::chrono::steady_clock::now())) {
+                    logger_->log_query(QueryLog{
+                        .session_id = session_id_,
+                        .db_user = ctx_.db_user,
+                        .client_ip = ctx_.client_ip,
+                        .raw_sql = cmd.query,
+                        .command_raw = command_raw,
+                        .tables = tables,
+                        .action_raw = static_cast<std::uint8_t>(policy_result.action),
+                        .timestamp = std::chrono::system_clock::now(),
+                        .duration = duration,
+                    });
+                } else {
+                    stats_->on_query_log_suppressed();
                 }
 
-                std::uint8_t command_raw = 0;
-                std::vector<std::string> tables;
-                if (parse_result) {
-                    command_raw = static_cast<std::uint8_t>(parse_result->command);
-                    tables = parse_result->tables;
+                record_query(false);
+            }
+
+            set_state(SessionState::kReady);
+            continue;
+        }
+
+        // ---------------------------------------------------------------
+        // COM_STMT_PREPARE
+        //   SQL 을 1회 파싱·평가한다. 차단이면 서버에 전달하지 않고 ERR, 허용이면 전달 후
+        //   서버가 돌려준 statement_id 로 판정을 보관한다 (EXECUTE 는 조회만).
+        // ---------------------------------------------------------------
+        if (cmd.command_type == CommandType::kComStmtPrepare) {
+            set_state(SessionState::kProcessingQuery);
+            const QueryArena::Scope arena_scope{query_arena_};
+
+            if (prepared_statements_.full()) {
+                spdlog::warn("[session {}] prepared statement limit reached ({})",
+                             session_id_,
+                             PreparedStatementTable::kMaxStatements);
+                if (!co_await respond_error(
+                        1461,
+                        "Can't create more than max_prepared_stmt_count statements",
+                        static_cast<std::uint8_t>(cmd.sequence_id + 1))) {
+                    break;
                 }
+                set_state(SessionState::kReady);
+                continue;
+            }
 
-                logger_->log_query(QueryLog{
+            const auto eval_start = std::chrono::steady_clock::now();
+            auto statement = prepare_statement(
+                cmd.query, sql_parser_, *policy_, ctx_, &policy_binding_, &query_arena_);
+            stats_->on_latency(LatencyStage::kPolicyEvaluate,
+                               std::chrono::steady_clock::now() - eval_start);
+            const PolicyResult& verdict = statement.verdict.result;
+
+            if (verdict.action == PolicyAction::kBlock || verdict.monitor_mode) {
+                logger_->log_block(BlockLog{
                     .session_id = session_id_,
                     .db_user = ctx_.db_user,
                     .client_ip = ctx_.client_ip,
-                    .raw_sql = cmd.query,
-                    .command_raw = command_raw,
-                    .tables = std::move(tables),
-                    .action_raw = static_cast<std::uint8_t>(policy_result.action),
+                    .raw_sql = statement.sql,
+                    .matched_rule = verdict.matched_rule,
+                    .reason = verdict.reason,
                     .timestamp = std::chrono::system_clock::now(),
-                    .duration = duration,
+                    .would_block = verdict.monitor_mode,
                 });
-
-                stats_->on_query(false);
+            }
+            if (verdict.action == PolicyAction::kBlock) {
+                record_query(true);
+                (void)record_top_query(statement.fingerprint, true);
+                stats_->on_rule_block(verdict.matched_rule);
+                if (!co_await respond_error(
+                        1045,
+                        "Access denied by policy",
+                        static_cast<std::uint8_t>(cmd.sequence_id + 1))) {
+                    break;
+                }
+                set_state(SessionState::kReady);
+                continue;
+            }
+            if (verdict.monitor_mode) {
+                stats_->on_monitored_block();
             }
 
-            state_ = SessionState::kReady;
+            // statement_id 를 받아 등록해야 하므로 PREPARE 응답은 직렬로 릴레이한다
+            if (!co_await drain_responses()) {
+                break;
+            }
+            auto fwd = co_await write_packet_raw(server_stream_, pkt.raw());
+            if (!fwd) {
+                spdlog::error("[session {}] failed to forward COM_STMT_PREPARE to server: {}",
+                              session_id_,
+                              fwd.error().message);
+                break;
+            }
+            std::optional<std::uint32_t> statement_id;
+            auto relay_result = co_await relay_server_response(
+                cmd.command_type, cmd.sequence_id, &statement_id);
+            if (!relay_result) {
+                spdlog::warn("[session {}] relay_server_response failed: {}",
+                             session_id_,
+                             relay_result.error().message);
+                break;
+            }
+            // 서버 ERR (문법 오류 등) 이면 statement_id 가 없다 — 등록하지 않음
+            if (statement_id) {
+                prepared_statements_.insert(*statement_id, std::move(statement));
+            }
+            set_state(SessionState::kReady);
             continue;
         }
 
         // ---------------------------------------------------------------
-        // Prepared Statement 계열 (보안 fail-close)
+        // COM_STMT_EXECUTE
+        //   statement_id 로 저장된 판정을 조회한다. 정책 세대가 바뀌었거나 시간 제한 판정이면
+        //   보관한 SQL 로 재평가한다. 등록되지 않은 id 는 서버에 전달하지 않는다.
         // ---------------------------------------------------------------
-        if (cmd.command_type == CommandType::kComStmtPrepare ||
-            cmd.command_type == CommandType::kComStmtExecute ||
-            cmd.command_type == CommandType::kComStmtReset) {
-            spdlog::warn("[session {}] blocking unsupported prepared-statement command: 0x{:02x}",
-                         session_id_,
-                         static_cast<std::uint8_t>(cmd.command_type));
-
-            const auto err_pkt = MysqlPacket::make_error(
-                1235,
-                "Prepared statements are not supported by proxy policy enforcement",
-                static_cast<std::uint8_t>(cmd.sequence_id + 1));
+        if (cmd.command_type == CommandType::kComStmtExecute) {
+            set_state(SessionState::kProcessingQuery);
+            const QueryArena::Scope arena_scope{query_arena_};
+            const auto query_start = std::chrono::steady_clock::now();
 
-            boost::system::error_code wr_ec;
-            const auto err_bytes = err_pkt.serialize();
-            co_await boost::asio::async_write(
-                client_stream_,
-                boost::asio::buffer(err_bytes),
-                boost::asio::redirect_error(boost::asio::use_awaitable, wr_ec));
+            PreparedStatement* const statement = prepared_statements_.find(cmd.statement_id);
+            if (statement == nullptr) {
+                spdlog::warn("[session {}] COM_STMT_EXECUTE for unknown statement {}",
+                             session_id_,
+                             cmd.statement_id);
+                if (!co_await respond_error(
+                        1243,
+                        "Unknown prepared statement handler given to EXECUTE",
+                        static_cast<std::uint8_t>(cmd.sequence_id + 1))) {
+                    break;
+                }
+                set_state(SessionState::kReady);
+                continue;
+            }
 
-            if (wr_ec) {
-                spdlog::warn("[session {}] failed to send prepared-statement rejection: {}",
+            // 커서(COM_STMT_FETCH) 응답은 릴레이 상태 머신이 경계를 판정하지 못한다 (fail-close)
+            if (cmd.execute_flags != 0) {
+                spdlog::warn("[session {}] blocking cursor COM_STMT_EXECUTE (flags=0x{:02x})",
                              session_id_,
-                             wr_ec.message());
+                             cmd.execute_flags);
+                if (!co_await respond_error(
+                        1235,
+                        "Server-side cursors are not supported by proxy policy enforcement",
+                        static_cast<std::uint8_t>(cmd.sequence_id + 1))) {
+                    break;
+                }
+                set_state(SessionState::kReady);
+                continue;
+            }
+
+            const auto eval_start = std::chrono::steady_clock::now();
+            (void)revalidate_statement(
+                *statement, sql_parser_, *policy_, ctx_, &policy_binding_, &query_arena_);
+            stats_->on_latency(LatencyStage::kPolicyEvaluate,
+                               std::chrono::steady_clock::now() - eval_start);
+            const PolicyResult& verdict = statement->verdict.result;
+
+            if (verdict.action == PolicyAction::kBlock || verdict.monitor_mode) {
+                logger_->log_block(BlockLog{
+                    .session_id = session_id_,
+                    .db_user = ctx_.db_user,
+                    .client_ip = ctx_.client_ip,
+                    .raw_sql = statement->sql,
+                    .matched_rule = verdict.matched_rule,
+                    .reason = verdict.reason,
+                    .timestamp = std::chrono::system_clock::now(),
+                    .would_block = verdict.monitor_mode,
+                });
+            }
+            if (verdict.action == PolicyAction::kBlock) {
+                record_query(true);
+                (void)record_top_query(statement->fingerprint, true);
+                stats_->on_rule_block(verdict.matched_rule);
+                if (!co_await respond_error(
+                        1045,
+                        "Access denied by policy",
+                        static_cast<std::uint8_t>(cmd.sequence_id + 1))) {
+                    break;
+                }
+                set_state(SessionState::kReady);
+                continue;
+            }
+            if (verdict.monitor_mode) {
+                stats_->on_monitored_block();
+            }
+            const auto query_end = std::chrono::steady_clock::now();
+            stats_->on_latency(LatencyStage::kProxyOverhead, query_end - query_start);
+
+            const std::uint64_t query_hash = record_top_query(statement->fingerprint, false);
+            if (!co_await forward_and_relay(pkt.raw(), cmd, query_hash)) {
                 break;
             }
 
+            if (log_sampler_.admit(
+                    verdict.action, verdict.query_log, std::chrono::steady_clock::now())) {
+                std::pmr::vector<std::string_view> tables{
+                    statement->tables.begin(), statement->tables.end(), &query_arena_};
+                logger_->log_query(QueryLog{
+                    .session_id = session_id_,
+                    .db_user = ctx_.db_user,
+                    .client_ip = ctx_.client_ip,
+                    .raw_sql = statement->sql,
+                    .command_raw = static_cast<std::uint8_t>(statement->command),
+                    .tables = tables,
+                    .action_raw = static_cast<std::uint8_t>(verdict.action),
+                    .timestamp = std::chrono::system_clock::now(),
+                    .duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                        query_end - query_start),
+                });
+            } else {
+                stats_->on_query_log_suppressed();
+            }
+            record_query(false);
+            set_state(SessionState::kReady);
+            continue;
+        }
+
+        // ---------------------------------------------------------------
+        // COM_STMT_SEND_LONG_DATA / COM_STMT_CLOSE (서버 응답 없음)
+        //   등록된 statement 에 대해서만 전달한다. 미등록 id 는 조용히 버린다
+        //   (서버에 없는 statement 이며 클라이언트도 응답을 기다리지 않는다).
+        // ---------------------------------------------------------------
+        if (cmd.command_type == CommandType::kComStmtSendLongData ||
+            cmd.command_type == CommandType::kComStmtClose) {
+            PreparedStatement* const statement = prepared_statements_.find(cmd.statement_id);
+            const bool forward = statement != nullptr &&
+                                 (cmd.command_type == CommandType::kComStmtClose ||
+                                  statement->verdict.result.action != PolicyAction::kBlock);
+            if (cmd.command_type == CommandType::kComStmtClose) {
+                prepared_statements_.erase(cmd.statement_id);
+            }
+            if (forward) {
+                auto fwd = co_await write_packet_raw(server_stream_, pkt.raw());
+                if (!fwd) {
+                    spdlog::warn("[session {}] failed to forward statement command: {}",
+                                 session_id_,
+                                 fwd.error().message);
+                    break;
+                }
+            }
+            continue;
+        }
+
+        // ---------------------------------------------------------------
+        // COM_STMT_RESET: 등록된 statement 만 전달 (서버 OK/ERR 릴레이)
+        // COM_STMT_FETCH: 커서는 지원하지 않는다 (fail-close)
+        // ---------------------------------------------------------------
+        if ((cmd.command_type == CommandType::kComStmtReset &&
+             prepared_statements_.find(cmd.statement_id) == nullptr) ||
+            cmd.command_type == CommandType::kComStmtFetch) {
+            spdlog::warn("[session {}] rejecting statement command 0x{:02x} (statement {})",
+                         session_id_,
+                         static_cast<std::uint8_t>(cmd.command_type),
+                         cmd.statement_id);
+            const bool fetch = cmd.command_type == CommandType::kComStmtFetch;
+            if (!co_await respond_error(
+                    fetch ? 1235 : 1243,
+                    fetch ? "Server-side cursors are not supported by proxy policy enforcement"
+                          : "Unknown prepared statement handler given to RESET",
+                    static_cast<std::uint8_t>(cmd.sequence_id + 1))) {
+                break;
+            }
             continue;
         }
 
         // ---------------------------------------------------------------
         // 기타 커맨드: 서버로 투명 릴레이 + 응답 클라이언트에 릴레이
+        //   응답 형식을 릴레이 상태 머신만 알므로 파이프라이닝 모드에서도 직렬로 처리한다.
         // ---------------------------------------------------------------
         {
-            auto fwd = co_await write_packet_raw(server_stream_, pkt);
+            if (!co_await drain_responses()) {
+                break;
+            }
+            auto fwd = co_await write_packet_raw(server_stream_, pkt.raw());
             if (!fwd) {
                 spdlog::warn("[session {}] failed to forward command to server: {}",
                              session_id_,
@@ -924,7 +2320,29 @@ auto Session::run() -> boost::asio::awaitable<void> {
     // -----------------------------------------------------------------------
     // 9. 세션 정리
     // -----------------------------------------------------------------------
-    state_ = SessionState::kClosed;
+    // 파이프라이닝 모드: 릴레이 코루틴을 멈추고 종료를 기다린다.
+    //   응답이 남은 채 끝났으면(클라이언트 EOF, 오류) 커맨드 경계가 아니므로 반납하지 않고,
+    //   소켓을 취소해 진행 중인 릴레이를 끝낸다.
+    if (response_pipeline_.enabled()) {
+        if (!response_pipeline_.empty() || response_pipeline_.failed()) {
+            backend_reusable = false;
+            boost::system::error_code cancel_ec;
+            // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+            client_stream_.lowest_layer().cancel(cancel_ec);
+            // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+            server_stream_.lowest_layer().cancel(cancel_ec);
+        }
+        response_pipeline_.stop();
+        co_await response_pipeline_.wait_consumer_done();
+    }
+
+    // 서버 종료 / drain 중이거나 응답 바이트가 남아 있으면(커맨드 경계가 아님) 반납하지 않는다
+    if (backend_reusable && !closing_.load(std::memory_order_acquire) && !draining_ &&
+        server_rx_.readable().empty()) {
+        co_await release_backend();
+    }
+
+    set_state(SessionState::kClosed);
 
     logger_->log_connection(ConnectionLog{
         .session_id = session_id_,
@@ -968,6 +2386,25 @@ void Session::close() {
     }
 }
 
+// ---------------------------------------------------------------------------
+// Session::drain
+// ---------------------------------------------------------------------------
+void Session::drain(std::chrono::milliseconds idle_threshold) {
+    auto self = shared_from_this();
+    boost::asio::post(strand_, [self, idle_threshold]() {
+        if (self->draining_ || self->timers_stopped_ || self->state_ == SessionState::kClosed) {
+            return;
+        }
+        self->draining_ = true;
+        self->drain_idle_ = idle_threshold;
+        if (self->awaiting_command_ && self->idle_timer_ == 0) {
+            // 유휴 타이머가 없으면 idle_since_ 가 갱신되지 않았다: drain 시작부터 센다
+            self->idle_since_ = std::chrono::steady_clock::now();
+        }
+        self->on_drain_check();
+    });
+}
+
 // ---------------------------------------------------------------------------
 // Session::state / context
 // ---------------------------------------------------------------------------
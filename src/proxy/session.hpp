@@ -1,43 +1,57 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ssl/context.hpp>
 #include <boost/asio/strand.hpp>
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "common/async_stream.hpp"
+#include "common/query_arena.hpp"
 #include "common/types.hpp"
 #include "logger/structured_logger.hpp"
-#include "parser/injection_detector.hpp"
 #include "parser/procedure_detector.hpp"
 #include "parser/sql_parser.hpp"
 #include "policy/policy_engine.hpp"
 #include "protocol/command.hpp"
 #include "protocol/handshake.hpp"
 #include "protocol/mysql_packet.hpp"
+#include "protocol/packet_frame_buffer.hpp"
+#include "proxy/admission_control.hpp"
+#include "proxy/backend_pool.hpp"
+#include "proxy/prepared_statement_table.hpp"
+#include "proxy/query_log_sampler.hpp"
+#include "proxy/relay_budget.hpp"
+#include "proxy/response_pipeline.hpp"
+#include "proxy/socket_options.hpp"
+#include "proxy/socket_splice.hpp"
+#include "proxy/timer_wheel.hpp"
+#include "proxy/tls_session_cache.hpp"
+#include "proxy/upstream_set.hpp"
+#include "stats/query_topk.hpp"
+#include "stats/session_registry.hpp"
 #include "stats/stats_collector.hpp"
 
 // ---------------------------------------------------------------------------
-// SessionState
-//   Session 의 생명주기 상태를 나타낸다.
-//
-//   kHandshaking     : MySQL 핸드셰이크 진행 중
-//   kReady           : 핸드셰이크 완료, 커맨드 수신 대기 중
-//   kProcessingQuery : COM_QUERY 처리 중 (정책 판정 / 릴레이 진행 중)
-//   kClosing         : Graceful Shutdown 진행 중 (새 쿼리 거부)
-//   kClosed          : 세션 완전 종료
+// SessionTimeouts
+//   wheel        : 유휴 / 핸드셰이크 제한 시간 타이머 (nullptr 이면 둘 다 적용하지 않음)
+//   idle_timeout : 다음 커맨드를 기다린 시간이 이만큼 되면 세션을 닫는다 (0 = 없음)
+//   keepalive    : 업스트림 소켓 TCP keepalive / TCP_USER_TIMEOUT
+//                  (클라이언트 소켓은 ProxyServer 가 accept 직후 적용)
 // ---------------------------------------------------------------------------
-enum class SessionState : std::uint8_t {
-    kHandshaking = 0,
-    kReady = 1,
-    kProcessingQuery = 2,
-    kClosing = 3,
-    kClosed = 4,
+struct SessionTimeouts {
+    std::shared_ptr<TimerWheel> wheel{};
+    std::chrono::milliseconds idle_timeout{0};
+    TcpKeepalive keepalive{};
 };
 
 // ---------------------------------------------------------------------------
@@ -52,6 +66,11 @@ enum class SessionState : std::uint8_t {
 //   스레드 안전성:
 //     모든 비동기 핸들러는 strand_ 위에서 직렬화되므로 수동 락이 불필요하다.
 //
+//   유휴 타임아웃:
+//     커맨드마다 타이머를 걸지 않는다. 커맨드 대기를 시작한 시각만 기록하고, TimerWheel
+//     만료 시(strand 로 post) 그 시각을 확인해 아직 덜 찼으면 남은 시간만큼 다시 예약한다.
+//     쿼리 처리 중이거나 파이프라인 응답이 남아 있으면 유휴가 아니다.
+//
 //   SSL 지원:
 //     - client_stream: ProxyServer에서 accept 시 TCP 또는 TLS AsyncStream으로
 //       이미 결정되어 생성자에 전달됨.
@@ -72,6 +91,17 @@ public:
     //   policy           : 정책 판정 엔진 (shared 소유권)
     //   logger           : 구조화 로거 (shared 소유권)
     //   stats            : 통계 수집기 (shared 소유권)
+    //   backend_pool     : 백엔드 연결 풀 (nullptr 이면 세션마다 새 연결)
+    //   pipeline_depth   : in-flight 커맨드 상한 (0 = 직렬 처리, ResponsePipeline 참조)
+    //   backend_ssl_ktls : backend TLS 를 KtlsStream 으로 연결 (kernel TLS offload 시도)
+    //   backend_tls_sessions: backend TLS 세션 재개 캐시 (nullptr 이면 매번 전체 핸드셰이크)
+    //   relay_budget     : 릴레이 버퍼 메모리 예산 (nullptr 이면 집계/제한 없음)
+    //   upstream_lease   : UpstreamSet 이 고른 백엔드의 활성 수 점유 + connect 결과 보고
+    //   session_stats    : SessionRegistry 에 등록된 세션 통계 블록 (nullptr 이면 자체 생성)
+    //   admission        : accept 허용 티켓 (핸드셰이크 제한 시간 + pending/IP 슬롯 점유)
+    //   timeouts         : 유휴 / 핸드셰이크 타이머 휠 + 업스트림 keepalive (SessionTimeouts)
+    //   upstream_tuning  : 업스트림 소켓 TCP_NODELAY / 버퍼 크기 / busy poll (connect 전에 적용)
+    //   query_topk       : fingerprint 별 Top-K 집계 (nullptr 이면 집계하지 않음)
     // -----------------------------------------------------------------------
     Session(std::uint64_t session_id,
             AsyncStream client_stream,
@@ -81,7 +111,18 @@ public:
             const std::string& backend_tls_server_name,
             std::shared_ptr<PolicyEngine> policy,
             std::shared_ptr<StructuredLogger> logger,
-            std::shared_ptr<StatsCollector> stats);
+            std::shared_ptr<StatsCollector> stats,
+            std::shared_ptr<BackendPool> backend_pool = nullptr,
+            std::uint32_t pipeline_depth = 0,
+            bool backend_ssl_ktls = false,
+            TlsSessionCache* backend_tls_sessions = nullptr,
+            std::shared_ptr<RelayBudget> relay_budget = nullptr,
+            UpstreamLease upstream_lease = {},
+            std::shared_ptr<SessionStats> session_stats = nullptr,
+            AdmissionTicket admission = {},
+            SessionTimeouts timeouts = {},
+            SocketTuning upstream_tuning = {},
+            std::shared_ptr<QueryTopK> query_topk = nullptr);
 
     ~Session() = default;
 
@@ -109,6 +150,15 @@ public:
     // -----------------------------------------------------------------------
     void close();
 
+    // -----------------------------------------------------------------------
+    // drain
+    //   새 커맨드를 받지 않고 정상 종료한다 (ProxyServer::drain). close() 와 달리 진행 중인
+    //   I/O 를 취소하지 않는다: 처리 중인 커맨드는 응답까지 끝까지 릴레이하고, 커맨드 대기가
+    //   idle_threshold 이상 이어지면 닫는다 (0 = 다음 커맨드 경계에서 바로).
+    //   핸드셰이크 중인 세션은 완료 후 같은 규칙을 따른다. 임의 스레드에서 호출 가능.
+    // -----------------------------------------------------------------------
+    void drain(std::chrono::milliseconds idle_threshold);
+
     // -----------------------------------------------------------------------
     // Accessors
     // -----------------------------------------------------------------------
@@ -126,28 +176,281 @@ private:
     // Backend TLS: nullptr이면 평문 모드, 유효하면 TLS 모드
     boost::asio::ssl::context* backend_ssl_ctx_{nullptr};
     bool backend_ssl_verify_{false};
+    bool backend_ssl_ktls_{false};  // KtlsStream 사용 (kTLS 불가 시 사용자 공간 TLS)
+    TlsSessionCache* backend_tls_sessions_{nullptr};  // ProxyServer 소유 (세션보다 오래 산다)
     std::string backend_tls_server_name_{};
 
     std::shared_ptr<PolicyEngine> policy_;
     std::shared_ptr<StructuredLogger> logger_;
     std::shared_ptr<StatsCollector> stats_;
+    std::shared_ptr<QueryTopK> query_topk_;  // nullable (UDS "top_queries")
+
+    // 연결 풀: pool_key_ 가 있으면 정상 종료 시 서버 연결을 반납할 수 있다
+    std::shared_ptr<BackendPool> backend_pool_;
+    std::optional<BackendPoolKey> pool_key_{};
+    std::uint32_t pool_flags_{0};  // 서버와 협상된 capability (COM_CHANGE_USER 인코딩용)
 
     SessionContext ctx_;
     SessionState state_{SessionState::kHandshaking};
 
+    // 핸드셰이크 후 확정된 user/IP 의 access rule 바인딩 (정책 스냅샷이 바뀌면 lazy 재계산)
+    PolicyBinding policy_binding_{};
+
     // strand: 모든 비동기 핸들러를 직렬화하여 스레드 안전성을 보장한다.
     boost::asio::strand<boost::asio::any_io_executor> strand_;
 
     // parser 멤버 (stateless이므로 재사용)
+    // InjectionDetector 는 PolicyEngine::injection_detector() 로 공유본을 사용한다.
     SqlParser sql_parser_{};
-    InjectionDetector injection_detector_;
     ProcedureDetector proc_detector_{};
 
+    // COM_QUERY 1건의 parse/detect/evaluate scratch (커맨드마다 reset, 블록은 재사용)
+    QueryArena query_arena_{};
+
+    // COM_STMT_PREPARE 판정 저장소 (서버 statement_id → 판정, 세션 수명 동안 유지)
+    PreparedStatementTable prepared_statements_{};
+
+    // 허용 쿼리 QueryLog 샘플링 / 세션별 rate limit (세션 id 로 시드)
+    QueryLogSampler log_sampler_;
+
+    // 파이프라이닝 모드의 in-flight 응답 큐 (비활성이면 커맨드마다 직렬 릴레이)
+    ResponsePipeline response_pipeline_;
+
+    // 방향별 패킷 수신 버퍼 (세션 수명 동안 재사용)
+    //   read_one_packet 이 여기에 직접 읽고 MysqlPacketView 로 해석하며,
+    //   릴레이는 이 바이트를 그대로 전달한다. 패킷마다 할당/복사하지 않는다.
+    std::vector<std::uint8_t> client_buf_{};
+
+    // 서버 응답 스트리밍 수신 버퍼
+    //   소켓이 가진 만큼 한 번에 읽고, 패킷 경계를 걸으며 판정한 완전한 패킷들을
+    //   묶어서 클라이언트에 쓴다. server_pending_ 은 readable 앞쪽의 전달 대기 바이트 수.
+    PacketFrameBuffer server_rx_{};
+    std::size_t server_pending_{0};
+
+    // 큰 응답 패킷 통과 경로 (stream_server_packet)
+    //   streamed_head_: 흘려보낸 패킷의 payload 앞부분 (상태 머신 판정용 사본)
+    //   splice_pipe_  : 양쪽이 소켓 직접 경로(평문/kTLS)일 때 splice(2) 에 쓰는 파이프
+    std::array<std::uint8_t, 16> streamed_head_{};
+    SplicePipe splice_pipe_{};
+
+    // 릴레이 버퍼 메모리 예산 (ProxyServer 와 공유)
+    //   relay_account_: client_buf_ + server_rx_ 의 현재 capacity 를 전체 합계에 반영
+    //                   (relay_budget_ 보다 뒤에 선언 → 먼저 파괴되며 사용량을 돌려준다)
+    std::shared_ptr<RelayBudget> relay_budget_{};
+    RelayBudget::Account relay_account_;
+
+    // 업스트림 백엔드 점유 (세션 소멸 시 해당 백엔드의 활성 수 감소)
+    UpstreamLease upstream_lease_{};
+
+    // 세션 목록용 통계 (상태/카운터는 이 세션 strand 에서만 갱신)
+    std::shared_ptr<SessionStats> session_stats_;
+
+    // accept 허용 티켓 (핸드셰이크 완료 시 pending 슬롯, 세션 소멸 시 IP 슬롯 반환)
+    AdmissionTicket admission_;
+
+    // 유휴 / 핸드셰이크 타이머 (모두 strand 에서만 접근)
+    //   idle_since_       : 커맨드 대기를 시작한 시각 (또는 마지막으로 바빴던 것을 본 시각)
+    //   awaiting_command_ : 커맨드 루프가 클라이언트 읽기에서 기다리는 중
+    //   timers_stopped_   : run() 종료 후 — 이미 꺼낸 휠 콜백이 늦게 도착해도 무시한다
+    SessionTimeouts timeouts_;
+    SocketTuning upstream_tuning_;
+    TimerWheel::TimerId handshake_timer_{0};
+    TimerWheel::TimerId idle_timer_{0};
+    std::chrono::steady_clock::time_point idle_since_{};
+    bool awaiting_command_{false};
+    bool timers_stopped_{false};
+
+    // drain (strand 에서만 접근)
+    //   draining_    : drain() 이 적용됨 — 커맨드 경계 / 유휴 임계치에서 종료, 풀 반납 안 함
+    //   drain_idle_  : 커맨드 대기가 이만큼 이어지면 닫는다
+    //   drain_timer_ : on_drain_check 휠 타이머
+    bool draining_{false};
+    std::chrono::milliseconds drain_idle_{0};
+    TimerWheel::TimerId drain_timer_{0};
+
     // close() 중복 호출 방지용 atomic 플래그
     std::atomic<bool> closing_{false};
 
+    // 업스트림 connect (+ backend TLS). 실패 시 클라이언트에 ERR(err_seq) 후 소켓 정리.
+    auto connect_backend(std::uint8_t err_seq) -> boost::asio::awaitable<bool>;
+
+    // 서버 연결 + MySQL 핸드셰이크 (투명 경로 또는 연결 풀 경로)
+    auto establish_backend() -> boost::asio::awaitable<bool>;
+
+    // COM_RESET_CONNECTION 후 서버 연결을 풀에 반납
+    auto release_backend() -> boost::asio::awaitable<void>;
+
+    [[nodiscard]] auto make_pool_key(const ClientHandshake& client) const -> BackendPoolKey;
+
+    // 클라이언트/서버 소켓을 모두 닫고 kClosed 로 전이
+    void close_streams();
+
+    // 핸드셰이크 제한 시간 만료 (strand). 아직 kHandshaking 이면 소켓을 닫는다.
+    void on_handshake_timeout();
+
+    // 유휴 타이머 만료 (strand). 유휴 시간이 찼으면 닫고, 아니면 남은 시간만큼 다시 예약.
+    void on_idle_check();
+
+    // drain 중 유휴 확인 (strand). 커맨드 대기가 drain_idle_ 를 넘었으면 닫고, 아니면 다시 예약.
+    void on_drain_check();
+
+    // deadline 에 handler 를 세션 strand 로 post 하는 휠 타이머 (세션이 사라졌으면 무시)
+    [[nodiscard]] auto schedule_on_strand(std::chrono::steady_clock::time_point deadline,
+                                          void (Session::*handler)()) -> TimerWheel::TimerId;
+
+    // 남은 휠 타이머 취소 (run() 종료 시)
+    void cancel_timers() noexcept;
+
     // relay_server_response 헬퍼
     //   MySQL 서버 응답(Result Set / OK / ERR)이 완료될 때까지 읽어 클라이언트에 릴레이.
-    auto relay_server_response(CommandType request_type, std::uint8_t request_seq_id)
+    //   prepared_statement_id: COM_STMT_PREPARE_OK 를 받으면 서버 statement_id 를 기록
+    //                          (ERR 응답이면 그대로 nullopt).
+    auto relay_server_response(CommandType request_type,
+                               std::uint8_t request_seq_id,
+                               std::optional<std::uint32_t>* prepared_statement_id = nullptr)
+        -> boost::asio::awaitable<std::expected<void, ParseError>>;
+
+    // -----------------------------------------------------------------------
+    // 응답 릴레이 (스트림 타입 특화)
+    //   relay_server_response 가 응답 하나마다 server_stream_ / client_stream_ 의 실제 타입
+    //   (tcp::socket / ssl::stream / KtlsStream)을 한 번 확인하고, 아래 함수들은 그 구체
+    //   타입으로 인스턴스화된다. 응답 안의 패킷별 읽기/쓰기에는 variant 분기가 없다.
+    //   (세션 단위로 고정하지 않는 이유: 연결 풀 반납/재연결로 server_stream_ 이 교체된다)
+    // -----------------------------------------------------------------------
+    template <typename ServerStream, typename ClientStream>
+    struct RelayStreams {
+        ServerStream& server;
+        ClientStream& client;
+    };
+
+    // 응답 릴레이 + 남은 전달 대기 패킷 flush
+    template <typename Streams>
+    auto relay_response(Streams streams,
+                        CommandType request_type,
+                        std::uint8_t request_seq_id,
+                        std::optional<std::uint32_t>* prepared_statement_id)
+        -> boost::asio::awaitable<std::expected<void, ParseError>>;
+
+    // 응답 상태 머신. SERVER_MORE_RESULTS_EXISTS 를 따라 결과마다 relay_result_packets 반복.
+    //   전송은 flush_server_pending 이 묶어서 수행.
+    template <typename Streams>
+    auto relay_response_packets(Streams streams,
+                                CommandType request_type,
+                                std::uint8_t request_seq_id,
+                                std::optional<std::uint32_t>* prepared_statement_id)
+        -> boost::asio::awaitable<std::expected<void, ParseError>>;
+
+    // 결과 하나 (column-def / row / EOF). 반환: 다음 결과가 이어지는지 (MORE_RESULTS)
+    template <typename Streams>
+    auto relay_result_packets(Streams streams,
+                              CommandType request_type,
+                              std::optional<std::uint32_t>* prepared_statement_id)
+        -> boost::asio::awaitable<std::expected<bool, ParseError>>;
+
+    // 클라이언트에 ERR 패킷 전송. 쓰기 실패 시 false (세션 종료).
+    auto send_client_error(std::uint16_t code, std::string_view message, std::uint8_t seq)
+        -> boost::asio::awaitable<bool>;
+
+    // -----------------------------------------------------------------------
+    // 응답 경로 (직렬 / 파이프라이닝 공통)
+    //   파이프라이닝 모드에서는 응답을 response_pipeline_ 에 넣고 바로 반환하며,
+    //   relay_pipelined_responses 가 순서대로 클라이언트에 보낸다. false 면 세션 종료.
+    // -----------------------------------------------------------------------
+
+    // 프록시가 만든 ERR 로 응답 (서버에 전달하지 않은 커맨드)
+    auto respond_error(std::uint16_t code, std::string_view message, std::uint8_t seq)
+        -> boost::asio::awaitable<bool>;
+
+    // 커맨드를 서버에 전달하고 응답을 릴레이 (파이프라이닝: 전달 후 큐에 등록)
+    //   query_hash: 릴레이 완료 시 업스트림 지연을 귀속할 QueryTopK 해시 (0 = 없음)
+    auto forward_and_relay(std::span<const std::uint8_t> raw,
+                           const CommandPacket& cmd,
+                           std::uint64_t query_hash = 0) -> boost::asio::awaitable<bool>;
+
+    // 앞선 응답이 모두 끝날 때까지 대기 (직렬로 처리해야 하는 커맨드 앞)
+    auto drain_responses() -> boost::asio::awaitable<bool>;
+
+    // 파이프라이닝 모드의 릴레이 코루틴 (response_pipeline_ 소비자)
+    auto relay_pipelined_responses() -> boost::asio::awaitable<void>;
+
+    // COM_STMT_PREPARE 응답의 param/column definition 구간 릴레이
+    template <typename Streams>
+    auto relay_stmt_prepare_section(Streams streams, std::uint16_t count)
+        -> boost::asio::awaitable<std::expected<void, ParseError>>;
+
+    // server_rx_ 에 이미 완전히 수신된 다음 패킷을 코루틴 없이 꺼낸다 (없으면 nullopt).
+    //   패킷마다 도는 릴레이 루프는 이것을 먼저 시도하고, 수신/전달이 필요할 때만
+    //   next_server_packet 을 co_await 한다 (버퍼에 쌓인 row 마다 코루틴 프레임을 만들지 않음).
+    auto take_buffered_server_packet() noexcept -> std::optional<FrameHead>;
+
+    // server_rx_ 에서 다음 패킷의 헤더/앞부분을 얻는다 (필요 시 대기 중인 패킷을 먼저 전달 후 수신)
+    //   작은 패킷은 전체가 prefix 로 담기고 (complete), 큰 패킷은 stream_server_packet 으로
+    //   본문을 바로 흘려보낸 뒤 앞부분만 담긴다.
+    template <typename Streams>
+    auto next_server_packet(Streams streams)
+        -> boost::asio::awaitable<std::expected<FrameHead, ParseError>>;
+
+    // 큰 패킷 본문을 버퍼에 모으지 않고 클라이언트로 전달 (평문/kTLS 면 splice, 그 외 청크 복사)
+    template <typename Streams>
+    auto stream_server_packet(Streams streams, FrameHead head)
+        -> boost::asio::awaitable<std::expected<FrameHead, ParseError>>;
+
+    // 다음 서버 패킷을 전달 대기열에 넣지 않고 확인 (작은 패킷은 완전히, 큰 패킷은 앞부분)
+    template <typename Streams>
+    auto peek_server_packet(Streams streams)
+        -> boost::asio::awaitable<std::expected<FrameHead, ParseError>>;
+
+    // 서버에서 최대 max_bytes 를 server_rx_ 로 1회 수신
+    template <typename Streams>
+    auto read_server_chunk(Streams streams, std::size_t max_bytes)
+        -> boost::asio::awaitable<std::expected<std::size_t, ParseError>>;
+
+    // -----------------------------------------------------------------------
+    // 결과 셋 row 수 한도 (data_protection.max_result_rows)
+    //   한도를 넘는 첫 row 를 클라이언트에 보내기 전에 결과 셋을 ERR / EOF 로 끝내고,
+    //   서버의 나머지 응답 (MORE_RESULTS 로 이어지는 결과 셋 포함) 은 버퍼에 모으지 않고
+    //   끝까지 읽어 버린다. 응답 경계를 잃으면 오류 (서버 연결을 풀에 반납하지 않음).
+    // -----------------------------------------------------------------------
+    template <typename Streams>
+    auto end_result_set_at_limit(Streams streams,
+                                 PolicyEngine::ResultRowLimit limit,
+                                 std::uint8_t seq,
+                                 std::uint16_t metadata_status,
+                                 CommandType request_type,
+                                 std::uint8_t column_count)
+        -> boost::asio::awaitable<std::expected<void, ParseError>>;
+
+    template <typename Streams>
+    auto discard_remaining_results(Streams streams,
+                                   CommandType request_type,
+                                   std::uint8_t column_count)
+        -> boost::asio::awaitable<std::expected<std::uint64_t, ParseError>>;
+
+    // -----------------------------------------------------------------------
+    // 릴레이 버퍼 메모리 예산 (RelayBudget)
+    //   sync_relay_memory : 버퍼 capacity 변화를 relay_account_ 에 반영 (변화 없으면 no-op)
+    //   trim_client_buffer: 커맨드 사이 (run 루프, 다음 패킷 읽기 전) client_buf_ 해제
+    //   trim_server_buffer: 응답 릴레이 끝 (relay_response) server_rx_ 해제
+    //     세션 상한을 넘으면 기본 크기를 넘는 버퍼를, 전체 상한을 넘으면 버퍼 전부를 해제한다.
+    //     server_rx_ 는 릴레이 코루틴만 건드린다 (파이프라이닝 중 run 루프가 해제하지 않음).
+    //   wait_for_relay_budget: 전체 상한 초과 중에 버퍼를 키워야 하는 서버 읽기 전 대기
+    // -----------------------------------------------------------------------
+    void sync_relay_memory() noexcept;
+
+    // state_ 갱신 + session_stats_ 게시
+    void set_state(SessionState state) noexcept;
+
+    // StatsCollector / SessionStats 양쪽에 COM_QUERY 판정 1건 반영
+    void record_query(bool blocked) noexcept;
+    // QueryTopK 에 판정 1건 반영. 반환: 지연 귀속용 해시 (fingerprint 가 없거나 비활성이면 0)
+    [[nodiscard]] std::uint64_t record_top_query(std::string_view fingerprint, bool blocked);
+    [[nodiscard]] bool relay_over_budget() const noexcept;
+    void trim_client_buffer() noexcept;
+    void trim_server_buffer() noexcept;
+    auto wait_for_relay_budget() -> boost::asio::awaitable<void>;
+
+    // 전달 대기 중인 서버 패킷들을 한 번의 쓰기로 클라이언트에 전송
+    template <typename Streams>
+    auto flush_server_pending(Streams streams)
         -> boost::asio::awaitable<std::expected<void, ParseError>>;
 };
@@ -0,0 +1,120 @@
+// ---------------------------------------------------------------------------
+// socket_options.cpp
+// ---------------------------------------------------------------------------
+
+#include "proxy/socket_options.hpp"
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+namespace {
+
+bool set_int_option(int fd, int level, int name, int value) noexcept {
+    return ::setsockopt(fd, level, name, &value, sizeof(value)) == 0;
+}
+
+int clamp_int(std::uint32_t value) noexcept {
+    constexpr std::uint32_t kMax = 0x7FFFFFFFU;
+    return static_cast<int>(value > kMax ? kMax : value);
+}
+
+auto apply_buffer_sizes(int fd, std::uint32_t recv_bytes, std::uint32_t send_bytes) noexcept
+    -> std::expected<void, std::string_view> {
+    if (recv_bytes != 0 && !set_int_option(fd, SOL_SOCKET, SO_RCVBUF, clamp_int(recv_bytes))) {
+        return std::unexpected(std::string_view{"SO_RCVBUF"});
+    }
+    if (send_bytes != 0 && !set_int_option(fd, SOL_SOCKET, SO_SNDBUF, clamp_int(send_bytes))) {
+        return std::unexpected(std::string_view{"SO_SNDBUF"});
+    }
+    return {};
+}
+
+}  // namespace
+
+auto apply_tcp_keepalive(boost::asio::ip::tcp::socket& socket,
+                         const TcpKeepalive& options) noexcept
+    -> std::expected<void, std::string_view> {
+    if (!options.any() || !socket.is_open()) {
+        return {};
+    }
+    const int fd = socket.native_handle();
+
+    if (options.idle_sec != 0) {
+        if (!set_int_option(fd, SOL_SOCKET, SO_KEEPALIVE, 1)) {
+            return std::unexpected(std::string_view{"SO_KEEPALIVE"});
+        }
+#if defined(__linux__)
+        if (!set_int_option(fd, IPPROTO_TCP, TCP_KEEPIDLE, clamp_int(options.idle_sec))) {
+            return std::unexpected(std::string_view{"TCP_KEEPIDLE"});
+        }
+        if (options.interval_sec != 0 &&
+            !set_int_option(fd, IPPROTO_TCP, TCP_KEEPINTVL, clamp_int(options.interval_sec))) {
+            return std::unexpected(std::string_view{"TCP_KEEPINTVL"});
+        }
+        if (options.probes != 0 &&
+            !set_int_option(fd, IPPROTO_TCP, TCP_KEEPCNT, clamp_int(options.probes))) {
+            return std::unexpected(std::string_view{"TCP_KEEPCNT"});
+        }
+#endif
+    }
+
+#if defined(__linux__) && defined(TCP_USER_TIMEOUT)
+    if (options.user_timeout_ms != 0 &&
+        !set_int_option(fd, IPPROTO_TCP, TCP_USER_TIMEOUT, clamp_int(options.user_timeout_ms))) {
+        return std::unexpected(std::string_view{"TCP_USER_TIMEOUT"});
+    }
+#endif
+    return {};
+}
+
+auto apply_socket_tuning(boost::asio::ip::tcp::socket& socket,
+                         const SocketTuning& options) noexcept
+    -> std::expected<void, std::string_view> {
+    if (!socket.is_open()) {
+        return {};
+    }
+    const int fd = socket.native_handle();
+
+    if (options.no_delay && !set_int_option(fd, IPPROTO_TCP, TCP_NODELAY, 1)) {
+        return std::unexpected(std::string_view{"TCP_NODELAY"});
+    }
+    if (auto buffers = apply_buffer_sizes(fd, options.recv_buffer_bytes, options.send_buffer_bytes);
+        !buffers) {
+        return buffers;
+    }
+#if defined(__linux__) && defined(SO_BUSY_POLL)
+    if (options.busy_poll_us != 0 &&
+        !set_int_option(fd, SOL_SOCKET, SO_BUSY_POLL, clamp_int(options.busy_poll_us))) {
+        return std::unexpected(std::string_view{"SO_BUSY_POLL"});
+    }
+#endif
+    return {};
+}
+
+auto apply_listener_tuning(boost::asio::ip::tcp::acceptor& acceptor,
+                           const ListenerTuning& options) noexcept
+    -> std::expected<void, std::string_view> {
+    if (!acceptor.is_open()) {
+        return {};
+    }
+    const int fd = acceptor.native_handle();
+
+    if (auto buffers = apply_buffer_sizes(fd, options.recv_buffer_bytes, options.send_buffer_bytes);
+        !buffers) {
+        return buffers;
+    }
+#if defined(__linux__)
+    if (options.defer_accept_sec != 0 &&
+        !set_int_option(fd, IPPROTO_TCP, TCP_DEFER_ACCEPT, clamp_int(options.defer_accept_sec))) {
+        return std::unexpected(std::string_view{"TCP_DEFER_ACCEPT"});
+    }
+#endif
+#if defined(TCP_FASTOPEN)
+    if (options.fastopen_queue != 0 &&
+        !set_int_option(fd, IPPROTO_TCP, TCP_FASTOPEN, clamp_int(options.fastopen_queue))) {
+        return std::unexpected(std::string_view{"TCP_FASTOPEN"});
+    }
+#endif
+    return {};
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// socket_options.hpp
+//
+// 클라이언트 / 업스트림 TCP 소켓과 리스너 옵션 적용.
+//
+// [설계 의도]
+// 유휴 타임아웃(TimerWheel)은 프록시가 보기에 조용한 세션을 닫지만, 상대가 사라진 연결
+// (NAT 만료, 케이블 단절, 죽은 풀 연결)은 읽기가 영원히 끝나지 않아 자원을 붙잡는다.
+// TCP keepalive 와 TCP_USER_TIMEOUT 으로 커널이 죽은 연결을 찾아 오류로 끝내게 한다.
+//
+// 릴레이는 작은 패킷(OK, EOF, 짧은 결과 셋)을 주고받는 요청-응답 구조라 Nagle 이 켜져 있으면
+// 앞선 세그먼트의 ACK 를 기다리는 지연(delayed ACK 와 겹치면 수십 ms)이 생긴다. TCP_NODELAY
+// 는 기본으로 켠다. 버퍼 크기 / busy poll / defer accept / fast open 은 환경별로 효과가 달라
+// 모두 opt-in 이다 (SocketTuning, ListenerTuning).
+//
+// [적용 시점]
+// SO_RCVBUF 는 SYN 에서 window scale 을 정하므로 연결 전에 설정해야 한다.
+//   - 클라이언트 구간: 리스너에 설정 → accept 된 소켓이 물려받는다 (listen() 전에 적용)
+//   - 업스트림 구간 : open() 후 connect 전에 설정
+//
+// [실패 처리]
+// 옵션은 보조 수단이다. 설정 실패는 해당 옵션 이름을 돌려주고, 호출자는 경고만 남긴 채
+// 연결을 계속 쓴다. Linux 전용 옵션은 다른 플랫폼에서 건너뛴다.
+// ---------------------------------------------------------------------------
+
+#include <boost/asio/ip/tcp.hpp>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+
+// ---------------------------------------------------------------------------
+// TcpKeepalive
+//   idle_sec        : 마지막 수신 후 첫 probe 까지 (초, 0 = keepalive 끔)
+//   interval_sec    : probe 간격 (초, 0 = 커널 기본값)
+//   probes          : 응답 없는 probe 몇 개에 끊을지 (0 = 커널 기본값)
+//   user_timeout_ms : 보낸 데이터가 ACK 없이 머무를 수 있는 시간 (TCP_USER_TIMEOUT,
+//                     0 = 커널 기본값). keepalive 와 같이 쓰면 probe 실패에도 적용된다.
+// ---------------------------------------------------------------------------
+struct TcpKeepalive {
+    std::uint32_t idle_sec{0};
+    std::uint32_t interval_sec{0};
+    std::uint32_t probes{0};
+    std::uint32_t user_timeout_ms{0};
+
+    [[nodiscard]] bool any() const noexcept { return idle_sec != 0 || user_timeout_ms != 0; }
+};
+
+// ---------------------------------------------------------------------------
+// SocketTuning  (연결 소켓)
+//   no_delay           : TCP_NODELAY (Nagle 끔)
+//   recv_buffer_bytes  : SO_RCVBUF (0 = 커널 자동 조정)
+//   send_buffer_bytes  : SO_SNDBUF (0 = 커널 자동 조정)
+//   busy_poll_us       : SO_BUSY_POLL — 블로킹 읽기 시 NIC 큐를 바쁜 대기로 확인할 시간
+//                        (µs, 0 = 끔). net.core.busy_read 보다 크게 잡으려면 CAP_NET_ADMIN.
+//   버퍼 크기를 직접 정하면 커널 자동 조정이 꺼진다 (net.core.rmem_max / wmem_max 로 상한).
+// ---------------------------------------------------------------------------
+struct SocketTuning {
+    bool no_delay{true};
+    std::uint32_t recv_buffer_bytes{0};
+    std::uint32_t send_buffer_bytes{0};
+    std::uint32_t busy_poll_us{0};
+};
+
+// ---------------------------------------------------------------------------
+// ListenerTuning  (리스너 소켓, listen() 전에 적용)
+//   recv_buffer_bytes / send_buffer_bytes : accept 된 소켓이 물려받는 버퍼 크기 (0 = 자동)
+//   defer_accept_sec : TCP_DEFER_ACCEPT — 첫 데이터가 올 때까지 accept 를 미룬다 (0 = 끔).
+//                      클라이언트가 먼저 보내는 TLS 구간에서만 의미가 있다. 평문 MySQL 은
+//                      서버 greeting 이 먼저이므로 모든 연결이 이 시간만큼 늦어진다.
+//   fastopen_queue   : TCP_FASTOPEN 대기 큐 길이 (0 = 끔, net.ipv4.tcp_fastopen 서버 비트 필요)
+// ---------------------------------------------------------------------------
+struct ListenerTuning {
+    std::uint32_t recv_buffer_bytes{0};
+    std::uint32_t send_buffer_bytes{0};
+    std::uint32_t defer_accept_sec{0};
+    std::uint32_t fastopen_queue{0};
+};
+
+// 실패 시 설정하지 못한 옵션 이름 ("SO_KEEPALIVE", "TCP_KEEPIDLE", ...)
+[[nodiscard]] auto apply_tcp_keepalive(boost::asio::ip::tcp::socket& socket,
+                                       const TcpKeepalive& options) noexcept
+    -> std::expected<void, std::string_view>;
+
+// 열린 소켓에 적용 (연결 전/후 모두 가능, 버퍼 크기는 연결 전이어야 window 에 반영된다).
+// 실패 시 설정하지 못한 옵션 이름 ("TCP_NODELAY", "SO_RCVBUF", "SO_BUSY_POLL", ...)
+[[nodiscard]] auto apply_socket_tuning(boost::asio::ip::tcp::socket& socket,
+                                       const SocketTuning& options) noexcept
+    -> std::expected<void, std::string_view>;
+
+// 열린(bind/listen 전) 리스너에 적용. 실패 시 설정하지 못한 옵션 이름
+[[nodiscard]] auto apply_listener_tuning(boost::asio::ip::tcp::acceptor& acceptor,
+                                         const ListenerTuning& options) noexcept
+    -> std::expected<void, std::string_view>;
@@ -0,0 +1,141 @@
+// ---------------------------------------------------------------------------
+// socket_splice.cpp
+//
+// splice(2) 기반 소켓 간 전달. 비 Linux 빌드에서는 SplicePipe::open() 이 항상 false 이므로
+// splice_bytes 는 호출되지 않는다 (호출되면 kMalformedPacket).
+// ---------------------------------------------------------------------------
+
+#include "proxy/socket_splice.hpp"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/error_code.hpp>
+#include <cerrno>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace {
+
+// splice 1회 최대 전달량 (기본 파이프 용량 64KB 와 같음)
+constexpr std::size_t kSpliceChunk = 64U * 1024U;
+
+auto splice_error(std::string message, int err) -> std::unexpected<ParseError> {
+    return std::unexpected(ParseError{.code = ParseErrorCode::kMalformedPacket,
+                                      .message = std::move(message),
+                                      .context = std::generic_category().message(err)});
+}
+
+}  // namespace
+
+SplicePipe::~SplicePipe() {
+#if defined(__linux__)
+    for (const int fd : fds_) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+#endif
+}
+
+bool SplicePipe::open() noexcept {
+    if (fds_[0] >= 0) {
+        return true;
+    }
+    if (unavailable_) {
+        return false;
+    }
+#if defined(__linux__)
+    if (::pipe2(fds_, O_NONBLOCK | O_CLOEXEC) == 0) {
+        return true;
+    }
+    fds_[0] = -1;
+    fds_[1] = -1;
+#endif
+    unavailable_ = true;
+    return false;
+}
+
+auto splice_bytes(boost::asio::ip::tcp::socket& from,
+                  boost::asio::ip::tcp::socket& to,
+                  SplicePipe& pipe,
+                  std::size_t n) -> boost::asio::awaitable<std::expected<void, ParseError>> {
+#if defined(__linux__)
+    boost::system::error_code ec;
+    from.native_non_blocking(true, ec);
+    if (!ec) {
+        to.native_non_blocking(true, ec);
+    }
+    if (ec) {
+        co_return std::unexpected(ParseError{.code = ParseErrorCode::kMalformedPacket,
+                                             .message = "failed to set non-blocking socket",
+                                             .context = ec.message()});
+    }
+
+    std::size_t remaining = n;
+    while (remaining > 0) {
+        // 1. server socket → pipe
+        const ssize_t in = ::splice(from.native_handle(),
+                                    nullptr,
+                                    pipe.write_fd(),
+                                    nullptr,
+                                    std::min(remaining, kSpliceChunk),
+                                    SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (in == 0) {
+            co_return splice_error("connection closed during passthrough", ECONNRESET);
+        }
+        if (in < 0) {
+            if (errno != EAGAIN && errno != EINTR) {
+                co_return splice_error("failed to splice from socket", errno);
+            }
+            co_await from.async_wait(boost::asio::ip::tcp::socket::wait_read,
+                                     boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+            if (ec) {
+                co_return std::unexpected(ParseError{.code = ParseErrorCode::kMalformedPacket,
+                                                     .message = "failed to read packet payload",
+                                                     .context = ec.message()});
+            }
+            continue;
+        }
+
+        // 2. pipe → client socket (파이프에 든 만큼 모두 비운다)
+        auto left = static_cast<std::size_t>(in);
+        while (left > 0) {
+            const ssize_t out = ::splice(pipe.read_fd(),
+                                         nullptr,
+                                         to.native_handle(),
+                                         nullptr,
+                                         left,
+                                         SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+            if (out < 0) {
+                if (errno != EAGAIN && errno != EINTR) {
+                    co_return splice_error("failed to splice to socket", errno);
+                }
+                co_await to.async_wait(boost::asio::ip::tcp::socket::wait_write,
+                                       boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+                if (ec) {
+                    co_return std::unexpected(ParseError{.code = ParseErrorCode::kMalformedPacket,
+                                                         .message = "failed to write packet",
+                                                         .context = ec.message()});
+                }
+                continue;
+            }
+            left -= static_cast<std::size_t>(out);
+        }
+        remaining -= static_cast<std::size_t>(in);
+    }
+    co_return std::expected<void, ParseError>{};
+#else
+    (void)from;
+    (void)to;
+    (void)pipe;
+    (void)n;
+    co_return splice_error("splice is not supported on this platform", ENOSYS);
+#endif
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// socket_splice.hpp
+//
+// 소켓 간 바이트 구간 전달 (Linux splice(2), 평문 또는 kTLS 소켓).
+//
+// [설계 의도]
+// 서버 응답의 큰 패킷(BLOB row 등)은 릴레이 판정에 헤더와 payload 앞 몇 바이트만
+// 필요하다. 나머지 본문은 사용자 공간 버퍼를 거치지 않고 커널 안에서
+// server socket → pipe → client socket 으로 옮긴다 (복사/버퍼 성장 없음).
+//
+// [제약]
+// - 소켓에 평문을 직접 읽고 쓸 수 있을 때만 사용한다: 평문 TCP, 또는 해당 방향 kTLS 가
+//   활성인 KtlsStream (AsyncStream::kernel_recv / kernel_send). 사용자 공간 TLS 구간은
+//   호출자가 복사 경로를 쓴다.
+// - 파이프는 첫 사용 시 만들고 세션 수명 동안 재사용한다. 만들 수 없거나
+//   Linux 가 아니면 open() 이 false 를 반환한다.
+// - 소켓은 splice 중 non-blocking 이어야 하며, would-block 은 asio async_wait 로 대기한다.
+//
+// [스레드 안전성]
+// 세션 strand 위에서만 사용한다.
+// ---------------------------------------------------------------------------
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <cstddef>
+#include <expected>
+
+#include "common/types.hpp"
+
+class SplicePipe {
+public:
+    SplicePipe() = default;
+    ~SplicePipe();
+
+    SplicePipe(const SplicePipe&) = delete;
+    SplicePipe& operator=(const SplicePipe&) = delete;
+    SplicePipe(SplicePipe&&) = delete;
+    SplicePipe& operator=(SplicePipe&&) = delete;
+
+    // open: 파이프를 준비한다 (이미 열려 있으면 true). 실패는 기억하여 다시 시도하지 않는다.
+    [[nodiscard]] bool open() noexcept;
+
+    [[nodiscard]] int read_fd() const noexcept { return fds_[0]; }
+    [[nodiscard]] int write_fd() const noexcept { return fds_[1]; }
+
+private:
+    int fds_[2]{-1, -1};  // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+    bool unavailable_{false};
+};
+
+// ---------------------------------------------------------------------------
+// splice_bytes
+//   from 에서 정확히 n 바이트를 읽어 to 로 보낸다. pipe 는 open() 이 성공한 상태여야 한다.
+//   n 바이트 전에 from 이 닫히거나 오류가 나면 kMalformedPacket.
+//   전달한 바이트는 읽기/쓰기 양쪽 모두 완료된 상태로 반환한다 (파이프에 남기지 않음).
+// ---------------------------------------------------------------------------
+auto splice_bytes(boost::asio::ip::tcp::socket& from,
+                  boost::asio::ip::tcp::socket& to,
+                  SplicePipe& pipe,
+                  std::size_t n) -> boost::asio::awaitable<std::expected<void, ParseError>>;
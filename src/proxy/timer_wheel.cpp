@@ -0,0 +1,127 @@
+// ---------------------------------------------------------------------------
+// timer_wheel.cpp
+// ---------------------------------------------------------------------------
+
+#include "proxy/timer_wheel.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+constexpr std::uint64_t kSlotMask = TimerWheel::kSlots - 1;
+
+// level 단계 한 칸이 덮는 tick 수 (256^level)
+constexpr std::uint64_t level_span(std::size_t level) noexcept {
+    return std::uint64_t{1} << (TimerWheel::kSlotBits * level);
+}
+
+}  // namespace
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, Clock::time_point origin)
+    : tick_{std::max(tick, std::chrono::milliseconds{1})}, origin_{origin} {}
+
+TimerWheel::TimerId TimerWheel::schedule(Clock::time_point deadline, Callback callback) {
+    // 올림: deadline 보다 일찍 실행되지 않도록
+    const auto offset = deadline - origin_;
+    std::uint64_t expire_tick = 0;
+    if (offset.count() > 0) {
+        const auto ticks = (offset + tick_ - Clock::duration{1}) / tick_;
+        expire_tick = static_cast<std::uint64_t>(ticks);
+    }
+
+    const std::lock_guard lock{mu_};
+    const TimerId id = next_id_++;
+    expire_tick = std::max(expire_tick, current_tick_ + 1);
+    entries_.emplace(id, Entry{.expire_tick = expire_tick, .callback = std::move(callback)});
+    place(id, expire_tick);
+    return id;
+}
+
+bool TimerWheel::cancel(TimerId id) noexcept {
+    if (id == 0) {
+        return false;
+    }
+    const std::lock_guard lock{mu_};
+    return entries_.erase(id) > 0;
+}
+
+std::size_t TimerWheel::advance(Clock::time_point now) {
+    const auto offset = now - origin_;
+    if (offset.count() <= 0) {
+        return 0;
+    }
+    const auto target = static_cast<std::uint64_t>(offset / tick_);
+
+    std::vector<Callback> expired;
+    {
+        const std::lock_guard lock{mu_};
+        while (current_tick_ < target) {
+            ++current_tick_;
+            // 하위 단계가 한 바퀴 돌 때마다 상위 단계 한 칸을 내린다 (상위부터)
+            for (std::size_t level = kLevels - 1; level > 0; --level) {
+                if ((current_tick_ & (level_span(level) - 1)) == 0) {
+                    cascade(level);
+                }
+            }
+
+            auto& slot = slots_[0][current_tick_ & kSlotMask];
+            std::vector<TimerId> ids;
+            ids.swap(slot);
+            for (const TimerId id : ids) {
+                const auto it = entries_.find(id);
+                if (it == entries_.end()) {
+                    continue;  // 취소됨
+                }
+                if (it->second.expire_tick > current_tick_) {
+                    place(id, it->second.expire_tick);  // 범위 밖에서 내려온 항목
+                    continue;
+                }
+                expired.push_back(std::move(it->second.callback));
+                entries_.erase(it);
+            }
+            if (slot.empty()) {
+                ids.clear();
+                slot.swap(ids);  // 슬롯 vector 용량 재사용
+            }
+        }
+    }
+
+    for (auto& callback : expired) {
+        if (callback) {
+            callback();
+        }
+    }
+    return expired.size();
+}
+
+std::size_t TimerWheel::size() const noexcept {
+    const std::lock_guard lock{mu_};
+    return entries_.size();
+}
+
+void TimerWheel::place(TimerId id, std::uint64_t expire_tick) {
+    const std::uint64_t delta = expire_tick - current_tick_;
+    for (std::size_t level = 0; level < kLevels; ++level) {
+        if (delta < level_span(level + 1)) {
+            const auto index = (expire_tick >> (kSlotBits * level)) & kSlotMask;
+            slots_[level][index].push_back(id);
+            return;
+        }
+    }
+    // 최상위 범위 초과: 최상위 단계에서 가장 먼 칸 (내려올 때 다시 배치)
+    const auto index = ((current_tick_ >> (kSlotBits * (kLevels - 1))) - 1) & kSlotMask;
+    slots_[kLevels - 1][index].push_back(id);
+}
+
+void TimerWheel::cascade(std::size_t level) {
+    auto& slot = slots_[level][(current_tick_ >> (kSlotBits * level)) & kSlotMask];
+    std::vector<TimerId> ids;
+    ids.swap(slot);
+    for (const TimerId id : ids) {
+        const auto it = entries_.find(id);
+        if (it != entries_.end()) {
+            place(id, it->second.expire_tick);
+        }
+    }
+}
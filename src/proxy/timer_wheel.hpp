@@ -0,0 +1,92 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// timer_wheel.hpp
+//
+// 세션 유휴 / 핸드셰이크 제한 시간용 계층형 타이밍 휠.
+//
+// [설계 의도]
+// 세션마다 읽기 직전에 steady_timer 를 걸고 풀면 커맨드마다 타이머 큐(heap) 삽입/삭제와
+// 취소 핸들러 post 가 생긴다. 1만 세션 규모에서는 이 비용이 릴레이 경로에 그대로 더해진다.
+// 대신 프로세스에 휠 하나를 두고 ProxyServer 가 tick 주기로 advance() 를 호출한다.
+//   - schedule / cancel : O(1) (슬롯 vector push + id 표 삽입/삭제)
+//   - advance           : 지난 tick 수 + 만료 항목 수에 비례
+// 세션은 활동할 때마다 다시 예약하지 않는다. 만료 시점에 마지막 활동 시각을 확인하고,
+// 아직 유휴 시간이 덜 찼으면 남은 시간만큼 한 번 다시 예약한다 (Session::on_idle_check).
+//
+// [구조]
+// kLevels(3) 단계 x kSlots(256) 슬롯. tick 이 100ms 이면 단계별 범위는
+// 25.6초 / 약 1.8시간 / 약 19일이다. 범위를 넘는 만료는 최상위 마지막 슬롯에 두었다가
+// 내려올 때 다시 배치한다. 상위 단계 슬롯은 하위 단계가 한 바퀴 돌 때 한 칸 내려온다.
+// 취소는 id 표에서만 지우고 슬롯의 id 는 그 슬롯을 처리할 때 건너뛴다.
+//
+// [스레드 안전성]
+// 모든 메서드는 임의 스레드에서 호출할 수 있다 (mutex 하나). 콜백은 advance() 를 호출한
+// 스레드에서 락 밖에서 실행되므로, 세션 상태를 만지는 콜백은 세션 strand 로 post 해야 한다.
+// ---------------------------------------------------------------------------
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = std::uint64_t;  // 0 = 없음
+    using Callback = std::function<void()>;
+
+    static constexpr std::size_t kLevels = 3;
+    static constexpr std::size_t kSlotBits = 8;
+    static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+    static constexpr std::chrono::milliseconds kDefaultTick{100};
+
+    explicit TimerWheel(std::chrono::milliseconds tick = kDefaultTick,
+                        Clock::time_point origin = Clock::now());
+    ~TimerWheel() = default;
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+
+    // deadline 이후 첫 advance() 에서 callback 실행 (지난 시각이면 다음 tick).
+    // 반환된 id 로 cancel 한다.
+    [[nodiscard]] TimerId schedule(Clock::time_point deadline, Callback callback);
+
+    // 아직 실행되지 않았으면 취소하고 true. 이미 실행됐거나 없는 id 면 false.
+    bool cancel(TimerId id) noexcept;
+
+    // now 까지 tick 을 진행하고 만료된 콜백을 실행한다. 실행한 콜백 수를 반환.
+    std::size_t advance(Clock::time_point now);
+
+    [[nodiscard]] std::chrono::milliseconds tick() const noexcept { return tick_; }
+
+    // 예약된(취소·실행되지 않은) 타이머 수
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    struct Entry {
+        std::uint64_t expire_tick{0};
+        Callback callback{};
+    };
+
+    // expire_tick 을 현재 tick 기준으로 알맞은 단계/슬롯에 넣는다 (mu_ 보유 상태)
+    void place(TimerId id, std::uint64_t expire_tick);
+
+    // 상위 단계 슬롯 하나를 비우며 다시 배치한다 (mu_ 보유 상태)
+    void cascade(std::size_t level);
+
+    const std::chrono::milliseconds tick_;
+    const Clock::time_point origin_;
+
+    mutable std::mutex mu_;
+    std::uint64_t current_tick_{0};
+    TimerId next_id_{1};
+    std::unordered_map<TimerId, Entry> entries_{};
+    std::array<std::array<std::vector<TimerId>, kSlots>, kLevels> slots_{};
+};
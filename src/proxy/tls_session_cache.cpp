@@ -0,0 +1,146 @@
+// ---------------------------------------------------------------------------
+// tls_session_cache.cpp
+//
+// SSL / SSL_CTX ex_data 로 new-session 콜백에서 (캐시, 키)를 찾는다.
+//   - SSL_CTX ex_data: TlsSessionCache* (attach 시 설정, 소유하지 않음)
+//   - SSL ex_data    : std::string* 키 (prepare 시 설정, SSL_free 시 free 콜백이 해제)
+//
+// 캐시는 세션 복제본만 보관/제시한다. OpenSSL 은 close_notify 없이 해제된 연결의 현재 세션을
+// 재개 불가로 표시하므로(SSL_free → SSL_CTX_remove_session), 연결에 붙은 세션 객체를 공유하면
+// 연결 하나가 끊길 때 캐시된 세션까지 쓸 수 없게 된다.
+// ---------------------------------------------------------------------------
+
+#include "proxy/tls_session_cache.hpp"
+
+#include <ctime>
+#include <utility>
+
+namespace {
+
+// frontend 세션 캐시 / 티켓이 이 프로세스가 발급한 것인지 구분하는 컨텍스트 ID
+constexpr std::string_view kSessionIdContext{"dbgate-frontend"};
+
+void free_session_key(void* /*parent*/,
+                      void* ptr,
+                      CRYPTO_EX_DATA* /*ad*/,
+                      int /*idx*/,
+                      long /*argl*/,
+                      void* /*argp*/) {
+    delete static_cast<std::string*>(ptr);  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+int ctx_cache_index() {
+    static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    return index;
+}
+
+int ssl_key_index() {
+    static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, free_session_key);
+    return index;
+}
+
+bool expired(const SSL_SESSION* session) noexcept {
+    const auto now = static_cast<long>(std::time(nullptr));
+    return SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session) <= now;
+}
+
+}  // namespace
+
+void enable_server_resumption(boost::asio::ssl::context& ctx,
+                              std::size_t cache_size,
+                              std::chrono::seconds timeout) {
+    SSL_CTX* const native = ctx.native_handle();
+    if (cache_size == 0) {
+        SSL_CTX_set_session_cache_mode(native, SSL_SESS_CACHE_OFF);
+        SSL_CTX_set_options(native, SSL_OP_NO_TICKET);
+        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+        SSL_CTX_set_num_tickets(native, 0);
+        return;
+    }
+
+    // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+    SSL_CTX_set_session_id_context(native,
+                                   reinterpret_cast<const unsigned char*>(kSessionIdContext.data()),
+                                   static_cast<unsigned int>(kSessionIdContext.size()));
+    SSL_CTX_set_session_cache_mode(native, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(native, static_cast<long>(cache_size));
+    SSL_CTX_set_timeout(native, static_cast<long>(timeout.count()));
+    SSL_CTX_clear_options(native, SSL_OP_NO_TICKET);
+}
+
+TlsSessionCache::TlsSessionCache(std::size_t capacity) : capacity_{capacity} {}
+
+void TlsSessionCache::attach(boost::asio::ssl::context& ctx) {
+    SSL_CTX* const native = ctx.native_handle();
+    // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+    SSL_CTX_set_ex_data(native, ctx_cache_index(), this);
+    SSL_CTX_set_session_cache_mode(native,
+                                   SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(native, &TlsSessionCache::on_new_session);
+}
+
+bool TlsSessionCache::prepare(SSL* ssl, std::string_view key) {
+    // 이전 키가 있으면 (같은 SSL 에 두 번 호출) 교체
+    delete static_cast<std::string*>(  // NOLINT(cppcoreguidelines-owning-memory)
+        SSL_get_ex_data(ssl, ssl_key_index()));
+    // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c,cppcoreguidelines-owning-memory)
+    SSL_set_ex_data(ssl, ssl_key_index(), new std::string{key});
+
+    SessionPtr copy{};
+    {
+        const std::lock_guard lock{mutex_};
+        const auto it = sessions_.find(std::string{key});
+        if (it == sessions_.end()) {
+            return false;
+        }
+        if (expired(it->second.get())) {
+            sessions_.erase(it);
+            return false;
+        }
+        copy.reset(SSL_SESSION_dup(it->second.get()));
+    }
+    // SSL_set_session 은 자체 참조를 잡는다 (copy 는 여기서 해제)
+    return copy && SSL_set_session(ssl, copy.get()) == 1;
+}
+
+void TlsSessionCache::store(std::string_view key, const SSL_SESSION* session) {
+    if (capacity_ == 0 || SSL_SESSION_is_resumable(session) != 1) {
+        return;
+    }
+    SessionPtr owned{SSL_SESSION_dup(session)};
+    if (!owned) {
+        return;
+    }
+
+    const std::lock_guard lock{mutex_};
+    auto it = sessions_.find(std::string{key});
+    if (it != sessions_.end()) {
+        it->second = std::move(owned);
+        return;
+    }
+    if (sessions_.size() >= capacity_) {
+        // 업스트림 키 수는 보통 소수이므로 임의 항목 하나를 버린다
+        sessions_.erase(sessions_.begin());
+    }
+    sessions_.emplace(std::string{key}, std::move(owned));
+}
+
+void TlsSessionCache::forget(std::string_view key) {
+    const std::lock_guard lock{mutex_};
+    sessions_.erase(std::string{key});
+}
+
+std::size_t TlsSessionCache::size() const {
+    const std::lock_guard lock{mutex_};
+    return sessions_.size();
+}
+
+int TlsSessionCache::on_new_session(SSL* ssl, SSL_SESSION* session) {
+    auto* const cache = static_cast<TlsSessionCache*>(
+        SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), ctx_cache_index()));
+    const auto* const key = static_cast<const std::string*>(SSL_get_ex_data(ssl, ssl_key_index()));
+    if (cache != nullptr && key != nullptr) {
+        cache->store(*key, session);
+    }
+    return 0;  // 참조를 가져가지 않는다 (캐시는 복제본 보관)
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// tls_session_cache.hpp
+//
+// TLS 세션 재개 (frontend: 서버 측 세션 캐시 + 세션 티켓, backend: 클라이언트 측 세션 재사용).
+//
+// [설계 의도]
+// 재연결이 몰리는 구간(야간 일괄 재접속 등)에는 세션마다 전체 TLS 핸드셰이크
+// (인증서 교환 + 키 교환 + 서명)가 양 구간에서 반복된다. 재개된 핸드셰이크는 인증서
+// 검증과 서명을 생략하므로 CPU 비용과 왕복이 줄어든다.
+//
+// [Frontend — enable_server_resumption]
+// frontend ssl::context 하나를 모든 워커 스레드가 공유하므로 OpenSSL 내부 세션 캐시가
+// 곧 프로세스 공유 캐시다. TLS 1.3 / 1.2 세션 티켓도 함께 허용한다. 티켓 키는 OpenSSL 이
+// context 생성 시 난수로 만들고 메모리에만 둔다 (재시작 시 폐기 → 이전 티켓은 전체 핸드셰이크).
+//
+// [Backend — TlsSessionCache]
+// 클라이언트 측은 OpenSSL 이 세션을 자동 재사용하지 않으므로, 핸드셰이크 후 서버가 보낸
+// 세션(TLS 1.3 은 NewSessionTicket, 핸드셰이크 이후 도착)을 new-session 콜백으로 받아
+// 업스트림 키(SNI/주소:포트)별로 보관하고, 다음 연결의 핸드셰이크 전에 SSL_set_session 한다.
+// 서버가 재개를 거부하면 그대로 전체 핸드셰이크로 진행된다 (실패가 아님).
+//
+// [보안]
+// - 세션 재개도 같은 ssl::context(검증 모드/CA)로만 이뤄진다. 키에 SNI 이름을 포함하여
+//   다른 호스트명으로 검증해야 하는 연결에 세션을 주지 않는다.
+// - 재개 시도 후 핸드셰이크가 실패하면 해당 키의 세션을 버린다 (forget).
+//
+// [스레드 안전성]
+// TlsSessionCache 의 모든 연산은 mutex 로 보호한다 (여러 세션 strand 에서 동시 호출).
+// ---------------------------------------------------------------------------
+
+#include <openssl/ssl.h>
+
+#include <boost/asio/ssl/context.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// ---------------------------------------------------------------------------
+// enable_server_resumption
+//   frontend context 에 서버 측 세션 캐시와 세션 티켓을 설정한다.
+//   cache_size == 0 이면 재개를 끈다 (캐시 off + SSL_OP_NO_TICKET).
+//   timeout: 세션/티켓 수명 (이후 재개 요청은 전체 핸드셰이크).
+// ---------------------------------------------------------------------------
+void enable_server_resumption(boost::asio::ssl::context& ctx,
+                              std::size_t cache_size,
+                              std::chrono::seconds timeout);
+
+class TlsSessionCache {
+public:
+    // capacity: 보관할 업스트림 키 수 상한 (키당 최신 세션 1개)
+    explicit TlsSessionCache(std::size_t capacity);
+    ~TlsSessionCache() = default;
+
+    TlsSessionCache(const TlsSessionCache&) = delete;
+    TlsSessionCache& operator=(const TlsSessionCache&) = delete;
+    TlsSessionCache(TlsSessionCache&&) = delete;
+    TlsSessionCache& operator=(TlsSessionCache&&) = delete;
+
+    // -----------------------------------------------------------------------
+    // attach
+    //   backend context 에 클라이언트 세션 캐시 모드와 new-session 콜백을 설치한다.
+    //   OpenSSL 내부 저장소는 쓰지 않는다 (키별 보관은 이 캐시가 담당).
+    //   이 캐시는 ctx 보다 오래 살아야 한다.
+    // -----------------------------------------------------------------------
+    void attach(boost::asio::ssl::context& ctx);
+
+    // -----------------------------------------------------------------------
+    // prepare
+    //   핸드셰이크 전에 호출한다. ssl 에 key 를 기억시켜 이후 도착하는 세션을 key 로 저장하고,
+    //   key 에 재개 가능한 세션이 있으면 SSL_set_session 한다.
+    //   반환: 재개를 시도하는지 (세션을 제시했는지)
+    // -----------------------------------------------------------------------
+    bool prepare(SSL* ssl, std::string_view key);
+
+    // store: key 의 세션을 session 복제본으로 교체한다. 재개 불가 세션은 무시한다.
+    void store(std::string_view key, const SSL_SESSION* session);
+
+    // forget: key 의 세션을 버린다 (재개 시도 후 핸드셰이크 실패 시)
+    void forget(std::string_view key);
+
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    struct SessionDeleter {
+        void operator()(SSL_SESSION* session) const noexcept { SSL_SESSION_free(session); }
+    };
+    using SessionPtr = std::unique_ptr<SSL_SESSION, SessionDeleter>;
+
+    // new_session_cb: SSL 에 기억된 key 와 ctx 에 기억된 캐시로 store 를 호출한다
+    static int on_new_session(SSL* ssl, SSL_SESSION* session);
+
+    std::size_t capacity_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, SessionPtr> sessions_{};
+};
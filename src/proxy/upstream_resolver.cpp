@@ -0,0 +1,137 @@
+#include "proxy/upstream_resolver.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+// ---------------------------------------------------------------------------
+// UpstreamResolver — 구현
+// ---------------------------------------------------------------------------
+
+namespace {
+
+auto to_endpoint_list(const boost::asio::ip::tcp::resolver::results_type& results)
+    -> UpstreamResolver::EndpointList {
+    UpstreamResolver::EndpointList list;
+    list.reserve(results.size());
+    for (const auto& entry : results) {
+        list.push_back(entry.endpoint());
+    }
+    return list;
+}
+
+}  // namespace
+
+UpstreamResolver::UpstreamResolver(std::string host,
+                                   std::uint16_t port,
+                                   std::chrono::seconds refresh_interval,
+                                   boost::asio::io_context& io_context)
+    : host_{std::move(host)},
+      port_{port},
+      refresh_interval_{refresh_interval},
+      strand_{boost::asio::make_strand(io_context)},
+      timer_{strand_} {
+    // 숫자 IP 는 DNS 를 거치지 않고 고정 엔드포인트로 게시한다
+    boost::system::error_code ec;
+    const auto addr = boost::asio::ip::make_address(host_, ec);
+    if (!ec) {
+        is_static_ = true;
+        endpoints_.store(std::make_shared<const EndpointList>(
+                             EndpointList{boost::asio::ip::tcp::endpoint{addr, port_}}),
+                         std::memory_order_release);
+    }
+}
+
+bool UpstreamResolver::resolve_initial() {
+    if (is_static_) {
+        return true;
+    }
+
+    // 기동 시 1회만 동기 해석한다 (accept 루프 시작 전이므로 세션 지연 없음)
+    boost::asio::ip::tcp::resolver resolver{strand_};
+    boost::system::error_code ec;
+    const auto results = resolver.resolve(host_, std::to_string(port_), ec);
+    if (ec || results.empty()) {
+        spdlog::warn("[resolver] initial resolve of upstream {} failed: {} — "
+                     "connections are rejected until resolution succeeds (fail-close)",
+                     host_,
+                     ec ? ec.message() : "no endpoints");
+        return false;
+    }
+    publish(to_endpoint_list(results));
+    return true;
+}
+
+auto UpstreamResolver::run() -> boost::asio::awaitable<void> {
+    if (is_static_ || refresh_interval_.count() == 0) {
+        co_return;
+    }
+
+    boost::asio::ip::tcp::resolver resolver{strand_};
+    bool last_failed = false;
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        // 직전 실패 시(또는 아직 결과가 없으면) 짧은 간격으로 재시도
+        const bool retry = last_failed || !endpoints();
+        timer_.expires_after(retry ? std::min(refresh_interval_, kRetryInterval)
+                                   : refresh_interval_);
+        boost::system::error_code wait_ec;
+        co_await timer_.async_wait(
+            boost::asio::redirect_error(boost::asio::use_awaitable, wait_ec));
+        if (stopping_.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        boost::system::error_code ec;
+        const auto results = co_await resolver.async_resolve(
+            host_,
+            std::to_string(port_),
+            boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+        if (ec || results.empty()) {
+            // last-known-good 유지. 실패가 이어지는 동안 경고는 1회만 남긴다.
+            if (!last_failed) {
+                spdlog::warn("[resolver] refresh of upstream {} failed (keeping {} endpoints): {}",
+                             host_,
+                             endpoints() ? endpoints()->size() : 0U,
+                             ec ? ec.message() : "no endpoints");
+            }
+            last_failed = true;
+            continue;
+        }
+
+        if (last_failed) {
+            spdlog::info("[resolver] upstream {} resolution recovered", host_);
+        }
+        last_failed = false;
+        publish(to_endpoint_list(results));
+    }
+}
+
+void UpstreamResolver::stop() {
+    if (stopping_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    // timer_ 는 strand 위에서만 접근한다
+    boost::asio::post(strand_, [this] { timer_.cancel(); });
+}
+
+auto UpstreamResolver::endpoints() const noexcept -> std::shared_ptr<const EndpointList> {
+    return endpoints_.load(std::memory_order_acquire);
+}
+
+void UpstreamResolver::publish(EndpointList list) {
+    const auto previous = endpoints();
+    if (previous && *previous == list) {
+        return;
+    }
+    spdlog::info("[resolver] upstream {} resolved to {} endpoint(s), first={}",
+                 host_,
+                 list.size(),
+                 list.front().address().to_string());
+    endpoints_.store(std::make_shared<const EndpointList>(std::move(list)),
+                     std::memory_order_release);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// upstream_resolver.hpp
+//
+// 업스트림 MySQL 주소 해석 결과를 백그라운드에서 갱신하고 모든 세션이 공유한다.
+//
+// [설계 의도]
+// accept 마다 async_resolve 를 수행하면 업스트림이 DNS 이름일 때 매 연결 수립이
+// 리졸버 응답을 기다린다. UpstreamResolver 는 주기적으로(refresh_interval) 해석하여
+// 마지막 성공 결과(last-known-good)를 std::atomic<std::shared_ptr<>> 로 게시하고,
+// accept 루프는 endpoints() 로 즉시 읽기만 한다.
+//
+// [TTL]
+// getaddrinfo 는 레코드 TTL 을 노출하지 않으므로 고정 갱신 주기를 사용한다.
+// 해석 실패 시 이전 결과를 유지하고 kRetryInterval 후 재시도한다.
+//
+// [fail-close]
+// 기동 이후 한 번도 해석에 성공하지 못했으면 endpoints() 는 nullptr 이며,
+// 호출자는 연결을 거부해야 한다.
+//
+// 숫자 IP 는 해석 없이 고정 엔드포인트로 게시하고 갱신 루프를 돌리지 않는다.
+// ---------------------------------------------------------------------------
+
+#include <atomic>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class UpstreamResolver {
+public:
+    using EndpointList = std::vector<boost::asio::ip::tcp::endpoint>;
+
+    // 해석 실패 후 재시도 간격 (갱신 주기가 더 짧으면 갱신 주기를 사용)
+    static constexpr std::chrono::seconds kRetryInterval{5};
+
+    // -----------------------------------------------------------------------
+    // 생성자
+    //   host             : 업스트림 호스트명 또는 숫자 IP
+    //   port             : 업스트림 포트
+    //   refresh_interval : 재해석 주기 (0 이면 기동 시 1회만 해석)
+    //   io_context       : 갱신 코루틴을 실행할 io_context
+    // -----------------------------------------------------------------------
+    UpstreamResolver(std::string host,
+                     std::uint16_t port,
+                     std::chrono::seconds refresh_interval,
+                     boost::asio::io_context& io_context);
+
+    ~UpstreamResolver() = default;
+
+    UpstreamResolver(const UpstreamResolver&) = delete;
+    UpstreamResolver& operator=(const UpstreamResolver&) = delete;
+    UpstreamResolver(UpstreamResolver&&) = delete;
+    UpstreamResolver& operator=(UpstreamResolver&&) = delete;
+
+    // -----------------------------------------------------------------------
+    // resolve_initial
+    //   기동 시 1회 동기 해석 (accept 루프 시작 전에 호출).
+    //   성공 시 true. 실패해도 run() 이 재시도하므로 기동을 중단하지 않는다.
+    // -----------------------------------------------------------------------
+    [[nodiscard]] bool resolve_initial();
+
+    // -----------------------------------------------------------------------
+    // run
+    //   refresh_interval 마다 비동기 재해석하는 갱신 루프.
+    //   executor() (strand) 위에서 co_spawn 해야 stop() 과 직렬화된다.
+    //   숫자 IP 이거나 refresh_interval == 0 이면 즉시 반환한다.
+    // -----------------------------------------------------------------------
+    auto run() -> boost::asio::awaitable<void>;
+
+    // 갱신 루프 종료 요청 (임의 스레드에서 호출 가능)
+    void stop();
+
+    // -----------------------------------------------------------------------
+    // endpoints
+    //   마지막으로 성공한 해석 결과. 한 번도 성공하지 못했으면 nullptr.
+    //   lock-free 읽기 — accept 루프에서 연결마다 호출해도 리졸버를 기다리지 않는다.
+    // -----------------------------------------------------------------------
+    [[nodiscard]] auto endpoints() const noexcept -> std::shared_ptr<const EndpointList>;
+
+    // 숫자 IP 로 지정되어 해석이 필요 없는지
+    [[nodiscard]] auto is_static() const noexcept -> bool { return is_static_; }
+
+    [[nodiscard]] auto executor() const -> boost::asio::any_io_executor { return strand_; }
+
+private:
+    std::string host_;
+    std::uint16_t port_;
+    std::chrono::seconds refresh_interval_;
+    bool is_static_{false};
+
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+    boost::asio::steady_timer timer_;
+    std::atomic<bool> stopping_{false};
+
+    std::atomic<std::shared_ptr<const EndpointList>> endpoints_{};
+
+    // 결과를 게시하고 변경 시 로그를 남긴다
+    void publish(EndpointList list);
+};
@@ -0,0 +1,570 @@
+#include "proxy/upstream_set.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <charconv>
+#include <format>
+#include <utility>
+
+// ---------------------------------------------------------------------------
+// UpstreamSet — 구현
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// probe 로그인 (HandshakeResponse41) 에 쓰는 capability
+constexpr std::uint32_t kClientLongPassword = 0x00000001U;
+constexpr std::uint32_t kClientProtocol41 = 0x00000200U;
+constexpr std::uint32_t kClientSecureConnection = 0x00008000U;
+constexpr std::uint32_t kClientPluginAuth = 0x00080000U;
+constexpr std::uint32_t kProbeMaxPacket = 16U * 1024U * 1024U;
+constexpr std::uint8_t kProbeCharset = 0x21;  // utf8_general_ci
+constexpr std::string_view kProbeAuthPlugin = "mysql_native_password";
+
+// probe 가 받아들이는 패킷 크기 상한 (greeting / OK / ERR 는 수백 바이트)
+constexpr std::size_t kMaxProbePacket = 64U * 1024U;
+
+using ProbeResult = std::expected<void, std::string>;
+
+auto trim(std::string_view s) noexcept -> std::string_view {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+template <typename T>
+auto parse_number(std::string_view s) noexcept -> std::optional<T> {
+    T value{};
+    const auto* const end = s.data() + s.size();
+    const auto [ptr, ec] = std::from_chars(s.data(), end, value);
+    if (s.empty() || ec != std::errc{} || ptr != end) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+auto parse_upstream_entry(std::string_view entry, std::uint16_t default_port)
+    -> std::expected<UpstreamSpec, std::string> {
+    UpstreamSpec spec{.host = {}, .port = default_port, .weight = 1};
+
+    std::string_view address = entry;
+    if (const auto at = entry.rfind('@'); at != std::string_view::npos) {
+        const auto weight = parse_number<std::uint32_t>(entry.substr(at + 1));
+        if (!weight || *weight == 0) {
+            return std::unexpected(std::format("upstream '{}': invalid weight", entry));
+        }
+        spec.weight = *weight;
+        address = entry.substr(0, at);
+    }
+
+    std::string_view host = address;
+    std::string_view port_text{};
+    bool has_port = false;
+    if (address.starts_with('[')) {
+        const auto close = address.find(']');
+        if (close == std::string_view::npos) {
+            return std::unexpected(std::format("upstream '{}': unterminated '['", entry));
+        }
+        host = address.substr(1, close - 1);
+        const auto rest = address.substr(close + 1);
+        if (!rest.empty()) {
+            if (!rest.starts_with(':')) {
+                return std::unexpected(std::format("upstream '{}': expected ':port'", entry));
+            }
+            has_port = true;
+            port_text = rest.substr(1);
+        }
+    } else if (const auto colon = address.find(':'); colon != std::string_view::npos) {
+        if (address.find(':', colon + 1) != std::string_view::npos) {
+            return std::unexpected(
+                std::format("upstream '{}': IPv6 addresses must be bracketed", entry));
+        }
+        host = address.substr(0, colon);
+        has_port = true;
+        port_text = address.substr(colon + 1);
+    }
+
+    if (host.empty()) {
+        return std::unexpected(std::format("upstream '{}': empty host", entry));
+    }
+    if (has_port) {
+        const auto port = parse_number<std::uint16_t>(port_text);
+        if (!port || *port == 0) {
+            return std::unexpected(std::format("upstream '{}': invalid port", entry));
+        }
+        spec.port = *port;
+    }
+    spec.host = std::string{host};
+    return spec;
+}
+
+void put_le(std::vector<std::uint8_t>& out, std::uint32_t value, std::size_t bytes) {
+    for (std::size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<std::uint8_t>(value >> (8U * i)));
+    }
+}
+
+// MySQL 패킷 프레임 (4바이트 헤더 + payload)
+auto frame_packet(std::span<const std::uint8_t> payload, std::uint8_t seq)
+    -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> out;
+    out.reserve(payload.size() + 4);
+    put_le(out, static_cast<std::uint32_t>(payload.size()), 3);
+    out.push_back(seq);
+    out.insert(out.end(), payload.begin(), payload.end());
+    return out;
+}
+
+// 비밀번호 없는 probe 계정의 HandshakeResponse41 (TLS 미사용, auth 데이터 길이 0)
+auto build_probe_login(std::string_view user) -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> payload;
+    payload.reserve(32 + user.size() + 2 + kProbeAuthPlugin.size() + 1);
+    put_le(payload,
+           kClientLongPassword | kClientProtocol41 | kClientSecureConnection | kClientPluginAuth,
+           4);
+    put_le(payload, kProbeMaxPacket, 4);
+    payload.push_back(kProbeCharset);
+    payload.insert(payload.end(), 23, 0);
+    payload.insert(payload.end(), user.begin(), user.end());
+    payload.push_back(0);
+    payload.push_back(0);  // auth-response 길이
+    payload.insert(payload.end(), kProbeAuthPlugin.begin(), kProbeAuthPlugin.end());
+    payload.push_back(0);
+    return payload;
+}
+
+auto describe_err(std::span<const std::uint8_t> payload) -> std::string {
+    if (payload.size() < 3) {
+        return "ERR packet";
+    }
+    const auto code =
+        static_cast<unsigned>(payload[1]) | (static_cast<unsigned>(payload[2]) << 8U);
+    // ERR: 0xFF, code(2), ['#' sqlstate(5)], message
+    const std::size_t msg_off = payload.size() > 3 && payload[3] == '#' ? 9 : 3;
+    std::string message;
+    if (payload.size() > msg_off) {
+        message.assign(payload.begin() + static_cast<std::ptrdiff_t>(msg_off), payload.end());
+    }
+    return std::format("server error {}: {}", code, message);
+}
+
+auto read_packet(boost::asio::ip::tcp::socket& socket, std::vector<std::uint8_t>& payload)
+    -> boost::asio::awaitable<std::expected<std::uint8_t, std::string>> {
+    std::array<std::uint8_t, 4> header{};
+    boost::system::error_code ec;
+    co_await boost::asio::async_read(
+        socket,
+        boost::asio::buffer(header),
+        boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return std::unexpected(std::format("read failed: {}", ec.message()));
+    }
+    const std::size_t length = static_cast<std::size_t>(header[0]) |
+                               (static_cast<std::size_t>(header[1]) << 8U) |
+                               (static_cast<std::size_t>(header[2]) << 16U);
+    if (length == 0 || length > kMaxProbePacket) {
+        co_return std::unexpected(std::format("unexpected packet length {}", length));
+    }
+    payload.resize(length);
+    co_await boost::asio::async_read(
+        socket,
+        boost::asio::buffer(payload),
+        boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return std::unexpected(std::format("read failed: {}", ec.message()));
+    }
+    co_return header[3];
+}
+
+auto write_packet(boost::asio::ip::tcp::socket& socket,
+                  std::span<const std::uint8_t> payload,
+                  std::uint8_t seq) -> boost::asio::awaitable<ProbeResult> {
+    const auto bytes = frame_packet(payload, seq);
+    boost::system::error_code ec;
+    co_await boost::asio::async_write(
+        socket,
+        boost::asio::buffer(bytes),
+        boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return std::unexpected(std::format("write failed: {}", ec.message()));
+    }
+    co_return ProbeResult{};
+}
+
+// probe 계정 로그인: OK 까지 진행 후 COM_QUIT. AuthSwitchRequest 는 빈 응답으로 1회 수락한다.
+auto probe_login(boost::asio::ip::tcp::socket& socket,
+                 std::string_view user,
+                 std::uint8_t greeting_seq) -> boost::asio::awaitable<ProbeResult> {
+    const auto login = build_probe_login(user);
+    if (auto wr = co_await write_packet(socket, login, static_cast<std::uint8_t>(greeting_seq + 1));
+        !wr) {
+        co_return wr;
+    }
+
+    std::vector<std::uint8_t> payload;
+    for (int round = 0; round < 2; ++round) {
+        const auto seq = co_await read_packet(socket, payload);
+        if (!seq) {
+            co_return std::unexpected(seq.error());
+        }
+        if (payload[0] == 0x00) {
+            static constexpr std::array<std::uint8_t, 1> kQuit{0x01};
+            [[maybe_unused]] const auto quit = co_await write_packet(socket, kQuit, 0);
+            co_return ProbeResult{};
+        }
+        if (payload[0] == 0xFF) {
+            co_return std::unexpected(describe_err(payload));
+        }
+        if (payload[0] != 0xFE || round > 0) {
+            break;
+        }
+        if (auto wr = co_await write_packet(
+                socket, std::span<const std::uint8_t>{}, static_cast<std::uint8_t>(*seq + 1));
+            !wr) {
+            co_return wr;
+        }
+    }
+    co_return std::unexpected("probe login did not complete (user must have no password)");
+}
+
+auto probe_backend(const UpstreamBackend& backend, const UpstreamSetOptions& options)
+    -> boost::asio::awaitable<ProbeResult> {
+    const auto endpoints = backend.resolver->endpoints();
+    if (!endpoints || endpoints->empty()) {
+        co_return std::unexpected("not resolved");
+    }
+
+    const auto executor = co_await boost::asio::this_coro::executor;
+    auto socket = std::make_shared<boost::asio::ip::tcp::socket>(executor);
+
+    // 타임아웃 시 소켓을 닫아 진행 중인 connect/read 를 취소한다 (timer 소멸 시 대기 취소)
+    boost::asio::steady_timer deadline{executor};
+    deadline.expires_after(options.health_timeout);
+    deadline.async_wait([socket](boost::system::error_code ec) {
+        if (!ec) {
+            boost::system::error_code close_ec;
+            socket->close(close_ec);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+        }
+    });
+
+    boost::system::error_code ec;
+    co_await boost::asio::async_connect(
+        *socket, *endpoints, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return std::unexpected(std::format("connect failed: {}", ec.message()));
+    }
+
+    std::vector<std::uint8_t> greeting;
+    const auto greeting_seq = co_await read_packet(*socket, greeting);
+    if (!greeting_seq) {
+        co_return std::unexpected(greeting_seq.error());
+    }
+    if (greeting[0] == 0xFF) {
+        co_return std::unexpected(describe_err(greeting));
+    }
+    if (greeting[0] != 0x0A) {
+        co_return std::unexpected(std::format("unexpected greeting version {}", greeting[0]));
+    }
+
+    ProbeResult result{};
+    if (!options.health_user.empty()) {
+        result = co_await probe_login(*socket, options.health_user, *greeting_seq);
+    }
+    boost::system::error_code close_ec;
+    socket->close(close_ec);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+    co_return result;
+}
+
+void log_loop_error(std::exception_ptr eptr, std::string_view what) {
+    if (!eptr) {
+        return;
+    }
+    try {
+        std::rethrow_exception(eptr);
+    } catch (const std::exception& e) {
+        spdlog::error("[upstream] {} error: {}", what, e.what());
+    }
+}
+
+}  // namespace
+
+auto parse_upstream_list(std::string_view list, std::uint16_t default_port)
+    -> std::expected<std::vector<UpstreamSpec>, std::string> {
+    std::vector<UpstreamSpec> specs;
+    while (true) {
+        const auto comma = list.find(',');
+        const auto entry = trim(list.substr(0, comma));
+        if (entry.empty()) {
+            return std::unexpected("upstream list contains an empty entry");
+        }
+        auto spec = parse_upstream_entry(entry, default_port);
+        if (!spec) {
+            return std::unexpected(spec.error());
+        }
+        specs.push_back(std::move(*spec));
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        list.remove_prefix(comma + 1);
+    }
+    return specs;
+}
+
+auto parse_upstream_balance(std::string_view name) noexcept -> std::optional<UpstreamBalance> {
+    if (name == "least_conn") {
+        return UpstreamBalance::kLeastConnections;
+    }
+    if (name == "round_robin") {
+        return UpstreamBalance::kRoundRobin;
+    }
+    return std::nullopt;
+}
+
+auto select_upstream_index(std::span<const UpstreamCandidate> candidates,
+                           UpstreamBalance balance,
+                           std::uint64_t ticket) noexcept -> std::optional<std::size_t> {
+    if (balance == UpstreamBalance::kRoundRobin) {
+        std::uint64_t total = 0;
+        for (const auto& c : candidates) {
+            total += c.eligible ? c.weight : 0U;
+        }
+        if (total == 0) {
+            return std::nullopt;
+        }
+        auto slot = ticket % total;
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            if (!candidates[i].eligible) {
+                continue;
+            }
+            if (slot < candidates[i].weight) {
+                return i;
+            }
+            slot -= candidates[i].weight;
+        }
+        return std::nullopt;
+    }
+
+    // least connections: active_i / weight_i 최소 (교차 곱으로 비교), 시작점은 순번으로 회전
+    const std::size_t n = candidates.size();
+    if (n == 0) {
+        return std::nullopt;
+    }
+    const auto start = static_cast<std::size_t>(ticket % n);
+    std::optional<std::size_t> best;
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t i = (start + k) % n;
+        const auto& c = candidates[i];
+        if (!c.eligible) {
+            continue;
+        }
+        if (!best) {
+            best = i;
+            continue;
+        }
+        const auto& b = candidates[*best];
+        if (static_cast<std::uint64_t>(c.active) * b.weight <
+            static_cast<std::uint64_t>(b.active) * c.weight) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// ---------------------------------------------------------------------------
+// UpstreamBackend
+// ---------------------------------------------------------------------------
+UpstreamBackend::UpstreamBackend(UpstreamSpec spec_value,
+                                 std::chrono::seconds dns_refresh,
+                                 boost::asio::io_context& io_context)
+    : spec{std::move(spec_value)},
+      resolver{std::make_unique<UpstreamResolver>(spec.host, spec.port, dns_refresh, io_context)},
+      probe_timer{resolver->executor()} {}
+
+void UpstreamBackend::record_failure(std::string_view reason) noexcept {
+    const auto failures = consecutive_failures.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (eject_failures == 0 || failures < eject_failures) {
+        return;
+    }
+    if (healthy.exchange(false, std::memory_order_acq_rel)) {
+        spdlog::warn("[upstream] {}:{} ejected after {} consecutive failure(s): {}",
+                     spec.host,
+                     spec.port,
+                     failures,
+                     reason);
+    }
+}
+
+void UpstreamBackend::record_success() noexcept {
+    consecutive_failures.store(0, std::memory_order_relaxed);
+    if (!healthy.exchange(true, std::memory_order_acq_rel)) {
+        spdlog::info("[upstream] {}:{} readmitted", spec.host, spec.port);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// UpstreamLease
+// ---------------------------------------------------------------------------
+UpstreamLease::UpstreamLease(std::shared_ptr<UpstreamBackend> backend) noexcept
+    : backend_{std::move(backend)} {
+    if (backend_) {
+        backend_->active.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+UpstreamLease::~UpstreamLease() {
+    if (backend_) {
+        backend_->active.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+UpstreamLease& UpstreamLease::operator=(UpstreamLease&& other) noexcept {
+    if (this != &other) {
+        if (backend_) {
+            backend_->active.fetch_sub(1, std::memory_order_relaxed);
+        }
+        backend_ = std::move(other.backend_);
+    }
+    return *this;
+}
+
+void UpstreamLease::report_connect(bool ok) noexcept {
+    if (!backend_) {
+        return;
+    }
+    if (ok) {
+        backend_->record_success();
+    } else {
+        backend_->record_failure("session connect failed");
+    }
+}
+
+// ---------------------------------------------------------------------------
+// UpstreamSet
+// ---------------------------------------------------------------------------
+UpstreamSet::UpstreamSet(std::vector<UpstreamSpec> specs,
+                         UpstreamSetOptions options,
+                         boost::asio::io_context& io_context)
+    : options_{std::move(options)} {
+    backends_.reserve(specs.size());
+    for (auto& spec : specs) {
+        auto backend =
+            std::make_shared<UpstreamBackend>(std::move(spec), options_.dns_refresh, io_context);
+        // probe 가 없으면 복귀 수단이 없으므로 제외하지 않는다
+        backend->eject_failures =
+            options_.health_interval.count() > 0 ? options_.eject_failures : 0;
+        backends_.push_back(std::move(backend));
+    }
+}
+
+std::size_t UpstreamSet::resolve_initial() {
+    std::size_t resolved = 0;
+    for (const auto& backend : backends_) {
+        resolved += backend->resolver->resolve_initial() ? 1U : 0U;
+    }
+    return resolved;
+}
+
+void UpstreamSet::start() {
+    for (const auto& backend : backends_) {
+        boost::asio::co_spawn(
+            backend->resolver->executor(),
+            backend->resolver->run(),
+            [](std::exception_ptr eptr) {  // NOLINT(performance-unnecessary-value-param)
+                log_loop_error(eptr, "resolver");
+            });
+        if (options_.health_interval.count() > 0) {
+            boost::asio::co_spawn(
+                backend->resolver->executor(),
+                probe_loop(backend),
+                [](std::exception_ptr eptr) {  // NOLINT(performance-unnecessary-value-param)
+                    log_loop_error(eptr, "health probe");
+                });
+        }
+    }
+}
+
+void UpstreamSet::stop() {
+    if (stopping_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    for (const auto& backend : backends_) {
+        backend->resolver->stop();
+        // probe_timer 는 strand 위에서만 접근한다
+        boost::asio::post(backend->resolver->executor(),
+                          [backend] { backend->probe_timer.cancel(); });
+    }
+}
+
+auto UpstreamSet::select() -> std::optional<UpstreamTarget> {
+    std::vector<UpstreamCandidate> candidates;
+    candidates.reserve(backends_.size());
+    for (const auto& backend : backends_) {
+        const auto endpoints = backend->resolver->endpoints();
+        candidates.push_back(
+            {.weight = backend->spec.weight,
+             .active = backend->active.load(std::memory_order_relaxed),
+             .eligible = backend->healthy.load(std::memory_order_acquire) && endpoints &&
+                         !endpoints->empty()});
+    }
+
+    const auto index = select_upstream_index(
+        candidates, options_.balance, ticket_.fetch_add(1, std::memory_order_relaxed));
+    if (!index) {
+        return std::nullopt;
+    }
+
+    // 한 번 게시된 해석 결과는 nullptr 로 돌아가지 않는다
+    const auto& backend = backends_[*index];
+    return UpstreamTarget{.endpoint = backend->resolver->endpoints()->front(),
+                          .host = backend->spec.host,
+                          .lease = UpstreamLease{backend}};
+}
+
+std::size_t UpstreamSet::healthy_count() const noexcept {
+    return static_cast<std::size_t>(std::ranges::count_if(backends_, [](const auto& backend) {
+        return backend->healthy.load(std::memory_order_acquire);
+    }));
+}
+
+auto UpstreamSet::probe_loop(std::shared_ptr<UpstreamBackend> backend)
+    -> boost::asio::awaitable<void> {
+    const auto ejected_interval =
+        std::max(kMinEjectedProbeInterval, options_.health_interval / 4);
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        // 제외된 백엔드는 짧은 주기로 확인하여 복구 즉시 복귀시킨다
+        const bool ejected = !backend->healthy.load(std::memory_order_acquire);
+        backend->probe_timer.expires_after(ejected ? ejected_interval : options_.health_interval);
+        boost::system::error_code wait_ec;
+        co_await backend->probe_timer.async_wait(
+            boost::asio::redirect_error(boost::asio::use_awaitable, wait_ec));
+        if (stopping_.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        const auto result = co_await probe_backend(*backend, options_);
+        if (result) {
+            backend->record_success();
+        } else {
+            spdlog::debug("[upstream] probe {}:{} failed: {}",
+                          backend->spec.host,
+                          backend->spec.port,
+                          result.error());
+            backend->record_failure(result.error());
+        }
+    }
+}
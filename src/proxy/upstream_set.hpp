@@ -0,0 +1,219 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// upstream_set.hpp
+//
+// 여러 업스트림 MySQL 백엔드 중 새 세션이 연결할 대상을 고른다.
+//
+// [설계 의도]
+// 단일 upstream_address 로는 인스턴스 하나가 MySQL 하나만 앞단에서 받을 수 있어,
+// 읽기 확장을 위해 프록시를 여러 개 띄우고 haproxy 로 묶어야 했다. UpstreamSet 은
+// 백엔드마다 UpstreamResolver(주소 해석)와 상태(활성 세션 수, 연속 실패 수, healthy)를 두고
+// accept 루프에서 lock-free 로 대상을 선택한다.
+//
+// [선택]
+//   kLeastConnections : active / weight 가 가장 작은 백엔드 (동률은 순번으로 분산)
+//   kRoundRobin       : weight 비율대로 순번 배정
+// 해석 결과가 없거나 제외(eject)된 백엔드는 건너뛴다. 선택 가능한 백엔드가 없으면
+// std::nullopt — 호출자는 연결을 거부한다 (fail-close).
+//
+// [헬스 체크]
+// health_interval > 0 이면 백엔드마다 주기적으로 probe 한다.
+//   - TCP connect + 서버 greeting 수신 (protocol v10 이어야 하며 ERR 이면 실패)
+//   - health_user 가 있으면 비밀번호 없는 해당 계정으로 로그인 후 COM_QUIT
+//     (greeting 만 받고 끊으면 MySQL 이 handshake 오류로 집계하여 max_connect_errors
+//      초과 시 프록시 호스트를 차단할 수 있다 — 운영에서는 probe 전용 계정을 권장)
+// 세션의 업스트림 connect 실패(UpstreamLease::report_connect)와 probe 실패는 같은
+// 연속 실패 카운터를 올리고, eject_failures 에 도달하면 즉시 제외한다. 제외된 백엔드는
+// 더 짧은 주기로 probe 하며 한 번 성공하면 바로 복귀한다.
+// health_interval == 0 이면 복귀 수단이 없으므로 제외하지 않는다 (기존 단일 업스트림 동작).
+//
+// [범위]
+// 읽기/쓰기 분리는 지원하지 않는다. 프록시는 클라이언트 인증을 릴레이할 뿐 자격 증명을
+// 갖지 않으므로, 세션 도중 다른 백엔드에 인증된 두 번째 연결을 열 수 없다.
+// ---------------------------------------------------------------------------
+
+#include <atomic>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "proxy/upstream_resolver.hpp"
+
+// ---------------------------------------------------------------------------
+// UpstreamSpec
+//   host   : 호스트명 또는 숫자 IP
+//   port   : 포트
+//   weight : 선택 가중치 (1 이상)
+// ---------------------------------------------------------------------------
+struct UpstreamSpec {
+    std::string host{};
+    std::uint16_t port{0};
+    std::uint32_t weight{1};
+
+    bool operator==(const UpstreamSpec&) const = default;
+};
+
+// ---------------------------------------------------------------------------
+// parse_upstream_list
+//   "host[:port][@weight],..." 목록을 파싱한다. IPv6 는 "[::1]:3306" 형식.
+//   port 생략 시 default_port, weight 생략 시 1.
+//   빈 항목, 잘못된 포트/가중치(0 포함)는 오류 (기동 중단, fail-close).
+// ---------------------------------------------------------------------------
+[[nodiscard]] auto parse_upstream_list(std::string_view list, std::uint16_t default_port)
+    -> std::expected<std::vector<UpstreamSpec>, std::string>;
+
+enum class UpstreamBalance : std::uint8_t {
+    kLeastConnections = 0,
+    kRoundRobin = 1,
+};
+
+// "least_conn" / "round_robin". 그 외는 std::nullopt
+[[nodiscard]] auto parse_upstream_balance(std::string_view name) noexcept
+    -> std::optional<UpstreamBalance>;
+
+// ---------------------------------------------------------------------------
+// UpstreamCandidate / select_upstream_index
+//   선택 알고리즘 (상태 없는 순수 함수 — 단위 테스트 대상).
+//   ticket 은 호출마다 증가하는 순번이며 round-robin 위치 / 동률 시작점으로 쓰인다.
+// ---------------------------------------------------------------------------
+struct UpstreamCandidate {
+    std::uint32_t weight{1};
+    std::uint32_t active{0};
+    bool eligible{false};
+};
+
+[[nodiscard]] auto select_upstream_index(std::span<const UpstreamCandidate> candidates,
+                                         UpstreamBalance balance,
+                                         std::uint64_t ticket) noexcept
+    -> std::optional<std::size_t>;
+
+// ---------------------------------------------------------------------------
+// UpstreamBackend
+//   백엔드 하나의 공유 상태. UpstreamSet 이 소유하며 UpstreamLease 가 참조한다.
+// ---------------------------------------------------------------------------
+struct UpstreamBackend {
+    UpstreamSpec spec;
+    std::unique_ptr<UpstreamResolver> resolver;
+    boost::asio::steady_timer probe_timer;  // resolver->executor() (strand) 위에서만 접근
+
+    std::atomic<std::uint32_t> active{0};
+    std::atomic<std::uint32_t> consecutive_failures{0};
+    std::atomic<bool> healthy{true};
+    std::uint32_t eject_failures{0};  // 0 = 제외하지 않음
+
+    UpstreamBackend(UpstreamSpec spec_value,
+                    std::chrono::seconds dns_refresh,
+                    boost::asio::io_context& io_context);
+
+    // 실패/성공 기록 (임의 스레드). eject / 복귀 전환 시 로그를 남긴다.
+    void record_failure(std::string_view reason) noexcept;
+    void record_success() noexcept;
+};
+
+// ---------------------------------------------------------------------------
+// UpstreamLease
+//   선택된 백엔드의 활성 세션 수를 세션 수명 동안 1 올려 둔다 (소멸 시 감소).
+//   report_connect 는 세션이 업스트림 TCP connect 결과를 알릴 때 1회 호출한다.
+//   기본 생성된 lease 는 아무 것도 하지 않는다 (테스트 / 단일 업스트림 직접 생성용).
+// ---------------------------------------------------------------------------
+class UpstreamLease {
+public:
+    UpstreamLease() noexcept = default;
+    explicit UpstreamLease(std::shared_ptr<UpstreamBackend> backend) noexcept;
+    ~UpstreamLease();
+
+    UpstreamLease(const UpstreamLease&) = delete;
+    UpstreamLease& operator=(const UpstreamLease&) = delete;
+    UpstreamLease(UpstreamLease&& other) noexcept = default;
+    UpstreamLease& operator=(UpstreamLease&& other) noexcept;
+
+    void report_connect(bool ok) noexcept;
+
+    [[nodiscard]] explicit operator bool() const noexcept { return backend_ != nullptr; }
+
+private:
+    std::shared_ptr<UpstreamBackend> backend_{};
+};
+
+// ---------------------------------------------------------------------------
+// UpstreamTarget
+//   endpoint : 연결할 주소 (해당 백엔드의 마지막 해석 결과 첫 항목)
+//   host     : 백엔드 호스트 문자열 (backend TLS SNI 기본값, UpstreamSet 수명 동안 유효)
+// ---------------------------------------------------------------------------
+struct UpstreamTarget {
+    boost::asio::ip::tcp::endpoint endpoint{};
+    std::string_view host{};
+    UpstreamLease lease{};
+};
+
+struct UpstreamSetOptions {
+    UpstreamBalance balance{UpstreamBalance::kLeastConnections};
+    std::chrono::seconds dns_refresh{30};
+    std::chrono::milliseconds health_interval{2000};  // 0 = probe 없음 (제외도 없음)
+    std::chrono::milliseconds health_timeout{1000};
+    std::uint32_t eject_failures{3};
+    std::string health_user{};  // 빈 문자열 = greeting 까지만 확인
+};
+
+class UpstreamSet {
+public:
+    // 제외된 백엔드의 probe 주기 하한 (health_interval / 4 와 비교해 큰 값)
+    static constexpr std::chrono::milliseconds kMinEjectedProbeInterval{100};
+
+    // specs 는 비어 있으면 안 된다 (호출자가 parse_upstream_list 로 검증)
+    UpstreamSet(std::vector<UpstreamSpec> specs,
+                UpstreamSetOptions options,
+                boost::asio::io_context& io_context);
+
+    ~UpstreamSet() = default;
+
+    UpstreamSet(const UpstreamSet&) = delete;
+    UpstreamSet& operator=(const UpstreamSet&) = delete;
+    UpstreamSet(UpstreamSet&&) = delete;
+    UpstreamSet& operator=(UpstreamSet&&) = delete;
+
+    // 기동 시 1회 동기 해석. 해석에 성공한 백엔드 수를 반환한다.
+    std::size_t resolve_initial();
+
+    // DNS 갱신 루프 + (health_interval > 0) probe 루프를 백엔드 strand 에 co_spawn 한다
+    void start();
+
+    // 갱신/probe 루프 종료 요청 (임의 스레드에서 호출 가능)
+    void stop();
+
+    // -----------------------------------------------------------------------
+    // select
+    //   새 세션의 연결 대상. 활성 수 증가는 lease 에 묶인다.
+    //   선택 가능한 백엔드가 없으면 std::nullopt (fail-close).
+    // -----------------------------------------------------------------------
+    [[nodiscard]] auto select() -> std::optional<UpstreamTarget>;
+
+    [[nodiscard]] std::size_t size() const noexcept { return backends_.size(); }
+    [[nodiscard]] std::size_t healthy_count() const noexcept;
+    [[nodiscard]] const UpstreamSetOptions& options() const noexcept { return options_; }
+
+    // 테스트/진단용 개별 백엔드 접근 (index < size())
+    [[nodiscard]] UpstreamBackend& backend(std::size_t index) noexcept {
+        return *backends_[index];
+    }
+
+private:
+    UpstreamSetOptions options_;
+    std::vector<std::shared_ptr<UpstreamBackend>> backends_;
+    std::atomic<std::uint64_t> ticket_{0};
+    std::atomic<bool> stopping_{false};
+
+    auto probe_loop(std::shared_ptr<UpstreamBackend> backend) -> boost::asio::awaitable<void>;
+};
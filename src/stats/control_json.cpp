@@ -0,0 +1,477 @@
+// ---------------------------------------------------------------------------
+// control_json.cpp
+// ---------------------------------------------------------------------------
+
+#include "stats/control_json.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace {
+
+bool is_json_whitespace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool is_digit(char c) noexcept {
+    return c >= '0' && c <= '9';
+}
+
+int hex_value(char c) noexcept {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// 검증된 \uXXXX 의 4자리 16진수
+std::uint32_t read_hex4(std::string_view text, std::size_t pos) noexcept {
+    std::uint32_t value = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+        value = (value << 4U) | static_cast<std::uint32_t>(hex_value(text[pos + i]));
+    }
+    return value;
+}
+
+// 키를 다시 JSON 문자열로 쓸 때의 최소 이스케이프
+void append_escaped_key(std::string& out, std::string_view key) {
+    out += '"';
+    for (const char c : key) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20U) {
+            fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned>(c));
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void append_utf8(std::string& out, std::uint32_t cp) {
+    if (cp < 0x80U) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800U) {
+        out += static_cast<char>(0xC0U | (cp >> 6U));
+        out += static_cast<char>(0x80U | (cp & 0x3FU));
+    } else if (cp < 0x10000U) {
+        out += static_cast<char>(0xE0U | (cp >> 12U));
+        out += static_cast<char>(0x80U | ((cp >> 6U) & 0x3FU));
+        out += static_cast<char>(0x80U | (cp & 0x3FU));
+    } else {
+        out += static_cast<char>(0xF0U | (cp >> 18U));
+        out += static_cast<char>(0x80U | ((cp >> 12U) & 0x3FU));
+        out += static_cast<char>(0x80U | ((cp >> 6U) & 0x3FU));
+        out += static_cast<char>(0x80U | (cp & 0x3FU));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// unescape
+//   검증을 통과한 문자열 리터럴(따옴표 제외)의 이스케이프를 푼다.
+//   짝이 없는 서로게이트는 U+FFFD 로 바꾼다.
+// ---------------------------------------------------------------------------
+std::string unescape(std::string_view body) {
+    std::string out;
+    out.reserve(body.size());
+    for (std::size_t i = 0; i < body.size(); ++i) {
+        const char c = body[i];
+        if (c != '\\') {
+            out += c;
+            continue;
+        }
+        const char e = body[++i];
+        switch (e) {
+            case 'b':
+                out += '\b';
+                break;
+            case 'f':
+                out += '\f';
+                break;
+            case 'n':
+                out += '\n';
+                break;
+            case 'r':
+                out += '\r';
+                break;
+            case 't':
+                out += '\t';
+                break;
+            case 'u': {
+                std::uint32_t cp = read_hex4(body, i + 1);
+                i += 4;
+                if (cp >= 0xD800U && cp <= 0xDBFFU && i + 6 < body.size() &&
+                    body[i + 1] == '\\' && body[i + 2] == 'u' && hex_value(body[i + 3]) >= 0) {
+                    const std::uint32_t low = read_hex4(body, i + 3);
+                    if (low >= 0xDC00U && low <= 0xDFFFU) {
+                        cp = 0x10000U + ((cp - 0xD800U) << 10U) + (low - 0xDC00U);
+                        i += 6;
+                    }
+                }
+                if (cp >= 0xD800U && cp <= 0xDFFFU) {
+                    cp = 0xFFFDU;
+                }
+                append_utf8(out, cp);
+                break;
+            }
+            default:  // '"', '\\', '/'
+                out += e;
+                break;
+        }
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// Parser
+//   재귀 하강. 값 하나를 건너뛰며 문법을 검증하고, 최상위 오브젝트의 멤버만 기록한다.
+// ---------------------------------------------------------------------------
+class Parser {
+public:
+    explicit Parser(std::string_view text) noexcept : text_{text} {}
+
+    auto parse_document() -> std::expected<JsonObject, std::string> {
+        skip_whitespace();
+        if (pos_ >= text_.size() || text_[pos_] != '{') {
+            return fail("expected '{'");
+        }
+        JsonObject object;
+        if (!parse_object(0, &object)) {
+            return std::unexpected(std::move(error_));
+        }
+        skip_whitespace();
+        if (pos_ != text_.size()) {
+            return fail("trailing characters");
+        }
+        return object;
+    }
+
+private:
+    auto fail(std::string_view what) -> std::unexpected<std::string> {
+        return std::unexpected(fmt::format("{} at offset {}", what, pos_));
+    }
+
+    bool set_error(std::string_view what) {
+        error_ = fmt::format("{} at offset {}", what, pos_);
+        return false;
+    }
+
+    void skip_whitespace() noexcept {
+        while (pos_ < text_.size() && is_json_whitespace(text_[pos_])) {
+            ++pos_;
+        }
+    }
+
+    // out != nullptr 이면 멤버를 기록한다 (최상위 오브젝트)
+    bool parse_object(std::size_t depth, JsonObject* out) {
+        if (depth >= kMaxJsonDepth) {
+            return set_error("nesting too deep");
+        }
+        ++pos_;  // '{'
+        skip_whitespace();
+        if (pos_ < text_.size() && text_[pos_] == '}') {
+            ++pos_;
+            return true;
+        }
+        for (;;) {
+            skip_whitespace();
+            if (pos_ >= text_.size() || text_[pos_] != '"') {
+                return set_error("expected object key");
+            }
+            const auto key_begin = pos_;
+            if (!parse_string()) {
+                return false;
+            }
+            const auto key_raw = text_.substr(key_begin + 1, pos_ - key_begin - 2);
+            skip_whitespace();
+            if (pos_ >= text_.size() || text_[pos_] != ':') {
+                return set_error("expected ':'");
+            }
+            ++pos_;
+            skip_whitespace();
+            const auto value_begin = pos_;
+            JsonKind kind{};
+            if (!parse_value(depth + 1, kind)) {
+                return false;
+            }
+            if (out != nullptr) {
+                out->members.push_back(JsonMember{
+                    .key = unescape(key_raw),
+                    .kind = kind,
+                    .raw = text_.substr(value_begin, pos_ - value_begin),
+                });
+            }
+            skip_whitespace();
+            if (pos_ < text_.size() && text_[pos_] == ',') {
+                ++pos_;
+                continue;
+            }
+            if (pos_ < text_.size() && text_[pos_] == '}') {
+                ++pos_;
+                return true;
+            }
+            return set_error("expected ',' or '}'");
+        }
+    }
+
+    bool parse_array(std::size_t depth) {
+        if (depth >= kMaxJsonDepth) {
+            return set_error("nesting too deep");
+        }
+        ++pos_;  // '['
+        skip_whitespace();
+        if (pos_ < text_.size() && text_[pos_] == ']') {
+            ++pos_;
+            return true;
+        }
+        for (;;) {
+            skip_whitespace();
+            JsonKind kind{};
+            if (!parse_value(depth + 1, kind)) {
+                return false;
+            }
+            skip_whitespace();
+            if (pos_ < text_.size() && text_[pos_] == ',') {
+                ++pos_;
+                continue;
+            }
+            if (pos_ < text_.size() && text_[pos_] == ']') {
+                ++pos_;
+                return true;
+            }
+            return set_error("expected ',' or ']'");
+        }
+    }
+
+    bool parse_value(std::size_t depth, JsonKind& kind) {
+        if (pos_ >= text_.size()) {
+            return set_error("unexpected end of input");
+        }
+        switch (text_[pos_]) {
+            case '{':
+                kind = JsonKind::kObject;
+                return parse_object(depth, nullptr);
+            case '[':
+                kind = JsonKind::kArray;
+                return parse_array(depth);
+            case '"':
+                kind = JsonKind::kString;
+                return parse_string();
+            case 't':
+                kind = JsonKind::kBool;
+                return parse_literal("true");
+            case 'f':
+                kind = JsonKind::kBool;
+                return parse_literal("false");
+            case 'n':
+                kind = JsonKind::kNull;
+                return parse_literal("null");
+            default:
+                kind = JsonKind::kNumber;
+                return parse_number();
+        }
+    }
+
+    bool parse_literal(std::string_view literal) {
+        if (text_.substr(pos_, literal.size()) != literal) {
+            return set_error("invalid literal");
+        }
+        pos_ += literal.size();
+        return true;
+    }
+
+    // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    bool parse_number() {
+        if (pos_ < text_.size() && text_[pos_] == '-') {
+            ++pos_;
+        }
+        if (pos_ >= text_.size() || !is_digit(text_[pos_])) {
+            return set_error("invalid value");
+        }
+        if (text_[pos_] == '0') {
+            ++pos_;
+        } else {
+            while (pos_ < text_.size() && is_digit(text_[pos_])) {
+                ++pos_;
+            }
+        }
+        if (pos_ < text_.size() && text_[pos_] == '.') {
+            ++pos_;
+            if (pos_ >= text_.size() || !is_digit(text_[pos_])) {
+                return set_error("invalid number");
+            }
+            while (pos_ < text_.size() && is_digit(text_[pos_])) {
+                ++pos_;
+            }
+        }
+        if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E')) {
+            ++pos_;
+            if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-')) {
+                ++pos_;
+            }
+            if (pos_ >= text_.size() || !is_digit(text_[pos_])) {
+                return set_error("invalid number");
+            }
+            while (pos_ < text_.size() && is_digit(text_[pos_])) {
+                ++pos_;
+            }
+        }
+        return true;
+    }
+
+    // 여는 '"' 에서 시작해 닫는 '"' 다음으로 이동한다
+    bool parse_string() {
+        ++pos_;  // '"'
+        while (pos_ < text_.size()) {
+            const char c = text_[pos_];
+            if (c == '"') {
+                ++pos_;
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20U) {
+                return set_error("control character in string");
+            }
+            if (c != '\\') {
+                ++pos_;
+                continue;
+            }
+            if (pos_ + 1 >= text_.size()) {
+                break;
+            }
+            const char e = text_[pos_ + 1];
+            if (e == 'u') {
+                if (pos_ + 6 > text_.size()) {
+                    break;
+                }
+                for (std::size_t i = 2; i < 6; ++i) {
+                    if (hex_value(text_[pos_ + i]) < 0) {
+                        return set_error("invalid \\u escape");
+                    }
+                }
+                pos_ += 6;
+                continue;
+            }
+            if (e != '"' && e != '\\' && e != '/' && e != 'b' && e != 'f' && e != 'n' &&
+                e != 'r' && e != 't') {
+                return set_error("invalid escape");
+            }
+            pos_ += 2;
+        }
+        return set_error("unterminated string");
+    }
+
+    std::string_view text_;
+    std::size_t pos_{0};
+    std::string error_;
+};
+
+}  // namespace
+
+const JsonMember* JsonObject::find(std::string_view key) const noexcept {
+    for (const auto& member : members) {
+        if (member.key == key) {
+            return &member;
+        }
+    }
+    return nullptr;
+}
+
+std::optional<std::string> JsonObject::string_field(std::string_view key) const {
+    const auto* member = find(key);
+    return member != nullptr ? json_string_value(*member) : std::nullopt;
+}
+
+std::optional<std::uint64_t> JsonObject::uint64_field(std::string_view key) const {
+    const auto* member = find(key);
+    return member != nullptr ? json_uint64_value(*member) : std::nullopt;
+}
+
+std::optional<bool> JsonObject::bool_field(std::string_view key) const {
+    const auto* member = find(key);
+    if (member == nullptr || member->kind != JsonKind::kBool) {
+        return std::nullopt;
+    }
+    return member->raw == "true";
+}
+
+auto parse_json_object(std::string_view text) -> std::expected<JsonObject, std::string> {
+    return Parser{text}.parse_document();
+}
+
+std::optional<std::string> json_string_value(const JsonMember& member) {
+    if (member.kind != JsonKind::kString || member.raw.size() < 2) {
+        return std::nullopt;
+    }
+    return unescape(member.raw.substr(1, member.raw.size() - 2));
+}
+
+std::optional<std::uint64_t> json_uint64_value(const JsonMember& member) {
+    if (member.kind != JsonKind::kNumber || member.raw.empty()) {
+        return std::nullopt;
+    }
+    std::uint64_t value = 0;
+    for (const char c : member.raw) {
+        if (!is_digit(c)) {
+            return std::nullopt;  // 음수, 소수, 지수
+        }
+        const auto digit = static_cast<std::uint64_t>(c - '0');
+        if (value > (std::numeric_limits<std::uint64_t>::max() - digit) / 10U) {
+            return std::nullopt;
+        }
+        value = value * 10U + digit;
+    }
+    return value;
+}
+
+std::string json_object_delta(const JsonObject& current, const JsonObject& previous) {
+    std::string out = "{";
+    for (std::size_t i = 0; i < current.members.size(); ++i) {
+        const auto& member = current.members[i];
+        const JsonMember* before = nullptr;
+        if (i < previous.members.size() && previous.members[i].key == member.key) {
+            before = &previous.members[i];
+        } else {
+            before = previous.find(member.key);
+        }
+        if (before != nullptr && before->raw == member.raw) {
+            continue;
+        }
+        if (out.size() > 1) {
+            out += ',';
+        }
+        append_escaped_key(out, member.key);
+        out += ':';
+        out += member.raw;
+    }
+    out += '}';
+    return out;
+}
+
+auto parse_control_request(std::string_view json) -> std::expected<ControlRequest, std::string> {
+    auto top = parse_json_object(json);
+    if (!top) {
+        return std::unexpected(std::move(top.error()));
+    }
+
+    ControlRequest request;
+    request.command = top->string_field("command").value_or(std::string{});
+    request.version = top->uint64_field("version").value_or(1);
+    if (const auto* payload = top->find("payload");
+        payload != nullptr && payload->kind == JsonKind::kObject) {
+        // 이미 검증된 구간이라 다시 여는 데 실패하지 않는다
+        if (auto members = parse_json_object(payload->raw); members) {
+            request.payload = std::move(*members);
+        }
+    }
+    return request;
+}
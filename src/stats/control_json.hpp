@@ -0,0 +1,102 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// control_json.hpp
+//
+// UDS 제어 프로토콜용 단일 패스 JSON 파서.
+//
+// [설계 의도]
+// 요청 본문은 작고(보통 100바이트 미만) 필드는 최상위 "command" / "version" 과 "payload"
+// 오브젝트 하나뿐이다. 범용 DOM 을 만들지 않고, 본문을 한 번 훑으면서 문법 전체를 검증하고
+// 최상위 멤버만 (키, 값 종류, 원문 구간) 으로 기록한다. 중첩 값은 검증만 하고 원문 구간으로
+// 남겨 필요할 때 같은 파서로 다시 연다 (payload 가 그렇다).
+//
+// 이전의 부분 문자열 탐색과 달리 문자열 리터럴 / 중첩 오브젝트 안의 "key": 는 키가 될 수 없고,
+// 문법 오류가 있는 본문은 필드 하나도 믿지 않는다 (fail-close).
+//
+// [수명]
+// JsonMember::raw 와 ControlRequest::payload 는 파싱한 입력 텍스트를 가리킨다.
+// 입력 버퍼가 살아 있는 동안만 쓴다.
+// ---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 중첩 허용 깊이 (오브젝트 / 배열). 재귀 하강 파서의 스택 사용 상한이기도 하다.
+inline constexpr std::size_t kMaxJsonDepth = 32;
+
+enum class JsonKind : std::uint8_t {
+    kString,
+    kNumber,
+    kObject,
+    kArray,
+    kBool,
+    kNull,
+};
+
+// ---------------------------------------------------------------------------
+// JsonMember
+//   key : 이스케이프를 푼 키
+//   raw : 값의 원문 (문자열은 따옴표 포함, 오브젝트는 중괄호 포함)
+// ---------------------------------------------------------------------------
+struct JsonMember {
+    std::string key;
+    JsonKind kind{JsonKind::kNull};
+    std::string_view raw;
+};
+
+// ---------------------------------------------------------------------------
+// JsonObject
+//   최상위 멤버 목록 (입력 순서). 같은 키가 여러 번 나오면 find() 는 첫 번째를 돌려준다.
+// ---------------------------------------------------------------------------
+struct JsonObject {
+    std::vector<JsonMember> members;
+
+    [[nodiscard]] const JsonMember* find(std::string_view key) const noexcept;
+
+    // 타입이 맞지 않거나(문자열이 아닌 값 등) 없으면 nullopt
+    [[nodiscard]] std::optional<std::string> string_field(std::string_view key) const;
+    // 부호 / 소수점 / 지수 없는 정수만, uint64 범위를 넘으면 nullopt
+    [[nodiscard]] std::optional<std::uint64_t> uint64_field(std::string_view key) const;
+    [[nodiscard]] std::optional<bool> bool_field(std::string_view key) const;
+};
+
+// parse_json_object
+//   text 전체가 JSON 오브젝트 하나인지 검증하고 최상위 멤버를 반환한다.
+//   실패 시 "<이유> at offset N".
+[[nodiscard]] auto parse_json_object(std::string_view text)
+    -> std::expected<JsonObject, std::string>;
+
+// json_string_value / json_uint64_value
+//   parse_json_object 가 검증한 멤버의 값을 꺼낸다 (종류가 다르면 nullopt).
+//   문자열은 \uXXXX (서로게이트 쌍 포함)를 UTF-8 로 푼다.
+[[nodiscard]] std::optional<std::string> json_string_value(const JsonMember& member);
+[[nodiscard]] std::optional<std::uint64_t> json_uint64_value(const JsonMember& member);
+
+// json_object_delta
+//   current 의 멤버 중 previous 에 없거나 원문이 달라진 멤버만 담은 오브젝트 텍스트.
+//   바뀐 멤버가 없으면 "{}". 두 오브젝트의 멤버 순서가 같으면 비교는 멤버당 O(1) 이다.
+[[nodiscard]] std::string json_object_delta(const JsonObject& current, const JsonObject& previous);
+
+// ---------------------------------------------------------------------------
+// ControlRequest
+//   {"command":"...","version":N,"payload":{...}}
+//   command : 최상위 문자열 "command" (없거나 문자열이 아니면 빈 문자열)
+//   version : 최상위 "version" (없으면 1)
+//   payload : 최상위 "payload" 오브젝트의 멤버 (없거나 오브젝트가 아니면 비어 있음)
+// ---------------------------------------------------------------------------
+struct ControlRequest {
+    std::string command;
+    std::uint64_t version{1};
+    JsonObject payload;
+};
+
+// parse_control_request
+//   문법 오류만 실패로 돌려준다. command 누락 판단은 호출자 몫이다.
+[[nodiscard]] auto parse_control_request(std::string_view json)
+    -> std::expected<ControlRequest, std::string>;
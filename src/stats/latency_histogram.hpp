@@ -0,0 +1,194 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// latency_histogram.hpp
+//
+// 데이터패스 단계별 지연 히스토그램. 헤더 전용 (atomic inline 구현).
+//
+// [버킷 구조 — HDR 방식 log-linear]
+// - 값 단위: 나노초.
+// - 0~15ns 는 1ns 단위 정확 버킷.
+// - 그 이상은 2의 거듭제곱 구간마다 16개 선형 하위 버킷 → 상대 오차 최대 1/16 (6.25%).
+// - 2^36ns (약 68.7초) 이상은 마지막 버킷에 기록한다.
+// - 백분위 값은 버킷 상한(관측 최대값으로 clamp)으로 보고한다 → 실제보다 작게 보고하지 않음.
+//
+// [스레드 안전성]
+// - record(): 스레드별 샤드(캐시 라인 정렬)의 버킷 하나와 합계에 relaxed fetch_add.
+//   io_context 스레드 수가 kShardCount 이하이면 샤드 간 경합이 없다.
+// - summarize(): 모든 샤드를 합산한다 (조회 경로 전용, 수 µs).
+//   갱신과 동시에 호출되면 서로 다른 시점의 카운트가 섞일 수 있다 (근사 스냅샷).
+// ---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "stats/thread_slot.hpp"
+
+// ---------------------------------------------------------------------------
+// LatencyStage
+//   측정 단계. 값은 StatsSnapshot::latency 인덱스로 사용된다.
+//   kParse            : SqlParser::parse
+//   kInjectionCheck   : InjectionDetector::check
+//   kPolicyEvaluate   : PolicyEngine::evaluate / evaluate_cached
+//   kUpstreamResponse : 쿼리 전달 시작 ~ 서버 응답 릴레이 완료
+//   kProxyOverhead    : 쿼리 수신 후 전달(또는 차단) 직전까지 프록시가 더한 시간
+// ---------------------------------------------------------------------------
+enum class LatencyStage : std::uint8_t {
+    kParse = 0,
+    kInjectionCheck = 1,
+    kPolicyEvaluate = 2,
+    kUpstreamResponse = 3,
+    kProxyOverhead = 4,
+};
+
+inline constexpr std::size_t kLatencyStageCount = 5;
+
+// UDS / 메트릭 출력용 단계 이름
+[[nodiscard]] constexpr std::string_view latency_stage_name(LatencyStage stage) noexcept {
+    switch (stage) {
+        case LatencyStage::kParse:
+            return "parse";
+        case LatencyStage::kInjectionCheck:
+            return "injection_check";
+        case LatencyStage::kPolicyEvaluate:
+            return "policy_evaluate";
+        case LatencyStage::kUpstreamResponse:
+            return "upstream_response";
+        case LatencyStage::kProxyOverhead:
+            return "proxy_overhead";
+    }
+    return "unknown";
+}
+
+// ---------------------------------------------------------------------------
+// LatencySummary
+//   히스토그램 요약 (µs 단위). count == 0 이면 모든 값 0.
+//   sum_us 는 /metrics summary 의 _sum 용 (평균 = sum_us / count).
+// ---------------------------------------------------------------------------
+struct LatencySummary {
+    std::uint64_t count{0};
+    double sum_us{0.0};
+    double p50_us{0.0};
+    double p99_us{0.0};
+    double p999_us{0.0};
+    double max_us{0.0};
+};
+
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr std::uint64_t kSubBuckets = 1ULL << kSubBucketBits;
+    static constexpr unsigned kMaxExponent = 36;  // 2^36 ns 이상은 마지막 버킷
+    static constexpr std::size_t kBucketCount =
+        kSubBuckets + (kMaxExponent - kSubBucketBits) * kSubBuckets;
+    static constexpr std::size_t kShardCount = 8;
+
+    LatencyHistogram() noexcept = default;
+    ~LatencyHistogram() = default;
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    LatencyHistogram(LatencyHistogram&&) = delete;
+    LatencyHistogram& operator=(LatencyHistogram&&) = delete;
+
+    // bucket_index: 나노초 값 → 버킷 인덱스
+    [[nodiscard]] static constexpr std::size_t bucket_index(std::uint64_t ns) noexcept {
+        if (ns < kSubBuckets) {
+            return static_cast<std::size_t>(ns);
+        }
+        const auto exponent = static_cast<unsigned>(std::bit_width(ns)) - 1;
+        if (exponent >= kMaxExponent) {
+            return kBucketCount - 1;
+        }
+        const unsigned shift = exponent - kSubBucketBits;
+        const auto sub = (ns >> shift) - kSubBuckets;
+        return static_cast<std::size_t>(kSubBuckets + shift * kSubBuckets + sub);
+    }
+
+    // bucket_upper_bound: 버킷에 들어가는 최대 나노초 값
+    [[nodiscard]] static constexpr std::uint64_t bucket_upper_bound(std::size_t index) noexcept {
+        if (index < kSubBuckets) {
+            return index;
+        }
+        const auto shift = static_cast<unsigned>((index - kSubBuckets) / kSubBuckets);
+        const auto sub = static_cast<std::uint64_t>((index - kSubBuckets) % kSubBuckets);
+        return ((kSubBuckets + sub + 1) << shift) - 1;
+    }
+
+    // record: 데이터패스 (noexcept, 락 없음)
+    void record(std::chrono::nanoseconds elapsed) noexcept {
+        const auto ns = elapsed.count() > 0 ? static_cast<std::uint64_t>(elapsed.count()) : 0;
+        auto& shard = shards_[shard_index()];
+        shard.counts[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum_ns.fetch_add(ns, std::memory_order_relaxed);
+        auto prev_max = shard.max_ns.load(std::memory_order_relaxed);
+        while (ns > prev_max &&
+               !shard.max_ns.compare_exchange_weak(prev_max, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    // summarize: 샤드 합산 후 p50 / p99 / p99.9 / max 를 계산한다 (조회 경로)
+    [[nodiscard]] LatencySummary summarize() const noexcept {
+        std::array<std::uint64_t, kBucketCount> merged{};
+        std::uint64_t total = 0;
+        std::uint64_t max_ns = 0;
+        std::uint64_t sum_ns = 0;
+        for (const auto& shard : shards_) {
+            for (std::size_t i = 0; i < kBucketCount; ++i) {
+                const auto c = shard.counts[i].load(std::memory_order_relaxed);
+                merged[i] += c;
+                total += c;
+            }
+            max_ns = std::max(max_ns, shard.max_ns.load(std::memory_order_relaxed));
+            sum_ns += shard.sum_ns.load(std::memory_order_relaxed);
+        }
+        if (total == 0) {
+            return LatencySummary{};
+        }
+
+        const auto percentile_us = [&](double q) noexcept {
+            // rank = ceil(q * total), 최소 1
+            auto rank = static_cast<std::uint64_t>(q * static_cast<double>(total));
+            if (static_cast<double>(rank) < q * static_cast<double>(total)) {
+                ++rank;
+            }
+            rank = std::max<std::uint64_t>(rank, 1);
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < kBucketCount; ++i) {
+                seen += merged[i];
+                if (seen >= rank) {
+                    return static_cast<double>(std::min(bucket_upper_bound(i), max_ns)) / 1000.0;
+                }
+            }
+            return static_cast<double>(max_ns) / 1000.0;
+        };
+
+        return LatencySummary{
+            .count = total,
+            .sum_us = static_cast<double>(sum_ns) / 1000.0,
+            .p50_us = percentile_us(0.50),
+            .p99_us = percentile_us(0.99),
+            .p999_us = percentile_us(0.999),
+            .max_us = static_cast<double>(max_ns) / 1000.0,
+        };
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<std::uint64_t>, kBucketCount> counts{};
+        std::atomic<std::uint64_t> max_ns{0};
+        std::atomic<std::uint64_t> sum_ns{0};
+    };
+
+    [[nodiscard]] static std::size_t shard_index() noexcept {
+        return stats_thread_slot() % kShardCount;
+    }
+
+    std::array<Shard, kShardCount> shards_{};
+};
@@ -0,0 +1,229 @@
+// ---------------------------------------------------------------------------
+// metrics_exporter.cpp
+//
+// OpenMetrics 텍스트 렌더러. fmt::format_to 로 out 버퍼에 직접 append 한다
+// (중간 std::string 생성 없음).
+// ---------------------------------------------------------------------------
+
+#include "stats/metrics_exporter.hpp"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace {
+
+// 메타데이터 (# TYPE / # HELP)
+void write_meta(std::string& out,
+                std::string_view name,
+                std::string_view type,
+                std::string_view help) {
+    fmt::format_to(std::back_inserter(out), "# TYPE {} {}\n# HELP {} {}\n", name, type, name, help);
+}
+
+void write_counter(std::string& out,
+                   std::string_view name,
+                   std::string_view help,
+                   std::uint64_t value) {
+    write_meta(out, name, "counter", help);
+    fmt::format_to(std::back_inserter(out), "{}_total {}\n", name, value);
+}
+
+void write_gauge(std::string& out,
+                 std::string_view name,
+                 std::string_view help,
+                 std::uint64_t value) {
+    write_meta(out, name, "gauge", help);
+    fmt::format_to(std::back_inserter(out), "{} {}\n", name, value);
+}
+
+void write_window_gauge(std::string& out,
+                        std::string_view name,
+                        std::string_view help,
+                        double v1s,
+                        double v10s,
+                        double v60s) {
+    write_meta(out, name, "gauge", help);
+    fmt::format_to(std::back_inserter(out),
+                   "{0}{{window=\"1s\"}} {1}\n"
+                   "{0}{{window=\"10s\"}} {2}\n"
+                   "{0}{{window=\"60s\"}} {3}\n",
+                   name,
+                   v1s,
+                   v10s,
+                   v60s);
+}
+
+// 라벨 값 이스케이프 (OpenMetrics: \\, \", \n)
+void write_label_value(std::string& out, std::string_view value) {
+    for (const char c : value) {
+        switch (c) {
+            case '\\':
+                out += "\\\\";
+                break;
+            case '"':
+                out += "\\\"";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            default:
+                out += c;
+                break;
+        }
+    }
+}
+
+void write_latency(std::string& out, const StatsSnapshot& s) {
+    constexpr std::string_view kName = "dbgate_stage_latency_seconds";
+    fmt::format_to(std::back_inserter(out), "# TYPE {0} summary\n# UNIT {0} seconds\n", kName);
+    fmt::format_to(std::back_inserter(out),
+                   "# HELP {} Data path stage latency since process start.\n",
+                   kName);
+    for (std::size_t i = 0; i < kLatencyStageCount; ++i) {
+        const auto& l = s.latency[i];
+        const auto stage = latency_stage_name(static_cast<LatencyStage>(i));
+        fmt::format_to(std::back_inserter(out),
+                       "{0}{{stage=\"{1}\",quantile=\"0.5\"}} {2}\n"
+                       "{0}{{stage=\"{1}\",quantile=\"0.99\"}} {3}\n"
+                       "{0}{{stage=\"{1}\",quantile=\"0.999\"}} {4}\n"
+                       "{0}_sum{{stage=\"{1}\"}} {5}\n"
+                       "{0}_count{{stage=\"{1}\"}} {6}\n",
+                       kName,
+                       stage,
+                       l.p50_us / 1e6,
+                       l.p99_us / 1e6,
+                       l.p999_us / 1e6,
+                       l.sum_us / 1e6,
+                       l.count);
+    }
+
+    constexpr std::string_view kMaxName = "dbgate_stage_latency_max_seconds";
+    fmt::format_to(std::back_inserter(out), "# TYPE {0} gauge\n# UNIT {0} seconds\n", kMaxName);
+    fmt::format_to(std::back_inserter(out),
+                   "# HELP {} Largest observed stage latency since process start.\n",
+                   kMaxName);
+    for (std::size_t i = 0; i < kLatencyStageCount; ++i) {
+        fmt::format_to(std::back_inserter(out),
+                       "{}{{stage=\"{}\"}} {}\n",
+                       kMaxName,
+                       latency_stage_name(static_cast<LatencyStage>(i)),
+                       s.latency[i].max_us / 1e6);
+    }
+}
+
+void write_rule_blocks(std::string& out, const RuleCounterTable& rule_blocks) {
+    constexpr std::string_view kName = "dbgate_rule_blocks";
+    write_meta(out, kName, "counter", "Blocked queries by matched policy rule.");
+    rule_blocks.for_each([&out, kName](std::string_view rule, std::uint64_t count) {
+        fmt::format_to(std::back_inserter(out), "{}_total{{rule=\"", kName);
+        write_label_value(out, rule);
+        fmt::format_to(std::back_inserter(out), "\"}} {}\n", count);
+    });
+    write_counter(out,
+                  "dbgate_rule_blocks_untracked",
+                  "Blocked queries not attributed to a rule because the rule table is full.",
+                  rule_blocks.overflow());
+}
+
+void write_tls_handshakes(std::string& out, const StatsSnapshot& s) {
+    constexpr std::string_view kName = "dbgate_tls_handshakes";
+    write_meta(out, kName, "counter", "TLS handshakes by leg and session resumption.");
+    fmt::format_to(std::back_inserter(out),
+                   "{0}_total{{side=\"frontend\",resumed=\"true\"}} {1}\n"
+                   "{0}_total{{side=\"frontend\",resumed=\"false\"}} {2}\n"
+                   "{0}_total{{side=\"backend\",resumed=\"true\"}} {3}\n"
+                   "{0}_total{{side=\"backend\",resumed=\"false\"}} {4}\n",
+                   kName,
+                   s.tls_frontend_resumed,
+                   s.tls_frontend_full,
+                   s.tls_backend_resumed,
+                   s.tls_backend_full);
+}
+
+}  // namespace
+
+void render_openmetrics(const StatsSnapshot& snapshot,
+                        const RuleCounterTable& rule_blocks,
+                        std::string& out) {
+    const auto& s = snapshot;
+    out.clear();
+
+    write_counter(out, "dbgate_connections", "Accepted client connections.", s.total_connections);
+    write_gauge(
+        out, "dbgate_active_sessions", "Currently open client sessions.", s.active_sessions);
+    write_counter(out, "dbgate_queries", "Queries evaluated by the proxy.", s.total_queries);
+    write_counter(out, "dbgate_queries_blocked", "Queries blocked by policy.", s.blocked_queries);
+    write_counter(out,
+                  "dbgate_queries_monitored_blocks",
+                  "Queries that would have been blocked in monitor mode.",
+                  s.monitored_blocks);
+    write_window_gauge(out,
+                       "dbgate_qps",
+                       "Queries per second over a sliding window.",
+                       s.qps,
+                       s.qps_10s,
+                       s.qps_60s);
+    write_window_gauge(out,
+                       "dbgate_block_ratio",
+                       "Fraction of queries blocked over a sliding window.",
+                       s.block_rate_1s,
+                       s.block_rate_10s,
+                       s.block_rate_60s);
+
+    write_counter(out, "dbgate_pool_hits", "Backend pool connection reuses.", s.pool_hits);
+    write_counter(
+        out, "dbgate_pool_misses", "Backend connections opened on pool miss.", s.pool_misses);
+    write_gauge(out, "dbgate_pool_idle", "Idle backend connections in the pool.", s.pool_idle);
+    write_counter(out,
+                  "dbgate_pool_evictions",
+                  "Backend connections evicted from the pool.",
+                  s.pool_evictions);
+
+    write_counter(
+        out, "dbgate_log_dropped", "Log entries dropped by the async queue.", s.log_dropped);
+    write_gauge(out, "dbgate_log_queued", "Log entries waiting in the async queue.", s.log_queued);
+    write_counter(out,
+                  "dbgate_log_suppressed",
+                  "Allowed query logs skipped by sampling.",
+                  s.log_suppressed);
+    write_counter(out,
+                  "dbgate_result_rows_limited",
+                  "Result sets cut at data_protection.max_result_rows.",
+                  s.result_rows_limited);
+
+    write_gauge(out,
+                "dbgate_relay_buffer_bytes",
+                "Relay buffer memory held by all sessions.",
+                s.relay_buffer_bytes);
+    write_gauge(out,
+                "dbgate_relay_buffer_peak_bytes",
+                "Highest relay buffer memory since start.",
+                s.relay_buffer_peak_bytes);
+    write_counter(out,
+                  "dbgate_relay_budget_waits",
+                  "Server reads paused by the global relay buffer limit.",
+                  s.relay_budget_waits);
+    write_counter(out,
+                  "dbgate_connections_rejected",
+                  "Accepted connections closed before a session was created.",
+                  s.connections_rejected);
+    write_counter(out,
+                  "dbgate_handshake_timeouts",
+                  "Sessions closed for not finishing the handshake in time.",
+                  s.handshake_timeouts);
+    write_counter(out,
+                  "dbgate_idle_timeouts",
+                  "Sessions closed after waiting too long for the next command.",
+                  s.idle_timeouts);
+
+    write_tls_handshakes(out, s);
+
+    write_latency(out, s);
+    write_rule_blocks(out, rule_blocks);
+
+    out += "# EOF\n";
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// metrics_exporter.hpp
+//
+// StatsSnapshot / 규칙별 차단 카운터 → OpenMetrics 텍스트 (Prometheus `/metrics`).
+//
+// [설계 의도]
+// - HealthCheck 의 GET /metrics 에서 호출한다 (조회 경로).
+// - 출력은 호출자가 넘긴 버퍼에 덮어쓴다. clear() 후 append 만 하므로
+//   같은 버퍼를 재사용하면 두 번째 scrape 부터 할당이 없다.
+// - 데이터패스와 공유하는 상태는 StatsCollector 의 atomic 읽기뿐이다.
+//
+// [메트릭 이름]
+//   카운터는 `dbgate_<name>_total`, 윈도우 게이지는 window="1s|10s|60s" 라벨,
+//   단계별 지연은 summary `dbgate_stage_latency_seconds{stage,quantile}`.
+//   전체 목록은 docs/runbook.md "Prometheus 메트릭" 참고.
+// ---------------------------------------------------------------------------
+
+#include <string>
+#include <string_view>
+
+#include "stats/rule_counters.hpp"
+#include "stats/stats_collector.hpp"
+
+// Prometheus 가 OpenMetrics 로 파싱하도록 하는 Content-Type
+inline constexpr std::string_view kOpenMetricsContentType =
+    "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+// ---------------------------------------------------------------------------
+// render_openmetrics
+//   snapshot 과 rule_blocks 를 OpenMetrics 텍스트로 out 에 기록한다 ("# EOF" 로 끝남).
+//   out 의 기존 내용은 지워지고 capacity 는 유지된다.
+// ---------------------------------------------------------------------------
+void render_openmetrics(const StatsSnapshot& snapshot,
+                        const RuleCounterTable& rule_blocks,
+                        std::string& out);
@@ -0,0 +1,266 @@
+// ---------------------------------------------------------------------------
+// query_topk.cpp
+//
+// 샤드별 mutex + stream-summary 로 구현한 Space-Saving Top-K.
+// ---------------------------------------------------------------------------
+
+#include "stats/query_topk.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <functional>
+
+// ---------------------------------------------------------------------------
+// QueryLatencyBuckets
+// ---------------------------------------------------------------------------
+std::size_t QueryLatencyBuckets::bucket_index(std::uint64_t us) noexcept {
+    if (us < kSubBuckets) {
+        return static_cast<std::size_t>(us);
+    }
+    const auto exponent = static_cast<unsigned>(std::bit_width(us)) - 1;
+    if (exponent >= kMaxExponent) {
+        return kBucketCount - 1;
+    }
+    const unsigned shift = exponent - kSubBucketBits;
+    const auto sub = (us >> shift) - kSubBuckets;
+    return static_cast<std::size_t>(kSubBuckets + shift * kSubBuckets + sub);
+}
+
+std::uint64_t QueryLatencyBuckets::bucket_upper_bound(std::size_t index) noexcept {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    const auto shift = static_cast<unsigned>((index - kSubBuckets) / kSubBuckets);
+    const auto sub = static_cast<std::uint64_t>((index - kSubBuckets) % kSubBuckets);
+    return ((kSubBuckets + sub + 1) << shift) - 1;
+}
+
+void QueryLatencyBuckets::record(std::uint64_t us) noexcept {
+    ++counts[bucket_index(us)];
+    ++count;
+    sum_us += us;
+    max_us = std::max(max_us, us);
+}
+
+std::uint64_t QueryLatencyBuckets::percentile(double q) const noexcept {
+    if (count == 0) {
+        return 0;
+    }
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(bucket_upper_bound(i), max_us);
+        }
+    }
+    return max_us;
+}
+
+// ---------------------------------------------------------------------------
+// 정렬
+// ---------------------------------------------------------------------------
+namespace {
+
+std::uint64_t sort_value(const QueryTopEntry& e, QuerySortKey key) noexcept {
+    switch (key) {
+        case QuerySortKey::kBlocked:
+            return e.blocked;
+        case QuerySortKey::kUpstreamTime:
+            return e.upstream_us;
+        case QuerySortKey::kP99:
+            return e.p99_us;
+        case QuerySortKey::kCount:
+            break;
+    }
+    return e.count;
+}
+
+}  // namespace
+
+auto parse_query_sort_key(std::string_view name) noexcept -> std::optional<QuerySortKey> {
+    if (name == "count") {
+        return QuerySortKey::kCount;
+    }
+    if (name == "blocked") {
+        return QuerySortKey::kBlocked;
+    }
+    if (name == "upstream_us") {
+        return QuerySortKey::kUpstreamTime;
+    }
+    if (name == "p99_us") {
+        return QuerySortKey::kP99;
+    }
+    return std::nullopt;
+}
+
+auto top_queries(const std::vector<QueryTopEntry>& entries, QuerySortKey key, std::size_t limit)
+    -> std::vector<QueryTopEntry> {
+    std::vector<const QueryTopEntry*> order;
+    order.reserve(entries.size());
+    for (const auto& e : entries) {
+        order.push_back(&e);
+    }
+    const std::size_t count = std::min(limit, order.size());
+    std::partial_sort(order.begin(),
+                      order.begin() + static_cast<std::ptrdiff_t>(count),
+                      order.end(),
+                      [key](const QueryTopEntry* a, const QueryTopEntry* b) {
+                          const auto va = sort_value(*a, key);
+                          const auto vb = sort_value(*b, key);
+                          if (va != vb) {
+                              return va > vb;
+                          }
+                          return a->count != b->count ? a->count > b->count : a->hash < b->hash;
+                      });
+
+    std::vector<QueryTopEntry> top;
+    top.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        top.push_back(*order[i]);
+    }
+    return top;
+}
+
+// ---------------------------------------------------------------------------
+// QueryTopK
+// ---------------------------------------------------------------------------
+QueryTopK::QueryTopK(std::size_t capacity)
+    : shard_capacity_{capacity == 0 ? 0 : (capacity + kShardCount - 1) / kShardCount} {
+    for (auto& shard : shards_) {
+        shard.index.reserve(shard_capacity_);
+    }
+}
+
+std::uint64_t QueryTopK::hash_fingerprint(std::string_view fingerprint) noexcept {
+    const auto h = static_cast<std::uint64_t>(std::hash<std::string_view>{}(fingerprint));
+    return h == 0 ? 1 : h;
+}
+
+QueryTopK::Shard& QueryTopK::shard_for(std::uint64_t hash) noexcept {
+    // 하위 비트는 unordered_map 버킷 선택에 쓰이므로 상위 비트로 샤드를 고른다
+    return shards_[(hash >> 56U) % kShardCount];
+}
+
+const QueryTopK::Shard& QueryTopK::shard_for(std::uint64_t hash) const noexcept {
+    return shards_[(hash >> 56U) % kShardCount];
+}
+
+void QueryTopK::increment(Shard& shard, std::list<Counter>::iterator counter) {
+    const auto from = counter->bucket;
+    auto to = std::next(from);
+    if (to == shard.buckets.end() || to->count != from->count + 1) {
+        to = shard.buckets.insert(to, Bucket{.count = from->count + 1, .counters = {}});
+    }
+    // splice 는 노드를 옮길 뿐이므로 index 가 가진 iterator 는 그대로 유효하다
+    to->counters.splice(to->counters.end(), from->counters, counter);
+    counter->bucket = to;
+    if (from->counters.empty()) {
+        shard.buckets.erase(from);
+    }
+}
+
+void QueryTopK::assign(Counter& counter,
+                       std::uint64_t hash,
+                       std::string_view fingerprint,
+                       bool blocked) {
+    counter.hash = hash;
+    counter.truncated = fingerprint.size() > kMaxFingerprintText;
+    counter.fingerprint.assign(fingerprint.substr(0, kMaxFingerprintText));
+    counter.blocked = blocked ? 1 : 0;
+    counter.latency = QueryLatencyBuckets{};
+}
+
+void QueryTopK::record(std::uint64_t hash, std::string_view fingerprint, bool blocked) {
+    if (!enabled()) {
+        return;
+    }
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+
+    auto& shard = shard_for(hash);
+    const std::lock_guard lock{shard.mutex};
+
+    if (const auto it = shard.index.find(hash); it != shard.index.end()) {
+        if (blocked) {
+            ++it->second->blocked;
+        }
+        increment(shard, it->second);
+        return;
+    }
+
+    if (shard.index.size() < shard_capacity_) {
+        if (shard.buckets.empty() || shard.buckets.front().count != 1) {
+            shard.buckets.push_front(Bucket{.count = 1, .counters = {}});
+        }
+        auto& ones = shard.buckets.front();
+        ones.counters.emplace_back();
+        const auto counter = std::prev(ones.counters.end());
+        counter->bucket = shard.buckets.begin();
+        assign(*counter, hash, fingerprint, blocked);
+        shard.index.emplace(hash, counter);
+        return;
+    }
+
+    // 가득 참: 최소 카운트 카운터를 새 형태에 넘긴다 (count = min + 1, error = min)
+    auto& min_bucket = shard.buckets.front();
+    const auto victim = min_bucket.counters.begin();
+    auto node = shard.index.extract(victim->hash);  // 노드를 재사용한다 (할당 없음)
+    node.key() = hash;
+    shard.index.insert(std::move(node));
+    victim->error = min_bucket.count;
+    assign(*victim, hash, fingerprint, blocked);
+    increment(shard, victim);
+}
+
+void QueryTopK::record_untracked() noexcept {
+    if (enabled()) {
+        untracked_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void QueryTopK::record_latency(std::uint64_t hash, std::chrono::nanoseconds upstream) noexcept {
+    if (!enabled() || hash == 0) {
+        return;
+    }
+    const auto us = upstream.count() > 0
+                        ? static_cast<std::uint64_t>(
+                              std::chrono::duration_cast<std::chrono::microseconds>(upstream)
+                                  .count())
+                        : 0;
+
+    auto& shard = shard_for(hash);
+    const std::lock_guard lock{shard.mutex};
+    if (const auto it = shard.index.find(hash); it != shard.index.end()) {
+        it->second->latency.record(us);
+    }
+}
+
+QueryTopKSnapshot QueryTopK::snapshot() const {
+    QueryTopKSnapshot snap{.entries = {},
+                           .capacity = capacity(),
+                           .recorded = recorded_.load(std::memory_order_relaxed),
+                           .untracked = untracked_.load(std::memory_order_relaxed)};
+    for (const auto& shard : shards_) {
+        const std::lock_guard lock{shard.mutex};
+        for (const auto& bucket : shard.buckets) {
+            for (const auto& c : bucket.counters) {
+                snap.entries.push_back(QueryTopEntry{
+                    .hash = c.hash,
+                    .fingerprint = c.fingerprint,
+                    .truncated = c.truncated,
+                    .count = bucket.count,
+                    .error = c.error,
+                    .blocked = c.blocked,
+                    .latency_count = c.latency.count,
+                    .upstream_us = c.latency.sum_us,
+                    .p50_us = c.latency.percentile(0.50),
+                    .p99_us = c.latency.percentile(0.99),
+                    .max_us = c.latency.max_us,
+                });
+            }
+        }
+    }
+    return snap;
+}
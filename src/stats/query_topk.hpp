@@ -0,0 +1,193 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// query_topk.hpp
+//
+// 쿼리 형태(fingerprint) 별 Top-K 집계 (UDS "top_queries" 명령 — hot / slow 구문).
+//
+// [설계 의도]
+// 어떤 구문 형태가 부하나 지연을 만드는지는 감사 로그를 오프라인으로 집계해야만 알 수 있었다.
+// 판정 캐시가 이미 커맨드마다 fingerprint_query() 를 계산하므로, 같은 키로 고정 크기
+// Space-Saving 스케치를 갱신해 상위 형태를 프록시 안에서 바로 조회한다.
+//   - 메모리는 capacity 개 카운터로 고정된다 (구문 형태 수와 무관).
+//   - 갱신은 O(1): 카운트가 같은 카운터를 버킷 하나로 묶은 정렬 리스트(stream-summary)에서
+//     카운터를 다음 버킷으로 옮기고, 꽉 찼으면 최소 버킷의 카운터를 새 형태에 넘겨준다.
+//
+// [정확도 — Space-Saving]
+// count 는 실제 빈도 이상으로 추정되며, 실제 빈도는 count - error 이상이다.
+// 샤드 하나가 N 건 중 k 개 카운터를 가지면 N/k 건을 넘는 형태는 반드시 추적된다.
+// blocked / 지연은 카운터가 현재 형태를 맡은 뒤의 값만 담는다 (교체 시 0 부터 시작).
+//
+// [키]
+// fingerprint 의 64bit 해시다. 파이프라이닝 모드의 응답 릴레이는 fingerprint 문자열
+// (커맨드 QueryArena) 이 사라진 뒤 끝나므로 지연은 해시로만 귀속한다.
+// 해시 충돌 시 두 형태가 한 카운터로 합쳐진다 (통계 전용, 판정에는 쓰이지 않는다).
+// 표시용 fingerprint 는 kMaxFingerprintText 바이트까지만 보관한다 (truncated).
+//
+// [스레드 안전성]
+// 해시 상위 비트로 샤드를 나누고 샤드별 mutex 로 보호한다 (DecisionCache 와 같은 방식).
+// snapshot() 은 샤드를 하나씩 잠그고 복사한다 (조회 경로 전용).
+// ---------------------------------------------------------------------------
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// QueryLatencyBuckets
+//   카운터별 업스트림 지연 분포 (µs, log-linear).
+//   0~3µs 는 1µs 단위, 그 이상은 2의 거듭제곱 구간마다 4개 선형 하위 버킷 (상대 오차 ≤ 25%).
+//   2^27µs (약 134초) 이상은 마지막 버킷. 백분위는 버킷 상한(관측 최대값으로 clamp)이다.
+//   카운터를 보호하는 샤드 mutex 안에서만 갱신한다 (atomic 아님).
+// ---------------------------------------------------------------------------
+struct QueryLatencyBuckets {
+    static constexpr unsigned kSubBucketBits = 2;
+    static constexpr std::uint64_t kSubBuckets = 1ULL << kSubBucketBits;
+    static constexpr unsigned kMaxExponent = 27;
+    static constexpr std::size_t kBucketCount =
+        kSubBuckets + (kMaxExponent - kSubBucketBits) * kSubBuckets;
+
+    std::array<std::uint64_t, kBucketCount> counts{};
+    std::uint64_t count{0};
+    std::uint64_t sum_us{0};
+    std::uint64_t max_us{0};
+
+    [[nodiscard]] static std::size_t bucket_index(std::uint64_t us) noexcept;
+    [[nodiscard]] static std::uint64_t bucket_upper_bound(std::size_t index) noexcept;
+
+    void record(std::uint64_t us) noexcept;
+    // q: 0~1 분위. count == 0 이면 0
+    [[nodiscard]] std::uint64_t percentile(double q) const noexcept;
+};
+
+// ---------------------------------------------------------------------------
+// QueryTopEntry
+//   hash        : fingerprint 해시 (16진수로 표시)
+//   fingerprint : 정규화 구문 (최대 kMaxFingerprintText 바이트, 넘으면 truncated)
+//   count/error : Space-Saving 추정치와 과대 추정 상한
+//   blocked     : 정책 차단 수
+//   latency_count / upstream_us : 응답 릴레이까지 끝난 쿼리 수 / 누적 업스트림 시간
+// ---------------------------------------------------------------------------
+struct QueryTopEntry {
+    std::uint64_t hash{0};
+    std::string fingerprint{};
+    bool truncated{false};
+    std::uint64_t count{0};
+    std::uint64_t error{0};
+    std::uint64_t blocked{0};
+    std::uint64_t latency_count{0};
+    std::uint64_t upstream_us{0};
+    std::uint64_t p50_us{0};
+    std::uint64_t p99_us{0};
+    std::uint64_t max_us{0};
+};
+
+// ---------------------------------------------------------------------------
+// QueryTopKSnapshot
+//   entries   : 추적 중인 카운터 전체 (순서 없음)
+//   recorded  : fingerprint 가 있어 스케치에 반영된 쿼리 수
+//   untracked : fingerprint 가 없어 반영하지 못한 쿼리 수 (멀티 스테이트먼트 등)
+// ---------------------------------------------------------------------------
+struct QueryTopKSnapshot {
+    std::vector<QueryTopEntry> entries{};
+    std::size_t capacity{0};
+    std::uint64_t recorded{0};
+    std::uint64_t untracked{0};
+};
+
+enum class QuerySortKey : std::uint8_t {
+    kCount = 0,
+    kBlocked = 1,
+    kUpstreamTime = 2,
+    kP99 = 3,
+};
+
+// "count" / "blocked" / "upstream_us" / "p99_us"
+[[nodiscard]] auto parse_query_sort_key(std::string_view name) noexcept
+    -> std::optional<QuerySortKey>;
+
+// entries 중 key 내림차순 상위 limit 개 (동률은 count 내림차순, 다음 hash 오름차순)
+[[nodiscard]] auto top_queries(const std::vector<QueryTopEntry>& entries,
+                               QuerySortKey key,
+                               std::size_t limit) -> std::vector<QueryTopEntry>;
+
+class QueryTopK {
+public:
+    static constexpr std::size_t kShardCount = 16;
+    // 표시용 fingerprint 보관 상한 (키는 전체 fingerprint 의 해시)
+    static constexpr std::size_t kMaxFingerprintText = 1024;
+
+    // capacity == 0 이면 비활성 (record 는 no-op). 샤드당 최소 1개 카운터.
+    explicit QueryTopK(std::size_t capacity);
+
+    QueryTopK(const QueryTopK&) = delete;
+    QueryTopK& operator=(const QueryTopK&) = delete;
+    QueryTopK(QueryTopK&&) = delete;
+    QueryTopK& operator=(QueryTopK&&) = delete;
+    ~QueryTopK() = default;
+
+    // fingerprint 해시. 0 은 "해시 없음" 으로 예약되어 나오지 않는다 (PendingResponse 등).
+    [[nodiscard]] static std::uint64_t hash_fingerprint(std::string_view fingerprint) noexcept;
+
+    // record: 쿼리 1건 (정책 판정 직후). 새 형태는 최소 카운터를 넘겨받는다.
+    void record(std::uint64_t hash, std::string_view fingerprint, bool blocked);
+    // record_untracked: fingerprint 가 없는 쿼리 1건
+    void record_untracked() noexcept;
+    // record_latency: 응답 릴레이 완료. 그 사이 카운터가 다른 형태로 넘어갔으면 버린다.
+    void record_latency(std::uint64_t hash, std::chrono::nanoseconds upstream) noexcept;
+
+    [[nodiscard]] QueryTopKSnapshot snapshot() const;
+
+    [[nodiscard]] bool enabled() const noexcept { return shard_capacity_ > 0; }
+    // 실제 카운터 수 (샤드 수의 배수로 올림)
+    [[nodiscard]] std::size_t capacity() const noexcept { return shard_capacity_ * kShardCount; }
+
+private:
+    struct Bucket;
+
+    struct Counter {
+        std::uint64_t hash{0};
+        std::string fingerprint{};
+        bool truncated{false};
+        std::uint64_t error{0};
+        std::uint64_t blocked{0};
+        QueryLatencyBuckets latency{};
+        std::list<Bucket>::iterator bucket{};
+    };
+
+    // 카운트가 같은 카운터 묶음. Shard::buckets 는 count 오름차순이며 빈 버킷은 없다.
+    struct Bucket {
+        std::uint64_t count{0};
+        std::list<Counter> counters{};
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Bucket> buckets{};
+        std::unordered_map<std::uint64_t, std::list<Counter>::iterator> index{};
+    };
+
+    [[nodiscard]] Shard& shard_for(std::uint64_t hash) noexcept;
+    [[nodiscard]] const Shard& shard_for(std::uint64_t hash) const noexcept;
+
+    // 카운터를 count + 1 버킷으로 옮긴다
+    static void increment(Shard& shard, std::list<Counter>::iterator counter);
+    static void assign(Counter& counter,
+                       std::uint64_t hash,
+                       std::string_view fingerprint,
+                       bool blocked);
+
+    std::size_t shard_capacity_;
+    std::array<Shard, kShardCount> shards_{};
+    std::atomic<std::uint64_t> recorded_{0};
+    std::atomic<std::uint64_t> untracked_{0};
+};
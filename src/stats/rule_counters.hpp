@@ -0,0 +1,119 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// rule_counters.hpp
+//
+// 규칙 ID 별 카운터 테이블. 헤더 전용 (atomic inline 구현).
+//
+// [구조]
+// - 고정 용량 open addressing 테이블 (kCapacity 슬롯, 선형 탐사).
+// - 슬롯은 처음 등장한 규칙 ID 가 CAS 로 점유하며 이후 제거되지 않는다.
+//   규칙 ID 는 정책 엔진의 고정 문자열 + 설정 파일의 사용자 규칙이므로 종류가 한정적이다.
+// - 테이블이 가득 차면 overflow() 카운터에 합산한다 (카운트 유실 없음, 규칙 구분만 포기).
+// - kMaxNameLength 를 넘는 규칙 ID 는 잘라서 저장한다 (해시는 전체 ID 기준).
+//
+// [스레드 안전성]
+// - increment(): 데이터패스에서 concurrent 호출 안전, 할당/락 없음.
+//   기존 규칙이면 해시 비교 + relaxed fetch_add 1회.
+// - for_each(): 조회 경로. 등록이 끝난(ready) 슬롯만 방문한다.
+// ---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+class RuleCounterTable {
+public:
+    static constexpr std::size_t kCapacity = 256;
+    static constexpr std::size_t kMaxNameLength = 63;
+
+    RuleCounterTable() noexcept = default;
+    ~RuleCounterTable() = default;
+
+    RuleCounterTable(const RuleCounterTable&) = delete;
+    RuleCounterTable& operator=(const RuleCounterTable&) = delete;
+    RuleCounterTable(RuleCounterTable&&) = delete;
+    RuleCounterTable& operator=(RuleCounterTable&&) = delete;
+
+    // increment: rule 의 카운터를 delta 만큼 증가시킨다 (데이터패스, noexcept)
+    void increment(std::string_view rule, std::uint64_t delta = 1) noexcept {
+        const auto hash = hash_of(rule);
+        const auto name = rule.substr(0, std::min(rule.size(), kMaxNameLength));
+        for (std::size_t probe = 0; probe < kCapacity; ++probe) {
+            auto& slot = slots_[(hash + probe) % kCapacity];
+            auto state = slot.state.load(std::memory_order_acquire);
+            if (state == kEmpty) {
+                if (slot.state.compare_exchange_strong(
+                        state, kWriting, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    std::memcpy(slot.name.data(), name.data(), name.size());
+                    slot.length = static_cast<std::uint8_t>(name.size());
+                    slot.hash = hash;
+                    slot.state.store(kReady, std::memory_order_release);
+                    slot.count.fetch_add(delta, std::memory_order_relaxed);
+                    return;
+                }
+                // 다른 스레드가 먼저 점유 — state 에 최신 값이 들어 있다
+            }
+            while (state == kWriting) {
+                // 점유 스레드는 memcpy 한 번 후 곧바로 ready 로 전환한다
+                state = slot.state.load(std::memory_order_acquire);
+            }
+            if (slot.hash == hash && slot.view() == name) {
+                slot.count.fetch_add(delta, std::memory_order_relaxed);
+                return;
+            }
+        }
+        overflow_.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    // for_each: fn(std::string_view rule, std::uint64_t count) — 등록된 규칙만 (조회 경로)
+    //   rule 은 테이블 내부 저장소를 가리키며 테이블 수명 동안 유효하다.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const auto& slot : slots_) {
+            if (slot.state.load(std::memory_order_acquire) != kReady) {
+                continue;
+            }
+            fn(slot.view(), slot.count.load(std::memory_order_relaxed));
+        }
+    }
+
+    // overflow: 테이블이 가득 차 규칙을 구분하지 못하고 합산한 카운트
+    [[nodiscard]] std::uint64_t overflow() const noexcept {
+        return overflow_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::uint8_t kEmpty = 0;
+    static constexpr std::uint8_t kWriting = 1;
+    static constexpr std::uint8_t kReady = 2;
+
+    struct Slot {
+        std::atomic<std::uint8_t> state{kEmpty};
+        std::uint8_t length{0};
+        std::uint64_t hash{0};
+        std::array<char, kMaxNameLength> name{};
+        std::atomic<std::uint64_t> count{0};
+
+        [[nodiscard]] std::string_view view() const noexcept {
+            return std::string_view{name.data(), length};
+        }
+    };
+
+    // FNV-1a 64bit
+    [[nodiscard]] static constexpr std::uint64_t hash_of(std::string_view s) noexcept {
+        std::uint64_t h = 14695981039346656037ULL;
+        for (const char c : s) {
+            h ^= static_cast<std::uint8_t>(c);
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    std::array<Slot, kCapacity> slots_{};
+    std::atomic<std::uint64_t> overflow_{0};
+};
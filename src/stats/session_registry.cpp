@@ -0,0 +1,123 @@
+// ---------------------------------------------------------------------------
+// session_registry.cpp
+// ---------------------------------------------------------------------------
+
+#include "stats/session_registry.hpp"
+
+#include <algorithm>
+#include <new>
+
+std::string_view session_state_name(SessionState state) noexcept {
+    switch (state) {
+        case SessionState::kHandshaking:
+            return "handshaking";
+        case SessionState::kReady:
+            return "ready";
+        case SessionState::kProcessingQuery:
+            return "processing_query";
+        case SessionState::kClosing:
+            return "closing";
+        case SessionState::kClosed:
+            break;
+    }
+    return "closed";
+}
+
+// ---------------------------------------------------------------------------
+// SessionStats
+// ---------------------------------------------------------------------------
+SessionStats::SessionStats(std::uint64_t session_id,
+                           std::chrono::system_clock::time_point connected_at)
+    : session_id_{session_id}, connected_at_ms_{to_epoch_ms(connected_at)} {}
+
+void SessionStats::publish_context(const SessionContext& ctx) noexcept {
+    try {
+        context_.store(std::make_shared<const SessionContext>(ctx), std::memory_order_release);
+    } catch (const std::bad_alloc&) {
+        // 목록 표시만 이전 값으로 남는다 (세션 동작과 무관)
+    }
+}
+
+SessionStatsView SessionStats::view() const {
+    SessionStatsView v{};
+    v.session_id = session_id_;
+    if (const auto ctx = context_.load(std::memory_order_acquire)) {
+        v.client_ip = ctx->client_ip;
+        v.client_port = ctx->client_port;
+        v.db_user = ctx->db_user;
+        v.db_name = ctx->db_name;
+    }
+    v.state = state_.load(std::memory_order_relaxed);
+    v.queries = queries_.load(std::memory_order_relaxed);
+    v.blocked = blocked_.load(std::memory_order_relaxed);
+    v.bytes_in = bytes_in_.load(std::memory_order_relaxed);
+    v.bytes_out = bytes_out_.load(std::memory_order_relaxed);
+    v.upstream_us = upstream_us_.load(std::memory_order_relaxed);
+    v.connected_at_ms = connected_at_ms_;
+    v.last_query_at_ms = last_query_at_ms_.load(std::memory_order_relaxed);
+    return v;
+}
+
+// ---------------------------------------------------------------------------
+// SessionRegistry
+// ---------------------------------------------------------------------------
+auto SessionRegistry::add(std::uint64_t session_id,
+                          std::chrono::system_clock::time_point connected_at)
+    -> std::shared_ptr<SessionStats> {
+    auto stats = std::make_shared<SessionStats>(session_id, connected_at);
+    Shard& shard = shard_for(session_id);
+    const std::lock_guard lock{shard.mu};
+    const auto [it, inserted] = shard.sessions.insert_or_assign(session_id, stats);
+    if (inserted) {
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+auto SessionRegistry::remove(std::uint64_t session_id) noexcept -> std::shared_ptr<SessionStats> {
+    Shard& shard = shard_for(session_id);
+    std::shared_ptr<SessionStats> released{};  // 마지막 참조 해제는 락 밖에서
+    {
+        const std::lock_guard lock{shard.mu};
+        const auto it = shard.sessions.find(session_id);
+        if (it == shard.sessions.end()) {
+            return nullptr;
+        }
+        released = std::move(it->second);
+        shard.sessions.erase(it);
+    }
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    return released;
+}
+
+auto SessionRegistry::entries() const -> std::vector<std::shared_ptr<const SessionStats>> {
+    std::vector<std::shared_ptr<const SessionStats>> out;
+    out.reserve(size());
+    for (const Shard& shard : shards_) {
+        const std::lock_guard lock{shard.mu};
+        for (const auto& [id, stats] : shard.sessions) {
+            out.push_back(stats);
+        }
+    }
+    return out;
+}
+
+auto SessionRegistry::snapshot(std::size_t limit) const -> std::vector<SessionStatsView> {
+    auto entries = this->entries();
+
+    const auto by_id = [](const auto& a, const auto& b) {
+        return a->session_id() < b->session_id();
+    };
+    const std::size_t count = std::min(limit, entries.size());
+    std::partial_sort(entries.begin(),
+                      entries.begin() + static_cast<std::ptrdiff_t>(count),
+                      entries.end(),
+                      by_id);
+
+    std::vector<SessionStatsView> out;
+    out.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        out.push_back(entries[i]->view());
+    }
+    return out;
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// session_registry.hpp
+//
+// 활성 세션 목록 (UDS "sessions" 명령 / 대시보드 세션 화면).
+//
+// [설계 의도]
+// 세션 목록을 보려고 데이터패스가 락을 잡거나, 조회가 세션 strand 에 끼어들면 안 된다.
+// 세션마다 SessionStats 블록을 하나 두고, 세션 코루틴(단일 writer)은 relaxed load + store
+// 만 한다 (lock 접두 RMW 없이 일반 정수 증가와 같은 비용). 조회 경로는 같은 블록을 relaxed
+// load 로 읽는다.
+//
+// [구조]
+//   SessionStats    : 세션 1개의 카운터 + 상태 + 식별 정보(SessionContext 사본)
+//   SessionRegistry : session_id → shared_ptr<SessionStats>. id 기준 16개 샤드로 나눠
+//                     accept / 종료 / 조회가 서로 다른 샤드면 경합하지 않는다.
+//   db_user 별 집계는 UserAccounting (user_accounting.hpp) 이 이 목록을 주기적으로 합산한다.
+//
+// [스레드 안전성]
+// - SessionStats 갱신 메서드: 소유 세션의 strand 에서만 호출 (noexcept, 락 없음)
+// - SessionStats::view(): 임의 스레드
+// - SessionRegistry::add / remove: accept 루프 / 세션 완료 콜백 (샤드 mutex, 세션당 1회)
+// - SessionRegistry::snapshot(): 샤드마다 포인터만 짧게 복사한 뒤 락 밖에서 view 를 만든다.
+//   add/remove 와 겹친 세션은 포함될 수도, 빠질 수도 있다 (목록은 시점 근사치).
+//
+// [격리 원칙]
+// 식별 정보 게시(publish_context)의 할당 실패는 무시한다 — 목록 표시가 빠질 뿐
+// 세션 동작에는 영향이 없다.
+// ---------------------------------------------------------------------------
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/types.hpp"
+
+// "handshaking" / "ready" / "processing_query" / "closing" / "closed"
+[[nodiscard]] std::string_view session_state_name(SessionState state) noexcept;
+
+// ---------------------------------------------------------------------------
+// SessionStatsView
+//   조회 시점의 세션 1개 값 사본.
+//   connected_at_ms / last_query_at_ms : Unix epoch ms (쿼리가 없었으면 last_query_at_ms == 0)
+//   queries / blocked : COM_QUERY 판정 수 / 그중 차단 수
+//   bytes_in  : 클라이언트가 보낸 커맨드 패킷 바이트 (헤더 포함)
+//   bytes_out : 서버에서 받아 클라이언트로 릴레이한 응답 바이트
+//   upstream_us : 커맨드 전달 ~ 응답 릴레이 완료 누적 시간 (µs, 파이프라이닝 시 구간이 겹침)
+// ---------------------------------------------------------------------------
+struct SessionStatsView {
+    std::uint64_t session_id{0};
+    std::string client_ip{};
+    std::uint16_t client_port{0};
+    std::string db_user{};
+    std::string db_name{};
+    SessionState state{SessionState::kHandshaking};
+    std::uint64_t queries{0};
+    std::uint64_t blocked{0};
+    std::uint64_t bytes_in{0};
+    std::uint64_t bytes_out{0};
+    std::uint64_t upstream_us{0};
+    std::int64_t connected_at_ms{0};
+    std::int64_t last_query_at_ms{0};
+};
+
+// ---------------------------------------------------------------------------
+// SessionStats
+//   세션 1개의 통계 블록. Session 과 SessionRegistry 가 공유 소유한다.
+//   갱신 메서드는 writer 가 하나뿐이라는 전제로 fetch_add 대신 load + store 를 쓴다.
+// ---------------------------------------------------------------------------
+class SessionStats {
+public:
+    SessionStats(std::uint64_t session_id, std::chrono::system_clock::time_point connected_at);
+
+    // 식별 정보 갱신 (peer 추출 후, 핸드셰이크 완료 후 — 세션당 몇 번뿐)
+    void publish_context(const SessionContext& ctx) noexcept;
+
+    void set_state(SessionState state) noexcept {
+        state_.store(state, std::memory_order_relaxed);
+    }
+
+    void add_bytes_in(std::size_t bytes) noexcept { bump(bytes_in_, bytes); }
+
+    void add_bytes_out(std::size_t bytes) noexcept { bump(bytes_out_, bytes); }
+
+    void add_upstream_time(std::chrono::steady_clock::duration elapsed) noexcept {
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        bump(upstream_us_, us > 0 ? static_cast<std::uint64_t>(us) : 0U);
+    }
+
+    void on_query(bool blocked, std::chrono::system_clock::time_point now) noexcept {
+        bump(queries_, 1U);
+        if (blocked) {
+            bump(blocked_, 1U);
+        }
+        last_query_at_ms_.store(to_epoch_ms(now), std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t session_id() const noexcept { return session_id_; }
+    [[nodiscard]] SessionStatsView view() const;
+
+    // 마지막으로 게시된 식별 정보 (게시 전이면 nullptr)
+    [[nodiscard]] auto context() const noexcept -> std::shared_ptr<const SessionContext> {
+        return context_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] std::uint64_t queries() const noexcept {
+        return queries_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t blocked() const noexcept {
+        return blocked_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t bytes_in() const noexcept {
+        return bytes_in_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t bytes_out() const noexcept {
+        return bytes_out_.load(std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t upstream_us() const noexcept {
+        return upstream_us_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static std::int64_t to_epoch_ms(
+        std::chrono::system_clock::time_point tp) noexcept {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch())
+            .count();
+    }
+
+private:
+    static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t delta) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    const std::uint64_t session_id_;
+    const std::int64_t connected_at_ms_;
+    std::atomic<std::shared_ptr<const SessionContext>> context_{};
+    std::atomic<SessionState> state_{SessionState::kHandshaking};
+    std::atomic<std::uint64_t> queries_{0};
+    std::atomic<std::uint64_t> blocked_{0};
+    std::atomic<std::uint64_t> bytes_in_{0};
+    std::atomic<std::uint64_t> bytes_out_{0};
+    std::atomic<std::uint64_t> upstream_us_{0};
+    std::atomic<std::int64_t> last_query_at_ms_{0};
+};
+
+// ---------------------------------------------------------------------------
+// SessionRegistry
+// ---------------------------------------------------------------------------
+class SessionRegistry {
+public:
+    static constexpr std::size_t kShardCount = 16;
+
+    SessionRegistry() = default;
+    ~SessionRegistry() = default;
+
+    SessionRegistry(const SessionRegistry&) = delete;
+    SessionRegistry& operator=(const SessionRegistry&) = delete;
+    SessionRegistry(SessionRegistry&&) = delete;
+    SessionRegistry& operator=(SessionRegistry&&) = delete;
+
+    // 세션 등록. 반환된 블록을 Session 에 넘긴다 (같은 id 재등록 시 기존 항목 교체).
+    [[nodiscard]] auto add(std::uint64_t session_id,
+                           std::chrono::system_clock::time_point connected_at =
+                               std::chrono::system_clock::now())
+        -> std::shared_ptr<SessionStats>;
+
+    // 등록 해제. 제거된 블록을 반환한다 (없으면 nullptr) — 최종 값을 집계에 넘길 때 사용.
+    auto remove(std::uint64_t session_id) noexcept -> std::shared_ptr<SessionStats>;
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    // -----------------------------------------------------------------------
+    // snapshot
+    //   session_id 오름차순으로 최대 limit 개. 전체 수는 size() 로 따로 알린다.
+    // -----------------------------------------------------------------------
+    [[nodiscard]] auto snapshot(std::size_t limit) const -> std::vector<SessionStatsView>;
+
+    // 현재 등록된 모든 블록 (순서 없음). 샤드별로 포인터만 복사한다.
+    [[nodiscard]] auto entries() const -> std::vector<std::shared_ptr<const SessionStats>>;
+
+private:
+    struct alignas(64) Shard {
+        mutable std::mutex mu;
+        std::unordered_map<std::uint64_t, std::shared_ptr<SessionStats>> sessions;
+    };
+
+    [[nodiscard]] Shard& shard_for(std::uint64_t session_id) noexcept {
+        return shards_[session_id % kShardCount];
+    }
+
+    std::array<Shard, kShardCount> shards_{};
+    std::atomic<std::size_t> size_{0};
+};
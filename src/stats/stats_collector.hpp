@@ -19,19 +19,46 @@
 // - 갱신 경로: on_connection_open / on_connection_close / on_query
 // - 조회 경로: snapshot()
 //   두 경로 간 mutex 없이 atomic 로드/스토어로 분리한다.
+//
+// [쿼리 카운터 샤딩]
+// - on_query 는 스레드별 캐시 라인 정렬 샤드에 relaxed fetch_add 1회
+//   (차단 쿼리는 blocked 포함 2회). 다른 카운터와 캐시 라인을 공유하지 않는다.
+// - tick() 이 1초마다 샤드 합계를 ring 에 기록하고, snapshot() 은 ring 표본과
+//   현재 합계의 차이로 1s / 10s / 60s 윈도우 QPS·차단율을 계산한다.
 // ---------------------------------------------------------------------------
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <mutex>
+#include <string_view>
 
 #include "common/types.hpp"
+#include "stats/latency_histogram.hpp"
+#include "stats/rule_counters.hpp"
+#include "stats/thread_slot.hpp"
 
 // ---------------------------------------------------------------------------
 // StatsSnapshot
 //   특정 시점의 통계 스냅샷 (불변 값 객체).
-//   qps      : 1초 슬라이딩 윈도우 기반 초당 쿼리 수
-//   block_rate: blocked_queries / total_queries (total == 0 이면 0.0)
+//   qps      : 1초 슬라이딩 윈도우 기반 초당 쿼리 수 (= qps_1s)
+//   qps_10s / qps_60s : 10초 / 60초 윈도우 초당 쿼리 수
+//   block_rate: blocked_queries / total_queries (total == 0 이면 0.0, 누적)
+//   block_rate_1s / 10s / 60s : 윈도우 내 차단 비율 (윈도우 내 쿼리 없으면 0.0)
+//   pool_*   : 백엔드 연결 풀 (BackendPool) 재사용 적중/미적중, 유휴 연결 수, 제거 수
+//   log_dropped: 비동기 로그 큐 포화로 버려진 로그 엔트리 누적 수
+//   log_queued : 비동기 로그 큐에 기록 대기 중인 엔트리 수 (게이지)
+//   log_suppressed: 샘플링/세션 rate limit 으로 기록하지 않은 허용 쿼리 로그 누적 수
+//   result_rows_limited: data_protection.max_result_rows 로 잘라낸 결과 셋 누적 수
+//   relay_buffer_bytes / relay_buffer_peak_bytes: 전체 세션 릴레이 버퍼 합계 (게이지) / 최댓값
+//   relay_budget_waits: 전체 릴레이 버퍼 상한 초과로 서버 읽기를 멈춘 횟수
+//   connections_rejected: accept 직후 거부한 연결 수 (max_connections / AdmissionControl)
+//   handshake_timeouts : 핸드셰이크 제한 시간 안에 kReady 에 도달하지 못해 닫은 세션 수
+//   idle_timeouts      : 유휴 제한 시간 동안 커맨드가 없어 닫은 세션 수
+//   tls_*_resumed / tls_*_full: frontend/backend TLS 핸드셰이크 중 세션 재개(hit) / 전체(miss) 수
+//   latency  : LatencyStage 별 지연 요약 (p50/p99/p99.9/max µs, 프로세스 시작 이후 누적)
 // ---------------------------------------------------------------------------
 struct StatsSnapshot {
     std::uint64_t total_connections{0};
@@ -41,6 +68,30 @@ struct StatsSnapshot {
     std::uint64_t monitored_blocks{0};
     double qps{0.0};
     double block_rate{0.0};
+    double qps_10s{0.0};
+    double qps_60s{0.0};
+    double block_rate_1s{0.0};
+    double block_rate_10s{0.0};
+    double block_rate_60s{0.0};
+    std::uint64_t pool_hits{0};
+    std::uint64_t pool_misses{0};
+    std::uint64_t pool_idle{0};
+    std::uint64_t pool_evictions{0};
+    std::uint64_t log_dropped{0};
+    std::uint64_t log_queued{0};
+    std::uint64_t log_suppressed{0};
+    std::uint64_t result_rows_limited{0};
+    std::uint64_t relay_buffer_bytes{0};
+    std::uint64_t relay_buffer_peak_bytes{0};
+    std::uint64_t relay_budget_waits{0};
+    std::uint64_t connections_rejected{0};
+    std::uint64_t handshake_timeouts{0};
+    std::uint64_t idle_timeouts{0};
+    std::uint64_t tls_frontend_resumed{0};
+    std::uint64_t tls_frontend_full{0};
+    std::uint64_t tls_backend_resumed{0};
+    std::uint64_t tls_backend_full{0};
+    std::array<LatencySummary, kLatencyStageCount> latency{};
     std::chrono::system_clock::time_point captured_at{};
 };
 
@@ -48,19 +99,22 @@ struct StatsSnapshot {
 // StatsCollector
 //   데이터패스 이벤트를 집계하고 StatsSnapshot 을 제공한다.
 //
-// [QPS 계산 방식 (Phase 3 구현)]
-//   1초 슬라이딩 윈도우를 atomic timestamp + counter 로 구현.
-//   현재 stub 에서는 simple counter / elapsed 방식을 사용한다.
+// [윈도우 QPS 계산]
+//   ring_ 에 (시각, 누적 total, 누적 blocked) 표본을 kRateRingSize 개 보관한다.
+//   윈도우 W 의 기준 표본은 now - W 이전의 가장 최근 표본이며, 그런 표본이 없으면
+//   (가동 직후, tick 미실행) 가장 오래된 표본을 쓴다. 생성 시각이 첫 표본이므로
+//   tick 이 한 번도 돌지 않으면 누적 평균과 같다.
+//   ProxyServer 가 1초 주기 타이머로 tick() 을 호출한다.
 // ---------------------------------------------------------------------------
 class StatsCollector {
 public:
-    StatsCollector() noexcept
-        : total_connections_{0},
-          active_sessions_{0},
-          total_queries_{0},
-          blocked_queries_{0},
-          window_queries_{0},
-          window_start_(std::chrono::system_clock::now()) {}
+    // 윈도우 계산용 ring 크기 (60초 윈도우 + 여유)
+    static constexpr std::size_t kRateRingSize = 64;
+    static constexpr std::size_t kQueryShardCount = 16;
+
+    StatsCollector() noexcept : total_connections_{0}, active_sessions_{0} {
+        record_sample(std::chrono::steady_clock::now(), 0, 0);
+    }
 
     ~StatsCollector() = default;
 
@@ -98,13 +152,22 @@ public:
     //   쿼리 처리 완료 시 호출 (데이터패스).
     //   blocked: 정책에 의해 차단된 쿼리면 true
     void on_query(bool blocked) noexcept {
-        total_queries_.fetch_add(1, std::memory_order_relaxed);
-        window_queries_.fetch_add(1, std::memory_order_relaxed);
+        auto& shard = query_shards_[stats_thread_slot() % kQueryShardCount];
+        shard.total.fetch_add(1, std::memory_order_relaxed);
         if (blocked) {
-            blocked_queries_.fetch_add(1, std::memory_order_relaxed);
+            shard.blocked.fetch_add(1, std::memory_order_relaxed);
         }
     }
 
+    // tick
+    //   현재 쿼리 합계를 윈도우 ring 에 표본으로 기록한다 (1초 주기, 조회 경로).
+    //   tick 끼리는 mutex 로 직렬화하며 데이터패스와는 경합하지 않는다.
+    void tick(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) {
+        const std::lock_guard<std::mutex> lock(tick_mutex_);
+        const auto [total, blocked] = query_totals();
+        record_sample(now, total, blocked);
+    }
+
     // on_monitored_block
     //   monitor 모드에서 "차단되었을" 쿼리 발생 시 호출.
     //   blocked_queries 와 분리된 별도 카운터 (block_rate 정확성 유지).
@@ -112,60 +175,322 @@ public:
         monitored_blocks_.fetch_add(1, std::memory_order_relaxed);
     }
 
+    // on_pool_hit / on_pool_miss
+    //   백엔드 연결 풀에서 인증된 연결을 재사용했는지(hit) 새로 연결했는지(miss).
+    void on_pool_hit() noexcept { pool_hits_.fetch_add(1, std::memory_order_relaxed); }
+    void on_pool_miss() noexcept { pool_misses_.fetch_add(1, std::memory_order_relaxed); }
+
+    // on_pool_idle_changed
+    //   풀의 유휴 연결 수 게이지. BackendPool 이 보관/반출할 때 갱신한다.
+    void on_pool_idle_changed(std::uint64_t idle) noexcept {
+        pool_idle_.store(idle, std::memory_order_relaxed);
+    }
+
+    // on_pool_eviction
+    //   유휴 타임아웃·용량 초과·reset 실패로 풀에서 제거(종료)된 연결 수.
+    void on_pool_eviction(std::uint64_t count = 1) noexcept {
+        pool_evictions_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    // on_log_dropped
+    //   비동기 로그 큐가 가득 차 엔트리를 버렸을 때 (AsyncLogWriter 가 호출).
+    void on_log_dropped() noexcept { log_dropped_.fetch_add(1, std::memory_order_relaxed); }
+
+    // on_log_queue_depth
+    //   비동기 로그 큐 대기 엔트리 수 게이지. writer 스레드가 batch 마다 갱신한다.
+    void on_log_queue_depth(std::uint64_t queued) noexcept {
+        log_queued_.store(queued, std::memory_order_relaxed);
+    }
+
+    // on_query_log_suppressed
+    //   허용된 쿼리의 QueryLog 를 샘플링/세션 rate limit 으로 생략했을 때 (차단 로그는 제외).
+    void on_query_log_suppressed() noexcept {
+        log_suppressed_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // on_result_rows_limited
+    //   결과 셋이 max_result_rows 를 넘어 릴레이가 ERR / EOF 로 끝냈을 때.
+    void on_result_rows_limited() noexcept {
+        result_rows_limited_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // on_relay_buffer_bytes
+    //   전체 세션 릴레이 버퍼 합계 게이지 (RelayBudget 이 버퍼 크기 변화마다 갱신).
+    void on_relay_buffer_bytes(std::uint64_t bytes) noexcept {
+        relay_buffer_bytes_.store(bytes, std::memory_order_relaxed);
+        auto peak = relay_buffer_peak_bytes_.load(std::memory_order_relaxed);
+        while (bytes > peak && !relay_buffer_peak_bytes_.compare_exchange_weak(
+                                   peak, bytes, std::memory_order_relaxed)) {
+        }
+    }
+
+    // on_relay_budget_wait
+    //   전체 릴레이 버퍼 상한 초과로 세션이 서버 읽기를 멈췄을 때.
+    void on_relay_budget_wait() noexcept {
+        relay_budget_waits_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // on_connection_rejected
+    //   accept 한 연결을 세션 생성 전에 닫았을 때 (연결 수 상한 / accept 속도 / IP 별 상한).
+    void on_connection_rejected() noexcept {
+        connections_rejected_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // on_handshake_timeout
+    //   핸드셰이크(TLS + 백엔드 인증)가 제한 시간을 넘겨 세션을 닫았을 때.
+    void on_handshake_timeout() noexcept {
+        handshake_timeouts_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // on_idle_timeout
+    //   다음 커맨드를 유휴 제한 시간 넘게 기다려 세션을 닫았을 때.
+    void on_idle_timeout() noexcept { idle_timeouts_.fetch_add(1, std::memory_order_relaxed); }
+
+    // on_frontend_tls_handshake / on_backend_tls_handshake
+    //   TLS 핸드셰이크 성공 시 세션 재개(resumed=true) 또는 전체 핸드셰이크 여부.
+    void on_frontend_tls_handshake(bool resumed) noexcept {
+        (resumed ? tls_frontend_resumed_ : tls_frontend_full_)
+            .fetch_add(1, std::memory_order_relaxed);
+    }
+    void on_backend_tls_handshake(bool resumed) noexcept {
+        (resumed ? tls_backend_resumed_ : tls_backend_full_)
+            .fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // on_rule_block
+    //   정책 차단 시 matched_rule 별 카운터 증가 (on_query(true) 와 함께 호출).
+    void on_rule_block(std::string_view rule) noexcept { rule_blocks_.increment(rule); }
+
+    // rule_blocks
+    //   규칙별 차단 카운터 (조회 경로, /metrics).
+    //   가변 길이라 StatsSnapshot 에 복사하지 않고 테이블을 직접 순회한다.
+    [[nodiscard]] const RuleCounterTable& rule_blocks() const noexcept { return rule_blocks_; }
+
+    // on_latency
+    //   데이터패스 단계별 소요 시간 기록 (스레드별 샤드, 락 없음).
+    void on_latency(LatencyStage stage, std::chrono::nanoseconds elapsed) noexcept {
+        latency_[static_cast<std::size_t>(stage)].record(elapsed);
+    }
+
     // snapshot
     //   현재 통계의 불변 스냅샷을 반환한다 (조회 경로).
     //
     //   [QPS 계산]
-    //   window_start_ 이후 경과 시간과 window_queries_ 를 이용해 계산.
-    //   Phase 3 에서 1초 슬라이딩 윈도우로 교체 예정.
+    //   ring 표본을 먼저 읽고 샤드 합계를 나중에 읽어 delta 가 음수가 되지 않게 한다.
     [[nodiscard]] StatsSnapshot snapshot() const noexcept {
+        return snapshot(std::chrono::steady_clock::now());
+    }
+
+    // steady_now 기준 스냅샷 (테스트에서 시각 주입용)
+    [[nodiscard]] StatsSnapshot snapshot(std::chrono::steady_clock::time_point steady_now) const
+        noexcept {
         const auto now = std::chrono::system_clock::now();
+        const auto base_1s = window_base(steady_now, std::chrono::seconds{1});
+        const auto base_10s = window_base(steady_now, std::chrono::seconds{10});
+        const auto base_60s = window_base(steady_now, std::chrono::seconds{60});
+
         const auto total_conn = total_connections_.load(std::memory_order_relaxed);
         const auto active_sess_raw = active_sessions_.load(std::memory_order_relaxed);
-        const auto total_q = total_queries_.load(std::memory_order_relaxed);
-        const auto blocked_q = blocked_queries_.load(std::memory_order_relaxed);
+        const auto [total_q, blocked_q] = query_totals();
         const auto monitored_b = monitored_blocks_.load(std::memory_order_relaxed);
-        const auto window_q = window_queries_.load(std::memory_order_relaxed);
-        const auto window_start = window_start_.load();
 
         // lock-free 스냅샷 특성상 서로 다른 시점의 값을 읽을 수 있어
         // active가 total보다 크게 보이는 일시적 관측치를 보정한다.
         const auto active_sess =
             active_sess_raw <= total_conn ? active_sess_raw : total_conn;
 
-        const double elapsed_sec = std::chrono::duration<double>(now - window_start).count();
-
-        double qps = 0.0;
-        if (elapsed_sec > 0.0) {
-            qps = static_cast<double>(window_q) / elapsed_sec;
-        }
+        const auto rate_1s = window_rate(base_1s, steady_now, total_q, blocked_q);
+        const auto rate_10s = window_rate(base_10s, steady_now, total_q, blocked_q);
+        const auto rate_60s = window_rate(base_60s, steady_now, total_q, blocked_q);
 
         double block_rate = 0.0;
         if (total_q > 0) {
             block_rate = static_cast<double>(blocked_q) / static_cast<double>(total_q);
         }
 
+        std::array<LatencySummary, kLatencyStageCount> latency{};
+        for (std::size_t i = 0; i < kLatencyStageCount; ++i) {
+            latency[i] = latency_[i].summarize();
+        }
+
         return StatsSnapshot{
             .total_connections = total_conn,
             .active_sessions = active_sess,
             .total_queries = total_q,
             .blocked_queries = blocked_q,
             .monitored_blocks = monitored_b,
-            .qps = qps,
+            .qps = rate_1s.qps,
             .block_rate = block_rate,
+            .qps_10s = rate_10s.qps,
+            .qps_60s = rate_60s.qps,
+            .block_rate_1s = rate_1s.block_rate,
+            .block_rate_10s = rate_10s.block_rate,
+            .block_rate_60s = rate_60s.block_rate,
+            .pool_hits = pool_hits_.load(std::memory_order_relaxed),
+            .pool_misses = pool_misses_.load(std::memory_order_relaxed),
+            .pool_idle = pool_idle_.load(std::memory_order_relaxed),
+            .pool_evictions = pool_evictions_.load(std::memory_order_relaxed),
+            .log_dropped = log_dropped_.load(std::memory_order_relaxed),
+            .log_queued = log_queued_.load(std::memory_order_relaxed),
+            .log_suppressed = log_suppressed_.load(std::memory_order_relaxed),
+            .result_rows_limited = result_rows_limited_.load(std::memory_order_relaxed),
+            .relay_buffer_bytes = relay_buffer_bytes_.load(std::memory_order_relaxed),
+            .relay_buffer_peak_bytes = relay_buffer_peak_bytes_.load(std::memory_order_relaxed),
+            .relay_budget_waits = relay_budget_waits_.load(std::memory_order_relaxed),
+            .connections_rejected = connections_rejected_.load(std::memory_order_relaxed),
+            .handshake_timeouts = handshake_timeouts_.load(std::memory_order_relaxed),
+            .idle_timeouts = idle_timeouts_.load(std::memory_order_relaxed),
+            .tls_frontend_resumed = tls_frontend_resumed_.load(std::memory_order_relaxed),
+            .tls_frontend_full = tls_frontend_full_.load(std::memory_order_relaxed),
+            .tls_backend_resumed = tls_backend_resumed_.load(std::memory_order_relaxed),
+            .tls_backend_full = tls_backend_full_.load(std::memory_order_relaxed),
+            .latency = latency,
             .captured_at = now,
         };
     }
 
 private:
+    // 스레드별 쿼리 카운터 샤드 (false sharing 방지를 위해 캐시 라인 단위 정렬)
+    struct alignas(64) QueryShard {
+        std::atomic<std::uint64_t> total{0};
+        std::atomic<std::uint64_t> blocked{0};
+    };
+
+    // 윈도우 ring 표본. at_ns < 0 이면 기록 중/미기록 (seqlock 방식으로 재확인).
+    struct RateSample {
+        std::atomic<std::int64_t> at_ns{-1};
+        std::atomic<std::uint64_t> total{0};
+        std::atomic<std::uint64_t> blocked{0};
+    };
+
+    struct SampleValue {
+        std::int64_t at_ns{0};
+        std::uint64_t total{0};
+        std::uint64_t blocked{0};
+    };
+
+    struct WindowRate {
+        double qps{0.0};
+        double block_rate{0.0};
+    };
+
+    struct QueryTotals {
+        std::uint64_t total{0};
+        std::uint64_t blocked{0};
+    };
+
+    [[nodiscard]] QueryTotals query_totals() const noexcept {
+        QueryTotals totals{};
+        for (const auto& shard : query_shards_) {
+            totals.total += shard.total.load(std::memory_order_relaxed);
+            totals.blocked += shard.blocked.load(std::memory_order_relaxed);
+        }
+        return totals;
+    }
+
+    [[nodiscard]] static std::int64_t to_ns(std::chrono::steady_clock::time_point t) noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    // record_sample: 생성자 / tick() 에서만 호출 (tick_mutex_ 또는 생성 중)
+    void record_sample(std::chrono::steady_clock::time_point now,
+                       std::uint64_t total,
+                       std::uint64_t blocked) noexcept {
+        const auto head = ring_head_.load(std::memory_order_relaxed);
+        auto& slot = ring_[head % kRateRingSize];
+        slot.at_ns.store(-1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.total.store(total, std::memory_order_relaxed);
+        slot.blocked.store(blocked, std::memory_order_relaxed);
+        slot.at_ns.store(to_ns(now), std::memory_order_release);
+        ring_head_.store(head + 1, std::memory_order_release);
+    }
+
+    // window_base: now - window 이전의 가장 최근 표본 (없으면 가장 오래된 유효 표본)
+    [[nodiscard]] SampleValue window_base(std::chrono::steady_clock::time_point now,
+                                          std::chrono::seconds window) const noexcept {
+        const auto cutoff = to_ns(now) - std::chrono::nanoseconds(window).count();
+        const auto head = ring_head_.load(std::memory_order_acquire);
+        const auto available = head < kRateRingSize ? head : kRateRingSize;
+        SampleValue base{.at_ns = -1};
+        for (std::size_t back = 1; back <= available; ++back) {
+            const auto& slot = ring_[(head - back) % kRateRingSize];
+            const auto at = slot.at_ns.load(std::memory_order_acquire);
+            const auto total = slot.total.load(std::memory_order_relaxed);
+            const auto blocked = slot.blocked.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (at < 0 || slot.at_ns.load(std::memory_order_relaxed) != at) {
+                continue;  // tick 이 덮어쓰는 중
+            }
+            base = SampleValue{.at_ns = at, .total = total, .blocked = blocked};
+            if (at <= cutoff) {
+                break;
+            }
+        }
+        return base;
+    }
+
+    [[nodiscard]] static WindowRate window_rate(const SampleValue& base,
+                                                std::chrono::steady_clock::time_point now,
+                                                std::uint64_t total,
+                                                std::uint64_t blocked) noexcept {
+        const auto elapsed_ns = to_ns(now) - base.at_ns;
+        if (base.at_ns < 0 || elapsed_ns <= 0 || total < base.total) {
+            return WindowRate{};
+        }
+        const auto queries = total - base.total;
+        const auto blocks = blocked >= base.blocked ? blocked - base.blocked : 0;
+        WindowRate rate{};
+        rate.qps = static_cast<double>(queries) / (static_cast<double>(elapsed_ns) / 1e9);
+        if (queries > 0) {
+            rate.block_rate = static_cast<double>(blocks) / static_cast<double>(queries);
+        }
+        return rate;
+    }
+
     std::atomic<std::uint64_t> total_connections_;
     std::atomic<std::uint64_t> active_sessions_;
-    std::atomic<std::uint64_t> total_queries_;
-    std::atomic<std::uint64_t> blocked_queries_;
     std::atomic<std::uint64_t> monitored_blocks_{0};
 
-    // QPS 슬라이딩 윈도우용 카운터/타임스탬프
-    // Phase 3 에서 1초 윈도우 교체 시 ring buffer 방식으로 변경 예정.
-    std::atomic<std::uint64_t> window_queries_;
-    std::atomic<std::chrono::system_clock::time_point> window_start_;
+    // 백엔드 연결 풀 통계
+    std::atomic<std::uint64_t> pool_hits_{0};
+    std::atomic<std::uint64_t> pool_misses_{0};
+    std::atomic<std::uint64_t> pool_idle_{0};
+    std::atomic<std::uint64_t> pool_evictions_{0};
+
+    // 비동기 로그 파이프라인 통계
+    std::atomic<std::uint64_t> log_dropped_{0};
+    std::atomic<std::uint64_t> log_queued_{0};
+    std::atomic<std::uint64_t> log_suppressed_{0};
+
+    // data_protection.max_result_rows 적용 횟수
+    std::atomic<std::uint64_t> result_rows_limited_{0};
+
+    // 릴레이 버퍼 메모리 (RelayBudget)
+    std::atomic<std::uint64_t> relay_buffer_bytes_{0};
+    std::atomic<std::uint64_t> relay_buffer_peak_bytes_{0};
+    std::atomic<std::uint64_t> relay_budget_waits_{0};
+
+    // 연결 허용 판정 (accept 직후 거부 / 핸드셰이크 제한 시간 초과 / 유휴 종료)
+    std::atomic<std::uint64_t> connections_rejected_{0};
+    std::atomic<std::uint64_t> handshake_timeouts_{0};
+    std::atomic<std::uint64_t> idle_timeouts_{0};
+
+    // TLS 세션 재개 통계
+    std::atomic<std::uint64_t> tls_frontend_resumed_{0};
+    std::atomic<std::uint64_t> tls_frontend_full_{0};
+    std::atomic<std::uint64_t> tls_backend_resumed_{0};
+    std::atomic<std::uint64_t> tls_backend_full_{0};
+
+    // 단계별 지연 히스토그램 (LatencyStage 인덱스)
+    std::array<LatencyHistogram, kLatencyStageCount> latency_{};
+
+    // matched_rule 별 차단 카운터
+    RuleCounterTable rule_blocks_{};
+
+    // 쿼리 카운터 샤드 / 윈도우 ring
+    std::array<QueryShard, kQueryShardCount> query_shards_{};
+    std::array<RateSample, kRateRingSize> ring_{};
+    std::atomic<std::size_t> ring_head_{0};  // 지금까지 기록된 표본 수
+    std::mutex tick_mutex_;
 };
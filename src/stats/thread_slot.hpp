@@ -0,0 +1,19 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// thread_slot.hpp
+//
+// 통계 샤드 배정용 스레드 번호.
+// 스레드마다 최초 호출 시 0, 1, 2, ... 순서로 번호를 받는다. 샤드를 쓰는 쪽은
+// 자기 샤드 수로 나머지를 취해 사용한다 (StatsCollector, LatencyHistogram).
+// io_context 스레드 수가 샤드 수 이하이면 스레드마다 서로 다른 샤드를 쓴다.
+// ---------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+
+[[nodiscard]] inline std::size_t stats_thread_slot() noexcept {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
@@ -7,6 +7,8 @@
 //
 // [프로토콜]
 //   요청/응답 모두 4byte LE 길이 프리픽스 + JSON 바디.
+//   연결 하나로 여러 요청을 순서대로 보낼 수 있다 (EOF 또는 유휴 타임아웃까지 유지).
+//   본문은 control_json 파서로 한 번에 검증한다 (문법 오류면 해당 요청만 error 응답).
 //
 // [지원 커맨드]
 //   "stats"           — StatsSnapshot JSON 반환
@@ -14,7 +16,13 @@
 //   "policy_versions" — 저장된 정책 버전 목록 조회 (DON-50)
 //   "policy_rollback" — 특정 버전으로 정책 롤백 (DON-50)
 //   "policy_reload"   — 정책 파일 리로드 + 스냅샷 저장 (DON-50)
-//   "sessions"        — 501 placeholder (Phase 3)
+//   "policy_stats"    — 규칙별 적중 수 / 누적 평가 시간
+//   "sessions"        — 활성 세션 목록 (SessionRegistry 스냅샷)
+//   "user_stats"      — db_user 별 집계 Top-N (UserAccounting 게시 테이블)
+//   "top_queries"     — fingerprint 별 집계 Top-N (QueryTopK 스케치)
+//   "drain"           — accept 중단 + 세션 정상 종료
+//   "listener_handoff"— 리스너 fd 인계 (SCM_RIGHTS)
+//   "subscribe"       — 주기적 StatsSnapshot 델타 푸시 (연결이 푸시 전용이 된다)
 //   기타              — error 응답
 //
 // [격리 원칙]
@@ -31,18 +39,21 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
 #include <boost/asio/dispatch.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
 #include <boost/asio/write.hpp>
 #include <chrono>
 #include <cstdint>
 #include <ctime>
 #include <cstring>
 #include <iomanip>
+#include <iterator>
 #include <limits>
 #include <optional>
 #include <sstream>
@@ -50,7 +61,9 @@
 #include <string_view>
 #include <vector>
 
+#include "common/fd_passing.hpp"
 #include "policy/policy_loader.hpp"
+#include "stats/control_json.hpp"
 
 namespace {
 
@@ -102,6 +115,29 @@ std::string json_escape(std::string_view sv) {
     return out;
 }
 
+// ---------------------------------------------------------------------------
+// serialize_latency
+//   단계별 지연 요약 → {"parse":{"count":..,"p50_us":..,...},...}
+// ---------------------------------------------------------------------------
+std::string serialize_latency(const StatsSnapshot& s) {
+    std::string out = "{";
+    for (std::size_t i = 0; i < kLatencyStageCount; ++i) {
+        const auto& l = s.latency[i];
+        fmt::format_to(
+            std::back_inserter(out),
+            R"({}"{}":{{"count":{},"p50_us":{:.3f},"p99_us":{:.3f},"p999_us":{:.3f},"max_us":{:.3f}}})",
+            i == 0 ? "" : ",",
+            latency_stage_name(static_cast<LatencyStage>(i)),
+            l.count,
+            l.p50_us,
+            l.p99_us,
+            l.p999_us,
+            l.max_us);
+    }
+    out += '}';
+    return out;
+}
+
 // ---------------------------------------------------------------------------
 // serialize_snapshot
 //   StatsSnapshot → JSON 문자열 (nlohmann/json 없이 수동 직렬화).
@@ -113,7 +149,7 @@ std::string serialize_snapshot(const StatsSnapshot& s) {
             .count();
 
     return fmt::format(
-        R"({{"total_connections":{},"active_sessions":{},"total_queries":{},"blocked_queries":{},"monitored_blocks":{},"qps":{:.4f},"block_rate":{:.4f},"captured_at_ms":{}}})",
+        R"({{"total_connections":{},"active_sessions":{},"total_queries":{},"blocked_queries":{},"monitored_blocks":{},"qps":{:.4f},"block_rate":{:.4f},"qps_10s":{:.4f},"qps_60s":{:.4f},"block_rate_1s":{:.4f},"block_rate_10s":{:.4f},"block_rate_60s":{:.4f},"pool_hits":{},"pool_misses":{},"pool_idle":{},"pool_evictions":{},"log_dropped":{},"log_queued":{},"log_suppressed":{},"result_rows_limited":{},"relay_buffer_bytes":{},"relay_buffer_peak_bytes":{},"relay_budget_waits":{},"connections_rejected":{},"handshake_timeouts":{},"idle_timeouts":{},"tls_frontend_resumed":{},"tls_frontend_full":{},"tls_backend_resumed":{},"tls_backend_full":{},"latency":{},"captured_at_ms":{}}})",
         s.total_connections,
         s.active_sessions,
         s.total_queries,
@@ -121,9 +157,187 @@ std::string serialize_snapshot(const StatsSnapshot& s) {
         s.monitored_blocks,
         s.qps,
         s.block_rate,
+        s.qps_10s,
+        s.qps_60s,
+        s.block_rate_1s,
+        s.block_rate_10s,
+        s.block_rate_60s,
+        s.pool_hits,
+        s.pool_misses,
+        s.pool_idle,
+        s.pool_evictions,
+        s.log_dropped,
+        s.log_queued,
+        s.log_suppressed,
+        s.result_rows_limited,
+        s.relay_buffer_bytes,
+        s.relay_buffer_peak_bytes,
+        s.relay_budget_waits,
+        s.connections_rejected,
+        s.handshake_timeouts,
+        s.idle_timeouts,
+        s.tls_frontend_resumed,
+        s.tls_frontend_full,
+        s.tls_backend_resumed,
+        s.tls_backend_full,
+        serialize_latency(s),
         epoch_ms);
 }
 
+// ---------------------------------------------------------------------------
+// serialize_rule_cost
+//   RuleCost → "evaluations":..,"hits":..,"total_ns":..,"avg_ns":.. (중괄호 제외)
+// ---------------------------------------------------------------------------
+std::string serialize_rule_cost(const RuleCost& c) {
+    const double avg_ns =
+        c.evaluations > 0
+            ? static_cast<double>(c.total_ns) / static_cast<double>(c.evaluations)
+            : 0.0;
+    return fmt::format(R"("evaluations":{},"hits":{},"total_ns":{},"avg_ns":{:.1f})",
+                       c.evaluations,
+                       c.hits,
+                       c.total_ns,
+                       avg_ns);
+}
+
+// ---------------------------------------------------------------------------
+// serialize_rule_stats
+//   PolicyRuleStats → {"version":..,"access_rules":[..],"block_patterns":[..],
+//                      "no_access_rule":{..}}
+// ---------------------------------------------------------------------------
+std::string serialize_rule_stats(const PolicyRuleStats& stats) {
+    const auto append_list = [](std::string& out, const std::vector<RuleStats>& list) {
+        out += '[';
+        for (std::size_t i = 0; i < list.size(); ++i) {
+            const auto& r = list[i];
+            fmt::format_to(std::back_inserter(out),
+                           R"({}{{"index":{},"rule":"{}",{}}})",
+                           i == 0 ? "" : ",",
+                           r.index,
+                           json_escape(r.rule),
+                           serialize_rule_cost(r.cost));
+        }
+        out += ']';
+    };
+
+    std::string out = fmt::format(R"({{"version":{},"access_rules":)", stats.version);
+    append_list(out, stats.access_rules);
+    out += R"(,"block_patterns":)";
+    append_list(out, stats.block_patterns);
+    out += R"(,"no_access_rule":{)" + serialize_rule_cost(stats.no_access_rule) + "}}";
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// serialize_sessions
+//   SessionStatsView 목록 → {"total":..,"truncated":..,"sessions":[..]}
+// ---------------------------------------------------------------------------
+std::string serialize_sessions(const std::vector<SessionStatsView>& sessions,
+                               std::size_t total,
+                               bool truncated) {
+    std::string out = fmt::format(
+        R"({{"total":{},"truncated":{},"sessions":[)", total, truncated ? "true" : "false");
+    out.reserve(out.size() + sessions.size() * 256U);
+    for (std::size_t i = 0; i < sessions.size(); ++i) {
+        const auto& s = sessions[i];
+        fmt::format_to(std::back_inserter(out),
+                       R"({}{{"session_id":{},"client_ip":"{}","client_port":{},"db_user":"{}",)"
+                       R"("db_name":"{}","state":"{}","queries":{},"blocked":{},"bytes_in":{},)"
+                       R"("bytes_out":{},"upstream_us":{},"connected_at_ms":{},)"
+                       R"("last_query_at_ms":{}}})",
+                       i == 0 ? "" : ",",
+                       s.session_id,
+                       json_escape(s.client_ip),
+                       s.client_port,
+                       json_escape(s.db_user),
+                       json_escape(s.db_name),
+                       session_state_name(s.state),
+                       s.queries,
+                       s.blocked,
+                       s.bytes_in,
+                       s.bytes_out,
+                       s.upstream_us,
+                       s.connected_at_ms,
+                       s.last_query_at_ms);
+    }
+    out += "]}";
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// serialize_user_stats
+//   UserTotals 목록 → {"captured_at_ms":..,"total_users":..,"sort":"..","users":[..]}
+// ---------------------------------------------------------------------------
+std::string serialize_user_stats(const std::vector<UserTotals>& users,
+                                 std::size_t total_users,
+                                 std::string_view sort,
+                                 std::int64_t captured_at_ms) {
+    std::string out = fmt::format(R"({{"captured_at_ms":{},"total_users":{},"sort":"{}","users":[)",
+                                  captured_at_ms,
+                                  total_users,
+                                  sort);
+    for (std::size_t i = 0; i < users.size(); ++i) {
+        const auto& u = users[i];
+        fmt::format_to(std::back_inserter(out),
+                       R"({}{{"db_user":"{}","active_sessions":{},"sessions":{},"queries":{},)"
+                       R"("blocked":{},"bytes_in":{},"bytes_out":{},"upstream_us":{}}})",
+                       i == 0 ? "" : ",",
+                       json_escape(u.db_user),
+                       u.active_sessions,
+                       u.sessions,
+                       u.queries,
+                       u.blocked,
+                       u.bytes_in,
+                       u.bytes_out,
+                       u.upstream_us);
+    }
+    out += "]}";
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// serialize_top_queries
+//   QueryTopEntry 목록 → {"capacity":..,"tracked":..,"recorded":..,"untracked":..,
+//   "sort":"..","queries":[..]}. id 는 fingerprint 해시 16진수 (16자리).
+// ---------------------------------------------------------------------------
+std::string serialize_top_queries(const std::vector<QueryTopEntry>& top,
+                                  const QueryTopKSnapshot& snap,
+                                  std::string_view sort) {
+    std::string out = fmt::format(
+        R"({{"capacity":{},"tracked":{},"recorded":{},"untracked":{},"sort":"{}","queries":[)",
+        snap.capacity,
+        snap.entries.size(),
+        snap.recorded,
+        snap.untracked,
+        sort);
+    for (std::size_t i = 0; i < top.size(); ++i) {
+        const auto& q = top[i];
+        const double avg_us =
+            q.latency_count > 0
+                ? static_cast<double>(q.upstream_us) / static_cast<double>(q.latency_count)
+                : 0.0;
+        fmt::format_to(std::back_inserter(out),
+                       R"({}{{"id":"{:016x}","fingerprint":"{}","truncated":{},"count":{},)"
+                       R"("error":{},"blocked":{},"latency_count":{},"upstream_us":{},)"
+                       R"("avg_us":{:.1f},"p50_us":{},"p99_us":{},"max_us":{}}})",
+                       i == 0 ? "" : ",",
+                       q.hash,
+                       json_escape(q.fingerprint),
+                       q.truncated,
+                       q.count,
+                       q.error,
+                       q.blocked,
+                       q.latency_count,
+                       q.upstream_us,
+                       avg_us,
+                       q.p50_us,
+                       q.p99_us,
+                       q.max_us);
+    }
+    out += "]}";
+    return out;
+}
+
 // ---------------------------------------------------------------------------
 // make_ok_response
 //   {"ok":true,"payload":<data>}
@@ -195,38 +409,6 @@ std::string safe_strerror(int errnum) {
 #endif
 }
 
-bool is_json_whitespace(char c) {
-    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
-}
-
-// ---------------------------------------------------------------------------
-// find_json_string_end
-//   json[start_quote]가 '"'일 때, 문자열 리터럴의 닫는 '"' 인덱스를 반환한다.
-//   이스케이프(\\, \")를 고려한다. 실패 시 std::string_view::npos 반환.
-// ---------------------------------------------------------------------------
-std::string_view::size_type find_json_string_end(std::string_view json,
-                                                 std::string_view::size_type start_quote) {
-    if (start_quote >= json.size() || json[start_quote] != '"') {
-        return std::string_view::npos;
-    }
-    bool escaped = false;
-    for (std::string_view::size_type i = start_quote + 1; i < json.size(); ++i) {
-        const char c = json[i];
-        if (escaped) {
-            escaped = false;
-            continue;
-        }
-        if (c == '\\') {
-            escaped = true;
-            continue;
-        }
-        if (c == '"') {
-            return i;
-        }
-    }
-    return std::string_view::npos;
-}
-
 // ---------------------------------------------------------------------------
 // encode_le4
 //   uint32_t → 4바이트 LE 배열
@@ -249,437 +431,40 @@ uint32_t decode_le4(const std::array<uint8_t, 4>& buf) {
            (static_cast<uint32_t>(buf[2]) << 16) | (static_cast<uint32_t>(buf[3]) << 24);
 }
 
-// ---------------------------------------------------------------------------
-// unescape_json_string
-//   JSON 문자열 값의 이스케이프를 처리하여 unescaped 값을 반환한다.
-// ---------------------------------------------------------------------------
-std::string unescape_json_string(std::string_view escaped_value) {
-    std::string result;
-    for (std::size_t i = 0; i < escaped_value.size(); ++i) {
-        const char c = escaped_value[i];
-        if (c == '\\' && i + 1 < escaped_value.size()) {
-            const char next = escaped_value[++i];
-            switch (next) {
-                case '"':
-                    result += '"';
-                    break;
-                case '\\':
-                    result += '\\';
-                    break;
-                case 'n':
-                    result += '\n';
-                    break;
-                case 'r':
-                    result += '\r';
-                    break;
-                case 't':
-                    result += '\t';
-                    break;
-                default:
-                    result += next;
-                    break;
-            }
-        } else {
-            result += c;
-        }
-    }
-    return result;
-}
-
-// ---------------------------------------------------------------------------
-// parse_top_level_string_field
-//   JSON object 문자열의 "최상위" 키에서 문자열 값을 추출한다.
-//   문자열 리터럴 내부의 "key": 패턴은 무시한다 (depth tracking 사용).
-//   파싱 실패 시 std::nullopt 반환.
-// ---------------------------------------------------------------------------
-std::optional<std::string> parse_top_level_string_field(std::string_view object_json,
-                                                        std::string_view field_key) {
-    if (object_json.empty() || object_json.front() != '{') {
-        return std::nullopt;
-    }
-
-    std::size_t object_depth = 0;
-    std::size_t array_depth = 0;
-    for (std::string_view::size_type i = 0; i < object_json.size();) {
-        const char c = object_json[i];
-        if (c == '{') {
-            ++object_depth;
-            ++i;
-            continue;
-        }
-        if (c == '}') {
-            if (object_depth == 0) {
-                return std::nullopt;
-            }
-            --object_depth;
-            ++i;
-            continue;
-        }
-        if (c == '[') {
-            ++array_depth;
-            ++i;
-            continue;
-        }
-        if (c == ']') {
-            if (array_depth == 0) {
-                return std::nullopt;
-            }
-            --array_depth;
-            ++i;
-            continue;
-        }
-        if (c == '"') {
-            const auto string_end = find_json_string_end(object_json, i);
-            if (string_end == std::string_view::npos) {
-                return std::nullopt;
-            }
-
-            // object_depth == 1 && array_depth == 0 이고 문자열 뒤에 ':'가 오면 key 위치다.
-            if (object_depth == 1 && array_depth == 0) {
-                auto cursor = string_end + 1;
-                while (cursor < object_json.size() && is_json_whitespace(object_json[cursor])) {
-                    ++cursor;
-                }
-                if (cursor < object_json.size() && object_json[cursor] == ':') {
-                    const auto key =
-                        object_json.substr(i + 1, static_cast<std::size_t>(string_end - i - 1));
-                    if (key == field_key) {
-                        ++cursor;  // ':'를 건넘
-                        while (cursor < object_json.size() &&
-                               is_json_whitespace(object_json[cursor])) {
-                            ++cursor;
-                        }
-                        // value가 문자열이어야 함
-                        if (cursor < object_json.size() && object_json[cursor] == '"') {
-                            const auto val_end = find_json_string_end(object_json, cursor);
-                            if (val_end == std::string_view::npos) {
-                                return std::nullopt;
-                            }
-                            auto after_value = val_end + 1;
-                            while (after_value < object_json.size() &&
-                                   is_json_whitespace(object_json[after_value])) {
-                                ++after_value;
-                            }
-                            if (after_value < object_json.size() && object_json[after_value] != ',' &&
-                                object_json[after_value] != '}') {
-                                return std::nullopt;
-                            }
-                            // 문자열 값 추출 및 unescape 처리
-                            const auto escaped_content =
-                                object_json.substr(cursor + 1, static_cast<std::size_t>(val_end - cursor - 1));
-                            return unescape_json_string(escaped_content);
-                        }
-                        return std::nullopt;
-                    }
-                }
-            }
-
-            i = string_end + 1;
-            continue;
-        }
-
-        ++i;
-    }
-
-    return std::nullopt;
-}
-
-// ---------------------------------------------------------------------------
-// parse_command
-//   JSON 요청 문자열에서 top-level "command" 필드를 파싱한다.
-//   문자열 값 내부의 "command": 패턴은 무시한다 (depth tracking 사용).
-//   파싱 실패 시 빈 문자열 반환.
-// ---------------------------------------------------------------------------
-std::string parse_command(std::string_view json) {
-    return parse_top_level_string_field(json, "command").value_or(std::string{});
-}
-
 // 단일 클라이언트에서 수신할 최대 메시지 크기 (4MiB)
 constexpr uint32_t kMaxRequestSize = 4U * 1024U * 1024U;
 
-// ---------------------------------------------------------------------------
-// parse_string_field
-//   JSON 문자열에서 특정 키의 문자열 값을 추출한다.
-//   "key":"value" 패턴만 지원. 중첩 객체/배열 미지원.
-//   파싱 실패 시 std::nullopt 반환.
-// ---------------------------------------------------------------------------
-std::optional<std::string> parse_string_field(std::string_view json, std::string_view key) {
-    // "key": 형태로 탐색 (따옴표 포함)
-    const std::string search_key = fmt::format("\"{}\":", key);
-    const auto pos = json.find(search_key);
-    if (pos == std::string_view::npos) {
-        return std::nullopt;
-    }
-    auto start = pos + search_key.size();
-    // 공백 건너뜀
-    while (start < json.size() && is_json_whitespace(json[start])) {
-        ++start;
-    }
-    if (start >= json.size() || json[start] != '"') {
-        return std::nullopt;
-    }
-    const auto val_start = start;
-    const auto val_end = find_json_string_end(json, val_start);
-    if (val_end == std::string_view::npos) {
-        return std::nullopt;
-    }
-    auto cursor = val_end + 1;
-    while (cursor < json.size() && is_json_whitespace(json[cursor])) {
-        ++cursor;
-    }
-    if (cursor < json.size() && json[cursor] != ',' && json[cursor] != '}') {
-        return std::nullopt;
-    }
-
-    const auto escaped_value =
-        json.substr(val_start + 1, static_cast<std::size_t>(val_end - val_start - 1));
-
-    return unescape_json_string(escaped_value);
-}
+// subscribe interval_ms 기본값 / 허용 범위
+constexpr std::uint64_t kDefaultSubscribeIntervalMs = 1000;
+constexpr std::uint64_t kMinSubscribeIntervalMs = 100;
+constexpr std::uint64_t kMaxSubscribeIntervalMs = 60000;
 
 // ---------------------------------------------------------------------------
-// find_json_object_end
-//   object_start(여는 '{' 위치)부터 매칭되는 닫는 '}' 위치를 찾는다.
-//   문자열 리터럴/이스케이프를 고려해 문자열 내부의 중괄호는 무시한다.
-//   매칭 실패 시 std::string_view::npos 반환.
+// parse_subscribe_interval
+//   {"command":"subscribe","payload":{"topic":"stats","interval_ms":N}}
+//   topic 은 "stats" 만 지원한다 (생략 시 stats). interval_ms 생략 시 기본값,
+//   범위 [kMinSubscribeIntervalMs, kMaxSubscribeIntervalMs] 밖이면 오류.
 // ---------------------------------------------------------------------------
-std::string_view::size_type find_json_object_end(std::string_view json,
-                                                 std::string_view::size_type object_start) {
-    if (object_start >= json.size() || json[object_start] != '{') {
-        return std::string_view::npos;
-    }
-
-    std::size_t depth = 0;
-    bool in_string = false;
-    bool escaped = false;
-    for (std::string_view::size_type i = object_start; i < json.size(); ++i) {
-        const char c = json[i];
-
-        if (in_string) {
-            if (escaped) {
-                escaped = false;
-                continue;
-            }
-            if (c == '\\') {
-                escaped = true;
-                continue;
-            }
-            if (c == '"') {
-                in_string = false;
-            }
-            continue;
+auto parse_subscribe_interval(const ControlRequest& request)
+    -> std::expected<std::chrono::milliseconds, std::string> {
+    if (request.payload.find("topic") != nullptr) {
+        const auto topic = request.payload.string_field("topic");
+        if (!topic || *topic != "stats") {
+            return std::unexpected(std::string{"unsupported subscribe topic (only 'stats')"});
         }
-
-        if (c == '"') {
-            in_string = true;
-            continue;
-        }
-        if (c == '{') {
-            ++depth;
-            continue;
-        }
-        if (c == '}') {
-            if (depth == 0) {
-                return std::string_view::npos;
-            }
-            --depth;
-            if (depth == 0) {
-                return i;
-            }
-        }
-    }
-
-    return std::string_view::npos;
-}
-
-// ---------------------------------------------------------------------------
-// parse_top_level_uint64_field
-//   JSON object 문자열의 "최상위" 키에서 uint64 값을 추출한다.
-//   문자열 리터럴 내부의 "key": 패턴은 무시한다.
-//   파싱 실패 또는 값 범위 초과 시 std::nullopt 반환.
-// ---------------------------------------------------------------------------
-std::optional<std::uint64_t> parse_top_level_uint64_field(std::string_view object_json,
-                                                          std::string_view field_key) {
-    if (object_json.empty() || object_json.front() != '{') {
-        return std::nullopt;
     }
 
-    std::size_t depth = 0;
-    for (std::string_view::size_type i = 0; i < object_json.size();) {
-        const char c = object_json[i];
-        if (c == '"') {
-            const auto string_end = find_json_string_end(object_json, i);
-            if (string_end == std::string_view::npos) {
-                return std::nullopt;
-            }
-
-            // depth == 1 이고 문자열 뒤에 ':'가 오면 key 위치다.
-            if (depth == 1) {
-                auto cursor = string_end + 1;
-                while (cursor < object_json.size() && is_json_whitespace(object_json[cursor])) {
-                    ++cursor;
-                }
-                if (cursor < object_json.size() && object_json[cursor] == ':') {
-                    const auto key =
-                        object_json.substr(i + 1, static_cast<std::size_t>(string_end - i - 1));
-                    if (key == field_key) {
-                        ++cursor;  // ':'
-                        while (cursor < object_json.size() &&
-                               is_json_whitespace(object_json[cursor])) {
-                            ++cursor;
-                        }
-                        if (cursor >= object_json.size() || object_json[cursor] < '0' ||
-                            object_json[cursor] > '9') {
-                            return std::nullopt;
-                        }
-
-                        std::uint64_t value = 0;
-                        while (cursor < object_json.size() && object_json[cursor] >= '0' &&
-                               object_json[cursor] <= '9') {
-                            const auto digit =
-                                static_cast<std::uint64_t>(object_json[cursor] - '0');
-                            if (value > (std::numeric_limits<std::uint64_t>::max() - digit) / 10U) {
-                                return std::nullopt;
-                            }
-                            value = value * 10U + digit;
-                            ++cursor;
-                        }
-
-                        while (cursor < object_json.size() &&
-                               is_json_whitespace(object_json[cursor])) {
-                            ++cursor;
-                        }
-                        if (cursor < object_json.size() && object_json[cursor] != ',' &&
-                            object_json[cursor] != '}') {
-                            return std::nullopt;
-                        }
-                        return value;
-                    }
-                }
-            }
-
-            i = string_end + 1;
-            continue;
+    std::uint64_t interval_ms = kDefaultSubscribeIntervalMs;
+    if (request.payload.find("interval_ms") != nullptr) {
+        const auto parsed = request.payload.uint64_field("interval_ms");
+        if (!parsed || *parsed < kMinSubscribeIntervalMs || *parsed > kMaxSubscribeIntervalMs) {
+            return std::unexpected(fmt::format("'interval_ms' must be an integer in [{}, {}]",
+                                               kMinSubscribeIntervalMs,
+                                               kMaxSubscribeIntervalMs));
         }
-
-        if (c == '{') {
-            ++depth;
-            ++i;
-            continue;
-        }
-        if (c == '}') {
-            if (depth == 0) {
-                return std::nullopt;
-            }
-            --depth;
-            ++i;
-            continue;
-        }
-
-        ++i;
+        interval_ms = *parsed;
     }
-
-    return std::nullopt;
-}
-
-// ---------------------------------------------------------------------------
-// extract_top_level_object_field
-//   JSON object 문자열의 최상위에서 field_key에 해당하는 object 값을 추출한다.
-//   문자열 리터럴 내부의 "field_key": 패턴은 무시한다.
-// ---------------------------------------------------------------------------
-std::optional<std::string_view> extract_top_level_object_field(std::string_view object_json,
-                                                               std::string_view field_key) {
-    if (object_json.empty() || object_json.front() != '{') {
-        return std::nullopt;
-    }
-
-    std::size_t depth = 0;
-    for (std::string_view::size_type i = 0; i < object_json.size();) {
-        const char c = object_json[i];
-        if (c == '"') {
-            const auto string_end = find_json_string_end(object_json, i);
-            if (string_end == std::string_view::npos) {
-                return std::nullopt;
-            }
-
-            if (depth == 1) {
-                auto cursor = string_end + 1;
-                while (cursor < object_json.size() && is_json_whitespace(object_json[cursor])) {
-                    ++cursor;
-                }
-                if (cursor < object_json.size() && object_json[cursor] == ':') {
-                    const auto key =
-                        object_json.substr(i + 1, static_cast<std::size_t>(string_end - i - 1));
-                    if (key == field_key) {
-                        ++cursor;  // ':'
-                        while (cursor < object_json.size() &&
-                               is_json_whitespace(object_json[cursor])) {
-                            ++cursor;
-                        }
-                        if (cursor >= object_json.size() || object_json[cursor] != '{') {
-                            return std::nullopt;
-                        }
-                        const auto end = find_json_object_end(object_json, cursor);
-                        if (end == std::string_view::npos) {
-                            return std::nullopt;
-                        }
-                        return object_json.substr(
-                            cursor, static_cast<std::size_t>(end - cursor + 1));
-                    }
-                }
-            }
-
-            i = string_end + 1;
-            continue;
-        }
-
-        if (c == '{') {
-            ++depth;
-            ++i;
-            continue;
-        }
-        if (c == '}') {
-            if (depth == 0) {
-                return std::nullopt;
-            }
-            --depth;
-            ++i;
-            continue;
-        }
-
-        ++i;
-    }
-
-    return std::nullopt;
-}
-
-// ---------------------------------------------------------------------------
-// parse_payload_string_field
-//   요청 JSON 에서 payload 오브젝트 내 특정 문자열 필드를 추출한다.
-//   {"command":"...", "payload": {"key": "value", ...}} 패턴을 처리한다.
-//   payload 키를 찾지 못하거나 필드가 없으면 std::nullopt 반환.
-// ---------------------------------------------------------------------------
-std::optional<std::string> parse_payload_string_field(std::string_view json,
-                                                      std::string_view field_key) {
-    const auto payload_json = extract_top_level_object_field(json, "payload");
-    if (!payload_json) {
-        return std::nullopt;
-    }
-    return parse_string_field(*payload_json, field_key);
-}
-
-// ---------------------------------------------------------------------------
-// parse_payload_uint64_field
-//   요청 JSON 에서 payload 오브젝트 "최상위"의 uint64 필드를 추출한다.
-//   문자열 내부/중첩 오브젝트의 "key": 패턴은 무시한다.
-// ---------------------------------------------------------------------------
-std::optional<std::uint64_t> parse_payload_uint64_field(std::string_view json,
-                                                        std::string_view field_key) {
-    const auto payload_json = extract_top_level_object_field(json, "payload");
-    if (!payload_json) {
-        return std::nullopt;
-    }
-    return parse_top_level_uint64_field(*payload_json, field_key);
+    return std::chrono::milliseconds{interval_ms};
 }
 
 // ---------------------------------------------------------------------------
@@ -786,6 +571,7 @@ UdsServer::UdsServer(const std::filesystem::path& socket_path,
       version_store_{nullptr},
       policy_config_path_{},
       ioc_{ioc},
+      strand_{asio::make_strand(ioc)},
       acceptor_{ioc} {}
 
 // NOLINTNEXTLINE(modernize-pass-by-value)
@@ -801,6 +587,7 @@ UdsServer::UdsServer(const std::filesystem::path& socket_path,
       version_store_{nullptr},
       policy_config_path_{},
       ioc_{ioc},
+      strand_{asio::make_strand(ioc)},
       acceptor_{ioc} {}
 
 // NOLINTNEXTLINE(modernize-pass-by-value)
@@ -818,6 +605,7 @@ UdsServer::UdsServer(const std::filesystem::path& socket_path,
       version_store_{std::move(version_store)},
       policy_config_path_{std::move(policy_config_path)},
       ioc_{ioc},
+      strand_{asio::make_strand(ioc)},
       acceptor_{ioc} {}
 
 UdsServer::~UdsServer() {
@@ -844,6 +632,22 @@ void UdsServer::set_allowed_uid(uid_t uid) {
     allowed_uid_set_.store(true, std::memory_order_release);
 }
 
+void UdsServer::set_session_registry(std::shared_ptr<SessionRegistry> registry) {
+    session_registry_ = std::move(registry);
+}
+
+void UdsServer::set_user_accounting(std::shared_ptr<UserAccounting> accounting) {
+    user_accounting_ = std::move(accounting);
+}
+
+void UdsServer::set_query_topk(std::shared_ptr<QueryTopK> topk) {
+    query_topk_ = std::move(topk);
+}
+
+void UdsServer::set_drain_control(DrainControl control) {
+    drain_control_ = std::move(control);
+}
+
 // ---------------------------------------------------------------------------
 // stop
 //   acceptor를 닫아 run()의 accept 루프를 종료한다.
@@ -867,12 +671,13 @@ void UdsServer::stop() {
         }
     };
 
-    // acceptor 소유 스레드(io_context)에서 정리해 TSan 경합을 방지한다.
+    // acceptor 소유 strand 에서 정리해 TSan 경합을 방지한다.
+    // (io_context 를 여러 워커 스레드가 run() 하는 경우에도 accept 루프와 직렬화된다)
     if (ioc_.stopped()) {
         close_acceptor();
         return;
     }
-    asio::post(ioc_, std::move(close_acceptor));
+    asio::post(strand_, std::move(close_acceptor));
 }
 
 // ---------------------------------------------------------------------------
@@ -1038,114 +843,359 @@ asio::awaitable<void> UdsServer::handle_client(asio::local::stream_protocol::soc
 
     const auto io_executor = client_socket.get_executor();
 
-    // DON-53: 읽기 타임아웃용 타이머
+    // DON-53: 타임아웃 타이머 — 요청을 기다리는 동안(유휴)과 응답을 쓰는 동안 건다.
+    //   연결이 여러 요청을 나르므로 프레임마다 다시 건다. 만료되면 소켓을 닫아 진행 중인
+    //   async_read / async_write 를 끝낸다.
     asio::steady_timer deadline{io_executor};
-    deadline.expires_after(
-        std::chrono::seconds(client_timeout_sec_.load(std::memory_order_relaxed)));
-    deadline.async_wait([socket_sp](boost::system::error_code ec) {
-        if (!ec) {
-            // 타임아웃 발생 — 소켓을 닫아 진행 중인 async_read 를 취소한다
-            boost::system::error_code close_ec;
-            socket_sp->close(close_ec);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+    const auto arm_deadline = [this, &deadline, socket_sp] {
+        deadline.expires_after(
+            std::chrono::seconds(client_timeout_sec_.load(std::memory_order_relaxed)));
+        deadline.async_wait([socket_sp](boost::system::error_code ec) {
+            if (!ec) {
+                boost::system::error_code close_ec;
+                socket_sp->close(close_ec);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+            }
+        });
+    };
+
+    // 요청 바디 버퍼는 연결 수명 동안 재사용한다
+    std::vector<char> body_buf;
+
+    while (!stop_requested_.load(std::memory_order_acquire)) {
+        arm_deadline();
+
+        // ── 요청 헤더 읽기 ──────────────────────────────────────────────
+        std::array<uint8_t, 4> req_hdr{};
+        auto [hdr_ec, hdr_n] = co_await asio::async_read(
+            client_socket, asio::buffer(req_hdr), asio::as_tuple(asio::use_awaitable));
+
+        if (hdr_ec) {
+            // 요청 경계의 EOF 는 클라이언트의 정상 종료다
+            if (hdr_ec != asio::error::eof) {
+                spdlog::warn("[uds_server] handle_client: read header error: {}",
+                             hdr_ec.message());
+            }
+            break;
+        }
+        if (hdr_n != 4) {
+            spdlog::warn("[uds_server] handle_client: short header ({} bytes)", hdr_n);
+            break;
         }
-    });
 
-    // ── 요청 헤더 읽기 ──────────────────────────────────────────────────
-    std::array<uint8_t, 4> req_hdr{};
-    auto [hdr_ec, hdr_n] = co_await asio::async_read(
-        client_socket, asio::buffer(req_hdr), asio::as_tuple(asio::use_awaitable));
+        // 길이가 틀린 프레임 뒤로는 경계를 믿을 수 없으므로 연결을 닫는다
+        const uint32_t body_len = decode_le4(req_hdr);
+        if (body_len == 0 || body_len > kMaxRequestSize) {
+            spdlog::warn("[uds_server] handle_client: invalid body length {}", body_len);
+            break;
+        }
 
-    if (hdr_ec) {
-        if (hdr_ec != asio::error::eof) {
-            spdlog::warn("[uds_server] handle_client: read header error: {}", hdr_ec.message());
+        // ── 요청 바디 읽기 ──────────────────────────────────────────────
+        body_buf.resize(body_len);
+        auto [body_ec, body_n] = co_await asio::async_read(
+            client_socket, asio::buffer(body_buf), asio::as_tuple(asio::use_awaitable));
+
+        if (body_ec) {
+            spdlog::warn("[uds_server] handle_client: read body error: {}", body_ec.message());
+            break;
+        }
+        if (body_n != body_len) {
+            spdlog::warn("[uds_server] handle_client: short body ({}/{} bytes)", body_n, body_len);
+            break;
         }
-        co_return;
-    }
-    if (hdr_n != 4) {
-        spdlog::warn("[uds_server] handle_client: short header ({} bytes)", hdr_n);
-        co_return;
-    }
 
-    const uint32_t body_len = decode_le4(req_hdr);
-    if (body_len == 0 || body_len > kMaxRequestSize) {
-        spdlog::warn("[uds_server] handle_client: invalid body length {}", body_len);
-        co_return;
-    }
+        // ── 파싱 + 디스패치 ─────────────────────────────────────────────
+        // JSON 문법 오류는 해당 요청만 거절한다 (프레임 경계는 길이 헤더로 유지된다)
+        auto request = parse_control_request(std::string_view{body_buf.data(), body_n});
+        std::string cmd;
+        std::string response_body;
+
+        if (!request) {
+            spdlog::warn("[uds_server] handle_client: malformed request JSON: {}",
+                         request.error());
+            response_body =
+                make_error_response(fmt::format("malformed request JSON: {}", request.error()));
+        } else if (request->command == "listener_handoff") {
+            // listener_handoff — 응답 프레임에 리스너 fd 를 실어 보낸다 (송신은 핸들러가 수행)
+            auto error_response = co_await handle_listener_handoff(*request, client_socket);
+            if (!error_response) {
+                deadline.cancel();
+                co_return;
+            }
+            cmd = request->command;
+            response_body = std::move(*error_response);
+        } else if (request->command == "subscribe") {
+            // subscribe — 이후 이 연결은 요청을 받지 않고 stats 푸시 전용이 된다
+            auto interval = parse_subscribe_interval(*request);
+            if (interval) {
+                deadline.cancel();
+                co_await stream_stats(socket_sp, *interval);
+                co_return;
+            }
+            cmd = request->command;
+            spdlog::warn("[uds_server] handle_client: subscribe rejected: {}", interval.error());
+            response_body = make_error_response(interval.error());
+        } else {
+            cmd = request->command;
+            response_body = co_await dispatch_command(*request);
+        }
 
-    // ── 요청 바디 읽기 ──────────────────────────────────────────────────
-    std::vector<char> body_buf(body_len);
-    auto [body_ec, body_n] = co_await asio::async_read(
-        client_socket, asio::buffer(body_buf), asio::as_tuple(asio::use_awaitable));
+        // ── 응답 송신 ───────────────────────────────────────────────────
+        const auto resp_len = static_cast<uint32_t>(response_body.size());
+        const auto resp_hdr = encode_le4(resp_len);
+
+        // 헤더 + 바디를 gather-write
+        const std::array<asio::const_buffer, 2> bufs{
+            asio::buffer(resp_hdr),
+            asio::buffer(response_body),
+        };
+        auto [write_ec, write_n] =
+            co_await asio::async_write(client_socket, bufs, asio::as_tuple(asio::use_awaitable));
+
+        if (write_ec) {
+            spdlog::warn("[uds_server] handle_client: write error: {}", write_ec.message());
+            break;
+        }
 
-    if (body_ec) {
-        spdlog::warn("[uds_server] handle_client: read body error: {}", body_ec.message());
-        co_return;
-    }
-    if (body_n != body_len) {
-        spdlog::warn("[uds_server] handle_client: short body ({}/{} bytes)", body_n, body_len);
-        co_return;
+        spdlog::debug("[uds_server] handled command='{}' response_bytes={}", cmd, write_n);
     }
 
-    const std::string_view request_json{body_buf.data(), body_n};
+    // DON-53: 연결 종료 — 타이머 취소
+    deadline.cancel();
+}
 
-    // ── 커맨드 디스패치 ─────────────────────────────────────────────────
-    const std::string cmd = parse_command(request_json);
-    std::string response_body;
+// ---------------------------------------------------------------------------
+// dispatch_command
+//   요청 / 응답 한 번으로 끝나는 커맨드를 실행한다 (listener_handoff / subscribe 는
+//   handle_client 가 직접 처리). 호출한 io 스레드로 돌아온 뒤 응답 JSON 을 반환한다.
+//
+//   실행 위치:
+//     - stats / drain               : io 스레드 (atomic load / post 만 한다)
+//     - 조회 커맨드                  : control_pool_ (여러 스레드에서 병렬)
+//     - policy_reload / rollback    : control_strand_ (SIGHUP 리로드와 한 줄로 직렬화)
+//   조회 커맨드는 세션 목록 직렬화, SQL 파싱, 버전 스토어 mutex 대기처럼 수 ms 걸릴 수 있어
+//   데이터패스 io_context 에서 빼낸다. 변경 커맨드는 strand 에 있으므로 조회와 겹쳐도
+//   변경끼리는 순서가 유지된다.
+// ---------------------------------------------------------------------------
+asio::awaitable<std::string> UdsServer::dispatch_command(const ControlRequest& request) {
+    const auto io_executor = co_await asio::this_coro::executor;
+    const std::string& cmd = request.command;
 
     if (cmd == "stats") {
         // stats — StatsSnapshot 직렬화 후 반환
         const StatsSnapshot snap = stats_->snapshot();
-        response_body = make_ok_response(serialize_snapshot(snap));
-    } else if (cmd == "policy_explain") {
+        co_return make_ok_response(serialize_snapshot(snap));
+    }
+    if (cmd == "drain") {
+        // drain — accept 중단 + 세션 정상 종료 (ProxyServer 가 세션 strand 로 post 만 한다)
+        if (!drain_control_.begin_drain) {
+            co_return make_not_implemented_response("drain");
+        }
+        drain_control_.begin_drain("drain requested via UDS", false);
+        co_return make_ok_response(R"({"draining":true})");
+    }
+
+    if (cmd == "policy_reload" || cmd == "policy_rollback") {
+        // policy_reload — 정책 파일 리로드 + 스냅샷 저장 (DON-50)
+        // policy_rollback — 특정 버전으로 정책 롤백 (DON-50)
+        // 파일 I/O / 파싱 / 해시 계산이 포함되므로 control_strand_ 에서 실행한다.
+        co_await asio::dispatch(control_strand_, asio::use_awaitable);
+        std::string response = cmd == "policy_reload" ? handle_policy_reload(request)
+                                                      : handle_policy_rollback(request);
+        co_await asio::dispatch(io_executor, asio::use_awaitable);
+        co_return response;
+    }
+
+    std::string (UdsServer::*handler)(const ControlRequest&) = nullptr;
+    if (cmd == "policy_explain") {
         // policy_explain — SQL 정책 평가 dry-run (DON-48)
-        response_body = handle_policy_explain(request_json);
+        handler = &UdsServer::handle_policy_explain;
     } else if (cmd == "policy_versions") {
         // policy_versions — 저장된 정책 버전 목록 조회 (DON-50)
-        response_body = handle_policy_versions(request_json);
-    } else if (cmd == "policy_rollback") {
-        // policy_rollback — 특정 버전으로 정책 롤백 (DON-50)
-        // 파일 I/O/파싱이 포함되므로 control_pool_에서 실행해 이벤트 루프 블로킹을 방지한다.
-        co_await asio::dispatch(control_pool_.get_executor(), asio::use_awaitable);
-        response_body = handle_policy_rollback(request_json);
-        co_await asio::dispatch(io_executor, asio::use_awaitable);
-    } else if (cmd == "policy_reload") {
-        // policy_reload — 정책 파일 리로드 + 스냅샷 저장 (DON-50)
-        // 파일 I/O/해시 계산이 포함되므로 control_pool_에서 실행해 이벤트 루프 블로킹을 방지한다.
-        co_await asio::dispatch(control_pool_.get_executor(), asio::use_awaitable);
-        response_body = handle_policy_reload(request_json);
-        co_await asio::dispatch(io_executor, asio::use_awaitable);
+        handler = &UdsServer::handle_policy_versions;
+    } else if (cmd == "policy_stats") {
+        // policy_stats — 규칙별 적중 수 / 평가 비용 (read-only, atomic 합산만 수행)
+        handler = &UdsServer::handle_policy_stats;
     } else if (cmd == "sessions") {
-        // Phase 3 구현 예정
-        response_body = make_not_implemented_response("sessions");
+        // sessions — 활성 세션 목록 (샤드별 포인터 복사 후 락 밖에서 직렬화)
+        handler = &UdsServer::handle_sessions;
+    } else if (cmd == "user_stats") {
+        // user_stats — 사용자별 집계 Top-N (게시된 불변 테이블 atomic load)
+        handler = &UdsServer::handle_user_stats;
+    } else if (cmd == "top_queries") {
+        // top_queries — fingerprint 별 Top-N (샤드를 하나씩 잠그고 카운터 복사)
+        handler = &UdsServer::handle_top_queries;
     } else if (cmd.empty()) {
         spdlog::warn("[uds_server] handle_client: missing or malformed 'command' field");
-        response_body = make_error_response("missing or malformed 'command' field");
+        co_return make_error_response("missing or malformed 'command' field");
     } else {
         spdlog::warn("[uds_server] handle_client: unknown command '{}'", cmd);
-        response_body = make_error_response(fmt::format("unknown command '{}'", cmd));
+        co_return make_error_response(fmt::format("unknown command '{}'", cmd));
     }
 
-    // ── 응답 송신 ───────────────────────────────────────────────────────
-    const auto resp_len = static_cast<uint32_t>(response_body.size());
-    const auto resp_hdr = encode_le4(resp_len);
+    co_await asio::dispatch(control_pool_.get_executor(), asio::use_awaitable);
+    std::string response = (this->*handler)(request);
+    co_await asio::dispatch(io_executor, asio::use_awaitable);
+    co_return response;
+}
 
-    // 헤더 + 바디를 gather-write
-    const std::array<asio::const_buffer, 2> bufs{
-        asio::buffer(resp_hdr),
-        asio::buffer(response_body),
-    };
-    auto [write_ec, write_n] =
-        co_await asio::async_write(client_socket, bufs, asio::as_tuple(asio::use_awaitable));
+// ---------------------------------------------------------------------------
+// stream_stats
+//   subscribe 이후의 푸시 루프. interval 마다 StatsSnapshot 을 직렬화해 프레임을 쓴다:
+//     {"ok":true,"event":"stats","seq":N,"full":B,"interval_ms":I,"payload":{...}}
+//   seq 1 (full:true) 은 전체 스냅샷, 이후 프레임은 직전 프레임과 달라진 최상위 필드만
+//   담는다 (json_object_delta). 구독자는 받은 필드를 덮어써 전체 상태를 유지한다.
+//
+//   쓰기가 client_timeout_sec 안에 끝나지 않거나 실패하면(연결 종료 포함) 루프를 끝낸다.
+//   연결을 닫는 것이 구독 해제다.
+// ---------------------------------------------------------------------------
+asio::awaitable<void> UdsServer::stream_stats(
+    std::shared_ptr<asio::local::stream_protocol::socket> socket_sp,
+    std::chrono::milliseconds interval) {
+    auto& client_socket = *socket_sp;
+    const auto io_executor = client_socket.get_executor();
+    asio::steady_timer tick{io_executor};
+    asio::steady_timer write_deadline{io_executor};
+
+    // 직전 스냅샷의 멤버는 texts[previous_index] 를 가리킨다. 두 버퍼를 번갈아 써서
+    // 새 스냅샷을 직렬화하는 동안에도 직전 멤버가 유효하게 한다.
+    std::array<std::string, 2> texts{};
+    std::size_t current_index = 0;
+    JsonObject previous{};
+    std::uint64_t seq = 0;
+    auto next_tick = std::chrono::steady_clock::now();
+
+    spdlog::info("[uds_server] stats subscription started (interval_ms={})", interval.count());
+
+    while (!stop_requested_.load(std::memory_order_acquire)) {
+        std::string& current_text = texts[current_index];
+        current_text = serialize_snapshot(stats_->snapshot());
+        auto current = parse_json_object(current_text);
+        if (!current) {
+            spdlog::error("[uds_server] stream_stats: snapshot JSON rejected: {}",
+                          current.error());
+            break;
+        }
 
-    if (write_ec) {
-        spdlog::warn("[uds_server] handle_client: write error: {}", write_ec.message());
-        co_return;
+        ++seq;
+        const bool full = seq == 1;
+        const std::string delta = full ? std::string{} : json_object_delta(*current, previous);
+        const std::string frame = fmt::format(R"({{"ok":true,"event":"stats","seq":{},"full":{},)"
+                                              R"("interval_ms":{},"payload":{}}})",
+                                              seq,
+                                              full,
+                                              interval.count(),
+                                              full ? current_text : delta);
+        const auto frame_hdr = encode_le4(static_cast<uint32_t>(frame.size()));
+        const std::array<asio::const_buffer, 2> bufs{
+            asio::buffer(frame_hdr),
+            asio::buffer(frame),
+        };
+
+        write_deadline.expires_after(
+            std::chrono::seconds(client_timeout_sec_.load(std::memory_order_relaxed)));
+        write_deadline.async_wait([socket_sp](boost::system::error_code ec) {
+            if (!ec) {
+                boost::system::error_code close_ec;
+                socket_sp->close(close_ec);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+            }
+        });
+        auto [write_ec, write_n] =
+            co_await asio::async_write(client_socket, bufs, asio::as_tuple(asio::use_awaitable));
+        write_deadline.cancel();
+        if (write_ec) {
+            spdlog::debug("[uds_server] stream_stats: write ended: {}", write_ec.message());
+            break;
+        }
+
+        previous = std::move(*current);
+        current_index ^= 1U;
+
+        // 주기는 시작 시각 기준으로 고정한다. 한 주기 이상 밀리면(느린 구독자) 몰아서
+        // 보내지 않고 지금부터 다시 센다.
+        next_tick += interval;
+        const auto now = std::chrono::steady_clock::now();
+        if (next_tick < now) {
+            next_tick = now + interval;
+        }
+        tick.expires_at(next_tick);
+        auto [tick_ec] = co_await tick.async_wait(asio::as_tuple(asio::use_awaitable));
+        if (tick_ec) {
+            break;
+        }
     }
 
-    // DON-53: 정상 완료 — 타이머 취소
-    deadline.cancel();
+    spdlog::info("[uds_server] stats subscription ended after {} frames", seq);
+}
+
+// ---------------------------------------------------------------------------
+// handle_listener_handoff
+//   listener_fds() → 응답 프레임 + SCM_RIGHTS 송신 → begin_drain().
+//   fd 는 프레임의 첫 sendmsg 에 붙인다. 소켓 버퍼가 차 있으면(EAGAIN) io 스레드를 막지
+//   않고 wait_write 를 기다려 다시 시도하며, fd 가 나간 뒤의 나머지는 async_write 로 보낸다.
+// ---------------------------------------------------------------------------
+asio::awaitable<std::optional<std::string>> UdsServer::handle_listener_handoff(
+    const ControlRequest& request, asio::local::stream_protocol::socket& socket) {
+    if (!drain_control_.listener_fds || !drain_control_.begin_drain) {
+        co_return make_not_implemented_response("listener_handoff");
+    }
+    const auto listen_port = request.payload.uint64_field("listen_port");
+    if (!listen_port || *listen_port == 0 || *listen_port > 65535) {
+        co_return make_error_response("missing or invalid field: listen_port");
+    }
+    if (handoff_claimed_.exchange(true, std::memory_order_acq_rel)) {
+        co_return make_error_response("listener already handed off");
+    }
+    const auto fds = drain_control_.listener_fds(static_cast<std::uint16_t>(*listen_port));
+    if (fds.empty()) {
+        handoff_claimed_.store(false, std::memory_order_release);
+        co_return make_error_response(
+            "no listener to hand off (port mismatch, not listening or draining)");
+    }
+
+    const auto body = make_ok_response(fmt::format(R"({{"listeners":{}}})", fds.size()));
+    const auto header = encode_frame_length(static_cast<std::uint32_t>(body.size()));
+    std::string frame;
+    frame.reserve(header.size() + body.size());
+    frame.append(header.data(), header.size());
+    frame += body;
+
+    // 실패 시 프레임 일부가 나갔을 수 있으므로 오류 응답을 덧붙이지 않고 연결만 닫는다
+    const auto fail = [this](std::string_view reason) {
+        spdlog::error("[uds_server] listener handoff failed: {}", reason);
+        handoff_claimed_.store(false, std::memory_order_release);
+    };
+
+    std::size_t sent = 0;
+    while (sent == 0) {
+        auto n = try_send_with_fds(socket.native_handle(), frame, fds);
+        if (!n) {
+            fail(n.error());
+            co_return std::nullopt;
+        }
+        sent = *n;
+        if (sent == 0) {
+            auto [wait_ec] = co_await socket.async_wait(asio::socket_base::wait_write,
+                                                        asio::as_tuple(asio::use_awaitable));
+            if (wait_ec) {
+                fail(wait_ec.message());
+                co_return std::nullopt;
+            }
+        }
+    }
+    if (sent < frame.size()) {
+        auto [write_ec, write_n] = co_await asio::async_write(
+            socket,
+            asio::buffer(frame.data() + sent, frame.size() - sent),
+            asio::as_tuple(asio::use_awaitable));
+        if (write_ec) {
+            fail(write_ec.message());
+            co_return std::nullopt;
+        }
+    }
 
-    spdlog::debug("[uds_server] handled command='{}' response_bytes={}", cmd, write_n);
+    spdlog::info("[uds_server] handed off {} listener(s), starting drain", fds.size());
+    drain_control_.begin_drain("listener handed off", true);
+    co_return std::nullopt;
 }
 
 // ---------------------------------------------------------------------------
@@ -1158,7 +1208,7 @@ asio::awaitable<void> UdsServer::handle_client(asio::local::stream_protocol::soc
 //   - policy_engine_ 또는 sql_parser_ nullptr → not-implemented 반환
 //   - 예외 발생 → ok:false 반환 (데이터패스 비전파)
 // ---------------------------------------------------------------------------
-std::string UdsServer::handle_policy_explain(std::string_view request_json) {
+std::string UdsServer::handle_policy_explain(const ControlRequest& request) {
     // policy_engine / sql_parser 미주입 시 not-implemented 반환
     if (!policy_engine_ || !sql_parser_) {
         spdlog::warn("[uds_server] policy_explain: policy_engine or sql_parser not configured");
@@ -1166,9 +1216,9 @@ std::string UdsServer::handle_policy_explain(std::string_view request_json) {
     }
 
     // ── payload 필드 파싱 ────────────────────────────────────────────────
-    const auto sql_opt = parse_payload_string_field(request_json, "sql");
-    const auto user_opt = parse_payload_string_field(request_json, "user");
-    const auto source_ip_opt = parse_payload_string_field(request_json, "source_ip");
+    const auto sql_opt = request.payload.string_field("sql");
+    const auto user_opt = request.payload.string_field("user");
+    const auto source_ip_opt = request.payload.string_field("source_ip");
 
     if (!sql_opt) {
         spdlog::warn("[uds_server] policy_explain: missing required field: sql");
@@ -1239,7 +1289,7 @@ std::string UdsServer::handle_policy_explain(std::string_view request_json) {
 //   version_store_ 미주입 시 not-implemented 반환.
 //   예외 발생 시 ok:false 반환 (데이터패스 비전파).
 // ---------------------------------------------------------------------------
-std::string UdsServer::handle_policy_versions(std::string_view /*request_json*/) {
+std::string UdsServer::handle_policy_versions(const ControlRequest& /*request*/) {
     if (!version_store_ || !policy_engine_) {
         spdlog::warn("[uds_server] policy_versions: version_store or policy_engine not configured");
         return make_not_implemented_response("policy_versions");
@@ -1283,6 +1333,158 @@ std::string UdsServer::handle_policy_versions(std::string_view /*request_json*/)
     }
 }
 
+// ---------------------------------------------------------------------------
+// handle_sessions
+//   활성 세션 목록을 session_id 오름차순으로 반환한다 (최대 kMaxSessionsListed 개).
+//
+//   [응답 형식]
+//   {"ok":true,"payload":{"total":2,"truncated":false,"sessions":[{"session_id":1,
+//    "client_ip":"10.0.0.5","client_port":51234,"db_user":"app","db_name":"shop",
+//    "state":"ready","queries":120,"blocked":1,"bytes_in":8400,"bytes_out":96000,
+//    "connected_at_ms":1700000000000,"last_query_at_ms":1700000042000},...]}}
+//
+//   [fail-close]
+//   session_registry_ 미주입 시 not-implemented 반환. 예외 발생 시 ok:false 반환.
+// ---------------------------------------------------------------------------
+std::string UdsServer::handle_sessions(const ControlRequest& /*request*/) {
+    if (!session_registry_) {
+        return make_not_implemented_response("sessions");
+    }
+
+    try {
+        // size() 와 snapshot() 사이에 세션이 오갈 수 있으므로 total 은 근사치다
+        const auto sessions = session_registry_->snapshot(kMaxSessionsListed);
+        const std::size_t total = std::max(session_registry_->size(), sessions.size());
+        const bool truncated = sessions.size() == kMaxSessionsListed && total > sessions.size();
+        return make_ok_response(serialize_sessions(sessions, total, truncated));
+    } catch (const std::exception& e) {
+        spdlog::error("[uds_server] sessions: exception: {}", e.what());
+        return make_error_response("internal error during sessions");
+    } catch (...) {
+        spdlog::error("[uds_server] sessions: unknown exception");
+        return make_error_response("internal error during sessions");
+    }
+}
+
+// ---------------------------------------------------------------------------
+// handle_user_stats
+//   db_user 별 누적 집계의 상위 limit 개를 sort 내림차순으로 반환한다.
+//   테이블은 통계 tick(1초)마다 갱신되므로 최대 1초 전 값이다 (captured_at_ms).
+//
+//   [요청] {"command":"user_stats","payload":{"sort":"bytes_out","limit":10}}
+//          payload 생략 시 sort=queries, limit=20. limit 은 1..1000 으로 제한.
+//
+//   [응답 형식]
+//   {"ok":true,"payload":{"captured_at_ms":1700000000000,"total_users":2,"sort":"bytes_out",
+//    "users":[{"db_user":"app","active_sessions":3,"sessions":40,"queries":9100,
+//    "blocked":2,"bytes_in":812000,"bytes_out":96000000,"upstream_us":4100000},...]}}
+// ---------------------------------------------------------------------------
+std::string UdsServer::handle_user_stats(const ControlRequest& request) {
+    if (!user_accounting_) {
+        return make_not_implemented_response("user_stats");
+    }
+
+    const std::string sort =
+        request.payload.string_field("sort").value_or(std::string{"queries"});
+    const auto key = parse_user_sort_key(sort);
+    if (!key) {
+        return make_error_response(fmt::format(
+            "unknown sort '{}' (want queries, blocked, bytes_in, bytes_out, upstream_us, sessions)",
+            sort));
+    }
+    const std::uint64_t requested =
+        request.payload.uint64_field("limit").value_or(kDefaultUserStatsLimit);
+    const auto limit = static_cast<std::size_t>(
+        std::clamp<std::uint64_t>(requested, 1U, kMaxUserStatsLimit));
+
+    try {
+        const auto table = user_accounting_->snapshot();
+        const auto top = top_users(table->users, *key, limit);
+        return make_ok_response(
+            serialize_user_stats(top, table->users.size(), sort, table->captured_at_ms));
+    } catch (const std::exception& e) {
+        spdlog::error("[uds_server] user_stats: exception: {}", e.what());
+        return make_error_response("internal error during user_stats");
+    } catch (...) {
+        spdlog::error("[uds_server] user_stats: unknown exception");
+        return make_error_response("internal error during user_stats");
+    }
+}
+
+// ---------------------------------------------------------------------------
+// handle_top_queries
+//   QueryTopK 스케치에서 sort 기준 상위 구문 형태를 반환한다.
+//   count 는 Space-Saving 추정치(실제 ≥ count - error)이고, 지연은 카운터가 현재 형태를
+//   맡은 뒤 응답 릴레이까지 끝난 쿼리만 담는다. "slow" 는 sort=upstream_us / p99_us 로 본다.
+//
+//   [요청] {"command":"top_queries","payload":{"sort":"upstream_us","limit":10}}
+//          payload 생략 시 sort=count, limit=20. limit 은 1..1000 으로 제한.
+//
+//   [응답 형식]
+//   {"ok":true,"payload":{"capacity":256,"tracked":120,"recorded":981000,"untracked":12,
+//    "sort":"upstream_us","queries":[{"id":"9f2c41d0a1b2c3d4",
+//    "fingerprint":"SELECT * FROM orders WHERE id = ?","truncated":false,"count":51000,
+//    "error":0,"blocked":0,"latency_count":50990,"upstream_us":9120000,"avg_us":178.9,
+//    "p50_us":159,"p99_us":895,"max_us":20411},...]}}
+// ---------------------------------------------------------------------------
+std::string UdsServer::handle_top_queries(const ControlRequest& request) {
+    if (!query_topk_) {
+        return make_not_implemented_response("top_queries");
+    }
+
+    const std::string sort = request.payload.string_field("sort").value_or(std::string{"count"});
+    const auto key = parse_query_sort_key(sort);
+    if (!key) {
+        return make_error_response(
+            fmt::format("unknown sort '{}' (want count, blocked, upstream_us, p99_us)", sort));
+    }
+    const std::uint64_t requested =
+        request.payload.uint64_field("limit").value_or(kDefaultTopQueriesLimit);
+    const auto limit = static_cast<std::size_t>(
+        std::clamp<std::uint64_t>(requested, 1U, kMaxTopQueriesLimit));
+
+    try {
+        const auto snap = query_topk_->snapshot();
+        const auto top = top_queries(snap.entries, *key, limit);
+        return make_ok_response(serialize_top_queries(top, snap, sort));
+    } catch (const std::exception& e) {
+        spdlog::error("[uds_server] top_queries: exception: {}", e.what());
+        return make_error_response("internal error during top_queries");
+    } catch (...) {
+        spdlog::error("[uds_server] top_queries: unknown exception");
+        return make_error_response("internal error during top_queries");
+    }
+}
+
+// ---------------------------------------------------------------------------
+// handle_policy_stats
+//   현재 정책 스냅샷의 규칙별 적중 수 / 누적 평가 시간을 반환한다.
+//
+//   [응답 형식]
+//   {"ok":true,"payload":{"version":5,"access_rules":[{"index":0,"rule":"app@10.0.0.0/8",
+//    "evaluations":120,"hits":980,"total_ns":360000,"avg_ns":3000.0},...],
+//    "block_patterns":[...],"no_access_rule":{...}}}
+//
+//   [fail-close]
+//   policy_engine_ 미주입 시 not-implemented 반환. 예외 발생 시 ok:false 반환.
+// ---------------------------------------------------------------------------
+std::string UdsServer::handle_policy_stats(const ControlRequest& /*request*/) {
+    if (!policy_engine_) {
+        spdlog::warn("[uds_server] policy_stats: policy_engine not configured");
+        return make_not_implemented_response("policy_stats");
+    }
+
+    try {
+        return make_ok_response(serialize_rule_stats(policy_engine_->rule_stats()));
+    } catch (const std::exception& e) {
+        spdlog::error("[uds_server] policy_stats: exception: {}", e.what());
+        return make_error_response("internal error during policy_stats");
+    } catch (...) {
+        spdlog::error("[uds_server] policy_stats: unknown exception");
+        return make_error_response("internal error during policy_stats");
+    }
+}
+
 // ---------------------------------------------------------------------------
 // handle_policy_rollback (DON-50)
 //   payload 에서 target_version 을 파싱하여 해당 스냅샷으로 정책을 롤백한다.
@@ -1299,7 +1501,7 @@ std::string UdsServer::handle_policy_versions(std::string_view /*request_json*/)
 //   - load_snapshot 실패 시 현재 정책 유지 + ok:false 반환.
 //   - reload 실패 시 현재 정책 유지 + ok:false 반환 (예외 처리).
 // ---------------------------------------------------------------------------
-std::string UdsServer::handle_policy_rollback(std::string_view request_json) {
+std::string UdsServer::handle_policy_rollback(const ControlRequest& request) {
     if (!version_store_ || !policy_engine_) {
         spdlog::warn("[uds_server] policy_rollback: version_store or policy_engine not configured");
         return make_not_implemented_response("policy_rollback");
@@ -1308,7 +1510,7 @@ std::string UdsServer::handle_policy_rollback(std::string_view request_json) {
     // ── payload 오브젝트 내 target_version 파싱 ──────────────────────────
     // 프로토콜: {"command":"policy_rollback","version":1,"payload":{"target_version":3}}
     // payload 최상위 키만 허용한다 (문자열 리터럴/중첩 오브젝트 내 패턴 무시).
-    const auto target_version_opt = parse_payload_uint64_field(request_json, "target_version");
+    const auto target_version_opt = request.payload.uint64_field("target_version");
     if (!target_version_opt) {
         spdlog::warn("[uds_server] policy_rollback: missing target_version in payload");
         return make_error_response("missing required field: target_version");
@@ -1367,7 +1569,7 @@ std::string UdsServer::handle_policy_rollback(std::string_view request_json) {
 //     (스냅샷 저장 실패가 정책 리로드를 막지 않도록 격리).
 //   - policy_engine_->reload 예외 시 ok:false 반환 (현재 정책 유지).
 // ---------------------------------------------------------------------------
-std::string UdsServer::handle_policy_reload(std::string_view /*request_json*/) {
+std::string UdsServer::handle_policy_reload(const ControlRequest& /*request*/) {
     if (!version_store_ || !policy_engine_) {
         spdlog::warn("[uds_server] policy_reload: version_store or policy_engine not configured");
         return make_not_implemented_response("policy_reload");
@@ -1378,8 +1580,9 @@ std::string UdsServer::handle_policy_reload(std::string_view /*request_json*/) {
         return make_error_response("policy config path not configured");
     }
 
-    // ── 정책 파일 로드 ────────────────────────────────────────────────────
-    auto load_result = PolicyLoader::load(policy_config_path_);
+    // ── 정책 파일 로드 (현재 정책 기준 증분 컴파일) ───────────────────────
+    const auto live = policy_engine_->current_config();
+    auto load_result = PolicyLoader::load(policy_config_path_, live.get());
     if (!load_result) {
         spdlog::warn("[uds_server] policy_reload: load failed (keeping current policy): {}",
                      load_result.error());
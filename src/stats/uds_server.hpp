@@ -9,6 +9,8 @@
 //   요청 프레임:
 //     [4byte LE 길이][JSON 본문]
 //     예: {"command": "stats", "version": 1}
+//   연결 하나로 요청을 여러 번 보낼 수 있다. 응답은 요청 순서대로 온다.
+//   유휴(요청 대기) 시간이 client_timeout_sec 를 넘거나 프레임 길이가 잘못되면 연결을 닫는다.
 //
 //   응답 프레임:
 //     [4byte LE 길이][JSON 본문]
@@ -21,16 +23,30 @@
 //   "policy_versions" — 저장된 정책 버전 목록 조회 (DON-50)
 //   "policy_rollback" — 특정 버전으로 정책 롤백 (DON-50)
 //   "policy_reload"   — 정책 파일 리로드 + 스냅샷 저장 (DON-50)
-//   "sessions"        — 활성 세션 목록 (Phase 3 확장)
+//   "policy_stats"    — 규칙별 적중 수 / 누적 평가 시간
+//   "sessions"        — 활성 세션 목록 (SessionRegistry 스냅샷)
+//   "user_stats"      — db_user 별 쿼리/차단/바이트/업스트림 시간 Top-N (UserAccounting)
+//   "top_queries"     — fingerprint 별 쿼리/차단/업스트림 지연 Top-N (QueryTopK)
+//   "drain"           — drain 시작 (accept 중단, Health Check draining, 세션 정상 종료)
+//   "listener_handoff"— 리스너 fd 를 SCM_RIGHTS 로 응답과 함께 넘기고 drain 시작
+//                       (새 dbgate 프로세스가 기동 중에 보낸다, proxy/listener_handoff.hpp)
+//   "subscribe"       — payload {"topic":"stats","interval_ms":N}. 이후 연결은 푸시 전용:
+//                       {"ok":true,"event":"stats","seq":N,"full":B,"interval_ms":I,"payload":{}}
+//                       seq 1 은 전체 스냅샷, 이후는 바뀐 최상위 필드만. 연결 종료 = 구독 해제
 //
 // [버전 관리]
-//   CommandRequest.version 필드로 프로토콜 버전 구분.
+//   ControlRequest.version 필드로 프로토콜 버전 구분.
 //   현재 버전: 1. 미지정 시 기본값 1 적용.
 //
 // [스레드/비동기 모델]
 //   Boost.Asio co_await 기반. io_context 는 외부에서 주입.
 //   run() 은 co_return 까지 accept 루프를 유지한다.
 //   stop() 은 acceptor 를 닫아 run() 을 종료시킨다.
+//   io_context 를 여러 스레드가 run() 하는 경우 run() 을 executor() (strand) 위에서
+//   co_spawn 해야 stop() 의 acceptor 정리와 accept 루프가 직렬화된다.
+//   조회 커맨드(policy_explain/sessions/user_stats/top_queries/policy_stats/policy_versions)는
+//   control_pool_ 워커에서 병렬로, 변경 커맨드(policy_reload/policy_rollback)는 control_strand_ 에서 직렬로
+//   실행한다. 데이터패스 io_context 는 프레임 I/O 와 stats 직렬화만 맡는다.
 //
 // [격리 원칙]
 //   UDS I/O 실패가 데이터패스 실패로 전파되지 않도록
@@ -45,19 +61,43 @@
 #include <boost/asio.hpp>
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/strand.hpp>
 #include <boost/asio/thread_pool.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "parser/sql_parser.hpp"
 #include "policy/policy_engine.hpp"
 #include "policy/policy_version_store.hpp"
+#include "stats/control_json.hpp"
+#include "stats/query_topk.hpp"
+#include "stats/session_registry.hpp"
+#include "stats/user_accounting.hpp"
 #include "stats_collector.hpp"
 
 namespace asio = boost::asio;
 
+// ---------------------------------------------------------------------------
+// DrainControl
+//   "drain" / "listener_handoff" 커맨드가 호출하는 ProxyServer 쪽 동작.
+//   listener_fds : 요청한 프로세스가 listen_port 로 기동할 때 넘길 fd 목록 (프록시 포트,
+//                  Health Check 포트 순). 비어 있으면 인계할 수 없다 (포트 불일치, 이미 drain
+//                  중, 아직 listen 전) — 이 경우 fd 를 보내지도 drain 하지도 않는다.
+//   begin_drain  : drain 시작 (중복 호출은 무시된다). handed_off = 리스너를 넘긴 뒤 호출
+// ---------------------------------------------------------------------------
+struct DrainControl {
+    std::function<std::vector<int>(std::uint16_t listen_port)> listener_fds{};
+    std::function<void(std::string_view reason, bool handed_off)> begin_drain{};
+};
+
 // ---------------------------------------------------------------------------
 // UdsServer
 //   StatsCollector 의 snapshot() 및 policy_explain 을 UDS 클라이언트에 노출.
@@ -112,31 +152,88 @@ public:
     //   io_context 스레드에서 안전하게 호출 가능.
     void stop();
 
+    // executor
+    //   acceptor 를 소유하는 strand. 멀티스레드 io_context 에서는 run() 을 이 위에서 spawn 한다.
+    [[nodiscard]] auto executor() const -> asio::any_io_executor { return strand_; }
+
+    // control_executor
+    //   정책 변경 경로(reload/rollback) strand. 파일 I/O·YAML 파싱·해시 계산을 데이터패스
+    //   io_context 밖에서 실행한다. ProxyServer 의 SIGHUP reload 도 여기서 실행하여
+    //   UDS policy_reload/policy_rollback 과 직렬화한다.
+    [[nodiscard]] auto control_executor() noexcept
+        -> asio::strand<asio::thread_pool::executor_type> {
+        return control_strand_;
+    }
+
+    // 제어 커맨드 워커 수 (조회 커맨드 병렬도)
+    static constexpr std::size_t kControlThreads = 2;
+
     // --- DON-53: UDS 보안 설정 setter ---
     void set_client_timeout(std::uint32_t timeout_sec);
     void set_max_connections(std::uint32_t max_conn);
     void set_allowed_uid(uid_t uid);
 
+    // 활성 세션 목록 소스 (미설정 시 "sessions" 는 not-implemented). run() 전에 호출한다.
+    void set_session_registry(std::shared_ptr<SessionRegistry> registry);
+
+    // "sessions" 응답에 담는 최대 세션 수 (초과분은 truncated:true 로 표시)
+    static constexpr std::size_t kMaxSessionsListed = 10000;
+
+    // 사용자별 집계 소스 (미설정 시 "user_stats" 는 not-implemented). run() 전에 호출한다.
+    void set_user_accounting(std::shared_ptr<UserAccounting> accounting);
+
+    // "user_stats" limit 기본값 / 상한
+    static constexpr std::size_t kDefaultUserStatsLimit = 20;
+    static constexpr std::size_t kMaxUserStatsLimit = 1000;
+
+    // fingerprint 별 Top-K 소스 (미설정 시 "top_queries" 는 not-implemented). run() 전에 호출한다.
+    void set_query_topk(std::shared_ptr<QueryTopK> topk);
+
+    // "top_queries" limit 기본값 / 상한
+    static constexpr std::size_t kDefaultTopQueriesLimit = 20;
+    static constexpr std::size_t kMaxTopQueriesLimit = 1000;
+
+    // drain / 리스너 인계 동작 (미설정 시 "drain" / "listener_handoff" 는 not-implemented).
+    // run() 전에 호출한다.
+    void set_drain_control(DrainControl control);
+
 private:
     // handle_client
-    //   단일 클라이언트 연결을 처리하는 코루틴.
-    //   요청 JSON 파싱 → 커맨드 디스패치 → 응답 직렬화 → 송신.
+    //   단일 클라이언트 연결을 처리하는 코루틴. EOF / 유휴 타임아웃까지 프레임마다
+    //   요청 JSON 파싱 → 커맨드 디스패치 → 응답 직렬화 → 송신을 반복한다.
     asio::awaitable<void> handle_client(asio::local::stream_protocol::socket socket);
 
+    // dispatch_command
+    //   요청 / 응답 한 번으로 끝나는 커맨드를 실행할 executor 로 옮겨 실행하고 응답 JSON 을
+    //   반환한다 (조회 → control_pool_, 변경 → control_strand_, stats / drain → io 스레드).
+    asio::awaitable<std::string> dispatch_command(const ControlRequest& request);
+
+    // stream_stats
+    //   "subscribe" 이후의 푸시 루프. interval 마다 StatsSnapshot 델타 프레임을 쓴다.
+    //   쓰기 실패 / 타임아웃 / stop() 까지 실행한다.
+    asio::awaitable<void> stream_stats(
+        std::shared_ptr<asio::local::stream_protocol::socket> socket_sp,
+        std::chrono::milliseconds interval);
+
     // handle_policy_explain
     //   "policy_explain" 커맨드 처리.
     //   payload에서 sql/user/source_ip 파싱 후 PolicyEngine::explain() 또는
     //   explain_error() 를 호출하고 JSON 응답 문자열을 반환한다.
     //   payload 필드 누락/파싱 실패 시 {"ok":false,"error":"..."} 반환 (fail-close).
     //   policy_engine_ 또는 sql_parser_ 가 nullptr 이면 not-implemented 응답 반환.
-    [[nodiscard]] std::string handle_policy_explain(std::string_view request_json);
+    [[nodiscard]] std::string handle_policy_explain(const ControlRequest& request);
 
     // handle_policy_versions (DON-50)
     //   "policy_versions" 커맨드 처리.
     //   version_store_->list_versions() 와 policy_engine_->current_version() 을
     //   결합하여 버전 목록 JSON 을 반환한다.
     //   version_store_ 가 nullptr 이면 not-implemented 응답 반환.
-    [[nodiscard]] std::string handle_policy_versions(std::string_view request_json);
+    [[nodiscard]] std::string handle_policy_versions(const ControlRequest& request);
+
+    // handle_policy_stats
+    //   "policy_stats" 커맨드 처리. PolicyEngine::rule_stats() 를 직렬화한다.
+    //   policy_engine_ 가 nullptr 이면 not-implemented 응답 반환.
+    [[nodiscard]] std::string handle_policy_stats(const ControlRequest& request);
 
     // handle_policy_rollback (DON-50)
     //   "policy_rollback" 커맨드 처리.
@@ -144,22 +241,57 @@ private:
     //   policy_engine_->reload() 를 호출한다.
     //   실패 시 현재 정책 유지 (fail-close). version_store_ 가 nullptr 이면
     //   not-implemented 응답 반환.
-    [[nodiscard]] std::string handle_policy_rollback(std::string_view request_json);
+    [[nodiscard]] std::string handle_policy_rollback(const ControlRequest& request);
 
     // handle_policy_reload (DON-50, 기존 501 placeholder 교체)
     //   "policy_reload" 커맨드 처리.
     //   PolicyLoader::load(policy_config_path_) → save_snapshot() → reload() 순서로 수행.
     //   실패 시 현재 정책 유지 (fail-close). version_store_ 가 nullptr 이면
     //   not-implemented 응답 반환.
-    [[nodiscard]] std::string handle_policy_reload(std::string_view request_json);
+    [[nodiscard]] std::string handle_policy_reload(const ControlRequest& request);
+
+    // handle_sessions
+    //   "sessions" 커맨드 처리. SessionRegistry::snapshot() 을 직렬화한다 (read-only).
+    //   session_registry_ 가 nullptr 이면 not-implemented 응답 반환.
+    [[nodiscard]] std::string handle_sessions(const ControlRequest& request);
+
+    // handle_user_stats
+    //   "user_stats" 커맨드 처리. payload 의 sort(기본 "queries") / limit(기본 20) 로
+    //   UserAccounting 의 마지막 게시 테이블에서 상위 사용자를 고른다 (read-only).
+    //   알 수 없는 sort 는 ok:false. user_accounting_ 가 nullptr 이면 not-implemented.
+    [[nodiscard]] std::string handle_user_stats(const ControlRequest& request);
+
+    // handle_top_queries
+    //   "top_queries" 커맨드 처리. payload 의 sort(기본 "count") / limit(기본 20) 로
+    //   QueryTopK::snapshot() 에서 상위 구문 형태를 고른다 (read-only).
+    //   알 수 없는 sort 는 ok:false. query_topk_ 가 nullptr 이면 not-implemented.
+    [[nodiscard]] std::string handle_top_queries(const ControlRequest& request);
+
+    // handle_listener_handoff
+    //   "listener_handoff" 커맨드 처리. payload.listen_port 가 이쪽 리스너 포트와 같을 때만
+    //   넘긴다 (설정이 다른 프로세스가 리스너를 가져가 기존 프로세스만 drain 되는 일 방지).
+    //   응답 프레임을 리스너 fd 와 함께 직접 써야 하므로
+    //   소켓을 받는다. 응답을 이미 썼으면(또는 쓰다 실패했으면) nullopt, 아니면 보낼 오류
+    //   응답을 반환한다. 인계에 성공했을 때만 drain 을 시작한다 (실패 시 계속 서비스).
+    //   동시에 두 요청이 와도 한 프로세스에만 넘긴다 (handoff_claimed_).
+    //   송신은 io 스레드를 막지 않는다: 소켓 버퍼가 차 있으면 쓰기 가능을 async_wait 로
+    //   기다린다 (handle_client 의 연결 deadline 이 만료되면 소켓이 닫혀 실패로 끝난다).
+    [[nodiscard]] asio::awaitable<std::optional<std::string>> handle_listener_handoff(
+        const ControlRequest& request, asio::local::stream_protocol::socket& socket);
 
     std::filesystem::path socket_path_;
     std::shared_ptr<StatsCollector> stats_;
     std::shared_ptr<PolicyEngine> policy_engine_;        // nullable
     std::shared_ptr<SqlParser> sql_parser_;              // nullable
     std::shared_ptr<PolicyVersionStore> version_store_;  // nullable (DON-50)
+    std::shared_ptr<SessionRegistry> session_registry_;  // nullable
+    std::shared_ptr<UserAccounting> user_accounting_;    // nullable
+    std::shared_ptr<QueryTopK> query_topk_;              // nullable
+    DrainControl drain_control_{};                       // 미설정 = drain 커맨드 비활성
+    std::atomic<bool> handoff_claimed_{false};
     std::filesystem::path policy_config_path_;           // reload 시 사용할 정책 파일 경로 (DON-50)
     asio::io_context& ioc_;
+    asio::strand<asio::io_context::executor_type> strand_;  // acceptor 직렬화용
     asio::local::stream_protocol::acceptor acceptor_;
     std::atomic<bool> stop_requested_{false};
 
@@ -174,7 +306,12 @@ private:
         std::make_shared<std::atomic<std::uint32_t>>(0)};
 
     // control_pool_:
-    //   policy_reload/policy_rollback 의 동기 파일 I/O를 io_context 이벤트 루프에서 분리한다.
-    //   단일 워커로 직렬 실행하여 관리 경로 경쟁을 최소화한다.
-    asio::thread_pool control_pool_{1};
+    //   제어 커맨드의 동기 작업(파일 I/O, SQL 파싱, 목록 직렬화)을 io_context 이벤트 루프에서
+    //   분리한다. 조회 커맨드는 워커들에서 병렬로 실행된다.
+    // control_strand_:
+    //   policy_reload/policy_rollback 과 SIGHUP reload 를 한 줄로 직렬화한다.
+    //   control_pool_ 뒤에 선언해야 한다 (초기화 순서).
+    asio::thread_pool control_pool_{kControlThreads};
+    asio::strand<asio::thread_pool::executor_type> control_strand_{
+        asio::make_strand(control_pool_)};
 };
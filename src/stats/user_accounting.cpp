@@ -0,0 +1,135 @@
+// ---------------------------------------------------------------------------
+// user_accounting.cpp
+// ---------------------------------------------------------------------------
+
+#include "stats/user_accounting.hpp"
+
+#include <algorithm>
+
+namespace {
+
+void accumulate(UserTotals& totals, const SessionStats& stats) noexcept {
+    totals.queries += stats.queries();
+    totals.blocked += stats.blocked();
+    totals.bytes_in += stats.bytes_in();
+    totals.bytes_out += stats.bytes_out();
+    totals.upstream_us += stats.upstream_us();
+}
+
+std::string user_of(const SessionStats& stats) {
+    const auto ctx = stats.context();
+    return ctx != nullptr ? ctx->db_user : std::string{};
+}
+
+std::uint64_t sort_value(const UserTotals& u, UserSortKey key) noexcept {
+    switch (key) {
+        case UserSortKey::kBlocked:
+            return u.blocked;
+        case UserSortKey::kBytesIn:
+            return u.bytes_in;
+        case UserSortKey::kBytesOut:
+            return u.bytes_out;
+        case UserSortKey::kUpstreamTime:
+            return u.upstream_us;
+        case UserSortKey::kSessions:
+            return u.sessions;
+        case UserSortKey::kQueries:
+            break;
+    }
+    return u.queries;
+}
+
+}  // namespace
+
+auto parse_user_sort_key(std::string_view name) noexcept -> std::optional<UserSortKey> {
+    if (name == "queries") {
+        return UserSortKey::kQueries;
+    }
+    if (name == "blocked") {
+        return UserSortKey::kBlocked;
+    }
+    if (name == "bytes_in") {
+        return UserSortKey::kBytesIn;
+    }
+    if (name == "bytes_out") {
+        return UserSortKey::kBytesOut;
+    }
+    if (name == "upstream_us") {
+        return UserSortKey::kUpstreamTime;
+    }
+    if (name == "sessions") {
+        return UserSortKey::kSessions;
+    }
+    return std::nullopt;
+}
+
+auto top_users(const std::vector<UserTotals>& users, UserSortKey key, std::size_t limit)
+    -> std::vector<UserTotals> {
+    std::vector<const UserTotals*> order;
+    order.reserve(users.size());
+    for (const auto& u : users) {
+        order.push_back(&u);
+    }
+    const std::size_t count = std::min(limit, order.size());
+    std::partial_sort(order.begin(),
+                      order.begin() + static_cast<std::ptrdiff_t>(count),
+                      order.end(),
+                      [key](const UserTotals* a, const UserTotals* b) {
+                          const auto va = sort_value(*a, key);
+                          const auto vb = sort_value(*b, key);
+                          return va != vb ? va > vb : a->db_user < b->db_user;
+                      });
+
+    std::vector<UserTotals> out;
+    out.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        out.push_back(*order[i]);
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// UserAccounting
+// ---------------------------------------------------------------------------
+void UserAccounting::retire(const SessionStats& stats) {
+    std::string user = user_of(stats);
+    const std::lock_guard lock{mu_};
+    auto& totals = retired_[user];
+    if (totals.db_user.empty()) {
+        totals.db_user = std::move(user);
+    }
+    ++totals.sessions;
+    accumulate(totals, stats);
+}
+
+void UserAccounting::refresh(const SessionRegistry& registry,
+                             std::chrono::system_clock::time_point now) {
+    auto next = std::make_shared<UserAccountingSnapshot>();
+    next->captured_at_ms = SessionStats::to_epoch_ms(now);
+    {
+        const std::lock_guard lock{mu_};
+        std::unordered_map<std::string, UserTotals> merged = retired_;
+        for (const auto& stats : registry.entries()) {
+            std::string user = user_of(*stats);
+            auto& totals = merged[user];
+            if (totals.db_user.empty()) {
+                totals.db_user = std::move(user);
+            }
+            ++totals.sessions;
+            ++totals.active_sessions;
+            accumulate(totals, *stats);
+        }
+        next->users.reserve(merged.size());
+        for (auto& [user, totals] : merged) {
+            next->users.push_back(std::move(totals));
+        }
+    }
+    std::sort(next->users.begin(), next->users.end(), [](const auto& a, const auto& b) {
+        return a.db_user < b.db_user;
+    });
+    published_.store(std::move(next), std::memory_order_release);
+}
+
+auto UserAccounting::snapshot() const noexcept -> std::shared_ptr<const UserAccountingSnapshot> {
+    return published_.load(std::memory_order_acquire);
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// user_accounting.hpp
+//
+// db_user 별 부하 집계 (UDS "user_stats" 명령 / 대시보드 사용자 Top-N).
+//
+// [설계 의도]
+// StatsCollector 는 전체 합계만 가지므로 어떤 애플리케이션 계정이 프록시 부하를 만드는지
+// 로그를 파싱하지 않고는 알 수 없다. 세션별 카운터는 이미 SessionStats 에 있으므로
+// 데이터패스에 새 갱신을 추가하지 않고, 주기적으로(통계 tick, 1초) 다음을 합산한다.
+//   - 종료된 세션: retire() 로 최종 값을 사용자별 누적에 더해 둔다 (세션 완료 콜백)
+//   - 활성 세션  : refresh() 가 SessionRegistry::entries() 의 현재 값을 더한다
+// refresh() 결과는 불변 테이블로 게시되어 조회 경로는 atomic load 1회로 읽는다.
+//
+// [이중 집계 방지]
+// retire() 와 refresh() 는 같은 mutex 를 잡고, refresh() 는 그 안에서 등록 목록을 복사한다.
+// 종료 세션은 SessionRegistry::remove() 후 retire() 되므로, 한 refresh 안에서 활성 목록과
+// 누적 양쪽에 동시에 들어갈 수 없다 (최대 한 주기 늦게 반영될 수는 있다).
+//
+// [범위]
+// 사용자 키는 핸드셰이크가 끝난 세션의 db_user 다. 인증 전에 끝난 세션은 빈 문자열
+// 키("")로 묶인다. 누적은 프로세스 수명 동안 유지된다 (재시작 시 초기화).
+// ---------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "stats/session_registry.hpp"
+
+// ---------------------------------------------------------------------------
+// UserTotals
+//   active_sessions : refresh 시점의 활성 세션 수
+//   sessions        : 프로세스 시작 이후 이 사용자로 연결된 세션 수 (활성 포함)
+//   나머지          : SessionStatsView 와 같은 의미의 합계
+// ---------------------------------------------------------------------------
+struct UserTotals {
+    std::string db_user{};
+    std::uint64_t active_sessions{0};
+    std::uint64_t sessions{0};
+    std::uint64_t queries{0};
+    std::uint64_t blocked{0};
+    std::uint64_t bytes_in{0};
+    std::uint64_t bytes_out{0};
+    std::uint64_t upstream_us{0};
+};
+
+struct UserAccountingSnapshot {
+    std::vector<UserTotals> users{};  // db_user 오름차순
+    std::int64_t captured_at_ms{0};
+};
+
+enum class UserSortKey : std::uint8_t {
+    kQueries = 0,
+    kBlocked = 1,
+    kBytesIn = 2,
+    kBytesOut = 3,
+    kUpstreamTime = 4,
+    kSessions = 5,
+};
+
+// "queries" / "blocked" / "bytes_in" / "bytes_out" / "upstream_us" / "sessions"
+[[nodiscard]] auto parse_user_sort_key(std::string_view name) noexcept
+    -> std::optional<UserSortKey>;
+
+// users 중 key 내림차순 상위 limit 개 (동률은 db_user 오름차순)
+[[nodiscard]] auto top_users(const std::vector<UserTotals>& users,
+                             UserSortKey key,
+                             std::size_t limit) -> std::vector<UserTotals>;
+
+class UserAccounting {
+public:
+    UserAccounting() = default;
+    ~UserAccounting() = default;
+
+    UserAccounting(const UserAccounting&) = delete;
+    UserAccounting& operator=(const UserAccounting&) = delete;
+    UserAccounting(UserAccounting&&) = delete;
+    UserAccounting& operator=(UserAccounting&&) = delete;
+
+    // 종료된 세션의 최종 값을 누적한다 (SessionRegistry::remove() 이후에 호출)
+    void retire(const SessionStats& stats);
+
+    // 누적 + 현재 활성 세션 값으로 테이블을 다시 만들어 게시한다 (통계 tick)
+    void refresh(const SessionRegistry& registry,
+                 std::chrono::system_clock::time_point now = std::chrono::system_clock::now());
+
+    // 마지막으로 게시된 테이블 (refresh 전이면 빈 테이블)
+    [[nodiscard]] auto snapshot() const noexcept -> std::shared_ptr<const UserAccountingSnapshot>;
+
+private:
+    mutable std::mutex mu_;
+    std::unordered_map<std::string, UserTotals> retired_{};
+    std::atomic<std::shared_ptr<const UserAccountingSnapshot>> published_{
+        std::make_shared<const UserAccountingSnapshot>()};
+};
@@ -1,14 +1,17 @@
 // fuzz_mysql_packet.cpp — libFuzzer target for MySQL packet parsing
 //
-// Targets: MysqlPacket::parse(), extract_command()
+// Targets: MysqlPacket::parse(), MysqlPacketView::parse(), PacketFrameBuffer,
+//          extract_command()
 // Dependencies: protocol/mysql_packet, protocol/command (no spdlog)
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <span>
 
 #include "protocol/command.hpp"
 #include "protocol/mysql_packet.hpp"
+#include "protocol/packet_frame_buffer.hpp"
 
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
     // Phase 1: Fuzz MysqlPacket::parse with raw bytes
@@ -28,5 +31,39 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
         [[maybe_unused]] auto pay = packet_result.value().payload();
     }
 
+    // Phase 5: Zero-copy view must agree with the owning parse
+    auto view_result = MysqlPacketView::parse(std::span<const uint8_t>{data, size});
+    if (view_result.has_value() != packet_result.has_value()) {
+        __builtin_trap();
+    }
+    if (view_result.has_value()) {
+        [[maybe_unused]] auto view_cmd = extract_command(view_result.value());
+        if (view_result->raw().size() != packet_result->serialize().size()) {
+            __builtin_trap();
+        }
+    }
+
+    // Phase 6: Stream framing — feed in small chunks, walked packets must tile the input
+    PacketFrameBuffer rx;
+    std::size_t fed = 0;
+    std::size_t walked = 0;
+    while (fed < size) {
+        const std::size_t chunk = std::min<std::size_t>(7, size - fed);
+        auto space = rx.prepare(chunk);
+        std::copy_n(data + fed, chunk, space.begin());
+        rx.commit(chunk);
+        fed += chunk;
+
+        std::size_t offset = 0;
+        while (const auto view = rx.peek(offset)) {
+            offset += view->raw().size();
+        }
+        rx.consume(offset);
+        walked += offset;
+    }
+    if (walked + rx.readable().size() != size) {
+        __builtin_trap();
+    }
+
     return 0;  // Non-zero return values are reserved for future use
 }
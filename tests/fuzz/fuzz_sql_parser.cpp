@@ -1,14 +1,16 @@
 // fuzz_sql_parser.cpp — libFuzzer target for SQL parser
 //
-// Targets: SqlParser::parse()
-// Dependencies: parser/sql_parser, parser/injection_detector,
+// Targets: SqlParser::parse(), fingerprint_query(), sql_scan::find_first_of2()
+// Dependencies: parser/sql_parser, parser/query_fingerprint, parser/injection_detector,
 //               parser/procedure_detector, spdlog (LEVEL_OFF)
 
 #include <cstddef>
 #include <cstdint>
 #include <string_view>
 
+#include "parser/query_fingerprint.hpp"
 #include "parser/sql_parser.hpp"
+#include "parser/sql_scan.hpp"
 
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
     // Interpret raw bytes as a SQL string
@@ -26,5 +28,20 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
         [[maybe_unused]] auto multi = result.value().has_multi_statement;
     }
 
+    // fingerprint 정규화는 파서와 같은 렉서를 쓰므로 같은 입력 공간에서 함께 검증한다
+    [[maybe_unused]] auto fingerprint = fingerprint_query(sql);
+
+    // 벡터 커널은 렉서가 쓰는 구분 문자 조합에서 스칼라 기준 구현과 같아야 한다
+    static constexpr char kPairs[][2] = {{'\'', '\\'}, {'"', '\\'}, {'`', '`'}, {'*', '*'},
+                                         {'\n', '\n'}};
+    for (const auto& pair : kPairs) {
+        for (std::size_t pos = 0; pos <= sql.size(); pos += 7) {
+            if (sql_scan::find_first_of2(sql, pos, pair[0], pair[1]) !=
+                sql_scan::find_first_of2_scalar(sql, pos, pair[0], pair[1])) {
+                __builtin_trap();
+            }
+        }
+    }
+
     return 0;
 }
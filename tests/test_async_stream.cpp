@@ -13,8 +13,10 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/context.hpp>
 #include <boost/asio/ssl/stream.hpp>
+#include <type_traits>
 
 #include "common/async_stream.hpp"
+#include "common/io_backend.hpp"
 
 // ---------------------------------------------------------------------------
 // 헬퍼
@@ -245,3 +247,53 @@ TEST(AsyncStreamTest, AsyncShutdownNoOpForTcp) {
     EXPECT_TRUE(called);
     EXPECT_FALSE(result_ec);
 }
+
+// ---------------------------------------------------------------------------
+// visit 테스트
+//   실제 스트림 타입으로 호출되고, 같은 객체(lowest_layer 와 같은 소켓)를 참조해야 한다.
+// ---------------------------------------------------------------------------
+
+TEST(AsyncStreamTest, VisitPassesConcreteStream) {
+    boost::asio::io_context ioc;
+    boost::asio::ssl::context ssl_ctx{boost::asio::ssl::context::tls_client};
+    AsyncStream plain{make_tcp_socket(ioc)};
+    AsyncStream tls{AsyncStream::ssl_socket{make_tcp_socket(ioc), ssl_ctx}};
+
+    auto* const plain_socket = &plain.lowest_layer();
+    const bool plain_is_tcp = plain.visit([&](auto& s) {
+        using S = std::decay_t<decltype(s)>;
+        if constexpr (std::is_same_v<S, AsyncStream::tcp_socket>) {
+            return &s == plain_socket;
+        } else {
+            return false;
+        }
+    });
+    EXPECT_TRUE(plain_is_tcp);
+
+    auto* const tls_socket = &tls.lowest_layer();
+    const bool tls_is_ssl = tls.visit([&](auto& s) {
+        using S = std::decay_t<decltype(s)>;
+        if constexpr (std::is_same_v<S, AsyncStream::ssl_socket>) {
+            return &s.next_layer() == tls_socket;
+        } else {
+            return false;
+        }
+    });
+    EXPECT_TRUE(tls_is_ssl);
+}
+
+// ---------------------------------------------------------------------------
+// I/O 백엔드 (DBGATE_ENABLE_IO_URING 빌드는 위 소켓 테스트 전체가 io_uring 으로 실행된다)
+// ---------------------------------------------------------------------------
+
+TEST(IoBackendTest, ReportsCompiledBackend) {
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    EXPECT_EQ(io_backend_name(), "io_uring");
+#elif defined(__linux__)
+    EXPECT_EQ(io_backend_name(), "epoll");
+#else
+    EXPECT_FALSE(io_backend_name().empty());
+#endif
+    const auto probe = probe_io_backend();
+    EXPECT_TRUE(probe.has_value()) << (probe ? std::string{} : probe.error());
+}
@@ -1163,3 +1163,193 @@ TEST(ExtractHandshakeResponseFields, LegacyAuthResponseNoNullTerminator_IsError)
     EXPECT_NE(result.error().message.find("auth_response missing null terminator"),
               std::string::npos);
 }
+
+// ===========================================================================
+// 연결 풀 경로 — greeting 원형 / 재인증 패킷 빌더
+// ===========================================================================
+
+namespace {
+
+// HandshakeV10 패킷 (헤더 포함). capability = cap_low | cap_high << 16
+std::vector<std::uint8_t> build_server_greeting(std::uint16_t cap_low,
+                                                std::uint16_t cap_high,
+                                                std::uint8_t auth_data_len = 21) {
+    std::vector<std::uint8_t> out(4, 0x00);
+    out.push_back(0x0A);
+    for (char c : std::string{"8.0.36"}) {
+        out.push_back(static_cast<std::uint8_t>(c));
+    }
+    out.push_back(0x00);
+    out.insert(out.end(), {0x2A, 0x00, 0x00, 0x00});  // connection_id
+    out.insert(out.end(), 8, 'a');                    // auth_plugin_data_part_1
+    out.push_back(0x00);                              // filler
+    out.push_back(static_cast<std::uint8_t>(cap_low & 0xFFU));
+    out.push_back(static_cast<std::uint8_t>(cap_low >> 8U));
+    out.push_back(0x21);  // charset
+    out.insert(out.end(), {0x02, 0x00});  // status
+    out.push_back(static_cast<std::uint8_t>(cap_high & 0xFFU));
+    out.push_back(static_cast<std::uint8_t>(cap_high >> 8U));
+    out.push_back(auth_data_len);
+    out.insert(out.end(), 10, 0x00);  // reserved
+    out.insert(out.end(), 12, 'b');   // auth_plugin_data_part_2
+    out.push_back(0x00);
+    for (char c : std::string{"caching_sha2_password"}) {
+        out.push_back(static_cast<std::uint8_t>(c));
+    }
+    out.push_back(0x00);
+
+    const auto len = static_cast<std::uint32_t>(out.size() - 4);
+    out[0] = static_cast<std::uint8_t>(len & 0xFFU);
+    out[1] = static_cast<std::uint8_t>((len >> 8U) & 0xFFU);
+    out[2] = static_cast<std::uint8_t>((len >> 16U) & 0xFFU);
+    return out;
+}
+
+// CLIENT_PLUGIN_AUTH(0x00080000) 를 켠 HandshakeResponse41 payload
+std::vector<std::uint8_t> build_plugin_auth_response(std::uint8_t extra_flags_byte3 = 0x00) {
+    auto payload = build_handshake_response("app", "appdb", true);
+    payload[2] |= 0x08U;
+    payload[3] |= extra_flags_byte3;
+    return payload;
+}
+
+std::uint32_t read_flags(std::span<const std::uint8_t> payload) {
+    return static_cast<std::uint32_t>(payload[0]) | (static_cast<std::uint32_t>(payload[1]) << 8U) |
+           (static_cast<std::uint32_t>(payload[2]) << 16U) |
+           (static_cast<std::uint32_t>(payload[3]) << 24U);
+}
+
+}  // namespace
+
+TEST(MakePooledGreeting, ReplacesScrambleOnly) {
+    const auto greeting = build_server_greeting(0xFFFFU, 0x000FU);
+    std::vector<std::uint8_t> scramble(20);
+    for (std::size_t i = 0; i < scramble.size(); ++i) {
+        scramble[i] = static_cast<std::uint8_t>('A' + i);
+    }
+
+    const auto result = detail::make_pooled_greeting(greeting, scramble);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), greeting.size());
+
+    // header(4) + proto(1) + "8.0.36\0"(7) + connection_id(4) = 16
+    constexpr std::size_t part1 = 16;
+    constexpr std::size_t part2 = part1 + 8 + 1 + 2 + 1 + 2 + 2 + 1 + 10;
+    for (std::size_t i = 0; i < result->size(); ++i) {
+        if (i >= part1 && i < part1 + 8) {
+            EXPECT_EQ((*result)[i], scramble[i - part1]);
+        } else if (i >= part2 && i < part2 + 12) {
+            EXPECT_EQ((*result)[i], scramble[8 + i - part2]);
+        } else {
+            EXPECT_EQ((*result)[i], greeting[i]) << "offset " << i;
+        }
+    }
+}
+
+TEST(MakePooledGreeting, WithoutPluginAuth_IsError) {
+    // capability_flags_2 에 CLIENT_PLUGIN_AUTH(0x0008) 없음
+    const auto greeting = build_server_greeting(0xFFFFU, 0x0007U);
+    const std::vector<std::uint8_t> scramble(20, 'x');
+    EXPECT_FALSE(detail::make_pooled_greeting(greeting, scramble).has_value());
+}
+
+TEST(MakePooledGreeting, UnexpectedAuthDataLength_IsError) {
+    const auto greeting = build_server_greeting(0xFFFFU, 0x000FU, 0);
+    const std::vector<std::uint8_t> scramble(20, 'x');
+    EXPECT_FALSE(detail::make_pooled_greeting(greeting, scramble).has_value());
+}
+
+TEST(MakePooledGreeting, WrongScrambleSize_IsError) {
+    const auto greeting = build_server_greeting(0xFFFFU, 0x000FU);
+    const std::vector<std::uint8_t> scramble(8, 'x');
+    EXPECT_FALSE(detail::make_pooled_greeting(greeting, scramble).has_value());
+}
+
+TEST(ParseClientHandshake, Normal_StripsUnsupportedCapabilities) {
+    // CLIENT_DEPRECATE_EOF(0x01000000) 를 요청한 클라이언트
+    const auto payload = build_plugin_auth_response(0x01);
+
+    const auto result = detail::parse_client_handshake(payload);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->user, "app");
+    EXPECT_EQ(result->db, "appdb");
+    EXPECT_EQ(result->charset, 0x21);
+    EXPECT_EQ(result->max_packet_size, 0x01000000U);
+    EXPECT_NE(result->capability_flags & 0x00080000U, 0U);
+    EXPECT_EQ(result->capability_flags & detail::kUnsupportedCapabilities, 0U);
+}
+
+TEST(ParseClientHandshake, WithoutPluginAuth_IsError) {
+    const auto payload = build_handshake_response("app", "appdb", true);
+    EXPECT_FALSE(detail::parse_client_handshake(payload).has_value());
+}
+
+TEST(ParseClientHandshake, CompressedProtocol_IsError) {
+    auto payload = build_plugin_auth_response();
+    payload[0] |= 0x20U;  // CLIENT_COMPRESS
+    EXPECT_FALSE(detail::parse_client_handshake(payload).has_value());
+}
+
+TEST(BuildReauthResponse, EmptyAuthWithReauthPlugin) {
+    const auto client = detail::parse_client_handshake(build_plugin_auth_response());
+    ASSERT_TRUE(client.has_value());
+
+    const auto packet = detail::build_reauth_response(*client);
+    auto parsed = MysqlPacket::parse(packet);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->sequence_id(), 1);
+
+    const auto payload = parsed->payload();
+    EXPECT_EQ(read_flags(payload), client->capability_flags);
+
+    // 서버와 같은 파서로 user/db 가 읽혀야 한다
+    std::string user;
+    std::string db;
+    ASSERT_TRUE(detail::extract_handshake_response_fields(payload, user, db).has_value());
+    EXPECT_EQ(user, "app");
+    EXPECT_EQ(db, "appdb");
+
+    // auth_response 는 비어 있고 payload 는 plugin 이름으로 끝난다
+    const std::size_t auth_pos = 32 + user.size() + 1;
+    EXPECT_EQ(payload[auth_pos], 0x00);
+    const std::string tail(payload.end() - static_cast<std::ptrdiff_t>(
+                                               detail::kPoolReauthPlugin.size() + 1),
+                           payload.end() - 1);
+    EXPECT_EQ(tail, detail::kPoolReauthPlugin);
+    EXPECT_EQ(payload.back(), 0x00);
+}
+
+TEST(BuildReauthResponse, ConnectAttrsAppendsEmptyBlock) {
+    auto client = detail::parse_client_handshake(build_plugin_auth_response());
+    ASSERT_TRUE(client.has_value());
+    const auto without = detail::build_reauth_response(*client);
+
+    client->capability_flags |= 0x00100000U;  // CLIENT_CONNECT_ATTRS
+    const auto with = detail::build_reauth_response(*client);
+    ASSERT_EQ(with.size(), without.size() + 1);
+    EXPECT_EQ(with.back(), 0x00);
+}
+
+TEST(BuildChangeUser, Layout) {
+    const auto client = detail::parse_client_handshake(build_plugin_auth_response());
+    ASSERT_TRUE(client.has_value());
+
+    const auto packet = detail::build_change_user(*client, client->capability_flags);
+    auto parsed = MysqlPacket::parse(packet);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->sequence_id(), 0);
+
+    // 0x11 | "app\0" | auth_len 0 | "appdb\0" | charset(2) | plugin\0
+    std::vector<std::uint8_t> expected{0x11, 'a', 'p', 'p', 0x00, 0x00};
+    for (char c : std::string{"appdb"}) {
+        expected.push_back(static_cast<std::uint8_t>(c));
+    }
+    expected.insert(expected.end(), {0x00, 0x21, 0x00});
+    for (char c : detail::kPoolReauthPlugin) {
+        expected.push_back(static_cast<std::uint8_t>(c));
+    }
+    expected.push_back(0x00);
+
+    const auto payload = parsed->payload();
+    EXPECT_EQ(std::vector<std::uint8_t>(payload.begin(), payload.end()), expected);
+}
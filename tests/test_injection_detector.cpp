@@ -19,10 +19,12 @@
 
 #include <gtest/gtest.h>
 
+#include <regex>
 #include <string>
 #include <vector>
 
 #include "parser/injection_detector.hpp"
+#include "parser/literal_prefilter.hpp"
 
 // ---------------------------------------------------------------------------
 // 기본 탐지 패턴 (config에서 로드될 기본 패턴)
@@ -359,4 +361,82 @@ TEST(InjectionDetector, EncodingBypass_KnownFalseNegative) {
                  "String literal evaluation is not in scope.";
 }
 
+// ---------------------------------------------------------------------------
+// 다중 패턴 사전 필터 (LiteralPrefilter) 테스트
+//
+// 사전 필터는 비용만 줄이고 탐지 결과를 바꾸면 안 된다 (미탐 금지).
+// 추출된 필수 리터럴은 실제 매칭에 반드시 포함되는 부분이어야 한다.
+// ---------------------------------------------------------------------------
+
+TEST(LiteralPrefilter, ExtractRequiredLiterals) {
+    using Literals = std::vector<std::string>;
+    EXPECT_EQ(extract_required_literals(R"(UNION\s+SELECT)"), (Literals{"SELECT", "UNION"}));
+    EXPECT_EQ(extract_required_literals(R"(SLEEP\s*\()"), (Literals{"(", "SLEEP"}));
+    EXPECT_EQ(extract_required_literals(R"(('\s*OR\s+['"\d]))"), (Literals{"'", "OR"}));
+    // 선택적 문자(* ?)는 제외, + 는 유지
+    EXPECT_EQ(extract_required_literals("ab*c"), (Literals{"A", "C"}));
+    EXPECT_EQ(extract_required_literals("ab+c"), (Literals{"AB", "C"}));
+    // 그룹 내부 교대는 건너뛰고 바깥 리터럴만 사용
+    EXPECT_EQ(extract_required_literals(R"(;\s*(DROP|DELETE))"), (Literals{";"}));
+    // \xHH 이스케이프의 16진수는 리터럴이 아님
+    EXPECT_EQ(extract_required_literals(R"(\x41BC)"), (Literals{"BC"}));
+    // 최상위 교대 / 선택적 그룹 → 필수 리터럴 없음
+    EXPECT_TRUE(extract_required_literals("SLEEP|BENCHMARK").empty());
+    EXPECT_TRUE(extract_required_literals("(UNION)?").empty());
+}
+
+TEST(LiteralPrefilter, ScanFindsOverlappingLiteralsCaseInsensitive) {
+    LiteralPrefilter prefilter;
+    const auto he = prefilter.add("he");
+    const auto she = prefilter.add("SHE");
+    const auto his = prefilter.add("his");
+    const auto hers = prefilter.add("hers");
+    EXPECT_EQ(prefilter.add("HE"), he) << "case-only duplicates share an id";
+    prefilter.build();
+
+    std::vector<bool> found;
+    prefilter.scan("uShErS", found);
+    ASSERT_EQ(found.size(), 4U);
+    EXPECT_TRUE(found[he]);
+    EXPECT_TRUE(found[she]);
+    EXPECT_TRUE(found[hers]);
+    EXPECT_FALSE(found[his]);
+}
+
+TEST(InjectionDetector, PrefilterMatchesNaiveRegexScan) {
+    // 사전 필터 적용 결과가 "모든 패턴 정규식 순차 실행" 과 동일해야 한다.
+    auto patterns = default_patterns();
+    patterns.emplace_back(R"((OR|AND)\s+\d+\s*=\s*\d+)");  // 필수 리터럴 없음 → 항상 실행
+    const InjectionDetector detector(patterns);
+
+    const std::vector<std::string> queries = {
+        "SELECT id FROM users WHERE id = 1",
+        "select * from t union   select 1",
+        "SELECT name FROM t WHERE a = '' or '1'='1'",
+        "SELECT sleep (3)",
+        "SELECT SLEEP",
+        "SELECT * INTO   OUTFILE '/tmp/x'",
+        "SELECT 1; drop table t",
+        "SELECT 1 -- ",
+        "SELECT /* hint */ 1",
+        "SELECT /*/ 1",
+        "SELECT * FROM orders WHERE x = 1 AND 2=2",
+        "UPDATE t SET a = 'O''Reilly' WHERE id = 7",
+    };
+
+    for (const auto& sql : queries) {
+        std::string expected_pattern;
+        for (const auto& p : patterns) {
+            const std::regex re(p, std::regex_constants::icase | std::regex_constants::ECMAScript);
+            if (std::regex_search(sql, re)) {
+                expected_pattern = p;
+                break;
+            }
+        }
+        const auto result = detector.check(sql);
+        EXPECT_EQ(result.detected, !expected_pattern.empty()) << sql;
+        EXPECT_EQ(result.matched_pattern, expected_pattern) << sql;
+    }
+}
+
 // main 함수는 test_logger.cpp 에서 제공됨 (단일 dbgate_tests 실행 파일)
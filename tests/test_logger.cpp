@@ -5,16 +5,29 @@
 // ---------------------------------------------------------------------------
 
 #include <gtest/gtest.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/logger.h>
+#include <spdlog/sinks/base_sink.h>
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <iterator>
+#include <mutex>
+#include <span>
 #include <sstream>
 #include <thread>
 #include <vector>
 
+#include "logger/async_log_writer.hpp"
+#include "logger/binary_audit_sink.hpp"
 #include "logger/log_types.hpp"
 #include "logger/structured_logger.hpp"
+#include "stats/stats_collector.hpp"
 
 namespace fs = std::filesystem;
 
@@ -203,7 +216,8 @@ TEST_F(StructuredLoggerTest, QueryLogJsonFields) {
     entry.action_raw = 1;   // ALLOW
     entry.timestamp = now;
     entry.duration = std::chrono::microseconds(1500);
-    entry.tables.emplace_back("users");
+    const std::vector<std::string_view> tables{"users"};
+    entry.tables = tables;
 
     logger.log_query(entry);
 
@@ -300,12 +314,16 @@ TEST_F(StructuredLoggerTest, MultithreadedLoggingNoCrash) {
         threads.emplace_back([&logger, t]() {
             const auto now = std::chrono::system_clock::now();
             for (int i = 0; i < logs_per_thread; ++i) {
+                // 로그 구조체는 비소유 view 이므로 원본 문자열을 호출 동안 유지한다
+                const std::string db_user = "user_" + std::to_string(t);
+                const std::string client_ip = "192.168.1." + std::to_string(i);
+                const std::string raw_sql = "SELECT * FROM table_" + std::to_string(i);
                 QueryLog entry;
                 entry.session_id =
                     static_cast<std::uint64_t>(t) * 1000U + static_cast<std::uint64_t>(i);
-                entry.db_user = "user_" + std::to_string(t);
-                entry.client_ip = "192.168.1." + std::to_string(i);
-                entry.raw_sql = "SELECT * FROM table_" + std::to_string(i);
+                entry.db_user = db_user;
+                entry.client_ip = client_ip;
+                entry.raw_sql = raw_sql;
                 entry.timestamp = now;
                 logger.log_query(entry);
             }
@@ -371,6 +389,451 @@ TEST_F(StructuredLoggerTest, DiagnosticLogging) {
     EXPECT_GT(file_size, 0) << "Log file is empty";
 }
 
+// ---------------------------------------------------------------------------
+// Test: 제어 문자 / UTF-8 / 8바이트 경계 이스케이프
+// ---------------------------------------------------------------------------
+TEST_F(StructuredLoggerTest, JsonEscapingControlAndUtf8Bytes) {
+    StructuredLogger logger(LogLevel::kInfo, log_file_);
+
+    // 8바이트 단위 스캔 경계 앞뒤에 특수 문자를 배치한다 ('"' @7, '\\' @8, 0x01 @16)
+    const std::string raw_sql = std::string("SELECT \"\\ FROM t") + '\x01' + " WHERE n='한글'";
+    QueryLog entry;
+    entry.session_id = 55555;
+    entry.raw_sql = raw_sql;
+    entry.timestamp = std::chrono::system_clock::now();
+    logger.log_query(entry);
+    logger.flush();
+
+    const auto lines = read_log_lines();
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_NE(lines[0].find(R"("raw_sql":"SELECT \"\\ FROM t\u0001 WHERE n='한글'")"),
+              std::string::npos)
+        << lines[0];
+}
+
+// ---------------------------------------------------------------------------
+// Test: 긴 SQL 과 여러 테이블 (버퍼 재사용 후에도 이전 레코드가 섞이지 않음)
+// ---------------------------------------------------------------------------
+TEST_F(StructuredLoggerTest, LongRecordThenShortRecordDoesNotLeak) {
+    StructuredLogger logger(LogLevel::kInfo, log_file_);
+
+    const std::string long_sql = "SELECT " + std::string(4096, 'x');
+    const std::vector<std::string_view> tables{"a", "b\"c"};
+    QueryLog first;
+    first.session_id = 1;
+    first.raw_sql = long_sql;
+    first.tables = tables;
+    first.timestamp = std::chrono::system_clock::now();
+    logger.log_query(first);
+
+    QueryLog second;
+    second.session_id = 2;
+    second.raw_sql = "SELECT 1";
+    second.timestamp = first.timestamp;
+    logger.log_query(second);
+    logger.flush();
+
+    const auto lines = read_log_lines();
+    ASSERT_EQ(lines.size(), 2U);
+    EXPECT_NE(lines[0].find(R"("tables":["a","b\"c"])"), std::string::npos) << lines[0];
+    EXPECT_EQ(JsonLineParser(lines[1]).get_field("raw_sql"), "SELECT 1");
+    EXPECT_NE(lines[1].find(R"("tables":[])"), std::string::npos);
+    EXPECT_LT(lines[1].size(), 300U);
+}
+
+// ---------------------------------------------------------------------------
+// Test: 비동기 모드 — flush() 후 제출한 모든 엔트리가 파일에 기록됨
+// ---------------------------------------------------------------------------
+TEST_F(StructuredLoggerTest, AsyncModeWritesAllEntriesAfterFlush) {
+    auto stats = std::make_shared<StatsCollector>();
+    AsyncLogOptions async{.enabled = true,
+                          .queue_capacity = 1024,
+                          .flush_batch = 16,
+                          .flush_interval = std::chrono::milliseconds{50},
+                          .overflow_policy = LogOverflowPolicy::kBlock,
+                          .stats = stats};
+    StructuredLogger logger(LogLevel::kInfo, log_file_, std::move(async));
+
+    constexpr int kEntries = 100;
+    const auto now = std::chrono::system_clock::now();
+    for (int i = 0; i < kEntries; ++i) {
+        const std::string raw_sql = "SELECT " + std::to_string(i);
+        QueryLog entry;
+        entry.session_id = static_cast<std::uint64_t>(i);
+        entry.raw_sql = raw_sql;
+        entry.timestamp = now;
+        logger.log_query(entry);
+    }
+    logger.flush();
+
+    const auto lines = read_log_lines();
+    ASSERT_EQ(lines.size(), static_cast<std::size_t>(kEntries));
+    // writer 는 단일 스레드이므로 단일 생산자의 제출 순서가 유지된다
+    EXPECT_EQ(JsonLineParser(lines.front()).get_field("session_id"), "0");
+    EXPECT_EQ(JsonLineParser(lines.back()).get_field("session_id"), "99");
+    EXPECT_EQ(logger.dropped_count(), 0U);
+    EXPECT_EQ(stats->snapshot().log_dropped, 0U);
+}
+
+// ---------------------------------------------------------------------------
+// AsyncLogWriter 테스트용 싱크: open() 전까지 첫 기록에서 writer 스레드를 붙잡는다
+// ---------------------------------------------------------------------------
+class GatedSink : public spdlog::sinks::base_sink<std::mutex> {
+public:
+    void open() {
+        {
+            const std::lock_guard<std::mutex> lock{gate_mutex_};
+            open_ = true;
+        }
+        gate_cv_.notify_all();
+    }
+
+    void wait_until_entered() {
+        while (!entered_.load()) {
+            std::this_thread::yield();
+        }
+    }
+
+    [[nodiscard]] std::size_t written() const { return written_.load(); }
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& /*msg*/) override {
+        entered_.store(true);
+        std::unique_lock<std::mutex> lock{gate_mutex_};
+        gate_cv_.wait(lock, [this] { return open_; });
+        written_.fetch_add(1);
+    }
+    void flush_() override {}
+
+private:
+    std::mutex gate_mutex_;
+    std::condition_variable gate_cv_;
+    bool open_{false};
+    std::atomic<bool> entered_{false};
+    std::atomic<std::size_t> written_{0};
+};
+
+class AsyncLogWriterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        sink_ = std::make_shared<GatedSink>();
+        sink_logger_ = std::make_shared<spdlog::logger>("async_writer_test", sink_);
+        stats_ = std::make_shared<StatsCollector>();
+    }
+
+    // 첫 엔트리로 writer 스레드를 싱크 안에 붙잡아 큐를 소비하지 못하게 한다
+    static void stall_writer(AsyncLogWriter& writer, GatedSink& sink) {
+        ASSERT_TRUE(writer.submit(static_cast<int>(spdlog::level::info), "stall"));
+        sink.wait_until_entered();
+    }
+
+    std::shared_ptr<GatedSink>
+        sink_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes,readability-identifier-naming)
+    std::shared_ptr<spdlog::logger>
+        sink_logger_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes,readability-identifier-naming)
+    std::shared_ptr<StatsCollector>
+        stats_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes,readability-identifier-naming)
+};
+
+// ---------------------------------------------------------------------------
+// Test: kDrop — 큐가 가득 차면 버리고 log_dropped 를 증가시킨다
+// ---------------------------------------------------------------------------
+TEST_F(AsyncLogWriterTest, DropPolicyCountsOverflow) {
+    AsyncLogWriter writer(sink_logger_,
+                          AsyncLogOptions{.enabled = true,
+                                          .queue_capacity = 4,
+                                          .overflow_policy = LogOverflowPolicy::kDrop,
+                                          .stats = stats_});
+    stall_writer(writer, *sink_);
+
+    int accepted = 0;
+    for (int i = 0; i < 7; ++i) {
+        accepted += writer.submit(static_cast<int>(spdlog::level::info), "entry") ? 1 : 0;
+    }
+    EXPECT_EQ(accepted, 4);
+    EXPECT_EQ(writer.dropped(), 3U);
+    EXPECT_EQ(stats_->snapshot().log_dropped, 3U);
+
+    sink_->open();
+    writer.flush();
+    EXPECT_EQ(sink_->written(), 5U);  // stall 1 + 적재 4
+    EXPECT_EQ(writer.queued(), 0U);
+}
+
+// ---------------------------------------------------------------------------
+// Test: kSample — 3/4 이상 차면 N 개 중 1 개만 받는다
+// ---------------------------------------------------------------------------
+TEST_F(AsyncLogWriterTest, SamplePolicyThinsUnderPressure) {
+    AsyncLogWriter writer(sink_logger_,
+                          AsyncLogOptions{.enabled = true,
+                                          .queue_capacity = 8,
+                                          .overflow_policy = LogOverflowPolicy::kSample,
+                                          .sample_keep_every = 2,
+                                          .stats = stats_});
+    stall_writer(writer, *sink_);
+
+    // 6 개(3/4) 까지는 모두 적재
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_TRUE(writer.submit(static_cast<int>(spdlog::level::info), "entry"));
+    }
+    // 이후에는 2 개 중 1 개만 적재
+    int accepted = 0;
+    for (int i = 0; i < 4; ++i) {
+        accepted += writer.submit(static_cast<int>(spdlog::level::info), "entry") ? 1 : 0;
+    }
+    EXPECT_EQ(accepted, 2);
+    EXPECT_EQ(writer.dropped(), 2U);
+
+    sink_->open();
+    writer.flush();
+    EXPECT_EQ(sink_->written(), 9U);  // stall 1 + 적재 8
+}
+
+// ---------------------------------------------------------------------------
+// Test: preserve — 오버플로 정책이 drop 이어도 자리가 날 때까지 대기 후 적재
+// ---------------------------------------------------------------------------
+TEST_F(AsyncLogWriterTest, PreservedEntryWaitsInsteadOfDropping) {
+    AsyncLogWriter writer(sink_logger_,
+                          AsyncLogOptions{.enabled = true,
+                                          .queue_capacity = 2,
+                                          .overflow_policy = LogOverflowPolicy::kDrop,
+                                          .stats = stats_});
+    stall_writer(writer, *sink_);
+    ASSERT_TRUE(writer.submit(static_cast<int>(spdlog::level::info), "a"));
+    ASSERT_TRUE(writer.submit(static_cast<int>(spdlog::level::info), "b"));
+
+    std::atomic<bool> preserved{false};
+    std::thread producer([&] {
+        preserved.store(
+            writer.submit(static_cast<int>(spdlog::level::warn), "block-event", true));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(preserved.load());  // 큐가 가득 차 대기 중
+
+    sink_->open();
+    producer.join();
+    EXPECT_TRUE(preserved.load());
+    writer.flush();
+    EXPECT_EQ(sink_->written(), 4U);
+    EXPECT_EQ(writer.dropped(), 0U);
+}
+
+// ---------------------------------------------------------------------------
+// 바이너리 감사 로그 테스트
+// ---------------------------------------------------------------------------
+namespace {
+
+struct AuditRecord {
+    std::uint8_t type{0};
+    std::vector<std::uint8_t> body{};  // 타입 바이트 이후
+};
+
+// 길이 접두 레코드 열을 분해한다 (손상 시 빈 결과)
+std::vector<AuditRecord> split_audit_records(std::span<const std::uint8_t> in) {
+    std::vector<AuditRecord> records;
+    while (!in.empty()) {
+        const auto len = audit_format::get_varint(in);
+        if (!len || *len == 0 || *len > in.size()) {
+            return {};
+        }
+        const auto body = in.first(static_cast<std::size_t>(*len));
+        records.push_back({body.front(), {body.begin() + 1, body.end()}});
+        in = in.subspan(body.size());
+    }
+    return records;
+}
+
+std::span<const std::uint8_t> as_bytes(const fmt::memory_buffer& buffer) {
+    return {reinterpret_cast<const std::uint8_t*>(buffer.data()),  // NOLINT
+            buffer.size()};
+}
+
+std::vector<std::uint8_t> read_file_bytes(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// Test: varint / zigzag 왕복
+// ---------------------------------------------------------------------------
+TEST(AuditFormatTest, VarintAndZigzagRoundTrip) {
+    for (const std::uint64_t value : {0ULL, 1ULL, 127ULL, 128ULL, 300ULL, ~0ULL}) {
+        fmt::memory_buffer out;
+        audit_format::put_varint(out, value);
+        auto in = as_bytes(out);
+        EXPECT_EQ(audit_format::get_varint(in), value);
+        EXPECT_TRUE(in.empty());
+    }
+    for (const std::int64_t value : {0LL, -1LL, 1LL, -1'000'000LL, 1'700'000'000'000'000LL}) {
+        EXPECT_EQ(audit_format::unzigzag(audit_format::zigzag(value)), value);
+    }
+
+    // 잘린 varint 는 거부
+    const std::array<std::uint8_t, 2> truncated{0x80, 0x80};
+    std::span<const std::uint8_t> in{truncated};
+    EXPECT_FALSE(audit_format::get_varint(in).has_value());
+}
+
+// ---------------------------------------------------------------------------
+// Test: 반복 문자열은 세그먼트 안에서 한 번만 정의되고 이후 id 로 참조됨
+// ---------------------------------------------------------------------------
+TEST(AuditFormatTest, SegmentEncoderInternsRepeatedStrings) {
+    const std::vector<std::string_view> tables{"orders", "orders"};
+    QueryLog entry;
+    entry.session_id = 7;
+    entry.db_user = "app_user";
+    entry.client_ip = "10.0.0.1";
+    entry.raw_sql = "SELECT * FROM orders o JOIN orders p";
+    entry.tables = tables;
+    entry.timestamp = std::chrono::system_clock::time_point{std::chrono::seconds{1'700'000'000}};
+
+    audit_format::AuditSegmentEncoder encoder;
+    fmt::memory_buffer first;
+    encoder.begin_segment(first);
+    fmt::memory_buffer staging;
+    audit_format::encode_query(staging, entry);
+    ASSERT_TRUE(encoder.append(as_bytes(staging), first));
+
+    const auto first_records = split_audit_records(as_bytes(first));
+    // SEGMENT + STRING(app_user, 10.0.0.1, orders) + QUERY
+    ASSERT_EQ(first_records.size(), 5U);
+    EXPECT_EQ(first_records[0].type, static_cast<std::uint8_t>(audit_format::RecordType::kSegment));
+    for (std::size_t i = 1; i <= 3; ++i) {
+        EXPECT_EQ(first_records[i].type,
+                  static_cast<std::uint8_t>(audit_format::RecordType::kString));
+    }
+    EXPECT_EQ(first_records[4].type, static_cast<std::uint8_t>(audit_format::RecordType::kQuery));
+
+    // 같은 사용자/IP/테이블의 두 번째 레코드: 정의 없이 QUERY 하나, staging 보다 작음
+    entry.timestamp += std::chrono::milliseconds{3};
+    staging.clear();
+    audit_format::encode_query(staging, entry);
+    fmt::memory_buffer second;
+    ASSERT_TRUE(encoder.append(as_bytes(staging), second));
+    const auto second_records = split_audit_records(as_bytes(second));
+    ASSERT_EQ(second_records.size(), 1U);
+    EXPECT_EQ(second_records[0].type, static_cast<std::uint8_t>(audit_format::RecordType::kQuery));
+    EXPECT_LT(second.size(), staging.size());
+
+    // 타임스탬프는 직전 레코드 대비 delta (3ms = 3000us)
+    auto body = std::span<const std::uint8_t>{second_records[0].body};
+    EXPECT_EQ(audit_format::unzigzag(audit_format::get_varint(body).value_or(0)), 3000);
+}
+
+// ---------------------------------------------------------------------------
+// Test: 손상된 staging 은 출력/사전을 변경하지 않음
+// ---------------------------------------------------------------------------
+TEST(AuditFormatTest, CorruptStagingIsRejectedWithoutSideEffects) {
+    BlockLog entry;
+    entry.db_user = "attacker";
+    entry.client_ip = "10.0.0.9";
+    entry.matched_rule = "block-drop";
+    entry.reason = "DROP is not allowed";
+    entry.raw_sql = "DROP TABLE users";
+
+    fmt::memory_buffer staging;
+    audit_format::encode_block(staging, entry);
+    audit_format::AuditSegmentEncoder encoder;
+
+    fmt::memory_buffer out;
+    const auto truncated = as_bytes(staging).first(staging.size() - 4);
+    EXPECT_FALSE(encoder.append(truncated, out));
+    EXPECT_EQ(out.size(), 0U);
+
+    // 실패한 시도의 문자열이 사전에 남지 않았으므로 정상 기록 시 정의가 모두 나온다
+    ASSERT_TRUE(encoder.append(as_bytes(staging), out));
+    const auto records = split_audit_records(as_bytes(out));
+    ASSERT_EQ(records.size(), 5U);  // STRING x4 + BLOCK
+    EXPECT_EQ(records[4].type, static_cast<std::uint8_t>(audit_format::RecordType::kBlock));
+}
+
+// ---------------------------------------------------------------------------
+// Test: binary 형식 — 쿼리/차단은 .audit 파일로, 연결 로그는 JSON 로그에 남음
+// ---------------------------------------------------------------------------
+TEST_F(StructuredLoggerTest, BinaryFormatWritesAuditFile) {
+    const auto audit_file = BinaryAuditSink::audit_path_for(log_file_);
+    EXPECT_EQ(audit_file, log_dir_ / "test.audit");
+    {
+        StructuredLogger logger(LogLevel::kInfo, log_file_, {}, LogFormat::kBinary);
+
+        ConnectionLog conn;
+        conn.event = "connect";
+        conn.client_ip = "127.0.0.1";
+        logger.log_connection(conn);
+
+        QueryLog query;
+        query.db_user = "app_user";
+        query.client_ip = "127.0.0.1";
+        query.raw_sql = "SELECT 1";
+        logger.log_query(query);
+
+        BlockLog block;
+        block.db_user = "app_user";
+        block.client_ip = "127.0.0.1";
+        block.raw_sql = "DROP TABLE t";
+        block.matched_rule = "block-drop";
+        logger.log_block(block);
+        logger.flush();
+    }
+
+    const auto lines = read_log_lines();
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_EQ(JsonLineParser(lines[0]).get_field("event"), "connect");
+
+    const auto bytes = read_file_bytes(audit_file);
+    const auto records = split_audit_records(bytes);
+    ASSERT_FALSE(records.empty());
+    EXPECT_EQ(records.front().type,
+              static_cast<std::uint8_t>(audit_format::RecordType::kSegment));
+    ASSERT_GE(records.front().body.size(), 5U);
+    EXPECT_EQ(std::string(records.front().body.begin(), records.front().body.begin() + 4),
+              "DBGA");
+
+    std::size_t queries = 0;
+    std::size_t blocks = 0;
+    for (const auto& record : records) {
+        queries += record.type == static_cast<std::uint8_t>(audit_format::RecordType::kQuery);
+        blocks += record.type == static_cast<std::uint8_t>(audit_format::RecordType::kBlock);
+    }
+    EXPECT_EQ(queries, 1U);
+    EXPECT_EQ(blocks, 1U);
+}
+
+// ---------------------------------------------------------------------------
+// Test: binary + 비동기 모드 — 감사 채널도 flush() 로 모두 기록됨
+// ---------------------------------------------------------------------------
+TEST_F(StructuredLoggerTest, BinaryFormatAsyncModeWritesAllRecords) {
+    AsyncLogOptions async{.enabled = true,
+                          .queue_capacity = 256,
+                          .flush_batch = 8,
+                          .flush_interval = std::chrono::milliseconds{50},
+                          .overflow_policy = LogOverflowPolicy::kBlock};
+    constexpr int kEntries = 50;
+    {
+        StructuredLogger logger(LogLevel::kInfo, log_file_, std::move(async), LogFormat::kBinary);
+        for (int i = 0; i < kEntries; ++i) {
+            const std::string raw_sql = "SELECT " + std::to_string(i);
+            QueryLog entry;
+            entry.session_id = static_cast<std::uint64_t>(i);
+            entry.db_user = "app_user";
+            entry.raw_sql = raw_sql;
+            logger.log_query(entry);
+        }
+        logger.flush();
+
+        const auto records = split_audit_records(
+            read_file_bytes(BinaryAuditSink::audit_path_for(log_file_)));
+        std::size_t queries = 0;
+        for (const auto& record : records) {
+            queries += record.type == static_cast<std::uint8_t>(audit_format::RecordType::kQuery);
+        }
+        EXPECT_EQ(queries, static_cast<std::size_t>(kEntries));
+    }
+    EXPECT_TRUE(read_log_lines().empty());
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
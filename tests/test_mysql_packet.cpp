@@ -1,17 +1,19 @@
 // ---------------------------------------------------------------------------
 // test_mysql_packet.cpp
 //
-// MysqlPacket / extract_command 단위 테스트 (DON-24)
+// MysqlPacket / MysqlPacketView / PacketFrameBuffer / extract_command 단위 테스트 (DON-24)
 // ---------------------------------------------------------------------------
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <span>
 #include <vector>
 
 #include "protocol/command.hpp"
 #include "protocol/mysql_packet.hpp"
+#include "protocol/packet_frame_buffer.hpp"
 
 // ===========================================================================
 // MysqlPacket::parse 테스트
@@ -311,6 +313,9 @@ TEST(ExtractCommand, ComQueryExtractsQuery) {
     EXPECT_EQ(cmd_result->command_type, CommandType::kComQuery);
     EXPECT_EQ(cmd_result->query, sql);
     EXPECT_EQ(cmd_result->sequence_id, seq_id);
+    // query 는 사본이 아니라 패킷 payload 를 가리키는 뷰
+    EXPECT_EQ(static_cast<const void*>(cmd_result->query.data()),
+              static_cast<const void*>(parse_result->payload().data() + 1));
 }
 
 // ---------------------------------------------------------------------------
@@ -391,6 +396,21 @@ TEST(MysqlPacketMakeError, ParsedBackAsError) {
     EXPECT_EQ(re_parsed->sequence_id(), 1);
 }
 
+// make_eof: [0xFE][warnings LE][status LE], 5바이트 payload
+TEST(MysqlPacketMakeEof, EncodesWarningsAndStatus) {
+    const MysqlPacket eof_pkt = MysqlPacket::make_eof(0x0102, 0x0022, 7);
+    const auto serialized = eof_pkt.serialize();
+
+    const std::vector<std::uint8_t> expected = {
+        0x05, 0x00, 0x00, 0x07, 0xFE, 0x02, 0x01, 0x22, 0x00};
+    EXPECT_EQ(serialized, expected);
+
+    const auto re_parsed = MysqlPacket::parse(std::span<const std::uint8_t>{serialized});
+    ASSERT_TRUE(re_parsed.has_value());
+    EXPECT_EQ(re_parsed->type(), PacketType::kEof);
+    EXPECT_EQ(re_parsed->sequence_id(), 7);
+}
+
 // COM_QUERY with empty query body (payload = {0x03} only)
 TEST(ExtractCommand, ComQueryEmptyQueryBody) {
     const std::vector<std::uint8_t> data = {
@@ -491,8 +511,8 @@ TEST(ExtractCommand, ComStmtPrepare) {
     const auto cmd_result = extract_command(*parse_result);
     ASSERT_TRUE(cmd_result.has_value());
     EXPECT_EQ(cmd_result->command_type, CommandType::kComStmtPrepare);
-    // COM_STMT_PREPARE는 query 필드를 설정하지 않는다 (COM_QUERY 전용)
-    EXPECT_TRUE(cmd_result->query.empty());
+    // COM_STMT_PREPARE 도 SQL 을 싣는다 (PREPARE 시점에 1회 파싱·정책 평가)
+    EXPECT_EQ(cmd_result->query, stmt_sql);
 }
 
 // ---------------------------------------------------------------------------
@@ -678,3 +698,289 @@ TEST(MysqlPacketMakeError, EmptyMessage) {
     ASSERT_EQ(payload.size(), 9U);
     EXPECT_EQ(payload[0], 0xFF);
 }
+
+// ===========================================================================
+// MysqlPacketView 테스트 (제로 카피 릴레이 경로)
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+// 23. view parse: payload 가 원본 버퍼를 가리키고 raw() 가 와이어 바이트와 동일
+// ---------------------------------------------------------------------------
+TEST(MysqlPacketView, PointsIntoSourceBuffer) {
+    const std::vector<std::uint8_t> data = {0x05, 0x00, 0x00, 0x03, 0x03, 0x41, 0x42, 0x43, 0x44};
+
+    const auto view = MysqlPacketView::parse(std::span<const std::uint8_t>{data});
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->sequence_id(), 3);
+    EXPECT_EQ(view->payload_length(), 5U);
+    EXPECT_EQ(view->type(), PacketType::kComQuery);
+
+    // 복사 없이 원본 버퍼 위치를 그대로 가리켜야 한다
+    EXPECT_EQ(view->payload().data(), data.data() + 4);
+    EXPECT_EQ(view->raw().data(), data.data());
+    ASSERT_EQ(view->raw().size(), data.size());
+
+    // raw() 는 MysqlPacket 경로의 serialize() 결과와 같아야 한다
+    const auto owned = MysqlPacket::parse(std::span<const std::uint8_t>{data});
+    ASSERT_TRUE(owned.has_value());
+    const auto serialized = owned->serialize();
+    EXPECT_TRUE(std::equal(view->raw().begin(), view->raw().end(), serialized.begin()));
+}
+
+// ---------------------------------------------------------------------------
+// 24. view parse: 재사용 버퍼의 뒤쪽 잔여 바이트는 raw() 에 포함되지 않음
+// ---------------------------------------------------------------------------
+TEST(MysqlPacketView, IgnoresTrailingBufferBytes) {
+    const std::vector<std::uint8_t> data = {0x01, 0x00, 0x00, 0x00, 0x0E, 0xAA, 0xBB, 0xCC};
+
+    const auto view = MysqlPacketView::parse(std::span<const std::uint8_t>{data});
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->raw().size(), 5U);
+    EXPECT_EQ(view->payload_length(), 1U);
+}
+
+// ---------------------------------------------------------------------------
+// 25. view parse: 헤더/길이 검증 실패는 MysqlPacket::parse 와 동일한 에러
+// ---------------------------------------------------------------------------
+TEST(MysqlPacketView, RejectsIncompletePayload) {
+    const std::vector<std::uint8_t> data = {0x0A, 0x00, 0x00, 0x00, 0x03, 0x41};
+
+    const auto view = MysqlPacketView::parse(std::span<const std::uint8_t>{data});
+    ASSERT_FALSE(view.has_value());
+    EXPECT_EQ(view.error().code, ParseErrorCode::kMalformedPacket);
+    EXPECT_EQ(view.error().message, "incomplete payload");
+
+    const auto too_short = MysqlPacketView::parse(std::span<const std::uint8_t>{data.data(), 3});
+    ASSERT_FALSE(too_short.has_value());
+    EXPECT_EQ(too_short.error().message, "packet too short");
+}
+
+// ---------------------------------------------------------------------------
+// 26. extract_command(view): 결과는 MysqlPacket 경로와 동일 (둘 다 payload 를 가리키는 뷰)
+// ---------------------------------------------------------------------------
+TEST(MysqlPacketView, ExtractCommandMatchesOwnedPacket) {
+    const std::vector<std::uint8_t> data = {
+        0x09, 0x00, 0x00, 0x00, 0x03, 'S', 'E', 'L', 'E', 'C', 'T', ' ', '1'};
+
+    const auto view = MysqlPacketView::parse(std::span<const std::uint8_t>{data});
+    ASSERT_TRUE(view.has_value());
+    const auto from_view = extract_command(*view);
+    const auto owned = view->to_packet();  // query 가 가리키므로 추출 결과보다 오래 살아야 함
+    const auto from_owned = extract_command(owned);
+
+    ASSERT_TRUE(from_view.has_value());
+    ASSERT_TRUE(from_owned.has_value());
+    EXPECT_EQ(from_view->command_type, CommandType::kComQuery);
+    EXPECT_EQ(from_view->query, "SELECT 1");
+    EXPECT_EQ(from_view->query, from_owned->query);
+    EXPECT_EQ(from_view->sequence_id, from_owned->sequence_id);
+}
+
+// ===========================================================================
+// PacketFrameBuffer 테스트 (서버 응답 스트리밍 릴레이)
+// ===========================================================================
+
+namespace {
+
+// prepare/commit 으로 bytes 를 수신한 것처럼 적재
+void feed(PacketFrameBuffer& rx, std::span<const std::uint8_t> bytes) {
+    auto space = rx.prepare(bytes.size());
+    std::copy(bytes.begin(), bytes.end(), space.begin());
+    rx.commit(bytes.size());
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// 27. 한 번에 수신된 여러 패킷을 경계를 따라 걷고, 앞쪽 구간을 통째로 전달
+// ---------------------------------------------------------------------------
+TEST(PacketFrameBuffer, WalksCoalescedPackets) {
+    // row 2개 + EOF: [len=2 seq=1 "\x01A"] [len=2 seq=2 "\x01B"] [len=5 seq=3 EOF]
+    const std::vector<std::uint8_t> wire = {0x02, 0x00, 0x00, 0x01, 0x01, 'A',
+                                            0x02, 0x00, 0x00, 0x02, 0x01, 'B',
+                                            0x05, 0x00, 0x00, 0x03, 0xFE, 0x00,
+                                            0x00, 0x02, 0x00};
+    PacketFrameBuffer rx;
+    feed(rx, wire);
+
+    std::size_t offset = 0;
+    std::vector<std::uint8_t> seqs;
+    while (const auto view = rx.peek(offset)) {
+        seqs.push_back(view->sequence_id());
+        offset += view->raw().size();
+    }
+
+    EXPECT_EQ(seqs, (std::vector<std::uint8_t>{1, 2, 3}));
+    ASSERT_EQ(offset, wire.size());
+
+    // 걸어온 구간 전체가 원본 바이트 그대로 한 번에 전달 가능해야 한다
+    const auto batch = rx.readable().first(offset);
+    EXPECT_TRUE(std::equal(batch.begin(), batch.end(), wire.begin(), wire.end()));
+
+    rx.consume(offset);
+    EXPECT_TRUE(rx.readable().empty());
+}
+
+// ---------------------------------------------------------------------------
+// 28. 패킷이 수신 경계에 걸쳐 잘리면 missing() 만큼 더 받은 뒤 완성
+// ---------------------------------------------------------------------------
+TEST(PacketFrameBuffer, SplitPacketCompletesAfterMoreBytes) {
+    const std::vector<std::uint8_t> wire = {0x03, 0x00, 0x00, 0x07, 0x01, 0x02, 0x03};
+    PacketFrameBuffer rx;
+
+    feed(rx, std::span<const std::uint8_t>{wire}.first(2));
+    EXPECT_FALSE(rx.peek(0).has_value());
+    EXPECT_EQ(rx.missing(0), 2U);  // 헤더까지 부족분
+
+    feed(rx, std::span<const std::uint8_t>{wire}.subspan(2, 3));
+    EXPECT_FALSE(rx.peek(0).has_value());
+    EXPECT_EQ(rx.missing(0), 2U);  // payload 부족분
+
+    feed(rx, std::span<const std::uint8_t>{wire}.subspan(5));
+    const auto view = rx.peek(0);
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->sequence_id(), 7);
+    EXPECT_EQ(view->payload_length(), 3U);
+    EXPECT_EQ(rx.missing(0), 0U);
+}
+
+// ---------------------------------------------------------------------------
+// 29. 다음 응답에 속하는 잔여 바이트는 consume 이후에도 보존 (compaction 포함)
+// ---------------------------------------------------------------------------
+TEST(PacketFrameBuffer, KeepsTrailingBytesAcrossCompaction) {
+    PacketFrameBuffer rx;
+    const std::vector<std::uint8_t> first = {0x01, 0x00, 0x00, 0x01, 0x00};
+    const std::vector<std::uint8_t> partial = {0x04, 0x00, 0x00, 0x00, 0xAA};
+
+    feed(rx, first);
+    feed(rx, partial);
+
+    const auto view = rx.peek(0);
+    ASSERT_TRUE(view.has_value());
+    rx.consume(view->raw().size());
+
+    // 버퍼 끝을 넘는 공간을 요구하여 compaction/확장을 유발
+    const std::size_t big = rx.capacity();
+    auto space = rx.prepare(big);
+    ASSERT_GE(space.size(), big);
+    ASSERT_EQ(rx.readable().size(), partial.size());
+    EXPECT_TRUE(std::equal(rx.readable().begin(), rx.readable().end(), partial.begin()));
+    EXPECT_EQ(rx.missing(0), 3U);
+}
+
+// ---------------------------------------------------------------------------
+// 30. 큰 패킷으로 자란 버퍼는 비워진 뒤 작은 수신 시 기본 크기로 축소
+// ---------------------------------------------------------------------------
+TEST(PacketFrameBuffer, ShrinksAfterLargePacketDrained) {
+    PacketFrameBuffer rx;
+    auto space = rx.prepare(PacketFrameBuffer::kRetainMax + 1);
+    EXPECT_GT(rx.capacity(), PacketFrameBuffer::kRetainMax);
+    rx.commit(space.size());
+    rx.consume(space.size());
+
+    [[maybe_unused]] auto small = rx.prepare(16);
+    EXPECT_EQ(rx.capacity(), PacketFrameBuffer::kDefaultCapacity);
+}
+
+// ---------------------------------------------------------------------------
+// 30-1. release / would_grow: 비어 있을 때만 해제, compaction 으로 충분하면 확장 아님
+// ---------------------------------------------------------------------------
+TEST(PacketFrameBuffer, ReleaseOnlyWhenEmpty) {
+    PacketFrameBuffer rx;
+    const std::vector<std::uint8_t> partial = {0x04, 0x00, 0x00, 0x00, 0xAA};
+    feed(rx, partial);
+    ASSERT_EQ(rx.capacity(), PacketFrameBuffer::kDefaultCapacity);
+    EXPECT_FALSE(rx.would_grow(PacketFrameBuffer::kDefaultCapacity - partial.size()));
+    EXPECT_TRUE(rx.would_grow(PacketFrameBuffer::kDefaultCapacity));
+
+    rx.release(0);  // 미완성 패킷이 남아 있으면 유지
+    EXPECT_EQ(rx.capacity(), PacketFrameBuffer::kDefaultCapacity);
+
+    rx.consume(partial.size());
+    rx.release(PacketFrameBuffer::kDefaultCapacity);  // keep 이하면 유지
+    EXPECT_EQ(rx.capacity(), PacketFrameBuffer::kDefaultCapacity);
+    rx.release(0);
+    EXPECT_EQ(rx.capacity(), 0U);
+
+    // 해제 후 prepare 는 기본 크기로 다시 할당
+    [[maybe_unused]] auto space = rx.prepare(16);
+    EXPECT_EQ(rx.capacity(), PacketFrameBuffer::kDefaultCapacity);
+}
+
+// ---------------------------------------------------------------------------
+// 31. extract_command: COM_STMT_EXECUTE → statement_id (LE 4B) / flags 추출
+// ---------------------------------------------------------------------------
+TEST(ExtractCommand, ComStmtExecuteStatementIdAndFlags) {
+    // [0x17][stmt_id=0x04030201][flags=0x01][iteration_count=1]
+    const std::vector<std::uint8_t> data = {
+        0x0A, 0x00, 0x00, 0x00, 0x17, 0x01, 0x02, 0x03, 0x04, 0x01, 0x01, 0x00, 0x00, 0x00};
+
+    const auto view = MysqlPacketView::parse(std::span<const std::uint8_t>{data});
+    ASSERT_TRUE(view.has_value());
+    const auto cmd_result = extract_command(*view);
+    ASSERT_TRUE(cmd_result.has_value());
+    EXPECT_EQ(cmd_result->command_type, CommandType::kComStmtExecute);
+    EXPECT_EQ(cmd_result->statement_id, 0x04030201U);
+    EXPECT_EQ(cmd_result->execute_flags, 0x01);
+    EXPECT_TRUE(cmd_result->query.empty());
+}
+
+// ---------------------------------------------------------------------------
+// 32. extract_command: statement_id 가 잘린 statement 커맨드는 malformed (fail-close)
+// ---------------------------------------------------------------------------
+TEST(ExtractCommand, TruncatedStatementIdIsMalformed) {
+    const std::vector<std::uint8_t> data = {0x03, 0x00, 0x00, 0x00, 0x19, 0x01, 0x02};
+
+    const auto view = MysqlPacketView::parse(std::span<const std::uint8_t>{data});
+    ASSERT_TRUE(view.has_value());
+    const auto cmd_result = extract_command(*view);
+    ASSERT_FALSE(cmd_result.has_value());
+    EXPECT_EQ(cmd_result.error().code, ParseErrorCode::kMalformedPacket);
+}
+
+// ---------------------------------------------------------------------------
+// 33. peek_head: 큰 패킷은 헤더 + payload 앞부분만으로 판정 가능 (전체 수신 전)
+// ---------------------------------------------------------------------------
+TEST(PacketFrameBuffer, PeekHeadBeforePacketCompletes) {
+    // payload_length = 0x010000 (64KB) 인 row 의 헤더 + 앞 3바이트만 수신
+    const std::vector<std::uint8_t> wire = {0x00, 0x00, 0x01, 0x05, 0xFC, 0x00, 0x10};
+    PacketFrameBuffer rx;
+    feed(rx, std::span<const std::uint8_t>{wire}.first(5));
+
+    EXPECT_FALSE(rx.peek(0).has_value());
+    EXPECT_FALSE(rx.peek_head(0, 3).has_value());  // prefix 부족
+
+    feed(rx, std::span<const std::uint8_t>{wire}.subspan(5));
+    const auto head = rx.peek_head(0, 3);
+    ASSERT_TRUE(head.has_value());
+    EXPECT_EQ(head->payload_length, 0x010000U);
+    EXPECT_EQ(head->sequence_id, 5);
+    ASSERT_EQ(head->prefix.size(), 3U);
+    EXPECT_EQ(head->prefix[0], 0xFC);
+    EXPECT_FALSE(head->complete());
+    EXPECT_EQ(rx.missing(0), 0x010000U - 3U);
+
+    // 짧은 패킷은 min_prefix 보다 작아도 payload 전체가 있으면 complete
+    PacketFrameBuffer small;
+    const std::vector<std::uint8_t> eof = {0x05, 0x00, 0x00, 0x02, 0xFE, 0x00, 0x00, 0x02, 0x00};
+    feed(small, eof);
+    const auto eof_head = small.peek_head(0, 16);
+    ASSERT_TRUE(eof_head.has_value());
+    EXPECT_TRUE(eof_head->complete());
+    EXPECT_EQ(eof_head->payload_length, 5U);
+}
+
+// ---------------------------------------------------------------------------
+// 34. response_shape: 단일 패킷 응답 커맨드는 Result Set 상태 머신을 타지 않는다
+// ---------------------------------------------------------------------------
+TEST(ResponseShape, ClassifiesCommands) {
+    EXPECT_EQ(response_shape(CommandType::kComStatistics), ResponseShape::kSinglePacket);
+    EXPECT_EQ(response_shape(CommandType::kComPing), ResponseShape::kSinglePacket);
+    EXPECT_EQ(response_shape(CommandType::kComInitDb), ResponseShape::kSinglePacket);
+    EXPECT_EQ(response_shape(CommandType::kComStmtReset), ResponseShape::kSinglePacket);
+    EXPECT_EQ(response_shape(CommandType::kComFieldList), ResponseShape::kFieldList);
+    EXPECT_EQ(response_shape(CommandType::kComQuery), ResponseShape::kGeneric);
+    EXPECT_EQ(response_shape(CommandType::kComStmtPrepare), ResponseShape::kGeneric);
+    EXPECT_EQ(response_shape(CommandType::kComStmtExecute), ResponseShape::kGeneric);
+    EXPECT_EQ(response_shape(CommandType::kComProcessInfo), ResponseShape::kGeneric);
+}
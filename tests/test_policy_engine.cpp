@@ -13,6 +13,7 @@
 // - 차단/허용 오퍼레이션 (blocked/allowed_operations)
 // - blocked_operations vs allowed_operations 우선순위
 // - 시간대 제한 (time_restriction) — UTC 기반 / 자정 초과 범위 / 잘못된 형식
+// - time_restriction 사전 계산 창 / ZoneClock 캐시 / DST 전환 (America/New_York)
 // - 동적 SQL 차단/허용 (block_dynamic_sql: true/false)
 // - 프로시저 제어 (whitelist/blacklist, dynamic SQL, create/alter)
 // - 스키마 접근 차단 (INFORMATION_SCHEMA)
@@ -32,13 +33,21 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <memory>
+#include <regex>
 #include <string>
 #include <vector>
 
+#include "parser/injection_detector.hpp"
+#include "policy/access_index.hpp"
+#include "policy/compiled_patterns.hpp"
+#include "policy/decision_cache.hpp"
 #include "policy/policy_engine.hpp"
 #include "policy/policy_loader.hpp"
+#include "policy/policy_snapshot.hpp"
 #include "policy/policy_version_store.hpp"
 
 // ---------------------------------------------------------------------------
@@ -62,10 +71,13 @@ SessionContext make_session(const std::string& user = "testuser",
 ParsedQuery make_query(SqlCommand cmd = SqlCommand::kSelect,
                        std::vector<std::string> tables = {"users"},
                        const std::string& raw_sql = "SELECT * FROM users") {
+    // ParsedQuery 는 원문 버퍼를 빌리므로 테스트 입력은 ParsedQuery 자신이 소유하게 한다
     ParsedQuery q{};
     q.command = cmd;
-    q.tables = std::move(tables);
-    q.raw_sql = raw_sql;
+    for (auto& table : tables) {
+        q.tables.push_back(q.own(std::move(table)));
+    }
+    q.raw_sql = q.own(raw_sql);
     q.has_where_clause = false;
     return q;
 }
@@ -227,6 +239,189 @@ TEST(PolicyEngine, BlockPattern_InvalidRegex_Skipped) {
     EXPECT_EQ(result.matched_rule, "block-pattern");
 }
 
+TEST(PolicyEngine, BlockPattern_CompiledOnceAtConstruction) {
+    // 생성 시점에 block_patterns 가 컴파일되어 config 에 보관된다 (쿼리당 재컴파일 없음)
+    auto cfg = make_basic_config();
+    cfg->sql_rules.block_patterns = {"[invalid_regex", "UNION\\s+SELECT"};
+    const PolicyEngine engine(cfg);
+
+    ASSERT_NE(cfg->sql_rules.compiled_patterns, nullptr);
+    const auto* compiled_before = cfg->sql_rules.compiled_patterns.get();
+    EXPECT_EQ(compiled_before->patterns.size(), 1U);
+    ASSERT_EQ(compiled_before->invalid.size(), 1U);
+    EXPECT_EQ(compiled_before->invalid[0].source, "[invalid_regex");
+
+    const auto query = make_query(SqlCommand::kSelect, {}, "SELECT 1 UNION SELECT 2");
+    EXPECT_EQ(engine.evaluate(query, make_session()).matched_rule, "block-pattern");
+    EXPECT_EQ(engine.explain(query, make_session()).matched_rule, "block-pattern");
+
+    // 평가 후에도 동일한 컴파일 결과를 재사용한다
+    EXPECT_EQ(cfg->sql_rules.compiled_patterns.get(), compiled_before);
+}
+
+TEST(PolicyEngine, BlockPattern_StampedAtPublish) {
+    // 게시 시 stamp 를 기록해 쿼리마다 원본 패턴 목록을 비교하지 않는다
+    auto cfg = make_basic_config();
+    const PolicyEngine engine(cfg);
+
+    const auto& rules = cfg->sql_rules;
+    EXPECT_EQ(rules.compiled_stamp.compiled, rules.compiled_patterns.get());
+    EXPECT_EQ(rules.compiled_stamp.data, rules.block_patterns.data());
+    EXPECT_EQ(rules.compiled_stamp.size, rules.block_patterns.size());
+    EXPECT_TRUE(
+        is_compiled_for(rules.compiled_patterns, rules.block_patterns, rules.compiled_stamp));
+
+    // 복사본은 저장소가 달라 stamp 가 맞지 않지만, 전체 비교로 여전히 유효하다
+    const PolicyConfig copy = *cfg;
+    EXPECT_NE(copy.sql_rules.compiled_stamp.data, copy.sql_rules.block_patterns.data());
+    EXPECT_TRUE(is_compiled_for(copy.sql_rules.compiled_patterns,
+                                copy.sql_rules.block_patterns,
+                                copy.sql_rules.compiled_stamp));
+
+    // compiled_patterns 가 교체되면 stamp 는 더 이상 맞지 않는다
+    auto swapped = *cfg;
+    swapped.sql_rules.compiled_patterns = compile_block_patterns({"BENCHMARK\\s*\\("});
+    EXPECT_FALSE(is_compiled_for(swapped.sql_rules.compiled_patterns,
+                                 swapped.sql_rules.block_patterns,
+                                 swapped.sql_rules.compiled_stamp));
+}
+
+TEST(PolicyEngine, BlockPattern_ReloadRecompilesStalePatterns) {
+    // reload 시 block_patterns 와 불일치하는 컴파일 결과는 교체된다
+    auto cfg = make_basic_config();
+    PolicyEngine engine(cfg);
+
+    auto new_cfg = std::make_shared<PolicyConfig>(*cfg);  // compiled_patterns 공유 (낡음)
+    new_cfg->sql_rules.block_patterns = {"BENCHMARK\\s*\\("};
+    engine.reload(new_cfg);
+
+    ASSERT_NE(new_cfg->sql_rules.compiled_patterns, nullptr);
+    EXPECT_EQ(new_cfg->sql_rules.compiled_patterns->sources, new_cfg->sql_rules.block_patterns);
+
+    const auto query = make_query(SqlCommand::kSelect, {}, "SELECT BENCHMARK(1000000, MD5(1))");
+    const auto result = engine.evaluate(query, make_session());
+    EXPECT_EQ(result.action, PolicyAction::kBlock);
+    EXPECT_EQ(result.matched_rule, "block-pattern");
+}
+
+TEST(PolicyEngine, InjectionDetector_SharedPerPolicySnapshot) {
+    // 세션들은 정책 스냅샷 단위로 컴파일된 detector 하나를 공유한다
+    auto cfg = make_basic_config();
+    const PolicyEngine engine(cfg);
+
+    const auto first = engine.injection_detector();
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(engine.injection_detector(), first) << "no per-call (per-session) recompilation";
+    EXPECT_TRUE(first->check("SELECT LOAD_FILE('/etc/passwd')").detected)
+        << "built-in default patterns are always included";
+    EXPECT_FALSE(first->check("SELECT id FROM users WHERE id = 1").detected);
+}
+
+TEST(PolicyEngine, InjectionDetector_FollowsReload) {
+    auto cfg = make_basic_config();
+    PolicyEngine engine(cfg);
+    const auto before = engine.injection_detector();
+    ASSERT_NE(before, nullptr);
+    EXPECT_FALSE(before->check("EXEC xp_cmdshell 'dir'").detected);
+
+    auto new_cfg = std::make_shared<PolicyConfig>(*cfg);  // detector 공유 (낡음)
+    new_cfg->sql_rules.block_patterns = {"xp_cmdshell", "[invalid_regex"};
+    engine.reload(new_cfg);
+
+    const auto after = engine.injection_detector();
+    ASSERT_NE(after, nullptr);
+    EXPECT_NE(after, before);
+    EXPECT_TRUE(after->check("EXEC xp_cmdshell 'dir'").detected)
+        << "operator block_patterns are picked up on reload";
+    // 이전 스냅샷을 들고 있는 세션은 교체 이후에도 안전하게 사용할 수 있다
+    EXPECT_FALSE(before->check("EXEC xp_cmdshell 'dir'").detected);
+
+    engine.reload(nullptr);
+    EXPECT_EQ(engine.injection_detector(), nullptr);
+}
+
+TEST(CompiledPatterns, ReusesUnchangedPatternsFromPrevious) {
+    const auto previous = compile_block_patterns({"SLEEP\\s*\\(", "[invalid_regex"});
+    const auto next =
+        compile_block_patterns({"[invalid_regex", "xp_cmdshell", "SLEEP\\s*\\("}, previous.get());
+
+    EXPECT_EQ(next->reused, 2U) << "valid and invalid sources are both carried over";
+    ASSERT_EQ(next->patterns.size(), 2U);
+    EXPECT_EQ(next->patterns[0].source, "xp_cmdshell");
+    EXPECT_EQ(next->patterns[0].index, 1U);
+    EXPECT_EQ(next->patterns[1].index, 2U) << "index follows the new block_patterns order";
+    EXPECT_TRUE(std::regex_search("select sleep (1)", next->patterns[1].regex));
+    ASSERT_EQ(next->invalid.size(), 1U);
+    EXPECT_EQ(next->invalid[0].source, "[invalid_regex");
+}
+
+TEST(CompiledPatterns, PrefilterSkipsPatternsWithoutAnchors) {
+    const auto compiled = compile_block_patterns({"UNION\\s+SELECT", "(DROP|TRUNCATE)\\s"});
+    ASSERT_EQ(compiled->patterns.size(), 2U);
+    EXPECT_EQ(compiled->patterns[0].anchors.size(), 2U) << "UNION, SELECT";
+    EXPECT_TRUE(compiled->patterns[1].anchors.empty()) << "교대는 필수 리터럴이 없다";
+
+    std::vector<bool> found;
+    compiled->prefilter.scan("select * from t where a = 1", found);
+    EXPECT_FALSE(CompiledBlockPatterns::candidate(compiled->patterns[0], found));
+    EXPECT_TRUE(CompiledBlockPatterns::candidate(compiled->patterns[1], found))
+        << "anchor 없는 패턴은 항상 정규식 실행";
+    compiled->prefilter.scan("SELECT 1 union   select 2", found);
+    EXPECT_TRUE(CompiledBlockPatterns::candidate(compiled->patterns[0], found));
+
+    // 판정 결과는 사전 필터 유무와 같다
+    auto cfg = make_basic_config();
+    cfg->sql_rules.block_patterns = {"UNION\\s+SELECT", "(DROP|TRUNCATE)\\s"};
+    const PolicyEngine engine(cfg);
+    const SqlParser parser;
+    const auto blocked = parser.parse("SELECT id FROM users UNION\n SELECT id FROM orders");
+    ASSERT_TRUE(blocked.has_value());
+    EXPECT_EQ(engine.evaluate(*blocked, make_session()).matched_rule, "block-pattern");
+    const auto allowed = parser.parse("SELECT id FROM users WHERE id = 1");
+    ASSERT_TRUE(allowed.has_value());
+    EXPECT_EQ(engine.evaluate(*allowed, make_session()).action, PolicyAction::kAllow);
+}
+
+TEST(PolicyEngine, Reload_ReusesUnchangedCompiledParts) {
+    auto cfg = make_basic_config();
+    PolicyEngine engine(cfg);
+    const auto detector = engine.injection_detector();
+
+    // 내용이 같은 새 config (로더가 새로 읽은 것과 같다): 인덱스/detector 공유
+    auto same = make_basic_config();
+    engine.reload(same);
+    EXPECT_EQ(same->access_index, cfg->access_index);
+    EXPECT_EQ(engine.injection_detector(), detector);
+    ASSERT_NE(same->sql_rules.compiled_patterns, nullptr);
+    EXPECT_EQ(same->sql_rules.compiled_patterns->reused, 2U);
+    EXPECT_NE(same->rule_profile, cfg->rule_profile) << "profile restarts with each snapshot";
+
+    // 패턴 1개 추가 + 룰 변경: 바뀐 부분만 새로 컴파일
+    auto changed = make_basic_config();
+    changed->sql_rules.block_patterns.emplace_back("xp_cmdshell");
+    changed->access_control[0].allowed_tables.emplace_back("audit");
+    engine.reload(changed);
+    EXPECT_NE(changed->access_index, same->access_index);
+    EXPECT_NE(engine.injection_detector(), detector);
+    EXPECT_EQ(changed->sql_rules.compiled_patterns->reused, 2U);
+
+    const auto query = make_query(SqlCommand::kSelect, {"audit"}, "SELECT * FROM audit");
+    EXPECT_EQ(engine.evaluate(query, make_session()).action, PolicyAction::kAllow);
+    EXPECT_TRUE(engine.injection_detector()->check("EXEC xp_cmdshell 'dir'").detected);
+}
+
+TEST(PolicyEngine, BlockPattern_MutatedAfterConstruction_NotStale) {
+    // 게시 이후 block_patterns 가 수정되어도 낡은 matcher 로 평가하지 않는다 (fail-close)
+    auto cfg = make_basic_config();
+    const PolicyEngine engine(cfg);
+    cfg->sql_rules.block_patterns = {"BENCHMARK\\s*\\("};
+
+    const auto query = make_query(SqlCommand::kSelect, {}, "SELECT BENCHMARK(1000000, MD5(1))");
+    const auto result = engine.evaluate(query, make_session());
+    EXPECT_EQ(result.action, PolicyAction::kBlock);
+    EXPECT_EQ(result.matched_rule, "block-pattern");
+}
+
 // ===========================================================================
 // Step 5: 사용자/IP 접근 제어
 // ===========================================================================
@@ -951,6 +1146,10 @@ data_protection:
     EXPECT_EQ(cfg.access_control.size(), 1U);
     EXPECT_EQ(cfg.sql_rules.block_statements.size(), 1U);
     EXPECT_EQ(cfg.sql_rules.block_patterns.size(), 1U);
+    // 로드 시점에 block_patterns 가 사전 컴파일된다
+    ASSERT_NE(cfg.sql_rules.compiled_patterns, nullptr);
+    EXPECT_EQ(cfg.sql_rules.compiled_patterns->patterns.size(), 1U);
+    EXPECT_TRUE(cfg.sql_rules.compiled_patterns->invalid.empty());
     EXPECT_TRUE(cfg.procedure_control.block_dynamic_sql);
     EXPECT_TRUE(cfg.data_protection.block_schema_access);
 
@@ -1930,6 +2129,34 @@ TEST(PolicyEngine, Explain_MatchesEvaluate_Block_NoAccessRule) {
     EXPECT_EQ(eval_result.matched_rule, expl_result.matched_rule);
 }
 
+TEST(PolicyEngine, Explain_MatchesEvaluate_BlockPatterns) {
+    // explain() 의 Step 4 는 evaluate() 와 같은 사전 필터 + 정규식 경로를 쓴다
+    auto cfg = make_basic_config();
+    cfg->sql_rules.block_patterns = {"UNION\\s+SELECT", "SLEEP\\s*\\(", "\\bOR\\s+1\\s*=\\s*1"};
+    const PolicyEngine engine(cfg);
+    const auto session = make_session();
+
+    for (const std::string sql : {"SELECT id FROM users UNION  SELECT password FROM users",
+                                  "SELECT id FROM users WHERE id = 1 OR 1=1",
+                                  "SELECT sleep (5) FROM users",
+                                  "SELECT id FROM users WHERE name = 'union'"}) {
+        const auto query = make_query(SqlCommand::kSelect, {"users"}, sql);
+        const auto eval_result = engine.evaluate(query, session);
+        const auto expl_result = engine.explain(query, session);
+        EXPECT_EQ(eval_result.action, expl_result.action) << sql;
+        EXPECT_EQ(eval_result.matched_rule, expl_result.matched_rule) << sql;
+        EXPECT_EQ(eval_result.reason, expl_result.reason) << sql;
+        if (eval_result.matched_rule == "block-pattern") {
+            EXPECT_NE(expl_result.evaluation_path.find(" > block_pattern("), std::string::npos);
+        }
+    }
+
+    // explain 은 dry-run 이므로 패턴 프로파일에는 evaluate() 만 반영된다
+    const auto stats = engine.rule_stats();
+    ASSERT_EQ(stats.block_patterns.size(), 3U);
+    EXPECT_EQ(stats.block_patterns[0].cost.evaluations, 4U);
+}
+
 // ===========================================================================
 // explain_error(): ParseError → ExplainResult (fail-close)
 // ===========================================================================
@@ -2343,7 +2570,8 @@ TEST(PolicyEngine, CurrentVersion_MultipleReloads_LastVersionWins) {
 // - load_snapshot 실패 시 호출자가 기존 정책을 유지해야 함.
 //
 // [알려진 한계]
-// - rules_count/hash 는 디렉토리 스캔 복원 시 0/"" 로 초기화됨.
+// - rules_count/hash 는 디렉토리 스캔 복원 시 0/"" 로 초기화됨
+//   (binary_snapshots 로 .bin 사본이 있으면 그 헤더에서 복원).
 //   운영 환경에서는 재시작 후 목록 조회 시 0 이 될 수 있음.
 // ===========================================================================
 
@@ -2808,3 +3036,908 @@ data_protection:
 
     std::filesystem::remove_all(tmp_dir);
 }
+
+// ===========================================================================
+// 바이너리 정책 스냅샷 (policy_snapshot + PolicyVersionStore .bin 사본)
+// ===========================================================================
+
+namespace {
+
+std::span<const std::uint8_t> snapshot_bytes(const std::string& s) {
+    return {reinterpret_cast<const std::uint8_t*>(s.data()), s.size()};
+}
+
+constexpr std::string_view kSnapshotHash =
+    "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// encode → decode 가 로더 결과 필드를 모두 보존하는지 확인
+// ---------------------------------------------------------------------------
+TEST(PolicySnapshot, RoundTrip_PreservesConfig) {
+    auto cfg = make_basic_config();
+    cfg->global.log_format = "binary";
+    cfg->global.decision_cache_entries = 77;
+    cfg->global.query_log.sample_rate = 0.25;
+    cfg->global.query_log.command_sample_rates = {{.command = "SELECT", .rate = 0.5}};
+    cfg->global.query_log.session_rate_limit = 9;
+    cfg->access_control[0].time_restriction = TimeRestriction{"08:00-20:00", "Asia/Seoul"};
+    cfg->access_control[0].log_sample_rate = 0.1;
+    AccessRule monitor{};
+    monitor.user = "auditor";
+    monitor.allowed_tables = {"users"};  // 첫 룰과 문자열 공유 (테이블 인터닝)
+    monitor.blocked_operations = {"DELETE"};
+    monitor.mode = RuleMode::kMonitor;
+    cfg->access_control.push_back(monitor);
+    cfg->sql_rules.mode = RuleMode::kMonitor;
+    cfg->data_protection.max_result_rows_action = "truncate";
+
+    const auto bin = policy_snapshot::encode(*cfg, kSnapshotHash);
+    const auto header = policy_snapshot::read_header(snapshot_bytes(bin));
+    ASSERT_TRUE(header.has_value()) << header.error();
+    EXPECT_EQ(header->rules_count, 2U);
+    EXPECT_EQ(header->source_hash, kSnapshotHash);
+
+    const auto decoded = policy_snapshot::decode(snapshot_bytes(bin), kSnapshotHash);
+    ASSERT_TRUE(decoded.has_value()) << decoded.error();
+    EXPECT_EQ(decoded->access_control, cfg->access_control);
+    EXPECT_EQ(decoded->global.log_format, "binary");
+    EXPECT_EQ(decoded->global.decision_cache_entries, 77U);
+    EXPECT_DOUBLE_EQ(decoded->global.query_log.sample_rate, 0.25);
+    ASSERT_EQ(decoded->global.query_log.command_sample_rates.size(), 1U);
+    EXPECT_EQ(decoded->global.query_log.command_sample_rates[0].command, "SELECT");
+    EXPECT_EQ(decoded->global.query_log.session_rate_limit, 9U);
+    EXPECT_EQ(decoded->sql_rules.block_statements, cfg->sql_rules.block_statements);
+    EXPECT_EQ(decoded->sql_rules.block_patterns, cfg->sql_rules.block_patterns);
+    EXPECT_EQ(decoded->sql_rules.mode, RuleMode::kMonitor);
+    EXPECT_EQ(decoded->procedure_control.whitelist, cfg->procedure_control.whitelist);
+    EXPECT_EQ(decoded->data_protection.max_result_rows, 10000U);
+    EXPECT_EQ(decoded->data_protection.max_result_rows_action, "truncate");
+    // 컴파일 결과는 기록하지 않는다 — 엔진이 채운다
+    EXPECT_EQ(decoded->sql_rules.compiled_patterns, nullptr);
+    EXPECT_EQ(decoded->access_index, nullptr);
+}
+
+// ---------------------------------------------------------------------------
+// 손상/잘림/다른 원본/잘못된 magic 은 모두 거부 (호출자는 YAML 로 fallback)
+// ---------------------------------------------------------------------------
+TEST(PolicySnapshot, Decode_RejectsCorruptTruncatedAndForeign) {
+    const auto bin = policy_snapshot::encode(*make_basic_config(), kSnapshotHash);
+    ASSERT_TRUE(policy_snapshot::decode(snapshot_bytes(bin), kSnapshotHash).has_value());
+
+    auto flipped = bin;
+    flipped.back() = static_cast<char>(flipped.back() ^ 0x01);
+    EXPECT_FALSE(policy_snapshot::decode(snapshot_bytes(flipped), kSnapshotHash).has_value());
+
+    const auto truncated = bin.substr(0, bin.size() - 3);
+    EXPECT_FALSE(policy_snapshot::decode(snapshot_bytes(truncated), kSnapshotHash).has_value());
+    const auto header_only = bin.substr(0, policy_snapshot::kHeaderSize - 1);
+    EXPECT_FALSE(policy_snapshot::read_header(snapshot_bytes(header_only)).has_value());
+
+    auto bad_magic = bin;
+    bad_magic[0] = 'X';
+    EXPECT_FALSE(policy_snapshot::decode(snapshot_bytes(bad_magic), kSnapshotHash).has_value());
+
+    const std::string other(kSnapshotHash.size(), 'f');
+    EXPECT_FALSE(policy_snapshot::decode(snapshot_bytes(bin), other).has_value());
+
+    // block_patterns 가 비어 있는 스냅샷은 로더와 같이 fail-close 거부
+    PolicyConfig empty{};
+    const auto no_patterns = policy_snapshot::encode(empty, kSnapshotHash);
+    EXPECT_FALSE(policy_snapshot::decode(snapshot_bytes(no_patterns), kSnapshotHash).has_value());
+}
+
+// ---------------------------------------------------------------------------
+// binary_snapshots: .bin 기록 → load_snapshot / 재시작 메타 복원 / load_cached
+// ---------------------------------------------------------------------------
+TEST(PolicyVersionStore, BinarySnapshot_SavedRestoredAndCached) {
+    const std::filesystem::path tmp_dir = "/tmp/pvs_test_binary";
+    std::filesystem::remove_all(tmp_dir);
+    std::filesystem::create_directories(tmp_dir);
+
+    const auto yaml_path = tmp_dir / "policy.yaml";
+    ASSERT_FALSE(create_temp_yaml(yaml_path).empty());
+    auto cfg_result = PolicyLoader::load(yaml_path);
+    ASSERT_TRUE(cfg_result.has_value()) << cfg_result.error();
+
+    std::string hash;
+    {
+        PolicyVersionStore store(tmp_dir, 10U, true);
+        const auto meta = store.save_snapshot(*cfg_result, yaml_path);
+        ASSERT_TRUE(meta.has_value()) << meta.error();
+        hash = meta->hash;
+        auto bin_path = meta->snapshot_path;
+        bin_path.replace_extension(".bin");
+        EXPECT_TRUE(std::filesystem::exists(bin_path));
+
+        const auto loaded = store.load_snapshot(meta->version);
+        ASSERT_TRUE(loaded.has_value()) << loaded.error();
+        EXPECT_EQ(loaded->access_control, cfg_result->access_control);
+    }
+
+    // 재시작: .bin 헤더에서 hash / rules_count 복원, 원본이 같으면 load_cached 성공
+    {
+        const PolicyVersionStore store(tmp_dir, 10U, true);
+        const auto versions = store.list_versions();
+        ASSERT_EQ(versions.size(), 1U);
+        EXPECT_EQ(versions[0].hash, hash);
+        EXPECT_EQ(versions[0].rules_count, 1U);
+
+        const auto cached = store.load_cached(yaml_path);
+        ASSERT_TRUE(cached.has_value()) << cached.error();
+        EXPECT_EQ(cached->meta.version, 1U);
+        EXPECT_EQ(cached->config.sql_rules.block_patterns, cfg_result->sql_rules.block_patterns);
+    }
+
+    // 원본이 바뀌면 캐시 미사용
+    {
+        std::ofstream out(yaml_path, std::ios::app);
+        out << "\n# edited\n";
+    }
+    {
+        const PolicyVersionStore store(tmp_dir, 10U, true);
+        EXPECT_FALSE(store.load_cached(yaml_path).has_value());
+    }
+
+    std::filesystem::remove_all(tmp_dir);
+}
+
+// ---------------------------------------------------------------------------
+// 파싱 뒤 save_snapshot 전에 원본이 수정됨 → .bin 의 해시와 본문은 같은 바이트 (사본) 기준
+//   이전 정책 본문에 새 파일 해시가 붙으면 다음 기동이 수정 내용을 잃는다
+// ---------------------------------------------------------------------------
+TEST(PolicyVersionStore, BinarySnapshot_SourceEditedAfterLoadIsNotLost) {
+    const std::filesystem::path tmp_dir = "/tmp/pvs_test_binary_edited";
+    std::filesystem::remove_all(tmp_dir);
+    std::filesystem::create_directories(tmp_dir);
+
+    const auto yaml_path = tmp_dir / "policy.yaml";
+    ASSERT_FALSE(create_temp_yaml(yaml_path).empty());
+    auto stale = PolicyLoader::load(yaml_path);
+    ASSERT_TRUE(stale.has_value()) << stale.error();
+
+    std::string edited{kMinimalValidYaml};
+    const std::string pattern = "\"UNION\\\\s+SELECT\"";
+    const auto pos = edited.find(pattern);
+    ASSERT_NE(pos, std::string::npos);
+    edited.replace(pos, pattern.size(), "\"SLEEP\\\\s*\\\\(\"");
+    {
+        std::ofstream out(yaml_path, std::ios::trunc);
+        out << edited;
+    }
+
+    {
+        PolicyVersionStore store(tmp_dir, 10U, true);
+        const auto meta = store.save_snapshot(*stale, yaml_path);
+        ASSERT_TRUE(meta.has_value()) << meta.error();
+    }
+
+    const PolicyVersionStore store(tmp_dir, 10U, true);
+    const auto cached = store.load_cached(yaml_path);
+    ASSERT_TRUE(cached.has_value()) << cached.error();
+    EXPECT_EQ(cached->config.sql_rules.block_patterns,
+              std::vector<std::string>{"SLEEP\\s*\\("});
+
+    std::filesystem::remove_all(tmp_dir);
+}
+
+// ---------------------------------------------------------------------------
+// 손상된 .bin → load_snapshot 은 YAML 로 fallback, load_cached 는 실패
+// ---------------------------------------------------------------------------
+TEST(PolicyVersionStore, BinarySnapshot_CorruptFallsBackToYaml) {
+    const std::filesystem::path tmp_dir = "/tmp/pvs_test_binary_corrupt";
+    std::filesystem::remove_all(tmp_dir);
+    std::filesystem::create_directories(tmp_dir);
+
+    const auto yaml_path = tmp_dir / "policy.yaml";
+    ASSERT_FALSE(create_temp_yaml(yaml_path).empty());
+    auto cfg_result = PolicyLoader::load(yaml_path);
+    ASSERT_TRUE(cfg_result.has_value()) << cfg_result.error();
+
+    PolicyVersionStore store(tmp_dir, 10U, true);
+    const auto meta = store.save_snapshot(*cfg_result, yaml_path);
+    ASSERT_TRUE(meta.has_value()) << meta.error();
+
+    auto bin_path = meta->snapshot_path;
+    bin_path.replace_extension(".bin");
+    {
+        std::fstream f(bin_path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(-1, std::ios::end);
+        f.put('\x7f');
+    }
+
+    const auto loaded = store.load_snapshot(meta->version);
+    ASSERT_TRUE(loaded.has_value()) << loaded.error();
+    EXPECT_EQ(loaded->access_control, cfg_result->access_control);
+    EXPECT_FALSE(store.load_cached(yaml_path).has_value());
+
+    std::filesystem::remove_all(tmp_dir);
+}
+
+// ===========================================================================
+// 판정 캐시 (fingerprint 단위)
+// ===========================================================================
+
+TEST(PolicyEngine, DecisionCache_HitMatchesEvaluate) {
+    const PolicyEngine engine(make_basic_config());
+    const auto session = make_session();
+    const std::string fp = "SELECT * FROM users WHERE id = ?";
+
+    EXPECT_FALSE(engine.evaluate_cached(fp, "SELECT * FROM users WHERE id = 1", session));
+
+    const auto query =
+        make_query(SqlCommand::kSelect, {"users"}, "SELECT * FROM users WHERE id = 1");
+    const auto direct = engine.evaluate(query, session, fp);
+    EXPECT_EQ(direct.action, PolicyAction::kAllow);
+
+    const auto cached = engine.evaluate_cached(fp, "SELECT * FROM users WHERE id = 2", session);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached->result.action, direct.action);
+    EXPECT_EQ(cached->result.matched_rule, direct.matched_rule);
+    EXPECT_EQ(cached->command, SqlCommand::kSelect);
+    EXPECT_EQ(cached->tables, std::vector<std::string>{"users"});
+    EXPECT_EQ(engine.decision_cache_stats().hits, 1U);
+}
+
+TEST(PolicyEngine, DecisionCache_BlockPatternsCheckedOnHit) {
+    // 같은 형태라도 문자열 리터럴 내용이 block_patterns 에 걸리면 차단되어야 한다
+    auto cfg = make_basic_config();
+    cfg->sql_rules.block_patterns = {"evil"};
+    const PolicyEngine engine(cfg);
+    const auto session = make_session();
+    const std::string fp = "SELECT * FROM users WHERE name = '?'";
+
+    const auto query =
+        make_query(SqlCommand::kSelect, {"users"}, "SELECT * FROM users WHERE name = 'kim'");
+    EXPECT_EQ(engine.evaluate(query, session, fp).action, PolicyAction::kAllow);
+
+    const auto hit =
+        engine.evaluate_cached(fp, "SELECT * FROM users WHERE name = 'evil'", session);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->result.action, PolicyAction::kBlock);
+    EXPECT_EQ(hit->result.matched_rule, "block-pattern");
+}
+
+TEST(PolicyEngine, DecisionCache_BlockedDecisionCached) {
+    const PolicyEngine engine(make_basic_config());
+    const auto session = make_session();
+    const std::string fp = "DELETE FROM users WHERE id = ?";
+
+    const auto query = make_query(SqlCommand::kDelete, {"users"}, "DELETE FROM users WHERE id = 1");
+    const auto direct = engine.evaluate(query, session, fp);
+    EXPECT_EQ(direct.action, PolicyAction::kBlock);
+
+    const auto hit = engine.evaluate_cached(fp, "DELETE FROM users WHERE id = 7", session);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->result.action, PolicyAction::kBlock);
+    EXPECT_EQ(hit->result.matched_rule, direct.matched_rule);
+}
+
+TEST(PolicyEngine, DecisionCache_KeyedByUserAndIp) {
+    const PolicyEngine engine(make_basic_config());
+    const std::string fp = "SELECT * FROM users";
+    const auto query = make_query(SqlCommand::kSelect, {"users"}, "SELECT * FROM users");
+    EXPECT_EQ(engine.evaluate(query, make_session(), fp).action, PolicyAction::kAllow);
+
+    EXPECT_FALSE(engine.evaluate_cached(fp, query.raw_sql, make_session("other")).has_value());
+    EXPECT_FALSE(engine.evaluate_cached(fp, query.raw_sql, make_session("testuser", "10.0.0.1"))
+                     .has_value());
+}
+
+TEST(PolicyEngine, DecisionCache_InvalidatedOnReload) {
+    PolicyEngine engine(make_basic_config());
+    const auto session = make_session();
+    const std::string fp = "SELECT * FROM users";
+    const auto query = make_query(SqlCommand::kSelect, {"users"}, "SELECT * FROM users");
+    EXPECT_EQ(engine.evaluate(query, session, fp).action, PolicyAction::kAllow);
+    ASSERT_TRUE(engine.evaluate_cached(fp, query.raw_sql, session).has_value());
+
+    // 새 정책에서 users 접근 금지 — 이전 허용 판정이 재사용되면 안 된다
+    auto cfg = make_basic_config();
+    cfg->access_control[0].allowed_tables = {"orders"};
+    engine.reload(cfg);
+    EXPECT_FALSE(engine.evaluate_cached(fp, query.raw_sql, session).has_value());
+    EXPECT_EQ(engine.evaluate(query, session, fp).action, PolicyAction::kBlock);
+    const auto hit = engine.evaluate_cached(fp, query.raw_sql, session);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->result.action, PolicyAction::kBlock);
+
+    // 같은 버전 번호로 reload 해도 무효화된다 (버전 없는 reload 는 버전을 0 으로 되돌림)
+    engine.reload(make_basic_config(), 0);
+    EXPECT_FALSE(engine.evaluate_cached(fp, query.raw_sql, session).has_value());
+}
+
+TEST(PolicyEngine, DecisionCache_TimeRestrictionNotCached) {
+    auto cfg = make_basic_config();
+    cfg->access_control[0].time_restriction =
+        TimeRestriction{.allow_range = "00:00-23:59", .timezone = "UTC"};
+    const PolicyEngine engine(cfg);
+    const auto session = make_session();
+    const std::string fp = "SELECT id FROM users";
+    const auto query = make_query(SqlCommand::kSelect, {"users"}, "SELECT id FROM users");
+
+    EXPECT_EQ(engine.evaluate(query, session, fp).action, PolicyAction::kAllow);
+    EXPECT_FALSE(engine.evaluate_cached(fp, query.raw_sql, session).has_value());
+    EXPECT_EQ(engine.decision_cache_stats().entries, 0U);
+}
+
+TEST(PolicyEngine, DecisionCache_NumericTableNotCached) {
+    // 숫자 테이블명은 fingerprint 에서 ? 로 정규화되므로 다른 테이블과 구분되지 않는다
+    auto cfg = make_basic_config();
+    cfg->access_control[0].allowed_tables.emplace_back("archive.2023");
+    const PolicyEngine engine(cfg);
+    const auto session = make_session();
+    const auto query = make_query(SqlCommand::kSelect, {"123"}, "SELECT * FROM 123");
+    [[maybe_unused]] const auto result = engine.evaluate(query, session, "SELECT * FROM ?");
+    EXPECT_FALSE(engine.evaluate_cached("SELECT * FROM ?", query.raw_sql, session).has_value());
+
+    // schema 가 붙은 이름의 숫자 부분도 같다: archive.2023 / archive.2024 → archive.?
+    constexpr std::string_view kQualified = "SELECT * FROM archive.?";
+    const auto allowed =
+        make_query(SqlCommand::kSelect, {"archive.2023"}, "SELECT * FROM archive.2023");
+    EXPECT_EQ(engine.evaluate(allowed, session, kQualified).action, PolicyAction::kAllow);
+    EXPECT_FALSE(engine.evaluate_cached(kQualified, allowed.raw_sql, session).has_value());
+
+    // 허용 판정이 캐시되었다면 archive.2024 가 그 판정으로 통과했을 것이다
+    const auto denied =
+        make_query(SqlCommand::kSelect, {"archive.2024"}, "SELECT * FROM archive.2024");
+    EXPECT_FALSE(engine.evaluate_cached(kQualified, denied.raw_sql, session).has_value());
+    EXPECT_EQ(engine.evaluate(denied, session, kQualified).action, PolicyAction::kBlock);
+}
+
+TEST(PolicyEngine, DecisionCache_DisabledByConfig) {
+    auto cfg = make_basic_config();
+    cfg->global.decision_cache_entries = 0;
+    const PolicyEngine engine(cfg);
+    const auto session = make_session();
+    const auto query = make_query();
+    const std::string fp(query.raw_sql);
+    EXPECT_EQ(engine.evaluate(query, session, fp).action, PolicyAction::kAllow);
+    EXPECT_FALSE(engine.evaluate_cached(fp, query.raw_sql, session).has_value());
+    EXPECT_EQ(engine.decision_cache_stats().capacity, 0U);
+}
+
+TEST(DecisionCache, EvictsLeastRecentlyUsed) {
+    // 용량 16 = 샤드당 1 엔트리 — 같은 샤드에 두 번째 키가 들어오면 첫 키가 밀려난다
+    DecisionCache cache(16);
+    const auto decision = std::make_shared<const CachedDecision>();
+    for (int i = 0; i < 200; ++i) {
+        cache.insert(DecisionCacheKey{.generation = 1, .fingerprint = std::to_string(i)},
+                     decision);
+    }
+    EXPECT_LE(cache.size(), cache.capacity());
+    EXPECT_GT(cache.size(), 0U);
+    EXPECT_TRUE(cache.find(DecisionCacheKey{.generation = 1, .fingerprint = "199"}) != nullptr);
+}
+
+TEST(DecisionCache, ZeroCapacityDisables) {
+    DecisionCache cache(0);
+    cache.insert(DecisionCacheKey{.generation = 1, .fingerprint = "q"},
+                 std::make_shared<const CachedDecision>());
+    EXPECT_EQ(cache.size(), 0U);
+    EXPECT_EQ(cache.find(DecisionCacheKey{.generation = 1, .fingerprint = "q"}), nullptr);
+}
+
+TEST(DecisionCache, GenerationIsPartOfKey) {
+    DecisionCache cache(64);
+    cache.insert(DecisionCacheKey{.generation = 1, .fingerprint = "q"},
+                 std::make_shared<const CachedDecision>());
+    EXPECT_NE(cache.find(DecisionCacheKey{.generation = 1, .fingerprint = "q"}), nullptr);
+    EXPECT_EQ(cache.find(DecisionCacheKey{.generation = 2, .fingerprint = "q"}), nullptr);
+    EXPECT_EQ(cache.hits(), 1U);
+    EXPECT_EQ(cache.misses(), 1U);
+}
+
+// ===========================================================================
+// 허용 쿼리 로그 샘플링 (global.query_log / AccessRule::log_sample_rate)
+// ===========================================================================
+
+TEST(PolicyLoader, LoadFile_QueryLogSampling) {
+    const std::string tmp_path = "/tmp/test_policy_query_log.yaml";
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        std::FILE* f = std::fopen(tmp_path.c_str(), "w");
+        ASSERT_NE(f, nullptr);  // NOLINT(clang-analyzer-unix.Stream)
+        // NOLINTNEXTLINE(cert-err33-c)
+        std::fputs(R"(
+global:
+  query_log:
+    sample_rate: 2.5
+    command_sample_rates:
+      select: 0.01
+      insert: "abc"
+    session_rate_limit: 100
+    session_burst: 200
+
+access_control:
+  - user: "batch"
+    allowed_operations: ["SELECT"]
+    log_sample_rate: 0.1
+  - user: "app"
+    allowed_operations: ["SELECT"]
+
+sql_rules:
+  block_patterns:
+    - "UNION\\s+SELECT"
+)",
+                   f);   // NOLINT(cert-err33-c)
+        std::fclose(f);  // NOLINT(cert-err33-c,cppcoreguidelines-owning-memory)
+    }
+
+    const auto result = PolicyLoader::load(tmp_path);
+    ASSERT_TRUE(result.has_value());
+
+    const auto& ql = result.value().global.query_log;
+    EXPECT_DOUBLE_EQ(ql.sample_rate, 1.0) << "범위 초과 비율은 1.0 으로 clamp";
+    ASSERT_EQ(ql.command_sample_rates.size(), 2U);
+    EXPECT_EQ(ql.command_sample_rates[0].command, "SELECT") << "커맨드명은 대문자로 정규화";
+    EXPECT_DOUBLE_EQ(ql.command_sample_rates[0].rate, 0.01);
+    EXPECT_DOUBLE_EQ(ql.command_sample_rates[1].rate, 1.0) << "숫자가 아니면 1.0 (전부 기록)";
+    EXPECT_EQ(ql.session_rate_limit, 100U);
+    EXPECT_EQ(ql.session_burst, 200U);
+
+    const auto& rules = result.value().access_control;
+    ASSERT_EQ(rules.size(), 2U);
+    ASSERT_TRUE(rules[0].log_sample_rate.has_value());
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    EXPECT_DOUBLE_EQ(*rules[0].log_sample_rate, 0.1);
+    EXPECT_FALSE(rules[1].log_sample_rate.has_value());
+
+    std::remove(tmp_path.c_str());  // NOLINT(cert-err33-c)
+}
+
+TEST(PolicyEngine, QueryLogDirective_Precedence) {
+    auto cfg = make_basic_config();
+    cfg->global.query_log.sample_rate = 0.5;
+    cfg->global.query_log.command_sample_rates = {{.command = "SELECT", .rate = 0.01}};
+    cfg->global.query_log.session_rate_limit = 10;
+    const PolicyEngine engine(cfg);
+    const auto session = make_session();
+
+    // 커맨드별 비율이 기본 비율보다 우선
+    const auto select = engine.evaluate(make_query(SqlCommand::kSelect), session);
+    ASSERT_EQ(select.action, PolicyAction::kAllow);
+    EXPECT_DOUBLE_EQ(select.query_log.sample_rate, 0.01);
+    EXPECT_EQ(select.query_log.session_rate_limit, 10U);
+
+    const auto insert = engine.evaluate(make_query(SqlCommand::kInsert), session);
+    ASSERT_EQ(insert.action, PolicyAction::kAllow);
+    EXPECT_DOUBLE_EQ(insert.query_log.sample_rate, 0.5);
+
+    // access rule 의 log_sample_rate 가 가장 우선
+    cfg->access_control[0].log_sample_rate = 0.2;
+    const PolicyEngine rule_engine(cfg);
+    const auto overridden = rule_engine.evaluate(make_query(SqlCommand::kSelect), session);
+    EXPECT_DOUBLE_EQ(overridden.query_log.sample_rate, 0.2);
+}
+
+TEST(PolicyEngine, QueryLogDirective_CarriedByDecisionCache) {
+    auto cfg = make_basic_config();
+    cfg->global.query_log.sample_rate = 0.25;
+    const PolicyEngine engine(cfg);
+    const auto session = make_session();
+    const std::string fp = "SELECT * FROM users WHERE id = ?";
+
+    const auto query =
+        make_query(SqlCommand::kSelect, {"users"}, "SELECT * FROM users WHERE id = 1");
+    (void)engine.evaluate(query, session, fp);
+
+    const auto cached = engine.evaluate_cached(fp, "SELECT * FROM users WHERE id = 2", session);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_DOUBLE_EQ(cached->result.query_log.sample_rate, 0.25);
+}
+
+// ===========================================================================
+// 규칙별 프로파일 (rule_stats)
+// ===========================================================================
+
+TEST(PolicyEngine, RuleStats_CountsAccessRuleHits) {
+    auto cfg = make_basic_config();
+    AccessRule wildcard{};
+    wildcard.user = "*";
+    wildcard.source_ip_cidr = "10.0.0.0/8";
+    cfg->access_control.push_back(wildcard);
+    const PolicyEngine engine(cfg);
+
+    for (int i = 0; i < 3; ++i) {
+        (void)engine.evaluate(make_query(), make_session());
+    }
+    (void)engine.evaluate(make_query(), make_session("other", "10.1.2.3"));
+    (void)engine.evaluate(make_query(), make_session("nobody", "172.16.0.1"));
+
+    const auto stats = engine.rule_stats();
+    ASSERT_EQ(stats.access_rules.size(), 2U);
+    EXPECT_EQ(stats.access_rules[0].rule, "testuser@192.168.1.0/24");
+    EXPECT_EQ(stats.access_rules[0].cost.hits, 3U);
+    EXPECT_EQ(stats.access_rules[0].cost.evaluations, 3U);
+    EXPECT_EQ(stats.access_rules[1].rule, "*@10.0.0.0/8");
+    EXPECT_EQ(stats.access_rules[1].cost.hits, 1U);
+    EXPECT_EQ(stats.no_access_rule.hits, 1U) << "매칭 규칙 없음은 별도 버킷";
+}
+
+TEST(PolicyEngine, RuleStats_CountsBlockPatternEvaluations) {
+    const PolicyEngine engine(make_basic_config());
+    const auto session = make_session();
+
+    (void)engine.evaluate(make_query(), session);
+    const auto blocked = engine.evaluate(
+        make_query(SqlCommand::kSelect, {"users"}, "SELECT * FROM users UNION SELECT 1"),
+        session);
+    ASSERT_EQ(blocked.action, PolicyAction::kBlock);
+
+    const auto stats = engine.rule_stats();
+    ASSERT_EQ(stats.block_patterns.size(), 2U);
+    EXPECT_EQ(stats.block_patterns[0].rule, "UNION\\s+SELECT");
+    EXPECT_EQ(stats.block_patterns[0].cost.evaluations, 2U);
+    EXPECT_EQ(stats.block_patterns[0].cost.hits, 1U);
+    EXPECT_EQ(stats.block_patterns[1].cost.evaluations, 1U) << "첫 매칭에서 평가 중단";
+    EXPECT_EQ(stats.block_patterns[1].cost.hits, 0U);
+}
+
+TEST(PolicyEngine, RuleStats_CacheHitCountsHitWithoutEvaluation) {
+    const PolicyEngine engine(make_basic_config());
+    const auto session = make_session();
+    const std::string fp = "SELECT * FROM users WHERE id = ?";
+
+    (void)engine.evaluate(
+        make_query(SqlCommand::kSelect, {"users"}, "SELECT * FROM users WHERE id = 1"),
+        session,
+        fp);
+    ASSERT_TRUE(
+        engine.evaluate_cached(fp, "SELECT * FROM users WHERE id = 2", session).has_value());
+
+    const auto stats = engine.rule_stats();
+    ASSERT_EQ(stats.access_rules.size(), 1U);
+    EXPECT_EQ(stats.access_rules[0].cost.hits, 2U);
+    EXPECT_EQ(stats.access_rules[0].cost.evaluations, 1U);
+    EXPECT_EQ(stats.block_patterns[0].cost.evaluations, 2U) << "캐시 적중도 패턴은 재검사";
+}
+
+TEST(PolicyEngine, RuleStats_ResetOnReload) {
+    auto cfg = make_basic_config();
+    PolicyEngine engine(cfg);
+    (void)engine.evaluate(make_query(), make_session());
+    ASSERT_EQ(engine.rule_stats().access_rules[0].cost.hits, 1U);
+
+    engine.reload(make_basic_config());
+    const auto stats = engine.rule_stats();
+    EXPECT_EQ(stats.version, engine.current_version());
+    ASSERT_EQ(stats.access_rules.size(), 1U);
+    EXPECT_EQ(stats.access_rules[0].cost.hits, 0U);
+}
+
+TEST(PolicyEngine, RuleStats_NullConfigEmpty) {
+    const PolicyEngine engine(nullptr);
+    const auto stats = engine.rule_stats();
+    EXPECT_TRUE(stats.access_rules.empty());
+    EXPECT_TRUE(stats.block_patterns.empty());
+}
+
+// ===========================================================================
+// access_control 사전 컴파일 인덱스 (access_index)
+// ===========================================================================
+
+TEST(AccessIndex, FirstMatchAcrossUserAndWildcardBuckets) {
+    std::vector<AccessRule> rules(4);
+    rules[0].user = "app";
+    rules[0].source_ip_cidr = "10.1.0.0/16";
+    rules[1].user = "*";
+    rules[1].source_ip_cidr = "10.0.0.0/8";
+    rules[2].user = "app";
+    rules[2].source_ip_cidr = "10.1.2.0/24";
+    rules[3].user = "app";  // 빈 CIDR = 모든 IP
+    const auto index = compile_access_index(rules);
+
+    EXPECT_EQ(index->find("app", "10.1.2.3"), 0U) << "더 구체적인 CIDR 보다 앞선 룰 우선";
+    EXPECT_EQ(index->find("app", "10.2.0.1"), 1U) << "wildcard 룰이 뒤의 user 룰보다 앞섬";
+    EXPECT_EQ(index->find("app", "192.168.0.1"), 3U);
+    EXPECT_EQ(index->find("app", "::1"), 3U) << "IPv4 가 아니면 빈 CIDR 룰만 매칭";
+    EXPECT_EQ(index->find("other", "10.9.9.9"), 1U);
+    EXPECT_FALSE(index->find("other", "192.168.0.1").has_value());
+}
+
+TEST(AccessIndex, CidrBoundariesAndInvalidCidr) {
+    std::vector<AccessRule> rules(4);
+    rules[0].user = "u";
+    rules[0].source_ip_cidr = "192.168.1.100/32";
+    rules[1].user = "v";
+    rules[1].source_ip_cidr = "0.0.0.0/0";
+    rules[2].user = "w";
+    rules[2].source_ip_cidr = "10.0.0.0/33";
+    rules[3].user = "w";
+    rules[3].source_ip_cidr = "not-a-cidr";
+    const auto index = compile_access_index(rules);
+
+    EXPECT_EQ(index->find("u", "192.168.1.100"), 0U);
+    EXPECT_FALSE(index->find("u", "192.168.1.101").has_value());
+    EXPECT_EQ(index->find("v", "1.2.3.4"), 1U);
+    EXPECT_FALSE(index->find("v", "not-an-ip").has_value()) << "/0 도 IPv4 파싱 실패 시 불일치";
+    EXPECT_FALSE(index->find("w", "10.0.0.1").has_value()) << "잘못된 CIDR 은 매칭 불가";
+    ASSERT_EQ(index->invalid_cidrs.size(), 2U);
+    EXPECT_EQ(index->invalid_cidrs[0].rule_index, 2U);
+}
+
+TEST(AccessIndex, TablesAndOperationMasks) {
+    AccessRule rule{};
+    rule.user = "u";
+    rule.allowed_tables = {"Users", "orders"};
+    rule.allowed_operations = {"select", "INSERT", "GRANT"};
+    rule.blocked_operations = {"Delete"};
+    const auto index = compile_access_index({rule});
+    const auto& compiled = index->rules.at(0);
+
+    EXPECT_TRUE(compiled.table_allowed("USERS"));
+    EXPECT_TRUE(compiled.table_allowed("orders"));
+    EXPECT_FALSE(compiled.table_allowed("products"));
+    EXPECT_TRUE(compiled.operation_allowed(SqlCommand::kSelect));
+    EXPECT_TRUE(compiled.operation_allowed(SqlCommand::kInsert));
+    EXPECT_FALSE(compiled.operation_allowed(SqlCommand::kUpdate));
+    EXPECT_TRUE(compiled.operation_blocked(SqlCommand::kDelete));
+    EXPECT_FALSE(compiled.operation_blocked(SqlCommand::kSelect));
+
+    AccessRule open{};
+    open.allowed_operations = {"*"};
+    const auto open_index = compile_access_index({open});
+    EXPECT_TRUE(open_index->rules.at(0).any_table) << "기본 allowed_tables = {\"*\"}";
+    EXPECT_TRUE(open_index->rules.at(0).operation_allowed(SqlCommand::kDrop));
+}
+
+namespace {
+
+// utc_time: 테스트용 UTC 시각 (y-m-d h:m:s)
+std::chrono::system_clock::time_point utc_time(int y, unsigned mo, unsigned d, int h, int mi,
+                                               int sec = 0) {
+    using namespace std::chrono;
+    return sys_days{year{y} / month{mo} / day{d}} + hours{h} + minutes{mi} + seconds{sec};
+}
+
+}  // namespace
+
+TEST(AccessIndex, TimeWindow_PrecomputedAndZoneClocksShared) {
+    std::vector<AccessRule> rules(3);
+    rules[0].time_restriction = TimeRestriction{.allow_range = "09:30-18:15", .timezone = "UTC"};
+    rules[1].time_restriction = TimeRestriction{.allow_range = "22:00-06:00", .timezone = "UTC"};
+    // rules[2]: time_restriction 없음
+    const auto index = compile_access_index(rules);
+
+    ASSERT_TRUE(index->rules[0].time_window.has_value());
+    const auto& day = *index->rules[0].time_window;
+    EXPECT_TRUE(day.valid);
+    EXPECT_EQ(day.start_minute, 570);
+    EXPECT_EQ(day.end_minute, 1095);
+    EXPECT_TRUE(day.contains(570));
+    EXPECT_FALSE(day.contains(1095)) << "끝 시각은 배타적";
+
+    const auto& night = *index->rules[1].time_window;
+    EXPECT_TRUE(night.contains(23 * 60));
+    EXPECT_TRUE(night.contains(5 * 60 + 59));
+    EXPECT_FALSE(night.contains(12 * 60));
+    EXPECT_EQ(day.clock, night.clock) << "같은 timezone 은 ZoneClock 하나를 공유";
+    EXPECT_EQ(index->zone_clocks.size(), 1U);
+    EXPECT_FALSE(index->rules[2].time_window.has_value());
+    EXPECT_TRUE(index->time_issues.empty());
+
+    EXPECT_TRUE(day.allows(utc_time(2026, 1, 1, 9, 30)));
+    EXPECT_FALSE(day.allows(utc_time(2026, 1, 1, 18, 15)));
+    EXPECT_TRUE(night.allows(utc_time(2026, 1, 1, 2, 0)));
+}
+
+TEST(AccessIndex, TimeWindow_InvalidConfigurationRecordedOnce) {
+    std::vector<AccessRule> rules(4);
+    rules[0].time_restriction = TimeRestriction{.allow_range = "25:00-18:00", .timezone = "UTC"};
+    rules[1].time_restriction =
+        TimeRestriction{.allow_range = "00:00-23:59", .timezone = "Mars/Olympus_Mons"};
+    rules[2].time_restriction = TimeRestriction{.allow_range = "00:00-23:59", .timezone = ""};
+    rules[3].time_restriction =
+        TimeRestriction{.allow_range = "00:00-23:59", .timezone = "Mars/Olympus_Mons"};
+    const auto index = compile_access_index(rules);
+
+    EXPECT_FALSE(index->rules[0].time_window->valid);
+    EXPECT_EQ(index->rules[1].time_window->clock, nullptr);
+    EXPECT_FALSE(index->rules[1].time_window->allows(std::chrono::system_clock::now()))
+        << "알 수 없는 timezone 은 항상 허용 시간 외 (fail-close)";
+    EXPECT_NE(index->rules[2].time_window->clock, nullptr) << "빈 timezone 은 UTC fallback";
+
+    ASSERT_EQ(index->time_issues.size(), 3U) << "같은 timezone 오류는 1회만 기록";
+    EXPECT_EQ(index->time_issues[0].kind, TimeRestrictionIssue::Kind::kInvalidRange);
+    EXPECT_EQ(index->time_issues[0].rule_index, 0U);
+    EXPECT_EQ(index->time_issues[1].kind, TimeRestrictionIssue::Kind::kUnknownTimezone);
+    EXPECT_EQ(index->time_issues[1].value, "Mars/Olympus_Mons");
+    EXPECT_EQ(index->time_issues[2].kind, TimeRestrictionIssue::Kind::kEmptyTimezone);
+}
+
+TEST(AccessIndex, ZoneClock_ReusesMinuteUntilBoundary) {
+    const ZoneClock clock{std::chrono::locate_zone("UTC")};
+
+    EXPECT_EQ(clock.minute_of_day(utc_time(2026, 1, 1, 10, 5, 10)), 605);
+    EXPECT_EQ(clock.minute_of_day(utc_time(2026, 1, 1, 10, 5, 59)), 605);
+    EXPECT_EQ(clock.refreshes(), 1U) << "같은 분 안에서는 재계산하지 않음";
+    EXPECT_EQ(clock.minute_of_day(utc_time(2026, 1, 1, 10, 6, 0)), 606);
+    EXPECT_EQ(clock.refreshes(), 2U);
+    EXPECT_EQ(clock.minute_of_day(utc_time(2026, 1, 1, 23, 59, 30)), 1439);
+    EXPECT_EQ(clock.minute_of_day(utc_time(2026, 1, 2, 0, 0, 0)), 0);
+}
+
+TEST(AccessIndex, ZoneClock_FollowsDstTransitions) {
+    const std::chrono::time_zone* zone = nullptr;
+    try {
+        zone = std::chrono::locate_zone("America/New_York");
+    } catch (const std::exception&) {
+        GTEST_SKIP() << "tzdata 에 America/New_York 없음";
+    }
+    const ZoneClock clock{zone};
+
+    // 2026-03-08 07:00Z: EST(-5) → EDT(-4), 로컬 01:59 다음 분이 03:00
+    EXPECT_EQ(clock.minute_of_day(utc_time(2026, 3, 8, 6, 59, 30)), 60 + 59);
+    EXPECT_EQ(clock.minute_of_day(utc_time(2026, 3, 8, 7, 0, 0)), 3 * 60);
+    // 2026-11-01 06:00Z: EDT(-4) → EST(-5), 로컬 01:59 다음 분이 다시 01:00
+    EXPECT_EQ(clock.minute_of_day(utc_time(2026, 11, 1, 5, 59, 30)), 60 + 59);
+    EXPECT_EQ(clock.minute_of_day(utc_time(2026, 11, 1, 6, 0, 0)), 60);
+    // 여름: 09:00 EDT = 13:00Z
+    EXPECT_EQ(clock.minute_of_day(utc_time(2026, 7, 1, 13, 0, 0)), 9 * 60);
+}
+
+TEST(PolicyEngine, AccessIndex_ManyRulesFirstMatchPreserved) {
+    auto cfg = make_basic_config();
+    cfg->access_control.clear();
+    for (int i = 0; i < 2000; ++i) {
+        AccessRule rule{};
+        rule.user = "tenant" + std::to_string(i);
+        rule.source_ip_cidr =
+            "10." + std::to_string(i / 256) + "." + std::to_string(i % 256) + ".0/24";
+        rule.allowed_operations = {"SELECT"};
+        cfg->access_control.push_back(std::move(rule));
+    }
+    AccessRule fallback{};
+    fallback.user = "*";
+    fallback.source_ip_cidr = "10.0.0.0/8";
+    fallback.allowed_operations = {"INSERT"};
+    cfg->access_control.push_back(std::move(fallback));
+    const PolicyEngine engine(cfg);
+
+    const auto own = engine.evaluate(make_query(SqlCommand::kSelect),
+                                     make_session("tenant1234", "10.4.210.7"));
+    EXPECT_EQ(own.action, PolicyAction::kAllow);
+
+    // 자기 대역이 아니면 wildcard 룰 (INSERT 만 허용) 에 매칭
+    const auto other = engine.evaluate(make_query(SqlCommand::kSelect),
+                                       make_session("tenant1234", "10.0.0.7"));
+    EXPECT_EQ(other.action, PolicyAction::kBlock);
+    EXPECT_EQ(other.matched_rule, "operation-denied");
+}
+
+TEST(PolicyEngine, AccessIndex_RulesAddedAfterPublishAreHonored) {
+    auto cfg = make_basic_config();
+    const PolicyEngine engine(cfg);
+    const auto session = make_session("late", "10.0.0.1");
+    ASSERT_EQ(engine.evaluate(make_query(), session).matched_rule, "no-access-rule");
+
+    AccessRule late{};
+    late.user = "late";
+    cfg->access_control.push_back(late);
+    EXPECT_EQ(engine.evaluate(make_query(), session).action, PolicyAction::kAllow)
+        << "룰 수가 바뀌면 인덱스를 임시 재컴파일 (범위 밖 인덱스 사용 금지)";
+}
+
+// ===========================================================================
+// 세션별 access rule 바인딩 (PolicyBinding)
+// ===========================================================================
+
+TEST(PolicyEngine, Binding_MatchesOncePerSnapshot) {
+    const PolicyEngine engine(make_basic_config());
+    const auto session = make_session();
+    PolicyBinding binding;
+
+    engine.bind(session, binding);
+    ASSERT_EQ(binding.binds, 1U);
+    ASSERT_TRUE(binding.access_rule.has_value());
+
+    for (int i = 0; i < 3; ++i) {
+        const auto with_binding = engine.evaluate(make_query(), session, &binding);
+        EXPECT_EQ(with_binding.action, engine.evaluate(make_query(), session).action);
+    }
+    const auto denied = engine.evaluate(make_query(SqlCommand::kDelete), session, &binding);
+    EXPECT_EQ(denied.matched_rule, "operation-denied");
+    EXPECT_EQ(binding.binds, 1U) << "같은 스냅샷에서는 다시 매칭하지 않음";
+}
+
+TEST(PolicyEngine, Binding_RecomputedAfterReload) {
+    PolicyEngine engine(make_basic_config());
+    const auto session = make_session();
+    PolicyBinding binding;
+    engine.bind(session, binding);
+    ASSERT_EQ(engine.evaluate(make_query(), session, &binding).action, PolicyAction::kAllow);
+
+    auto restricted = make_basic_config();
+    restricted->access_control[0].source_ip_cidr = "10.0.0.0/8";
+    engine.reload(restricted);
+
+    const auto result = engine.evaluate(make_query(), session, &binding);
+    EXPECT_EQ(result.action, PolicyAction::kBlock);
+    EXPECT_EQ(result.matched_rule, "no-access-rule");
+    EXPECT_EQ(binding.binds, 2U);
+    EXPECT_FALSE(binding.access_rule.has_value());
+}
+
+TEST(PolicyEngine, Binding_DifferentIdentityRebinds) {
+    const PolicyEngine engine(make_basic_config());
+    PolicyBinding binding;
+    engine.bind(make_session(), binding);
+
+    // 바인딩과 다른 user 로 평가하면 저장된 룰을 재사용하지 않는다 (fail-close)
+    const auto result = engine.evaluate(make_query(), make_session("intruder"), &binding);
+    EXPECT_EQ(result.matched_rule, "no-access-rule");
+    EXPECT_EQ(binding.binds, 2U);
+}
+
+TEST(PolicyEngine, Binding_NullConfigClearsBinding) {
+    const PolicyEngine engine(nullptr);
+    PolicyBinding binding;
+    engine.bind(make_session(), binding);
+    EXPECT_EQ(binding.index, nullptr);
+    EXPECT_EQ(engine.evaluate(make_query(), make_session(), &binding).action,
+              PolicyAction::kBlock);
+}
+
+// ===========================================================================
+// data_protection.max_result_rows (응답 릴레이 row 수 한도)
+// ===========================================================================
+
+TEST(PolicyLoader, LoadFile_MaxResultRowsAction) {
+    const std::string tmp_path = "/tmp/test_policy_row_limit.yaml";
+    const auto write_policy = [&](const char* action) {
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        std::FILE* f = std::fopen(tmp_path.c_str(), "w");
+        ASSERT_NE(f, nullptr);  // NOLINT(clang-analyzer-unix.Stream)
+        // NOLINTNEXTLINE(cert-err33-c)
+        std::fprintf(f,
+                     "sql_rules:\n"
+                     "  block_patterns:\n"
+                     "    - \"UNION\\\\s+SELECT\"\n"
+                     "data_protection:\n"
+                     "  max_result_rows: 100\n"
+                     "  max_result_rows_action: %s\n",
+                     action);
+        std::fclose(f);  // NOLINT(cert-err33-c,cppcoreguidelines-owning-memory)
+    };
+
+    write_policy("truncate");
+    auto result = PolicyLoader::load(tmp_path);
+    ASSERT_TRUE(result.has_value()) << result.error();
+    EXPECT_EQ(result->data_protection.max_result_rows, 100U);
+    EXPECT_EQ(result->data_protection.max_result_rows_action, "truncate");
+
+    // 알 수 없는 값은 잘린 결과를 ERR 로 알리는 "error" 로 대체 (fail-close)
+    write_policy("silently_drop");
+    result = PolicyLoader::load(tmp_path);
+    ASSERT_TRUE(result.has_value()) << result.error();
+    EXPECT_EQ(result->data_protection.max_result_rows_action, "error");
+
+    // 이전 정책을 넘기면 같은 패턴은 재컴파일하지 않는다 (reload 증분 컴파일)
+    const auto previous = std::make_shared<PolicyConfig>(std::move(*result));
+    result = PolicyLoader::load(tmp_path, previous.get());
+    ASSERT_TRUE(result.has_value()) << result.error();
+    ASSERT_NE(result->sql_rules.compiled_patterns, nullptr);
+    EXPECT_EQ(result->sql_rules.compiled_patterns->reused, 1U);
+
+    std::remove(tmp_path.c_str());  // NOLINT(cert-err33-c)
+}
+
+TEST(PolicyEngine, ResultRowLimit_FollowsReload) {
+    auto cfg = make_basic_config();
+    cfg->data_protection.max_result_rows = 10;
+    PolicyEngine engine(cfg);
+    EXPECT_EQ(engine.result_row_limit().max_rows, 10U);
+    EXPECT_FALSE(engine.result_row_limit().truncate);
+
+    auto next = make_basic_config();
+    next->data_protection.max_result_rows = 500;
+    next->data_protection.max_result_rows_action = "truncate";
+    engine.reload(next);
+    EXPECT_EQ(engine.result_row_limit().max_rows, 500U);
+    EXPECT_TRUE(engine.result_row_limit().truncate);
+
+    engine.reload(nullptr);
+    EXPECT_EQ(engine.result_row_limit().max_rows, 0U);
+}
@@ -9,6 +9,7 @@
 // - SqlParser → ProcedureDetector: 저장 프로시저/동적 SQL 탐지
 // - 파싱 실패 → PolicyEngine::evaluate_error() → fail-close (kBlock)
 // - StatsCollector 연동: 쿼리 처리 후 통계 업데이트 확인
+// - QueryLogSampler: 허용 쿼리 로그 샘플링 / 세션 token bucket, 차단 로그 비대상
 //
 // [fail-close 검증]
 // 파이프라인의 모든 오류 경로가 kBlock 으로 수렴하는지 검증한다.
@@ -31,6 +32,7 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -41,6 +43,9 @@
 #include "parser/sql_parser.hpp"
 #include "policy/policy_engine.hpp"
 #include "policy/rule.hpp"
+#include "proxy/prepared_statement_table.hpp"
+#include "proxy/query_log_sampler.hpp"
+#include "proxy/relay_budget.hpp"
 #include "stats/stats_collector.hpp"
 
 // ---------------------------------------------------------------------------
@@ -675,3 +680,214 @@ TEST_F(ProxyPipeline, Monitor_RegisteredUser_BlockStatement_IsKLog_WithStats) {
     EXPECT_EQ(snap_after.blocked_queries, snap_before.blocked_queries)
         << "kLog(monitor) 는 blocked_queries 를 증가시키지 않아야 한다";
 }
+
+// ===========================================================================
+// QueryLogSampler — 허용 쿼리 로그 샘플링 / 세션별 rate limit
+// ===========================================================================
+
+TEST(QueryLogSampler, FullRateWithoutLimitAdmitsEverything) {
+    QueryLogSampler sampler(1);
+    const auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(sampler.admit(PolicyAction::kAllow, QueryLogDirective{}, now));
+    }
+}
+
+TEST(QueryLogSampler, ZeroRateSuppressesAllowButNeverBlockOrLog) {
+    QueryLogSampler sampler(1);
+    const auto now = std::chrono::steady_clock::now();
+    const QueryLogDirective none{.sample_rate = 0.0, .session_rate_limit = 1};
+    EXPECT_FALSE(sampler.admit(PolicyAction::kAllow, none, now));
+    // 차단/monitor 판정은 샘플링·rate limit 과 무관하게 항상 기록
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(sampler.admit(PolicyAction::kBlock, none, now));
+        EXPECT_TRUE(sampler.admit(PolicyAction::kLog, none, now));
+    }
+}
+
+TEST(QueryLogSampler, PartialRateApproximatesRatio) {
+    QueryLogSampler sampler(42);
+    const auto now = std::chrono::steady_clock::now();
+    const QueryLogDirective tenth{.sample_rate = 0.1};
+    int admitted = 0;
+    for (int i = 0; i < 20000; ++i) {
+        admitted += sampler.admit(PolicyAction::kAllow, tenth, now) ? 1 : 0;
+    }
+    EXPECT_GT(admitted, 1600);
+    EXPECT_LT(admitted, 2400);
+}
+
+TEST(QueryLogSampler, TokenBucketLimitsBurstAndRefills) {
+    QueryLogSampler sampler(1);
+    auto now = std::chrono::steady_clock::now();
+    const QueryLogDirective limited{.session_rate_limit = 10, .session_burst = 5};
+
+    int admitted = 0;
+    for (int i = 0; i < 20; ++i) {
+        admitted += sampler.admit(PolicyAction::kAllow, limited, now) ? 1 : 0;
+    }
+    EXPECT_EQ(admitted, 5) << "burst 용량만큼만 즉시 기록";
+
+    // 0.3초 후 10/s × 0.3 = 3 토큰 보충
+    now += std::chrono::milliseconds(300);
+    admitted = 0;
+    for (int i = 0; i < 20; ++i) {
+        admitted += sampler.admit(PolicyAction::kAllow, limited, now) ? 1 : 0;
+    }
+    EXPECT_EQ(admitted, 3);
+
+    // 오래 쉬어도 burst 를 넘겨 쌓이지 않는다
+    now += std::chrono::seconds(60);
+    admitted = 0;
+    for (int i = 0; i < 20; ++i) {
+        admitted += sampler.admit(PolicyAction::kAllow, limited, now) ? 1 : 0;
+    }
+    EXPECT_EQ(admitted, 5);
+}
+
+TEST(QueryLogSampler, SuppressedCounterInSnapshot) {
+    StatsCollector stats;
+    stats.on_query_log_suppressed();
+    stats.on_query_log_suppressed();
+    EXPECT_EQ(stats.snapshot().log_suppressed, 2U);
+}
+
+// ===========================================================================
+// PreparedStatementTable / prepare_statement
+//   PREPARE 1회 평가 → EXECUTE 는 저장된 판정 재사용, 정책 세대 변경 시 재평가
+// ===========================================================================
+
+TEST_F(ProxyPipeline, Prepared_AllowedStatementStoresVerdictAndTables) {
+    const SqlParser parser;
+    const auto stmt =
+        prepare_statement("SELECT * FROM users WHERE id = ?", parser, *engine_, session_, nullptr);
+
+    EXPECT_EQ(stmt.verdict.result.action, PolicyAction::kAllow) << stmt.verdict.result.reason;
+    EXPECT_EQ(stmt.verdict.generation, engine_->generation());
+    EXPECT_FALSE(stmt.verdict.time_dependent);
+    EXPECT_EQ(stmt.command, SqlCommand::kSelect);
+    ASSERT_EQ(stmt.tables.size(), 1U);
+    EXPECT_EQ(stmt.tables[0], "users");
+    // top_queries 집계 키: 원문 placeholder '?' 는 '\?' 로 구분된다
+    EXPECT_EQ(stmt.fingerprint, "SELECT * FROM users WHERE id = \\?");
+}
+
+TEST_F(ProxyPipeline, Prepared_BlockedAndUnparsableStatementsAreBlocked) {
+    const SqlParser parser;
+    EXPECT_EQ(prepare_statement("DROP TABLE users", parser, *engine_, session_, nullptr)
+                  .verdict.result.action,
+              PolicyAction::kBlock);
+    const auto blank = prepare_statement("   ", parser, *engine_, session_, nullptr);
+    EXPECT_EQ(blank.verdict.result.action, PolicyAction::kBlock);
+    EXPECT_TRUE(blank.fingerprint.empty());  // 토큰 없음 → 집계 대상 아님 (untracked)
+}
+
+TEST_F(ProxyPipeline, Prepared_VerdictReusedUntilPolicyReload) {
+    const SqlParser parser;
+    auto stmt = prepare_statement("DELETE FROM users WHERE id = ?", parser, *engine_, session_,
+                                  nullptr);
+    ASSERT_EQ(stmt.verdict.result.action, PolicyAction::kAllow);
+
+    // 같은 세대: 재평가 없이 저장된 판정 사용
+    EXPECT_FALSE(revalidate_statement(stmt, parser, *engine_, session_, nullptr));
+
+    // reload 로 DELETE 가 차단되면 다음 EXECUTE 부터 차단 (fail-close)
+    auto cfg = make_default_config();
+    cfg->sql_rules.block_statements.push_back("DELETE");
+    engine_->reload(cfg);
+    EXPECT_TRUE(revalidate_statement(stmt, parser, *engine_, session_, nullptr));
+    EXPECT_EQ(stmt.verdict.result.action, PolicyAction::kBlock);
+    EXPECT_EQ(stmt.verdict.generation, engine_->generation());
+    EXPECT_FALSE(revalidate_statement(stmt, parser, *engine_, session_, nullptr));
+}
+
+TEST_F(ProxyPipeline, Prepared_TimeRestrictedVerdictRevalidatedEveryExecute) {
+    auto cfg = make_default_config();
+    cfg->access_control[0].time_restriction =
+        TimeRestriction{.allow_range = "00:00-23:59", .timezone = "UTC"};
+    engine_->reload(cfg);
+
+    const SqlParser parser;
+    auto stmt = prepare_statement("SELECT id FROM users", parser, *engine_, session_, nullptr);
+    EXPECT_TRUE(stmt.verdict.time_dependent);
+    EXPECT_TRUE(revalidate_statement(stmt, parser, *engine_, session_, nullptr));
+    EXPECT_TRUE(revalidate_statement(stmt, parser, *engine_, session_, nullptr));
+}
+
+TEST(PreparedStatementTable, InsertFindEraseAndCap) {
+    PreparedStatementTable table;
+    EXPECT_EQ(table.find(1), nullptr);
+
+    table.insert(1, PreparedStatement{.sql = "SELECT 1"});
+    table.insert(1, PreparedStatement{.sql = "SELECT 2"});  // 같은 id 는 교체
+    ASSERT_NE(table.find(1), nullptr);
+    EXPECT_EQ(table.find(1)->sql, "SELECT 2");
+    EXPECT_EQ(table.size(), 1U);
+
+    table.erase(1);
+    EXPECT_EQ(table.find(1), nullptr);
+
+    for (std::uint32_t id = 0; id < PreparedStatementTable::kMaxStatements; ++id) {
+        EXPECT_FALSE(table.full());
+        table.insert(id, PreparedStatement{});
+    }
+    EXPECT_TRUE(table.full());
+    table.clear();
+    EXPECT_EQ(table.size(), 0U);
+}
+
+// ===========================================================================
+// RelayBudget
+//   세션 Account 는 차이만 전체 합계에 반영하고, 소멸 시 사용량을 돌려준다
+// ===========================================================================
+
+TEST(RelayBudget, AccountsApplyDeltasAndReleaseOnDestruction) {
+    RelayBudget budget{1024, 0};
+    {
+        RelayBudget::Account a{&budget};
+        RelayBudget::Account b{&budget};
+        a.update(100);
+        b.update(300);
+        EXPECT_EQ(budget.in_use(), 400U);
+
+        a.update(40);  // 줄어든 만큼만 빠진다
+        EXPECT_EQ(budget.in_use(), 340U);
+        EXPECT_EQ(a.bytes(), 40U);
+    }
+    EXPECT_EQ(budget.in_use(), 0U);
+
+    RelayBudget::Account detached{};  // budget 없음 → no-op
+    detached.update(10);
+    EXPECT_EQ(budget.in_use(), 0U);
+}
+
+TEST(RelayBudget, OverLimitOnlyWithGlobalLimit) {
+    RelayBudget unlimited{1024, 0};
+    RelayBudget::Account big{&unlimited};
+    big.update(1U << 30U);
+    EXPECT_FALSE(unlimited.over_limit());
+
+    RelayBudget limited{1024, 1000};
+    RelayBudget::Account acc{&limited};
+    acc.update(1000);
+    EXPECT_FALSE(limited.over_limit());  // 상한과 같으면 초과 아님
+    acc.update(1001);
+    EXPECT_TRUE(limited.over_limit());
+    acc.update(0);
+    EXPECT_FALSE(limited.over_limit());
+}
+
+TEST(RelayBudget, StatsTrackCurrentAndPeakBytes) {
+    auto stats = std::make_shared<StatsCollector>();
+    RelayBudget budget{1024, 0, stats};
+    {
+        RelayBudget::Account acc{&budget};
+        acc.update(500);
+        acc.update(200);
+        stats->on_relay_budget_wait();
+    }
+    const auto snap = stats->snapshot();
+    EXPECT_EQ(snap.relay_buffer_bytes, 0U);
+    EXPECT_EQ(snap.relay_buffer_peak_bytes, 500U);
+    EXPECT_EQ(snap.relay_budget_waits, 1U);
+}
@@ -8,21 +8,54 @@
 // ---------------------------------------------------------------------------
 
 #include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/system/error_code.hpp>
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "common/async_stream.hpp"
 #include "common/types.hpp"
 #include "health/health_check.hpp"
+#include "loadgen/fake_backend.hpp"
+#include "loadgen/loadgen_wire.hpp"
 #include "logger/structured_logger.hpp"
 #include "policy/policy_engine.hpp"
+#include "policy/rule.hpp"
+#include "protocol/packet_frame_buffer.hpp"
+#include "proxy/admission_control.hpp"
+#include "proxy/backend_pool.hpp"
 #include "proxy/proxy_server.hpp"
+#include "proxy/response_pipeline.hpp"
 #include "proxy/session.hpp"
+#include "proxy/socket_options.hpp"
+#include "proxy/socket_splice.hpp"
+#include "proxy/timer_wheel.hpp"
+#include "proxy/upstream_resolver.hpp"
+#include "proxy/upstream_set.hpp"
 #include "stats/stats_collector.hpp"
 
 // ---------------------------------------------------------------------------
@@ -56,6 +89,33 @@ TEST(ProxyConfigTest, DefaultValues) {
     EXPECT_EQ(cfg.upstream_port, 0);
     EXPECT_EQ(cfg.max_connections, 0U);
     EXPECT_EQ(cfg.connection_timeout_sec, 0U);
+    EXPECT_EQ(cfg.worker_threads, 1U);
+    EXPECT_EQ(cfg.upstream_dns_refresh_sec, 30U);
+    EXPECT_FALSE(cfg.backend_pool_enabled);
+    EXPECT_EQ(cfg.backend_pool_max_idle, 64U);
+    EXPECT_EQ(cfg.backend_pool_max_idle_per_key, 8U);
+    EXPECT_EQ(cfg.backend_pool_idle_timeout_sec, 60U);
+    EXPECT_EQ(cfg.pipeline_depth, 0U);
+    EXPECT_EQ(cfg.accept_rate_per_sec, 0U);
+    EXPECT_EQ(cfg.max_pending_handshakes, 0U);
+    EXPECT_EQ(cfg.max_connections_per_ip, 0U);
+    EXPECT_EQ(cfg.handshake_timeout_ms, 10000U);
+    EXPECT_EQ(cfg.tcp_keepalive_idle_sec, 0U);
+    EXPECT_EQ(cfg.tcp_keepalive_interval_sec, 0U);
+    EXPECT_EQ(cfg.tcp_keepalive_probes, 0U);
+    EXPECT_EQ(cfg.tcp_user_timeout_ms, 0U);
+    EXPECT_TRUE(cfg.tcp_nodelay);
+    EXPECT_EQ(cfg.socket_recv_buffer_bytes, 0U);
+    EXPECT_EQ(cfg.socket_send_buffer_bytes, 0U);
+    EXPECT_EQ(cfg.socket_busy_poll_us, 0U);
+    EXPECT_EQ(cfg.tcp_defer_accept_sec, 0U);
+    EXPECT_EQ(cfg.tcp_fastopen_queue, 0U);
+    EXPECT_TRUE(cfg.listener_handoff_from.empty());
+    EXPECT_EQ(cfg.drain_idle_sec, 5U);
+    EXPECT_EQ(cfg.drain_timeout_sec, 300U);
+    EXPECT_FALSE(cfg.log_async_enabled);
+    EXPECT_EQ(cfg.log_queue_capacity, 8192U);
+    EXPECT_EQ(cfg.log_overflow_policy, "drop");
     EXPECT_EQ(cfg.health_check_port, 0);
     EXPECT_TRUE(cfg.listen_address.empty());
     EXPECT_TRUE(cfg.upstream_address.empty());
@@ -138,6 +198,31 @@ TEST(HealthCheckTest, MultipleSetUnhealthyCalls) {
     EXPECT_EQ(hc.status(), HealthStatus::kUnhealthy);
 }
 
+// drain 은 되돌릴 수 없다: 과부하 판정(set_unhealthy / set_healthy)이 덮어쓰지 않는다
+TEST(HealthCheckTest, DrainingIsSticky) {
+    boost::asio::io_context ioc;
+    const auto stats = make_stats();
+    HealthCheck hc{18086, stats, ioc};
+
+    hc.set_draining("listener handed off");
+    EXPECT_EQ(hc.status(), HealthStatus::kDraining);
+
+    hc.set_healthy();
+    EXPECT_EQ(hc.status(), HealthStatus::kDraining);
+    hc.set_unhealthy("overloaded");
+    EXPECT_EQ(hc.status(), HealthStatus::kDraining);
+}
+
+TEST(HealthCheckTest, ListenerFdUnsetBeforeRun) {
+    boost::asio::io_context ioc;
+    const auto stats = make_stats();
+    HealthCheck hc{18087, stats, ioc};
+
+    EXPECT_EQ(hc.listener_fd(), -1);
+    hc.stop_accepting();
+    EXPECT_EQ(hc.listener_fd(), -1);
+}
+
 // ---------------------------------------------------------------------------
 // Session 생성자 + 상태 초기값 테스트
 // ---------------------------------------------------------------------------
@@ -351,3 +436,1485 @@ TEST(ProxyServerUpstreamResolverTest, HostnameAndIPSupport) {
     // resolver가 호스트명을 처리할 수 있도록 accept 루프 내부에서 사용됨
     EXPECT_NO_THROW({ const ProxyServer server{cfg2}; });
 }
+
+// ---------------------------------------------------------------------------
+// UpstreamResolver: accept 루프 밖에서 해석한 결과를 공유
+// 검증 항목:
+//   - 숫자 IP 는 해석 없이 즉시 게시되고 갱신 루프를 돌리지 않는다
+//   - 호스트명은 기동 시 1회 해석되어 endpoints() 로 즉시 읽힌다
+//   - stop() 이 대기 중인 갱신 타이머를 취소한다
+//   - 해석 실패 시 endpoints() == nullptr (호출자가 연결 거부, fail-close)
+// ---------------------------------------------------------------------------
+TEST(UpstreamResolverTest, StaticIpPublishedWithoutResolve) {
+    boost::asio::io_context io_ctx;
+    UpstreamResolver resolver{"127.0.0.1", 3306, std::chrono::seconds{30}, io_ctx};
+
+    EXPECT_TRUE(resolver.is_static());
+    const auto eps = resolver.endpoints();
+    ASSERT_NE(eps, nullptr);
+    ASSERT_EQ(eps->size(), 1U);
+    EXPECT_EQ(eps->front().port(), 3306);
+    EXPECT_EQ(eps->front().address().to_string(), "127.0.0.1");
+    EXPECT_TRUE(resolver.resolve_initial());
+}
+
+TEST(UpstreamResolverTest, StaticIpRunReturnsImmediately) {
+    boost::asio::io_context io_ctx;
+    UpstreamResolver resolver{"::1", 3306, std::chrono::seconds{30}, io_ctx};
+    bool done = false;
+    boost::asio::co_spawn(resolver.executor(), resolver.run(), [&done](std::exception_ptr) {
+        done = true;
+    });
+    // 대기 중인 타이머가 없으므로 run() 이 바로 반환된다
+    io_ctx.run_for(std::chrono::seconds{5});
+    EXPECT_TRUE(done);
+}
+
+TEST(UpstreamResolverTest, HostnameResolvedAtStartup) {
+    boost::asio::io_context io_ctx;
+    UpstreamResolver resolver{"localhost", 3307, std::chrono::seconds{30}, io_ctx};
+
+    EXPECT_FALSE(resolver.is_static());
+    EXPECT_EQ(resolver.endpoints(), nullptr);
+    ASSERT_TRUE(resolver.resolve_initial());
+    const auto eps = resolver.endpoints();
+    ASSERT_NE(eps, nullptr);
+    ASSERT_FALSE(eps->empty());
+    EXPECT_EQ(eps->front().port(), 3307);
+    EXPECT_TRUE(eps->front().address().is_loopback());
+}
+
+TEST(UpstreamResolverTest, StopCancelsRefreshLoop) {
+    boost::asio::io_context io_ctx;
+    UpstreamResolver resolver{"localhost", 3306, std::chrono::seconds{3600}, io_ctx};
+    ASSERT_TRUE(resolver.resolve_initial());
+
+    bool done = false;
+    boost::asio::co_spawn(resolver.executor(), resolver.run(), [&done](std::exception_ptr) {
+        done = true;
+    });
+    resolver.stop();
+    io_ctx.run_for(std::chrono::seconds{5});
+    EXPECT_TRUE(done);
+    // 종료 후에도 마지막 결과는 유지된다
+    EXPECT_NE(resolver.endpoints(), nullptr);
+}
+
+TEST(UpstreamResolverTest, UnresolvableHostFailsClosed) {
+    boost::asio::io_context io_ctx;
+    // .invalid TLD 는 항상 해석 실패한다 (RFC 6761)
+    UpstreamResolver resolver{"dbgate-upstream.invalid", 3306, std::chrono::seconds{30}, io_ctx};
+    EXPECT_FALSE(resolver.resolve_initial());
+    EXPECT_EQ(resolver.endpoints(), nullptr);
+}
+
+// ---------------------------------------------------------------------------
+// UpstreamSet: 다중 업스트림 선택 / 헬스 체크
+// 검증 항목:
+//   - "host[:port][@weight]" 목록 파싱 (IPv6 대괄호, 기본 포트, 잘못된 항목 거부)
+//   - weighted round-robin 은 가중치 비율대로, least_conn 은 active/weight 최소를 고른다
+//   - lease 수명 동안 활성 수가 유지되고, 연속 실패 시 제외 / 성공 시 복귀한다
+//   - probe 는 greeting 을 받으면 복귀시키고, 연결 거부는 제외시킨다
+// ---------------------------------------------------------------------------
+TEST(UpstreamSetTest, ParseUpstreamList) {
+    const auto specs = parse_upstream_list(" db1:3307@3, db2 ,[::1]:3308,10.0.0.5@2", 3306);
+    ASSERT_TRUE(specs.has_value()) << specs.error();
+    ASSERT_EQ(specs->size(), 4U);
+    EXPECT_EQ((*specs)[0], (UpstreamSpec{.host = "db1", .port = 3307, .weight = 3}));
+    EXPECT_EQ((*specs)[1], (UpstreamSpec{.host = "db2", .port = 3306, .weight = 1}));
+    EXPECT_EQ((*specs)[2], (UpstreamSpec{.host = "::1", .port = 3308, .weight = 1}));
+    EXPECT_EQ((*specs)[3], (UpstreamSpec{.host = "10.0.0.5", .port = 3306, .weight = 2}));
+
+    for (const auto* bad : {"", "db1,,db2", "db1:0", "db1:70000", "db1:", "db1@0", "db1@x",
+                            "::1:3306", "[::1", ":3306"}) {
+        EXPECT_FALSE(parse_upstream_list(bad, 3306).has_value()) << bad;
+    }
+    EXPECT_EQ(parse_upstream_balance("round_robin"), UpstreamBalance::kRoundRobin);
+    EXPECT_EQ(parse_upstream_balance("least_conn"), UpstreamBalance::kLeastConnections);
+    EXPECT_FALSE(parse_upstream_balance("random").has_value());
+}
+
+TEST(UpstreamSetTest, WeightedRoundRobinFollowsWeights) {
+    const std::vector<UpstreamCandidate> candidates{
+        {.weight = 3, .active = 0, .eligible = true},
+        {.weight = 5, .active = 0, .eligible = false},
+        {.weight = 1, .active = 0, .eligible = true},
+    };
+    std::array<int, 3> picks{};
+    for (std::uint64_t ticket = 0; ticket < 40; ++ticket) {
+        const auto index = select_upstream_index(candidates, UpstreamBalance::kRoundRobin, ticket);
+        ASSERT_TRUE(index.has_value());
+        ++picks.at(*index);
+    }
+    EXPECT_EQ(picks[0], 30);
+    EXPECT_EQ(picks[1], 0);
+    EXPECT_EQ(picks[2], 10);
+
+    const std::vector<UpstreamCandidate> none{{.weight = 1, .active = 0, .eligible = false}};
+    EXPECT_FALSE(select_upstream_index(none, UpstreamBalance::kRoundRobin, 0).has_value());
+    EXPECT_FALSE(select_upstream_index(none, UpstreamBalance::kLeastConnections, 0).has_value());
+}
+
+TEST(UpstreamSetTest, LeastConnectionsUsesActivePerWeight) {
+    // 4/2 = 2, 3/1 = 3, 5/5 = 1 → 세 번째
+    const std::vector<UpstreamCandidate> candidates{
+        {.weight = 2, .active = 4, .eligible = true},
+        {.weight = 1, .active = 3, .eligible = true},
+        {.weight = 5, .active = 5, .eligible = true},
+    };
+    for (std::uint64_t ticket = 0; ticket < 6; ++ticket) {
+        EXPECT_EQ(select_upstream_index(candidates, UpstreamBalance::kLeastConnections, ticket),
+                  2U);
+    }
+
+    // 동률이면 ticket 에 따라 시작점이 회전하여 고르게 분산된다
+    const std::vector<UpstreamCandidate> tied{
+        {.weight = 1, .active = 0, .eligible = true},
+        {.weight = 1, .active = 0, .eligible = true},
+    };
+    EXPECT_EQ(select_upstream_index(tied, UpstreamBalance::kLeastConnections, 0), 0U);
+    EXPECT_EQ(select_upstream_index(tied, UpstreamBalance::kLeastConnections, 1), 1U);
+}
+
+TEST(UpstreamSetTest, LeaseCountsActiveAndFailuresEject) {
+    boost::asio::io_context io_ctx;
+    UpstreamSet set{{{.host = "127.0.0.1", .port = 3306, .weight = 1},
+                     {.host = "127.0.0.2", .port = 3306, .weight = 1}},
+                    UpstreamSetOptions{.balance = UpstreamBalance::kLeastConnections,
+                                       .dns_refresh = std::chrono::seconds{30},
+                                       .health_interval = std::chrono::milliseconds{1000},
+                                       .health_timeout = std::chrono::milliseconds{100},
+                                       .eject_failures = 2,
+                                       .health_user = {}},
+                    io_ctx};
+    EXPECT_EQ(set.resolve_initial(), 2U);
+
+    auto first = set.select();
+    auto second = set.select();
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    // least_conn: 첫 세션이 점유한 백엔드 대신 다른 백엔드를 고른다
+    EXPECT_NE(first->endpoint, second->endpoint);
+    EXPECT_EQ(set.backend(0).active.load() + set.backend(1).active.load(), 2U);
+    first.reset();
+    EXPECT_EQ(set.backend(0).active.load() + set.backend(1).active.load(), 1U);
+
+    // 연속 실패 2회 → 제외, 남은 백엔드만 선택된다
+    second->lease.report_connect(false);
+    EXPECT_EQ(set.healthy_count(), 2U);
+    second->lease.report_connect(false);
+    EXPECT_EQ(set.healthy_count(), 1U);
+    for (int i = 0; i < 4; ++i) {
+        const auto next = set.select();
+        ASSERT_TRUE(next.has_value());
+        EXPECT_NE(next->endpoint, second->endpoint);
+    }
+
+    // 성공하면 즉시 복귀
+    second->lease.report_connect(true);
+    EXPECT_EQ(set.healthy_count(), 2U);
+
+    // 모두 제외되면 선택 불가 (fail-close)
+    for (std::size_t i = 0; i < set.size(); ++i) {
+        set.backend(i).record_failure("test");
+        set.backend(i).record_failure("test");
+    }
+    EXPECT_FALSE(set.select().has_value());
+}
+
+TEST(UpstreamSetTest, WithoutProbesBackendsAreNeverEjected) {
+    boost::asio::io_context io_ctx;
+    UpstreamSet set{{{.host = "127.0.0.1", .port = 3306, .weight = 1}},
+                    UpstreamSetOptions{.balance = UpstreamBalance::kRoundRobin,
+                                       .dns_refresh = std::chrono::seconds{30},
+                                       .health_interval = std::chrono::milliseconds{0},
+                                       .health_timeout = std::chrono::milliseconds{100},
+                                       .eject_failures = 1,
+                                       .health_user = {}},
+                    io_ctx};
+    for (int i = 0; i < 5; ++i) {
+        set.backend(0).record_failure("test");
+    }
+    EXPECT_EQ(set.healthy_count(), 1U);
+    EXPECT_TRUE(set.select().has_value());
+}
+
+TEST(UpstreamSetTest, ProbeReadmitsOnGreetingAndEjectsOnRefusal) {
+    boost::asio::io_context io_ctx;
+
+    // greeting 만 보내고 닫는 가짜 MySQL 서버
+    boost::asio::ip::tcp::acceptor alive{io_ctx, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    boost::asio::co_spawn(
+        io_ctx,
+        [&alive]() -> boost::asio::awaitable<void> {
+            static constexpr std::array<std::uint8_t, 10> kGreeting{
+                6, 0, 0, 0, 0x0A, '8', '.', '0', '.', 0};
+            while (true) {
+                auto sock = co_await alive.async_accept(boost::asio::use_awaitable);
+                co_await boost::asio::async_write(
+                    sock, boost::asio::buffer(kGreeting), boost::asio::use_awaitable);
+            }
+        },
+        boost::asio::detached);
+
+    // 닫힌 포트: 열었다 닫아 연결 거부를 만든다
+    std::uint16_t refused_port = 0;
+    {
+        boost::asio::ip::tcp::acceptor tmp{io_ctx, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+        refused_port = tmp.local_endpoint().port();
+    }
+
+    UpstreamSet set{{{.host = "127.0.0.1", .port = alive.local_endpoint().port(), .weight = 1},
+                     {.host = "127.0.0.1", .port = refused_port, .weight = 1}},
+                    UpstreamSetOptions{.balance = UpstreamBalance::kRoundRobin,
+                                       .dns_refresh = std::chrono::seconds{30},
+                                       .health_interval = std::chrono::milliseconds{50},
+                                       .health_timeout = std::chrono::milliseconds{500},
+                                       .eject_failures = 2,
+                                       .health_user = {}},
+                    io_ctx};
+    ASSERT_EQ(set.resolve_initial(), 2U);
+
+    // 살아 있는 백엔드는 제외 상태에서 시작해도 probe 한 번으로 복귀한다
+    set.backend(0).record_failure("test");
+    set.backend(0).record_failure("test");
+    ASSERT_FALSE(set.backend(0).healthy.load());
+
+    set.start();
+    for (int i = 0; i < 100 && !(set.backend(0).healthy.load() && !set.backend(1).healthy.load());
+         ++i) {
+        io_ctx.run_for(std::chrono::milliseconds{20});
+    }
+    EXPECT_TRUE(set.backend(0).healthy.load());
+    EXPECT_FALSE(set.backend(1).healthy.load());
+
+    const auto target = set.select();
+    ASSERT_TRUE(target.has_value());
+    EXPECT_EQ(target->endpoint.port(), alive.local_endpoint().port());
+    set.stop();
+}
+
+TEST(UpstreamSetTest, ProbeLoginRequiresOkFromServer) {
+    boost::asio::io_context io_ctx;
+
+    // greeting → HandshakeResponse 수신 → user 가 "probe" 이면 OK, 아니면 ERR
+    boost::asio::ip::tcp::acceptor server{io_ctx, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    std::string seen_user;
+    boost::asio::co_spawn(
+        io_ctx,
+        [&server, &seen_user]() -> boost::asio::awaitable<void> {
+            static constexpr std::array<std::uint8_t, 10> kGreeting{
+                6, 0, 0, 0, 0x0A, '8', '.', '0', '.', 0};
+            static constexpr std::array<std::uint8_t, 11> kOk{7, 0, 0, 2, 0, 0, 0, 2, 0, 0, 0};
+            while (true) {
+                auto sock = co_await server.async_accept(boost::asio::use_awaitable);
+                co_await boost::asio::async_write(
+                    sock, boost::asio::buffer(kGreeting), boost::asio::use_awaitable);
+                std::array<std::uint8_t, 4> header{};
+                co_await boost::asio::async_read(
+                    sock, boost::asio::buffer(header), boost::asio::use_awaitable);
+                std::vector<std::uint8_t> login(header[0]);
+                co_await boost::asio::async_read(
+                    sock, boost::asio::buffer(login), boost::asio::use_awaitable);
+                // 4 caps + 4 max packet + 1 charset + 23 reserved 뒤 NUL 종료 user
+                seen_user.assign(reinterpret_cast<const char*>(login.data() + 32));
+                EXPECT_EQ(header[3], 1);
+                co_await boost::asio::async_write(
+                    sock, boost::asio::buffer(kOk), boost::asio::use_awaitable);
+            }
+        },
+        boost::asio::detached);
+
+    UpstreamSet set{{{.host = "127.0.0.1", .port = server.local_endpoint().port(), .weight = 1}},
+                    UpstreamSetOptions{.balance = UpstreamBalance::kLeastConnections,
+                                       .dns_refresh = std::chrono::seconds{30},
+                                       .health_interval = std::chrono::milliseconds{50},
+                                       .health_timeout = std::chrono::milliseconds{500},
+                                       .eject_failures = 1,
+                                       .health_user = "probe"},
+                    io_ctx};
+    ASSERT_EQ(set.resolve_initial(), 1U);
+    set.backend(0).record_failure("test");
+    ASSERT_EQ(set.healthy_count(), 0U);
+
+    set.start();
+    for (int i = 0; i < 100 && set.healthy_count() == 0; ++i) {
+        io_ctx.run_for(std::chrono::milliseconds{20});
+    }
+    EXPECT_EQ(set.healthy_count(), 1U);
+    EXPECT_EQ(seen_user, "probe");
+    set.stop();
+}
+
+// ---------------------------------------------------------------------------
+// AdmissionControl: accept 직후 연결 허용 판정
+// 검증 항목:
+//   - 토큰 버킷은 burst 만큼 허용한 뒤 경과 시간에 비례해 보충된다
+//   - pending 슬롯은 handshake_finished 에서, IP 슬롯은 티켓 소멸 시 반환된다
+//   - 거부된 연결은 토큰/슬롯을 소비하지 않는다
+//   - 제한 시간 안에 핸드셰이크가 끝나지 않은 세션은 닫힌다
+// ---------------------------------------------------------------------------
+TEST(AdmissionControlTest, TokenBucketRefillsOverTime) {
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto admission = std::make_shared<AdmissionControl>(
+        AdmissionOptions{.accept_rate = 10, .accept_burst = 2}, t0);
+    const auto ip = boost::asio::ip::make_address("10.0.0.1");
+
+    auto a = admission->try_admit(ip, t0);
+    auto b = admission->try_admit(ip, t0);
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    const auto limited = admission->try_admit(ip, t0);
+    ASSERT_FALSE(limited.has_value());
+    EXPECT_EQ(limited.error(), AdmissionReject::kRateLimited);
+    EXPECT_EQ(admission_reject_name(limited.error()), "rate_limited");
+
+    // 10/s → 100ms 에 토큰 1개, burst(2) 를 넘게 쌓이지 않는다
+    EXPECT_TRUE(admission->try_admit(ip, t0 + std::chrono::milliseconds{100}).has_value());
+    EXPECT_FALSE(admission->try_admit(ip, t0 + std::chrono::milliseconds{100}).has_value());
+    const auto later = t0 + std::chrono::seconds{10};
+    EXPECT_TRUE(admission->try_admit(ip, later).has_value());
+    EXPECT_TRUE(admission->try_admit(ip, later).has_value());
+    EXPECT_FALSE(admission->try_admit(ip, later).has_value());
+}
+
+TEST(AdmissionControlTest, PendingAndPerIpSlotsAreReleased) {
+    const auto admission = std::make_shared<AdmissionControl>(
+        AdmissionOptions{.max_pending_handshakes = 2, .max_connections_per_ip = 2});
+    const auto ip1 = boost::asio::ip::make_address("192.168.1.10");
+    const auto ip1_mapped = boost::asio::ip::make_address("::ffff:192.168.1.10");
+    const auto ip2 = boost::asio::ip::make_address("192.168.1.20");
+
+    auto first = admission->try_admit(ip1);
+    ASSERT_TRUE(first.has_value());
+    auto second = admission->try_admit(ip2);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(admission->pending_handshakes(), 2U);
+
+    const auto pending_full = admission->try_admit(ip2);
+    ASSERT_FALSE(pending_full.has_value());
+    EXPECT_EQ(pending_full.error(), AdmissionReject::kTooManyPendingHandshakes);
+
+    // 핸드셰이크 완료 → pending 반환 (IP 슬롯은 유지)
+    first->handshake_finished();
+    first->handshake_finished();  // 중복 호출 무시
+    second->handshake_finished();
+    EXPECT_EQ(admission->pending_handshakes(), 0U);
+
+    // IPv4 와 v4-mapped IPv6 는 같은 출발지다
+    auto third = admission->try_admit(ip1_mapped);
+    ASSERT_TRUE(third.has_value());
+    const auto per_ip = admission->try_admit(ip1);
+    ASSERT_FALSE(per_ip.has_value());
+    EXPECT_EQ(per_ip.error(), AdmissionReject::kPerIpLimit);
+    EXPECT_EQ(admission->pending_handshakes(), 1U);  // 거부는 슬롯을 차지하지 않는다
+
+    // 티켓 이동 후 소멸 → IP 슬롯 1회만 반환
+    AdmissionTicket moved = std::move(*first);
+    EXPECT_FALSE(static_cast<bool>(*first));
+    {
+        const AdmissionTicket dropped = std::move(moved);
+    }
+    EXPECT_TRUE(admission->try_admit(ip1).has_value());  // 임시 티켓 → 즉시 반환
+    EXPECT_EQ(admission->tracked_sources(), 2U);
+
+    third = AdmissionTicket{};
+    second = AdmissionTicket{};
+    EXPECT_EQ(admission->tracked_sources(), 0U);
+    EXPECT_EQ(admission->pending_handshakes(), 0U);
+}
+
+TEST(AdmissionControlTest, SessionClosedWhenHandshakeTimesOut) {
+    boost::asio::io_context io_ctx;
+    // 업스트림: connect 는 backlog 로 성공하지만 greeting 을 보내지 않는다
+    boost::asio::ip::tcp::acceptor silent_upstream{
+        io_ctx, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    boost::asio::ip::tcp::acceptor front{io_ctx, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    boost::asio::ip::tcp::socket client{io_ctx};
+    client.connect(front.local_endpoint());
+    boost::asio::ip::tcp::socket accepted = front.accept();
+
+    const auto admission = std::make_shared<AdmissionControl>(
+        AdmissionOptions{.handshake_timeout = std::chrono::milliseconds{50}});
+    auto ticket = admission->try_admit(client.local_endpoint().address());
+    ASSERT_TRUE(ticket.has_value());
+    const auto wheel = std::make_shared<TimerWheel>(std::chrono::milliseconds{10});
+
+    auto stats = make_stats();
+    auto session = std::make_shared<Session>(7ULL,
+                                             AsyncStream{std::move(accepted)},
+                                             silent_upstream.local_endpoint(),
+                                             nullptr,
+                                             false,
+                                             "",
+                                             make_policy_engine(),
+                                             make_logger(),
+                                             stats,
+                                             nullptr,
+                                             0,
+                                             false,
+                                             nullptr,
+                                             nullptr,
+                                             UpstreamLease{},
+                                             nullptr,
+                                             std::move(*ticket),
+                                             SessionTimeouts{.wheel = wheel});
+    bool done = false;
+    boost::asio::co_spawn(
+        session->executor(), session->run(), [&done](const std::exception_ptr&) { done = true; });
+    for (int i = 0; i < 100 && !done; ++i) {
+        io_ctx.run_for(std::chrono::milliseconds{20});
+        wheel->advance(std::chrono::steady_clock::now());
+    }
+    ASSERT_TRUE(done);
+    EXPECT_EQ(session->state(), SessionState::kClosed);
+    EXPECT_EQ(stats->snapshot().handshake_timeouts, 1U);
+    EXPECT_EQ(admission->pending_handshakes(), 1U);  // 세션 소멸 시 반환
+    session.reset();
+    EXPECT_EQ(admission->pending_handshakes(), 0U);
+    EXPECT_EQ(wheel->size(), 0U);  // run() 종료 시 남은 타이머 취소
+}
+
+// ---------------------------------------------------------------------------
+// TimerWheel: 세션 유휴 / 핸드셰이크 제한 시간
+// ---------------------------------------------------------------------------
+TEST(TimerWheelTest, FiresOnFirstAdvanceAfterDeadline) {
+    const auto t0 = TimerWheel::Clock::now();
+    TimerWheel wheel{std::chrono::milliseconds{100}, t0};
+    int fired = 0;
+    const auto id = wheel.schedule(t0 + std::chrono::milliseconds{250}, [&fired] { ++fired; });
+    EXPECT_NE(id, 0U);
+    EXPECT_EQ(wheel.size(), 1U);
+
+    EXPECT_EQ(wheel.advance(t0 + std::chrono::milliseconds{200}), 0U);
+    EXPECT_EQ(wheel.advance(t0 + std::chrono::milliseconds{299}), 0U);  // 일찍 실행하지 않음
+    EXPECT_EQ(wheel.advance(t0 + std::chrono::milliseconds{300}), 1U);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(wheel.size(), 0U);
+    EXPECT_FALSE(wheel.cancel(id));  // 이미 실행됨
+}
+
+TEST(TimerWheelTest, CancelledTimerDoesNotFire) {
+    const auto t0 = TimerWheel::Clock::now();
+    TimerWheel wheel{std::chrono::milliseconds{10}, t0};
+    int fired = 0;
+    const auto keep = wheel.schedule(t0 + std::chrono::milliseconds{50}, [&fired] { fired += 1; });
+    const auto drop = wheel.schedule(t0 + std::chrono::milliseconds{50}, [&fired] { fired += 10; });
+    EXPECT_TRUE(wheel.cancel(drop));
+    EXPECT_FALSE(wheel.cancel(drop));
+    EXPECT_FALSE(wheel.cancel(0));
+    EXPECT_EQ(wheel.size(), 1U);
+
+    EXPECT_EQ(wheel.advance(t0 + std::chrono::seconds{1}), 1U);
+    EXPECT_EQ(fired, 1);
+    EXPECT_FALSE(wheel.cancel(keep));
+}
+
+TEST(TimerWheelTest, LongDelaysCascadeAcrossLevels) {
+    // tick 1ms: level 0 = 256ms, level 1 = 약 65.5초, 그 이상은 level 2 에서 내려온다
+    const auto t0 = TimerWheel::Clock::now();
+    TimerWheel wheel{std::chrono::milliseconds{1}, t0};
+    std::vector<int> order;
+    const std::array<std::chrono::milliseconds, 4> delays{
+        std::chrono::milliseconds{70'000},
+        std::chrono::milliseconds{300},
+        std::chrono::milliseconds{5},
+        std::chrono::milliseconds{65'600},
+    };
+    for (std::size_t i = 0; i < delays.size(); ++i) {
+        (void)wheel.schedule(t0 + delays[i], [&order, i] { order.push_back(static_cast<int>(i)); });
+    }
+
+    // 마감 순서대로 직전 tick 에는 실행되지 않고 마감 tick 에 정확히 하나 실행된다
+    for (const std::size_t i : {2U, 1U, 3U, 0U}) {
+        EXPECT_EQ(wheel.advance(t0 + delays[i] - std::chrono::milliseconds{1}), 0U) << i;
+        EXPECT_EQ(wheel.advance(t0 + delays[i]), 1U) << i;
+    }
+    EXPECT_EQ(order, (std::vector<int>{2, 1, 3, 0}));
+    EXPECT_EQ(wheel.size(), 0U);
+}
+
+TEST(TimerWheelTest, PastDeadlineFiresOnNextTick) {
+    const auto t0 = TimerWheel::Clock::now();
+    TimerWheel wheel{std::chrono::milliseconds{10}, t0};
+    wheel.advance(t0 + std::chrono::milliseconds{100});
+    int fired = 0;
+    (void)wheel.schedule(t0, [&fired] { ++fired; });
+    EXPECT_EQ(wheel.advance(t0 + std::chrono::milliseconds{105}), 0U);
+    EXPECT_EQ(wheel.advance(t0 + std::chrono::milliseconds{110}), 1U);
+    EXPECT_EQ(fired, 1);
+}
+
+TEST(SocketOptionsTest, AppliesKeepaliveToSocket) {
+    boost::asio::io_context io_ctx;
+    boost::asio::ip::tcp::socket sock{io_ctx};
+    sock.open(boost::asio::ip::tcp::v4());
+
+    EXPECT_TRUE(apply_tcp_keepalive(sock, TcpKeepalive{}).has_value());  // 아무것도 하지 않음
+    int enabled = 0;
+    socklen_t len = sizeof(enabled);
+    ASSERT_EQ(::getsockopt(sock.native_handle(), SOL_SOCKET, SO_KEEPALIVE, &enabled, &len), 0);
+    EXPECT_EQ(enabled, 0);
+
+    const auto applied = apply_tcp_keepalive(
+        sock,
+        TcpKeepalive{.idle_sec = 60, .interval_sec = 10, .probes = 3, .user_timeout_ms = 5000});
+    EXPECT_TRUE(applied.has_value());
+    ASSERT_EQ(::getsockopt(sock.native_handle(), SOL_SOCKET, SO_KEEPALIVE, &enabled, &len), 0);
+    EXPECT_EQ(enabled, 1);
+}
+
+TEST(SocketOptionsTest, AppliesNoDelayAndBufferSizes) {
+    boost::asio::io_context io_ctx;
+    boost::asio::ip::tcp::socket sock{io_ctx};
+    sock.open(boost::asio::ip::tcp::v4());
+
+    const auto applied = apply_socket_tuning(
+        sock,
+        SocketTuning{.no_delay = true, .recv_buffer_bytes = 65536, .send_buffer_bytes = 65536});
+    ASSERT_TRUE(applied.has_value());
+
+    int value = 0;
+    socklen_t len = sizeof(value);
+    ASSERT_EQ(::getsockopt(sock.native_handle(), IPPROTO_TCP, TCP_NODELAY, &value, &len), 0);
+    EXPECT_NE(value, 0);
+    // 커널은 요청값을 두 배로 잡아 돌려준다 (bookkeeping 포함, rmem_max 이하)
+    ASSERT_EQ(::getsockopt(sock.native_handle(), SOL_SOCKET, SO_RCVBUF, &value, &len), 0);
+    EXPECT_GE(value, 65536);
+
+    // 닫힌 소켓은 건너뛴다
+    boost::asio::ip::tcp::socket closed{io_ctx};
+    EXPECT_TRUE(apply_socket_tuning(closed, SocketTuning{}).has_value());
+}
+
+TEST(SocketOptionsTest, AppliesDeferAcceptToListener) {
+    boost::asio::io_context io_ctx;
+    boost::asio::ip::tcp::acceptor acceptor{io_ctx};
+    acceptor.open(boost::asio::ip::tcp::v4());
+
+    ASSERT_TRUE(
+        apply_listener_tuning(acceptor, ListenerTuning{.recv_buffer_bytes = 131072}).has_value());
+    ASSERT_TRUE(apply_listener_tuning(acceptor, ListenerTuning{.defer_accept_sec = 2}).has_value());
+    int defer = 0;
+    socklen_t len = sizeof(defer);
+    ASSERT_EQ(
+        ::getsockopt(acceptor.native_handle(), IPPROTO_TCP, TCP_DEFER_ACCEPT, &defer, &len), 0);
+    EXPECT_GT(defer, 0);  // 커널은 재전송 횟수로 올림해 돌려준다
+
+    acceptor.bind({boost::asio::ip::make_address("127.0.0.1"), 0});
+    acceptor.listen();
+    EXPECT_NE(acceptor.local_endpoint().port(), 0);
+}
+
+// ---------------------------------------------------------------------------
+// BackendPool: 인증된 서버 연결 재사용
+// 검증 항목:
+//   - 키가 같아야 적중하고, 적중/미적중/유휴 수가 StatsCollector 에 기록된다
+//   - 키당 / 전체 상한을 넘는 반납은 거부된다 (호출자가 연결을 닫음)
+//   - 유휴 타임아웃을 넘기거나 원격이 닫은 연결은 반출하지 않는다
+// ---------------------------------------------------------------------------
+namespace {
+
+// 루프백으로 연결된 소켓 쌍: local 은 풀에 넣을 "서버 연결", remote 는 MySQL 서버 역할
+struct LoopbackPair {
+    boost::asio::ip::tcp::socket local;
+    boost::asio::ip::tcp::socket remote;
+};
+
+LoopbackPair make_loopback_pair(boost::asio::io_context& io_ctx) {
+    boost::asio::ip::tcp::acceptor acceptor{
+        io_ctx, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    boost::asio::ip::tcp::socket local{io_ctx};
+    local.connect(acceptor.local_endpoint());
+    boost::asio::ip::tcp::socket remote = acceptor.accept();
+    return LoopbackPair{std::move(local), std::move(remote)};
+}
+
+BackendPoolKey pool_key(const std::string& user) {
+    return BackendPoolKey{.db_user = user,
+                          .db_name = "appdb",
+                          .capability_flags = 0x000FA685U,
+                          .backend_tls = false,
+                          .endpoint = {boost::asio::ip::make_address("127.0.0.1"), 3306}};
+}
+
+PooledBackend pooled(boost::asio::ip::tcp::socket sock, std::chrono::steady_clock::time_point at) {
+    return PooledBackend{
+        .stream = AsyncStream{std::move(sock)}, .capability_flags = 0x000FA685U, .idle_since = at};
+}
+
+}  // namespace
+
+TEST(BackendPoolTest, ReleaseThenAcquireSameKeyIsHit) {
+    boost::asio::io_context io_ctx;
+    auto stats = std::make_shared<StatsCollector>();
+    BackendPool pool{4, 2, std::chrono::seconds{60}, stats};
+    const auto now = std::chrono::steady_clock::now();
+
+    auto pair = make_loopback_pair(io_ctx);
+    EXPECT_TRUE(pool.release(pool_key("alice"), pooled(std::move(pair.local), now)));
+    EXPECT_EQ(pool.idle_count(), 1U);
+    EXPECT_EQ(stats->snapshot().pool_idle, 1U);
+
+    auto backend = pool.acquire(pool_key("alice"), now);
+    ASSERT_TRUE(backend.has_value());
+    EXPECT_EQ(backend->capability_flags, 0x000FA685U);
+    EXPECT_TRUE(backend->stream.lowest_layer().is_open());
+
+    const auto snap = stats->snapshot();
+    EXPECT_EQ(snap.pool_hits, 1U);
+    EXPECT_EQ(snap.pool_misses, 0U);
+    EXPECT_EQ(snap.pool_idle, 0U);
+}
+
+TEST(BackendPoolTest, DifferentKeyIsMiss) {
+    boost::asio::io_context io_ctx;
+    auto stats = std::make_shared<StatsCollector>();
+    BackendPool pool{4, 2, std::chrono::seconds{60}, stats};
+    const auto now = std::chrono::steady_clock::now();
+
+    auto pair = make_loopback_pair(io_ctx);
+    ASSERT_TRUE(pool.release(pool_key("alice"), pooled(std::move(pair.local), now)));
+
+    EXPECT_FALSE(pool.acquire(pool_key("bob"), now).has_value());
+    auto tls_key = pool_key("alice");
+    tls_key.backend_tls = true;
+    EXPECT_FALSE(pool.acquire(tls_key, now).has_value());
+
+    EXPECT_EQ(stats->snapshot().pool_misses, 2U);
+    EXPECT_EQ(pool.idle_count(), 1U);
+}
+
+TEST(BackendPoolTest, ReleaseBeyondLimitsIsRejected) {
+    boost::asio::io_context io_ctx;
+    auto stats = std::make_shared<StatsCollector>();
+    BackendPool pool{2, 1, std::chrono::seconds{60}, stats};
+    const auto now = std::chrono::steady_clock::now();
+
+    auto a = make_loopback_pair(io_ctx);
+    auto b = make_loopback_pair(io_ctx);
+    auto c = make_loopback_pair(io_ctx);
+    auto d = make_loopback_pair(io_ctx);
+    EXPECT_TRUE(pool.release(pool_key("alice"), pooled(std::move(a.local), now)));
+    // 키당 상한 1
+    EXPECT_FALSE(pool.release(pool_key("alice"), pooled(std::move(b.local), now)));
+    EXPECT_TRUE(pool.release(pool_key("bob"), pooled(std::move(c.local), now)));
+    // 전체 상한 2
+    EXPECT_FALSE(pool.release(pool_key("carol"), pooled(std::move(d.local), now)));
+
+    EXPECT_EQ(pool.idle_count(), 2U);
+    EXPECT_EQ(stats->snapshot().pool_evictions, 2U);
+}
+
+TEST(BackendPoolTest, ExpiredConnectionIsNotReused) {
+    boost::asio::io_context io_ctx;
+    auto stats = std::make_shared<StatsCollector>();
+    BackendPool pool{4, 2, std::chrono::seconds{60}, stats};
+    const auto now = std::chrono::steady_clock::now();
+
+    auto pair = make_loopback_pair(io_ctx);
+    ASSERT_TRUE(pool.release(pool_key("alice"), pooled(std::move(pair.local), now)));
+
+    EXPECT_FALSE(pool.acquire(pool_key("alice"), now + std::chrono::seconds{61}).has_value());
+    EXPECT_EQ(pool.idle_count(), 0U);
+    EXPECT_EQ(stats->snapshot().pool_evictions, 1U);
+}
+
+TEST(BackendPoolTest, EvictExpiredClosesOnlyStaleConnections) {
+    boost::asio::io_context io_ctx;
+    auto stats = std::make_shared<StatsCollector>();
+    BackendPool pool{4, 2, std::chrono::seconds{60}, stats};
+    const auto now = std::chrono::steady_clock::now();
+
+    auto old_pair = make_loopback_pair(io_ctx);
+    auto new_pair = make_loopback_pair(io_ctx);
+    ASSERT_TRUE(pool.release(pool_key("alice"),
+                             pooled(std::move(old_pair.local), now - std::chrono::seconds{90})));
+    ASSERT_TRUE(pool.release(pool_key("bob"), pooled(std::move(new_pair.local), now)));
+
+    EXPECT_EQ(pool.evict_expired(now), 1U);
+    EXPECT_EQ(pool.idle_count(), 1U);
+    EXPECT_EQ(stats->snapshot().pool_idle, 1U);
+    EXPECT_TRUE(pool.acquire(pool_key("bob"), now).has_value());
+}
+
+TEST(BackendPoolTest, PeerClosedConnectionIsSkipped) {
+    boost::asio::io_context io_ctx;
+    auto stats = std::make_shared<StatsCollector>();
+    BackendPool pool{4, 2, std::chrono::seconds{60}, stats};
+    const auto now = std::chrono::steady_clock::now();
+
+    auto pair = make_loopback_pair(io_ctx);
+    ASSERT_TRUE(pool.release(pool_key("alice"), pooled(std::move(pair.local), now)));
+    // 서버 측이 연결을 닫음 (wait_timeout 등)
+    pair.remote.close();
+
+    EXPECT_FALSE(pool.acquire(pool_key("alice"), now).has_value());
+    EXPECT_EQ(stats->snapshot().pool_evictions, 1U);
+}
+
+TEST(BackendPoolTest, GreetingTemplateIsStored) {
+    BackendPool pool{4, 2, std::chrono::seconds{60}, nullptr};
+    EXPECT_TRUE(pool.greeting_template().empty());
+    pool.set_greeting_template({0x01, 0x00, 0x00, 0x00, 0x0A});
+    EXPECT_EQ(pool.greeting_template().size(), 5U);
+}
+
+// ---------------------------------------------------------------------------
+// ResponsePipeline 테스트 (커맨드 파이프라이닝 in-flight 큐)
+//
+// 검증 항목:
+//   - 응답은 push 순서대로 소비되고, in-flight 가 depth 에 도달하면 생산자가 대기한다
+//   - 소비자 실패 시 대기 중인 생산자는 false 를 받는다 (fail-close)
+//   - stop() 후 남은 응답을 모두 소비한 뒤 소비자가 종료한다
+// ---------------------------------------------------------------------------
+TEST(ResponsePipelineTest, DepthIsClampedAndZeroDisables) {
+    boost::asio::io_context io_ctx;
+    const ResponsePipeline off{io_ctx.get_executor(), 0};
+    const ResponsePipeline big{io_ctx.get_executor(), 1000};
+    EXPECT_FALSE(off.enabled());
+    EXPECT_TRUE(big.enabled());
+    EXPECT_EQ(big.depth(), ResponsePipeline::kMaxDepth);
+}
+
+TEST(ResponsePipelineTest, ProducerBlocksAtDepthAndConsumerPreservesOrder) {
+    boost::asio::io_context io_ctx;
+    ResponsePipeline pipeline{io_ctx.get_executor(), 2};
+    std::vector<std::uint8_t> consumed;
+    std::size_t max_in_flight = 0;
+    bool producer_done = false;
+
+    boost::asio::co_spawn(
+        io_ctx,
+        [&]() -> boost::asio::awaitable<void> {
+            for (std::uint8_t seq = 0; seq < 5; ++seq) {
+                EXPECT_TRUE(co_await pipeline.acquire_slot());
+                pipeline.push(PendingResponse{.command_type = CommandType::kComQuery,
+                                              .sequence_id = seq});
+                max_in_flight = std::max(max_in_flight, pipeline.size());
+            }
+            EXPECT_TRUE(co_await pipeline.drain());
+            pipeline.stop();
+            co_await pipeline.wait_consumer_done();
+            producer_done = true;
+        },
+        boost::asio::detached);
+
+    boost::asio::co_spawn(
+        io_ctx,
+        [&]() -> boost::asio::awaitable<void> {
+            while (PendingResponse* const next = co_await pipeline.next()) {
+                consumed.push_back(next->sequence_id);
+                // 릴레이가 끝나기 전 다른 코루틴이 실행될 기회를 준다
+                boost::asio::steady_timer yield{io_ctx, std::chrono::milliseconds{1}};
+                co_await yield.async_wait(boost::asio::use_awaitable);
+                pipeline.complete();
+            }
+            pipeline.finish();
+        },
+        boost::asio::detached);
+
+    io_ctx.run_for(std::chrono::seconds{5});
+    EXPECT_TRUE(producer_done);
+    EXPECT_EQ(consumed, (std::vector<std::uint8_t>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(max_in_flight, 2U);
+    EXPECT_TRUE(pipeline.empty());
+}
+
+TEST(ResponsePipelineTest, ConsumerFailureReleasesWaitingProducer) {
+    boost::asio::io_context io_ctx;
+    ResponsePipeline pipeline{io_ctx.get_executor(), 1};
+    std::optional<bool> second_slot;
+
+    boost::asio::co_spawn(
+        io_ctx,
+        [&]() -> boost::asio::awaitable<void> {
+            EXPECT_TRUE(co_await pipeline.acquire_slot());
+            pipeline.push(PendingResponse{.command_type = CommandType::kComQuery});
+            second_slot = co_await pipeline.acquire_slot();  // 가득 참 → 실패로 깨어남
+        },
+        boost::asio::detached);
+
+    boost::asio::co_spawn(
+        io_ctx,
+        [&]() -> boost::asio::awaitable<void> {
+            EXPECT_NE(co_await pipeline.next(), nullptr);
+            pipeline.fail();
+            EXPECT_EQ(co_await pipeline.next(), nullptr);
+            pipeline.finish();
+        },
+        boost::asio::detached);
+
+    io_ctx.run_for(std::chrono::seconds{5});
+    ASSERT_TRUE(second_slot.has_value());
+    EXPECT_FALSE(*second_slot);
+    EXPECT_TRUE(pipeline.failed());
+    EXPECT_TRUE(pipeline.empty());
+}
+
+// ---------------------------------------------------------------------------
+// SplicePipe / splice_bytes: 큰 응답 패킷 본문의 커널 내 전달
+// ---------------------------------------------------------------------------
+
+TEST(SocketSpliceTest, MovesExactByteCountAndLeavesTrailingBytes) {
+    boost::asio::io_context io_ctx;
+    auto upstream = make_loopback_pair(io_ctx);  // local: 서버 역할, remote: 프록시 수신
+    auto client = make_loopback_pair(io_ctx);    // local: 프록시 송신, remote: 클라이언트
+
+    SplicePipe pipe;
+    if (!pipe.open()) {
+        GTEST_SKIP() << "splice(2) is not available on this platform";
+    }
+
+    constexpr std::size_t kBody = 300U * 1024U;  // 파이프 용량보다 큼 → 여러 번 splice
+    std::vector<std::uint8_t> sent(kBody + 5);
+    for (std::size_t i = 0; i < sent.size(); ++i) {
+        sent[i] = static_cast<std::uint8_t>(i * 31U);
+    }
+    std::vector<std::uint8_t> received(kBody);
+    std::vector<std::uint8_t> trailing(5);
+    bool spliced = false;
+    bool read_done = false;
+
+    boost::asio::co_spawn(
+        io_ctx,
+        [&]() -> boost::asio::awaitable<void> {
+            co_await boost::asio::async_write(
+                upstream.local, boost::asio::buffer(sent), boost::asio::use_awaitable);
+        },
+        boost::asio::detached);
+    boost::asio::co_spawn(
+        io_ctx,
+        [&]() -> boost::asio::awaitable<void> {
+            auto result = co_await splice_bytes(upstream.remote, client.local, pipe, kBody);
+            spliced = result.has_value();
+            // 다음 패킷 바이트는 splice 되지 않고 소켓에 남아 있어야 한다
+            co_await boost::asio::async_read(
+                upstream.remote, boost::asio::buffer(trailing), boost::asio::use_awaitable);
+        },
+        boost::asio::detached);
+    boost::asio::co_spawn(
+        io_ctx,
+        [&]() -> boost::asio::awaitable<void> {
+            co_await boost::asio::async_read(
+                client.remote, boost::asio::buffer(received), boost::asio::use_awaitable);
+            read_done = true;
+        },
+        boost::asio::detached);
+
+    io_ctx.run_for(std::chrono::seconds{5});
+    EXPECT_TRUE(spliced);
+    ASSERT_TRUE(read_done);
+    EXPECT_TRUE(std::equal(received.begin(), received.end(), sent.begin()));
+    EXPECT_TRUE(std::equal(trailing.begin(), trailing.end(), sent.begin() + kBody));
+}
+
+TEST(SocketSpliceTest, PeerCloseBeforeCountIsError) {
+    boost::asio::io_context io_ctx;
+    auto upstream = make_loopback_pair(io_ctx);
+    auto client = make_loopback_pair(io_ctx);
+
+    SplicePipe pipe;
+    if (!pipe.open()) {
+        GTEST_SKIP() << "splice(2) is not available on this platform";
+    }
+
+    const std::vector<std::uint8_t> partial(100, 0xAB);
+    std::optional<ParseErrorCode> error;
+
+    boost::asio::co_spawn(
+        io_ctx,
+        [&]() -> boost::asio::awaitable<void> {
+            co_await boost::asio::async_write(
+                upstream.local, boost::asio::buffer(partial), boost::asio::use_awaitable);
+            upstream.local.close();
+        },
+        boost::asio::detached);
+    boost::asio::co_spawn(
+        io_ctx,
+        [&]() -> boost::asio::awaitable<void> {
+            auto result = co_await splice_bytes(upstream.remote, client.local, pipe, 1000);
+            if (!result) {
+                error = result.error().code;
+            }
+        },
+        boost::asio::detached);
+
+    io_ctx.run_for(std::chrono::seconds{5});
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(*error, ParseErrorCode::kMalformedPacket);
+}
+
+// ---------------------------------------------------------------------------
+// Session 응답 릴레이: data_protection.max_result_rows
+//   벤치마크용 가짜 백엔드 (benchmarks/loadgen) 를 루프백에 띄우고 Session 을 실제로 돌린다.
+//   - error: 한도까지의 row 뒤 ERR 1104, truncate: 한도까지의 row 뒤 EOF (MORE_RESULTS 없음)
+//   - 한도를 넘긴 응답 뒤에도 다음 커맨드가 자기 응답을 받는다 (서버 연결 desync 없음)
+//   - kStreamThreshold 를 넘는 row, CALL 의 다중 결과 셋도 응답 끝까지 버린다
+// ---------------------------------------------------------------------------
+namespace {
+
+using Payloads = std::vector<std::vector<std::uint8_t>>;
+
+std::shared_ptr<PolicyEngine> make_row_limit_policy(std::uint32_t max_rows, std::string action) {
+    auto cfg = std::make_shared<PolicyConfig>();
+    AccessRule rule{};
+    rule.user = "dbgate";
+    rule.source_ip_cidr = "127.0.0.1/32";
+    rule.allowed_tables = {"*"};
+    rule.allowed_operations = {"SELECT", "CALL"};
+    cfg->access_control.push_back(rule);
+    cfg->procedure_control.mode = "blacklist";  // 빈 블랙리스트: CALL 허용
+    cfg->data_protection.max_result_rows = max_rows;
+    cfg->data_protection.max_result_rows_action = std::move(action);
+    return std::make_shared<PolicyEngine>(cfg);
+}
+
+// 열이 많은 결과 셋 (column count 가 0xFC lenenc). row 의 cell 은 모두 빈 문자열 (0x00)
+//   이라 column count 를 잘못 읽으면 row 가 final OK 처럼 보인다.
+std::vector<std::uint8_t> make_wide_result_set(std::uint16_t columns,
+                                               std::size_t rows,
+                                               std::uint8_t first_seq,
+                                               std::uint16_t status) {
+    std::vector<std::uint8_t> wire;
+    auto seq = first_seq;
+    loadgen::append_packet(wire,
+                           seq++,
+                           std::array<std::uint8_t, 3>{0xFC,
+                                                       static_cast<std::uint8_t>(columns & 0xFFU),
+                                                       static_cast<std::uint8_t>(columns >> 8U)});
+    // column definition: catalog "def" + 빈 이름 5개 + 고정 필드 (릴레이는 내용을 보지 않는다)
+    const std::array<std::uint8_t, 22> column_def{
+        3, 'd', 'e', 'f', 0, 0, 0, 0, 0, 0x0C, 0x21, 0, 0xFF, 0, 0, 0, 0xFD, 0, 0, 0, 0, 0};
+    for (std::uint16_t i = 0; i < columns; ++i) {
+        loadgen::append_packet(wire, seq++, column_def);
+    }
+    const std::array<std::uint8_t, 5> eof{0xFE,
+                                          0,
+                                          0,
+                                          static_cast<std::uint8_t>(status & 0xFFU),
+                                          static_cast<std::uint8_t>(status >> 8U)};
+    loadgen::append_packet(wire, seq++, eof);
+    const std::vector<std::uint8_t> row(columns, 0x00);
+    for (std::size_t i = 0; i < rows; ++i) {
+        loadgen::append_packet(wire, seq++, row);
+    }
+    loadgen::append_packet(wire, seq++, eof);
+    return wire;
+}
+
+// SQL 별 가짜 백엔드 응답
+//   big / small: 단일 결과 셋, rows / row_bytes 는 SQL 의 테이블 이름으로 고른다
+//   CALL sp_rows: 결과 셋 2개 (각 status 에 MORE_RESULTS) + final OK
+//   CALL sp_wide: 결과 셋 뒤 300 열 결과 셋 (MORE_RESULTS) + final OK
+std::vector<std::uint8_t> scripted_reply(std::string_view sql) {
+    constexpr std::uint16_t kMore =
+        loadgen::kServerStatusAutocommit | loadgen::kServerMoreResultsExists;
+    if (sql == "SELECT * FROM ten_rows") {
+        return loadgen::make_result_set(10, 8);
+    }
+    if (sql == "SELECT * FROM huge_rows") {
+        return loadgen::make_result_set(4, 200U * 1024U);
+    }
+    if (sql == "CALL sp_rows()") {
+        auto wire = loadgen::make_result_set(5, 8, 1, kMore);           // seq 1..10
+        const auto second = loadgen::make_result_set(1, 8, 11, kMore);  // seq 11..16
+        const auto done = loadgen::make_ok(17);
+        wire.insert(wire.end(), second.begin(), second.end());
+        wire.insert(wire.end(), done.begin(), done.end());
+        return wire;
+    }
+    if (sql == "CALL sp_wide()") {
+        auto wire = loadgen::make_result_set(5, 8, 1, kMore);  // seq 1..10
+        const auto wide = make_wide_result_set(300, 2, 11, kMore);
+        // column count + column-def 300 + EOF + row 2 + EOF 뒤 (seq 는 256 에서 돈다)
+        const auto done = loadgen::make_ok(static_cast<std::uint8_t>(11 + 1 + 300 + 1 + 2 + 1));
+        wire.insert(wire.end(), wide.begin(), wide.end());
+        wire.insert(wire.end(), done.begin(), done.end());
+        return wire;
+    }
+    return loadgen::make_result_set(2, 3);  // SELECT * FROM two_rows
+}
+
+// 가짜 백엔드 + 투명 모드 Session 하나, 클라이언트는 같은 io_context 의 코루틴
+struct RowLimitRelay {
+    RowLimitRelay(std::uint32_t max_rows, std::string action)
+        : backend{io_ctx, loadgen::BackendOptions{.on_query = scripted_reply}} {
+        backend.start();
+        boost::asio::ip::tcp::acceptor front{io_ctx,
+                                             {boost::asio::ip::make_address("127.0.0.1"), 0}};
+        boost::asio::ip::tcp::socket socket{io_ctx};
+        socket.connect(front.local_endpoint());
+        session = std::make_shared<Session>(
+            1ULL,
+            AsyncStream{front.accept()},
+            boost::asio::ip::tcp::endpoint{boost::asio::ip::make_address("127.0.0.1"),
+                                           backend.port()},
+            nullptr,
+            false,
+            "",
+            make_row_limit_policy(max_rows, std::move(action)),
+            make_logger(),
+            stats);
+        client.emplace(std::move(socket));
+        boost::asio::co_spawn(session->executor(), session->run(), boost::asio::detached);
+    }
+
+    RowLimitRelay(const RowLimitRelay&) = delete;
+    RowLimitRelay& operator=(const RowLimitRelay&) = delete;
+    RowLimitRelay(RowLimitRelay&&) = delete;
+    RowLimitRelay& operator=(RowLimitRelay&&) = delete;
+
+    ~RowLimitRelay() {
+        close_client();  // 세션 종료 → 서버 연결 종료
+        backend.stop();
+        io_ctx.run_for(std::chrono::seconds{1});
+    }
+
+    void close_client() {
+        boost::system::error_code ec;
+        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+        client->lowest_layer().close(ec);
+    }
+
+    // script 를 실행한다. 5초 안에 끝나지 않으면 클라이언트를 닫아 끝까지 풀고 false.
+    template <typename Script>
+    bool run(Script script) {
+        bool done = false;
+        boost::asio::co_spawn(
+            io_ctx, script(), [&done](const std::exception_ptr&) { done = true; });
+        for (int i = 0; i < 250 && !done; ++i) {
+            io_ctx.run_for(std::chrono::milliseconds{20});
+        }
+        if (done) {
+            return true;
+        }
+        close_client();
+        while (!done) {
+            io_ctx.run_for(std::chrono::milliseconds{20});
+        }
+        return false;
+    }
+
+    auto login() -> boost::asio::awaitable<bool> {
+        if (!co_await loadgen::fill_packet(*client, rx)) {
+            co_return false;
+        }
+        rx.consume(rx.peek(0)->raw().size());  // greeting
+        if (!co_await loadgen::write_all(*client,
+                                         loadgen::make_handshake_response("dbgate", "appdb")) ||
+            !co_await loadgen::fill_packet(*client, rx)) {
+            co_return false;
+        }
+        const auto reply = *rx.peek(0);
+        const bool ok = !reply.payload().empty() && reply.payload()[0] == 0x00;
+        rx.consume(reply.raw().size());
+        co_return ok;
+    }
+
+    // 쿼리를 보내고 응답 패킷 count 개의 payload 를 받는다 (끊기면 받은 만큼만)
+    auto query(std::string_view sql, std::size_t count) -> boost::asio::awaitable<Payloads> {
+        Payloads packets;
+        if (!co_await loadgen::write_all(*client, loadgen::make_query(sql))) {
+            co_return packets;
+        }
+        while (packets.size() < count) {
+            if (!co_await loadgen::fill_packet(*client, rx)) {
+                break;
+            }
+            const auto pkt = *rx.peek(0);
+            packets.emplace_back(pkt.payload().begin(), pkt.payload().end());
+            rx.consume(pkt.raw().size());
+        }
+        co_return packets;
+    }
+
+    boost::asio::io_context io_ctx;
+    loadgen::FakeMysqlBackend backend;
+    std::shared_ptr<StatsCollector> stats = make_stats();
+    std::shared_ptr<Session> session;
+    std::optional<AsyncStream> client;
+    PacketFrameBuffer rx;
+};
+
+bool is_eof(const std::vector<std::uint8_t>& payload) {
+    return !payload.empty() && payload[0] == 0xFE && payload.size() < 9;
+}
+
+std::uint16_t status_flags(const std::vector<std::uint8_t>& eof) {
+    return static_cast<std::uint16_t>(eof[3] | (static_cast<unsigned>(eof[4]) << 8U));
+}
+
+std::uint16_t error_code(const std::vector<std::uint8_t>& err) {
+    return static_cast<std::uint16_t>(err[1] | (static_cast<unsigned>(err[2]) << 8U));
+}
+
+// 결과 셋 하나 (column count 2, column def 2, EOF, rows, EOF) 의 패킷 수
+constexpr std::size_t result_set_packets(std::size_t rows) {
+    return rows + 5;
+}
+
+}  // namespace
+
+TEST(SessionRowLimitTest, ErrorModeSendsErr1104AndNextCommandIsInSync) {
+    RowLimitRelay relay{3, "error"};
+    Payloads limited;
+    Payloads next;
+    ASSERT_TRUE(relay.run([&]() -> boost::asio::awaitable<void> {
+        EXPECT_TRUE(co_await relay.login());
+        limited = co_await relay.query("SELECT * FROM ten_rows", 4 + 3 + 1);
+        next = co_await relay.query("SELECT * FROM two_rows", result_set_packets(2));
+    }));
+
+    ASSERT_EQ(limited.size(), 8U);
+    EXPECT_TRUE(is_eof(limited[3]));
+    ASSERT_EQ(limited[7].at(0), 0xFF);
+    EXPECT_EQ(error_code(limited[7]), 1104);
+
+    ASSERT_EQ(next.size(), result_set_packets(2));
+    EXPECT_EQ(next[0], (std::vector<std::uint8_t>{2}));
+    EXPECT_EQ(next[4].size(), 1U + 1U + 1U + 3U);  // "0" + "xxx" (ten_rows 의 row 가 아님)
+    EXPECT_TRUE(is_eof(next.back()));
+    EXPECT_TRUE(relay.rx.readable().empty());
+    EXPECT_EQ(relay.stats->snapshot().result_rows_limited, 1U);
+}
+
+TEST(SessionRowLimitTest, TruncateModeEndsWithEofAndNextCommandIsInSync) {
+    RowLimitRelay relay{3, "truncate"};
+    Payloads limited;
+    Payloads next;
+    ASSERT_TRUE(relay.run([&]() -> boost::asio::awaitable<void> {
+        EXPECT_TRUE(co_await relay.login());
+        limited = co_await relay.query("SELECT * FROM ten_rows", result_set_packets(3));
+        next = co_await relay.query("SELECT * FROM two_rows", result_set_packets(2));
+    }));
+
+    ASSERT_EQ(limited.size(), result_set_packets(3));
+    ASSERT_TRUE(is_eof(limited.back()));
+    EXPECT_EQ(status_flags(limited.back()), loadgen::kServerStatusAutocommit);
+
+    ASSERT_EQ(next.size(), result_set_packets(2));
+    EXPECT_EQ(next[4].size(), 1U + 1U + 1U + 3U);
+    EXPECT_TRUE(is_eof(next.back()));
+    EXPECT_TRUE(relay.rx.readable().empty());
+    EXPECT_EQ(relay.stats->snapshot().result_rows_limited, 1U);
+}
+
+TEST(SessionRowLimitTest, RowsLargerThanStreamThresholdAreDiscarded) {
+    RowLimitRelay relay{2, "error"};
+    Payloads limited;
+    Payloads next;
+    ASSERT_TRUE(relay.run([&]() -> boost::asio::awaitable<void> {
+        EXPECT_TRUE(co_await relay.login());
+        limited = co_await relay.query("SELECT * FROM huge_rows", 4 + 2 + 1);
+        next = co_await relay.query("SELECT * FROM two_rows", result_set_packets(2));
+    }));
+
+    ASSERT_EQ(limited.size(), 7U);
+    EXPECT_GT(limited[4].size(), 200U * 1024U);  // 한도 안의 큰 row 는 그대로 전달
+    EXPECT_GT(limited[5].size(), 200U * 1024U);
+    ASSERT_EQ(limited[6].at(0), 0xFF);
+    EXPECT_EQ(error_code(limited[6]), 1104);
+
+    ASSERT_EQ(next.size(), result_set_packets(2));
+    EXPECT_EQ(next[4].size(), 1U + 1U + 1U + 3U);
+    EXPECT_TRUE(relay.rx.readable().empty());
+}
+
+TEST(SessionRowLimitTest, MultiResultCallIsRelayedAndDiscardedToTheEnd) {
+    // 한도 안: 두 결과 셋과 final OK 가 한 응답으로 모두 전달된다
+    {
+        RowLimitRelay relay{5, "truncate"};
+        Payloads reply;
+        Payloads next;
+        ASSERT_TRUE(relay.run([&]() -> boost::asio::awaitable<void> {
+            EXPECT_TRUE(co_await relay.login());
+            reply = co_await relay.query("CALL sp_rows()",
+                                         result_set_packets(5) + result_set_packets(1) + 1);
+            next = co_await relay.query("SELECT * FROM two_rows", result_set_packets(2));
+        }));
+        ASSERT_EQ(reply.size(), result_set_packets(5) + result_set_packets(1) + 1);
+        EXPECT_NE(status_flags(reply[result_set_packets(5) - 1]) &
+                      loadgen::kServerMoreResultsExists,
+                  0);
+        EXPECT_EQ(reply.back().at(0), 0x00);
+        ASSERT_EQ(next.size(), result_set_packets(2));
+        EXPECT_EQ(next[4].size(), 1U + 1U + 1U + 3U);
+        EXPECT_EQ(relay.stats->snapshot().result_rows_limited, 0U);
+    }
+
+    // 한도 초과: 첫 결과 셋을 EOF (MORE_RESULTS 없음) 로 끝내고 나머지 결과 셋 / OK 는 버린다
+    RowLimitRelay relay{2, "truncate"};
+    Payloads limited;
+    Payloads next;
+    ASSERT_TRUE(relay.run([&]() -> boost::asio::awaitable<void> {
+        EXPECT_TRUE(co_await relay.login());
+        limited = co_await relay.query("CALL sp_rows()", result_set_packets(2));
+        next = co_await relay.query("SELECT * FROM two_rows", result_set_packets(2));
+    }));
+
+    ASSERT_EQ(limited.size(), result_set_packets(2));
+    ASSERT_TRUE(is_eof(limited.back()));
+    EXPECT_EQ(status_flags(limited.back()) & loadgen::kServerMoreResultsExists, 0);
+
+    ASSERT_EQ(next.size(), result_set_packets(2));
+    EXPECT_EQ(next[0], (std::vector<std::uint8_t>{2}));
+    EXPECT_EQ(next[4].size(), 1U + 1U + 1U + 3U);
+    EXPECT_TRUE(is_eof(next.back()));
+    EXPECT_TRUE(relay.rx.readable().empty());
+    EXPECT_EQ(relay.stats->snapshot().result_rows_limited, 1U);
+}
+
+TEST(SessionRowLimitTest, DiscardDecodesLenencColumnCountOfNextResult) {
+    // 뒤따르는 결과 셋의 column count 가 0xFC lenenc (300 열) — 첫 바이트를 열 수로 쓰면
+    // 빈 cell 로 된 row 를 final OK 로 보고 버리기를 멈춰 나머지가 다음 응답에 섞인다
+    RowLimitRelay relay{2, "truncate"};
+    Payloads limited;
+    Payloads next;
+    ASSERT_TRUE(relay.run([&]() -> boost::asio::awaitable<void> {
+        EXPECT_TRUE(co_await relay.login());
+        limited = co_await relay.query("CALL sp_wide()", result_set_packets(2));
+        next = co_await relay.query("SELECT * FROM two_rows", result_set_packets(2));
+    }));
+
+    ASSERT_EQ(limited.size(), result_set_packets(2));
+    ASSERT_TRUE(is_eof(limited.back()));
+    ASSERT_EQ(next.size(), result_set_packets(2));
+    EXPECT_EQ(next[0], (std::vector<std::uint8_t>{2}));
+    EXPECT_EQ(next[4].size(), 1U + 1U + 1U + 3U);
+    EXPECT_TRUE(is_eof(next.back()));
+    EXPECT_TRUE(relay.rx.readable().empty());
+    EXPECT_EQ(relay.stats->snapshot().result_rows_limited, 1U);
+}
+
+// ---------------------------------------------------------------------------
+// ProxyServer 멀티스레드: io_context 를 여러 스레드가 run() 하는 중 세션 열기/닫기 + stop()
+//   - 연결을 유지하는 세션은 sessions_ 에 남고, 끊긴 세션은 완료 콜백에서 erase 된다
+//   - 접속이 계속 들어오는 중에 stop() 해도 모든 세션이 닫히고 io_context 가 멈춘다
+//   스레드 간 공유 상태는 atomic 과 ProxyServer 의 mutex 로만 접근한다 (TSan / ASan 대상).
+// ---------------------------------------------------------------------------
+namespace {
+
+constexpr std::size_t kIoThreads = 4;
+constexpr std::size_t kClientThreads = 2;
+constexpr std::size_t kHeldClients = 8;
+constexpr std::size_t kChurnClients = 6;
+
+std::uint16_t free_loopback_port() {
+    boost::asio::io_context io_ctx;
+    const boost::asio::ip::tcp::acceptor probe{io_ctx,
+                                               {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    return probe.local_endpoint().port();
+}
+
+template <typename Pred>
+bool wait_until(Pred pred, std::chrono::milliseconds timeout = std::chrono::seconds{10}) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+    return true;
+}
+
+// accept_loop 가 리스너를 열 때까지 접속을 재시도한다 (확인용 연결은 바로 닫는다)
+bool wait_for_listener(const boost::asio::ip::tcp::endpoint& target) {
+    boost::asio::io_context io_ctx;
+    return wait_until([&] {
+        boost::asio::ip::tcp::socket socket{io_ctx};
+        boost::system::error_code ec;
+        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+        socket.connect(target, ec);
+        return !ec;
+    });
+}
+
+// 접속 → greeting → HandshakeResponse → OK. 실패하면 nullopt
+auto open_session(boost::asio::ip::tcp::endpoint target, PacketFrameBuffer& rx)
+    -> boost::asio::awaitable<std::optional<AsyncStream>> {
+    boost::asio::ip::tcp::socket socket{co_await boost::asio::this_coro::executor};
+    boost::system::error_code ec;
+    co_await socket.async_connect(target,
+                                  boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return std::nullopt;
+    }
+    AsyncStream stream{std::move(socket)};
+    if (!co_await loadgen::fill_packet(stream, rx)) {
+        co_return std::nullopt;
+    }
+    rx.consume(rx.peek(0)->raw().size());  // greeting
+    if (!co_await loadgen::write_all(stream, loadgen::make_handshake_response("dbgate", "appdb"))) {
+        co_return std::nullopt;
+    }
+    if (!co_await loadgen::fill_packet(stream, rx)) {
+        co_return std::nullopt;
+    }
+    const auto reply = *rx.peek(0);
+    const bool ok = !reply.payload().empty() && reply.payload()[0] == 0x00;
+    rx.consume(reply.raw().size());
+    if (!ok) {
+        co_return std::nullopt;
+    }
+    co_return std::optional<AsyncStream>{std::move(stream)};
+}
+
+struct ClientCounters {
+    std::atomic<bool> stop_churn{false};
+    std::atomic<std::size_t> churn_running{0};
+    std::atomic<std::size_t> churn_logins{0};
+    std::atomic<std::size_t> held_ready{0};
+    std::atomic<std::size_t> held_closed{0};
+};
+
+// 로그인 후 프록시가 연결을 끊을 때까지 (stop()) 기다린다
+auto held_client(boost::asio::ip::tcp::endpoint target, ClientCounters& counters)
+    -> boost::asio::awaitable<void> {
+    PacketFrameBuffer rx;
+    auto stream = co_await open_session(target, rx);
+    if (!stream) {
+        co_return;
+    }
+    counters.held_ready.fetch_add(1, std::memory_order_acq_rel);
+    if (!co_await loadgen::fill_packet(*stream, rx)) {
+        counters.held_closed.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+// 접속 → 로그인 → 종료 (짝수 회차는 COM_QUIT, 홀수 회차는 그냥 끊기) 를 반복한다.
+// stop_churn 이거나 접속 / 로그인이 실패하면 (stop() 이후) 끝난다.
+auto churn_client(boost::asio::ip::tcp::endpoint target, ClientCounters& counters)
+    -> boost::asio::awaitable<void> {
+    for (std::size_t round = 0; !counters.stop_churn.load(std::memory_order_acquire); ++round) {
+        PacketFrameBuffer rx;
+        auto stream = co_await open_session(target, rx);
+        if (!stream) {
+            break;
+        }
+        counters.churn_logins.fetch_add(1, std::memory_order_acq_rel);
+        if (round % 2 == 0) {
+            std::vector<std::uint8_t> quit;
+            loadgen::append_packet(quit, 0, std::array<std::uint8_t, 1>{loadgen::kComQuit});
+            [[maybe_unused]] const bool sent = co_await loadgen::write_all(*stream, quit);
+        }
+        boost::system::error_code ec;
+        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+        stream->lowest_layer().close(ec);
+    }
+    counters.churn_running.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void spawn_churn(boost::asio::io_context& io_ctx,
+                 const boost::asio::ip::tcp::endpoint& target,
+                 ClientCounters& counters) {
+    counters.stop_churn.store(false, std::memory_order_release);
+    counters.churn_running.fetch_add(kChurnClients, std::memory_order_acq_rel);
+    for (std::size_t i = 0; i < kChurnClients; ++i) {
+        boost::asio::co_spawn(io_ctx, churn_client(target, counters), boost::asio::detached);
+    }
+}
+
+}  // namespace
+
+TEST(ProxyServerConcurrencyTest, SessionsOpenAndCloseAcrossIoThreadsAndStopMidFlight) {
+    const auto work_dir = std::filesystem::temp_directory_path() / "dbgate_test_proxy_mt";
+    std::filesystem::create_directories(work_dir);
+
+    boost::asio::io_context backend_ctx;
+    loadgen::FakeMysqlBackend backend{backend_ctx, loadgen::BackendOptions{}};
+    backend.start();
+    std::thread backend_thread{[&backend_ctx] { backend_ctx.run(); }};
+
+    ProxyConfig config;
+    config.listen_address = "127.0.0.1";
+    config.listen_port = free_loopback_port();
+    config.upstream_address = "127.0.0.1";
+    config.upstream_port = backend.port();
+    config.health_check_port = free_loopback_port();
+    config.log_level = "warn";
+    config.log_path = (work_dir / "dbgate.log").string();
+    config.uds_socket_path = (work_dir / "dbgate.sock").string();
+    // 정책 파일 없음 → fail-close (쿼리는 모두 차단, 로그인 / 종료 경로만 쓴다)
+    config.policy_path = (work_dir / "missing_policy.yaml").string();
+    config.worker_threads = kIoThreads;
+    const boost::asio::ip::tcp::endpoint target{boost::asio::ip::make_address("127.0.0.1"),
+                                                config.listen_port};
+
+    // 리스너 / 세션 소켓이 ProxyServer 소멸 시 닫히도록 server 를 io_ctx 보다 먼저 해제한다
+    auto io_ctx = std::make_unique<boost::asio::io_context>(static_cast<int>(kIoThreads));
+    auto server = std::make_unique<ProxyServer>(config);
+    server->run(*io_ctx);
+    std::atomic<std::size_t> io_exited{0};
+    std::vector<std::thread> io_threads;
+    for (std::size_t i = 0; i < kIoThreads; ++i) {
+        io_threads.emplace_back([&io_ctx, &io_exited] {
+            io_ctx->run();
+            io_exited.fetch_add(1, std::memory_order_acq_rel);
+        });
+    }
+    ASSERT_TRUE(wait_for_listener(target));
+
+    ClientCounters counters;
+    boost::asio::io_context client_ctx;
+    auto client_work = boost::asio::make_work_guard(client_ctx);
+    std::vector<std::thread> client_threads;
+    for (std::size_t i = 0; i < kClientThreads; ++i) {
+        client_threads.emplace_back([&client_ctx] { client_ctx.run(); });
+    }
+
+    // 1) 유지 세션 + 반복 접속: 끊긴 세션은 모두 erase 되고 유지 세션만 남는다
+    for (std::size_t i = 0; i < kHeldClients; ++i) {
+        boost::asio::co_spawn(client_ctx, held_client(target, counters), boost::asio::detached);
+    }
+    spawn_churn(client_ctx, target, counters);
+    EXPECT_TRUE(wait_until([&] { return counters.held_ready.load() == kHeldClients; }));
+    EXPECT_TRUE(wait_until([&] { return counters.churn_logins.load() >= 50; }));
+    counters.stop_churn.store(true, std::memory_order_release);
+    EXPECT_TRUE(wait_until([&] { return counters.churn_running.load() == 0; }));
+    EXPECT_TRUE(wait_until([&] { return server->active_sessions() == kHeldClients; }))
+        << "active sessions: " << server->active_sessions();
+
+    // 2) 반복 접속 중에 stop(): SIGTERM 핸들러처럼 워커 스레드에서 호출한다
+    const auto logins_before_stop = counters.churn_logins.load() + 20;
+    spawn_churn(client_ctx, target, counters);
+    EXPECT_TRUE(wait_until([&] { return counters.churn_logins.load() >= logins_before_stop; }));
+    boost::asio::post(*io_ctx, [&server] { server->stop(); });
+
+    const bool io_stopped = wait_until([&] { return io_exited.load() == kIoThreads; });
+    EXPECT_TRUE(io_stopped) << "io_context did not stop, active sessions: "
+                            << server->active_sessions();
+    if (!io_stopped) {
+        io_ctx->stop();
+    }
+    for (auto& thread : io_threads) {
+        thread.join();
+    }
+    EXPECT_EQ(server->active_sessions(), 0U);
+    EXPECT_TRUE(wait_until([&] { return counters.held_closed.load() == kHeldClients; }));
+
+    // 3) 정지 후: 리스너가 닫혀 새 연결은 거부되고 반복 접속 클라이언트도 끝난다
+    counters.stop_churn.store(true, std::memory_order_release);
+    server.reset();
+    io_ctx.reset();
+    {
+        boost::asio::io_context probe_ctx;
+        boost::asio::ip::tcp::socket probe{probe_ctx};
+        boost::system::error_code ec;
+        // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+        probe.connect(target, ec);
+        EXPECT_TRUE(ec);
+    }
+    EXPECT_TRUE(wait_until([&] { return counters.churn_running.load() == 0; }));
+
+    client_work.reset();
+    for (auto& thread : client_threads) {
+        thread.join();
+    }
+    backend.stop();
+    backend_ctx.stop();
+    backend_thread.join();
+    std::error_code fs_ec;
+    std::filesystem::remove_all(work_dir, fs_ec);
+}
@@ -10,7 +10,8 @@
 // - 주석 전처리 (/* */, --, #)
 // - 에러 처리 (빈 입력, 공백 전용)
 // - has_where_clause 판정
-// - raw_sql 원문 보존
+// - raw_sql 원문 보존 / 입력 버퍼를 빌리는 뷰 (raw_sql, tables)
+// - QueryArena: 커맨드 단위 scratch 할당과 블록 재사용
 //
 // [오탐/미탐 주의사항]
 // - ORM 생성 복잡 쿼리에서 테이블명 추출이 부정확할 수 있음 (알려진 한계).
@@ -21,28 +22,58 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "common/query_arena.hpp"
+#include "parser/procedure_detector.hpp"
+#include "parser/query_fingerprint.hpp"
+#include "parser/sql_lexer.hpp"
 #include "parser/sql_parser.hpp"
+#include "parser/sql_scan.hpp"
 
 // ---------------------------------------------------------------------------
 // 헬퍼: tables 벡터에 특정 이름이 포함되어 있는지 확인 (대소문자 무관)
 // ---------------------------------------------------------------------------
 namespace {
 
-bool contains_table(const std::vector<std::string>& tables, const std::string& name) {
-    auto to_upper = [](std::string s) {
+bool contains_table(std::span<const std::string_view> tables, const std::string& name) {
+    auto to_upper = [](std::string_view sv) {
+        std::string s(sv);
         std::ranges::transform(
             s, s.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
         return s;
     };
     const std::string upper_name = to_upper(name);
     return std::ranges::any_of(tables,
-                               [&](const std::string& t) { return to_upper(t) == upper_name; });
+                               [&](std::string_view t) { return to_upper(t) == upper_name; });
 }
 
+// 전달된 할당을 세는 memory_resource (기본 리소스로 새는 할당이 없는지 확인용)
+class CountingResource final : public std::pmr::memory_resource {
+public:
+    std::size_t allocations{0};
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
 }  // namespace
 
 // ---------------------------------------------------------------------------
@@ -561,4 +592,418 @@ TEST(SqlParser, MultiStatementEXECUTE_Blocked) {
     EXPECT_EQ(result.error().code, ParseErrorCode::kInvalidSql);
 }
 
+// ---------------------------------------------------------------------------
+// 단일 패스 렉서 (SqlLexer) 기반 파싱 테스트
+//
+// 문자열/백틱/주석 경계를 토큰 단위로 판정하므로, 리터럴 내부의 키워드나
+// 주석 기호가 테이블 추출/WHERE 판정/멀티 스테이트먼트 감지에 영향을 주지 않는다.
+// ---------------------------------------------------------------------------
+
+TEST(SqlLexer, TokenKindsAndCommentSkipping) {
+    SqlLexer lexer{"SELECT `a b`, 'x;y' /* c */ FROM t -- tail"};
+
+    const auto t1 = lexer.next();
+    EXPECT_EQ(t1.kind, SqlTokenKind::kWord);
+    EXPECT_EQ(t1.text, "SELECT");
+
+    const auto t2 = lexer.next();
+    EXPECT_EQ(t2.kind, SqlTokenKind::kQuotedIdentifier);
+    EXPECT_EQ(t2.text, "`a b`");
+
+    const auto t3 = lexer.next();
+    EXPECT_EQ(t3.kind, SqlTokenKind::kSymbol);
+    EXPECT_FALSE(t3.separated_before);
+
+    const auto t4 = lexer.next();
+    EXPECT_EQ(t4.kind, SqlTokenKind::kString);
+    EXPECT_EQ(t4.text, "'x;y'");
+
+    const auto t5 = lexer.next();
+    EXPECT_EQ(t5.text, "FROM");
+    EXPECT_TRUE(t5.separated_before);
+
+    EXPECT_EQ(lexer.next().text, "t");
+    EXPECT_EQ(lexer.next().kind, SqlTokenKind::kEnd);
+    EXPECT_EQ(lexer.next().kind, SqlTokenKind::kEnd);
+}
+
+TEST(SqlScan, VectorKernelMatchesScalarAcrossBlockBoundaries) {
+    // 16/32 바이트 경계 앞뒤, 마지막 바이트, 히트 없음, 두 문자 모두 등장
+    std::string text(97, 'x');
+    const std::size_t positions[] = {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 95, 96};
+    for (const auto hit : positions) {
+        for (const auto other : positions) {
+            std::string s = text;
+            s[hit] = '\'';
+            s[other] = '\\';
+            for (std::size_t pos = 0; pos <= s.size() + 1; ++pos) {
+                ASSERT_EQ(sql_scan::find_first_of2(s, pos, '\'', '\\'),
+                          sql_scan::find_first_of2_scalar(s, pos, '\'', '\\'))
+                    << "hit=" << hit << " other=" << other << " pos=" << pos;
+            }
+        }
+    }
+    EXPECT_EQ(sql_scan::find_first_of2(text, 0, '*', '*'), text.size());
+    // 비ASCII 바이트 (부호 있는 char 비교)
+    EXPECT_EQ(sql_scan::find_first_of2(std::string(40, '\xE2') + "\n", 3, '\n', '\n'), 40U);
+    EXPECT_FALSE(sql_scan::kernel_name(sql_scan::active_kernel()).empty());
+}
+
+TEST(SqlLexer, LongLiteralsAndCommentsKeepBoundaries) {
+    // 커널 블록보다 긴 리터럴/주석 안의 세미콜론·주석 기호·이스케이프는 구문이 아니다
+    const std::string body(100, 'a');
+    const std::string sql = "SELECT '" + body + "\\'" + body + "'';--" + body + "' /*" + body +
+                            "*" + body + "*/ `" + body + "``" + body + "` -- " + body + "\nx";
+    SqlLexer lexer{sql};
+    const auto select = lexer.next();
+    EXPECT_EQ(select.text, "SELECT");
+    const auto str = lexer.next();
+    ASSERT_EQ(str.kind, SqlTokenKind::kString);
+    EXPECT_EQ(str.end_offset(), 8 + 100 + 2 + 100 + 2 + 3 + 100 + 1);
+    const auto ident = lexer.next();
+    ASSERT_EQ(ident.kind, SqlTokenKind::kQuotedIdentifier);
+    EXPECT_EQ(ident.text.size(), 100 + 2 + 100 + 2);
+    const auto tail = lexer.next();
+    EXPECT_EQ(tail.text, "x");
+    EXPECT_EQ(lexer.next().kind, SqlTokenKind::kEnd);
+}
+
+TEST(SqlLexer, UnterminatedStringRunsToEnd) {
+    SqlLexer lexer{"SELECT 'abc\\"};
+    EXPECT_EQ(lexer.next().text, "SELECT");
+    const auto tok = lexer.next();
+    EXPECT_EQ(tok.kind, SqlTokenKind::kString);
+    EXPECT_EQ(lexer.next().kind, SqlTokenKind::kEnd);
+}
+
+TEST(SqlParser, KeywordsInsideStringLiteralIgnored) {
+    const SqlParser parser;
+    const auto result = parser.parse("SELECT 'FROM secret -- x' AS s FROM t");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(contains_table(result->tables, "t"));
+    EXPECT_FALSE(contains_table(result->tables, "secret"));
+}
+
+TEST(SqlParser, WhereInsideStringLiteralNotCounted) {
+    // 문자열 안의 WHERE 는 조건절이 아님 → has_where_clause false (차단 우선 방향)
+    const SqlParser parser;
+    const auto result = parser.parse("UPDATE t SET note = 'no WHERE here'");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_FALSE(result->has_where_clause);
+}
+
+TEST(SqlParser, BacktickQualifiedTableName) {
+    const SqlParser parser;
+    const auto result = parser.parse("SELECT * FROM `mydb`.`Orders` WHERE id = 1");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->tables.size(), 1U);
+    EXPECT_EQ(result->tables[0], "mydb.Orders");
+}
+
+TEST(SqlParser, CommaListWithAliases) {
+    const SqlParser parser;
+    const auto result = parser.parse("SELECT * FROM t1 a, t2 AS b WHERE a.id = b.id");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(contains_table(result->tables, "t1"));
+    EXPECT_TRUE(contains_table(result->tables, "t2"));
+    EXPECT_FALSE(contains_table(result->tables, "a"));
+    EXPECT_TRUE(result->has_where_clause);
+}
+
+TEST(SqlParser, DropTableIfExists) {
+    const SqlParser parser;
+    const auto result = parser.parse("DROP TABLE IF EXISTS users");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->tables.size(), 1U);
+    EXPECT_EQ(result->tables[0], "users");
+}
+
+TEST(SqlParser, QuoteInsideBacktickDoesNotHideSemicolon) {
+    // 백틱 식별자 안의 ' 가 문자열 시작으로 오인되면 뒤의 세미콜론이 숨겨진다.
+    const SqlParser parser;
+    const auto result = parser.parse("SELECT `it's` FROM t; DROP TABLE users");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, ParseErrorCode::kInvalidSql);
+}
+
+TEST(SqlParser, SemicolonInsideBacktickAllowed) {
+    const SqlParser parser;
+    const auto result = parser.parse("SELECT `a;b` FROM t");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(contains_table(result->tables, "t"));
+}
+
+TEST(SqlParser, KeywordGluedToParenIsUnknown) {
+    // 첫 토큰은 공백/주석/입력 끝으로 구분되어야 키워드로 인정 (기존 규칙 유지)
+    const SqlParser parser;
+    const auto result = parser.parse("SELECT(1)");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->command, SqlCommand::kUnknown);
+}
+
+TEST(SqlParser, LargeOrmStyleJoinQuery) {
+    std::string sql = "SELECT t0.id FROM t0";
+    for (int i = 1; i <= 500; ++i) {
+        sql += " LEFT OUTER JOIN t" + std::to_string(i) + " ON t" + std::to_string(i) +
+               ".id = t0.id";
+    }
+    sql += " WHERE t0.id IN (SELECT id FROM t0)";
+
+    const SqlParser parser;
+    const auto result = parser.parse(sql);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->command, SqlCommand::kSelect);
+    EXPECT_EQ(result->tables.size(), 501U);
+    EXPECT_TRUE(contains_table(result->tables, "t500"));
+    EXPECT_TRUE(result->has_where_clause);
+}
+
+TEST(SqlParser, RawSqlAndTablesBorrowInputBuffer) {
+    const std::string sql = "SELECT * FROM mydb.orders o JOIN `Users` u ON o.uid = u.id";
+    const auto in_sql = [&sql](std::string_view v) {
+        return v.data() >= sql.data() && v.data() + v.size() <= sql.data() + sql.size();
+    };
+
+    const SqlParser parser;
+    const auto result = parser.parse(sql);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(static_cast<const void*>(result->raw_sql.data()),
+              static_cast<const void*>(sql.data()))
+        << "raw_sql 은 사본이 아니라 입력 버퍼를 가리킨다";
+    ASSERT_EQ(result->tables.size(), 2U);
+    EXPECT_EQ(result->tables[0], "mydb.orders");
+    EXPECT_EQ(result->tables[1], "Users");
+    EXPECT_TRUE(in_sql(result->tables[0]));
+    EXPECT_TRUE(in_sql(result->tables[1]));
+    EXPECT_TRUE(result->owned_strings.empty()) << "원문에 연속인 이름은 사본을 만들지 않는다";
+}
+
+TEST(SqlParser, NonContiguousTableNamesNormalizedAndSurviveMove) {
+    const SqlParser parser;
+    auto result = parser.parse("SELECT * FROM `my``db`.`t1` JOIN s . t2 JOIN `a`.b");
+    ASSERT_TRUE(result.has_value());
+
+    // 이동 후에도 정규화 사본을 가리키는 뷰가 유효해야 한다 (세션은 결과를 옮겨 보관한다)
+    const ParsedQuery moved = std::move(*result);
+    ASSERT_EQ(moved.tables.size(), 3U);
+    EXPECT_EQ(moved.tables[0], "my`db.t1");
+    EXPECT_EQ(moved.tables[1], "s.t2");
+    EXPECT_EQ(moved.tables[2], "a.b");
+}
+
+// ===========================================================================
+// fingerprint_query — 판정 캐시 키 정규화
+// ===========================================================================
+
+TEST(QueryFingerprint, LiteralsNormalizeToSameShape) {
+    const auto a = fingerprint_query("SELECT * FROM users WHERE id = 1 AND name = 'kim'");
+    const auto b = fingerprint_query("SELECT * FROM users WHERE id = 42 AND name = \"lee\"");
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ(*a, *b);
+    EXPECT_EQ(*a, "SELECT * FROM users WHERE id = ? AND name = '?'");
+}
+
+TEST(QueryFingerprint, WhitespaceAndCommentsCollapse) {
+    const auto a = fingerprint_query("SELECT  id\n\tFROM /* c */ users");
+    const auto b = fingerprint_query("SELECT id FROM users");
+    ASSERT_TRUE(a.has_value());
+    EXPECT_EQ(*a, *b);
+}
+
+TEST(QueryFingerprint, SeparationPreserved) {
+    // "SELECT(1)" 는 파서가 kUnknown 으로 판정하므로 "SELECT (1)" 과 묶이면 안 된다
+    const auto glued = fingerprint_query("SELECT(1)");
+    const auto spaced = fingerprint_query("SELECT (1)");
+    ASSERT_TRUE(glued.has_value());
+    ASSERT_TRUE(spaced.has_value());
+    EXPECT_NE(*glued, *spaced);
+}
+
+TEST(QueryFingerprint, IdentifiersAreNotNormalized) {
+    EXPECT_NE(*fingerprint_query("SELECT * FROM users"),
+              *fingerprint_query("SELECT * FROM orders"));
+    EXPECT_NE(*fingerprint_query("SELECT * FROM `users`"),
+              *fingerprint_query("SELECT * FROM users"));
+}
+
+TEST(QueryFingerprint, PlaceholderSymbolEscaped) {
+    // 원문의 ? 와 숫자 리터럴 치환 결과가 구분되어야 한다
+    EXPECT_NE(*fingerprint_query("SELECT ? FROM t"), *fingerprint_query("SELECT 1 FROM t"));
+}
+
+TEST(QueryFingerprint, SemicolonNotFingerprinted) {
+    EXPECT_FALSE(fingerprint_query("SELECT 1;").has_value());
+    EXPECT_FALSE(fingerprint_query("SELECT 1; DROP TABLE users").has_value());
+    // 문자열 안의 세미콜론은 리터럴이므로 허용
+    EXPECT_TRUE(fingerprint_query("SELECT 'a;b' FROM t").has_value());
+}
+
+TEST(QueryFingerprint, EmptyInputNotFingerprinted) {
+    EXPECT_FALSE(fingerprint_query("").has_value());
+    EXPECT_FALSE(fingerprint_query("  /* only comment */ ").has_value());
+}
+
+TEST(SqlTokenList, SharedTokensMatchLexerPaths) {
+    const SqlParser parser;
+    for (const char* sql : {"SELECT * FROM users WHERE id = 1",
+                            "select/**/a from `db`.`t` join x on 1",
+                            "UPDATE t SET a = 'x;y' -- tail",
+                            "SELECT 1;   ",
+                            "SELECT 1; -- hidden",
+                            "SELECT 1; DROP TABLE t",
+                            "SELECT(1)",
+                            "DELETE FROM t",
+                            "  /* only comment */ ",
+                            "INSERT INTO t VALUES ('unterminated"}) {
+        const auto tokens = tokenize_sql(sql, std::pmr::get_default_resource());
+
+        const auto direct = parser.parse(sql);
+        const auto shared = parser.parse(sql, tokens);
+        ASSERT_EQ(direct.has_value(), shared.has_value()) << sql;
+        if (direct) {
+            EXPECT_EQ(direct->command, shared->command) << sql;
+            EXPECT_EQ(direct->has_where_clause, shared->has_where_clause) << sql;
+            EXPECT_TRUE(std::ranges::equal(direct->tables, shared->tables)) << sql;
+        } else {
+            EXPECT_EQ(direct.error().message, shared.error().message) << sql;
+        }
+
+        const auto fp_direct = fingerprint_query(sql);
+        const auto fp_shared = fingerprint_query(sql, tokens, std::pmr::get_default_resource());
+        ASSERT_EQ(fp_direct.has_value(), fp_shared.has_value()) << sql;
+        if (fp_direct) {
+            EXPECT_EQ(*fp_direct, std::string_view{*fp_shared}) << sql;
+        }
+    }
+}
+
+// ===========================================================================
+// QueryArena — 커맨드 단위 parse/detect scratch
+// ===========================================================================
+
+TEST(QueryArena, ParseAllocatesFromGivenResourceOnly) {
+    CountingResource counting;
+    CountingResource fallback;
+    std::pmr::memory_resource* const previous = std::pmr::set_default_resource(&fallback);
+
+    const SqlParser parser;
+    {
+        const auto result = parser.parse("SELECT * FROM `my``db`.`t1` JOIN s . t2", &counting);
+        ASSERT_TRUE(result.has_value());
+        ASSERT_EQ(result->tables.size(), 2U);
+        EXPECT_EQ(result->tables[0], "my`db.t1");
+        EXPECT_EQ(result->resource(), &counting);
+    }
+    std::pmr::set_default_resource(previous);
+
+    EXPECT_GT(counting.allocations, 0U);
+    EXPECT_EQ(fallback.allocations, 0U) << "기본 리소스로 새는 할당이 없어야 한다";
+}
+
+TEST(QueryArena, SteadyStateReusesRetainedBlocks) {
+    QueryArena arena;
+    const SqlParser parser;
+    const ProcedureDetector detector;
+    const std::string sql = "CALL billing.sp_monthly_close_for_region(1, 'apac')";
+
+    const auto run_once = [&] {
+        const QueryArena::Scope scope{arena};
+        const auto fingerprint = fingerprint_query(sql, &arena);
+        ASSERT_TRUE(fingerprint.has_value());
+        EXPECT_EQ(std::string_view{*fingerprint}, *fingerprint_query(sql));
+        const auto parsed = parser.parse(sql, &arena);
+        ASSERT_TRUE(parsed.has_value());
+        const auto info = detector.detect(*parsed);
+        ASSERT_TRUE(info.has_value());
+        EXPECT_EQ(info->procedure_name, "billing.sp_monthly_close_for_region");
+        EXPECT_EQ(info->procedure_name.get_allocator().resource(), &arena);
+    };
+
+    run_once();
+    const auto blocks_after_first = arena.block_allocations();
+    EXPECT_EQ(blocks_after_first, 1U);
+    for (int i = 0; i < 100; ++i) {
+        run_once();
+    }
+    EXPECT_EQ(arena.block_allocations(), blocks_after_first)
+        << "reset 후에는 보관된 블록을 재사용해야 한다";
+}
+
+TEST(QueryArena, OversizedBlocksReleasedOnReset) {
+    QueryArena arena;
+    {
+        const QueryArena::Scope scope{arena};
+        (void)arena.allocate(64, alignof(std::max_align_t));
+        (void)arena.allocate(QueryArena::kMaxRetainedBytes * 2, alignof(std::max_align_t));
+        EXPECT_GT(arena.retained_bytes(), QueryArena::kMaxRetainedBytes);
+    }
+    // 첫 블록만 남는다 (대용량 쿼리 1건 때문에 세션이 큰 블록을 계속 쥐지 않음)
+    EXPECT_EQ(arena.retained_bytes(), QueryArena::kInitialBlockBytes);
+
+    // 과정렬 요청도 정렬을 지킨다
+    void* const p = arena.allocate(16, 256);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 256, 0U);
+}
+
+TEST(ProcedureDetector, ProcedureKeywordRequiresWordBoundary) {
+    const SqlParser parser;
+    const ProcedureDetector detector;
+
+    const auto create = parser.parse("create definer=root procedure p() select 1");
+    ASSERT_TRUE(create.has_value());
+    const auto info = detector.detect(*create);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->type, ProcedureType::kCreateProcedure);
+
+    // 테이블/컬럼 이름 일부인 PROCEDURE 는 프로시저 구문이 아니다
+    for (const char* sql : {"CREATE TABLE procedures (id INT)", "DROP TABLE my_procedure",
+                            "ALTER TABLE t ADD procedure_id INT"}) {
+        const auto parsed = parser.parse(sql);
+        ASSERT_TRUE(parsed.has_value()) << sql;
+        EXPECT_FALSE(detector.detect(*parsed).has_value()) << sql;
+    }
+}
+
+TEST(ProcedureDetector, CallNameExtraction_MatchesRegexSemantics) {
+    const SqlParser parser;
+    const ProcedureDetector detector;
+
+    const std::pair<const char*, const char*> cases[] = {
+        {"CALL sp_a()", "sp_a"},
+        {"call\n\tShop.Sp_B (1, 2)", "Shop.Sp_B"},
+        {"  CALL sp_c   ( 'x' )", "sp_c"},
+        {"CALL sp_d", ""},                // 괄호 없음
+        {"CALL /* c */ sp_e()", ""},      // 주석 (알려진 한계)
+        {"CALL x CALL sp_f()", "sp_f"},   // 첫 후보가 실패하면 다음 CALL 로
+    };
+    for (const auto& [sql, expected] : cases) {
+        const auto parsed = parser.parse(sql);
+        ASSERT_TRUE(parsed.has_value()) << sql;
+        const auto info = detector.detect(*parsed);
+        ASSERT_TRUE(info.has_value()) << sql;
+        EXPECT_EQ(info->procedure_name, expected) << sql;
+    }
+}
+
+TEST(ProcedureDetector, IsCandidate_MatchesDetectCoverage) {
+    const SqlParser parser;
+    const ProcedureDetector detector;
+
+    for (const char* sql : {"SELECT * FROM users", "INSERT INTO t VALUES (1)",
+                            "UPDATE t SET a = 1", "DELETE FROM t"}) {
+        const auto parsed = parser.parse(sql);
+        ASSERT_TRUE(parsed.has_value()) << sql;
+        EXPECT_FALSE(ProcedureDetector::is_candidate(parsed->command)) << sql;
+        EXPECT_FALSE(detector.detect(*parsed).has_value()) << sql;
+    }
+    for (const char* sql : {"CALL p()", "PREPARE s FROM 'SELECT 1'", "EXECUTE s",
+                            "DROP PROCEDURE p", "CREATE PROCEDURE p() SELECT 1"}) {
+        const auto parsed = parser.parse(sql);
+        ASSERT_TRUE(parsed.has_value()) << sql;
+        EXPECT_TRUE(ProcedureDetector::is_candidate(parsed->command)) << sql;
+        EXPECT_TRUE(detector.detect(*parsed).has_value()) << sql;
+    }
+}
+
 // main 함수는 test_logger.cpp 에서 제공됨 (단일 dbgate_tests 실행 파일)
@@ -10,6 +10,8 @@
 //   E. SSL 비활성화 시 기존 동작 하위 호환
 //   F. 실패 케이스 (fail-close 검증)
 //   G. Session SSL 모드 테스트
+//   H. KtlsStream (소켓 직결 OpenSSL, kTLS 시도) 루프백 핸드셰이크/송수신
+//   I. TLS 세션 재개 (서버 세션 캐시/티켓 + TlsSessionCache)
 //
 // init_ssl()은 ProxyServer private 메서드이므로 직접 호출할 수 없다.
 // boost::asio::ssl::context API를 통해 동일한 로직을 재현하여 검증한다.
@@ -17,10 +19,16 @@
 
 #include <gtest/gtest.h>
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/context.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/redirect_error.hpp>
 #include <boost/asio/ssl/stream.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
 #include <boost/system/error_code.hpp>
 #include <chrono>
 #include <cstdlib>
@@ -31,12 +39,14 @@
 #include <random>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "common/async_stream.hpp"
 #include "logger/structured_logger.hpp"
 #include "policy/policy_engine.hpp"
 #include "proxy/proxy_server.hpp"
 #include "proxy/session.hpp"
+#include "proxy/tls_session_cache.hpp"
 #include "stats/stats_collector.hpp"
 
 // ---------------------------------------------------------------------------
@@ -178,6 +188,23 @@ TEST(ProxyConfigSslTest, DefaultUpstreamSslSni_IsEmpty) {
     EXPECT_TRUE(cfg.upstream_ssl_sni.empty());
 }
 
+// ---------------------------------------------------------------------------
+// PA-7. ProxyConfig 기본 생성 시 ssl_ktls_enabled=false (kTLS 는 opt-in)
+// ---------------------------------------------------------------------------
+TEST(ProxyConfigSslTest, DefaultSslKtlsEnabled_IsFalse) {
+    const ProxyConfig cfg;
+    EXPECT_FALSE(cfg.ssl_ktls_enabled);
+}
+
+// ---------------------------------------------------------------------------
+// PA-8. ProxyConfig 기본 생성 시 TLS 세션 재개 활성 (cache 1024, 수명 300초)
+// ---------------------------------------------------------------------------
+TEST(ProxyConfigSslTest, DefaultSslSessionCache_IsEnabled) {
+    const ProxyConfig cfg;
+    EXPECT_EQ(cfg.ssl_session_cache_size, 1024U);
+    EXPECT_EQ(cfg.ssl_session_timeout_sec, 300U);
+}
+
 // ===========================================================================
 // C. SSL Context 생성/설정 검증 (ProxyServer::init_ssl 간접 테스트)
 // ===========================================================================
@@ -601,3 +628,272 @@ TEST(SessionSslModeTest, ValidBackendSslCtx_CloseIdempotent) {
         session->close();
     });
 }
+
+// ===========================================================================
+// H. KtlsStream 테스트
+//    kTLS 활성 여부는 커널/OpenSSL 빌드에 따라 다르므로 검증하지 않는다.
+//    어느 경우든 ssl::stream 상대와 TLS 로 정상 통신해야 한다 (폴백 동작 동일).
+// ===========================================================================
+
+namespace {
+
+struct TlsLoopbackContexts {
+    boost::asio::ssl::context server{boost::asio::ssl::context::tls_server};
+    boost::asio::ssl::context client{boost::asio::ssl::context::tls_client};
+};
+
+bool load_loopback_contexts(TlsLoopbackContexts& ctxs, const TestCertificateFiles& files) {
+    boost::system::error_code ec;
+    // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+    ctxs.server.use_certificate_chain_file(files.cert_path.string(), ec);
+    if (ec) {
+        return false;
+    }
+    // NOLINTNEXTLINE(bugprone-unused-return-value,cert-err33-c)
+    ctxs.server.use_private_key_file(
+        files.key_path.string(), boost::asio::ssl::context::pem, ec);
+    ctxs.client.set_verify_mode(boost::asio::ssl::verify_none);
+    return !ec;
+}
+
+// stream 쪽에서 핸드셰이크 → payload 전송 → 같은 길이 에코 수신
+auto handshake_and_echo(AsyncStream& stream,
+                        boost::asio::ssl::stream_base::handshake_type type,
+                        const std::vector<std::uint8_t>& payload,
+                        std::vector<std::uint8_t>& echoed) -> boost::asio::awaitable<bool> {
+    boost::system::error_code ec;
+    co_await stream.async_handshake(type,
+                                    boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return false;
+    }
+    co_await boost::asio::async_write(stream,
+                                      boost::asio::buffer(payload),
+                                      boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return false;
+    }
+    echoed.resize(payload.size());
+    co_await boost::asio::async_read(stream,
+                                     boost::asio::buffer(echoed),
+                                     boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    co_return !ec;
+}
+
+// 상대편: 핸드셰이크 후 n 바이트를 받아 그대로 돌려준다
+auto handshake_and_reflect(AsyncStream& stream,
+                           boost::asio::ssl::stream_base::handshake_type type,
+                           std::size_t n) -> boost::asio::awaitable<void> {
+    boost::system::error_code ec;
+    co_await stream.async_handshake(type,
+                                    boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return;
+    }
+    std::vector<std::uint8_t> buf(n);
+    co_await boost::asio::async_read(stream,
+                                     boost::asio::buffer(buf),
+                                     boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+        co_return;
+    }
+    co_await boost::asio::async_write(stream,
+                                      boost::asio::buffer(buf),
+                                      boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// SH-1. KtlsStream 서버(frontend 역할) ↔ ssl::stream 클라이언트: 여러 레코드 왕복
+// ---------------------------------------------------------------------------
+TEST(KtlsStreamTest, ServerSideHandshakeAndEcho) {
+    const auto& files = test_certificate_files();
+    if (!files.has_value()) {
+        GTEST_SKIP() << "openssl 인증서 생성 실패로 테스트를 건너뜀";
+    }
+    TlsLoopbackContexts ctxs;
+    ASSERT_TRUE(load_loopback_contexts(ctxs, *files));
+
+    boost::asio::io_context ioc;
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    boost::asio::ip::tcp::socket client_sock{ioc};
+    client_sock.connect(acceptor.local_endpoint());
+
+    AsyncStream server = AsyncStream::make_tls(acceptor.accept(), ctxs.server, true);
+    AsyncStream client{AsyncStream::ssl_socket{std::move(client_sock), ctxs.client}};
+    ASSERT_TRUE(server.is_ssl());
+    ASSERT_NE(server.native_ssl(), nullptr);
+
+    const std::vector<std::uint8_t> payload(100U * 1024U, 0x5A);  // TLS 레코드 여러 개
+    std::vector<std::uint8_t> echoed;
+    std::optional<bool> ok;
+
+    boost::asio::co_spawn(
+        ioc,
+        [&]() -> boost::asio::awaitable<void> {
+            ok = co_await handshake_and_echo(
+                client, boost::asio::ssl::stream_base::client, payload, echoed);
+        },
+        boost::asio::detached);
+    boost::asio::co_spawn(
+        ioc,
+        handshake_and_reflect(server, boost::asio::ssl::stream_base::server, payload.size()),
+        boost::asio::detached);
+
+    ioc.run_for(std::chrono::seconds{10});
+    ASSERT_TRUE(ok.has_value());
+    EXPECT_TRUE(*ok);
+    EXPECT_EQ(echoed, payload);
+}
+
+// ---------------------------------------------------------------------------
+// SH-2. KtlsStream 클라이언트(backend 역할) ↔ ssl::stream 서버
+// ---------------------------------------------------------------------------
+TEST(KtlsStreamTest, ClientSideHandshakeAndEcho) {
+    const auto& files = test_certificate_files();
+    if (!files.has_value()) {
+        GTEST_SKIP() << "openssl 인증서 생성 실패로 테스트를 건너뜀";
+    }
+    TlsLoopbackContexts ctxs;
+    ASSERT_TRUE(load_loopback_contexts(ctxs, *files));
+
+    boost::asio::io_context ioc;
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    boost::asio::ip::tcp::socket client_sock{ioc};
+    client_sock.connect(acceptor.local_endpoint());
+
+    AsyncStream server{AsyncStream::ssl_socket{acceptor.accept(), ctxs.server}};
+    AsyncStream client = AsyncStream::make_tls(std::move(client_sock), ctxs.client, true);
+
+    const std::vector<std::uint8_t> payload(3000, 0xC3);
+    std::vector<std::uint8_t> echoed;
+    std::optional<bool> ok;
+
+    boost::asio::co_spawn(
+        ioc,
+        [&]() -> boost::asio::awaitable<void> {
+            ok = co_await handshake_and_echo(
+                client, boost::asio::ssl::stream_base::client, payload, echoed);
+        },
+        boost::asio::detached);
+    boost::asio::co_spawn(
+        ioc,
+        handshake_and_reflect(server, boost::asio::ssl::stream_base::server, payload.size()),
+        boost::asio::detached);
+
+    ioc.run_for(std::chrono::seconds{10});
+    ASSERT_TRUE(ok.has_value());
+    EXPECT_TRUE(*ok);
+    EXPECT_EQ(echoed, payload);
+}
+
+// ---------------------------------------------------------------------------
+// SH-3. make_tls(prefer_ktls=false) 는 ssl::stream — 소켓 직접 경로 불가
+// ---------------------------------------------------------------------------
+TEST(KtlsStreamTest, UserSpaceTlsIsNotKernelPath) {
+    boost::asio::io_context ioc;
+    boost::asio::ssl::context ctx{boost::asio::ssl::context::tls_server};
+
+    AsyncStream tls = AsyncStream::make_tls(boost::asio::ip::tcp::socket{ioc}, ctx, false);
+    const AsyncStream plain{boost::asio::ip::tcp::socket{ioc}};
+
+    EXPECT_TRUE(tls.is_ssl());
+    EXPECT_NE(tls.native_ssl(), nullptr);
+    EXPECT_FALSE(tls.kernel_send());
+    EXPECT_FALSE(tls.kernel_recv());
+    EXPECT_TRUE(plain.kernel_send());
+    EXPECT_TRUE(plain.kernel_recv());
+}
+
+// ===========================================================================
+// I. TLS 세션 재개
+// ===========================================================================
+
+namespace {
+
+// 루프백 TLS 연결 1회: 클라이언트는 cache 로 세션을 제시하고 에코까지 마친다
+// (TLS 1.3 세션 티켓은 핸드셰이크 후 첫 수신에서 도착). 반환: 재개 여부 (실패 시 nullopt)
+auto connect_with_cache(TlsLoopbackContexts& ctxs, TlsSessionCache& cache, bool ktls)
+    -> std::optional<bool> {
+    boost::asio::io_context ioc;
+    boost::asio::ip::tcp::acceptor acceptor{ioc, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    boost::asio::ip::tcp::socket client_sock{ioc};
+    client_sock.connect(acceptor.local_endpoint());
+
+    AsyncStream server{AsyncStream::ssl_socket{acceptor.accept(), ctxs.server}};
+    AsyncStream client = AsyncStream::make_tls(std::move(client_sock), ctxs.client, ktls);
+    cache.prepare(client.native_ssl(), "db.internal@127.0.0.1:3306");
+
+    const std::vector<std::uint8_t> payload(64, 0x11);
+    std::vector<std::uint8_t> echoed;
+    std::optional<bool> ok;
+    boost::asio::co_spawn(
+        ioc,
+        [&]() -> boost::asio::awaitable<void> {
+            ok = co_await handshake_and_echo(
+                client, boost::asio::ssl::stream_base::client, payload, echoed);
+        },
+        boost::asio::detached);
+    boost::asio::co_spawn(
+        ioc,
+        handshake_and_reflect(server, boost::asio::ssl::stream_base::server, payload.size()),
+        boost::asio::detached);
+    ioc.run_for(std::chrono::seconds{10});
+
+    if (!ok.value_or(false)) {
+        return std::nullopt;
+    }
+    return SSL_session_reused(client.native_ssl()) == 1;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// SR-1. 두 번째 연결은 첫 연결에서 받은 세션으로 재개된다 (ssl::stream / KtlsStream 모두)
+// ---------------------------------------------------------------------------
+TEST(TlsSessionCacheTest, SecondConnectionResumes) {
+    const auto& files = test_certificate_files();
+    if (!files.has_value()) {
+        GTEST_SKIP() << "openssl 인증서 생성 실패로 테스트를 건너뜀";
+    }
+    for (const bool ktls : {false, true}) {
+        TlsLoopbackContexts ctxs;
+        ASSERT_TRUE(load_loopback_contexts(ctxs, *files));
+        enable_server_resumption(ctxs.server, 64, std::chrono::seconds{300});
+        TlsSessionCache cache{8};
+        cache.attach(ctxs.client);
+
+        const auto first = connect_with_cache(ctxs, cache, ktls);
+        ASSERT_TRUE(first.has_value()) << "ktls=" << ktls;
+        EXPECT_FALSE(*first);
+        EXPECT_EQ(cache.size(), 1U);
+
+        const auto second = connect_with_cache(ctxs, cache, ktls);
+        ASSERT_TRUE(second.has_value()) << "ktls=" << ktls;
+        EXPECT_TRUE(*second) << "ktls=" << ktls;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SR-2. cache_size == 0 이면 서버가 세션을 발급하지 않아 재개되지 않는다 / forget 은 세션 삭제
+// ---------------------------------------------------------------------------
+TEST(TlsSessionCacheTest, DisabledServerResumptionAndForget) {
+    const auto& files = test_certificate_files();
+    if (!files.has_value()) {
+        GTEST_SKIP() << "openssl 인증서 생성 실패로 테스트를 건너뜀";
+    }
+    TlsLoopbackContexts ctxs;
+    ASSERT_TRUE(load_loopback_contexts(ctxs, *files));
+    enable_server_resumption(ctxs.server, 0, std::chrono::seconds{300});
+    TlsSessionCache cache{8};
+    cache.attach(ctxs.client);
+
+    for (int i = 0; i < 2; ++i) {
+        const auto resumed = connect_with_cache(ctxs, cache, false);
+        ASSERT_TRUE(resumed.has_value());
+        EXPECT_FALSE(*resumed);
+    }
+    cache.forget("db.internal@127.0.0.1:3306");
+    EXPECT_EQ(cache.size(), 0U);
+}
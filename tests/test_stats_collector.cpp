@@ -12,24 +12,37 @@
 // - snapshot(): qps 양수 확인 (elapsed > 0)
 // - snapshot(): total == 0 시 block_rate == 0.0 (div-by-zero 방지)
 // - ConcurrentAccess: 멀티스레드 동시성 (data race 미발생 확인)
+// - LatencyHistogram: 버킷 경계, 백분위 계산, 스레드 샤드 합산
+// - tick() 표본 기반 1s/10s/60s 윈도우 QPS·차단율, ring 순환
+// - RuleCounterTable: 규칙별 카운트, 용량 초과 시 overflow 합산
+// - render_openmetrics: 메트릭 이름/라벨 이스케이프/# EOF, 버퍼 재사용
+// - QueryTopK: Space-Saving 상위 형태 보존 / 오차 상한, 교체 시 차단·지연 초기화, 정렬
 //
 // [스레드 안전성]
 // StatsCollector 는 atomic 기반 헤더-온리 구현이므로 TSan 빌드에서
 // 모든 동시성 테스트가 클린해야 한다.
 //
 // [알려진 한계]
-// - qps 계산은 elapsed_sec 기반 누적 방식이므로 테스트 실행 시간에 따라
-//   절대값이 달라진다. 양수 여부(> 0.0)만 검증한다.
+// - tick() 없이 계산한 qps 는 생성 이후 누적 평균이므로 테스트 실행 시간에 따라
+//   절대값이 달라진다. 양수 여부(> 0.0)만 검증한다. 윈도우 값은 시각을 주입해 검증한다.
 // - block_rate 부동소수점 비교는 EXPECT_NEAR 으로 허용 오차 1e-9 이내.
 // ---------------------------------------------------------------------------
 
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
 #include <thread>
 #include <vector>
 
+#include "stats/metrics_exporter.hpp"
+#include "stats/query_topk.hpp"
+#include "stats/rule_counters.hpp"
+#include "stats/session_registry.hpp"
 #include "stats/stats_collector.hpp"
+#include "stats/user_accounting.hpp"
 
 // ---------------------------------------------------------------------------
 // InitialState_AllZero
@@ -198,9 +211,9 @@ TEST(StatsCollector, Snapshot_CapturedAt_IsSet) {
 //   충분한 시간이 경과한 후 쿼리를 실행하면 qps 가 0 보다 커야 한다.
 //
 //   [구현 주의사항]
-//   window_start_ 는 StatsCollector 생성자에서 설정되고 snapshot() 에서
-//   now - window_start 로 elapsed 를 계산한다.
-//   생성 직후 즉시 snapshot() 을 호출하면 system_clock 의 정밀도 한계로
+//   tick() 이 한 번도 호출되지 않으면 생성 시각 표본이 윈도우 기준이 되어
+//   now - 생성 시각으로 elapsed 를 계산한다.
+//   생성 직후 즉시 snapshot() 을 호출하면 clock 정밀도 한계로
 //   elapsed == 0 이 될 수 있으므로 (qps == 0.0), 최소 1ms 대기 후 검증한다.
 // ---------------------------------------------------------------------------
 TEST(StatsCollector, Snapshot_Qps_PositiveAfterQuery) {
@@ -322,3 +335,661 @@ TEST(StatsCollector, OnMonitoredBlock_IncrementsCounter) {
     EXPECT_EQ(snap.total_queries, 0U)
         << "total_queries must remain 0 — on_monitored_block does not call on_query";
 }
+
+// ---------------------------------------------------------------------------
+// OnTlsHandshake_CountsResumedAndFull
+//   frontend/backend TLS 핸드셰이크의 세션 재개(hit)/전체(miss) 카운터가 분리되어야 한다.
+// ---------------------------------------------------------------------------
+TEST(StatsCollector, OnTlsHandshake_CountsResumedAndFull) {
+    StatsCollector stats;
+    stats.on_frontend_tls_handshake(false);
+    stats.on_frontend_tls_handshake(true);
+    stats.on_frontend_tls_handshake(true);
+    stats.on_backend_tls_handshake(false);
+
+    const auto snap = stats.snapshot();
+    EXPECT_EQ(snap.tls_frontend_resumed, 2U);
+    EXPECT_EQ(snap.tls_frontend_full, 1U);
+    EXPECT_EQ(snap.tls_backend_resumed, 0U);
+    EXPECT_EQ(snap.tls_backend_full, 1U);
+
+    std::string out;
+    render_openmetrics(snap, stats.rule_blocks(), out);
+    EXPECT_NE(out.find("dbgate_tls_handshakes_total{side=\"frontend\",resumed=\"true\"} 2\n"),
+              std::string::npos);
+    EXPECT_NE(out.find("dbgate_tls_handshakes_total{side=\"backend\",resumed=\"false\"} 1\n"),
+              std::string::npos);
+}
+
+// ---------------------------------------------------------------------------
+// LatencyHistogram_BucketBoundsCoverValue
+//   모든 값은 자기 버킷 상한 이하이고, 상대 오차는 1/16 이내여야 한다.
+// ---------------------------------------------------------------------------
+TEST(LatencyHistogram, BucketBoundsCoverValue) {
+    for (const std::uint64_t ns : {0ULL, 1ULL, 15ULL, 16ULL, 17ULL, 31ULL, 32ULL, 33ULL, 999ULL,
+                                   150'000ULL, 1'000'000'000ULL}) {
+        const auto index = LatencyHistogram::bucket_index(ns);
+        const auto upper = LatencyHistogram::bucket_upper_bound(index);
+        EXPECT_GE(upper, ns) << "ns=" << ns;
+        EXPECT_LE(static_cast<double>(upper - ns), static_cast<double>(ns) / 16.0 + 1.0)
+            << "ns=" << ns;
+        if (index > 0) {
+            EXPECT_LT(LatencyHistogram::bucket_upper_bound(index - 1), ns) << "ns=" << ns;
+        }
+    }
+    // 범위를 넘는 값은 마지막 버킷
+    EXPECT_EQ(LatencyHistogram::bucket_index(~0ULL), LatencyHistogram::kBucketCount - 1);
+}
+
+// ---------------------------------------------------------------------------
+// LatencyHistogram_Percentiles
+//   1~1000µs 균등 분포 → p50 ≈ 500µs, p99 ≈ 990µs, max = 1000µs.
+//   보고값은 버킷 상한이므로 실제 값보다 작지 않고 6.25% 이내로 크다.
+// ---------------------------------------------------------------------------
+TEST(LatencyHistogram, Percentiles) {
+    LatencyHistogram hist;
+    EXPECT_EQ(hist.summarize().count, 0U);
+
+    for (int us = 1; us <= 1000; ++us) {
+        hist.record(std::chrono::microseconds(us));
+    }
+    const auto s = hist.summarize();
+    EXPECT_EQ(s.count, 1000U);
+    EXPECT_GE(s.p50_us, 500.0);
+    EXPECT_LE(s.p50_us, 500.0 * 1.0625);
+    EXPECT_GE(s.p99_us, 990.0);
+    EXPECT_LE(s.p99_us, 1000.0);
+    EXPECT_DOUBLE_EQ(s.p999_us, 1000.0) << "상한은 관측 최대값으로 clamp";
+    EXPECT_DOUBLE_EQ(s.max_us, 1000.0);
+    EXPECT_DOUBLE_EQ(s.sum_us, 500500.0) << "합계는 버킷이 아닌 정확한 값";
+}
+
+// ---------------------------------------------------------------------------
+// OnLatency_MergedAcrossThreads
+//   여러 스레드가 서로 다른 샤드에 기록해도 snapshot 에서 합산되어야 한다.
+// ---------------------------------------------------------------------------
+TEST(StatsCollector, OnLatency_MergedAcrossThreads) {
+    StatsCollector stats;
+    constexpr int kThreads = 12;
+    constexpr int kPerThread = 1000;
+
+    std::vector<std::thread> threads;
+    threads.reserve(kThreads);
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&stats] {
+            for (int i = 0; i < kPerThread; ++i) {
+                stats.on_latency(LatencyStage::kPolicyEvaluate, std::chrono::microseconds(50));
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    const auto snap = stats.snapshot();
+    const auto& eval = snap.latency[static_cast<std::size_t>(LatencyStage::kPolicyEvaluate)];
+    EXPECT_EQ(eval.count, static_cast<std::uint64_t>(kThreads * kPerThread));
+    EXPECT_DOUBLE_EQ(eval.p99_us, 50.0);
+    EXPECT_EQ(snap.latency[static_cast<std::size_t>(LatencyStage::kParse)].count, 0U)
+        << "다른 단계에는 영향이 없어야 한다";
+}
+
+// ---------------------------------------------------------------------------
+// WindowRates_UseTickSamples
+//   tick() 표본 이후의 쿼리만 1s 윈도우에 반영되어야 한다.
+//   더 긴 윈도우는 기준 표본이 없으면 가장 오래된 표본(생성 시각)을 사용한다.
+// ---------------------------------------------------------------------------
+TEST(StatsCollector, WindowRates_UseTickSamples) {
+    StatsCollector stats;
+    const auto t0 = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < 100; ++i) {
+        stats.on_query(false);
+    }
+    stats.tick(t0 + std::chrono::seconds{1});
+    for (int i = 0; i < 10; ++i) {
+        stats.on_query(i % 2 == 0);
+    }
+
+    const auto snap = stats.snapshot(t0 + std::chrono::seconds{2});
+    EXPECT_NEAR(snap.qps, 10.0, 1e-6) << "1s 윈도우: 마지막 tick 이후 10건 / 1초";
+    EXPECT_NEAR(snap.block_rate_1s, 0.5, 1e-9);
+    EXPECT_NEAR(snap.qps_10s, 55.0, 1.0) << "10s 윈도우: 생성 시각 기준 110건 / 약 2초";
+    EXPECT_NEAR(snap.block_rate_10s, 5.0 / 110.0, 1e-9);
+    EXPECT_EQ(snap.total_queries, 110U);
+    EXPECT_EQ(snap.blocked_queries, 5U);
+}
+
+// ---------------------------------------------------------------------------
+// WindowRates_RingWrapsAround
+//   ring 크기보다 많이 tick 해도 60s 윈도우는 최근 60초만 반영해야 한다.
+// ---------------------------------------------------------------------------
+TEST(StatsCollector, WindowRates_RingWrapsAround) {
+    StatsCollector stats;
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // 200초 동안 초당 3건 (마지막 60초는 초당 7건)
+    for (int sec = 1; sec <= 200; ++sec) {
+        const int per_sec = sec > 140 ? 7 : 3;
+        for (int i = 0; i < per_sec; ++i) {
+            stats.on_query(false);
+        }
+        stats.tick(t0 + std::chrono::seconds{sec});
+    }
+
+    const auto snap = stats.snapshot(t0 + std::chrono::seconds{200});
+    EXPECT_NEAR(snap.qps_60s, 7.0, 1e-6);
+    EXPECT_NEAR(snap.qps_10s, 7.0, 1e-6);
+    EXPECT_NEAR(snap.block_rate_60s, 0.0, 1e-9);
+}
+
+// ---------------------------------------------------------------------------
+// OnQuery_ConcurrentShardsSumExactly
+//   샤드 수보다 많은 스레드가 동시에 기록해도 합계는 정확해야 한다.
+// ---------------------------------------------------------------------------
+TEST(StatsCollector, OnQuery_ConcurrentShardsSumExactly) {
+    StatsCollector stats;
+    constexpr int kThreads = static_cast<int>(StatsCollector::kQueryShardCount) + 4;
+    constexpr int kPerThread = 2000;
+
+    std::vector<std::thread> threads;
+    threads.reserve(kThreads);
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&stats] {
+            for (int i = 0; i < kPerThread; ++i) {
+                stats.on_query(i % 4 == 0);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    const auto snap = stats.snapshot();
+    EXPECT_EQ(snap.total_queries, static_cast<std::uint64_t>(kThreads * kPerThread));
+    EXPECT_EQ(snap.blocked_queries, static_cast<std::uint64_t>(kThreads * kPerThread / 4));
+}
+
+// ---------------------------------------------------------------------------
+// RuleCounterTable_CountsPerRuleAcrossThreads
+//   같은 규칙 ID 는 한 슬롯으로 합산되고, 동시 등록에도 중복 슬롯이 생기지 않아야 한다.
+// ---------------------------------------------------------------------------
+TEST(RuleCounterTable, CountsPerRuleAcrossThreads) {
+    RuleCounterTable table;
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 1000;
+
+    std::vector<std::thread> threads;
+    threads.reserve(kThreads);
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&table] {
+            for (int i = 0; i < kPerThread; ++i) {
+                table.increment(i % 2 == 0 ? "block-statement" : "table-denied");
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    std::map<std::string, std::uint64_t> counts;
+    table.for_each([&counts](std::string_view rule, std::uint64_t count) {
+        counts[std::string{rule}] += count;
+    });
+    ASSERT_EQ(counts.size(), 2U);
+    EXPECT_EQ(counts["block-statement"], static_cast<std::uint64_t>(kThreads * kPerThread / 2));
+    EXPECT_EQ(counts["table-denied"], static_cast<std::uint64_t>(kThreads * kPerThread / 2));
+    EXPECT_EQ(table.overflow(), 0U);
+}
+
+// ---------------------------------------------------------------------------
+// RuleCounterTable_OverflowWhenFull
+//   용량을 넘는 규칙은 overflow 로 합산된다 (카운트 유실 없음).
+// ---------------------------------------------------------------------------
+TEST(RuleCounterTable, OverflowWhenFull) {
+    RuleCounterTable table;
+    for (std::size_t i = 0; i < RuleCounterTable::kCapacity + 3; ++i) {
+        table.increment("access-rule:user" + std::to_string(i));
+    }
+    std::size_t rules = 0;
+    table.for_each([&rules](std::string_view /*rule*/, std::uint64_t /*count*/) { ++rules; });
+    EXPECT_EQ(rules, RuleCounterTable::kCapacity);
+    EXPECT_EQ(table.overflow(), 3U);
+}
+
+// ---------------------------------------------------------------------------
+// RenderOpenMetrics_ContainsSnapshotAndRuleCounters
+//   카운터/게이지/지연 summary/규칙 카운터가 OpenMetrics 형식으로 출력되어야 한다.
+// ---------------------------------------------------------------------------
+TEST(MetricsExporter, RenderOpenMetrics_ContainsSnapshotAndRuleCounters) {
+    StatsCollector stats;
+    stats.on_connection_open();
+    stats.on_query(false);
+    stats.on_query(true);
+    stats.on_rule_block("block-statement");
+    stats.on_rule_block("access-rule:we\"ird");
+    stats.on_latency(LatencyStage::kParse, std::chrono::microseconds{5});
+
+    const auto snap = stats.snapshot();
+    std::string out;
+    render_openmetrics(snap, stats.rule_blocks(), out);
+
+    EXPECT_NE(out.find("# TYPE dbgate_queries counter\n"), std::string::npos);
+    EXPECT_NE(out.find("\ndbgate_queries_total 2\n"), std::string::npos);
+    EXPECT_NE(out.find("\ndbgate_queries_blocked_total 1\n"), std::string::npos);
+    EXPECT_NE(out.find("\ndbgate_active_sessions 1\n"), std::string::npos);
+    EXPECT_NE(out.find("dbgate_qps{window=\"60s\"} "), std::string::npos);
+    EXPECT_NE(out.find("dbgate_stage_latency_seconds_count{stage=\"parse\"} 1\n"),
+              std::string::npos);
+    EXPECT_NE(out.find("dbgate_stage_latency_seconds{stage=\"parse\",quantile=\"0.99\"} "),
+              std::string::npos);
+    EXPECT_NE(out.find("dbgate_rule_blocks_total{rule=\"block-statement\"} 1\n"),
+              std::string::npos);
+    EXPECT_NE(out.find(R"(dbgate_rule_blocks_total{rule="access-rule:we\"ird"} 1)"),
+              std::string::npos);
+    ASSERT_GE(out.size(), 6U);
+    EXPECT_EQ(out.substr(out.size() - 6), "# EOF\n");
+
+    // 두 번째 렌더는 기존 내용을 지우고 capacity 를 재사용한다
+    const auto* data = out.data();
+    const auto size = out.size();
+    render_openmetrics(snap, stats.rule_blocks(), out);
+    EXPECT_EQ(out.size(), size);
+    EXPECT_EQ(out.data(), data);
+}
+
+TEST(MetricsExporter, ResultRowsLimitedCounter) {
+    StatsCollector stats;
+    stats.on_result_rows_limited();
+    stats.on_result_rows_limited();
+
+    const auto snap = stats.snapshot();
+    EXPECT_EQ(snap.result_rows_limited, 2U);
+
+    std::string out;
+    render_openmetrics(snap, stats.rule_blocks(), out);
+    EXPECT_NE(out.find("\ndbgate_result_rows_limited_total 2\n"), std::string::npos);
+}
+
+// ---------------------------------------------------------------------------
+// SessionRegistry
+// ---------------------------------------------------------------------------
+TEST(SessionRegistry, SnapshotReflectsPerSessionCounters) {
+    SessionRegistry registry;
+    const auto connected = std::chrono::system_clock::time_point{std::chrono::milliseconds{1000}};
+    auto a = registry.add(7, connected);
+    auto b = registry.add(3, connected);
+    EXPECT_EQ(registry.size(), 2U);
+
+    SessionContext ctx{};
+    ctx.session_id = 7;
+    ctx.client_ip = "10.0.0.5";
+    ctx.client_port = 51234;
+    ctx.db_user = "app";
+    ctx.db_name = "shop";
+    a->publish_context(ctx);
+    a->set_state(SessionState::kProcessingQuery);
+    a->add_bytes_in(40);
+    a->add_bytes_out(1000);
+    a->on_query(false, std::chrono::system_clock::time_point{std::chrono::milliseconds{5000}});
+    a->on_query(true, std::chrono::system_clock::time_point{std::chrono::milliseconds{6000}});
+
+    const auto views = registry.snapshot(10);
+    ASSERT_EQ(views.size(), 2U);
+    // session_id 오름차순
+    EXPECT_EQ(views[0].session_id, 3U);
+    EXPECT_EQ(views[0].state, SessionState::kHandshaking);
+    EXPECT_TRUE(views[0].client_ip.empty());
+    EXPECT_EQ(views[0].last_query_at_ms, 0);
+
+    const auto& v = views[1];
+    EXPECT_EQ(v.session_id, 7U);
+    EXPECT_EQ(v.client_ip, "10.0.0.5");
+    EXPECT_EQ(v.client_port, 51234);
+    EXPECT_EQ(v.db_user, "app");
+    EXPECT_EQ(v.db_name, "shop");
+    EXPECT_EQ(v.state, SessionState::kProcessingQuery);
+    EXPECT_EQ(v.queries, 2U);
+    EXPECT_EQ(v.blocked, 1U);
+    EXPECT_EQ(v.bytes_in, 40U);
+    EXPECT_EQ(v.bytes_out, 1000U);
+    EXPECT_EQ(v.connected_at_ms, 1000);
+    EXPECT_EQ(v.last_query_at_ms, 6000);
+    EXPECT_EQ(session_state_name(v.state), "processing_query");
+}
+
+TEST(SessionRegistry, RemoveAndLimit) {
+    SessionRegistry registry;
+    for (std::uint64_t id = 1; id <= 40; ++id) {
+        (void)registry.add(id);
+    }
+    registry.remove(3);
+    registry.remove(3);  // 중복 제거는 no-op
+    registry.remove(999);
+    EXPECT_EQ(registry.size(), 39U);
+
+    const auto views = registry.snapshot(4);
+    ASSERT_EQ(views.size(), 4U);
+    EXPECT_EQ(views[0].session_id, 1U);
+    EXPECT_EQ(views[2].session_id, 4U);
+    EXPECT_EQ(views[3].session_id, 5U);
+
+    // 제거된 뒤에도 세션이 쥔 블록은 유효하다 (Session 이 공유 소유)
+    auto held = registry.add(100);
+    registry.remove(100);
+    held->on_query(false, std::chrono::system_clock::now());
+    EXPECT_EQ(held->view().queries, 1U);
+    EXPECT_EQ(registry.snapshot(100).size(), 39U);
+}
+
+TEST(SessionRegistry, ConcurrentUpdatesAndSnapshots) {
+    SessionRegistry registry;
+    constexpr int kThreads = 4;
+    constexpr int kQueries = 2000;
+    std::atomic<bool> done{false};
+
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            for (const auto& v : registry.snapshot(100)) {
+                EXPECT_LE(v.blocked, v.queries);
+            }
+        }
+    });
+
+    std::vector<std::thread> writers;
+    writers.reserve(kThreads);
+    for (int t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&registry, t] {
+            auto stats = registry.add(static_cast<std::uint64_t>(t + 1));
+            SessionContext ctx{};
+            ctx.db_user = "user" + std::to_string(t);
+            stats->publish_context(ctx);
+            for (int i = 0; i < kQueries; ++i) {
+                stats->on_query(false, std::chrono::system_clock::now());
+                stats->add_bytes_in(10);
+            }
+        });
+    }
+    for (auto& w : writers) {
+        w.join();
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    const auto views = registry.snapshot(100);
+    ASSERT_EQ(views.size(), static_cast<std::size_t>(kThreads));
+    for (const auto& v : views) {
+        EXPECT_EQ(v.queries, static_cast<std::uint64_t>(kQueries));
+        EXPECT_EQ(v.bytes_in, static_cast<std::uint64_t>(kQueries) * 10U);
+        EXPECT_EQ(v.db_user, "user" + std::to_string(v.session_id - 1));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// UserAccounting
+// ---------------------------------------------------------------------------
+namespace {
+
+std::shared_ptr<SessionStats> add_user_session(SessionRegistry& registry,
+                                               std::uint64_t id,
+                                               const std::string& user) {
+    auto stats = registry.add(id);
+    SessionContext ctx{};
+    ctx.db_user = user;
+    stats->publish_context(ctx);
+    return stats;
+}
+
+const UserTotals* find_user(const UserAccountingSnapshot& snap, const std::string& user) {
+    for (const auto& u : snap.users) {
+        if (u.db_user == user) {
+            return &u;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+TEST(UserAccounting, MergesLiveAndRetiredSessionsPerUser) {
+    SessionRegistry registry;
+    UserAccounting accounting;
+    EXPECT_TRUE(accounting.snapshot()->users.empty());
+
+    auto a1 = add_user_session(registry, 1, "app");
+    auto a2 = add_user_session(registry, 2, "app");
+    auto b1 = add_user_session(registry, 3, "batch");
+    (void)registry.add(4);  // 핸드셰이크 전 세션 → "" 키
+    a1->on_query(false, std::chrono::system_clock::now());
+    a1->add_bytes_in(10);
+    a2->on_query(true, std::chrono::system_clock::now());
+    a2->add_bytes_out(300);
+    a2->add_upstream_time(std::chrono::milliseconds{2});
+    b1->add_bytes_out(9000);
+
+    // a1 종료: remove 후 retire (ProxyServer 완료 콜백 순서)
+    accounting.retire(*registry.remove(1));
+    accounting.refresh(registry, std::chrono::system_clock::time_point{std::chrono::seconds{7}});
+
+    const auto snap = accounting.snapshot();
+    EXPECT_EQ(snap->captured_at_ms, 7000);
+    ASSERT_EQ(snap->users.size(), 3U);
+    EXPECT_EQ(snap->users[0].db_user, "");  // db_user 오름차순
+
+    const auto* app = find_user(*snap, "app");
+    ASSERT_NE(app, nullptr);
+    EXPECT_EQ(app->sessions, 2U);
+    EXPECT_EQ(app->active_sessions, 1U);
+    EXPECT_EQ(app->queries, 2U);
+    EXPECT_EQ(app->blocked, 1U);
+    EXPECT_EQ(app->bytes_in, 10U);
+    EXPECT_EQ(app->bytes_out, 300U);
+    EXPECT_EQ(app->upstream_us, 2000U);
+
+    // 두 번째 refresh 는 retired 값을 중복 합산하지 않는다
+    accounting.refresh(registry);
+    const auto* app2 = find_user(*accounting.snapshot(), "app");
+    ASSERT_NE(app2, nullptr);
+    EXPECT_EQ(app2->queries, 2U);
+    EXPECT_EQ(app2->sessions, 2U);
+
+    const auto top = top_users(accounting.snapshot()->users, UserSortKey::kBytesOut, 1);
+    ASSERT_EQ(top.size(), 1U);
+    EXPECT_EQ(top[0].db_user, "batch");
+}
+
+TEST(UserAccounting, TopUsersTieBreakAndSortKeys) {
+    std::vector<UserTotals> users(3);
+    users[0].db_user = "c";
+    users[0].queries = 5;
+    users[1].db_user = "a";
+    users[1].queries = 5;
+    users[2].db_user = "b";
+    users[2].queries = 9;
+    users[2].upstream_us = 1;
+
+    const auto top = top_users(users, UserSortKey::kQueries, 10);
+    ASSERT_EQ(top.size(), 3U);
+    EXPECT_EQ(top[0].db_user, "b");
+    EXPECT_EQ(top[1].db_user, "a");  // 동률은 이름순
+    EXPECT_EQ(top[2].db_user, "c");
+
+    EXPECT_EQ(parse_user_sort_key("upstream_us"), UserSortKey::kUpstreamTime);
+    EXPECT_EQ(parse_user_sort_key("bytes_in"), UserSortKey::kBytesIn);
+    EXPECT_FALSE(parse_user_sort_key("QUERIES").has_value());
+    EXPECT_TRUE(top_users(users, UserSortKey::kSessions, 0).empty());
+}
+
+// ---------------------------------------------------------------------------
+// QueryTopK
+//   해시 상위 8bit 가 샤드를 고르므로, 테스트는 상위 바이트가 0 인 해시로 샤드 0 만 쓴다.
+// ---------------------------------------------------------------------------
+namespace {
+
+const QueryTopEntry* find_query(const QueryTopKSnapshot& snap, std::uint64_t hash) {
+    for (const auto& e : snap.entries) {
+        if (e.hash == hash) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+TEST(QueryTopK, CountsBlockedAndLatencyPerFingerprint) {
+    QueryTopK topk{64};
+    EXPECT_TRUE(topk.enabled());
+    EXPECT_EQ(topk.capacity(), 64U);
+
+    topk.record(1, "SELECT * FROM t WHERE id = ?", false);
+    topk.record(1, "SELECT * FROM t WHERE id = ?", false);
+    topk.record(1, "SELECT * FROM t WHERE id = ?", true);
+    topk.record(2, "DELETE FROM t", true);
+    topk.record_untracked();
+    for (int us = 1; us <= 100; ++us) {
+        topk.record_latency(1, std::chrono::microseconds{us});
+    }
+    topk.record_latency(99, std::chrono::seconds{1});  // 추적하지 않는 형태 → 버림
+
+    const auto snap = topk.snapshot();
+    EXPECT_EQ(snap.capacity, 64U);
+    EXPECT_EQ(snap.recorded, 4U);
+    EXPECT_EQ(snap.untracked, 1U);
+    ASSERT_EQ(snap.entries.size(), 2U);
+
+    const auto* select = find_query(snap, 1);
+    ASSERT_NE(select, nullptr);
+    EXPECT_EQ(select->fingerprint, "SELECT * FROM t WHERE id = ?");
+    EXPECT_EQ(select->count, 3U);
+    EXPECT_EQ(select->error, 0U);
+    EXPECT_EQ(select->blocked, 1U);
+    EXPECT_EQ(select->latency_count, 100U);
+    EXPECT_EQ(select->upstream_us, 5050U);
+    EXPECT_EQ(select->max_us, 100U);
+    // 버킷 상한으로 보고한다 (상대 오차 ≤ 25%, 실제보다 작지 않음)
+    EXPECT_GE(select->p50_us, 50U);
+    EXPECT_LE(select->p50_us, 63U);
+    EXPECT_GE(select->p99_us, 99U);
+    EXPECT_LE(select->p99_us, 100U);
+
+    const auto* del = find_query(snap, 2);
+    ASSERT_NE(del, nullptr);
+    EXPECT_EQ(del->blocked, 1U);
+    EXPECT_EQ(del->latency_count, 0U);
+    EXPECT_EQ(del->p99_us, 0U);
+}
+
+TEST(QueryTopK, SpaceSavingKeepsHeavyHittersWithinErrorBound) {
+    QueryTopK topk{64};  // 샤드당 4개
+    // 샤드 0: 상위 형태 3개 × 200회 + 1회성 형태 100개 (N=700, N/k=175)
+    for (std::uint64_t i = 0; i < 200; ++i) {
+        for (std::uint64_t hot = 1; hot <= 3; ++hot) {
+            topk.record(hot, "hot", false);
+        }
+        if (i < 100) {
+            topk.record(1000 + i, "once", false);
+        }
+    }
+
+    const auto snap = topk.snapshot();
+    EXPECT_EQ(snap.entries.size(), 4U);  // 샤드 용량으로 고정
+    const auto top = top_queries(snap.entries, QuerySortKey::kCount, 3);
+    ASSERT_EQ(top.size(), 3U);
+    for (const auto& e : top) {
+        EXPECT_GE(e.hash, 1U);  // N/k 를 넘는 형태는 반드시 남는다
+        EXPECT_LE(e.hash, 3U);
+        EXPECT_GE(e.count, 200U);  // 과대 추정만 한다
+        EXPECT_LE(e.count - e.error, 200U);
+    }
+    std::uint64_t total = 0;
+    for (const auto& e : snap.entries) {
+        total += e.count;
+    }
+    EXPECT_EQ(total, 700U);  // Space-Saving: 카운트 합 = 전체 건수
+}
+
+TEST(QueryTopK, ReplacedCounterStartsFreshStats) {
+    QueryTopK topk{16};  // 샤드당 1개
+    topk.record(1, "SELECT 1", true);
+    topk.record_latency(1, std::chrono::milliseconds{5});
+
+    topk.record(2, std::string(QueryTopK::kMaxFingerprintText + 10, 'x'), false);
+    topk.record_latency(1, std::chrono::milliseconds{5});  // 넘겨준 형태 → 버림
+
+    const auto snap = topk.snapshot();
+    ASSERT_EQ(snap.entries.size(), 1U);
+    const auto& e = snap.entries[0];
+    EXPECT_EQ(e.hash, 2U);
+    EXPECT_EQ(e.count, 2U);
+    EXPECT_EQ(e.error, 1U);
+    EXPECT_EQ(e.blocked, 0U);
+    EXPECT_EQ(e.latency_count, 0U);
+    EXPECT_TRUE(e.truncated);
+    EXPECT_EQ(e.fingerprint.size(), QueryTopK::kMaxFingerprintText);
+}
+
+TEST(QueryTopK, DisabledAndSortKeys) {
+    QueryTopK disabled{0};
+    EXPECT_FALSE(disabled.enabled());
+    disabled.record(1, "SELECT 1", false);
+    disabled.record_untracked();
+    EXPECT_TRUE(disabled.snapshot().entries.empty());
+    EXPECT_EQ(disabled.snapshot().recorded, 0U);
+
+    EXPECT_NE(QueryTopK::hash_fingerprint(""), 0U);
+    EXPECT_EQ(QueryTopK::hash_fingerprint("SELECT ?"), QueryTopK::hash_fingerprint("SELECT ?"));
+
+    std::vector<QueryTopEntry> entries(3);
+    entries[0].hash = 1;
+    entries[0].count = 10;
+    entries[0].upstream_us = 5;
+    entries[1].hash = 2;
+    entries[1].count = 3;
+    entries[1].upstream_us = 900;
+    entries[2].hash = 3;
+    entries[2].count = 7;
+    entries[2].p99_us = 40;
+    EXPECT_EQ(top_queries(entries, QuerySortKey::kUpstreamTime, 1)[0].hash, 2U);
+    EXPECT_EQ(top_queries(entries, QuerySortKey::kP99, 1)[0].hash, 3U);
+    // blocked 가 모두 0 이면 count 순
+    const auto by_blocked = top_queries(entries, QuerySortKey::kBlocked, 10);
+    ASSERT_EQ(by_blocked.size(), 3U);
+    EXPECT_EQ(by_blocked[0].hash, 1U);
+    EXPECT_EQ(by_blocked[2].hash, 2U);
+
+    EXPECT_EQ(parse_query_sort_key("upstream_us"), QuerySortKey::kUpstreamTime);
+    EXPECT_EQ(parse_query_sort_key("p99_us"), QuerySortKey::kP99);
+    EXPECT_FALSE(parse_query_sort_key("queries").has_value());
+}
+
+TEST(QueryTopK, ConcurrentRecord) {
+    QueryTopK topk{256};
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&topk] {
+            for (int i = 0; i < kPerThread; ++i) {
+                const std::string fp = "SELECT " + std::to_string(i % 8);
+                const auto hash = QueryTopK::hash_fingerprint(fp);
+                topk.record(hash, fp, i % 2 == 0);
+                topk.record_latency(hash, std::chrono::microseconds{i % 100});
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    const auto snap = topk.snapshot();
+    EXPECT_EQ(snap.recorded, static_cast<std::uint64_t>(kThreads) * kPerThread);
+    std::uint64_t total = 0;
+    std::uint64_t latency = 0;
+    for (const auto& e : snap.entries) {
+        total += e.count;
+        latency += e.latency_count;
+    }
+    EXPECT_EQ(total, snap.recorded);
+    EXPECT_EQ(latency, snap.recorded);
+}
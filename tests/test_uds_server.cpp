@@ -15,6 +15,10 @@
 // - 잘못된 프레임(0-length body, 과대 body length) → 서버가 안전하게 처리
 // - 여러 클라이언트 동시 접속 → 각자 올바른 응답 수신
 // - run() 전 stop() 호출 → 크래시/hang 없음
+// - 한 연결로 여러 요청 (지속 연결), JSON 문법 오류는 해당 요청만 거절
+// - "subscribe" → 전체 스냅샷 후 델타 푸시, 잘못된 interval/topic 거절
+// - "top_queries" → fingerprint 별 sort 상위 limit 개, 미주입은 not-implemented
+// - control_json 파서 (최상위 필드만 인정, 문법 오류 거절, 오브젝트 델타)
 //
 // [테스트 패턴]
 // - 각 테스트는 임시 소켓 경로(/tmp/test_uds_<pid>_<N>.sock)를 사용한다.
@@ -33,6 +37,7 @@
 // ---------------------------------------------------------------------------
 
 #include <gtest/gtest.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -46,20 +51,28 @@
 #include <boost/asio/write.hpp>
 #include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <vector>
 
+#include "common/fd_passing.hpp"
 #include "parser/sql_parser.hpp"
 #include "policy/policy_engine.hpp"
 #include "policy/policy_version_store.hpp"
 #include "policy/rule.hpp"
+#include "proxy/listener_handoff.hpp"
+#include "stats/control_json.hpp"
+#include "stats/query_topk.hpp"
+#include "stats/session_registry.hpp"
 #include "stats/stats_collector.hpp"
 #include "stats/uds_server.hpp"
+#include "stats/user_accounting.hpp"
 
 namespace asio = boost::asio;
 using stream_protocol = asio::local::stream_protocol;
@@ -449,6 +462,26 @@ TEST_F(UdsServerTest, StopBeforeRun_NoCrash) {
     ASSERT_NO_THROW(server_->stop()) << "stop() before run() must not throw or crash";
 }
 
+// ---------------------------------------------------------------------------
+// ControlExecutor_RunsOffIoContextThread
+//   SIGHUP reload 등 관리 작업은 control_executor() 워커에서 실행되어야 한다
+//   (데이터패스 io_context 스레드를 막지 않음).
+// ---------------------------------------------------------------------------
+TEST_F(UdsServerTest, ControlExecutor_RunsOffIoContextThread) {
+    std::promise<std::thread::id> io_thread;
+    std::promise<std::thread::id> control_thread;
+    asio::post(*ioc_, [&io_thread] { io_thread.set_value(std::this_thread::get_id()); });
+    asio::post(server_->control_executor(),
+               [&control_thread] { control_thread.set_value(std::this_thread::get_id()); });
+    start_server();
+
+    auto io_id = io_thread.get_future();
+    auto control_id = control_thread.get_future();
+    ASSERT_EQ(io_id.wait_for(std::chrono::seconds{2}), std::future_status::ready);
+    ASSERT_EQ(control_id.wait_for(std::chrono::seconds{2}), std::future_status::ready);
+    EXPECT_NE(control_id.get(), io_id.get());
+}
+
 // ---------------------------------------------------------------------------
 // CommandField_InjectedInsideStringValue_UsesTopLevelCommand
 //   JSON 문자열 값 내부에 "command": 패턴이 있을 때 top-level "command" 필드만
@@ -787,6 +820,43 @@ TEST_F(UdsPolicyExplainTest, PolicyExplain_NoPayloadField_ReturnsError) {
         << "No payload must return ok:false. Got: " << resp;
 }
 
+// ---------------------------------------------------------------------------
+// PolicyStats_ReturnsPerRuleCounters
+//   policy_stats 는 access rule / block pattern 별 카운터를 반환해야 한다.
+//
+//   [검증 포인트]
+//   - "ok":true, "access_rules" / "block_patterns" / "no_access_rule" 포함
+//   - access rule 이름은 "user@cidr" 형식
+//   - 엔진 평가 후 hits 가 반영됨
+// ---------------------------------------------------------------------------
+TEST_F(UdsPolicyExplainTest, PolicyStats_ReturnsPerRuleCounters) {
+    SessionContext session{};
+    session.db_user = "app_service";
+    session.client_ip = "172.16.0.1";
+    ParsedQuery query{};
+    query.command = SqlCommand::kSelect;
+    query.tables = {"users"};
+    query.raw_sql = "SELECT * FROM users";
+    (void)policy_engine_->evaluate(query, session);
+
+    start_server();
+    ASSERT_TRUE(wait_for_socket()) << "UDS socket not created within 2s";
+
+    UdsSyncClient client;
+    ASSERT_NO_THROW(client.connect(socket_path_));
+    client.send(R"({"command":"policy_stats","version":1})");
+
+    const std::string resp = client.recv();
+    ASSERT_FALSE(resp.empty());
+    EXPECT_NE(resp.find(R"("ok":true)"), std::string::npos) << "Got: " << resp;
+    EXPECT_NE(resp.find(R"("access_rules")"), std::string::npos) << "Got: " << resp;
+    EXPECT_NE(resp.find(R"("block_patterns")"), std::string::npos) << "Got: " << resp;
+    EXPECT_NE(resp.find(R"("no_access_rule")"), std::string::npos) << "Got: " << resp;
+    EXPECT_NE(resp.find(R"("rule":"app_service@172.16.0.0/12")"), std::string::npos)
+        << "Got: " << resp;
+    EXPECT_NE(resp.find(R"("hits":1)"), std::string::npos) << "Got: " << resp;
+}
+
 // ---------------------------------------------------------------------------
 // PolicyExplain_WithoutPolicyEngine_ReturnsNotImplemented
 //   policy_engine 없이 생성된 UdsServer 에서 policy_explain 커맨드는
@@ -1697,3 +1767,506 @@ TEST_F(UdsServerTest, ConnectionCounter_DecrementOnDisconnect) {
         EXPECT_NE(resp2.find(R"("ok":true)"), std::string::npos);
     }
 }
+
+// ---------------------------------------------------------------------------
+// Sessions_WithoutRegistry_ReturnsNotImplemented
+//   set_session_registry() 를 호출하지 않은 서버의 "sessions" 는 501 응답.
+// ---------------------------------------------------------------------------
+TEST_F(UdsServerTest, Sessions_WithoutRegistry_ReturnsNotImplemented) {
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    UdsSyncClient client;
+    ASSERT_NO_THROW(client.connect(socket_path_));
+    client.send(R"({"command":"sessions","version":1})");
+
+    const std::string resp = client.recv();
+    EXPECT_NE(resp.find(R"("ok":false)"), std::string::npos) << resp;
+    EXPECT_NE(resp.find("501"), std::string::npos) << resp;
+}
+
+// ---------------------------------------------------------------------------
+// Sessions_ListsRegisteredSessions
+//   등록된 세션의 식별 정보/카운터가 session_id 순서로 직렬화되고,
+//   문자열 필드는 JSON 이스케이프된다.
+// ---------------------------------------------------------------------------
+TEST_F(UdsServerTest, Sessions_ListsRegisteredSessions) {
+    auto registry = std::make_shared<SessionRegistry>();
+    auto first = registry->add(2, std::chrono::system_clock::time_point{});
+    auto second = registry->add(9, std::chrono::system_clock::time_point{});
+
+    SessionContext ctx{};
+    ctx.client_ip = "10.1.2.3";
+    ctx.client_port = 4000;
+    ctx.db_user = R"(we"ird)";
+    ctx.db_name = "shop";
+    first->publish_context(ctx);
+    first->set_state(SessionState::kReady);
+    first->on_query(true, std::chrono::system_clock::time_point{std::chrono::milliseconds{42}});
+    first->add_bytes_out(512);
+
+    server_->set_session_registry(registry);
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    UdsSyncClient client;
+    ASSERT_NO_THROW(client.connect(socket_path_));
+    client.send(R"({"command":"sessions","version":1})");
+
+    const std::string resp = client.recv();
+    EXPECT_NE(resp.find(R"("ok":true)"), std::string::npos) << resp;
+    EXPECT_NE(resp.find(R"("total":2,"truncated":false)"), std::string::npos) << resp;
+    EXPECT_NE(resp.find(R"("session_id":2,"client_ip":"10.1.2.3","client_port":4000,)"
+                        R"("db_user":"we\"ird","db_name":"shop","state":"ready","queries":1,)"
+                        R"("blocked":1,"bytes_in":0,"bytes_out":512,"upstream_us":0,)"
+                        R"("connected_at_ms":0,"last_query_at_ms":42})"),
+              std::string::npos)
+        << resp;
+    const auto pos_first = resp.find(R"("session_id":2)");
+    const auto pos_second = resp.find(R"("session_id":9)");
+    ASSERT_NE(pos_second, std::string::npos) << resp;
+    EXPECT_LT(pos_first, pos_second);
+    EXPECT_NE(resp.find(R"("state":"handshaking")"), std::string::npos) << resp;
+}
+
+// ---------------------------------------------------------------------------
+// UserStats_TopNBySortKey
+//   user_stats 는 게시된 사용자 테이블에서 sort 내림차순 상위 limit 개를 반환하고,
+//   알 수 없는 sort 는 ok:false, accounting 미주입은 501 로 응답한다.
+// ---------------------------------------------------------------------------
+TEST_F(UdsServerTest, UserStats_TopNBySortKey) {
+    auto registry = std::make_shared<SessionRegistry>();
+    auto accounting = std::make_shared<UserAccounting>();
+    const auto add_session = [&](std::uint64_t id, const char* user, std::size_t bytes_out) {
+        auto stats = registry->add(id);
+        SessionContext ctx{};
+        ctx.db_user = user;
+        stats->publish_context(ctx);
+        stats->add_bytes_out(bytes_out);
+        stats->on_query(false, std::chrono::system_clock::now());
+    };
+    add_session(1, "app", 100);
+    add_session(2, "batch", 5000);
+    add_session(3, "app", 200);
+    accounting->refresh(*registry);
+
+    server_->set_user_accounting(accounting);
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    {
+        UdsSyncClient client;
+        ASSERT_NO_THROW(client.connect(socket_path_));
+        client.send(
+            R"({"command":"user_stats","version":1,"payload":{"sort":"bytes_out","limit":1}})");
+        const std::string resp = client.recv();
+        EXPECT_NE(resp.find(R"("total_users":2,"sort":"bytes_out","users":[{"db_user":"batch",)"
+                            R"("active_sessions":1,"sessions":1,"queries":1,"blocked":0,)"
+                            R"("bytes_in":0,"bytes_out":5000,"upstream_us":0}]})"),
+                  std::string::npos)
+            << resp;
+    }
+    {
+        UdsSyncClient client;
+        ASSERT_NO_THROW(client.connect(socket_path_));
+        client.send(R"({"command":"user_stats","version":1})");
+        const std::string resp = client.recv();
+        // 기본 정렬은 queries: app(2) 가 먼저
+        const auto pos_app = resp.find(R"("db_user":"app","active_sessions":2)");
+        const auto pos_batch = resp.find(R"("db_user":"batch")");
+        ASSERT_NE(pos_app, std::string::npos) << resp;
+        EXPECT_LT(pos_app, pos_batch) << resp;
+    }
+    {
+        UdsSyncClient client;
+        ASSERT_NO_THROW(client.connect(socket_path_));
+        client.send(R"({"command":"user_stats","version":1,"payload":{"sort":"nope"}})");
+        const std::string resp = client.recv();
+        EXPECT_NE(resp.find(R"("ok":false)"), std::string::npos) << resp;
+    }
+}
+
+TEST_F(UdsServerTest, UserStats_WithoutAccounting_ReturnsNotImplemented) {
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    UdsSyncClient client;
+    ASSERT_NO_THROW(client.connect(socket_path_));
+    client.send(R"({"command":"user_stats","version":1})");
+
+    const std::string resp = client.recv();
+    EXPECT_NE(resp.find("501"), std::string::npos) << resp;
+}
+
+// ---------------------------------------------------------------------------
+// TopQueries_TopNBySortKey
+//   top_queries 는 QueryTopK 카운터를 sort 내림차순 상위 limit 개로 직렬화하고
+//   (fingerprint 는 JSON 이스케이프), 알 수 없는 sort 는 ok:false, 미주입은 501 로 응답한다.
+// ---------------------------------------------------------------------------
+TEST_F(UdsServerTest, TopQueries_TopNBySortKey) {
+    auto topk = std::make_shared<QueryTopK>(64);
+    const std::string hot = R"(SELECT * FROM t WHERE name = '?' AND id = \?)";
+    const auto hot_hash = QueryTopK::hash_fingerprint(hot);
+    for (int i = 0; i < 3; ++i) {
+        topk->record(hot_hash, hot, false);
+        topk->record_latency(hot_hash, std::chrono::microseconds{100});
+    }
+    const auto slow_hash = QueryTopK::hash_fingerprint("SELECT SLEEP(?)");
+    topk->record(slow_hash, "SELECT SLEEP(?)", false);
+    topk->record_latency(slow_hash, std::chrono::milliseconds{2});
+    topk->record_untracked();
+
+    server_->set_query_topk(topk);
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    UdsSyncClient client;
+    ASSERT_NO_THROW(client.connect(socket_path_));
+    {
+        client.send(R"({"command":"top_queries","version":1,"payload":{"limit":1}})");
+        const std::string resp = client.recv();
+        EXPECT_NE(resp.find(R"("capacity":64,"tracked":2,"recorded":4,"untracked":1,)"
+                            R"("sort":"count","queries":[{"id":")"),
+                  std::string::npos)
+            << resp;
+        EXPECT_NE(resp.find(R"("fingerprint":"SELECT * FROM t WHERE name = '?' AND id = \\?",)"
+                            R"("truncated":false,"count":3,"error":0,"blocked":0,)"
+                            R"("latency_count":3,"upstream_us":300,"avg_us":100.0,)"
+                            R"("p50_us":100,"p99_us":100,"max_us":100}]})"),
+                  std::string::npos)
+            << resp;
+    }
+    {
+        client.send(
+            R"({"command":"top_queries","version":1,"payload":{"sort":"upstream_us","limit":5}})");
+        const std::string resp = client.recv();
+        const auto pos_slow = resp.find(R"("fingerprint":"SELECT SLEEP(?)");
+        const auto pos_hot = resp.find(R"("count":3)");
+        ASSERT_NE(pos_slow, std::string::npos) << resp;
+        EXPECT_LT(pos_slow, pos_hot) << resp;
+    }
+    {
+        client.send(R"({"command":"top_queries","version":1,"payload":{"sort":"nope"}})");
+        const std::string resp = client.recv();
+        EXPECT_NE(resp.find(R"("ok":false)"), std::string::npos) << resp;
+    }
+}
+
+TEST_F(UdsServerTest, TopQueries_WithoutTopK_ReturnsNotImplemented) {
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    UdsSyncClient client;
+    ASSERT_NO_THROW(client.connect(socket_path_));
+    client.send(R"({"command":"top_queries","version":1})");
+
+    const std::string resp = client.recv();
+    EXPECT_NE(resp.find("501"), std::string::npos) << resp;
+}
+
+// ---------------------------------------------------------------------------
+// Drain_WithoutControl_ReturnsNotImplemented / Drain_StartsDrainWithoutHandoff
+//   drain 은 ProxyServer 가 DrainControl 을 연결했을 때만 동작하고, 인계 없이 시작된다.
+// ---------------------------------------------------------------------------
+TEST_F(UdsServerTest, Drain_WithoutControl_ReturnsNotImplemented) {
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    UdsSyncClient client;
+    ASSERT_NO_THROW(client.connect(socket_path_));
+    client.send(R"({"command":"drain","version":1})");
+
+    const std::string resp = client.recv();
+    EXPECT_NE(resp.find("501"), std::string::npos) << resp;
+}
+
+TEST_F(UdsServerTest, Drain_StartsDrainWithoutHandoff) {
+    std::promise<bool> handed_off;
+    auto drained = handed_off.get_future();
+    server_->set_drain_control(DrainControl{
+        .listener_fds = [](std::uint16_t) { return std::vector<int>{}; },
+        .begin_drain = [&handed_off](std::string_view,
+                                     bool handed) { handed_off.set_value(handed); },
+    });
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    UdsSyncClient client;
+    ASSERT_NO_THROW(client.connect(socket_path_));
+    client.send(R"({"command":"drain","version":1})");
+
+    const std::string resp = client.recv();
+    EXPECT_NE(resp.find(R"("ok":true,"payload":{"draining":true})"), std::string::npos) << resp;
+    ASSERT_EQ(drained.wait_for(std::chrono::seconds{2}), std::future_status::ready);
+    EXPECT_FALSE(drained.get());
+}
+
+// ---------------------------------------------------------------------------
+// ListenerHandoff_PassesListenerAndStartsDrain
+//   request_listener_handoff 는 SCM_RIGHTS 로 복제된 listening 소켓을 받고,
+//   넘긴 쪽은 handed_off=true 로 drain 을 시작한다. 두 번째 인계 요청은 거부된다.
+// ---------------------------------------------------------------------------
+TEST_F(UdsServerTest, ListenerHandoff_PassesListenerAndStartsDrain) {
+    asio::io_context listener_ioc;
+    asio::ip::tcp::acceptor listener{listener_ioc, {asio::ip::address_v4::loopback(), 0}};
+    const auto port = listener.local_endpoint().port();
+
+    std::promise<bool> handed_off;
+    auto drained = handed_off.get_future();
+    server_->set_drain_control(DrainControl{
+        .listener_fds =
+            [&listener, port](std::uint16_t requested) {
+                return requested == port ? std::vector<int>{listener.native_handle()}
+                                         : std::vector<int>{};
+            },
+        .begin_drain = [&handed_off](std::string_view,
+                                     bool handed) { handed_off.set_value(handed); },
+    });
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    auto fds = request_listener_handoff(socket_path_, port, std::chrono::seconds{2});
+    ASSERT_TRUE(fds) << fds.error();
+    ASSERT_EQ(fds->size(), 1U);
+    EXPECT_NE(fds->front(), listener.native_handle());
+
+    const auto endpoint = inspect_listener_fd(fds->front());
+    ASSERT_TRUE(endpoint) << endpoint.error();
+    EXPECT_EQ(endpoint->port(), port);
+    (void)::close(fds->front());  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+
+    ASSERT_EQ(drained.wait_for(std::chrono::seconds{2}), std::future_status::ready);
+    EXPECT_TRUE(drained.get());
+
+    auto again = request_listener_handoff(socket_path_, port, std::chrono::seconds{2});
+    EXPECT_FALSE(again);
+}
+
+// ---------------------------------------------------------------------------
+// ListenerHandoff_PortMismatch_Rejected
+//   요청 포트가 다르면 fd 를 보내지 않고 drain 도 시작하지 않는다.
+// ---------------------------------------------------------------------------
+TEST_F(UdsServerTest, ListenerHandoff_PortMismatch_Rejected) {
+    std::atomic<bool> drain_started{false};
+    server_->set_drain_control(DrainControl{
+        .listener_fds = [](std::uint16_t) { return std::vector<int>{}; },
+        .begin_drain = [&drain_started](std::string_view,
+                                        bool) { drain_started.store(true); },
+    });
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    auto fds = request_listener_handoff(socket_path_, 13306, std::chrono::seconds{2});
+    EXPECT_FALSE(fds);
+    EXPECT_FALSE(drain_started.load());
+}
+
+// ---------------------------------------------------------------------------
+// InspectListenerFd_RejectsNonListeningSocket
+//   연결용 TCP 소켓이나 UDS 는 인계 대상 리스너로 받지 않는다.
+// ---------------------------------------------------------------------------
+TEST(ListenerHandoffTest, InspectListenerFd_RejectsNonListeningSocket) {
+    const int tcp_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(tcp_fd, 0);
+    EXPECT_FALSE(inspect_listener_fd(tcp_fd));
+    (void)::close(tcp_fd);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+
+    const int unix_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(unix_fd, 0);
+    EXPECT_FALSE(inspect_listener_fd(unix_fd));
+    (void)::close(unix_fd);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+
+    EXPECT_FALSE(request_listener_handoff(
+        "/tmp/dbgate-handoff-missing.sock", 13306, std::chrono::milliseconds{200}));
+}
+
+// ---------------------------------------------------------------------------
+// TrySendWithFds_FullBuffer_ReturnsZeroWithoutBlocking
+//   소켓 버퍼가 차 있으면 기다리지 않고 0 을 반환하며 fd 도 보내지 않는다 (io 스레드 보호).
+//   버퍼가 비면 같은 호출이 프레임과 함께 fd 를 넘긴다.
+// ---------------------------------------------------------------------------
+TEST(ListenerHandoffTest, TrySendWithFds_FullBuffer_ReturnsZeroWithoutBlocking) {
+    std::array<int, 2> pair{-1, -1};
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, pair.data()), 0);
+    const int sndbuf = 4096;
+    (void)::setsockopt(pair[0], SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+
+    // 한쪽 방향 버퍼를 가득 채운다
+    const std::vector<char> filler(4096, 'x');
+    std::size_t queued = 0;
+    while (::send(pair[0], filler.data(), filler.size(), MSG_DONTWAIT | MSG_NOSIGNAL) > 0) {
+        queued += filler.size();
+    }
+    ASSERT_GT(queued, 0U);
+
+    const std::string frame{"\x05\x00\x00\x00hello", 9};
+    const std::array<int, 1> fds{pair[1]};
+    const auto start = std::chrono::steady_clock::now();
+    auto blocked = try_send_with_fds(pair[0], frame, fds);
+    ASSERT_TRUE(blocked) << blocked.error();
+    EXPECT_EQ(*blocked, 0U);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{100});
+
+    // 읽는 쪽을 비우면 같은 호출이 프레임과 fd 를 넘긴다
+    std::vector<char> sink(64U * 1024U);
+    while (::recv(pair[1], sink.data(), sink.size(), MSG_DONTWAIT) > 0) {
+    }
+    auto sent = try_send_with_fds(pair[0], frame, fds);
+    ASSERT_TRUE(sent) << sent.error();
+    EXPECT_EQ(*sent, frame.size());
+
+    std::array<char, 16> data{};
+    std::array<char, CMSG_SPACE(sizeof(int))> control{};
+    iovec iov{.iov_base = data.data(), .iov_len = data.size()};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.data();
+    msg.msg_controllen = control.size();
+    ASSERT_EQ(::recvmsg(pair[1], &msg, MSG_CMSG_CLOEXEC), static_cast<ssize_t>(frame.size()));
+    const cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    ASSERT_NE(cmsg, nullptr);
+    EXPECT_EQ(cmsg->cmsg_type, SCM_RIGHTS);
+    int received = -1;
+    std::memcpy(&received, CMSG_DATA(cmsg), sizeof(int));
+    EXPECT_GE(received, 0);
+
+    (void)::close(received);  // NOLINT(bugprone-unused-return-value,cert-err33-c)
+    (void)::close(pair[0]);   // NOLINT(bugprone-unused-return-value,cert-err33-c)
+    (void)::close(pair[1]);   // NOLINT(bugprone-unused-return-value,cert-err33-c)
+}
+
+// ---------------------------------------------------------------------------
+// ControlJson_*
+//   제어 프로토콜 파서: 최상위 멤버만 키로 인정하고, 문법 오류는 요청 전체를 거절한다.
+// ---------------------------------------------------------------------------
+TEST(ControlJsonTest, ParseControlRequest_TopLevelFieldsOnly) {
+    auto request = parse_control_request(
+        R"({"note":"x\"command\":\"policy_reload\"","nested":{"command":"policy_reload"},)"
+        R"("command":"stats","version":2,)"
+        R"("payload":{"sql":"SELECT \"a\" 😀","target_version":18446744073709551615,)"
+        R"("big":18446744073709551616,"limit":-1,"flag":true}})");
+    ASSERT_TRUE(request) << request.error();
+    EXPECT_EQ(request->command, "stats");
+    EXPECT_EQ(request->version, 2U);
+    EXPECT_EQ(request->payload.string_field("sql"), "SELECT \"a\" \xf0\x9f\x98\x80");
+    EXPECT_EQ(request->payload.uint64_field("target_version"), 18446744073709551615ULL);
+    EXPECT_FALSE(request->payload.uint64_field("big"));
+    EXPECT_FALSE(request->payload.uint64_field("limit"));
+    EXPECT_EQ(request->payload.bool_field("flag"), true);
+    EXPECT_FALSE(request->payload.string_field("target_version"));
+
+    auto without_command = parse_control_request(R"({"version":1})");
+    ASSERT_TRUE(without_command);
+    EXPECT_TRUE(without_command->command.empty());
+    EXPECT_TRUE(without_command->payload.members.empty());
+}
+
+TEST(ControlJsonTest, ParseJsonObject_RejectsMalformedInput) {
+    for (const std::string_view bad : {"",
+                                       "[]",
+                                       "{",
+                                       R"({"a":})",
+                                       R"({"a":1,})",
+                                       R"({"a":01})",
+                                       R"({"a":"\x"})",
+                                       R"({"a":1} x)",
+                                       R"({"a":tru})",
+                                       R"({"a":"\u12"})"}) {
+        EXPECT_FALSE(parse_json_object(bad)) << bad;
+    }
+    EXPECT_FALSE(parse_json_object("{\"a\":\"\x01\"}"));
+
+    const std::string too_deep =
+        "{\"a\":" + std::string(kMaxJsonDepth + 8, '[') + std::string(kMaxJsonDepth + 8, ']') + "}";
+    EXPECT_FALSE(parse_json_object(too_deep));
+    EXPECT_TRUE(parse_json_object(R"( { "a" : [1, 2.5e-3, {"b":null}], "c":false } )"));
+}
+
+TEST(ControlJsonTest, ObjectDelta_ContainsChangedAndNewMembersOnly) {
+    auto before = parse_json_object(R"({"x":1,"y":{"p":2},"z":"s"})");
+    auto after = parse_json_object(R"({"x":1,"y":{"p":3},"z":"s","w":0})");
+    ASSERT_TRUE(before);
+    ASSERT_TRUE(after);
+    EXPECT_EQ(json_object_delta(*after, *before), R"({"y":{"p":3},"w":0})");
+    EXPECT_EQ(json_object_delta(*before, *before), "{}");
+    EXPECT_EQ(json_object_delta(*before, JsonObject{}), R"({"x":1,"y":{"p":2},"z":"s"})");
+}
+
+// ---------------------------------------------------------------------------
+// PersistentConnection_MultipleRequestsOnOneSocket
+//   연결 하나로 여러 요청을 보내면 순서대로 응답한다. JSON 문법 오류는 그 요청만 거절하고
+//   연결은 유지한다.
+// ---------------------------------------------------------------------------
+TEST_F(UdsServerTest, PersistentConnection_MultipleRequestsOnOneSocket) {
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    UdsSyncClient client;
+    ASSERT_NO_THROW(client.connect(socket_path_));
+
+    for (int i = 0; i < 3; ++i) {
+        client.send(R"({"command":"stats","version":1})");
+        const std::string resp = client.recv();
+        EXPECT_NE(resp.find(R"("ok":true)"), std::string::npos) << resp;
+    }
+
+    client.send(R"({"command":"stats",)");
+    const std::string malformed = client.recv();
+    EXPECT_NE(malformed.find(R"("ok":false)"), std::string::npos) << malformed;
+    EXPECT_NE(malformed.find("malformed request JSON"), std::string::npos) << malformed;
+
+    client.send(R"({"command":"sessions","version":1})");
+    const std::string after = client.recv();
+    EXPECT_NE(after.find("501"), std::string::npos) << after;
+}
+
+// ---------------------------------------------------------------------------
+// Subscribe_PushesFullSnapshotThenDeltas
+//   subscribe 는 seq 1 에 전체 스냅샷(full:true), 이후 바뀐 최상위 필드만 보낸다.
+// ---------------------------------------------------------------------------
+TEST_F(UdsServerTest, Subscribe_PushesFullSnapshotThenDeltas) {
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    UdsSyncClient client;
+    ASSERT_NO_THROW(client.connect(socket_path_));
+    client.send(R"({"command":"subscribe","payload":{"topic":"stats","interval_ms":100}})");
+
+    const std::string first = client.recv();
+    EXPECT_NE(first.find(R"("event":"stats","seq":1,"full":true,"interval_ms":100)"),
+              std::string::npos)
+        << first;
+    EXPECT_NE(first.find(R"("total_queries":0)"), std::string::npos) << first;
+
+    stats_->on_query(false);
+    const std::string second = client.recv();
+    EXPECT_NE(second.find(R"("seq":2,"full":false)"), std::string::npos) << second;
+    EXPECT_NE(second.find(R"("total_queries":1)"), std::string::npos) << second;
+    EXPECT_EQ(second.find(R"("total_connections")"), std::string::npos) << second;
+}
+
+// ---------------------------------------------------------------------------
+// Subscribe_InvalidInterval_ReturnsErrorAndKeepsConnection
+//   범위 밖 interval_ms / 미지원 topic 은 error 응답 후 요청-응답 모드를 유지한다.
+// ---------------------------------------------------------------------------
+TEST_F(UdsServerTest, Subscribe_InvalidInterval_ReturnsErrorAndKeepsConnection) {
+    start_server();
+    ASSERT_TRUE(wait_for_socket());
+
+    UdsSyncClient client;
+    ASSERT_NO_THROW(client.connect(socket_path_));
+
+    client.send(R"({"command":"subscribe","payload":{"interval_ms":10}})");
+    const std::string too_fast = client.recv();
+    EXPECT_NE(too_fast.find("interval_ms"), std::string::npos) << too_fast;
+    EXPECT_NE(too_fast.find(R"("ok":false)"), std::string::npos) << too_fast;
+
+    client.send(R"({"command":"subscribe","payload":{"topic":"sessions"}})");
+    const std::string bad_topic = client.recv();
+    EXPECT_NE(bad_topic.find("unsupported subscribe topic"), std::string::npos) << bad_topic;
+
+    client.send(R"({"command":"stats","version":1})");
+    const std::string resp = client.recv();
+    EXPECT_NE(resp.find(R"("ok":true)"), std::string::npos) << resp;
+}
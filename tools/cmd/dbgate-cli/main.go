@@ -9,21 +9,36 @@
 //
 // Commands:
 //
-//	stats                        Print QPS, block rate, active sessions, and query counters.
-//	sessions                     List active sessions (server-side not yet implemented).
+//	stats [--watch]              Print QPS, block rate, active sessions, and query counters.
+//	sessions                     List active sessions with per-session query/byte counters.
+//	users [--sort K] [--top N]   Show the top database users by queries, bytes or upstream time.
+//	top-queries [--sort K] [--top N]
+//	                             Show the hottest / slowest statement shapes (fingerprints).
+//	drain                        Stop accepting connections and exit once sessions finish.
 //	policy reload                Trigger a policy reload and print the new version.
 //	policy explain               Dry-run SQL evaluation against the policy engine.
 //	policy versions              List all stored policy versions.
 //	policy rollback --version N  Roll back to a specific policy version.
+//	policy stats [--sort K]      Show per-rule hit counts and evaluation cost.
+//	audit [flags] <file...>      Decode a binary audit log (log_format: binary) as JSON lines.
 package main
 
 import (
+	"context"
 	"encoding/json"
+	"errors"
 	"fmt"
+	"io"
+	"net"
 	"os"
+	"os/signal"
+	"sort"
+	"strconv"
+	"syscall"
 	"text/tabwriter"
 	"time"
 
+	"github.com/dongwonkwak/dbgate/tools/internal/auditlog"
 	"github.com/dongwonkwak/dbgate/tools/internal/client"
 	"github.com/spf13/cobra"
 )
@@ -57,20 +72,78 @@ provides commands to inspect statistics, list sessions, and reload policies.`,
 	root.PersistentFlags().DurationVar(&timeout, "timeout", defaultTimeout, "Timeout for UDS requests")
 
 	// stats subcommand
+	var statsWatch bool
+	var statsInterval time.Duration
 	statsCmd := &cobra.Command{
 		Use:   "stats",
 		Short: "Print proxy statistics (QPS, block rate, active sessions, etc.)",
 		RunE: func(cmd *cobra.Command, args []string) error {
-			return runStats(socketPath, timeout)
+			if !statsWatch {
+				return runStats(socketPath, timeout)
+			}
+			ctx, stop := signal.NotifyContext(cmd.Context(), os.Interrupt, syscall.SIGTERM)
+			defer stop()
+			return runStatsWatch(ctx, os.Stdout, socketPath, timeout, statsInterval)
 		},
 	}
+	statsCmd.Flags().BoolVar(&statsWatch, "watch", false, "Stream updates over one subscription until interrupted")
+	statsCmd.Flags().DurationVar(&statsInterval, "interval", time.Second, "Update interval for --watch (100ms..60s)")
 
 	// sessions subcommand
 	sessionsCmd := &cobra.Command{
 		Use:   "sessions",
 		Short: "List active sessions",
 		RunE: func(cmd *cobra.Command, args []string) error {
-			return runGenericCommand(socketPath, timeout, "sessions")
+			return runSessions(os.Stdout, socketPath, timeout, time.Now())
+		},
+	}
+
+	// users subcommand
+	var usersSort string
+	var usersTop int
+	usersCmd := &cobra.Command{
+		Use:   "users",
+		Short: "Show the top database users by load",
+		Long: `Show per-db_user totals (sessions, queries, blocked queries, bytes relayed in
+each direction and cumulative upstream time) across live and finished sessions.
+The proxy refreshes the table once per second.`,
+		RunE: func(cmd *cobra.Command, args []string) error {
+			return runUsers(os.Stdout, socketPath, timeout, usersSort, usersTop)
+		},
+	}
+	usersCmd.Flags().StringVar(&usersSort, "sort", "queries",
+		"Sort order: queries | blocked | bytes_in | bytes_out | upstream_us | sessions")
+	usersCmd.Flags().IntVar(&usersTop, "top", 20, "Number of users to show (max 1000)")
+
+	// top-queries subcommand
+	var queriesSort string
+	var queriesTop int
+	topQueriesCmd := &cobra.Command{
+		Use:   "top-queries",
+		Short: "Show the hottest and slowest statement shapes",
+		Long: `Show per-fingerprint totals kept by the proxy: statements that differ only in
+literals share one fingerprint. The proxy tracks a fixed number of fingerprints
+(TOP_QUERIES_CAPACITY) with the Space-Saving algorithm, so Count may over-estimate
+by up to Err. Sort by upstream_us or p99_us to find slow statements.`,
+		RunE: func(cmd *cobra.Command, args []string) error {
+			return runTopQueries(os.Stdout, socketPath, timeout, queriesSort, queriesTop)
+		},
+	}
+	topQueriesCmd.Flags().StringVar(&queriesSort, "sort", "count",
+		"Sort order: count | blocked | upstream_us | p99_us")
+	topQueriesCmd.Flags().IntVar(&queriesTop, "top", 20, "Number of statements to show (max 1000)")
+
+	// drain subcommand
+	drainCmd := &cobra.Command{
+		Use:   "drain",
+		Short: "Stop accepting connections and exit once sessions finish",
+		Long: `Put the proxy into drain mode: the listener is closed, /health reports
+"draining" (HTTP 503) and each session is closed at its next command boundary or
+after DRAIN_IDLE_SEC of idleness. The proxy exits when the last session ends or
+DRAIN_TIMEOUT_SEC elapses. For a binary upgrade with no refused connections, start
+the new process with LISTENER_HANDOFF_FROM instead (it starts the drain itself).`,
+		RunE: func(cmd *cobra.Command, args []string) error {
+			return runDrain(os.Stdout, socketPath, timeout)
 		},
 	}
 
@@ -127,6 +200,22 @@ Useful for debugging policy rules and auditing access control decisions.`,
 		},
 	}
 
+	// policy stats subcommand
+	var statsSort string
+	var statsTop int
+	policyStatsCmd := &cobra.Command{
+		Use:   "stats",
+		Short: "Show per-rule hit counts and evaluation cost",
+		Long: `Show how often each access rule and block pattern matched and how long it took
+to evaluate, for the active policy snapshot (counters restart on every reload).
+Use it to find slow block_patterns regexes and hot access rules worth reordering.`,
+		RunE: func(cmd *cobra.Command, args []string) error {
+			return runPolicyStats(socketPath, timeout, statsSort, statsTop)
+		},
+	}
+	policyStatsCmd.Flags().StringVar(&statsSort, "sort", "total", "Sort order: total | avg | hits | index")
+	policyStatsCmd.Flags().IntVar(&statsTop, "top", 0, "Show only the first N rules of each table (0 = all)")
+
 	// policy rollback subcommand
 	var rollbackVersion uint64
 	policyRollbackCmd := &cobra.Command{
@@ -141,8 +230,37 @@ Useful for debugging policy rules and auditing access control decisions.`,
 		panic(err)
 	}
 
-	policyCmd.AddCommand(policyReloadCmd, policyExplainCmd, policyVersionsCmd, policyRollbackCmd)
-	root.AddCommand(statsCmd, sessionsCmd, policyCmd)
+	policyCmd.AddCommand(policyReloadCmd, policyExplainCmd, policyVersionsCmd, policyRollbackCmd,
+		policyStatsCmd)
+
+	// audit subcommand (reads files locally; does not use the socket)
+	var auditFilter auditlog.Filter
+	var auditSince, auditUntil string
+	auditCmd := &cobra.Command{
+		Use:   "audit <file...>",
+		Short: "Decode and filter a binary audit log (log_format: binary)",
+		Long: `Stream one or more binary audit log files (e.g. /var/log/dbgate/dbgate.audit,
+dbgate.1.audit) and print matching query/block records as JSON lines using the same
+schema as the JSON log. Use "-" to read from stdin.`,
+		Args: cobra.MinimumNArgs(1),
+		RunE: func(cmd *cobra.Command, args []string) error {
+			var err error
+			if auditFilter.Since, err = parseAuditTime(auditSince); err != nil {
+				return fmt.Errorf("audit: --since: %w", err)
+			}
+			if auditFilter.Until, err = parseAuditTime(auditUntil); err != nil {
+				return fmt.Errorf("audit: --until: %w", err)
+			}
+			return runAudit(os.Stdout, args, &auditFilter)
+		},
+	}
+	auditCmd.Flags().StringVar(&auditFilter.User, "user", "", "Only records for this MySQL user")
+	auditCmd.Flags().StringVar(&auditFilter.Rule, "rule", "", "Only block records that matched this rule ID")
+	auditCmd.Flags().StringVar(&auditSince, "since", "", "Only records at or after this RFC3339 time")
+	auditCmd.Flags().StringVar(&auditUntil, "until", "", "Only records before this RFC3339 time")
+	auditCmd.Flags().BoolVar(&auditFilter.BlockedOnly, "blocked-only", false, "Only block records")
+
+	root.AddCommand(statsCmd, sessionsCmd, usersCmd, topQueriesCmd, drainCmd, policyCmd, auditCmd)
 
 	return root
 }
@@ -154,18 +272,78 @@ func runStats(socketPath string, timeout time.Duration) error {
 	if err != nil {
 		return fmt.Errorf("stats: %w", err)
 	}
+	printStats(os.Stdout, snap)
+	return nil
+}
 
-	fmt.Println("=== dbgate stats ===")
-	fmt.Printf("QPS:              %8.2f\n", snap.QPS)
-	fmt.Printf("Block Rate:       %7.2f%%\n", snap.BlockRate*100)
-	fmt.Printf("Active Sessions:  %8d\n", snap.ActiveSessions)
-	fmt.Printf("Total Queries:    %8d\n", snap.TotalQueries)
-	fmt.Printf("Blocked Queries:  %8d\n", snap.BlockedQueries)
-	fmt.Printf("Monitored Blocks: %8d\n", snap.MonitoredBlocks)
-	fmt.Printf("Total Connections:%8d\n", snap.TotalConnections)
-	fmt.Printf("Captured At:      %s\n", snap.CapturedAt.Format("2006-01-02 15:04:05 UTC"))
+// runStatsWatch subscribes to the proxy's stats stream and reprints the
+// snapshot every interval until ctx is cancelled (Ctrl-C). One control
+// connection is held for the whole session instead of one per refresh.
+func runStatsWatch(ctx context.Context, w io.Writer, socketPath string, timeout, interval time.Duration) error {
+	c := client.NewClient(socketPath, timeout)
+	err := c.SubscribeStats(ctx, interval, func(snap *client.StatsSnapshot) {
+		fmt.Fprintln(w)
+		printStats(w, snap)
+	})
+	if errors.Is(err, context.Canceled) {
+		return nil
+	}
+	return fmt.Errorf("stats --watch: %w", err)
+}
 
-	return nil
+// printStats writes the human-readable stats report for snap.
+func printStats(w io.Writer, snap *client.StatsSnapshot) {
+	fmt.Fprintln(w, "=== dbgate stats ===")
+	fmt.Fprintf(w, "QPS (1s/10s/60s): %8.2f / %.2f / %.2f\n", snap.QPS, snap.QPS10s, snap.QPS60s)
+	fmt.Fprintf(w, "Block Rate:       %7.2f%% (1s %.2f%%, 10s %.2f%%, 60s %.2f%%)\n",
+		snap.BlockRate*100, snap.BlockRate1s*100, snap.BlockRate10s*100, snap.BlockRate60s*100)
+	fmt.Fprintf(w, "Active Sessions:  %8d\n", snap.ActiveSessions)
+	fmt.Fprintf(w, "Total Queries:    %8d\n", snap.TotalQueries)
+	fmt.Fprintf(w, "Blocked Queries:  %8d\n", snap.BlockedQueries)
+	fmt.Fprintf(w, "Monitored Blocks: %8d\n", snap.MonitoredBlocks)
+	fmt.Fprintf(w, "Total Connections:%8d\n", snap.TotalConnections)
+	if snap.PoolHits+snap.PoolMisses > 0 {
+		fmt.Fprintf(w, "Pool Hits/Misses: %8d / %d\n", snap.PoolHits, snap.PoolMisses)
+		fmt.Fprintf(w, "Pool Idle:        %8d (evicted %d)\n", snap.PoolIdle, snap.PoolEvictions)
+	}
+	if snap.LogDropped+snap.LogQueued > 0 {
+		fmt.Fprintf(w, "Log Queued:       %8d (dropped %d)\n", snap.LogQueued, snap.LogDropped)
+	}
+	if snap.LogSuppressed > 0 {
+		fmt.Fprintf(w, "Log Suppressed:   %8d\n", snap.LogSuppressed)
+	}
+	if snap.ResultRowsLimited > 0 {
+		fmt.Fprintf(w, "Rows Limited:     %8d\n", snap.ResultRowsLimited)
+	}
+	if snap.RelayBufferPeak > 0 {
+		fmt.Fprintf(w, "Relay Buffers:    %8d bytes (peak %d, waits %d)\n",
+			snap.RelayBufferBytes, snap.RelayBufferPeak, snap.RelayBudgetWaits)
+	}
+	if snap.ConnsRejected+snap.HandshakeTimeouts > 0 {
+		fmt.Fprintf(w, "Conns Rejected:   %8d (handshake timeouts %d)\n",
+			snap.ConnsRejected, snap.HandshakeTimeouts)
+	}
+	if snap.IdleTimeouts > 0 {
+		fmt.Fprintf(w, "Idle Timeouts:    %8d\n", snap.IdleTimeouts)
+	}
+	if snap.TLSFrontendHits+snap.TLSFrontendFull > 0 {
+		fmt.Fprintf(w, "TLS Front Resume: %8d / %d full\n", snap.TLSFrontendHits, snap.TLSFrontendFull)
+	}
+	if snap.TLSBackendHits+snap.TLSBackendFull > 0 {
+		fmt.Fprintf(w, "TLS Back Resume:  %8d / %d full\n", snap.TLSBackendHits, snap.TLSBackendFull)
+	}
+	if len(snap.Latency) > 0 {
+		fmt.Fprintln(w, "Latency (µs):          count      p50      p99    p99.9      max")
+		for _, stage := range client.LatencyStages {
+			l, ok := snap.Latency[stage]
+			if !ok {
+				continue
+			}
+			fmt.Fprintf(w, "  %-18s %8d %8.1f %8.1f %8.1f %8.1f\n",
+				stage, l.Count, l.P50us, l.P99us, l.P999us, l.MaxUs)
+		}
+	}
+	fmt.Fprintf(w, "Captured At:      %s\n", snap.CapturedAt.Format("2006-01-02 15:04:05 UTC"))
 }
 
 // runPolicyExplain evaluates a SQL statement against the policy engine (dry-run)
@@ -277,6 +455,163 @@ func runPolicyVersions(socketPath string, timeout time.Duration) error {
 	return nil
 }
 
+// runPolicyStats prints per-rule hit counts and evaluation cost.
+func runPolicyStats(socketPath string, timeout time.Duration, sortBy string, top int) error {
+	less, err := ruleStatsOrder(sortBy)
+	if err != nil {
+		return err
+	}
+	c := client.NewClient(socketPath, timeout)
+	result, err := c.PolicyStats()
+	if err != nil {
+		return fmt.Errorf("policy stats: %w", err)
+	}
+
+	fmt.Printf("Policy version: %d\n", result.Version)
+	w := tabwriter.NewWriter(os.Stdout, 0, 0, 2, ' ', 0)
+	printTable := func(title string, rules []client.RuleStats) {
+		fmt.Fprintf(w, "\n=== %s ===\n", title)
+		fmt.Fprintln(w, "#\tRule\tHits\tEvals\tTotal\tAvg")
+		sorted := append([]client.RuleStats(nil), rules...)
+		sort.SliceStable(sorted, func(i, j int) bool { return less(sorted[i], sorted[j]) })
+		if top > 0 && len(sorted) > top {
+			sorted = sorted[:top]
+		}
+		for _, r := range sorted {
+			fmt.Fprintf(w, "%d\t%s\t%d\t%d\t%s\t%s\n", r.Index, r.Rule, r.Hits, r.Evaluations,
+				time.Duration(r.TotalNs), time.Duration(int64(r.AvgNs)))
+		}
+	}
+	printTable("Access Rules", result.AccessRules)
+	nr := result.NoAccessRule
+	fmt.Fprintf(w, "-\t(no access rule)\t%d\t%d\t%s\t%s\n", nr.Hits, nr.Evaluations,
+		time.Duration(nr.TotalNs), time.Duration(int64(nr.AvgNs)))
+	printTable("Block Patterns", result.BlockPatterns)
+	if err := w.Flush(); err != nil {
+		return fmt.Errorf("flush output: %w", err)
+	}
+	return nil
+}
+
+// ruleStatsOrder returns the comparison for the --sort flag of "policy stats".
+func ruleStatsOrder(sortBy string) (func(a, b client.RuleStats) bool, error) {
+	switch sortBy {
+	case "total":
+		return func(a, b client.RuleStats) bool { return a.TotalNs > b.TotalNs }, nil
+	case "avg":
+		return func(a, b client.RuleStats) bool { return a.AvgNs > b.AvgNs }, nil
+	case "hits":
+		return func(a, b client.RuleStats) bool { return a.Hits > b.Hits }, nil
+	case "index":
+		return func(a, b client.RuleStats) bool { return a.Index < b.Index }, nil
+	default:
+		return nil, fmt.Errorf("policy stats: unknown --sort %q (want total, avg, hits or index)", sortBy)
+	}
+}
+
+// runSessions prints the active session list as a table. Durations are measured
+// against now.
+func runSessions(w io.Writer, socketPath string, timeout time.Duration, now time.Time) error {
+	c := client.NewClient(socketPath, timeout)
+	result, err := c.Sessions()
+	if err != nil {
+		return fmt.Errorf("sessions: %w", err)
+	}
+
+	tw := tabwriter.NewWriter(w, 0, 0, 2, ' ', 0)
+	fmt.Fprintln(tw, "ID\tClient\tUser\tDatabase\tState\tAge\tQueries\tBlocked\tBytes In\tBytes Out\tLast Query")
+	for _, s := range result.Sessions {
+		lastQuery := "-"
+		if s.LastQueryAtMs > 0 {
+			lastQuery = now.Sub(time.UnixMilli(s.LastQueryAtMs)).Truncate(time.Second).String() + " ago"
+		}
+		fmt.Fprintf(tw, "%d\t%s\t%s\t%s\t%s\t%s\t%d\t%d\t%d\t%d\t%s\n",
+			s.SessionID, net.JoinHostPort(s.ClientIP, strconv.Itoa(int(s.ClientPort))),
+			s.DBUser, s.DBName, s.State,
+			now.Sub(time.UnixMilli(s.ConnectedAtMs)).Truncate(time.Second),
+			s.Queries, s.Blocked, s.BytesIn, s.BytesOut, lastQuery)
+	}
+	if err := tw.Flush(); err != nil {
+		return fmt.Errorf("flush output: %w", err)
+	}
+	if result.Truncated {
+		fmt.Fprintf(w, "(showing %d of %d sessions)\n", len(result.Sessions), result.Total)
+	} else {
+		fmt.Fprintf(w, "%d active sessions\n", result.Total)
+	}
+	return nil
+}
+
+// runUsers prints the top users table returned by "user_stats".
+func runUsers(w io.Writer, socketPath string, timeout time.Duration, sortBy string, top int) error {
+	c := client.NewClient(socketPath, timeout)
+	result, err := c.UserStats(sortBy, top)
+	if err != nil {
+		return fmt.Errorf("users: %w", err)
+	}
+
+	tw := tabwriter.NewWriter(w, 0, 0, 2, ' ', 0)
+	fmt.Fprintln(tw, "User\tActive\tSessions\tQueries\tBlocked\tBytes In\tBytes Out\tUpstream")
+	for _, u := range result.Users {
+		name := u.DBUser
+		if name == "" {
+			name = "(unauthenticated)"
+		}
+		fmt.Fprintf(tw, "%s\t%d\t%d\t%d\t%d\t%d\t%d\t%s\n", name, u.ActiveSessions,
+			u.Sessions, u.Queries, u.Blocked, u.BytesIn, u.BytesOut,
+			time.Duration(u.UpstreamUs)*time.Microsecond)
+	}
+	if err := tw.Flush(); err != nil {
+		return fmt.Errorf("flush output: %w", err)
+	}
+	fmt.Fprintf(w, "(top %d of %d users by %s)\n", len(result.Users), result.TotalUsers, result.Sort)
+	return nil
+}
+
+// maxFingerprintColumn caps the fingerprint column of "top-queries" so the table
+// stays readable; the full text is available from the UDS command.
+const maxFingerprintColumn = 100
+
+// runTopQueries prints the top statement shapes returned by "top_queries".
+func runTopQueries(w io.Writer, socketPath string, timeout time.Duration, sortBy string, top int) error {
+	c := client.NewClient(socketPath, timeout)
+	result, err := c.TopQueries(sortBy, top)
+	if err != nil {
+		return fmt.Errorf("top-queries: %w", err)
+	}
+
+	us := func(v uint64) time.Duration { return time.Duration(v) * time.Microsecond }
+	tw := tabwriter.NewWriter(w, 0, 0, 2, ' ', 0)
+	fmt.Fprintln(tw, "Count\tErr\tBlocked\tUpstream\tAvg\tp50\tp99\tMax\tFingerprint")
+	for _, q := range result.Queries {
+		fp := q.Fingerprint
+		if len(fp) > maxFingerprintColumn {
+			fp = fp[:maxFingerprintColumn] + "..."
+		} else if q.Truncated {
+			fp += "..."
+		}
+		fmt.Fprintf(tw, "%d\t%d\t%d\t%s\t%s\t%s\t%s\t%s\t%s\n", q.Count, q.Error, q.Blocked,
+			us(q.UpstreamUs), time.Duration(q.AvgUs*float64(time.Microsecond)).Truncate(time.Microsecond),
+			us(q.P50Us), us(q.P99Us), us(q.MaxUs), fp)
+	}
+	if err := tw.Flush(); err != nil {
+		return fmt.Errorf("flush output: %w", err)
+	}
+	fmt.Fprintf(w, "(top %d of %d tracked statements by %s; %d queries recorded, %d without fingerprint)\n",
+		len(result.Queries), result.Tracked, result.Sort, result.Recorded, result.Untracked)
+	return nil
+}
+
+// runDrain starts a graceful drain of the proxy.
+func runDrain(w io.Writer, socketPath string, timeout time.Duration) error {
+	c := client.NewClient(socketPath, timeout)
+	if err := c.Drain(); err != nil {
+		return fmt.Errorf("drain: %w", err)
+	}
+	fmt.Fprintln(w, "Drain started: no new connections; the proxy exits when sessions finish")
+	return nil
+}
+
 // runPolicyRollback rolls back the policy to a specific version.
 func runPolicyRollback(socketPath string, timeout time.Duration, targetVersion uint64) error {
 	c := client.NewClient(socketPath, timeout)
@@ -290,3 +625,50 @@ func runPolicyRollback(socketPath string, timeout time.Duration, targetVersion u
 	fmt.Printf("Rules count: %d\n", result.RulesCount)
 	return nil
 }
+
+// parseAuditTime parses an RFC3339 flag value; an empty value means "unbounded".
+func parseAuditTime(value string) (time.Time, error) {
+	if value == "" {
+		return time.Time{}, nil
+	}
+	return time.Parse(time.RFC3339, value)
+}
+
+// runAudit decodes each audit log file in order and writes matching records to w
+// as JSON lines. Files are independent streams (each starts with a segment header).
+func runAudit(w io.Writer, paths []string, filter *auditlog.Filter) error {
+	enc := json.NewEncoder(w)
+	enc.SetEscapeHTML(false)
+	for _, path := range paths {
+		if err := auditFile(enc, path, filter); err != nil {
+			return fmt.Errorf("audit: %s: %w", path, err)
+		}
+	}
+	return nil
+}
+
+func auditFile(enc *json.Encoder, path string, filter *auditlog.Filter) error {
+	var in io.Reader = os.Stdin
+	if path != "-" {
+		f, err := os.Open(path)
+		if err != nil {
+			return err
+		}
+		defer func() { _ = f.Close() }()
+		in = f
+	}
+
+	rd := auditlog.NewReader(in)
+	for {
+		rec, err := rd.Next(filter)
+		if errors.Is(err, io.EOF) {
+			return nil
+		}
+		if err != nil {
+			return err
+		}
+		if err := enc.Encode(rec); err != nil {
+			return fmt.Errorf("encode JSON: %w", err)
+		}
+	}
+}
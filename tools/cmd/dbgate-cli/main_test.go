@@ -1,14 +1,18 @@
 package main
 
 import (
+	"context"
 	"encoding/binary"
 	"encoding/json"
+	"io"
 	"net"
 	"os"
 	"path/filepath"
 	"strings"
 	"testing"
 	"time"
+
+	"github.com/dongwonkwak/dbgate/tools/internal/auditlog"
 )
 
 // mockUDSServer starts a mock Unix Domain Socket server that accepts one
@@ -122,6 +126,118 @@ func TestRunGenericCommand_ConnectionError(t *testing.T) {
 	}
 }
 
+// TestRunSessions_Table verifies the sessions table rows and the footer.
+func TestRunSessions_Table(t *testing.T) {
+	respJSON := []byte(`{"ok":true,"payload":{"total":5,"truncated":true,"sessions":[` +
+		`{"session_id":3,"client_ip":"10.0.0.5","client_port":51234,"db_user":"app",` +
+		`"db_name":"shop","state":"ready","queries":9,"blocked":1,"bytes_in":300,` +
+		`"bytes_out":4096,"connected_at_ms":1700000000000,"last_query_at_ms":0}]}}`)
+	sockPath := mockUDSServer(t, respJSON)
+
+	var out strings.Builder
+	now := time.UnixMilli(1700000065000)
+	if err := runSessions(&out, sockPath, 3*time.Second, now); err != nil {
+		t.Fatalf("runSessions: %v", err)
+	}
+	got := out.String()
+	for _, want := range []string{"10.0.0.5:51234", "app", "shop", "ready", "1m5s", "4096",
+		"(showing 1 of 5 sessions)"} {
+		if !strings.Contains(got, want) {
+			t.Errorf("output should contain %q, got:\n%s", want, got)
+		}
+	}
+}
+
+// TestRunSessions_ServerError verifies that ok=false (older proxy) is an error.
+func TestRunSessions_ServerError(t *testing.T) {
+	respJSON, _ := json.Marshal(map[string]interface{}{"ok": false, "error": "not implemented"})
+	sockPath := mockUDSServer(t, respJSON)
+
+	var out strings.Builder
+	if err := runSessions(&out, sockPath, 3*time.Second, time.Now()); err == nil {
+		t.Fatal("expected error for ok=false, got nil")
+	}
+}
+
+// TestRunUsers_Table verifies the users table and footer.
+func TestRunUsers_Table(t *testing.T) {
+	respJSON := []byte(`{"ok":true,"payload":{"captured_at_ms":1,"total_users":7,` +
+		`"sort":"upstream_us","users":[{"db_user":"report","active_sessions":1,"sessions":3,` +
+		`"queries":40,"blocked":0,"bytes_in":100,"bytes_out":2048,"upstream_us":2500}]}}`)
+	sockPath := mockUDSServer(t, respJSON)
+
+	var out strings.Builder
+	if err := runUsers(&out, sockPath, 3*time.Second, "upstream_us", 1); err != nil {
+		t.Fatalf("runUsers: %v", err)
+	}
+	got := out.String()
+	for _, want := range []string{"report", "2048", "2.5ms", "(top 1 of 7 users by upstream_us)"} {
+		if !strings.Contains(got, want) {
+			t.Errorf("output should contain %q, got:\n%s", want, got)
+		}
+	}
+}
+
+// TestRunTopQueries_Table verifies the top-queries table and the summary line.
+func TestRunTopQueries_Table(t *testing.T) {
+	respJSON := []byte(`{"ok":true,"payload":{"capacity":256,"tracked":12,"recorded":900,` +
+		`"untracked":3,"sort":"p99_us","queries":[{"id":"00000000000000ff",` +
+		`"fingerprint":"SELECT * FROM orders WHERE id = ?","truncated":false,"count":450,` +
+		`"error":0,"blocked":0,"latency_count":450,"upstream_us":90000,"avg_us":200.0,` +
+		`"p50_us":150,"p99_us":2500,"max_us":4000}]}}`)
+	sockPath := mockUDSServer(t, respJSON)
+
+	var out strings.Builder
+	if err := runTopQueries(&out, sockPath, 3*time.Second, "p99_us", 1); err != nil {
+		t.Fatalf("runTopQueries: %v", err)
+	}
+	got := out.String()
+	for _, want := range []string{"SELECT * FROM orders WHERE id = ?", "450", "90ms", "200µs",
+		"2.5ms", "(top 1 of 12 tracked statements by p99_us; 900 queries recorded, 3 without fingerprint)"} {
+		if !strings.Contains(got, want) {
+			t.Errorf("output should contain %q, got:\n%s", want, got)
+		}
+	}
+}
+
+// TestRunDrain verifies the drain confirmation and that ok=false is an error.
+func TestRunDrain(t *testing.T) {
+	var out strings.Builder
+	sockPath := mockUDSServer(t, []byte(`{"ok":true,"payload":{"draining":true}}`))
+	if err := runDrain(&out, sockPath, 3*time.Second); err != nil {
+		t.Fatalf("runDrain: %v", err)
+	}
+	if !strings.Contains(out.String(), "Drain started") {
+		t.Errorf("unexpected output: %q", out.String())
+	}
+
+	sockPath = mockUDSServer(t, []byte(`{"ok":false,"error":"not implemented","code":501}`))
+	if err := runDrain(&out, sockPath, 3*time.Second); err == nil {
+		t.Fatal("expected error for ok=false, got nil")
+	}
+}
+
+// TestRunStatsWatch verifies that --watch prints each pushed snapshot and
+// reports the stream ending (the mock closes after one frame).
+func TestRunStatsWatch(t *testing.T) {
+	var out strings.Builder
+	sockPath := mockUDSServer(t, []byte(`{"ok":true,"event":"stats","seq":1,"full":true,`+
+		`"payload":{"total_queries":1250,"qps":25.5,"captured_at_ms":1000}}`))
+	err := runStatsWatch(context.Background(), &out, sockPath, 3*time.Second, time.Second)
+	if err == nil {
+		t.Fatal("expected error when the stream ends")
+	}
+	if !strings.Contains(out.String(), "Total Queries:        1250") {
+		t.Errorf("unexpected output: %q", out.String())
+	}
+
+	sockPath = mockUDSServer(t, []byte(`{"ok":false,"error":"unknown command 'subscribe'"}`))
+	err = runStatsWatch(context.Background(), &out, sockPath, 3*time.Second, time.Second)
+	if err == nil || !strings.Contains(err.Error(), "unknown command") {
+		t.Fatalf("expected rejection error, got %v", err)
+	}
+}
+
 // makePolicyExplainResponse builds a framed mock policy_explain response payload.
 func makePolicyExplainResponse(action string) []byte {
 	resp := map[string]interface{}{
@@ -179,3 +295,63 @@ func TestRunPolicyExplain_ConnectionError(t *testing.T) {
 		t.Fatal("expected error for unreachable socket, got nil")
 	}
 }
+
+// writeAuditFile writes a minimal binary audit log: a segment header followed by
+// one query record per user (strings inline, timestamps as deltas from zero).
+func writeAuditFile(t *testing.T, users ...string) string {
+	t.Helper()
+
+	record := func(out, body []byte) []byte {
+		return append(binary.AppendUvarint(out, uint64(len(body))), body...)
+	}
+	inline := func(body []byte, s string) []byte {
+		body = binary.AppendUvarint(body, 0)
+		body = binary.AppendUvarint(body, uint64(len(s)))
+		return append(body, s...)
+	}
+
+	data := record(nil, []byte("\x00DBGA\x01"))
+	for i, user := range users {
+		body := binary.AppendUvarint([]byte{2}, 2) // zigzag(+1us)
+		body = binary.AppendUvarint(body, uint64(i+1))
+		body = inline(body, user)
+		body = inline(body, "10.0.0.1")
+		body = append(body, 1, 0, 0, 0) // command, action, duration, no tables
+		body = inline(body, "SELECT 1")
+		data = record(data, body)
+	}
+
+	path := filepath.Join(t.TempDir(), "dbgate.audit")
+	if err := os.WriteFile(path, data, 0o600); err != nil {
+		t.Fatalf("write audit file: %v", err)
+	}
+	return path
+}
+
+// TestRunAudit_FiltersByUser verifies that only matching records are printed as JSON lines.
+func TestRunAudit_FiltersByUser(t *testing.T) {
+	path := writeAuditFile(t, "app", "report", "app")
+
+	var out strings.Builder
+	if err := runAudit(&out, []string{path}, &auditlog.Filter{User: "app"}); err != nil {
+		t.Fatalf("runAudit: %v", err)
+	}
+	lines := strings.Split(strings.TrimSpace(out.String()), "\n")
+	if len(lines) != 2 {
+		t.Fatalf("got %d lines, want 2: %q", len(lines), out.String())
+	}
+	var rec map[string]interface{}
+	if err := json.Unmarshal([]byte(lines[1]), &rec); err != nil {
+		t.Fatalf("invalid JSON line: %v", err)
+	}
+	if rec["event"] != "query" || rec["db_user"] != "app" || rec["session_id"] != float64(3) {
+		t.Errorf("unexpected record: %v", rec)
+	}
+}
+
+// TestRunAudit_MissingFile verifies that an unreadable file returns an error.
+func TestRunAudit_MissingFile(t *testing.T) {
+	if err := runAudit(io.Discard, []string{"/nonexistent/dbgate.audit"}, nil); err == nil {
+		t.Fatal("expected error for missing file, got nil")
+	}
+}
@@ -0,0 +1,352 @@
+// Package auditlog decodes the dbgate binary audit log (global.log_format: binary).
+//
+// The file is a sequence of length-prefixed records (see docs/audit-log-format.md).
+// Reader decodes it as a stream: only the dictionary and the previous timestamp are
+// kept in memory, and the SQL text of a record is materialised only when the record
+// passes the Filter.
+package auditlog
+
+import (
+	"bufio"
+	"encoding/binary"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+	"time"
+)
+
+// Record types on the wire.
+const (
+	recordSegment byte = 0
+	recordString  byte = 1
+	recordQuery   byte = 2
+	recordBlock   byte = 3
+)
+
+const (
+	formatMagic   = "DBGA"
+	formatVersion = 1
+
+	blockFlagWouldBlock = 0x01
+
+	// maxRecordSize bounds a single record so that a corrupt length prefix cannot
+	// make the reader allocate an arbitrary amount of memory.
+	maxRecordSize = 64 << 20
+)
+
+// ErrCorrupt is returned (wrapped) when the input does not follow the format.
+var ErrCorrupt = errors.New("corrupt audit log")
+
+// Kind distinguishes query records from block records.
+type Kind int
+
+const (
+	KindQuery Kind = iota
+	KindBlock
+)
+
+// Record is one decoded audit event. Fields that do not apply to the record kind
+// are left at their zero value.
+type Record struct {
+	Kind       Kind
+	Timestamp  time.Time
+	SessionID  uint64
+	DBUser     string
+	ClientIP   string
+	CommandRaw uint8
+	ActionRaw  uint8
+	DurationUS uint64
+	Tables     []string
+	RawSQL     string
+
+	MatchedRule string
+	Reason      string
+	WouldBlock  bool
+}
+
+// Filter selects records. Empty fields match everything.
+type Filter struct {
+	User        string
+	Rule        string // matches block records only
+	Since       time.Time
+	Until       time.Time // exclusive
+	BlockedOnly bool
+}
+
+func (f *Filter) match(r *Record) bool {
+	if f == nil {
+		return true
+	}
+	if (f.BlockedOnly || f.Rule != "") && r.Kind != KindBlock {
+		return false
+	}
+	if f.User != "" && r.DBUser != f.User {
+		return false
+	}
+	if f.Rule != "" && r.MatchedRule != f.Rule {
+		return false
+	}
+	if !f.Since.IsZero() && r.Timestamp.Before(f.Since) {
+		return false
+	}
+	if !f.Until.IsZero() && !r.Timestamp.Before(f.Until) {
+		return false
+	}
+	return true
+}
+
+// Reader decodes records from an audit log stream.
+type Reader struct {
+	r         *bufio.Reader
+	buf       []byte
+	dict      map[uint64]string
+	lastTS    int64
+	inSegment bool
+}
+
+// NewReader returns a Reader positioned at the start of an audit log file.
+func NewReader(r io.Reader) *Reader {
+	return &Reader{r: bufio.NewReaderSize(r, 64*1024), dict: make(map[uint64]string)}
+}
+
+// Next returns the next record that matches f (nil matches all).
+// It returns io.EOF at a clean end of input; a record cut short by a crash or an
+// in-progress write yields an error wrapping io.ErrUnexpectedEOF.
+func (rd *Reader) Next(f *Filter) (*Record, error) {
+	for {
+		body, err := rd.readRecord()
+		if err != nil {
+			return nil, err
+		}
+		rec, err := rd.decode(body, f)
+		if err != nil {
+			return nil, err
+		}
+		if rec != nil {
+			return rec, nil
+		}
+	}
+}
+
+func (rd *Reader) readRecord() ([]byte, error) {
+	n, err := binary.ReadUvarint(rd.r)
+	if err != nil {
+		if errors.Is(err, io.EOF) {
+			return nil, io.EOF
+		}
+		return nil, fmt.Errorf("%w: record length: %w", ErrCorrupt, err)
+	}
+	if n == 0 || n > maxRecordSize {
+		return nil, fmt.Errorf("%w: record length %d", ErrCorrupt, n)
+	}
+	if uint64(cap(rd.buf)) < n {
+		rd.buf = make([]byte, n)
+	}
+	rd.buf = rd.buf[:n]
+	if _, err := io.ReadFull(rd.r, rd.buf); err != nil {
+		if errors.Is(err, io.EOF) {
+			err = io.ErrUnexpectedEOF
+		}
+		return nil, fmt.Errorf("%w: record body: %w", ErrCorrupt, err)
+	}
+	return rd.buf, nil
+}
+
+// decode handles one record body. It returns a Record only for query/block records
+// that match f; dictionary and segment records update state and return nil.
+func (rd *Reader) decode(body []byte, f *Filter) (*Record, error) {
+	typ := body[0]
+	d := decoder{b: body[1:]}
+
+	if typ == recordSegment {
+		if len(d.b) < len(formatMagic)+1 || string(d.b[:len(formatMagic)]) != formatMagic {
+			return nil, fmt.Errorf("%w: bad segment magic", ErrCorrupt)
+		}
+		if v := d.b[len(formatMagic)]; v != formatVersion {
+			return nil, fmt.Errorf("%w: unsupported format version %d", ErrCorrupt, v)
+		}
+		clear(rd.dict)
+		rd.lastTS = 0
+		rd.inSegment = true
+		return nil, nil
+	}
+	if !rd.inSegment {
+		return nil, fmt.Errorf("%w: record before segment header", ErrCorrupt)
+	}
+
+	switch typ {
+	case recordString:
+		id := d.uvarint()
+		s := d.bytes()
+		if d.err != nil {
+			return nil, d.err
+		}
+		rd.dict[id] = string(s)
+		return nil, nil
+	case recordQuery, recordBlock:
+		return rd.decodeEvent(typ, &d, f)
+	default:
+		// Unknown record types are skipped so that newer writers stay readable.
+		return nil, nil
+	}
+}
+
+func (rd *Reader) decodeEvent(typ byte, d *decoder, f *Filter) (*Record, error) {
+	rec := &Record{Kind: KindQuery}
+	if typ == recordBlock {
+		rec.Kind = KindBlock
+	}
+
+	// The timestamp chain must advance for every record, matching or not.
+	rd.lastTS += unzigzag(d.uvarint())
+	rec.Timestamp = time.UnixMicro(rd.lastTS).UTC()
+	rec.SessionID = d.uvarint()
+	rec.DBUser = rd.str(d)
+	rec.ClientIP = rd.str(d)
+
+	if rec.Kind == KindQuery {
+		rec.CommandRaw = d.u8()
+		rec.ActionRaw = d.u8()
+		rec.DurationUS = d.uvarint()
+		n := d.uvarint()
+		if n > uint64(len(d.b)) {
+			return nil, fmt.Errorf("%w: table count %d", ErrCorrupt, n)
+		}
+		rec.Tables = make([]string, 0, n)
+		for i := uint64(0); i < n && d.err == nil; i++ {
+			rec.Tables = append(rec.Tables, rd.str(d))
+		}
+	} else {
+		rec.MatchedRule = rd.str(d)
+		rec.Reason = rd.str(d)
+		rec.WouldBlock = d.u8()&blockFlagWouldBlock != 0
+	}
+	if d.err != nil {
+		return nil, d.err
+	}
+
+	if !f.match(rec) {
+		return nil, nil
+	}
+	// SQL is the trailing field; it is copied out only for matching records.
+	sql := d.bytes()
+	if d.err != nil {
+		return nil, d.err
+	}
+	rec.RawSQL = string(sql)
+	return rec, nil
+}
+
+// str decodes a string reference: 0 = inline bytes, otherwise a dictionary id.
+func (rd *Reader) str(d *decoder) string {
+	ref := d.uvarint()
+	if d.err != nil {
+		return ""
+	}
+	if ref == 0 {
+		return string(d.bytes())
+	}
+	s, ok := rd.dict[ref]
+	if !ok {
+		d.fail(fmt.Sprintf("unknown string id %d", ref))
+	}
+	return s
+}
+
+func unzigzag(v uint64) int64 {
+	return int64(v>>1) ^ -int64(v&1)
+}
+
+// decoder is a cursor over one record body. The first error sticks.
+type decoder struct {
+	b   []byte
+	err error
+}
+
+func (d *decoder) fail(msg string) {
+	if d.err == nil {
+		d.err = fmt.Errorf("%w: %s", ErrCorrupt, msg)
+	}
+	d.b = nil
+}
+
+func (d *decoder) uvarint() uint64 {
+	if d.err != nil {
+		return 0
+	}
+	v, n := binary.Uvarint(d.b)
+	if n <= 0 {
+		d.fail("bad varint")
+		return 0
+	}
+	d.b = d.b[n:]
+	return v
+}
+
+func (d *decoder) u8() uint8 {
+	if d.err != nil {
+		return 0
+	}
+	if len(d.b) == 0 {
+		d.fail("truncated record")
+		return 0
+	}
+	v := d.b[0]
+	d.b = d.b[1:]
+	return v
+}
+
+func (d *decoder) bytes() []byte {
+	n := d.uvarint()
+	if d.err != nil {
+		return nil
+	}
+	if n > uint64(len(d.b)) {
+		d.fail("truncated string")
+		return nil
+	}
+	s := d.b[:n]
+	d.b = d.b[n:]
+	return s
+}
+
+// MarshalJSON renders the record with the same schema as the JSON audit log lines.
+func (r *Record) MarshalJSON() ([]byte, error) {
+	ts := r.Timestamp.UTC().Format("2006-01-02T15:04:05.000Z")
+	if r.Kind == KindBlock {
+		event := "query_blocked"
+		if r.WouldBlock {
+			event = "query_would_block"
+		}
+		return json.Marshal(struct {
+			Event       string `json:"event"`
+			SessionID   uint64 `json:"session_id"`
+			DBUser      string `json:"db_user"`
+			ClientIP    string `json:"client_ip"`
+			RawSQL      string `json:"raw_sql"`
+			MatchedRule string `json:"matched_rule"`
+			Reason      string `json:"reason"`
+			WouldBlock  bool   `json:"would_block"`
+			Timestamp   string `json:"timestamp"`
+		}{event, r.SessionID, r.DBUser, r.ClientIP, r.RawSQL, r.MatchedRule, r.Reason,
+			r.WouldBlock, ts})
+	}
+	tables := r.Tables
+	if tables == nil {
+		tables = []string{}
+	}
+	return json.Marshal(struct {
+		Event      string   `json:"event"`
+		SessionID  uint64   `json:"session_id"`
+		DBUser     string   `json:"db_user"`
+		ClientIP   string   `json:"client_ip"`
+		RawSQL     string   `json:"raw_sql"`
+		CommandRaw uint8    `json:"command_raw"`
+		Tables     []string `json:"tables"`
+		ActionRaw  uint8    `json:"action_raw"`
+		Timestamp  string   `json:"timestamp"`
+		DurationUS uint64   `json:"duration_us"`
+	}{"query", r.SessionID, r.DBUser, r.ClientIP, r.RawSQL, r.CommandRaw, tables,
+		r.ActionRaw, ts, r.DurationUS})
+}
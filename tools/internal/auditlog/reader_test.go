@@ -0,0 +1,218 @@
+package auditlog
+
+import (
+	"bytes"
+	"encoding/binary"
+	"encoding/json"
+	"errors"
+	"io"
+	"testing"
+	"time"
+)
+
+// writer builds audit log bytes the same way the C++ BinaryAuditSink does:
+// it interns every string and writes timestamps as deltas.
+type writer struct {
+	out    bytes.Buffer
+	ids    map[string]uint64
+	lastTS int64
+}
+
+func newWriter() *writer {
+	w := &writer{}
+	w.segment()
+	return w
+}
+
+func (w *writer) record(body []byte) {
+	w.out.Write(binary.AppendUvarint(nil, uint64(len(body))))
+	w.out.Write(body)
+}
+
+func (w *writer) segment() {
+	w.ids = make(map[string]uint64)
+	w.lastTS = 0
+	w.record(append([]byte{recordSegment}, formatMagic+"\x01"...))
+}
+
+func (w *writer) ref(body []byte, s string) []byte {
+	id, ok := w.ids[s]
+	if !ok {
+		id = uint64(len(w.ids) + 1)
+		w.ids[s] = id
+		def := binary.AppendUvarint([]byte{recordString}, id)
+		def = binary.AppendUvarint(def, uint64(len(s)))
+		w.record(append(def, s...))
+	}
+	return binary.AppendUvarint(body, id)
+}
+
+func (w *writer) ts(body []byte, t time.Time) []byte {
+	us := t.UnixMicro()
+	delta := us - w.lastTS
+	w.lastTS = us
+	return binary.AppendUvarint(body, uint64(delta<<1)^uint64(delta>>63))
+}
+
+func (w *writer) query(t time.Time, session uint64, user, ip, sql string, tables ...string) {
+	body := w.ts([]byte{recordQuery}, t)
+	body = binary.AppendUvarint(body, session)
+	body = w.ref(body, user)
+	body = w.ref(body, ip)
+	body = append(body, 1, 0) // command_raw, action_raw
+	body = binary.AppendUvarint(body, 42)
+	body = binary.AppendUvarint(body, uint64(len(tables)))
+	for _, tbl := range tables {
+		body = w.ref(body, tbl)
+	}
+	body = binary.AppendUvarint(body, uint64(len(sql)))
+	w.record(append(body, sql...))
+}
+
+func (w *writer) block(t time.Time, user, ip, rule, reason, sql string, wouldBlock bool) {
+	body := w.ts([]byte{recordBlock}, t)
+	body = binary.AppendUvarint(body, 9)
+	body = w.ref(body, user)
+	body = w.ref(body, ip)
+	body = w.ref(body, rule)
+	// reason inline (ref 0), as the C++ writer does for long strings
+	body = binary.AppendUvarint(body, 0)
+	body = binary.AppendUvarint(body, uint64(len(reason)))
+	body = append(body, reason...)
+	flags := byte(0)
+	if wouldBlock {
+		flags = blockFlagWouldBlock
+	}
+	body = append(body, flags)
+	body = binary.AppendUvarint(body, uint64(len(sql)))
+	w.record(append(body, sql...))
+}
+
+func readAll(t *testing.T, data []byte, f *Filter) []*Record {
+	t.Helper()
+	rd := NewReader(bytes.NewReader(data))
+	var out []*Record
+	for {
+		rec, err := rd.Next(f)
+		if errors.Is(err, io.EOF) {
+			return out
+		}
+		if err != nil {
+			t.Fatalf("Next: %v", err)
+		}
+		out = append(out, rec)
+	}
+}
+
+var base = time.Date(2026, 1, 2, 3, 4, 5, 0, time.UTC)
+
+func sample() []byte {
+	w := newWriter()
+	w.query(base, 1, "app", "10.0.0.1", "SELECT * FROM orders", "orders")
+	w.query(base.Add(time.Second), 2, "report", "10.0.0.2", "SELECT 1")
+	w.block(base.Add(2*time.Second), "app", "10.0.0.1", "block-drop", "DROP not allowed",
+		"DROP TABLE orders", false)
+	w.segment() // e.g. rotation — dictionary and timestamp base reset
+	w.query(base.Add(3*time.Second), 3, "app", "10.0.0.1", "SELECT 2", "orders", "orders")
+	return w.out.Bytes()
+}
+
+func TestReader_DecodesAllRecords(t *testing.T) {
+	recs := readAll(t, sample(), nil)
+	if len(recs) != 4 {
+		t.Fatalf("got %d records, want 4", len(recs))
+	}
+	q := recs[0]
+	if q.Kind != KindQuery || q.DBUser != "app" || q.ClientIP != "10.0.0.1" ||
+		q.RawSQL != "SELECT * FROM orders" || q.DurationUS != 42 || !q.Timestamp.Equal(base) {
+		t.Errorf("unexpected first record: %+v", q)
+	}
+	if len(q.Tables) != 1 || q.Tables[0] != "orders" {
+		t.Errorf("tables = %v", q.Tables)
+	}
+	b := recs[2]
+	if b.Kind != KindBlock || b.MatchedRule != "block-drop" || b.Reason != "DROP not allowed" ||
+		b.WouldBlock || !b.Timestamp.Equal(base.Add(2*time.Second)) {
+		t.Errorf("unexpected block record: %+v", b)
+	}
+	last := recs[3]
+	if !last.Timestamp.Equal(base.Add(3*time.Second)) || len(last.Tables) != 2 {
+		t.Errorf("unexpected record after new segment: %+v", last)
+	}
+}
+
+func TestReader_Filters(t *testing.T) {
+	data := sample()
+	tests := []struct {
+		name   string
+		filter Filter
+		want   []uint64 // session ids
+	}{
+		{"user", Filter{User: "app"}, []uint64{1, 9, 3}},
+		{"rule", Filter{Rule: "block-drop"}, []uint64{9}},
+		{"blocked only", Filter{BlockedOnly: true}, []uint64{9}},
+		{"since", Filter{Since: base.Add(time.Second)}, []uint64{2, 9, 3}},
+		{"until exclusive", Filter{Until: base.Add(time.Second)}, []uint64{1}},
+		{"no match", Filter{User: "nobody"}, nil},
+	}
+	for _, tt := range tests {
+		t.Run(tt.name, func(t *testing.T) {
+			recs := readAll(t, data, &tt.filter)
+			if len(recs) != len(tt.want) {
+				t.Fatalf("got %d records, want %d", len(recs), len(tt.want))
+			}
+			for i, rec := range recs {
+				if rec.SessionID != tt.want[i] {
+					t.Errorf("record %d session_id = %d, want %d", i, rec.SessionID, tt.want[i])
+				}
+			}
+		})
+	}
+}
+
+func TestReader_TruncatedRecord(t *testing.T) {
+	data := sample()
+	rd := NewReader(bytes.NewReader(data[:len(data)-3]))
+	var err error
+	for err == nil {
+		_, err = rd.Next(nil)
+	}
+	if !errors.Is(err, ErrCorrupt) || !errors.Is(err, io.ErrUnexpectedEOF) {
+		t.Fatalf("err = %v, want corrupt + unexpected EOF", err)
+	}
+}
+
+func TestReader_RejectsMissingSegmentHeader(t *testing.T) {
+	w := newWriter()
+	w.query(base, 1, "app", "10.0.0.1", "SELECT 1")
+	data := w.out.Bytes()
+	// drop the SEGMENT record (1-byte length + 6-byte body)
+	_, err := NewReader(bytes.NewReader(data[7:])).Next(nil)
+	if !errors.Is(err, ErrCorrupt) {
+		t.Fatalf("err = %v, want ErrCorrupt", err)
+	}
+}
+
+func TestRecord_MarshalJSONMatchesLogSchema(t *testing.T) {
+	recs := readAll(t, sample(), nil)
+	line, err := json.Marshal(recs[2])
+	if err != nil {
+		t.Fatalf("marshal: %v", err)
+	}
+	var got map[string]any
+	if err := json.Unmarshal(line, &got); err != nil {
+		t.Fatalf("unmarshal: %v", err)
+	}
+	if got["event"] != "query_blocked" || got["matched_rule"] != "block-drop" ||
+		got["timestamp"] != "2026-01-02T03:04:07.000Z" {
+		t.Errorf("unexpected JSON: %s", line)
+	}
+
+	line, err = json.Marshal(recs[1])
+	if err != nil {
+		t.Fatalf("marshal: %v", err)
+	}
+	if !bytes.Contains(line, []byte(`"tables":[]`)) || !bytes.Contains(line, []byte(`"event":"query"`)) {
+		t.Errorf("unexpected JSON: %s", line)
+	}
+}
@@ -60,43 +60,12 @@ func (c *Client) sendRequest(req CommandRequest) (*Response, error) {
 		}
 	}
 
-	// Marshal request.
-	body, err := json.Marshal(req)
-	if err != nil {
-		return nil, fmt.Errorf("marshal request: %w", err)
-	}
-
-	// Write 4-byte LE length prefix.
-	var lenBuf [4]byte
-	if uint64(len(body)) > uint64(^uint32(0)) {
-		return nil, fmt.Errorf("request body too large: %d", len(body))
-	}
-	reqLen := uint32(len(body)) // #nosec G115 -- bounded by the explicit check above.
-	binary.LittleEndian.PutUint32(lenBuf[:], reqLen)
-	if err := writeFull(conn, lenBuf[:]); err != nil {
-		return nil, fmt.Errorf("write length prefix: %w", err)
-	}
-
-	// Write JSON body.
-	if err := writeFull(conn, body); err != nil {
-		return nil, fmt.Errorf("write request body: %w", err)
-	}
-
-	// Read 4-byte LE length prefix of response.
-	if _, err := io.ReadFull(conn, lenBuf[:]); err != nil {
-		return nil, fmt.Errorf("read response length: %w", err)
-	}
-	respLen := binary.LittleEndian.Uint32(lenBuf[:])
-
-	const maxResponseBytes = 16 * 1024 * 1024 // 16 MiB guard
-	if respLen == 0 || respLen > maxResponseBytes {
-		return nil, fmt.Errorf("invalid response length %d", respLen)
+	if err := writeRequest(conn, req); err != nil {
+		return nil, err
 	}
-
-	// Read JSON body.
-	respBody := make([]byte, respLen)
-	if _, err := io.ReadFull(conn, respBody); err != nil {
-		return nil, fmt.Errorf("read response body: %w", err)
+	respBody, err := readFrame(conn)
+	if err != nil {
+		return nil, err
 	}
 
 	var resp Response
@@ -179,6 +148,137 @@ func (c *Client) PolicyVersions() (*PolicyVersionsResult, error) {
 	return &result, nil
 }
 
+// PolicyStats sends a "policy_stats" command and returns per-rule hit counts and
+// evaluation cost for the active policy snapshot.
+func (c *Client) PolicyStats() (*PolicyStatsResult, error) {
+	resp, err := c.SendCommand("policy_stats")
+	if err != nil {
+		return nil, err
+	}
+	if !resp.OK {
+		errMsg := resp.Error
+		if errMsg == "" {
+			errMsg = "unknown server error"
+		}
+		return nil, fmt.Errorf("policy_stats: server error: %s", errMsg)
+	}
+	if resp.Payload == nil {
+		return nil, fmt.Errorf("policy_stats: response has no payload")
+	}
+
+	payloadBytes, err := json.Marshal(resp.Payload)
+	if err != nil {
+		return nil, fmt.Errorf("policy_stats: re-marshal payload: %w", err)
+	}
+
+	var result PolicyStatsResult
+	if err := json.Unmarshal(payloadBytes, &result); err != nil {
+		return nil, fmt.Errorf("policy_stats: parse payload: %w", err)
+	}
+
+	return &result, nil
+}
+
+// Sessions sends a "sessions" command and returns the active session list.
+func (c *Client) Sessions() (*SessionsResult, error) {
+	resp, err := c.SendCommand("sessions")
+	if err != nil {
+		return nil, err
+	}
+	if !resp.OK {
+		errMsg := resp.Error
+		if errMsg == "" {
+			errMsg = "unknown server error"
+		}
+		return nil, fmt.Errorf("sessions: server error: %s", errMsg)
+	}
+	if resp.Payload == nil {
+		return nil, fmt.Errorf("sessions: response has no payload")
+	}
+
+	payloadBytes, err := json.Marshal(resp.Payload)
+	if err != nil {
+		return nil, fmt.Errorf("sessions: re-marshal payload: %w", err)
+	}
+
+	var result SessionsResult
+	if err := json.Unmarshal(payloadBytes, &result); err != nil {
+		return nil, fmt.Errorf("sessions: parse payload: %w", err)
+	}
+
+	return &result, nil
+}
+
+// UserStats sends a "user_stats" command and returns the top users by sortBy.
+// An empty sortBy or a non-positive limit selects the server defaults.
+func (c *Client) UserStats(sortBy string, limit int) (*UserStatsResult, error) {
+	req := CommandRequest{
+		Command: "user_stats",
+		Payload: UserStatsRequest{Sort: sortBy, Limit: max(limit, 0)},
+	}
+	resp, err := c.sendRequest(req)
+	if err != nil {
+		return nil, err
+	}
+	if !resp.OK {
+		errMsg := resp.Error
+		if errMsg == "" {
+			errMsg = "unknown server error"
+		}
+		return nil, fmt.Errorf("user_stats: server error: %s", errMsg)
+	}
+	if resp.Payload == nil {
+		return nil, fmt.Errorf("user_stats: response has no payload")
+	}
+
+	payloadBytes, err := json.Marshal(resp.Payload)
+	if err != nil {
+		return nil, fmt.Errorf("user_stats: re-marshal payload: %w", err)
+	}
+
+	var result UserStatsResult
+	if err := json.Unmarshal(payloadBytes, &result); err != nil {
+		return nil, fmt.Errorf("user_stats: parse payload: %w", err)
+	}
+
+	return &result, nil
+}
+
+// TopQueries sends a "top_queries" command and returns the top statement shapes
+// by sortBy. An empty sortBy or a non-positive limit selects the server defaults.
+func (c *Client) TopQueries(sortBy string, limit int) (*TopQueriesResult, error) {
+	req := CommandRequest{
+		Command: "top_queries",
+		Payload: TopQueriesRequest{Sort: sortBy, Limit: max(limit, 0)},
+	}
+	resp, err := c.sendRequest(req)
+	if err != nil {
+		return nil, err
+	}
+	if !resp.OK {
+		errMsg := resp.Error
+		if errMsg == "" {
+			errMsg = "unknown server error"
+		}
+		return nil, fmt.Errorf("top_queries: server error: %s", errMsg)
+	}
+	if resp.Payload == nil {
+		return nil, fmt.Errorf("top_queries: response has no payload")
+	}
+
+	payloadBytes, err := json.Marshal(resp.Payload)
+	if err != nil {
+		return nil, fmt.Errorf("top_queries: re-marshal payload: %w", err)
+	}
+
+	var result TopQueriesResult
+	if err := json.Unmarshal(payloadBytes, &result); err != nil {
+		return nil, fmt.Errorf("top_queries: parse payload: %w", err)
+	}
+
+	return &result, nil
+}
+
 // PolicyRollback sends a "policy_rollback" command with the given targetVersion
 // and returns the decoded PolicyRollbackResult.
 func (c *Client) PolicyRollback(targetVersion uint64) (*PolicyRollbackResult, error) {
@@ -245,6 +345,71 @@ func (c *Client) PolicyReload() (*PolicyReloadResult, error) {
 	return &result, nil
 }
 
+// Drain sends a "drain" command: the proxy stops accepting connections, reports
+// "draining" on its health endpoint and exits once the remaining sessions finish
+// (or DRAIN_TIMEOUT_SEC elapses). The call returns as soon as the drain starts.
+func (c *Client) Drain() error {
+	resp, err := c.SendCommand("drain")
+	if err != nil {
+		return err
+	}
+	if !resp.OK {
+		errMsg := resp.Error
+		if errMsg == "" {
+			errMsg = "unknown server error"
+		}
+		return fmt.Errorf("drain: server error: %s", errMsg)
+	}
+	return nil
+}
+
+// writeRequest marshals req and writes it as one framed message:
+// 4-byte LE length prefix followed by the JSON body.
+func writeRequest(w io.Writer, req CommandRequest) error {
+	body, err := json.Marshal(req)
+	if err != nil {
+		return fmt.Errorf("marshal request: %w", err)
+	}
+
+	// Write 4-byte LE length prefix.
+	var lenBuf [4]byte
+	if uint64(len(body)) > uint64(^uint32(0)) {
+		return fmt.Errorf("request body too large: %d", len(body))
+	}
+	reqLen := uint32(len(body)) // #nosec G115 -- bounded by the explicit check above.
+	binary.LittleEndian.PutUint32(lenBuf[:], reqLen)
+	if err := writeFull(w, lenBuf[:]); err != nil {
+		return fmt.Errorf("write length prefix: %w", err)
+	}
+
+	// Write JSON body.
+	if err := writeFull(w, body); err != nil {
+		return fmt.Errorf("write request body: %w", err)
+	}
+	return nil
+}
+
+// readFrame reads one framed message (response or pushed event) and returns
+// its JSON body.
+func readFrame(r io.Reader) ([]byte, error) {
+	var lenBuf [4]byte
+	if _, err := io.ReadFull(r, lenBuf[:]); err != nil {
+		return nil, fmt.Errorf("read response length: %w", err)
+	}
+	respLen := binary.LittleEndian.Uint32(lenBuf[:])
+
+	const maxResponseBytes = 16 * 1024 * 1024 // 16 MiB guard
+	if respLen == 0 || respLen > maxResponseBytes {
+		return nil, fmt.Errorf("invalid response length %d", respLen)
+	}
+
+	body := make([]byte, respLen)
+	if _, err := io.ReadFull(r, body); err != nil {
+		return nil, fmt.Errorf("read response body: %w", err)
+	}
+	return body, nil
+}
+
 // writeFull writes all bytes in buf to w, looping until all bytes are written
 // or an error occurs. This handles the rare case where Write returns n < len(buf)
 // without an error, which technically violates the io.Writer contract but can
@@ -264,15 +429,40 @@ func writeFull(w io.Writer, buf []byte) error {
 // captured_at is sent as captured_at_ms (Unix epoch milliseconds), not as an
 // RFC 3339 string. All other fields are identical to StatsSnapshot.
 type rawStats struct {
-	TotalConnections uint64  `json:"total_connections"`
-	ActiveSessions   uint64  `json:"active_sessions"`
-	TotalQueries     uint64  `json:"total_queries"`
-	BlockedQueries   uint64  `json:"blocked_queries"`
-	MonitoredBlocks  uint64  `json:"monitored_blocks"`
-	QPS              float64 `json:"qps"`
-	BlockRate        float64 `json:"block_rate"`
+	TotalConnections  uint64  `json:"total_connections"`
+	ActiveSessions    uint64  `json:"active_sessions"`
+	TotalQueries      uint64  `json:"total_queries"`
+	BlockedQueries    uint64  `json:"blocked_queries"`
+	MonitoredBlocks   uint64  `json:"monitored_blocks"`
+	QPS               float64 `json:"qps"`
+	BlockRate         float64 `json:"block_rate"`
+	QPS10s            float64 `json:"qps_10s"`
+	QPS60s            float64 `json:"qps_60s"`
+	BlockRate1s       float64 `json:"block_rate_1s"`
+	BlockRate10s      float64 `json:"block_rate_10s"`
+	BlockRate60s      float64 `json:"block_rate_60s"`
+	PoolHits          uint64  `json:"pool_hits"`
+	PoolMisses        uint64  `json:"pool_misses"`
+	PoolIdle          uint64  `json:"pool_idle"`
+	PoolEvictions     uint64  `json:"pool_evictions"`
+	LogDropped        uint64  `json:"log_dropped"`
+	LogQueued         uint64  `json:"log_queued"`
+	LogSuppressed     uint64  `json:"log_suppressed"`
+	ResultRowsLimited uint64  `json:"result_rows_limited"`
+	RelayBufferBytes  uint64  `json:"relay_buffer_bytes"`
+	RelayBufferPeak   uint64  `json:"relay_buffer_peak_bytes"`
+	RelayBudgetWaits  uint64  `json:"relay_budget_waits"`
+	ConnsRejected     uint64  `json:"connections_rejected"`
+	HandshakeTimeouts uint64  `json:"handshake_timeouts"`
+	IdleTimeouts      uint64  `json:"idle_timeouts"`
+	TLSFrontendHits   uint64  `json:"tls_frontend_resumed"`
+	TLSFrontendFull   uint64  `json:"tls_frontend_full"`
+	TLSBackendHits    uint64  `json:"tls_backend_resumed"`
+	TLSBackendFull    uint64  `json:"tls_backend_full"`
 	// C++ side serialises the timestamp as Unix epoch milliseconds.
 	CapturedAtMs int64 `json:"captured_at_ms"`
+
+	Latency map[string]LatencySummary `json:"latency"`
 }
 
 // GetStats sends a "stats" command and returns the decoded StatsSnapshot.
@@ -294,20 +484,50 @@ func (c *Client) GetStats() (*StatsSnapshot, error) {
 		return nil, fmt.Errorf("re-marshal stats payload: %w", err)
 	}
 
+	return decodeStats(payloadBytes)
+}
+
+// decodeStats converts a StatsSnapshot payload as serialised by the C++ core
+// ("stats" response or a merged "subscribe" event) into a StatsSnapshot.
+func decodeStats(payload []byte) (*StatsSnapshot, error) {
 	var raw rawStats
-	if err := json.Unmarshal(payloadBytes, &raw); err != nil {
+	if err := json.Unmarshal(payload, &raw); err != nil {
 		return nil, fmt.Errorf("parse stats payload: %w", err)
 	}
 
 	snap := &StatsSnapshot{
-		TotalConnections: raw.TotalConnections,
-		ActiveSessions:   raw.ActiveSessions,
-		TotalQueries:     raw.TotalQueries,
-		BlockedQueries:   raw.BlockedQueries,
-		MonitoredBlocks:  raw.MonitoredBlocks,
-		QPS:              raw.QPS,
-		BlockRate:        raw.BlockRate,
-		CapturedAt:       time.UnixMilli(raw.CapturedAtMs).UTC(),
+		TotalConnections:  raw.TotalConnections,
+		ActiveSessions:    raw.ActiveSessions,
+		TotalQueries:      raw.TotalQueries,
+		BlockedQueries:    raw.BlockedQueries,
+		MonitoredBlocks:   raw.MonitoredBlocks,
+		QPS:               raw.QPS,
+		BlockRate:         raw.BlockRate,
+		QPS10s:            raw.QPS10s,
+		QPS60s:            raw.QPS60s,
+		BlockRate1s:       raw.BlockRate1s,
+		BlockRate10s:      raw.BlockRate10s,
+		BlockRate60s:      raw.BlockRate60s,
+		PoolHits:          raw.PoolHits,
+		PoolMisses:        raw.PoolMisses,
+		PoolIdle:          raw.PoolIdle,
+		PoolEvictions:     raw.PoolEvictions,
+		LogDropped:        raw.LogDropped,
+		LogQueued:         raw.LogQueued,
+		LogSuppressed:     raw.LogSuppressed,
+		ResultRowsLimited: raw.ResultRowsLimited,
+		RelayBufferBytes:  raw.RelayBufferBytes,
+		RelayBufferPeak:   raw.RelayBufferPeak,
+		RelayBudgetWaits:  raw.RelayBudgetWaits,
+		ConnsRejected:     raw.ConnsRejected,
+		HandshakeTimeouts: raw.HandshakeTimeouts,
+		IdleTimeouts:      raw.IdleTimeouts,
+		TLSFrontendHits:   raw.TLSFrontendHits,
+		TLSFrontendFull:   raw.TLSFrontendFull,
+		TLSBackendHits:    raw.TLSBackendHits,
+		TLSBackendFull:    raw.TLSBackendFull,
+		CapturedAt:        time.UnixMilli(raw.CapturedAtMs).UTC(),
+		Latency:           raw.Latency,
 	}
 	return snap, nil
 }
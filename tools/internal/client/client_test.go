@@ -204,6 +204,27 @@ func TestGetStats_CapturedAtMs(t *testing.T) {
 	}
 }
 
+// TestGetStats_Latency verifies that per-stage latency summaries are decoded.
+func TestGetStats_Latency(t *testing.T) {
+	respJSON := []byte(`{"ok":true,"payload":{"total_queries":3,"captured_at_ms":0,` +
+		`"latency":{"parse":{"count":3,"p50_us":1.5,"p99_us":4.25,"p999_us":4.25,"max_us":4.1},` +
+		`"proxy_overhead":{"count":3,"p50_us":12,"p99_us":180,"p999_us":180,"max_us":175}}}}`)
+	sockPath := startMockServer(t, frameResponse(respJSON))
+
+	c := NewClient(sockPath, 3*time.Second)
+	snap, err := c.GetStats()
+	if err != nil {
+		t.Fatalf("GetStats: %v", err)
+	}
+	parse, ok := snap.Latency["parse"]
+	if !ok || parse.Count != 3 || parse.P99us != 4.25 {
+		t.Errorf("parse latency: got %+v (present=%v)", parse, ok)
+	}
+	if got := snap.Latency["proxy_overhead"].P99us; got != 180 {
+		t.Errorf("proxy_overhead p99: got %v, want 180", got)
+	}
+}
+
 // TestGetStats_ServerError verifies that a non-OK server response surfaces as an error.
 func TestGetStats_ServerError(t *testing.T) {
 	respJSON := []byte(`{"ok":false,"error":"internal error"}`)
@@ -364,3 +385,157 @@ func TestTimeout(t *testing.T) {
 		t.Errorf("timeout took too long: %v", elapsed)
 	}
 }
+
+// TestPolicyStats verifies that per-rule counters are decoded, including the
+// embedded RuleCost fields and the no_access_rule bucket.
+func TestPolicyStats(t *testing.T) {
+	respJSON := []byte(`{"ok":true,"payload":{"version":3,` +
+		`"access_rules":[{"index":0,"rule":"app@10.0.0.0/8","evaluations":4,"hits":6,` +
+		`"total_ns":800,"avg_ns":200}],` +
+		`"block_patterns":[{"index":0,"rule":"UNION\\s+SELECT","evaluations":10,"hits":1,` +
+		`"total_ns":5000,"avg_ns":500}],` +
+		`"no_access_rule":{"evaluations":2,"hits":2,"total_ns":100,"avg_ns":50}}}`)
+	sockPath := startMockServer(t, frameResponse(respJSON))
+
+	c := NewClient(sockPath, 3*time.Second)
+	result, err := c.PolicyStats()
+	if err != nil {
+		t.Fatalf("PolicyStats: %v", err)
+	}
+	if result.Version != 3 {
+		t.Errorf("Version: got %d, want 3", result.Version)
+	}
+	if len(result.AccessRules) != 1 || result.AccessRules[0].Rule != "app@10.0.0.0/8" ||
+		result.AccessRules[0].Hits != 6 || result.AccessRules[0].Evaluations != 4 {
+		t.Errorf("AccessRules: got %+v", result.AccessRules)
+	}
+	if len(result.BlockPatterns) != 1 || result.BlockPatterns[0].TotalNs != 5000 ||
+		result.BlockPatterns[0].AvgNs != 500 {
+		t.Errorf("BlockPatterns: got %+v", result.BlockPatterns)
+	}
+	if result.NoAccessRule.Hits != 2 {
+		t.Errorf("NoAccessRule.Hits: got %d, want 2", result.NoAccessRule.Hits)
+	}
+}
+
+// TestSessions verifies that the "sessions" payload is decoded into SessionInfo rows.
+func TestSessions(t *testing.T) {
+	respJSON := []byte(`{"ok":true,"payload":{"total":3,"truncated":true,"sessions":[` +
+		`{"session_id":4,"client_ip":"10.0.0.5","client_port":51234,"db_user":"app",` +
+		`"db_name":"shop","state":"ready","queries":12,"blocked":1,"bytes_in":800,` +
+		`"bytes_out":64000,"connected_at_ms":1700000000000,"last_query_at_ms":1700000042000}]}}`)
+	sockPath := startMockServer(t, frameResponse(respJSON))
+
+	c := NewClient(sockPath, 3*time.Second)
+	result, err := c.Sessions()
+	if err != nil {
+		t.Fatalf("Sessions: %v", err)
+	}
+	if result.Total != 3 || !result.Truncated || len(result.Sessions) != 1 {
+		t.Fatalf("unexpected result: %+v", result)
+	}
+	s := result.Sessions[0]
+	if s.SessionID != 4 || s.ClientIP != "10.0.0.5" || s.ClientPort != 51234 ||
+		s.DBUser != "app" || s.DBName != "shop" || s.State != "ready" {
+		t.Errorf("identity fields: got %+v", s)
+	}
+	if s.Queries != 12 || s.Blocked != 1 || s.BytesIn != 800 || s.BytesOut != 64000 ||
+		s.ConnectedAtMs != 1700000000000 || s.LastQueryAtMs != 1700000042000 {
+		t.Errorf("counter fields: got %+v", s)
+	}
+}
+
+// TestSessions_ServerError verifies that ok:false is surfaced as an error.
+func TestSessions_ServerError(t *testing.T) {
+	respJSON := []byte(`{"ok":false,"error":"not implemented","code":501,"command":"sessions"}`)
+	sockPath := startMockServer(t, frameResponse(respJSON))
+
+	c := NewClient(sockPath, 3*time.Second)
+	if _, err := c.Sessions(); err == nil {
+		t.Fatal("expected error for ok:false response")
+	}
+}
+
+// TestUserStats verifies that the "user_stats" payload is decoded into UserTotals.
+func TestUserStats(t *testing.T) {
+	respJSON := []byte(`{"ok":true,"payload":{"captured_at_ms":1700000000000,"total_users":4,` +
+		`"sort":"bytes_out","users":[{"db_user":"batch","active_sessions":2,"sessions":9,` +
+		`"queries":120,"blocked":3,"bytes_in":4000,"bytes_out":90000000,"upstream_us":5500000}]}}`)
+	sockPath := startMockServer(t, frameResponse(respJSON))
+
+	c := NewClient(sockPath, 3*time.Second)
+	result, err := c.UserStats("bytes_out", 1)
+	if err != nil {
+		t.Fatalf("UserStats: %v", err)
+	}
+	if result.TotalUsers != 4 || result.Sort != "bytes_out" || len(result.Users) != 1 {
+		t.Fatalf("unexpected result: %+v", result)
+	}
+	u := result.Users[0]
+	if u.DBUser != "batch" || u.ActiveSessions != 2 || u.Sessions != 9 || u.Queries != 120 ||
+		u.Blocked != 3 || u.BytesIn != 4000 || u.BytesOut != 90000000 || u.UpstreamUs != 5500000 {
+		t.Errorf("UserTotals: got %+v", u)
+	}
+}
+
+// TestTopQueries verifies that the "top_queries" payload is decoded into QueryStats.
+func TestTopQueries(t *testing.T) {
+	respJSON := []byte(`{"ok":true,"payload":{"capacity":256,"tracked":2,"recorded":40,` +
+		`"untracked":1,"sort":"p99_us","queries":[{"id":"00000000000000ff",` +
+		`"fingerprint":"SELECT * FROM t WHERE id = ?","truncated":false,"count":30,"error":2,` +
+		`"blocked":1,"latency_count":29,"upstream_us":5800,"avg_us":200.0,"p50_us":150,` +
+		`"p99_us":900,"max_us":1200}]}}`)
+	sockPath := startMockServer(t, frameResponse(respJSON))
+
+	c := NewClient(sockPath, 3*time.Second)
+	result, err := c.TopQueries("p99_us", 1)
+	if err != nil {
+		t.Fatalf("TopQueries: %v", err)
+	}
+	if result.Capacity != 256 || result.Tracked != 2 || result.Untracked != 1 ||
+		result.Sort != "p99_us" || len(result.Queries) != 1 {
+		t.Fatalf("unexpected result: %+v", result)
+	}
+	q := result.Queries[0]
+	if q.ID != "00000000000000ff" || q.Fingerprint != "SELECT * FROM t WHERE id = ?" ||
+		q.Count != 30 || q.Error != 2 || q.Blocked != 1 || q.LatencyCount != 29 ||
+		q.UpstreamUs != 5800 || q.AvgUs != 200 || q.P50Us != 150 || q.P99Us != 900 || q.MaxUs != 1200 {
+		t.Errorf("QueryStats: got %+v", q)
+	}
+
+	errJSON := []byte(`{"ok":false,"error":"unknown sort 'x' (want count, blocked, upstream_us, p99_us)"}`)
+	c = NewClient(startMockServer(t, frameResponse(errJSON)), 3*time.Second)
+	if _, err := c.TopQueries("x", 0); err == nil || !strings.Contains(err.Error(), "unknown sort") {
+		t.Fatalf("expected server error, got %v", err)
+	}
+}
+
+// TestDrain verifies that ok:true starts the drain and ok:false is surfaced as an error.
+func TestDrain(t *testing.T) {
+	okJSON := []byte(`{"ok":true,"payload":{"draining":true}}`)
+	c := NewClient(startMockServer(t, frameResponse(okJSON)), 3*time.Second)
+	if err := c.Drain(); err != nil {
+		t.Fatalf("Drain: %v", err)
+	}
+
+	errJSON := []byte(`{"ok":false,"error":"not implemented","code":501,"command":"drain"}`)
+	c = NewClient(startMockServer(t, frameResponse(errJSON)), 3*time.Second)
+	if err := c.Drain(); err == nil || !strings.Contains(err.Error(), "not implemented") {
+		t.Fatalf("expected server error, got %v", err)
+	}
+}
+
+// TestUserStatsRequest_OmitsDefaults verifies that zero sort/limit are left to the server.
+func TestUserStatsRequest_OmitsDefaults(t *testing.T) {
+	b, err := json.Marshal(UserStatsRequest{})
+	if err != nil {
+		t.Fatalf("marshal: %v", err)
+	}
+	if string(b) != "{}" {
+		t.Errorf("empty request: got %s, want {}", b)
+	}
+	b, _ = json.Marshal(UserStatsRequest{Sort: "blocked", Limit: 5})
+	if string(b) != `{"sort":"blocked","limit":5}` {
+		t.Errorf("request: got %s", b)
+	}
+}
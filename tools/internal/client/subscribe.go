@@ -0,0 +1,235 @@
+package client
+
+import (
+	"context"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"net"
+	"sync"
+	"time"
+)
+
+// ErrSubscribeRejected is returned by SubscribeStats when the proxy answers the
+// "subscribe" command with ok=false (for example an older proxy that does not
+// know the command, or an interval outside 100ms..60s).
+var ErrSubscribeRejected = errors.New("subscribe rejected")
+
+// SubscribeStats opens one "subscribe" connection and calls fn with the complete
+// StatsSnapshot for every frame the proxy pushes (one per interval). The proxy
+// sends the full snapshot first and only changed top-level fields afterwards;
+// the deltas are merged here so fn always sees a complete snapshot.
+//
+// It blocks until ctx is cancelled (returning ctx.Err()) or the stream fails.
+// A frame that does not arrive within interval+timeout counts as a failure.
+func (c *Client) SubscribeStats(ctx context.Context, interval time.Duration, fn func(*StatsSnapshot)) error {
+	dialCtx, cancel := context.WithTimeout(ctx, c.timeout)
+	conn, err := (&net.Dialer{}).DialContext(dialCtx, "unix", c.socketPath)
+	cancel()
+	if err != nil {
+		return fmt.Errorf("connect to %s: %w", c.socketPath, err)
+	}
+	defer func() {
+		_ = conn.Close()
+	}()
+
+	// Closing the connection unblocks the pending read when ctx is cancelled.
+	stop := context.AfterFunc(ctx, func() {
+		_ = conn.Close()
+	})
+	defer stop()
+
+	if err := conn.SetWriteDeadline(time.Now().Add(c.timeout)); err != nil {
+		return fmt.Errorf("set deadline: %w", err)
+	}
+	req := CommandRequest{
+		Command: "subscribe",
+		Payload: SubscribeRequest{Topic: "stats", IntervalMs: interval.Milliseconds()},
+	}
+	if err := writeRequest(conn, req); err != nil {
+		return err
+	}
+
+	var state map[string]json.RawMessage
+	var lastSeq uint64
+	for {
+		if err := conn.SetReadDeadline(time.Now().Add(interval + c.timeout)); err != nil {
+			return fmt.Errorf("set deadline: %w", err)
+		}
+		body, err := readFrame(conn)
+		if err != nil {
+			if ctx.Err() != nil {
+				return ctx.Err()
+			}
+			return err
+		}
+
+		var ev StatsEvent
+		if err := json.Unmarshal(body, &ev); err != nil {
+			return fmt.Errorf("parse event JSON: %w", err)
+		}
+		if !ev.OK {
+			errMsg := ev.Error
+			if errMsg == "" {
+				errMsg = "unknown server error"
+			}
+			return fmt.Errorf("%w: %s", ErrSubscribeRejected, errMsg)
+		}
+		if ev.Event != "stats" {
+			continue // unknown event kinds are ignored for forward compatibility
+		}
+
+		switch {
+		case ev.Full:
+			state = ev.Payload
+		case state == nil || ev.Seq != lastSeq+1:
+			return fmt.Errorf("stats event seq %d out of order (last %d)", ev.Seq, lastSeq)
+		default:
+			for k, v := range ev.Payload {
+				state[k] = v
+			}
+		}
+		lastSeq = ev.Seq
+
+		merged, err := json.Marshal(state)
+		if err != nil {
+			return fmt.Errorf("re-marshal stats state: %w", err)
+		}
+		snap, err := decodeStats(merged)
+		if err != nil {
+			return err
+		}
+		fn(snap)
+	}
+}
+
+// StatsUpdate is one state of a StatsFeed: the latest snapshot, or the error
+// that interrupted the stream (Snapshot is nil then).
+type StatsUpdate struct {
+	Snapshot *StatsSnapshot
+	Err      error
+}
+
+// StatsFeed shares a single stats stream among any number of readers, so the
+// proxy serves one control connection regardless of how many dashboards or
+// browsers are watching.
+//
+// Run holds a "subscribe" connection and reconnects with backoff. When the
+// proxy rejects "subscribe" (older proxy) the feed polls "stats" at the same
+// interval instead, and tries to subscribe again after the next failure.
+type StatsFeed struct {
+	client   *Client
+	interval time.Duration
+
+	mu       sync.Mutex
+	latest   StatsUpdate
+	has      bool
+	watchers map[chan StatsUpdate]struct{}
+}
+
+// maxFeedBackoff caps the reconnect delay of StatsFeed.Run.
+const maxFeedBackoff = 30 * time.Second
+
+// NewStatsFeed returns a feed that streams stats from c every interval.
+// Call Run to start it.
+func NewStatsFeed(c *Client, interval time.Duration) *StatsFeed {
+	return &StatsFeed{
+		client:   c,
+		interval: interval,
+		watchers: make(map[chan StatsUpdate]struct{}),
+	}
+}
+
+// Interval returns the update interval the feed requests from the proxy.
+func (f *StatsFeed) Interval() time.Duration { return f.interval }
+
+// Run streams stats until ctx is cancelled.
+func (f *StatsFeed) Run(ctx context.Context) {
+	backoff := f.interval
+	for ctx.Err() == nil {
+		received := false
+		publish := func(snap *StatsSnapshot) {
+			received = true
+			f.publish(StatsUpdate{Snapshot: snap})
+		}
+
+		err := f.client.SubscribeStats(ctx, f.interval, publish)
+		if errors.Is(err, ErrSubscribeRejected) {
+			err = f.poll(ctx, publish)
+		}
+		if ctx.Err() != nil {
+			return
+		}
+		f.publish(StatsUpdate{Err: err})
+
+		if received {
+			backoff = f.interval
+		} else {
+			backoff = min(backoff*2, maxFeedBackoff)
+		}
+		t := time.NewTimer(backoff)
+		select {
+		case <-ctx.Done():
+			t.Stop()
+			return
+		case <-t.C:
+		}
+	}
+}
+
+// poll is the fallback for proxies without "subscribe": one "stats" request per
+// interval until a request fails or ctx is cancelled.
+func (f *StatsFeed) poll(ctx context.Context, publish func(*StatsSnapshot)) error {
+	ticker := time.NewTicker(f.interval)
+	defer ticker.Stop()
+	for {
+		snap, err := f.client.GetStats()
+		if err != nil {
+			return err
+		}
+		publish(snap)
+		select {
+		case <-ctx.Done():
+			return ctx.Err()
+		case <-ticker.C:
+		}
+	}
+}
+
+// Latest returns the most recent update. ok is false until Run has produced a
+// snapshot or an error.
+func (f *StatsFeed) Latest() (update StatsUpdate, ok bool) {
+	f.mu.Lock()
+	defer f.mu.Unlock()
+	return f.latest, f.has
+}
+
+// Watch registers a reader. The returned channel receives every update; a slow
+// reader only misses intermediate updates (the channel holds the newest one).
+// Call cancel to unregister; the channel is not closed.
+func (f *StatsFeed) Watch() (updates <-chan StatsUpdate, cancel func()) {
+	ch := make(chan StatsUpdate, 1)
+	f.mu.Lock()
+	f.watchers[ch] = struct{}{}
+	f.mu.Unlock()
+	return ch, func() {
+		f.mu.Lock()
+		delete(f.watchers, ch)
+		f.mu.Unlock()
+	}
+}
+
+func (f *StatsFeed) publish(u StatsUpdate) {
+	f.mu.Lock()
+	defer f.mu.Unlock()
+	f.latest = u
+	f.has = true
+	for ch := range f.watchers {
+		// Replace a pending update the reader has not consumed yet.
+		select {
+		case <-ch:
+		default:
+		}
+		ch <- u
+	}
+}
@@ -0,0 +1,204 @@
+package client
+
+import (
+	"context"
+	"encoding/binary"
+	"errors"
+	"net"
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+	"time"
+)
+
+// startPushServer starts a mock UDS server that, for every connection, drains
+// one request frame, hands its body to onRequest and writes the frames returned
+// by it (already framed), then keeps the connection open until the client closes.
+func startPushServer(t *testing.T, onRequest func(req string) [][]byte) string {
+	t.Helper()
+
+	dir := t.TempDir()
+	sockPath := filepath.Join(dir, "push.sock")
+	ln, err := net.Listen("unix", sockPath)
+	if err != nil {
+		t.Fatalf("listen: %v", err)
+	}
+	t.Cleanup(func() {
+		_ = ln.Close()
+		_ = os.Remove(sockPath)
+	})
+
+	go func() {
+		for {
+			conn, err := ln.Accept()
+			if err != nil {
+				return
+			}
+			go func(c net.Conn) {
+				defer func() { _ = c.Close() }()
+				for {
+					var lenBuf [4]byte
+					if _, err := readFull(c, lenBuf[:]); err != nil {
+						return
+					}
+					body := make([]byte, binary.LittleEndian.Uint32(lenBuf[:]))
+					if _, err := readFull(c, body); err != nil {
+						return
+					}
+					for _, frame := range onRequest(string(body)) {
+						if _, err := c.Write(frame); err != nil {
+							return
+						}
+					}
+				}
+			}(conn)
+		}
+	}()
+
+	return sockPath
+}
+
+// TestSubscribeStats_MergesDeltas verifies that deltas are applied on top of the
+// full snapshot so the callback always sees complete values.
+func TestSubscribeStats_MergesDeltas(t *testing.T) {
+	requests := make(chan string, 1)
+	sockPath := startPushServer(t, func(req string) [][]byte {
+		requests <- req
+		return [][]byte{
+			frameResponse([]byte(`{"ok":true,"event":"stats","seq":1,"full":true,"interval_ms":100,` +
+				`"payload":{"total_queries":5,"active_sessions":2,"qps":1.5,"captured_at_ms":1000}}`)),
+			frameResponse([]byte(`{"ok":true,"event":"stats","seq":2,"full":false,"interval_ms":100,` +
+				`"payload":{"total_queries":7,"captured_at_ms":1100}}`)),
+		}
+	})
+
+	ctx, cancel := context.WithCancel(context.Background())
+	defer cancel()
+
+	var got []*StatsSnapshot
+	c := NewClient(sockPath, 2*time.Second)
+	err := c.SubscribeStats(ctx, 100*time.Millisecond, func(s *StatsSnapshot) {
+		got = append(got, s)
+		if len(got) == 2 {
+			cancel()
+		}
+	})
+	if !errors.Is(err, context.Canceled) {
+		t.Fatalf("SubscribeStats: %v", err)
+	}
+
+	req := <-requests
+	if !strings.Contains(req, `"command":"subscribe"`) ||
+		!strings.Contains(req, `"payload":{"topic":"stats","interval_ms":100}`) {
+		t.Errorf("unexpected request %s", req)
+	}
+	if len(got) != 2 {
+		t.Fatalf("expected 2 snapshots, got %d", len(got))
+	}
+	if got[1].TotalQueries != 7 || got[1].ActiveSessions != 2 || got[1].QPS != 1.5 {
+		t.Errorf("delta not merged: %+v", got[1])
+	}
+	if got[1].CapturedAt.UnixMilli() != 1100 {
+		t.Errorf("captured_at: got %v", got[1].CapturedAt)
+	}
+}
+
+// TestSubscribeStats_SeqGap verifies that a missing frame fails the stream
+// instead of silently producing a stale merge.
+func TestSubscribeStats_SeqGap(t *testing.T) {
+	sockPath := startPushServer(t, func(string) [][]byte {
+		return [][]byte{
+			frameResponse([]byte(`{"ok":true,"event":"stats","seq":1,"full":true,"payload":{"total_queries":1}}`)),
+			frameResponse([]byte(`{"ok":true,"event":"stats","seq":3,"full":false,"payload":{"total_queries":3}}`)),
+		}
+	})
+
+	c := NewClient(sockPath, 2*time.Second)
+	err := c.SubscribeStats(context.Background(), 100*time.Millisecond, func(*StatsSnapshot) {})
+	if err == nil || !strings.Contains(err.Error(), "out of order") {
+		t.Fatalf("expected out-of-order error, got %v", err)
+	}
+}
+
+// TestSubscribeStats_Rejected verifies that an ok=false reply maps to
+// ErrSubscribeRejected.
+func TestSubscribeStats_Rejected(t *testing.T) {
+	sockPath := startPushServer(t, func(string) [][]byte {
+		return [][]byte{frameResponse([]byte(`{"ok":false,"error":"unknown command 'subscribe'"}`))}
+	})
+
+	c := NewClient(sockPath, 2*time.Second)
+	err := c.SubscribeStats(context.Background(), time.Second, func(*StatsSnapshot) {})
+	if !errors.Is(err, ErrSubscribeRejected) {
+		t.Fatalf("expected ErrSubscribeRejected, got %v", err)
+	}
+	if !strings.Contains(err.Error(), "unknown command") {
+		t.Errorf("error should carry server message: %v", err)
+	}
+}
+
+// TestStatsFeed_FallsBackToPolling verifies that a proxy without "subscribe" is
+// still served by polling "stats", and that watchers see the updates.
+func TestStatsFeed_FallsBackToPolling(t *testing.T) {
+	sockPath := startPushServer(t, func(req string) [][]byte {
+		if strings.Contains(req, `"subscribe"`) {
+			return [][]byte{frameResponse([]byte(`{"ok":false,"error":"unknown command 'subscribe'"}`))}
+		}
+		return [][]byte{frameResponse([]byte(`{"ok":true,"payload":{"total_queries":42,"captured_at_ms":1000}}`))}
+	})
+
+	feed := NewStatsFeed(NewClient(sockPath, 2*time.Second), 100*time.Millisecond)
+	updates, stop := feed.Watch()
+	defer stop()
+	if _, ok := feed.Latest(); ok {
+		t.Fatal("Latest should report no update before Run")
+	}
+
+	ctx, cancel := context.WithCancel(context.Background())
+	done := make(chan struct{})
+	go func() {
+		feed.Run(ctx)
+		close(done)
+	}()
+
+	select {
+	case u := <-updates:
+		if u.Err != nil || u.Snapshot == nil || u.Snapshot.TotalQueries != 42 {
+			t.Errorf("unexpected update %+v", u)
+		}
+	case <-time.After(2 * time.Second):
+		t.Fatal("no update from feed")
+	}
+	if u, ok := feed.Latest(); !ok || u.Snapshot == nil {
+		t.Errorf("Latest: %+v %v", u, ok)
+	}
+
+	cancel()
+	select {
+	case <-done:
+	case <-time.After(2 * time.Second):
+		t.Fatal("Run did not return after cancel")
+	}
+}
+
+// TestStatsFeed_ReportsConnectionError verifies that an unreachable proxy is
+// published as an error update.
+func TestStatsFeed_ReportsConnectionError(t *testing.T) {
+	feed := NewStatsFeed(NewClient("/nonexistent/dbgate.sock", 100*time.Millisecond), 100*time.Millisecond)
+	updates, stop := feed.Watch()
+	defer stop()
+
+	ctx, cancel := context.WithCancel(context.Background())
+	defer cancel()
+	go feed.Run(ctx)
+
+	select {
+	case u := <-updates:
+		if u.Err == nil || u.Snapshot != nil {
+			t.Errorf("expected error update, got %+v", u)
+		}
+	case <-time.After(2 * time.Second):
+		t.Fatal("no update from feed")
+	}
+}
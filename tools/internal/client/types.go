@@ -6,24 +6,70 @@
 // Response: Response        <- JSON <- [4byte LE len][JSON]
 //
 // Supported commands: "stats" | "policy_explain" | "sessions" | "policy_reload" |
-// "policy_versions" | "policy_rollback"
+// "policy_versions" | "policy_rollback" | "policy_stats" | "subscribe"
 package client
 
 import (
+	"encoding/json"
 	"time"
 )
 
 // StatsSnapshot is the JSON representation of C++ StatsCollector.snapshot().
 // Fields must match the C++ UDS response payload exactly.
 type StatsSnapshot struct {
-	TotalConnections uint64    `json:"total_connections"`
-	ActiveSessions   uint64    `json:"active_sessions"`
-	TotalQueries     uint64    `json:"total_queries"`
-	BlockedQueries   uint64    `json:"blocked_queries"`
-	MonitoredBlocks  uint64    `json:"monitored_blocks"`
-	QPS              float64   `json:"qps"`
-	BlockRate        float64   `json:"block_rate"`
-	CapturedAt       time.Time `json:"captured_at"`
+	TotalConnections  uint64    `json:"total_connections"`
+	ActiveSessions    uint64    `json:"active_sessions"`
+	TotalQueries      uint64    `json:"total_queries"`
+	BlockedQueries    uint64    `json:"blocked_queries"`
+	MonitoredBlocks   uint64    `json:"monitored_blocks"`
+	QPS               float64   `json:"qps"`
+	BlockRate         float64   `json:"block_rate"`
+	QPS10s            float64   `json:"qps_10s"`
+	QPS60s            float64   `json:"qps_60s"`
+	BlockRate1s       float64   `json:"block_rate_1s"`
+	BlockRate10s      float64   `json:"block_rate_10s"`
+	BlockRate60s      float64   `json:"block_rate_60s"`
+	PoolHits          uint64    `json:"pool_hits"`
+	PoolMisses        uint64    `json:"pool_misses"`
+	PoolIdle          uint64    `json:"pool_idle"`
+	PoolEvictions     uint64    `json:"pool_evictions"`
+	LogDropped        uint64    `json:"log_dropped"`
+	LogQueued         uint64    `json:"log_queued"`
+	LogSuppressed     uint64    `json:"log_suppressed"`
+	ResultRowsLimited uint64    `json:"result_rows_limited"`
+	RelayBufferBytes  uint64    `json:"relay_buffer_bytes"`
+	RelayBufferPeak   uint64    `json:"relay_buffer_peak_bytes"`
+	RelayBudgetWaits  uint64    `json:"relay_budget_waits"`
+	ConnsRejected     uint64    `json:"connections_rejected"`
+	HandshakeTimeouts uint64    `json:"handshake_timeouts"`
+	IdleTimeouts      uint64    `json:"idle_timeouts"`
+	TLSFrontendHits   uint64    `json:"tls_frontend_resumed"`
+	TLSFrontendFull   uint64    `json:"tls_frontend_full"`
+	TLSBackendHits    uint64    `json:"tls_backend_resumed"`
+	TLSBackendFull    uint64    `json:"tls_backend_full"`
+	CapturedAt        time.Time `json:"captured_at"`
+
+	// Latency holds per-stage latency summaries keyed by stage name (see LatencyStages).
+	Latency map[string]LatencySummary `json:"latency,omitempty"`
+}
+
+// LatencyStages lists the C++ LatencyStage names in pipeline order.
+var LatencyStages = []string{
+	"parse",
+	"injection_check",
+	"policy_evaluate",
+	"upstream_response",
+	"proxy_overhead",
+}
+
+// LatencySummary is the per-stage latency histogram summary in microseconds.
+// Percentiles are bucket upper bounds (at most 6.25% above the true value).
+type LatencySummary struct {
+	Count  uint64  `json:"count"`
+	P50us  float64 `json:"p50_us"`
+	P99us  float64 `json:"p99_us"`
+	P999us float64 `json:"p999_us"`
+	MaxUs  float64 `json:"max_us"`
 }
 
 // CommandRequest is a UDS request sent to the C++ dbgate core.
@@ -79,6 +125,131 @@ type PolicyVersionsResult struct {
 	Versions []PolicyVersionMeta `json:"versions"`
 }
 
+// RuleCost is the hit count and cumulative evaluation time of one policy rule.
+// AvgNs is TotalNs / Evaluations; Hits may exceed Evaluations for access rules
+// because decision cache hits are counted without being evaluated.
+type RuleCost struct {
+	Evaluations uint64  `json:"evaluations"`
+	Hits        uint64  `json:"hits"`
+	TotalNs     uint64  `json:"total_ns"`
+	AvgNs       float64 `json:"avg_ns"`
+}
+
+// RuleStats is one access_control or block_patterns entry of "policy_stats".
+// Index is the rule position in the active policy snapshot.
+type RuleStats struct {
+	Index int    `json:"index"`
+	Rule  string `json:"rule"`
+	RuleCost
+}
+
+// PolicyStatsResult is the response payload for "policy_stats".
+// Counters restart from zero on every policy reload.
+type PolicyStatsResult struct {
+	Version       uint64      `json:"version"`
+	AccessRules   []RuleStats `json:"access_rules"`
+	BlockPatterns []RuleStats `json:"block_patterns"`
+	NoAccessRule  RuleCost    `json:"no_access_rule"`
+}
+
+// SessionInfo is one active proxy session in the "sessions" response.
+// ConnectedAtMs and LastQueryAtMs are Unix epoch milliseconds; LastQueryAtMs is 0
+// until the session runs its first query. State is one of "handshaking", "ready",
+// "processing_query", "closing" or "closed".
+type SessionInfo struct {
+	SessionID     uint64 `json:"session_id"`
+	ClientIP      string `json:"client_ip"`
+	ClientPort    uint16 `json:"client_port"`
+	DBUser        string `json:"db_user"`
+	DBName        string `json:"db_name"`
+	State         string `json:"state"`
+	Queries       uint64 `json:"queries"`
+	Blocked       uint64 `json:"blocked"`
+	BytesIn       uint64 `json:"bytes_in"`
+	BytesOut      uint64 `json:"bytes_out"`
+	UpstreamUs    uint64 `json:"upstream_us"`
+	ConnectedAtMs int64  `json:"connected_at_ms"`
+	LastQueryAtMs int64  `json:"last_query_at_ms"`
+}
+
+// SessionsResult is the response payload for "sessions". Sessions are ordered by
+// SessionID; Truncated is set when Total exceeds the server-side listing cap.
+type SessionsResult struct {
+	Total     uint64        `json:"total"`
+	Truncated bool          `json:"truncated"`
+	Sessions  []SessionInfo `json:"sessions"`
+}
+
+// UserStatsRequest is the request payload for "user_stats". Sort is one of
+// "queries", "blocked", "bytes_in", "bytes_out", "upstream_us" or "sessions";
+// zero values select the server defaults (queries, 20).
+type UserStatsRequest struct {
+	Sort  string `json:"sort,omitempty"`
+	Limit int    `json:"limit,omitempty"`
+}
+
+// UserTotals is the cumulative load of one db_user (live and finished sessions).
+type UserTotals struct {
+	DBUser         string `json:"db_user"`
+	ActiveSessions uint64 `json:"active_sessions"`
+	Sessions       uint64 `json:"sessions"`
+	Queries        uint64 `json:"queries"`
+	Blocked        uint64 `json:"blocked"`
+	BytesIn        uint64 `json:"bytes_in"`
+	BytesOut       uint64 `json:"bytes_out"`
+	UpstreamUs     uint64 `json:"upstream_us"`
+}
+
+// UserStatsResult is the response payload for "user_stats". Users holds the top
+// entries by Sort (descending); TotalUsers counts every known user. The table is
+// refreshed once per second, at CapturedAtMs (Unix epoch milliseconds).
+type UserStatsResult struct {
+	CapturedAtMs int64        `json:"captured_at_ms"`
+	TotalUsers   uint64       `json:"total_users"`
+	Sort         string       `json:"sort"`
+	Users        []UserTotals `json:"users"`
+}
+
+// TopQueriesRequest is the request payload for "top_queries". Sort is one of
+// "count", "blocked", "upstream_us" or "p99_us"; zero values select the server
+// defaults (count, 20).
+type TopQueriesRequest struct {
+	Sort  string `json:"sort,omitempty"`
+	Limit int    `json:"limit,omitempty"`
+}
+
+// QueryStats is one statement shape (normalized fingerprint) tracked by the
+// proxy's Space-Saving sketch. Count over-estimates by at most Error, so the
+// true count is between Count-Error and Count. Blocked and the latency fields
+// cover only the period since the counter took over this fingerprint.
+type QueryStats struct {
+	ID           string  `json:"id"`
+	Fingerprint  string  `json:"fingerprint"`
+	Truncated    bool    `json:"truncated"`
+	Count        uint64  `json:"count"`
+	Error        uint64  `json:"error"`
+	Blocked      uint64  `json:"blocked"`
+	LatencyCount uint64  `json:"latency_count"`
+	UpstreamUs   uint64  `json:"upstream_us"`
+	AvgUs        float64 `json:"avg_us"`
+	P50Us        uint64  `json:"p50_us"`
+	P99Us        uint64  `json:"p99_us"`
+	MaxUs        uint64  `json:"max_us"`
+}
+
+// TopQueriesResult is the response payload for "top_queries". Queries holds the
+// top entries by Sort (descending). Tracked counts the fingerprints held by the
+// sketch (at most Capacity); Untracked counts queries without a fingerprint
+// (multi-statement queries, for example).
+type TopQueriesResult struct {
+	Capacity  uint64       `json:"capacity"`
+	Tracked   uint64       `json:"tracked"`
+	Recorded  uint64       `json:"recorded"`
+	Untracked uint64       `json:"untracked"`
+	Sort      string       `json:"sort"`
+	Queries   []QueryStats `json:"queries"`
+}
+
 // PolicyRollbackResult is the response payload for "policy_rollback".
 type PolicyRollbackResult struct {
 	RolledBackTo    uint64 `json:"rolled_back_to"`
@@ -98,3 +269,23 @@ type PolicyReloadResult struct {
 	Version    uint64 `json:"version"`
 	Message    string `json:"message"`
 }
+
+// SubscribeRequest is the request payload for "subscribe". After a successful
+// subscribe the connection only carries pushed StatsEvent frames.
+type SubscribeRequest struct {
+	Topic      string `json:"topic"`
+	IntervalMs int64  `json:"interval_ms"`
+}
+
+// StatsEvent is one frame pushed on a "subscribe" connection. Seq 1 (Full=true)
+// carries the whole StatsSnapshot payload; later frames carry only the top-level
+// fields whose value changed since the previous frame.
+type StatsEvent struct {
+	OK         bool                       `json:"ok"`
+	Error      string                     `json:"error,omitempty"`
+	Event      string                     `json:"event"`
+	Seq        uint64                     `json:"seq"`
+	Full       bool                       `json:"full"`
+	IntervalMs int64                      `json:"interval_ms"`
+	Payload    map[string]json.RawMessage `json:"payload"`
+}
@@ -1,10 +1,14 @@
 package dashboard
 
 import (
+	"bytes"
+	"context"
 	"encoding/json"
 	"fmt"
 	"log/slog"
+	"net"
 	"net/http"
+	"strings"
 	"sync"
 	"time"
 
@@ -39,18 +43,81 @@ type policyVersionsData struct {
 
 // sessionsData is passed to the sessions partial.
 type sessionsData struct {
-	Sessions []sessionRow
-	Error    string
+	Sessions  []sessionRow
+	Total     uint64
+	Truncated bool
+	Error     string
 }
 
 // sessionRow represents one active session for table display.
 type sessionRow struct {
-	ID       string
-	Client   string
+	ID        string
+	Client    string
+	User      string
+	Database  string
+	State     string
+	Duration  string
+	Queries   uint64
+	Blocked   uint64
+	BytesIn   uint64
+	BytesOut  uint64
+	LastQuery string
+}
+
+// sessionRows converts the "sessions" payload into table rows. Durations are
+// measured against now and truncated to whole seconds.
+func sessionRows(sessions []client.SessionInfo, now time.Time) []sessionRow {
+	since := func(ms int64) time.Duration {
+		d := now.Sub(time.UnixMilli(ms)).Truncate(time.Second)
+		if d < 0 {
+			return 0
+		}
+		return d
+	}
+	rows := make([]sessionRow, 0, len(sessions))
+	for _, si := range sessions {
+		lastQuery := "-"
+		if si.LastQueryAtMs > 0 {
+			lastQuery = since(si.LastQueryAtMs).String() + " ago"
+		}
+		rows = append(rows, sessionRow{
+			ID:        fmt.Sprintf("%d", si.SessionID),
+			Client:    net.JoinHostPort(si.ClientIP, fmt.Sprintf("%d", si.ClientPort)),
+			User:      si.DBUser,
+			Database:  si.DBName,
+			State:     si.State,
+			Duration:  since(si.ConnectedAtMs).String(),
+			Queries:   si.Queries,
+			Blocked:   si.Blocked,
+			BytesIn:   si.BytesIn,
+			BytesOut:  si.BytesOut,
+			LastQuery: lastQuery,
+		})
+	}
+	return rows
+}
+
+// usersTopN is the number of users shown in the Top Users table.
+const usersTopN = 10
+
+// usersData is passed to the users partial.
+type usersData struct {
+	Users []userRow
+	Total uint64
+	Sort  string
+	Error string
+}
+
+// userRow represents one db_user in the Top Users table.
+type userRow struct {
 	User     string
-	Database string
-	Duration string
-	Queries  int
+	Active   uint64
+	Sessions uint64
+	Queries  uint64
+	Blocked  uint64
+	BytesIn  uint64
+	BytesOut uint64
+	Upstream string
 }
 
 // chartPoint is a single data point in the QPS history.
@@ -64,6 +131,7 @@ type chartBuffer struct {
 	mu     sync.Mutex
 	points []chartPoint
 	cap    int
+	last   time.Time // CapturedAt of the last observed snapshot
 }
 
 func newChartBuffer(capacity int) *chartBuffer {
@@ -77,7 +145,22 @@ func newChartBuffer(capacity int) *chartBuffer {
 func (cb *chartBuffer) add(qps float64) {
 	cb.mu.Lock()
 	defer cb.mu.Unlock()
+	cb.addLocked(qps)
+}
+
+// observe records snap once: the chart recorder and every event stream see the
+// same feed update, and only the first of them adds the point.
+func (cb *chartBuffer) observe(snap *client.StatsSnapshot) {
+	cb.mu.Lock()
+	defer cb.mu.Unlock()
+	if !snap.CapturedAt.After(cb.last) {
+		return
+	}
+	cb.last = snap.CapturedAt
+	cb.addLocked(snap.QPS)
+}
 
+func (cb *chartBuffer) addLocked(qps float64) {
 	pt := chartPoint{QPS: qps, T: time.Now().Unix()}
 	if len(cb.points) >= cb.cap {
 		copy(cb.points, cb.points[1:])
@@ -97,6 +180,146 @@ func (cb *chartBuffer) snapshot() []chartPoint {
 	return out
 }
 
+// statsData returns the latest snapshot of the shared feed. Until the feed has
+// produced its first update (or when Run was not called) it falls back to one
+// "stats" request and records the chart point itself.
+func (s *Server) statsData() indexData {
+	if u, ok := s.feed.Latest(); ok {
+		if u.Err != nil {
+			return indexData{Error: u.Err.Error()}
+		}
+		return indexData{Stats: u.Snapshot}
+	}
+
+	stats, err := s.client.GetStats()
+	if err != nil {
+		s.logger.Warn("get stats", slog.String("error", err.Error()))
+		return indexData{Error: err.Error()}
+	}
+	s.chart.add(stats.QPS)
+	return indexData{Stats: stats}
+}
+
+// recordChart appends one QPS point per feed update, independent of how many
+// viewers are open.
+func (s *Server) recordChart(ctx context.Context) {
+	updates, stop := s.feed.Watch()
+	defer stop()
+	for {
+		select {
+		case <-ctx.Done():
+			return
+		case u := <-updates:
+			if u.Err != nil {
+				s.logger.Warn("stats feed", slog.String("error", u.Err.Error()))
+				continue
+			}
+			s.chart.observe(u.Snapshot)
+		}
+	}
+}
+
+// sseHeartbeat keeps idle event streams open through proxies that drop silent
+// connections.
+const sseHeartbeat = 15 * time.Second
+
+// handleEvents streams dashboard updates as server-sent events:
+//
+//	event: stats  data: rendered stats partial (HTML)
+//	event: chart  data: QPS history (JSON array)
+//
+// Every stream reads from the shared stats feed, so the proxy sees one control
+// connection however many browsers are open. dashboard.js swaps the payloads in
+// and htmx polling resumes while the stream is down.
+func (s *Server) handleEvents(w http.ResponseWriter, r *http.Request) {
+	flusher, ok := w.(http.Flusher)
+	if !ok {
+		http.Error(w, "streaming unsupported", http.StatusInternalServerError)
+		return
+	}
+	tmpl, err := parseTemplates()
+	if err != nil {
+		s.logger.Error("parse templates", slog.String("error", err.Error()))
+		http.Error(w, "internal server error", http.StatusInternalServerError)
+		return
+	}
+
+	updates, stop := s.feed.Watch()
+	defer stop()
+
+	w.Header().Set("Content-Type", "text/event-stream")
+	w.Header().Set("Cache-Control", "no-cache")
+	w.Header().Set("X-Accel-Buffering", "no")
+	w.WriteHeader(http.StatusOK)
+
+	send := func(u client.StatsUpdate) error {
+		data := indexData{Stats: u.Snapshot}
+		if u.Err != nil {
+			data = indexData{Error: u.Err.Error()}
+		} else {
+			s.chart.observe(u.Snapshot)
+		}
+		var buf bytes.Buffer
+		if err := tmpl.ExecuteTemplate(&buf, "templates/partials/stats.html", data); err != nil {
+			return err
+		}
+		if err := writeEvent(w, "stats", buf.String()); err != nil {
+			return err
+		}
+		points, err := json.Marshal(s.chart.snapshot())
+		if err != nil {
+			return err
+		}
+		if err := writeEvent(w, "chart", string(points)); err != nil {
+			return err
+		}
+		flusher.Flush()
+		return nil
+	}
+
+	if u, ok := s.feed.Latest(); ok {
+		if err := send(u); err != nil {
+			return
+		}
+	}
+
+	heartbeat := time.NewTicker(sseHeartbeat)
+	defer heartbeat.Stop()
+	for {
+		select {
+		case <-r.Context().Done():
+			return
+		case u := <-updates:
+			if err := send(u); err != nil {
+				s.logger.Debug("event stream closed", slog.String("error", err.Error()))
+				return
+			}
+		case <-heartbeat.C:
+			if _, err := fmt.Fprint(w, ": ping\n\n"); err != nil {
+				return
+			}
+			flusher.Flush()
+		}
+	}
+}
+
+// writeEvent writes one server-sent event; multi-line data is split into one
+// "data:" field per line as the SSE format requires.
+func writeEvent(w http.ResponseWriter, event, data string) error {
+	var b strings.Builder
+	b.WriteString("event: ")
+	b.WriteString(event)
+	b.WriteByte('\n')
+	for _, line := range strings.Split(data, "\n") {
+		b.WriteString("data: ")
+		b.WriteString(strings.TrimSuffix(line, "\r"))
+		b.WriteByte('\n')
+	}
+	b.WriteByte('\n')
+	_, err := fmt.Fprint(w, b.String())
+	return err
+}
+
 // handleIndex renders the full dashboard page.
 func (s *Server) handleIndex(w http.ResponseWriter, r *http.Request) {
 	if r.URL.Path != "/" {
@@ -111,15 +334,7 @@ func (s *Server) handleIndex(w http.ResponseWriter, r *http.Request) {
 		return
 	}
 
-	data := indexData{}
-	stats, err := s.client.GetStats()
-	if err != nil {
-		data.Error = err.Error()
-		s.logger.Warn("get stats for index", slog.String("error", err.Error()))
-	} else {
-		data.Stats = stats
-		s.chart.add(stats.QPS)
-	}
+	data := s.statsData()
 
 	w.Header().Set("Content-Type", "text/html; charset=utf-8")
 	if err := tmpl.ExecuteTemplate(w, "templates/layout.html", data); err != nil {
@@ -136,15 +351,7 @@ func (s *Server) handleStats(w http.ResponseWriter, _ *http.Request) {
 		return
 	}
 
-	data := indexData{}
-	stats, err := s.client.GetStats()
-	if err != nil {
-		data.Error = err.Error()
-		s.logger.Warn("get stats", slog.String("error", err.Error()))
-	} else {
-		data.Stats = stats
-		s.chart.add(stats.QPS)
-	}
+	data := s.statsData()
 
 	w.Header().Set("Content-Type", "text/html; charset=utf-8")
 	if err := tmpl.ExecuteTemplate(w, "templates/partials/stats.html", data); err != nil {
@@ -152,8 +359,8 @@ func (s *Server) handleStats(w http.ResponseWriter, _ *http.Request) {
 	}
 }
 
-// handleSessions renders the sessions partial. Returns "Coming Soon" if the
-// C++ side returns a 501-equivalent (ok=false).
+// handleSessions renders the sessions partial. Shows "Coming Soon" if the proxy
+// is unreachable or returns ok=false (e.g. an older proxy without "sessions").
 func (s *Server) handleSessions(w http.ResponseWriter, _ *http.Request) {
 	tmpl, err := parseTemplates()
 	if err != nil {
@@ -163,13 +370,14 @@ func (s *Server) handleSessions(w http.ResponseWriter, _ *http.Request) {
 	}
 
 	data := sessionsData{}
-	resp, err := s.client.SendCommand("sessions")
+	result, err := s.client.Sessions()
 	if err != nil {
 		data.Error = err.Error()
-	} else if !resp.OK {
-		data.Error = "not implemented"
+	} else {
+		data.Sessions = sessionRows(result.Sessions, time.Now())
+		data.Total = result.Total
+		data.Truncated = result.Truncated
 	}
-	// TODO: parse resp.Payload into sessionRow slice when C++ side implements sessions
 
 	w.Header().Set("Content-Type", "text/html; charset=utf-8")
 	if err := tmpl.ExecuteTemplate(w, "templates/partials/sessions.html", data); err != nil {
@@ -177,6 +385,47 @@ func (s *Server) handleSessions(w http.ResponseWriter, _ *http.Request) {
 	}
 }
 
+// handleUsers renders the Top Users partial. The optional "sort" query parameter
+// is passed to the proxy as-is (default "queries"); the proxy rejects unknown keys.
+func (s *Server) handleUsers(w http.ResponseWriter, r *http.Request) {
+	tmpl, err := parseTemplates()
+	if err != nil {
+		s.logger.Error("parse templates", slog.String("error", err.Error()))
+		http.Error(w, "internal server error", http.StatusInternalServerError)
+		return
+	}
+
+	data := usersData{}
+	result, err := s.client.UserStats(r.URL.Query().Get("sort"), usersTopN)
+	if err != nil {
+		data.Error = err.Error()
+	} else {
+		data.Total = result.TotalUsers
+		data.Sort = result.Sort
+		for _, u := range result.Users {
+			name := u.DBUser
+			if name == "" {
+				name = "(unauthenticated)"
+			}
+			data.Users = append(data.Users, userRow{
+				User:     name,
+				Active:   u.ActiveSessions,
+				Sessions: u.Sessions,
+				Queries:  u.Queries,
+				Blocked:  u.Blocked,
+				BytesIn:  u.BytesIn,
+				BytesOut: u.BytesOut,
+				Upstream: (time.Duration(u.UpstreamUs) * time.Microsecond).Truncate(time.Millisecond).String(),
+			})
+		}
+	}
+
+	w.Header().Set("Content-Type", "text/html; charset=utf-8")
+	if err := tmpl.ExecuteTemplate(w, "templates/partials/users.html", data); err != nil {
+		s.logger.Error("execute users template", slog.String("error", err.Error()))
+	}
+}
+
 // handlePolicyTester renders the Policy Tester standalone page.
 // The page uses its own layout (not the shared layout.html) to avoid
 // the Go template "content" block name collision with index.html.
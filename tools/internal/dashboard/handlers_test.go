@@ -1,6 +1,8 @@
 package dashboard
 
 import (
+	"bufio"
+	"context"
 	"encoding/binary"
 	"encoding/json"
 	"net"
@@ -215,6 +217,96 @@ func TestHandleSessions_ConnectionError(t *testing.T) {
 	}
 }
 
+func TestHandleSessions_ListsSessions(t *testing.T) {
+	respJSON := []byte(`{"ok":true,"payload":{"total":1,"truncated":false,"sessions":[` +
+		`{"session_id":42,"client_ip":"10.0.0.5","client_port":51234,"db_user":"app",` +
+		`"db_name":"shop","state":"processing_query","queries":17,"blocked":2,` +
+		`"bytes_in":900,"bytes_out":12000,"connected_at_ms":1,"last_query_at_ms":0}]}}`)
+	sockPath := startMockUDS(t, respJSON)
+	srv := newTestServer(t, sockPath)
+
+	req := httptest.NewRequest(http.MethodGet, "/api/sessions", http.NoBody)
+	rec := httptest.NewRecorder()
+	srv.mux.ServeHTTP(rec, req)
+
+	body := rec.Body.String()
+	for _, want := range []string{"42", "10.0.0.5:51234", "app", "shop", "processing_query",
+		"<td>17</td>", "<td>12000</td>"} {
+		if !strings.Contains(body, want) {
+			t.Errorf("sessions table should contain %q, got:\n%s", want, body)
+		}
+	}
+	if strings.Contains(body, "Coming Soon") {
+		t.Error("sessions table must not show 'Coming Soon' when the proxy returns sessions")
+	}
+}
+
+func TestHandleUsers_TopTable(t *testing.T) {
+	respJSON := []byte(`{"ok":true,"payload":{"captured_at_ms":1,"total_users":3,` +
+		`"sort":"queries","users":[{"db_user":"app","active_sessions":2,"sessions":5,` +
+		`"queries":900,"blocked":4,"bytes_in":10,"bytes_out":20,"upstream_us":1500000},` +
+		`{"db_user":"","active_sessions":0,"sessions":1,"queries":0,"blocked":0,` +
+		`"bytes_in":0,"bytes_out":78,"upstream_us":0}]}}`)
+	sockPath := startMockUDS(t, respJSON)
+	srv := newTestServer(t, sockPath)
+
+	req := httptest.NewRequest(http.MethodGet, "/api/users?sort=queries", http.NoBody)
+	rec := httptest.NewRecorder()
+	srv.mux.ServeHTTP(rec, req)
+
+	if rec.Code != http.StatusOK {
+		t.Fatalf("expected 200, got %d", rec.Code)
+	}
+	body := rec.Body.String()
+	for _, want := range []string{"<td>app</td>", "<td>900</td>", "1.5s", "(unauthenticated)",
+		"Top 2 of 3 users by queries"} {
+		if !strings.Contains(body, want) {
+			t.Errorf("users table should contain %q, got:\n%s", want, body)
+		}
+	}
+}
+
+func TestHandleUsers_ServerError(t *testing.T) {
+	respJSON := []byte(`{"ok":false,"error":"not implemented","code":501,"command":"user_stats"}`)
+	sockPath := startMockUDS(t, respJSON)
+	srv := newTestServer(t, sockPath)
+
+	req := httptest.NewRequest(http.MethodGet, "/api/users", http.NoBody)
+	rec := httptest.NewRecorder()
+	srv.mux.ServeHTTP(rec, req)
+
+	if !strings.Contains(rec.Body.String(), "unavailable") {
+		t.Errorf("users partial should report unavailable, got:\n%s", rec.Body.String())
+	}
+}
+
+func TestSessionRows_DurationsAndIPv6(t *testing.T) {
+	now := time.UnixMilli(1_700_000_100_500)
+	rows := sessionRows([]client.SessionInfo{{
+		SessionID:     7,
+		ClientIP:      "::1",
+		ClientPort:    3307,
+		ConnectedAtMs: 1_700_000_000_000,
+		LastQueryAtMs: 1_700_000_095_000,
+	}, {
+		SessionID:     8,
+		ConnectedAtMs: 1_700_000_200_000, // clock skew: never negative
+	}}, now)
+
+	if len(rows) != 2 {
+		t.Fatalf("expected 2 rows, got %d", len(rows))
+	}
+	if rows[0].Client != "[::1]:3307" {
+		t.Errorf("Client: got %q", rows[0].Client)
+	}
+	if rows[0].Duration != "1m40s" || rows[0].LastQuery != "5s ago" {
+		t.Errorf("Duration/LastQuery: got %q / %q", rows[0].Duration, rows[0].LastQuery)
+	}
+	if rows[1].Duration != "0s" || rows[1].LastQuery != "-" {
+		t.Errorf("skewed row: got %q / %q", rows[1].Duration, rows[1].LastQuery)
+	}
+}
+
 func TestHandleChartData(t *testing.T) {
 	sockPath := startMockUDS(t, makeStatsResponse())
 	srv := newTestServer(t, sockPath)
@@ -238,6 +330,146 @@ func TestHandleChartData(t *testing.T) {
 	}
 }
 
+// startMockStream starts a mock UDS server that answers each connection's first
+// request with eventJSON (framed) and then holds the connection open, like a
+// "subscribe" stream between pushes.
+func startMockStream(t *testing.T, eventJSON []byte) string {
+	t.Helper()
+
+	sockPath := filepath.Join(t.TempDir(), "stream.sock")
+	ln, err := net.Listen("unix", sockPath)
+	if err != nil {
+		t.Fatalf("listen: %v", err)
+	}
+	t.Cleanup(func() {
+		_ = ln.Close()
+		_ = os.Remove(sockPath)
+	})
+
+	frame := make([]byte, 4+len(eventJSON))
+	binary.LittleEndian.PutUint32(frame[:4], uint32(len(eventJSON)))
+	copy(frame[4:], eventJSON)
+
+	go func() {
+		for {
+			conn, err := ln.Accept()
+			if err != nil {
+				return
+			}
+			go func(c net.Conn) {
+				defer func() { _ = c.Close() }()
+				var hdr [4]byte
+				if _, err := readFull(c, hdr[:]); err != nil {
+					return
+				}
+				if _, err := readFull(c, make([]byte, binary.LittleEndian.Uint32(hdr[:]))); err != nil {
+					return
+				}
+				_, _ = c.Write(frame)
+				// Block until the client closes the stream.
+				_, _ = readFull(c, hdr[:])
+			}(conn)
+		}
+	}()
+
+	return sockPath
+}
+
+func makeStatsEvent() []byte {
+	ev := map[string]interface{}{
+		"ok":    true,
+		"event": "stats",
+		"seq":   1,
+		"full":  true,
+		"payload": map[string]interface{}{
+			"total_queries":  1250,
+			"qps":            25.5,
+			"captured_at_ms": time.Now().UnixMilli(),
+		},
+	}
+	b, _ := json.Marshal(ev)
+	return b
+}
+
+// TestHandleEvents_StreamsFeedUpdates verifies that /api/events renders the
+// shared feed's snapshot as an SSE "stats" event followed by a "chart" event.
+func TestHandleEvents_StreamsFeedUpdates(t *testing.T) {
+	sockPath := startMockStream(t, makeStatsEvent())
+	srv := newTestServer(t, sockPath)
+
+	ctx, cancel := context.WithCancel(context.Background())
+	defer cancel()
+	go srv.feed.Run(ctx)
+
+	ts := httptest.NewServer(srv.mux)
+	defer ts.Close()
+
+	req, _ := http.NewRequestWithContext(ctx, http.MethodGet, ts.URL+"/api/events", http.NoBody)
+	resp, err := http.DefaultClient.Do(req)
+	if err != nil {
+		t.Fatalf("GET /api/events: %v", err)
+	}
+	defer func() { _ = resp.Body.Close() }()
+	if ct := resp.Header.Get("Content-Type"); ct != "text/event-stream" {
+		t.Errorf("Content-Type: got %q", ct)
+	}
+
+	lines := make(chan string)
+	go func() {
+		sc := bufio.NewScanner(resp.Body)
+		for sc.Scan() {
+			lines <- sc.Text()
+		}
+		close(lines)
+	}()
+
+	var sawStats, sawQPS, sawChart bool
+	timeout := time.After(3 * time.Second)
+	for !sawChart {
+		select {
+		case line, ok := <-lines:
+			if !ok {
+				t.Fatal("stream ended early")
+			}
+			switch {
+			case line == "event: stats":
+				sawStats = true
+			case sawStats && strings.HasPrefix(line, "data: ") && strings.Contains(line, "25.50"):
+				sawQPS = true
+			case line == "event: chart":
+				sawChart = true
+			}
+		case <-timeout:
+			t.Fatalf("no stats/chart events (stats=%v qps=%v)", sawStats, sawQPS)
+		}
+	}
+	if !sawStats || !sawQPS {
+		t.Errorf("stats event missing or without QPS (stats=%v qps=%v)", sawStats, sawQPS)
+	}
+}
+
+func TestWriteEvent_SplitsLines(t *testing.T) {
+	rec := httptest.NewRecorder()
+	if err := writeEvent(rec, "stats", "<p>a</p>\n<p>b</p>"); err != nil {
+		t.Fatalf("writeEvent: %v", err)
+	}
+	want := "event: stats\ndata: <p>a</p>\ndata: <p>b</p>\n\n"
+	if rec.Body.String() != want {
+		t.Errorf("got %q, want %q", rec.Body.String(), want)
+	}
+}
+
+func TestChartBuffer_ObserveDeduplicates(t *testing.T) {
+	cb := newChartBuffer(10)
+	snap := &client.StatsSnapshot{QPS: 3, CapturedAt: time.UnixMilli(1000)}
+	cb.observe(snap)
+	cb.observe(snap)
+	cb.observe(&client.StatsSnapshot{QPS: 4, CapturedAt: time.UnixMilli(2000)})
+	if got := len(cb.snapshot()); got != 2 {
+		t.Errorf("expected 2 points, got %d", got)
+	}
+}
+
 func TestHandleStaticAssets(t *testing.T) {
 	sockPath := startMockUDS(t, makeStatsResponse())
 	srv := newTestServer(t, sockPath)
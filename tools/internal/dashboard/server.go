@@ -11,6 +11,7 @@ import (
 	"errors"
 	"io/fs"
 	"log/slog"
+	"net"
 	"net/http"
 	"time"
 
@@ -24,10 +25,15 @@ type Server struct {
 	logger       *slog.Logger
 	mux          *http.ServeMux
 	chart        *chartBuffer
+	feed         *client.StatsFeed
 	authUser     string
 	authPassword string
 }
 
+// statsInterval is the push interval of the shared stats subscription. Every
+// viewer (SSE or htmx polling) is served from the same feed.
+const statsInterval = time.Second
+
 // NewServer creates a new dashboard Server.
 // authUser and authPassword enable HTTP Basic Auth when both are non-empty.
 func NewServer(listenAddr string, c *client.Client, logger *slog.Logger, authUser, authPassword string) *Server {
@@ -37,6 +43,7 @@ func NewServer(listenAddr string, c *client.Client, logger *slog.Logger, authUse
 		logger:       logger,
 		mux:          http.NewServeMux(),
 		chart:        newChartBuffer(60),
+		feed:         client.NewStatsFeed(c, statsInterval),
 		authUser:     authUser,
 		authPassword: authPassword,
 	}
@@ -64,7 +71,9 @@ func (s *Server) registerRoutes() {
 	s.mux.HandleFunc("GET /", s.handleIndex)
 	s.mux.HandleFunc("GET /api/stats", s.handleStats)
 	s.mux.HandleFunc("GET /api/sessions", s.handleSessions)
+	s.mux.HandleFunc("GET /api/users", s.handleUsers)
 	s.mux.HandleFunc("GET /api/chart-data", s.handleChartData)
+	s.mux.HandleFunc("GET /api/events", s.handleEvents)
 	s.mux.HandleFunc("GET /api/policy-versions", s.handlePolicyVersions)
 	s.mux.HandleFunc("POST /api/policy-rollback", s.handlePolicyRollback)
 	s.mux.HandleFunc("GET /policy-tester", s.handlePolicyTester)
@@ -76,9 +85,13 @@ func (s *Server) registerRoutes() {
 	s.mux.Handle("GET /static/", http.StripPrefix("/static/", http.FileServerFS(staticSub)))
 }
 
-// Run starts the HTTP server and blocks until ctx is cancelled.
-// It performs a graceful shutdown with a 5-second deadline.
+// Run starts the shared stats feed and the HTTP server and blocks until ctx is
+// cancelled. It performs a graceful shutdown with a 5-second deadline; open
+// event streams end with ctx.
 func (s *Server) Run(ctx context.Context) error {
+	go s.feed.Run(ctx)
+	go s.recordChart(ctx)
+
 	var handler http.Handler = s.mux
 	if s.authUser != "" {
 		handler = basicAuthMiddleware(s.authUser, s.authPassword, handler)
@@ -87,6 +100,8 @@ func (s *Server) Run(ctx context.Context) error {
 		Addr:              s.listenAddr,
 		Handler:           handler,
 		ReadHeaderTimeout: 10 * time.Second,
+		// Request contexts derive from ctx so /api/events streams stop on shutdown.
+		BaseContext: func(net.Listener) context.Context { return ctx },
 	}
 
 	errCh := make(chan error, 1)
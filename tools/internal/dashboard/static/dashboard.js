@@ -1,5 +1,7 @@
-// QPS line chart using Canvas 2D API.
-// Data is fed by htmx polling /api/chart-data which injects a <script> calling updateChart().
+// QPS line chart using Canvas 2D API, plus the live update stream.
+// Data is fed by the /api/events stream (server-sent events). While the stream is down,
+// htmx polls /api/stats and /api/chart-data instead (hx-trigger filter on window.dbgateLive);
+// chart-data injects a <script> calling updateChart().
 
 (function() {
     "use strict";
@@ -86,7 +88,8 @@
         ctx.fillStyle = "#999";
         ctx.font = "11px sans-serif";
         ctx.textAlign = "center";
-        ctx.fillText("~ " + (data.length * 2) + "s ago", pad.left, h - 3);
+        var span = data.length > 1 ? data[data.length - 1].t - data[0].t : 0;
+        ctx.fillText("~ " + span + "s ago", pad.left, h - 3);
         ctx.fillText("now", pad.left + plotW, h - 3);
     }
 
@@ -102,3 +105,31 @@
     // Initial draw.
     draw();
 })();
+
+// Live updates over server-sent events. All browsers share the dashboard's single
+// stats subscription to the proxy.
+(function() {
+    "use strict";
+
+    if (typeof EventSource === "undefined") return;
+
+    var stats = document.getElementById("stats-container");
+    if (!stats) return;
+
+    var source = new EventSource("/api/events");
+    source.addEventListener("open", function() {
+        window.dbgateLive = true;
+    });
+    // EventSource reconnects by itself; htmx polling covers the gap.
+    source.addEventListener("error", function() {
+        window.dbgateLive = false;
+    });
+    source.addEventListener("stats", function(e) {
+        stats.innerHTML = e.data;
+    });
+    source.addEventListener("chart", function(e) {
+        if (typeof window.updateChart === "function") {
+            window.updateChart(JSON.parse(e.data));
+        }
+    });
+})();
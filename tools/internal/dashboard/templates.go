@@ -6,6 +6,8 @@ import (
 	"html/template"
 	"io/fs"
 	"time"
+
+	"github.com/dongwonkwak/dbgate/tools/internal/client"
 )
 
 //go:embed templates/*.html templates/partials/*.html
@@ -34,6 +36,9 @@ var funcMap = template.FuncMap{
 	"fmtInt": func(n uint64) string {
 		return fmt.Sprintf("%d", n)
 	},
+	"latencyStages": func() []string {
+		return client.LatencyStages
+	},
 }
 
 // parseTemplates loads and parses all embedded HTML templates.